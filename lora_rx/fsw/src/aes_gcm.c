@@ -0,0 +1,643 @@
+/*
+**  This program is free software: you can redistribute it and/or modify
+**  it under the terms of the GNU Lesser General Public License as
+**  published by the Free Software Foundation, either version 3 of the
+**  License, or (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Lesser General Public License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public License
+**  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+**
+**  Purpose:
+**    Implement the AES-GCM authenticated encryption functions
+**
+**  Notes:
+**    1. See aes_gcm.h for details.
+**    2. The accelerated block functions are compiled with function target
+**       attributes so the rest of the app doesn't need special compiler
+**       flags. They are only called after a runtime CPU feature check.
+**
+*/
+
+/*
+** Include Files:
+*/
+
+#include <string.h>
+#include "aes_gcm.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+   #define AES_GCM_HAVE_AESNI
+   #include <wmmintrin.h>
+#endif
+
+#if defined(__GNUC__) && defined(__aarch64__) && defined(__linux__)
+   #define AES_GCM_HAVE_ARMV8_CE
+   #include <arm_neon.h>
+   #include <sys/auxv.h>
+   #include <asm/hwcap.h>
+#endif
+
+
+/**********************/
+/** Global File Data **/
+/**********************/
+
+static const uint8_t SBox[256] =
+{
+   0x63, 0x7c, 0x77, 0x7b, 0xf2, 0x6b, 0x6f, 0xc5, 0x30, 0x01, 0x67, 0x2b, 0xfe, 0xd7, 0xab, 0x76,
+   0xca, 0x82, 0xc9, 0x7d, 0xfa, 0x59, 0x47, 0xf0, 0xad, 0xd4, 0xa2, 0xaf, 0x9c, 0xa4, 0x72, 0xc0,
+   0xb7, 0xfd, 0x93, 0x26, 0x36, 0x3f, 0xf7, 0xcc, 0x34, 0xa5, 0xe5, 0xf1, 0x71, 0xd8, 0x31, 0x15,
+   0x04, 0xc7, 0x23, 0xc3, 0x18, 0x96, 0x05, 0x9a, 0x07, 0x12, 0x80, 0xe2, 0xeb, 0x27, 0xb2, 0x75,
+   0x09, 0x83, 0x2c, 0x1a, 0x1b, 0x6e, 0x5a, 0xa0, 0x52, 0x3b, 0xd6, 0xb3, 0x29, 0xe3, 0x2f, 0x84,
+   0x53, 0xd1, 0x00, 0xed, 0x20, 0xfc, 0xb1, 0x5b, 0x6a, 0xcb, 0xbe, 0x39, 0x4a, 0x4c, 0x58, 0xcf,
+   0xd0, 0xef, 0xaa, 0xfb, 0x43, 0x4d, 0x33, 0x85, 0x45, 0xf9, 0x02, 0x7f, 0x50, 0x3c, 0x9f, 0xa8,
+   0x51, 0xa3, 0x40, 0x8f, 0x92, 0x9d, 0x38, 0xf5, 0xbc, 0xb6, 0xda, 0x21, 0x10, 0xff, 0xf3, 0xd2,
+   0xcd, 0x0c, 0x13, 0xec, 0x5f, 0x97, 0x44, 0x17, 0xc4, 0xa7, 0x7e, 0x3d, 0x64, 0x5d, 0x19, 0x73,
+   0x60, 0x81, 0x4f, 0xdc, 0x22, 0x2a, 0x90, 0x88, 0x46, 0xee, 0xb8, 0x14, 0xde, 0x5e, 0x0b, 0xdb,
+   0xe0, 0x32, 0x3a, 0x0a, 0x49, 0x06, 0x24, 0x5c, 0xc2, 0xd3, 0xac, 0x62, 0x91, 0x95, 0xe4, 0x79,
+   0xe7, 0xc8, 0x37, 0x6d, 0x8d, 0xd5, 0x4e, 0xa9, 0x6c, 0x56, 0xf4, 0xea, 0x65, 0x7a, 0xae, 0x08,
+   0xba, 0x78, 0x25, 0x2e, 0x1c, 0xa6, 0xb4, 0xc6, 0xe8, 0xdd, 0x74, 0x1f, 0x4b, 0xbd, 0x8b, 0x8a,
+   0x70, 0x3e, 0xb5, 0x66, 0x48, 0x03, 0xf6, 0x0e, 0x61, 0x35, 0x57, 0xb9, 0x86, 0xc1, 0x1d, 0x9e,
+   0xe1, 0xf8, 0x98, 0x11, 0x69, 0xd9, 0x8e, 0x94, 0x9b, 0x1e, 0x87, 0xe9, 0xce, 0x55, 0x28, 0xdf,
+   0x8c, 0xa1, 0x89, 0x0d, 0xbf, 0xe6, 0x42, 0x68, 0x41, 0x99, 0x2d, 0x0f, 0xb0, 0x54, 0xbb, 0x16
+};
+
+/* GHASH reduction constants for the 4-bit table method */
+static const uint64_t Last4[16] =
+{
+   0x0000, 0x1c20, 0x3840, 0x2460, 0x7080, 0x6ca0, 0x48c0, 0x54e0,
+   0xe100, 0xfd20, 0xd940, 0xc560, 0x9180, 0x8da0, 0xa9c0, 0xb5e0
+};
+
+
+/*******************************/
+/** Local Function Prototypes **/
+/*******************************/
+
+static void EncryptBlock(const AES_GCM_Ctx_t *Ctx, const uint8_t *In, uint8_t *Out);
+static void EncryptBlockPortable(const AES_GCM_Ctx_t *Ctx, const uint8_t *In, uint8_t *Out);
+static void ExpandKey(AES_GCM_Ctx_t *Ctx, const uint8_t *Key, size_t KeyLen);
+static void Ctr(const AES_GCM_Ctx_t *Ctx, const uint8_t *J0, uint8_t *Data, size_t DataLen);
+static void GhashBlocks(const AES_GCM_Ctx_t *Ctx, uint8_t *X, const uint8_t *Data, size_t DataLen);
+static void GhashMult(const AES_GCM_Ctx_t *Ctx, uint8_t *X);
+static void ComputeTag(const AES_GCM_Ctx_t *Ctx, const uint8_t *J0,
+                       const uint8_t *Aad, size_t AadLen,
+                       const uint8_t *Data, size_t DataLen, uint8_t *Tag);
+static void InitJ0(const uint8_t *Iv, uint8_t *J0);
+
+#ifdef AES_GCM_HAVE_AESNI
+static void EncryptBlockAesni(const AES_GCM_Ctx_t *Ctx, const uint8_t *In, uint8_t *Out);
+#endif
+#ifdef AES_GCM_HAVE_ARMV8_CE
+static void EncryptBlockArmv8(const AES_GCM_Ctx_t *Ctx, const uint8_t *In, uint8_t *Out);
+#endif
+
+
+/******************************************************************************
+** Function: AES_GCM_AccelImpl
+**
+*/
+AES_GCM_Impl_Enum_t AES_GCM_AccelImpl(void)
+{
+
+#if defined(AES_GCM_HAVE_AESNI)
+
+   if (__builtin_cpu_supports("aes"))
+   {
+      return AES_GCM_IMPL_AESNI;
+   }
+
+#elif defined(AES_GCM_HAVE_ARMV8_CE)
+
+   if (getauxval(AT_HWCAP) & HWCAP_AES)
+   {
+      return AES_GCM_IMPL_ARMV8_CE;
+   }
+
+#endif
+
+   return AES_GCM_IMPL_PORTABLE;
+
+} /* End AES_GCM_AccelImpl() */
+
+
+/******************************************************************************
+** Function: AES_GCM_Init
+**
+*/
+bool AES_GCM_Init(AES_GCM_Ctx_t *Ctx, const uint8_t *Key, size_t KeyLen,
+                  AES_GCM_Impl_Enum_t Impl)
+{
+
+   uint8_t  H[AES_GCM_BLOCK_LEN];
+   uint64_t Vh, Vl;
+   uint32_t T;
+   int i, j;
+
+   memset(Ctx, 0, sizeof(AES_GCM_Ctx_t));
+
+   if (KeyLen != 16 && KeyLen != 24 && KeyLen != 32)
+   {
+      return false;
+   }
+
+   Ctx->Impl = (Impl == AES_GCM_AccelImpl()) ? Impl : AES_GCM_IMPL_PORTABLE;
+   ExpandKey(Ctx, Key, KeyLen);
+
+   /* Hash subkey H = E(K, 0^128) */
+   memset(H, 0, sizeof(H));
+   EncryptBlock(Ctx, H, H);
+
+   Vh = 0;
+   Vl = 0;
+   for (i = 0; i < 8; i++)
+   {
+      Vh = (Vh << 8) | H[i];
+      Vl = (Vl << 8) | H[i+8];
+   }
+
+   Ctx->HL[8] = Vl;
+   Ctx->HH[8] = Vh;
+
+   for (i = 4; i > 0; i >>= 1)
+   {
+      T  = (uint32_t)(Vl & 1) * 0xe1000000U;
+      Vl = (Vh << 63) | (Vl >> 1);
+      Vh = (Vh >> 1) ^ ((uint64_t)T << 32);
+      Ctx->HL[i] = Vl;
+      Ctx->HH[i] = Vh;
+   }
+
+   for (i = 2; i <= 8; i *= 2)
+   {
+      Vh = Ctx->HH[i];
+      Vl = Ctx->HL[i];
+      for (j = 1; j < i; j++)
+      {
+         Ctx->HH[i+j] = Vh ^ Ctx->HH[j];
+         Ctx->HL[i+j] = Vl ^ Ctx->HL[j];
+      }
+   }
+
+   memset(H, 0, sizeof(H));
+
+   return true;
+
+} /* End AES_GCM_Init() */
+
+
+/******************************************************************************
+** Function: AES_GCM_Encrypt
+**
+*/
+void AES_GCM_Encrypt(const AES_GCM_Ctx_t *Ctx, const uint8_t *Iv,
+                     const uint8_t *Aad, size_t AadLen,
+                     uint8_t *Data, size_t DataLen,
+                     uint8_t *Tag, size_t TagLen)
+{
+
+   uint8_t J0[AES_GCM_BLOCK_LEN];
+   uint8_t FullTag[AES_GCM_BLOCK_LEN];
+
+   InitJ0(Iv, J0);
+   Ctr(Ctx, J0, Data, DataLen);
+   ComputeTag(Ctx, J0, Aad, AadLen, Data, DataLen, FullTag);
+
+   memcpy(Tag, FullTag, TagLen > AES_GCM_MAX_TAG_LEN ? AES_GCM_MAX_TAG_LEN : TagLen);
+
+} /* End AES_GCM_Encrypt() */
+
+
+/******************************************************************************
+** Function: AES_GCM_Decrypt
+**
+*/
+bool AES_GCM_Decrypt(const AES_GCM_Ctx_t *Ctx, const uint8_t *Iv,
+                     const uint8_t *Aad, size_t AadLen,
+                     uint8_t *Data, size_t DataLen,
+                     const uint8_t *Tag, size_t TagLen)
+{
+
+   uint8_t J0[AES_GCM_BLOCK_LEN];
+   uint8_t FullTag[AES_GCM_BLOCK_LEN];
+   uint8_t Diff = 0;
+   size_t  i;
+
+   if (TagLen == 0 || TagLen > AES_GCM_MAX_TAG_LEN)
+   {
+      return false;
+   }
+
+   InitJ0(Iv, J0);
+   ComputeTag(Ctx, J0, Aad, AadLen, Data, DataLen, FullTag);
+
+   for (i = 0; i < TagLen; i++)
+   {
+      Diff |= FullTag[i] ^ Tag[i];
+   }
+
+   if (Diff != 0)
+   {
+      return false;
+   }
+
+   Ctr(Ctx, J0, Data, DataLen);
+
+   return true;
+
+} /* End AES_GCM_Decrypt() */
+
+
+/******************************************************************************
+** Function: AES_GCM_Wipe
+**
+*/
+void AES_GCM_Wipe(AES_GCM_Ctx_t *Ctx)
+{
+
+   volatile uint8_t *Byte = (volatile uint8_t *)Ctx;
+   size_t i;
+
+   for (i = 0; i < sizeof(AES_GCM_Ctx_t); i++)
+   {
+      Byte[i] = 0;
+   }
+
+} /* End AES_GCM_Wipe() */
+
+
+/******************************************************************************
+** Function: ComputeTag
+**
+** Tag = E(K,J0) xor GHASH(A || pad || C || pad || len(A) || len(C))
+**
+*/
+static void ComputeTag(const AES_GCM_Ctx_t *Ctx, const uint8_t *J0,
+                       const uint8_t *Aad, size_t AadLen,
+                       const uint8_t *Data, size_t DataLen, uint8_t *Tag)
+{
+
+   uint8_t  X[AES_GCM_BLOCK_LEN];
+   uint8_t  LenBlock[AES_GCM_BLOCK_LEN];
+   uint64_t AadBits  = (uint64_t)AadLen * 8;
+   uint64_t DataBits = (uint64_t)DataLen * 8;
+   int i;
+
+   memset(X, 0, sizeof(X));
+   GhashBlocks(Ctx, X, Aad, AadLen);
+   GhashBlocks(Ctx, X, Data, DataLen);
+
+   for (i = 0; i < 8; i++)
+   {
+      LenBlock[i]   = (uint8_t)(AadBits  >> (56 - 8*i));
+      LenBlock[i+8] = (uint8_t)(DataBits >> (56 - 8*i));
+   }
+   GhashBlocks(Ctx, X, LenBlock, sizeof(LenBlock));
+
+   EncryptBlock(Ctx, J0, Tag);
+   for (i = 0; i < AES_GCM_BLOCK_LEN; i++)
+   {
+      Tag[i] ^= X[i];
+   }
+
+} /* End ComputeTag() */
+
+
+/******************************************************************************
+** Function: Ctr
+**
+** Apply the keystream starting at inc32(J0)
+**
+*/
+static void Ctr(const AES_GCM_Ctx_t *Ctx, const uint8_t *J0, uint8_t *Data, size_t DataLen)
+{
+
+   uint8_t  Counter[AES_GCM_BLOCK_LEN];
+   uint8_t  KeyStream[AES_GCM_BLOCK_LEN];
+   uint32_t Count;
+   size_t   BlockLen;
+   size_t   i;
+
+   memcpy(Counter, J0, AES_GCM_BLOCK_LEN);
+   Count = ((uint32_t)J0[12] << 24) | ((uint32_t)J0[13] << 16) | ((uint32_t)J0[14] << 8) | J0[15];
+
+   while (DataLen > 0)
+   {
+      Count++;
+      Counter[12] = (uint8_t)(Count >> 24);
+      Counter[13] = (uint8_t)(Count >> 16);
+      Counter[14] = (uint8_t)(Count >> 8);
+      Counter[15] = (uint8_t)Count;
+
+      EncryptBlock(Ctx, Counter, KeyStream);
+
+      BlockLen = DataLen < AES_GCM_BLOCK_LEN ? DataLen : AES_GCM_BLOCK_LEN;
+      for (i = 0; i < BlockLen; i++)
+      {
+         Data[i] ^= KeyStream[i];
+      }
+
+      Data    += BlockLen;
+      DataLen -= BlockLen;
+   }
+
+} /* End Ctr() */
+
+
+/******************************************************************************
+** Function: GhashBlocks
+**
+** Absorb Data into X, zero padding the last partial block
+**
+*/
+static void GhashBlocks(const AES_GCM_Ctx_t *Ctx, uint8_t *X, const uint8_t *Data, size_t DataLen)
+{
+
+   size_t BlockLen;
+   size_t i;
+
+   while (DataLen > 0)
+   {
+      BlockLen = DataLen < AES_GCM_BLOCK_LEN ? DataLen : AES_GCM_BLOCK_LEN;
+      for (i = 0; i < BlockLen; i++)
+      {
+         X[i] ^= Data[i];
+      }
+      GhashMult(Ctx, X);
+
+      Data    += BlockLen;
+      DataLen -= BlockLen;
+   }
+
+} /* End GhashBlocks() */
+
+
+/******************************************************************************
+** Function: GhashMult
+**
+** X = X * H in GF(2^128) using the 4-bit table built by AES_GCM_Init()
+**
+*/
+static void GhashMult(const AES_GCM_Ctx_t *Ctx, uint8_t *X)
+{
+
+   uint64_t Zh, Zl;
+   uint8_t  Lo, Hi, Rem;
+   int i;
+
+   Lo = X[15] & 0x0f;
+   Zh = Ctx->HH[Lo];
+   Zl = Ctx->HL[Lo];
+
+   for (i = 15; i >= 0; i--)
+   {
+      Lo = X[i] & 0x0f;
+      Hi = (X[i] >> 4) & 0x0f;
+
+      if (i != 15)
+      {
+         Rem = (uint8_t)Zl & 0x0f;
+         Zl  = (Zh << 60) | (Zl >> 4);
+         Zh  = (Zh >> 4) ^ (Last4[Rem] << 48);
+         Zh ^= Ctx->HH[Lo];
+         Zl ^= Ctx->HL[Lo];
+      }
+
+      Rem = (uint8_t)Zl & 0x0f;
+      Zl  = (Zh << 60) | (Zl >> 4);
+      Zh  = (Zh >> 4) ^ (Last4[Rem] << 48);
+      Zh ^= Ctx->HH[Hi];
+      Zl ^= Ctx->HL[Hi];
+   }
+
+   for (i = 0; i < 8; i++)
+   {
+      X[i]   = (uint8_t)(Zh >> (56 - 8*i));
+      X[i+8] = (uint8_t)(Zl >> (56 - 8*i));
+   }
+
+} /* End GhashMult() */
+
+
+/******************************************************************************
+** Function: InitJ0
+**
+** J0 = IV || 0^31 || 1 for a 96-bit IV
+**
+*/
+static void InitJ0(const uint8_t *Iv, uint8_t *J0)
+{
+
+   memcpy(J0, Iv, AES_GCM_IV_LEN);
+   J0[12] = 0;
+   J0[13] = 0;
+   J0[14] = 0;
+   J0[15] = 1;
+
+} /* End InitJ0() */
+
+
+/******************************************************************************
+** Function: ExpandKey
+**
+** FIPS-197 key expansion. The byte order of the round keys is the order
+** expected by the portable, AES-NI and ARMv8 implementations.
+**
+*/
+static void ExpandKey(AES_GCM_Ctx_t *Ctx, const uint8_t *Key, size_t KeyLen)
+{
+
+   uint32_t Nk = (uint32_t)KeyLen / 4;
+   uint32_t TotalWords;
+   uint32_t i;
+   uint8_t  Rcon = 0x01;
+   uint8_t  Temp[4];
+   uint8_t  t;
+   uint8_t *W = Ctx->RoundKey;
+
+   Ctx->Rounds = Nk + 6;
+   TotalWords  = 4 * (Ctx->Rounds + 1);
+
+   memcpy(W, Key, KeyLen);
+
+   for (i = Nk; i < TotalWords; i++)
+   {
+      memcpy(Temp, &W[4*(i-1)], 4);
+
+      if (i % Nk == 0)
+      {
+         t = Temp[0];
+         Temp[0] = SBox[Temp[1]] ^ Rcon;
+         Temp[1] = SBox[Temp[2]];
+         Temp[2] = SBox[Temp[3]];
+         Temp[3] = SBox[t];
+         Rcon = (uint8_t)((Rcon << 1) ^ ((Rcon & 0x80) ? 0x1b : 0x00));
+      }
+      else if (Nk > 6 && i % Nk == 4)
+      {
+         Temp[0] = SBox[Temp[0]];
+         Temp[1] = SBox[Temp[1]];
+         Temp[2] = SBox[Temp[2]];
+         Temp[3] = SBox[Temp[3]];
+      }
+
+      W[4*i+0] = W[4*(i-Nk)+0] ^ Temp[0];
+      W[4*i+1] = W[4*(i-Nk)+1] ^ Temp[1];
+      W[4*i+2] = W[4*(i-Nk)+2] ^ Temp[2];
+      W[4*i+3] = W[4*(i-Nk)+3] ^ Temp[3];
+   }
+
+} /* End ExpandKey() */
+
+
+/******************************************************************************
+** Function: EncryptBlock
+**
+*/
+static void EncryptBlock(const AES_GCM_Ctx_t *Ctx, const uint8_t *In, uint8_t *Out)
+{
+
+   switch (Ctx->Impl)
+   {
+#ifdef AES_GCM_HAVE_AESNI
+      case AES_GCM_IMPL_AESNI:
+         EncryptBlockAesni(Ctx, In, Out);
+         break;
+#endif
+#ifdef AES_GCM_HAVE_ARMV8_CE
+      case AES_GCM_IMPL_ARMV8_CE:
+         EncryptBlockArmv8(Ctx, In, Out);
+         break;
+#endif
+      default:
+         EncryptBlockPortable(Ctx, In, Out);
+         break;
+   }
+
+} /* End EncryptBlock() */
+
+
+/******************************************************************************
+** Function: EncryptBlockPortable
+**
+** Byte oriented AES round functions with no lookup tables beyond the S-box
+**
+*/
+static void EncryptBlockPortable(const AES_GCM_Ctx_t *Ctx, const uint8_t *In, uint8_t *Out)
+{
+
+   uint8_t  S[AES_GCM_BLOCK_LEN];
+   uint8_t  T[AES_GCM_BLOCK_LEN];
+   uint8_t  a0, a1, a2, a3, x;
+   uint32_t Round;
+   int c, i;
+   const uint8_t *Rk = Ctx->RoundKey;
+
+   for (i = 0; i < AES_GCM_BLOCK_LEN; i++)
+   {
+      S[i] = In[i] ^ Rk[i];
+   }
+
+   for (Round = 1; Round <= Ctx->Rounds; Round++)
+   {
+      /* SubBytes and ShiftRows, column major state */
+      for (c = 0; c < 4; c++)
+      {
+         T[4*c+0] = SBox[S[4*c+0]];
+         T[4*c+1] = SBox[S[(4*(c+1)+1) & 15]];
+         T[4*c+2] = SBox[S[(4*(c+2)+2) & 15]];
+         T[4*c+3] = SBox[S[(4*(c+3)+3) & 15]];
+      }
+
+      Rk += AES_GCM_BLOCK_LEN;
+
+      if (Round == Ctx->Rounds)
+      {
+         for (i = 0; i < AES_GCM_BLOCK_LEN; i++)
+         {
+            S[i] = T[i] ^ Rk[i];
+         }
+      }
+      else
+      {
+         /* MixColumns and AddRoundKey */
+         for (c = 0; c < 4; c++)
+         {
+            a0 = T[4*c+0];
+            a1 = T[4*c+1];
+            a2 = T[4*c+2];
+            a3 = T[4*c+3];
+            x  = a0 ^ a1 ^ a2 ^ a3;
+            S[4*c+0] = a0 ^ x ^ (uint8_t)(((a0 ^ a1) << 1) ^ (((a0 ^ a1) & 0x80) ? 0x1b : 0)) ^ Rk[4*c+0];
+            S[4*c+1] = a1 ^ x ^ (uint8_t)(((a1 ^ a2) << 1) ^ (((a1 ^ a2) & 0x80) ? 0x1b : 0)) ^ Rk[4*c+1];
+            S[4*c+2] = a2 ^ x ^ (uint8_t)(((a2 ^ a3) << 1) ^ (((a2 ^ a3) & 0x80) ? 0x1b : 0)) ^ Rk[4*c+2];
+            S[4*c+3] = a3 ^ x ^ (uint8_t)(((a3 ^ a0) << 1) ^ (((a3 ^ a0) & 0x80) ? 0x1b : 0)) ^ Rk[4*c+3];
+         }
+      }
+   }
+
+   memcpy(Out, S, AES_GCM_BLOCK_LEN);
+
+} /* End EncryptBlockPortable() */
+
+
+#ifdef AES_GCM_HAVE_AESNI
+/******************************************************************************
+** Function: EncryptBlockAesni
+**
+*/
+__attribute__((target("aes,sse2")))
+static void EncryptBlockAesni(const AES_GCM_Ctx_t *Ctx, const uint8_t *In, uint8_t *Out)
+{
+
+   const __m128i *Rk = (const __m128i *)Ctx->RoundKey;
+   __m128i  S;
+   uint32_t Round;
+
+   S = _mm_xor_si128(_mm_loadu_si128((const __m128i *)In), _mm_loadu_si128(&Rk[0]));
+
+   for (Round = 1; Round < Ctx->Rounds; Round++)
+   {
+      S = _mm_aesenc_si128(S, _mm_loadu_si128(&Rk[Round]));
+   }
+   S = _mm_aesenclast_si128(S, _mm_loadu_si128(&Rk[Ctx->Rounds]));
+
+   _mm_storeu_si128((__m128i *)Out, S);
+
+} /* End EncryptBlockAesni() */
+#endif
+
+
+#ifdef AES_GCM_HAVE_ARMV8_CE
+/******************************************************************************
+** Function: EncryptBlockArmv8
+**
+** Notes:
+**   1. AESE performs AddRoundKey before SubBytes/ShiftRows so the last
+**      round key is applied with a separate XOR.
+**
+*/
+__attribute__((target("+crypto")))
+static void EncryptBlockArmv8(const AES_GCM_Ctx_t *Ctx, const uint8_t *In, uint8_t *Out)
+{
+
+   const uint8_t *Rk = Ctx->RoundKey;
+   uint8x16_t S = vld1q_u8(In);
+   uint32_t   Round;
+
+   for (Round = 0; Round < Ctx->Rounds - 1; Round++)
+   {
+      S = vaesmcq_u8(vaeseq_u8(S, vld1q_u8(&Rk[Round*AES_GCM_BLOCK_LEN])));
+   }
+   S = vaeseq_u8(S, vld1q_u8(&Rk[(Ctx->Rounds-1)*AES_GCM_BLOCK_LEN]));
+   S = veorq_u8(S, vld1q_u8(&Rk[Ctx->Rounds*AES_GCM_BLOCK_LEN]));
+
+   vst1q_u8(Out, S);
+
+} /* End EncryptBlockArmv8() */
+#endif
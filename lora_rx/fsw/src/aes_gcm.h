@@ -0,0 +1,148 @@
+/*
+**  This program is free software: you can redistribute it and/or modify
+**  it under the terms of the GNU Lesser General Public License as
+**  published by the Free Software Foundation, either version 3 of the
+**  License, or (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Lesser General Public License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public License
+**  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+**
+**  Purpose:
+**    Define the AES-GCM authenticated encryption functions
+**
+**  Notes:
+**    1. Implements AES-GCM (NIST SP 800-38D) with 96-bit IVs and AES-128,
+**       AES-192 or AES-256 keys.
+**    2. The AES block cipher has a portable implementation plus x86 AES-NI
+**       and ARMv8 Crypto Extension implementations that are compiled when
+**       the compiler supports them and selected at runtime when the CPU
+**       supports them. GHASH uses a 4-bit table for all implementations.
+**    3. Decryption verifies the tag before any plaintext is written so a
+**       frame that fails authentication is left unchanged.
+**    4. This header shouldn't include cFS or Lora_Rx app C header files.
+**
+*/
+
+#ifndef _aes_gcm_
+#define _aes_gcm_
+
+/*
+** Includes
+*/
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define AES_GCM_BLOCK_LEN    16
+#define AES_GCM_IV_LEN       12
+#define AES_GCM_MAX_TAG_LEN  16
+#define AES_GCM_MAX_ROUNDS   14
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+typedef enum
+{
+   AES_GCM_IMPL_PORTABLE = 0,
+   AES_GCM_IMPL_AESNI    = 1,
+   AES_GCM_IMPL_ARMV8_CE = 2
+
+} AES_GCM_Impl_Enum_t;
+
+
+typedef struct
+{
+
+   AES_GCM_Impl_Enum_t Impl;
+   uint32_t Rounds;
+   uint8_t  RoundKey[(AES_GCM_MAX_ROUNDS+1)*AES_GCM_BLOCK_LEN];
+
+   uint64_t HL[16];   /* GHASH 4-bit multiplication table */
+   uint64_t HH[16];
+
+} AES_GCM_Ctx_t;
+
+
+/************************/
+/** Exported Functions **/
+/************************/
+
+
+/******************************************************************************
+** Function: AES_GCM_AccelImpl
+**
+** Return the fastest implementation supported by the compiler and the CPU
+**
+** Notes:
+**   1. Returns AES_GCM_IMPL_PORTABLE when no accelerated implementation is
+**      available.
+**
+*/
+AES_GCM_Impl_Enum_t AES_GCM_AccelImpl(void);
+
+
+/******************************************************************************
+** Function: AES_GCM_Init
+**
+** Expand a key and precompute the GHASH table
+**
+** Notes:
+**   1. KeyLen must be 16, 24 or 32 bytes.
+**   2. If Impl isn't supported the portable implementation is used. The
+**      selected implementation is saved in the context.
+**
+*/
+bool AES_GCM_Init(AES_GCM_Ctx_t *Ctx, const uint8_t *Key, size_t KeyLen,
+                  AES_GCM_Impl_Enum_t Impl);
+
+
+/******************************************************************************
+** Function: AES_GCM_Encrypt
+**
+** Encrypt Data in place and compute the authentication tag
+**
+*/
+void AES_GCM_Encrypt(const AES_GCM_Ctx_t *Ctx, const uint8_t *Iv,
+                     const uint8_t *Aad, size_t AadLen,
+                     uint8_t *Data, size_t DataLen,
+                     uint8_t *Tag, size_t TagLen);
+
+
+/******************************************************************************
+** Function: AES_GCM_Decrypt
+**
+** Verify the authentication tag and decrypt Data in place
+**
+** Notes:
+**   1. Returns false and leaves Data unchanged if the tag doesn't match.
+**   2. The tag comparison is constant time.
+**
+*/
+bool AES_GCM_Decrypt(const AES_GCM_Ctx_t *Ctx, const uint8_t *Iv,
+                     const uint8_t *Aad, size_t AadLen,
+                     uint8_t *Data, size_t DataLen,
+                     const uint8_t *Tag, size_t TagLen);
+
+
+/******************************************************************************
+** Function: AES_GCM_Wipe
+**
+** Clear key material from a context
+**
+*/
+void AES_GCM_Wipe(AES_GCM_Ctx_t *Ctx);
+
+
+#endif /* _aes_gcm_ */
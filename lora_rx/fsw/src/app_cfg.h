@@ -77,6 +77,10 @@
 #define CFG_BC_SCH_1_HZ_TOPICID         BC_SCH_1_HZ_TOPICID
 #define CFG_LORA_RX_STATUS_TLM_TOPICID  LORA_RX_STATUS_TLM_TOPICID
 #define CFG_LORA_RX_RADIO_TLM_TOPICID   LORA_RX_RADIO_TLM_TOPICID
+#define CFG_LORA_RX_RX_EVENT_TLM_TOPICID  LORA_RX_RX_EVENT_TLM_TOPICID
+#define CFG_LORA_RX_NACK_TLM_TOPICID    LORA_RX_NACK_TLM_TOPICID
+#define CFG_LORA_RX_LINK_TLM_TOPICID    LORA_RX_LINK_TLM_TOPICID
+#define CFG_LORA_RX_SWEEP_TLM_TOPICID   LORA_RX_SWEEP_TLM_TOPICID
 
 #define CFG_CHILD_NAME       CHILD_NAME
 #define CFG_CHILD_PERF_ID    CHILD_PERF_ID
@@ -86,6 +90,9 @@
 #define CFG_RADIO_SPI_DEV_STR  RADIO_SPI_DEV_STR
 #define CFG_RADIO_SPI_DEV_NUM  RADIO_SPI_DEV_NUM
 #define CFG_RADIO_SPI_SPEED    RADIO_SPI_SPEED
+#define CFG_SPI_CAL_AT_INIT    SPI_CAL_AT_INIT
+#define CFG_SPI_CAL_MAX_SPEED  SPI_CAL_MAX_SPEED
+#define CFG_SPI_CAL_PASSES     SPI_CAL_PASSES
 #define CFG_RADIO_PIN_BUSY     RADIO_PIN_BUSY
 #define CFG_RADIO_PIN_NRST     RADIO_PIN_NRST
 #define CFG_RADIO_PIN_NSS      RADIO_PIN_NSS
@@ -110,15 +117,82 @@
 #define CFG_RADIO_LORA_TXPA    RADIO_LORA_TXPA
 #define CFG_RADIO_LORA_RXLNA   RADIO_LORA_RXLNA
 
+#define CFG_RADIO_FLRC_BITRATE    RADIO_FLRC_BITRATE
+#define CFG_RADIO_FLRC_CR         RADIO_FLRC_CR
+#define CFG_RADIO_FLRC_SHAPING    RADIO_FLRC_SHAPING
+#define CFG_RADIO_FLRC_CRC        RADIO_FLRC_CRC
+#define CFG_RADIO_FLRC_SYNC_WORD  RADIO_FLRC_SYNC_WORD
+
+#define CFG_ARENA_BYTES        ARENA_BYTES
+#define CFG_FRAME_SLOTS        FRAME_SLOTS
+
+#define CFG_DEFRAMER_MAX_PKT_LEN  DEFRAMER_MAX_PKT_LEN
+#define CFG_DEFRAMER_RING_BYTES   DEFRAMER_RING_BYTES
+#define CFG_RX_TIME_CAL_NS     RX_TIME_CAL_NS
+
+#define CFG_DEFRAMER_PERF_ID      DEFRAMER_PERF_ID
+
+#define CFG_TRACE_ENABLE       TRACE_ENABLE
+#define CFG_TRACE_EVENTS       TRACE_EVENTS
+#define CFG_WAIT_PERF_ID       WAIT_PERF_ID
+#define CFG_SPI_READ_PERF_ID   SPI_READ_PERF_ID
+#define CFG_FILTER_PERF_ID     FILTER_PERF_ID
+#define CFG_PUBLISH_PERF_ID    PUBLISH_PERF_ID
+#define CFG_SPI_REC_ENABLE     SPI_REC_ENABLE
+
+#define CFG_TAP_ENABLE         TAP_ENABLE
+#define CFG_TAP_SHM_NAME       TAP_SHM_NAME
+#define CFG_TAP_SOCKET_PATH    TAP_SOCKET_PATH
+#define CFG_TAP_SLOTS          TAP_SLOTS
+
+#define CFG_SEC_REQUIRED       SEC_REQUIRED
+#define CFG_SEQ_NACK_PERIOD    SEQ_NACK_PERIOD
+#define CFG_LINK_EWMA_SHIFT    LINK_EWMA_SHIFT
+#define CFG_SEC_ACCEL          SEC_ACCEL
+#define CFG_SEC_PERF_ID        SEC_PERF_ID
+#define CFG_KEY_TBL_LOAD_FILE  KEY_TBL_LOAD_FILE
+
+#define CFG_DECOMP_WINDOW_BITS     DECOMP_WINDOW_BITS
+#define CFG_DECOMP_LOOKAHEAD_BITS  DECOMP_LOOKAHEAD_BITS
+#define CFG_DECOMP_MAX_LEN         DECOMP_MAX_LEN
+#define CFG_DECOMP_PERF_ID         DECOMP_PERF_ID
+
+#define CFG_DECODE_WORKERS  DECODE_WORKERS
+#define CFG_DECODE_DEPTH    DECODE_DEPTH
+
+#define CFG_WATCHDOG_BUSY_TIMEOUT_US  WATCHDOG_BUSY_TIMEOUT_US
+#define CFG_WATCHDOG_RX_SILENCE_MS    WATCHDOG_RX_SILENCE_MS
+
+#define CFG_VCHAN_SHM_NAME     VCHAN_SHM_NAME
+#define CFG_VCHAN_LOSS_PPM     VCHAN_LOSS_PPM
+#define CFG_VCHAN_CORRUPT_PPM  VCHAN_CORRUPT_PPM
+#define CFG_VCHAN_DELAY_US     VCHAN_DELAY_US
+#define CFG_VCHAN_DOPPLER_HZ   VCHAN_DOPPLER_HZ
+#define CFG_VCHAN_SEED         VCHAN_SEED
+
+#define CFG_RADIO_AUTO_INIT     RADIO_AUTO_INIT
+#define CFG_SCAN_RELOCK_MS      SCAN_RELOCK_MS
+#define CFG_SNIFF_RX_US         SNIFF_RX_US
+#define CFG_SNIFF_SLEEP_US      SNIFF_SLEEP_US
+#define CFG_SCAN_TBL_LOAD_FILE  SCAN_TBL_LOAD_FILE
+#define CFG_PROFILE_TBL_LOAD_FILE  PROFILE_TBL_LOAD_FILE
+#define CFG_SCHED_LEAD_US        SCHED_LEAD_US
+#define CFG_SCHED_LATE_LIMIT_US  SCHED_LATE_LIMIT_US
+#define CFG_SCHED_TBL_LOAD_FILE  SCHED_TBL_LOAD_FILE
+
 #define APP_CONFIG(XX) \
    XX(APP_CFE_NAME,char*) \
    XX(APP_PERF_ID,uint32) \
    XX(APP_CMD_PIPE_NAME,char*) \
    XX(APP_CMD_PIPE_DEPTH,uint32) \
-   XX(LORA_TX_CMD_TOPICID,uint32) \
+   XX(LORA_RX_CMD_TOPICID,uint32) \
    XX(BC_SCH_1_HZ_TOPICID,uint32) \
-   XX(LORA_TX_STATUS_TLM_TOPICID,uint32) \
-   XX(LORA_TX_RADIO_TLM_TOPICID,uint32) \
+   XX(LORA_RX_STATUS_TLM_TOPICID,uint32) \
+   XX(LORA_RX_RADIO_TLM_TOPICID,uint32) \
+   XX(LORA_RX_RX_EVENT_TLM_TOPICID,uint32) \
+   XX(LORA_RX_NACK_TLM_TOPICID,uint32) \
+   XX(LORA_RX_LINK_TLM_TOPICID,uint32) \
+   XX(LORA_RX_SWEEP_TLM_TOPICID,uint32) \
    XX(CHILD_NAME,char*) \
    XX(CHILD_PERF_ID,uint32) \
    XX(CHILD_STACK_SIZE,uint32) \
@@ -126,6 +200,9 @@
    XX(RADIO_SPI_DEV_STR,char*) \
    XX(RADIO_SPI_DEV_NUM,uint32) \
    XX(RADIO_SPI_SPEED,uint32) \
+   XX(SPI_CAL_AT_INIT,uint32) \
+   XX(SPI_CAL_MAX_SPEED,uint32) \
+   XX(SPI_CAL_PASSES,uint32) \
    XX(RADIO_PIN_BUSY,uint32) \
    XX(RADIO_PIN_NRST,uint32) \
    XX(RADIO_PIN_NSS,uint32) \
@@ -147,7 +224,58 @@
    XX(RADIO_LORA_NODE, uint32)\
    XX(RADIO_LORA_DEST, uint32)\
    XX(RADIO_LORA_TXPA, uint32)\
-   XX(RADIO_LORA_RXLNA, uint32)
+   XX(RADIO_LORA_RXLNA, uint32)\
+   XX(RADIO_FLRC_BITRATE, uint32)\
+   XX(RADIO_FLRC_CR, uint32)\
+   XX(RADIO_FLRC_SHAPING, uint32)\
+   XX(RADIO_FLRC_CRC, uint32)\
+   XX(RADIO_FLRC_SYNC_WORD, uint32)\
+   XX(RX_TIME_CAL_NS, uint32)\
+   XX(ARENA_BYTES, uint32)\
+   XX(FRAME_SLOTS, uint32)\
+   XX(DEFRAMER_MAX_PKT_LEN, uint32)\
+   XX(DEFRAMER_RING_BYTES, uint32)\
+   XX(DEFRAMER_PERF_ID, uint32)\
+   XX(TRACE_ENABLE, uint32)\
+   XX(TRACE_EVENTS, uint32)\
+   XX(WAIT_PERF_ID, uint32)\
+   XX(SPI_READ_PERF_ID, uint32)\
+   XX(FILTER_PERF_ID, uint32)\
+   XX(PUBLISH_PERF_ID, uint32)\
+   XX(SPI_REC_ENABLE, uint32)\
+   XX(TAP_ENABLE, uint32)\
+   XX(TAP_SHM_NAME, char*)\
+   XX(TAP_SOCKET_PATH, char*)\
+   XX(TAP_SLOTS, uint32)\
+   XX(SEC_REQUIRED, uint32)\
+   XX(SEQ_NACK_PERIOD, uint32)\
+   XX(LINK_EWMA_SHIFT, uint32)\
+   XX(SEC_ACCEL, uint32)\
+   XX(SEC_PERF_ID, uint32)\
+   XX(KEY_TBL_LOAD_FILE, char*)\
+   XX(DECOMP_WINDOW_BITS, uint32)\
+   XX(DECOMP_LOOKAHEAD_BITS, uint32)\
+   XX(DECOMP_MAX_LEN, uint32)\
+   XX(DECOMP_PERF_ID, uint32)\
+   XX(DECODE_WORKERS, uint32)\
+   XX(DECODE_DEPTH, uint32)\
+   XX(WATCHDOG_BUSY_TIMEOUT_US, uint32)\
+   XX(WATCHDOG_RX_SILENCE_MS, uint32)\
+   XX(VCHAN_SHM_NAME, char*)\
+   XX(VCHAN_LOSS_PPM, uint32)\
+   XX(VCHAN_CORRUPT_PPM, uint32)\
+   XX(VCHAN_DELAY_US, uint32)\
+   XX(VCHAN_DOPPLER_HZ, uint32)\
+   XX(VCHAN_SEED, uint32)\
+   XX(RADIO_AUTO_INIT, uint32)\
+   XX(SCAN_RELOCK_MS, uint32)\
+   XX(SNIFF_RX_US, uint32)\
+   XX(SNIFF_SLEEP_US, uint32)\
+   XX(SCAN_TBL_LOAD_FILE, char*)\
+   XX(PROFILE_TBL_LOAD_FILE, char*)\
+   XX(SCHED_LEAD_US, uint32)\
+   XX(SCHED_LATE_LIMIT_US, uint32)\
+   XX(SCHED_TBL_LOAD_FILE, char*)
    
 DECLARE_ENUM(Config,APP_CONFIG)
 
@@ -162,6 +290,12 @@ DECLARE_ENUM(Config,APP_CONFIG)
 
 #define LORA_RX_BASE_EID   (APP_C_FW_APP_BASE_EID +  0)
 #define RADIO_IF_BASE_EID  (APP_C_FW_APP_BASE_EID + 20)
+#define KEY_TBL_BASE_EID   (APP_C_FW_APP_BASE_EID + 40)
+#define SCAN_TBL_BASE_EID  (APP_C_FW_APP_BASE_EID + 50)
+#define PROFILE_TBL_BASE_EID  (APP_C_FW_APP_BASE_EID + 60)
+#define SCHED_TBL_BASE_EID    (APP_C_FW_APP_BASE_EID + 70)
+#define SWEEP_BASE_EID        (APP_C_FW_APP_BASE_EID + 80)
+#define WATCHDOG_BASE_EID     (APP_C_FW_APP_BASE_EID + 90)
 
 
 #endif /* _app_cfg_ */
@@ -0,0 +1,307 @@
+/*
+**  This program is free software: you can redistribute it and/or modify
+**  it under the terms of the GNU Lesser General Public License as
+**  published by the Free Software Foundation, either version 3 of the
+**  License, or (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Lesser General Public License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public License
+**  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+**
+**  Purpose:
+**    Implement the CCSDS space packet deframer class
+**
+**  Notes:
+**    1. See ccsds_deframer.h for details.
+**
+*/
+
+/*
+** Include Files:
+*/
+
+#include <string.h>
+#include "ccsds_deframer.h"
+
+
+/*******************************/
+/** Local Function Prototypes **/
+/*******************************/
+
+static void     Append(CCSDS_DEFRAMER_Class_t *Deframer, const uint8_t *Data, uint16_t Len);
+static void     Discard(CCSDS_DEFRAMER_Class_t *Deframer);
+static void     Extract(CCSDS_DEFRAMER_Class_t *Deframer);
+static uint8_t  PeekByte(const CCSDS_DEFRAMER_Class_t *Deframer, uint32_t Offset);
+
+
+/******************************************************************************
+** Function: CCSDS_DEFRAMER_Constructor
+**
+*/
+bool CCSDS_DEFRAMER_Constructor(CCSDS_DEFRAMER_Class_t *Deframer, uint16_t MaxPktLen,
+                                uint8_t *Ring, uint32_t RingSize,
+                                CCSDS_DEFRAMER_EmitFunc_t EmitFunc, void *EmitCtx)
+{
+
+   memset(Deframer, 0, sizeof(CCSDS_DEFRAMER_Class_t));
+
+   if (Ring == NULL || RingSize < CCSDS_DEFRAMER_MIN_RING_SIZE || 
+       RingSize > CCSDS_DEFRAMER_MAX_RING_SIZE || (RingSize & (RingSize - 1)) != 0)
+   {
+      return false;
+   }
+
+   if (MaxPktLen > CCSDS_DEFRAMER_MAX_PKT_LEN(RingSize))
+   {
+      MaxPktLen = CCSDS_DEFRAMER_MAX_PKT_LEN(RingSize);
+   }
+   if (MaxPktLen < CCSDS_DEFRAMER_MIN_PKT_LEN)
+   {
+      MaxPktLen = CCSDS_DEFRAMER_MIN_PKT_LEN;
+   }
+
+   Deframer->MaxPktLen = MaxPktLen;
+   Deframer->Ring      = Ring;
+   Deframer->RingMask  = RingSize - 1;
+   Deframer->EmitFunc  = EmitFunc;
+   Deframer->EmitCtx   = EmitCtx;
+   Deframer->InSync    = false;
+
+   return true;
+
+} /* End CCSDS_DEFRAMER_Constructor() */
+
+
+/******************************************************************************
+** Function: CCSDS_DEFRAMER_ResetStatus
+**
+*/
+void CCSDS_DEFRAMER_ResetStatus(CCSDS_DEFRAMER_Class_t *Deframer)
+{
+
+   memset(&Deframer->Stats, 0, sizeof(CCSDS_DEFRAMER_Stats_t));
+
+} /* End CCSDS_DEFRAMER_ResetStatus() */
+
+
+/******************************************************************************
+** Function: CCSDS_DEFRAMER_Write
+**
+** Notes:
+**   1. Bytes before the first header pointer complete the packet in
+**      progress. If anything is left in the ring once they're consumed then
+**      the packet boundaries disagree with the transmitter and the partial
+**      packet is discarded.
+**
+*/
+void CCSDS_DEFRAMER_Write(CCSDS_DEFRAMER_Class_t *Deframer, const uint8_t *Data,
+                          uint16_t Len, uint8_t Fhp, bool SeqGap)
+{
+
+   if (SeqGap && Deframer->InSync)
+   {
+      if (Deframer->Head != Deframer->Tail)
+      {
+         Deframer->Stats.GapCnt++;
+      }
+      Discard(Deframer);
+   }
+
+   if (Fhp == RX_FRAME_FHP_NONE || Fhp >= Len)
+   {
+      if (Deframer->InSync)
+      {
+         Append(Deframer, Data, Len);
+         Extract(Deframer);
+      }
+      else
+      {
+         Deframer->Stats.DiscardByteCnt += Len;
+      }
+   }
+   else
+   {
+      if (Deframer->InSync)
+      {
+         Append(Deframer, Data, Fhp);
+         Extract(Deframer);
+         if (Deframer->Head != Deframer->Tail)
+         {
+            Deframer->Stats.ResyncCnt++;
+            Discard(Deframer);
+         }
+      }
+      else
+      {
+         Deframer->Stats.DiscardByteCnt += Fhp;
+      }
+
+      Deframer->InSync = true;
+      Append(Deframer, &Data[Fhp], Len - Fhp);
+      Extract(Deframer);
+   }
+
+} /* End CCSDS_DEFRAMER_Write() */
+
+
+/******************************************************************************
+** Function: Append
+**
+** Notes:
+**   1. The ring is sized so an in-sync append can't overflow: Extract()
+**      never leaves more than MaxPktLen-1 bytes behind and a frame adds at
+**      most RX_FRAME_MAX_DATA_LEN. The check is kept as a safety net.
+**
+*/
+static void Append(CCSDS_DEFRAMER_Class_t *Deframer, const uint8_t *Data, uint16_t Len)
+{
+
+   uint32_t Fill = Deframer->Head - Deframer->Tail;
+   uint32_t Index;
+   uint32_t FirstLen;
+
+   if (Len == 0)
+   {
+      return;
+   }
+
+   if (Fill + Len > Deframer->RingMask + 1)
+   {
+      Deframer->Stats.ResyncCnt++;
+      Deframer->Stats.DiscardByteCnt += Len;
+      Discard(Deframer);
+      return;
+   }
+
+   Index    = Deframer->Head & Deframer->RingMask;
+   FirstLen = Deframer->RingMask + 1 - Index;
+
+   if (Len <= FirstLen)
+   {
+      memcpy(&Deframer->Ring[Index], Data, Len);
+   }
+   else
+   {
+      memcpy(&Deframer->Ring[Index], Data, FirstLen);
+      memcpy(Deframer->Ring, &Data[FirstLen], Len - FirstLen);
+   }
+
+   Deframer->Head += Len;
+
+   Fill += Len;
+   if (Fill > Deframer->Stats.RingHighWater)
+   {
+      Deframer->Stats.RingHighWater = (uint16_t)Fill;
+   }
+
+} /* End Append() */
+
+
+/******************************************************************************
+** Function: Discard
+**
+** Drop any partial packet and wait for the next first header pointer
+**
+*/
+static void Discard(CCSDS_DEFRAMER_Class_t *Deframer)
+{
+
+   Deframer->Stats.DiscardByteCnt += (Deframer->Head - Deframer->Tail);
+   Deframer->Tail   = Deframer->Head;
+   Deframer->InSync = false;
+
+} /* End Discard() */
+
+
+/******************************************************************************
+** Function: Extract
+**
+** Emit every complete packet in the ring
+**
+** Notes:
+**   1. Header validation is limited to what can be checked without mission
+**      knowledge: version number zero and a length within the configured
+**      limits.
+**
+*/
+static void Extract(CCSDS_DEFRAMER_Class_t *Deframer)
+{
+
+   uint32_t Fill;
+   uint32_t PktLen;
+   uint32_t Index;
+   uint32_t FirstLen;
+   uint16_t Apid;
+   bool     Emitted;
+
+   while ((Fill = Deframer->Head - Deframer->Tail) >= CCSDS_DEFRAMER_PRI_HDR_LEN)
+   {
+
+      PktLen = (((uint32_t)PeekByte(Deframer, 4) << 8) | PeekByte(Deframer, 5)) + 7;
+
+      if ((PeekByte(Deframer, 0) & 0xE0) != 0 || PktLen > Deframer->MaxPktLen)
+      {
+         Deframer->Stats.ResyncCnt++;
+         Discard(Deframer);
+         break;
+      }
+
+      if (PktLen > Fill)
+      {
+         break;
+      }
+
+      Apid = ((uint16_t)(PeekByte(Deframer, 0) & 0x07) << 8) | PeekByte(Deframer, 1);
+
+      if (Apid == CCSDS_DEFRAMER_IDLE_APID)
+      {
+         Deframer->Stats.IdlePktCnt++;
+      }
+      else
+      {
+         Index    = Deframer->Tail & Deframer->RingMask;
+         FirstLen = Deframer->RingMask + 1 - Index;
+
+         if (PktLen <= FirstLen)
+         {
+            Emitted = Deframer->EmitFunc(Deframer->EmitCtx, &Deframer->Ring[Index],
+                                         (uint16_t)PktLen, NULL, 0);
+         }
+         else
+         {
+            Emitted = Deframer->EmitFunc(Deframer->EmitCtx, &Deframer->Ring[Index],
+                                         (uint16_t)FirstLen, Deframer->Ring,
+                                         (uint16_t)(PktLen - FirstLen));
+         }
+
+         if (Emitted)
+         {
+            Deframer->Stats.PktCnt++;
+         }
+         else
+         {
+            Deframer->Stats.EmitErrCnt++;
+         }
+      }
+
+      Deframer->Tail += PktLen;
+
+   } /* End while */
+
+} /* End Extract() */
+
+
+/******************************************************************************
+** Function: PeekByte
+**
+*/
+static uint8_t PeekByte(const CCSDS_DEFRAMER_Class_t *Deframer, uint32_t Offset)
+{
+
+   return Deframer->Ring[(Deframer->Tail + Offset) & Deframer->RingMask];
+
+} /* End PeekByte() */
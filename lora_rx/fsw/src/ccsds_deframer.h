@@ -0,0 +1,169 @@
+/*
+**  This program is free software: you can redistribute it and/or modify
+**  it under the terms of the GNU Lesser General Public License as
+**  published by the Free Software Foundation, either version 3 of the
+**  License, or (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Lesser General Public License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public License
+**  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+**
+**  Purpose:
+**    Define the CCSDS space packet deframer class
+**
+**  Notes:
+**    1. Extracts CCSDS space packets from the byte stream carried in the
+**       data field of consecutive LoRa frames. Packets may straddle any
+**       number of frames and are delimited using the primary header's
+**       packet length field.
+**    2. Bytes are staged in a power-of-2 ring supplied by the owner when
+**       the deframer is constructed so no memory is allocated per
+**       packet. A complete packet is handed to the emit callback as one or
+**       two contiguous segments (two when the packet wraps the end of the
+**       ring) so the owner can copy it once into its output buffer.
+**    3. Sync is established and re-established using the frame's first
+**       header pointer (see rx_frame.h). A frame sequence gap, a primary
+**       header that fails validation or a packet that doesn't end where
+**       the next frame's first header pointer says it should discards the
+**       partial packet and waits for the next first header pointer.
+**    4. This header shouldn't include cFS or Lora_Rx app C header files so
+**       the deframer can be exercised outside of cFS.
+**
+*/
+
+#ifndef _ccsds_deframer_
+#define _ccsds_deframer_
+
+/*
+** Includes
+*/
+#include <stdbool.h>
+#include <stdint.h>
+#include "rx_frame.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define CCSDS_DEFRAMER_MIN_RING_SIZE  1024    /* Ring sizes must be a power of 2 */
+#define CCSDS_DEFRAMER_MAX_RING_SIZE  32768   /* Fill fits RingHighWater */
+
+#define CCSDS_DEFRAMER_PRI_HDR_LEN  6
+#define CCSDS_DEFRAMER_MIN_PKT_LEN  (CCSDS_DEFRAMER_PRI_HDR_LEN + 1)
+
+/* Largest packet that is guaranteed to fit with a full frame of lookahead */
+#define CCSDS_DEFRAMER_MAX_PKT_LEN(RingSize)  ((RingSize) - RX_FRAME_MAX_DATA_LEN)
+
+#define CCSDS_DEFRAMER_IDLE_APID  0x07FF
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+/*
+** Emit a complete packet. Seg2 is NULL and Seg2Len is 0 when the packet
+** is contiguous in the ring. Returns false if the packet couldn't be
+** delivered.
+*/
+typedef bool (*CCSDS_DEFRAMER_EmitFunc_t)(void *EmitCtx,
+                                          const uint8_t *Seg1, uint16_t Seg1Len,
+                                          const uint8_t *Seg2, uint16_t Seg2Len);
+
+typedef struct
+{
+
+   uint32_t PktCnt;          /* Packets emitted                                  */
+   uint32_t IdlePktCnt;      /* Idle packets discarded                           */
+   uint32_t ResyncCnt;       /* Invalid headers and packet/FHP boundary errors   */
+   uint32_t GapCnt;          /* Partial packets discarded due to a sequence gap  */
+   uint32_t DiscardByteCnt;  /* Bytes dropped while out of sync                  */
+   uint32_t EmitErrCnt;      /* Emit callback failures                           */
+   uint16_t RingHighWater;   /* Maximum ring fill in bytes                       */
+
+} CCSDS_DEFRAMER_Stats_t;
+
+
+/******************************************************************************
+** CCSDS_DEFRAMER_Class
+*/
+typedef struct
+{
+
+   /*
+   ** Configuration
+   */
+
+   uint16_t MaxPktLen;
+   uint32_t RingMask;
+   CCSDS_DEFRAMER_EmitFunc_t EmitFunc;
+   void    *EmitCtx;
+
+   /*
+   ** State Data
+   */
+
+   bool     InSync;
+   uint32_t Head;      /* Free running write index */
+   uint32_t Tail;      /* Free running read index  */
+
+   CCSDS_DEFRAMER_Stats_t Stats;
+
+   uint8_t  *Ring;
+
+} CCSDS_DEFRAMER_Class_t;
+
+
+/************************/
+/** Exported Functions **/
+/************************/
+
+
+/******************************************************************************
+** Function: CCSDS_DEFRAMER_Constructor
+**
+** Initialize the deframer to a known out of sync state
+**
+** Notes:
+**   1. Ring holds RingSize bytes and must stay valid for the life of the
+**      deframer. Returns false if RingSize isn't a power of 2 between the
+**      minimum and maximum ring sizes.
+**   2. MaxPktLen is limited to CCSDS_DEFRAMER_MAX_PKT_LEN(RingSize).
+**
+*/
+bool CCSDS_DEFRAMER_Constructor(CCSDS_DEFRAMER_Class_t *Deframer, uint16_t MaxPktLen,
+                                uint8_t *Ring, uint32_t RingSize,
+                                CCSDS_DEFRAMER_EmitFunc_t EmitFunc, void *EmitCtx);
+
+
+/******************************************************************************
+** Function: CCSDS_DEFRAMER_ResetStatus
+**
+** Reset counters to a known state. Sync state is not changed.
+**
+*/
+void CCSDS_DEFRAMER_ResetStatus(CCSDS_DEFRAMER_Class_t *Deframer);
+
+
+/******************************************************************************
+** Function: CCSDS_DEFRAMER_Write
+**
+** Process the data field of one received frame
+**
+** Notes:
+**   1. Fhp is the frame's first header pointer or RX_FRAME_FHP_NONE.
+**   2. SeqGap must be true if one or more frames were lost since the
+**      previous call.
+**   3. Emits zero or more packets before returning.
+**
+*/
+void CCSDS_DEFRAMER_Write(CCSDS_DEFRAMER_Class_t *Deframer, const uint8_t *Data,
+                          uint16_t Len, uint8_t Fhp, bool SeqGap);
+
+
+#endif /* _ccsds_deframer_ */
@@ -0,0 +1,319 @@
+/*
+**  This program is free software: you can redistribute it and/or modify
+**  it under the terms of the GNU Lesser General Public License as
+**  published by the Free Software Foundation, either version 3 of the
+**  License, or (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Lesser General Public License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public License
+**  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+**
+**  Purpose:
+**    Implement the receive security key table
+**
+**  Notes:
+**    1. See key_tbl.h for details.
+**
+*/
+
+/*
+** Include Files:
+*/
+
+#include <stdio.h>
+#include <string.h>
+#include "key_tbl.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define JSON_OBJ_CNT  (2*RX_SEC_MAX_KEYS)
+#define QUERY_LEN     32
+
+
+/**********************/
+/** Global File Data **/
+/**********************/
+
+static KEY_TBL_Class_t *KeyTbl = NULL;
+
+static KEY_TBL_Entry_t TblEntry[RX_SEC_MAX_KEYS];  /* Working buffer for loads */
+
+static CJSON_Obj_t JsonTblObjs[JSON_OBJ_CNT];
+static char        JsonQuery[JSON_OBJ_CNT][QUERY_LEN];
+
+
+/*******************************/
+/** Local Function Prototypes **/
+/*******************************/
+
+static bool HexToBytes(const char *HexStr, uint8 *Bytes, uint8 *ByteLen);
+static bool LoadJsonData(size_t JsonFileLen);
+static void WipeLoadData(void);
+
+
+/******************************************************************************
+** Function: KEY_TBL_Constructor
+**
+*/
+void KEY_TBL_Constructor(KEY_TBL_Class_t *KeyTblPtr, RX_SEC_Class_t *RxSec)
+{
+
+   uint16 i;
+
+   KeyTbl = KeyTblPtr;
+
+   memset(KeyTbl, 0, sizeof(KEY_TBL_Class_t));
+
+   KeyTbl->RxSec = RxSec;
+
+   for (i = 0; i < RX_SEC_MAX_KEYS; i++)
+   {
+      snprintf(JsonQuery[2*i],   QUERY_LEN, "key[%d].id",    i);
+      snprintf(JsonQuery[2*i+1], QUERY_LEN, "key[%d].value", i);
+      CJSON_ObjConstructor(&JsonTblObjs[2*i],   JsonQuery[2*i],   JSONNumber, &TblEntry[i].Id,    2);
+      CJSON_ObjConstructor(&JsonTblObjs[2*i+1], JsonQuery[2*i+1], JSONString, TblEntry[i].Value, KEY_TBL_HEX_STR_LEN);
+   }
+   KeyTbl->JsonObjCnt = JSON_OBJ_CNT;
+
+} /* End KEY_TBL_Constructor() */
+
+
+/******************************************************************************
+** Function: KEY_TBL_ResetStatus
+**
+*/
+void KEY_TBL_ResetStatus(void)
+{
+
+   /* Nothing to do */
+
+} /* End KEY_TBL_ResetStatus() */
+
+
+/******************************************************************************
+** Function: KEY_TBL_DumpCmd
+**
+** Notes:
+**  1. Function signature must match TBLMGR_DumpTblFuncPtr_t.
+**  2. Can assume valid table filename because this is a callback from
+**     the app framework table manager that has verified the file.
+**  3. DumpType is unused.
+**
+*/
+bool KEY_TBL_DumpCmd(TBLMGR_Tbl_t *Tbl, uint8 DumpType, const char *Filename)
+{
+
+   bool       RetStatus = false;
+   int32      SysStatus;
+   osal_id_t  FileHandle;
+   uint16     i;
+   char       DumpRecord[256];
+
+   SysStatus = OS_OpenCreate(&FileHandle, Filename, OS_FILE_FLAG_CREATE | OS_FILE_FLAG_TRUNCATE, OS_WRITE_ONLY);
+
+   if (SysStatus == OS_SUCCESS)
+   {
+
+      sprintf(DumpRecord,"{\n   \"name\": \"LoRa Receive Key Table\",\n   \"description\": \"Key values are not dumped\",\n   \"key\": [\n");
+      OS_write(FileHandle, DumpRecord, strlen(DumpRecord));
+
+      for (i = 0; i < KeyTbl->KeyCnt; i++)
+      {
+         sprintf(DumpRecord,"      {\"id\": %d, \"length\": %d}%s\n",
+                 KeyTbl->KeyId[i], KeyTbl->KeyLen[i], (i < KeyTbl->KeyCnt-1) ? "," : "");
+         OS_write(FileHandle, DumpRecord, strlen(DumpRecord));
+      }
+
+      sprintf(DumpRecord,"   ]\n}\n");
+      OS_write(FileHandle, DumpRecord, strlen(DumpRecord));
+
+      OS_close(FileHandle);
+
+      CFE_EVS_SendEvent(KEY_TBL_DUMP_EID, CFE_EVS_EventType_DEBUG,
+                        "Successfully dumped key table IDs to %s", Filename);
+      RetStatus = true;
+
+   } /* End if file create */
+   else
+   {
+
+      CFE_EVS_SendEvent(KEY_TBL_DUMP_EID, CFE_EVS_EventType_ERROR,
+                        "Error creating dump file '%s', status=0x%08X",
+                        Filename, SysStatus);
+
+   } /* End if file create error */
+
+   return RetStatus;
+
+} /* End of KEY_TBL_DumpCmd() */
+
+
+/******************************************************************************
+** Function: KEY_TBL_LoadCmd
+**
+** Notes:
+**  1. Function signature must match TBLMGR_LoadTblFuncPtr_t.
+**  2. This could migrate into table manager but I think I'll keep it here
+**     so user's can add table processing code if needed.
+**
+*/
+bool KEY_TBL_LoadCmd(TBLMGR_Tbl_t *Tbl, uint8 LoadType, const char *Filename)
+{
+
+   bool RetStatus = false;
+
+   if (LoadType == TBLMGR_LOAD_TBL_REPLACE)
+   {
+      if (CJSON_ProcessFile(Filename, KeyTbl->JsonBuf, KEY_TBL_JSON_FILE_MAX_CHAR, LoadJsonData))
+      {
+         KeyTbl->Loaded = true;
+         RetStatus = true;
+      }
+   }
+   else
+   {
+      CFE_EVS_SendEvent(KEY_TBL_LOAD_EID, CFE_EVS_EventType_ERROR,
+                        "Key table load rejected, only replace loads are supported");
+   }
+
+   WipeLoadData();
+
+   return RetStatus;
+
+} /* End KEY_TBL_LoadCmd() */
+
+
+/******************************************************************************
+** Function: LoadJsonData
+**
+** Notes:
+**  1. Key entries must be contiguous starting at key[0]. An entry must have
+**     both an id and a value.
+**
+*/
+static bool LoadJsonData(size_t JsonFileLen)
+{
+
+   bool   RetStatus = false;
+   uint16 KeyCnt;
+   uint16 i;
+   RX_SEC_KeyDef_t KeyDef[RX_SEC_MAX_KEYS];
+
+   KeyTbl->JsonFileLen = JsonFileLen;
+
+   memset(TblEntry, 0, sizeof(TblEntry));
+   for (i = 0; i < JSON_OBJ_CNT; i++)
+   {
+      JsonTblObjs[i].Updated = false;
+   }
+
+   CJSON_LoadObjArray(JsonTblObjs, KeyTbl->JsonObjCnt, KeyTbl->JsonBuf, KeyTbl->JsonFileLen);
+
+   for (KeyCnt = 0; KeyCnt < RX_SEC_MAX_KEYS; KeyCnt++)
+   {
+      if (!JsonTblObjs[2*KeyCnt].Updated || !JsonTblObjs[2*KeyCnt+1].Updated)
+      {
+         break;
+      }
+      KeyDef[KeyCnt].Id = (uint8)TblEntry[KeyCnt].Id;
+      if (TblEntry[KeyCnt].Id >= RX_SEC_MAX_KEYS ||
+          !HexToBytes(TblEntry[KeyCnt].Value, KeyDef[KeyCnt].Value, &KeyDef[KeyCnt].Len))
+      {
+         CFE_EVS_SendEvent(KEY_TBL_LOAD_EID, CFE_EVS_EventType_ERROR,
+                           "Key table load rejected, key[%d] has an invalid id or value", KeyCnt);
+         memset(KeyDef, 0, sizeof(KeyDef));
+         return false;
+      }
+   }
+
+   if (KeyCnt == 0)
+   {
+      CFE_EVS_SendEvent(KEY_TBL_LOAD_EID, CFE_EVS_EventType_ERROR,
+                        "Key table load rejected, no keys defined");
+   }
+   else if (RX_SEC_LoadKeys(KeyTbl->RxSec, KeyDef, KeyCnt))
+   {
+      KeyTbl->KeyCnt = KeyCnt;
+      for (i = 0; i < KeyCnt; i++)
+      {
+         KeyTbl->KeyId[i]  = KeyDef[i].Id;
+         KeyTbl->KeyLen[i] = KeyDef[i].Len;
+      }
+      CFE_EVS_SendEvent(KEY_TBL_LOAD_EID, CFE_EVS_EventType_INFORMATION,
+                        "Loaded %d security keys", KeyCnt);
+      RetStatus = true;
+   }
+   else
+   {
+      CFE_EVS_SendEvent(KEY_TBL_LOAD_EID, CFE_EVS_EventType_ERROR,
+                        "Key table load rejected by the security stage, previous load pending or invalid key length");
+   }
+
+   memset(KeyDef, 0, sizeof(KeyDef));
+
+   return RetStatus;
+
+} /* End LoadJsonData() */
+
+
+/******************************************************************************
+** Function: HexToBytes
+**
+** Notes:
+**  1. Only AES key lengths (16, 24 or 32 bytes) are accepted.
+**
+*/
+static bool HexToBytes(const char *HexStr, uint8 *Bytes, uint8 *ByteLen)
+{
+
+   size_t StrLen = strlen(HexStr);
+   size_t i;
+   uint8  Nibble[2];
+   int    n;
+   char   c;
+
+   if (StrLen != 32 && StrLen != 48 && StrLen != 64)
+   {
+      return false;
+   }
+
+   for (i = 0; i < StrLen/2; i++)
+   {
+      for (n = 0; n < 2; n++)
+      {
+         c = HexStr[2*i+n];
+         if (c >= '0' && c <= '9')      Nibble[n] = c - '0';
+         else if (c >= 'a' && c <= 'f') Nibble[n] = c - 'a' + 10;
+         else if (c >= 'A' && c <= 'F') Nibble[n] = c - 'A' + 10;
+         else return false;
+      }
+      Bytes[i] = (Nibble[0] << 4) | Nibble[1];
+   }
+
+   *ByteLen = (uint8)(StrLen/2);
+
+   return true;
+
+} /* End HexToBytes() */
+
+
+/******************************************************************************
+** Function: WipeLoadData
+**
+** Clear every copy of the key values that the load made
+**
+*/
+static void WipeLoadData(void)
+{
+
+   memset(TblEntry, 0, sizeof(TblEntry));
+   memset(KeyTbl->JsonBuf, 0, sizeof(KeyTbl->JsonBuf));
+
+} /* End WipeLoadData() */
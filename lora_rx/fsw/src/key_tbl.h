@@ -0,0 +1,144 @@
+/*
+**  This program is free software: you can redistribute it and/or modify
+**  it under the terms of the GNU Lesser General Public License as
+**  published by the Free Software Foundation, either version 3 of the
+**  License, or (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Lesser General Public License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public License
+**  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+**
+**  Purpose:
+**    Define the receive security key table
+**
+**  Notes:
+**    1. Keys are hex strings in a JSON table file. A load replaces the
+**       complete key set in the security stage, see rx_sec.h.
+**    2. Key values are never copied into telemetry, events or table dump
+**       files. A dump only reports which key IDs are loaded and their
+**       lengths. The JSON buffer is cleared after each load.
+**
+*/
+
+#ifndef _key_tbl_
+#define _key_tbl_
+
+/*
+** Includes
+*/
+
+#include "app_cfg.h"
+#include "rx_sec.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+
+/*
+** Event Message IDs
+*/
+
+#define KEY_TBL_DUMP_EID  (KEY_TBL_BASE_EID + 0)
+#define KEY_TBL_LOAD_EID  (KEY_TBL_BASE_EID + 1)
+
+#define KEY_TBL_NAME  "Key"
+
+#define KEY_TBL_JSON_FILE_MAX_CHAR  4000
+#define KEY_TBL_HEX_STR_LEN        (2*RX_SEC_MAX_KEY_LEN + 1)
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+
+typedef struct
+{
+   uint16  Id;
+   char    Value[KEY_TBL_HEX_STR_LEN];
+
+} KEY_TBL_Entry_t;
+
+
+/******************************************************************************
+** KEY_TBL_Class
+*/
+typedef struct
+{
+
+   /*
+   ** Class State Data
+   */
+
+   RX_SEC_Class_t *RxSec;
+
+   bool   Loaded;
+   uint16 KeyCnt;
+   uint8  KeyId[RX_SEC_MAX_KEYS];
+   uint8  KeyLen[RX_SEC_MAX_KEYS];
+
+   size_t JsonObjCnt;
+   char   JsonBuf[KEY_TBL_JSON_FILE_MAX_CHAR];
+   size_t JsonFileLen;
+
+} KEY_TBL_Class_t;
+
+
+/************************/
+/** Exported Functions **/
+/************************/
+
+
+/******************************************************************************
+** Function: KEY_TBL_Constructor
+**
+** Initialize the key table object to a known state
+**
+** Notes:
+**   1. This must be called prior to any other function.
+**   2. Loaded keys are pushed into RxSec.
+**
+*/
+void KEY_TBL_Constructor(KEY_TBL_Class_t *KeyTblPtr, RX_SEC_Class_t *RxSec);
+
+
+/******************************************************************************
+** Function: KEY_TBL_DumpCmd
+**
+** Write the key IDs and lengths, but not the key values, to a JSON file
+**
+** Notes:
+**  1. Function signature must match TBLMGR_DumpTblFuncPtr_t.
+**
+*/
+bool KEY_TBL_DumpCmd(TBLMGR_Tbl_t *Tbl, uint8 DumpType, const char *Filename);
+
+
+/******************************************************************************
+** Function: KEY_TBL_LoadCmd
+**
+** Notes:
+**  1. Function signature must match TBLMGR_LoadTblFuncPtr_t.
+**  2. Only replace loads are supported because a key set is always loaded
+**     as a unit.
+**
+*/
+bool KEY_TBL_LoadCmd(TBLMGR_Tbl_t *Tbl, uint8 LoadType, const char *Filename);
+
+
+/******************************************************************************
+** Function: KEY_TBL_ResetStatus
+**
+** Reset counters and status flags to a known reset state.
+**
+*/
+void KEY_TBL_ResetStatus(void);
+
+
+#endif /* _key_tbl_ */
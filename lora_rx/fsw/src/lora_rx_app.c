@@ -26,6 +26,7 @@
 
 #include <string.h>
 #include "lora_rx_app.h"
+#include "radio_rx.h"
 #include "lora_rx_eds_cc.h"
 
 /***********************/
@@ -36,7 +37,9 @@
 #define  INITBL_OBJ   (&(LoraRx.IniTbl))
 #define  CMDMGR_OBJ   (&(LoraRx.CmdMgr))
 #define  CHILDMGR_OBJ (&(LoraRx.ChildMgr))
+#define  TBLMGR_OBJ   (&(LoraRx.TblMgr))
 #define  RADIO_IF_OBJ (&(LoraRx.RadioIf))
+#define  KEY_TBL_OBJ  (&(LoraRx.KeyTbl))
 
 
 /*******************************/
@@ -146,8 +149,13 @@ bool LORA_RX_ResetAppCmd(void* ObjDataPtr, const CFE_MSG_Message_t *MsgPtr)
    
    CMDMGR_ResetStatus(CMDMGR_OBJ);
    CHILDMGR_ResetStatus(CHILDMGR_OBJ);
+   TBLMGR_ResetStatus(TBLMGR_OBJ);
    
    RADIO_IF_ResetStatus();
+   KEY_TBL_ResetStatus();
+   SCAN_TBL_ResetStatus();
+   PROFILE_TBL_ResetStatus();
+   SCHED_TBL_ResetStatus();
 	  
    return true;
 
@@ -195,6 +203,18 @@ static int32 InitApp(void)
 
       RADIO_IF_Constructor(RADIO_IF_OBJ, &LoraRx.IniTbl);
 
+      /* Keys are loaded into the radio interface's security stage */
+      KEY_TBL_Constructor(KEY_TBL_OBJ, &LoraRx.RadioIf.Core.Sec);
+      TBLMGR_Constructor(TBLMGR_OBJ, INITBL_GetStrConfig(INITBL_OBJ, CFG_APP_CFE_NAME));
+      TBLMGR_RegisterTblWithDef(TBLMGR_OBJ, KEY_TBL_NAME, KEY_TBL_LoadCmd, KEY_TBL_DumpCmd, 
+                                INITBL_GetStrConfig(INITBL_OBJ, CFG_KEY_TBL_LOAD_FILE));
+      TBLMGR_RegisterTblWithDef(TBLMGR_OBJ, SCAN_TBL_NAME, SCAN_TBL_LoadCmd, SCAN_TBL_DumpCmd, 
+                                INITBL_GetStrConfig(INITBL_OBJ, CFG_SCAN_TBL_LOAD_FILE));
+      TBLMGR_RegisterTblWithDef(TBLMGR_OBJ, PROFILE_TBL_NAME, PROFILE_TBL_LoadCmd, PROFILE_TBL_DumpCmd, 
+                                INITBL_GetStrConfig(INITBL_OBJ, CFG_PROFILE_TBL_LOAD_FILE));
+      TBLMGR_RegisterTblWithDef(TBLMGR_OBJ, SCHED_TBL_NAME, SCHED_TBL_LoadCmd, SCHED_TBL_DumpCmd, 
+                                INITBL_GetStrConfig(INITBL_OBJ, CFG_SCHED_TBL_LOAD_FILE));
+
       /*
       ** Initialize app level interfaces
       */
@@ -207,13 +227,31 @@ static int32 InitApp(void)
       CMDMGR_RegisterFunc(CMDMGR_OBJ, CMDMGR_NOOP_CMD_FC,   NULL, LORA_RX_NoOpCmd,     0);
       CMDMGR_RegisterFunc(CMDMGR_OBJ, CMDMGR_RESET_CMD_FC,  NULL, LORA_RX_ResetAppCmd, 0);
 
+      CMDMGR_RegisterFunc(CMDMGR_OBJ, LORA_RX_LOAD_TBL_CC, TBLMGR_OBJ, TBLMGR_LoadTblCmd, sizeof(APP_C_FW_LoadTbl_CmdPayload_t));
+      CMDMGR_RegisterFunc(CMDMGR_OBJ, LORA_RX_DUMP_TBL_CC, TBLMGR_OBJ, TBLMGR_DumpTblCmd, sizeof(APP_C_FW_DumpTbl_CmdPayload_t));
+
       CMDMGR_RegisterFunc(CMDMGR_OBJ, LORA_RX_INIT_RADIO_CC,     RADIO_IF_OBJ, RADIO_IF_InitRadioCmd,    0);
       CMDMGR_RegisterFunc(CMDMGR_OBJ, LORA_RX_SEND_RADIO_TLM_CC, RADIO_IF_OBJ, RADIO_IF_SendRadioTlmCmd, 0);
       CMDMGR_RegisterFunc(CMDMGR_OBJ, LORA_RX_SET_SPI_SPEED_CC,  RADIO_IF_OBJ, RADIO_IF_SetSpiSpeedCmd,  sizeof(LORA_RX_SetSpiSpeed_CmdPayload_t));
+      CMDMGR_RegisterFunc(CMDMGR_OBJ, LORA_RX_SET_RADIO_FREQUENCY_CC, RADIO_IF_OBJ, RADIO_IF_SetRadioFrequencyCmd, sizeof(LORA_RX_SetRadioFrequency_CmdPayload_t));
 
       CMDMGR_RegisterFunc(CMDMGR_OBJ, LORA_RX_SET_LO_RA_PARAMS_CC, RADIO_IF_OBJ, RADIO_IF_SetLoRaParamsCmd,  sizeof(LORA_RX_SetLoRaParams_CmdPayload_t));
+      CMDMGR_RegisterFunc(CMDMGR_OBJ, LORA_RX_CRYPTO_BENCH_CC,     RADIO_IF_OBJ, RADIO_IF_CryptoBenchCmd,    0);
+      CMDMGR_RegisterFunc(CMDMGR_OBJ, LORA_RX_SET_FLRC_PARAMS_CC,  RADIO_IF_OBJ, RADIO_IF_SetFlrcParamsCmd,  sizeof(LORA_RX_SetFlrcParams_CmdPayload_t));
+      CMDMGR_RegisterFunc(CMDMGR_OBJ, LORA_RX_START_SCAN_CC,       RADIO_IF_OBJ, RADIO_IF_StartScanCmd,      0);
+      CMDMGR_RegisterFunc(CMDMGR_OBJ, LORA_RX_STOP_SCAN_CC,        RADIO_IF_OBJ, RADIO_IF_StopScanCmd,       0);
+      CMDMGR_RegisterFunc(CMDMGR_OBJ, LORA_RX_SET_SNIFF_MODE_CC,   RADIO_IF_OBJ, RADIO_IF_SetSniffModeCmd,   sizeof(LORA_RX_SetSniffMode_CmdPayload_t));
+      CMDMGR_RegisterFunc(CMDMGR_OBJ, LORA_RX_SELECT_PROFILE_CC,   RADIO_IF_OBJ, RADIO_IF_SelectProfileCmd,  sizeof(LORA_RX_SelectProfile_CmdPayload_t));
+      CMDMGR_RegisterFunc(CMDMGR_OBJ, LORA_RX_DUMP_TRACE_CC,       RADIO_IF_OBJ, RADIO_IF_DumpTraceCmd,      sizeof(LORA_RX_DumpTrace_CmdPayload_t));
+      CMDMGR_RegisterFunc(CMDMGR_OBJ, LORA_RX_DUMP_SPI_REC_CC,     RADIO_IF_OBJ, RADIO_IF_DumpSpiRecCmd,     sizeof(LORA_RX_DumpSpiRec_CmdPayload_t));
+      CMDMGR_RegisterFunc(CMDMGR_OBJ, LORA_RX_REPLAY_SPI_REC_CC,   RADIO_IF_OBJ, RADIO_IF_ReplaySpiRecCmd,   sizeof(LORA_RX_ReplaySpiRec_CmdPayload_t));
+      CMDMGR_RegisterFunc(CMDMGR_OBJ, LORA_RX_CALIBRATE_SPI_CC,    RADIO_IF_OBJ, RADIO_IF_CalibrateSpiCmd,   0);
+      CMDMGR_RegisterFunc(CMDMGR_OBJ, LORA_RX_START_SWEEP_CC,      RADIO_IF_OBJ, RADIO_IF_StartSweepCmd,     sizeof(LORA_RX_StartSweep_CmdPayload_t));
+      CMDMGR_RegisterFunc(CMDMGR_OBJ, LORA_RX_STOP_SWEEP_CC,       RADIO_IF_OBJ, RADIO_IF_StopSweepCmd,      0);
 
       CFE_MSG_Init(CFE_MSG_PTR(LoraRx.StatusTlm.TelemetryHeader), CFE_SB_ValueToMsgId(INITBL_GetIntConfig(INITBL_OBJ, CFG_LORA_RX_STATUS_TLM_TOPICID)), sizeof(LORA_RX_StatusTlm_t));
+      
+      RADIO_IF_AutoInit();
    
       /*
       ** Application startup event message
@@ -259,12 +297,22 @@ static int32 ProcessCommands(void)
          {
             
             CMDMGR_DispatchFunc(CMDMGR_OBJ, &SbBufPtr->Msg);
+            RADIO_IF_SaveState();
          
          } 
          else if (CFE_SB_MsgId_Equal(MsgId, LoraRx.OneHzMid))
          {
 
+            RADIO_IF_SampleTime();
             SendStatusTlm();
+            RADIO_IF_ReportRxEvents();
+            RADIO_IF_ReportSchedule();
+            RADIO_IF_ReportWatchdog();
+            RADIO_IF_SendNackTlm();
+            RADIO_IF_SendLinkTlm();
+            RADIO_IF_SendSweepTlm();
+            RADIO_IF_ServiceTap();
+            RADIO_IF_SaveState();
             
          }
          else
@@ -304,13 +352,223 @@ static void SendStatusTlm(void)
 {
    
    LORA_RX_StatusTlm_Payload_t *StatusTlmPayload = &LoraRx.StatusTlm.Payload;
+   const RADIO_IF_Class_t *RadioIf = &LoraRx.RadioIf;
+   RADIO_RX_Status_t RadioStatus;
+   RADIO_RX_ScanStatus_t ScanStatus;
+   RADIO_RX_SniffStatus_t SniffStatus;
+   RADIO_RX_WatchdogStatus_t WatchdogStatus;
+   RADIO_RX_ReplayStatus_t ReplayStatus;
+   SPI_REC_Status_t SpiRecStatus;
+   RX_MEM_ArenaStatus_t ArenaStatus;
+   RADIO_RX_SlotStatus_t SlotStatus;
+   RX_TAP_Status_t TapStatus;
+   uint16 i;
    
    StatusTlmPayload->ValidCmdCnt   = LoraRx.CmdMgr.ValidCmdCnt;
    StatusTlmPayload->InvalidCmdCnt = LoraRx.CmdMgr.InvalidCmdCnt;
 
    /*
-   ** Rx Demo Object
+   ** Radio Interface Object
    */ 
+   
+   RADIO_RX_GetStatus(&RadioStatus);
+
+   StatusTlmPayload->RadioInitialized = RadioIf->Initialized;
+   StatusTlmPayload->RxDoneCnt        = RadioStatus.RxDoneCnt;
+   StatusTlmPayload->RxCrcErrCnt      = RadioStatus.CrcErrCnt;
+   StatusTlmPayload->RxHdrErrCnt      = RadioStatus.HdrErrCnt;
+   StatusTlmPayload->RxOverrunCnt     = RadioStatus.OverrunCnt;
+   
+   StatusTlmPayload->FrameCnt         = RadioIf->Core.Stats.FrameCnt;
+   StatusTlmPayload->ShortFrameCnt    = RadioIf->Core.Stats.ShortFrameCnt;
+   StatusTlmPayload->DestFilterCnt    = RadioIf->Core.Stats.DestFilterCnt;
+   StatusTlmPayload->NodeFilterCnt    = RadioIf->Core.Stats.NodeFilterCnt;
+   StatusTlmPayload->SeqGapCnt        = RadioIf->Core.Stats.SeqGapCnt;
+   StatusTlmPayload->InsecureCnt      = RadioIf->Core.Stats.InsecureCnt;
+   
+   StatusTlmPayload->SecImpl          = RadioIf->Core.Sec.Impl;
+   StatusTlmPayload->SecKeyCnt        = LoraRx.KeyTbl.KeyCnt;
+   StatusTlmPayload->SecFrameCnt      = RadioIf->Core.Sec.Stats.FrameCnt;
+   StatusTlmPayload->SecShortCnt      = RadioIf->Core.Sec.Stats.ShortCnt;
+   StatusTlmPayload->SecNoKeyCnt      = RadioIf->Core.Sec.Stats.NoKeyCnt;
+   StatusTlmPayload->SecReplayCnt     = RadioIf->Core.Sec.Stats.ReplayCnt;
+   StatusTlmPayload->SecAuthFailCnt   = RadioIf->Core.Sec.Stats.AuthFailCnt;
+   StatusTlmPayload->CryptoBenchPortableNs = RadioIf->CryptoBenchPortableNs;
+   StatusTlmPayload->CryptoBenchAccelNs    = RadioIf->CryptoBenchAccelNs;
+   
+   StatusTlmPayload->DecompFrameCnt    = RadioIf->Core.Decomp.Stats.FrameCnt;
+   StatusTlmPayload->DecompInByteCnt   = RadioIf->Core.Decomp.Stats.InByteCnt;
+   StatusTlmPayload->DecompOutByteCnt  = RadioIf->Core.Decomp.Stats.OutByteCnt;
+   StatusTlmPayload->DecompRatio       = 0;
+   if (RadioIf->Core.Decomp.Stats.InByteCnt > 0)
+   {
+      StatusTlmPayload->DecompRatio = (uint16)(((uint64)RadioIf->Core.Decomp.Stats.OutByteCnt * 100) / 
+                                               RadioIf->Core.Decomp.Stats.InByteCnt);
+   }
+   StatusTlmPayload->DecompMaxOutLen   = RadioIf->Core.Decomp.Stats.MaxOutLen;
+   StatusTlmPayload->DecompBadRefCnt   = RadioIf->Core.Decomp.Stats.BadRefCnt;
+   StatusTlmPayload->DecompOverflowCnt = RadioIf->Core.Decomp.Stats.OverflowCnt;
+   StatusTlmPayload->DecompLastNs      = RadioIf->Core.DecompLastNs;
+   StatusTlmPayload->DecompMaxNs       = RadioIf->Core.DecompMaxNs;
+   
+   RADIO_RX_GetScanStatus(&ScanStatus);
+   
+   StatusTlmPayload->ScanActive        = RadioIf->ScanActive;
+   StatusTlmPayload->ScanState         = ScanStatus.State;
+   StatusTlmPayload->ScanChannel       = ScanStatus.Channel;
+   StatusTlmPayload->ScanSpare         = 0;
+   StatusTlmPayload->ScanFrequency     = 0;
+   if (ScanStatus.State == RADIO_RX_SCAN_LOCKED)
+   {
+      StatusTlmPayload->ScanFrequency = RadioIf->ScanTbl.Data.Channel[ScanStatus.Channel].Frequency;
+   }
+   StatusTlmPayload->ScanStepCnt       = ScanStatus.StepCnt;
+   StatusTlmPayload->ScanAcquireCnt    = ScanStatus.AcquireCnt;
+   StatusTlmPayload->ScanLastAcquireUs = ScanStatus.LastAcquireUs;
+   StatusTlmPayload->ScanRelockCnt     = RadioIf->ScanRelockCnt;
+   for (i = 0; i < RADIO_RX_SCAN_MAX_CHANNELS; i++)
+   {
+      StatusTlmPayload->ScanHitCnt[i] = ScanStatus.HitCnt[i];
+   }
+   
+   RADIO_RX_GetSniffStatus(&SniffStatus);
+   
+   StatusTlmPayload->SniffActive           = SniffStatus.Active;
+   StatusTlmPayload->SniffSpare            = 0;
+   StatusTlmPayload->SniffDutyRatio        = SniffStatus.DutyRatio;
+   StatusTlmPayload->SniffWakeCnt          = SniffStatus.WakeCnt;
+   StatusTlmPayload->SniffWakeLatencyUs    = SniffStatus.WakeLatencyUs;
+   StatusTlmPayload->SniffMaxWakeLatencyUs = SniffStatus.MaxWakeLatencyUs;
+   StatusTlmPayload->HostWakeRate          = RADIO_IF_HostWakeRate();
+   
+   StatusTlmPayload->CdsRestored    = RadioIf->CdsRestored;
+   StatusTlmPayload->RadioWarmStart = RadioIf->RadioWarmStart;
+   StatusTlmPayload->RadioInitSpare = 0;
+   StatusTlmPayload->RadioInitUs    = RadioIf->RadioInitUs;
+
+   StatusTlmPayload->ActiveProfile   = RadioIf->ActiveProfile;
+   StatusTlmPayload->ProfileCnt      = (uint8)RadioIf->ProfileTbl.ProfileCnt;
+   StatusTlmPayload->ProfileSpare    = 0;
+   StatusTlmPayload->ProfileSwitchUs = RadioIf->ProfileSwitchUs;
+
+   StatusTlmPayload->SchedBusy         = RX_SCHED_Busy(&RadioIf->Sched);
+   StatusTlmPayload->SchedSpare        = 0;
+   StatusTlmPayload->SchedEntryCnt     = RadioIf->SchedTbl.EntryCnt;
+   StatusTlmPayload->SchedExecCnt      = RadioIf->Sched.Stats.ExecCnt;
+   StatusTlmPayload->SchedSkipCnt      = RadioIf->Sched.Stats.SkipCnt;
+   StatusTlmPayload->SchedLateCnt      = RadioIf->Sched.Stats.LateCnt;
+   StatusTlmPayload->SchedLastLateUs   = RadioIf->Sched.Stats.LastLateUs;
+   StatusTlmPayload->SchedMaxLateUs    = RadioIf->Sched.Stats.MaxLateUs;
+   StatusTlmPayload->SchedLastSwitchUs = RadioIf->Sched.Stats.LastSwitchUs;
+   StatusTlmPayload->SchedMaxSwitchUs  = RadioIf->Sched.Stats.MaxSwitchUs;
+   
+   RADIO_IF_UpdateGoodput();
+   StatusTlmPayload->LinkGoodputBps  = RadioIf->LinkGoodputBps;
+   StatusTlmPayload->RxGoodputBps    = RadioIf->RxGoodputBps;
+   StatusTlmPayload->AirtimeRatio    = RadioIf->AirtimeRatio;
+   StatusTlmPayload->GoodputSpare    = 0;
+   
+   StatusTlmPayload->FrameTimeValid    = RadioIf->FrameTimeValid;
+   StatusTlmPayload->TimeFitSamples    = (uint8)RadioIf->RxTime.Stats.SampleCnt;
+   StatusTlmPayload->TimeJumpCnt       = (uint16)RadioIf->RxTime.Stats.JumpCnt;
+   StatusTlmPayload->FrameTimeSeconds  = RadioIf->FrameTime.Seconds;
+   StatusTlmPayload->FrameTimeSubsecs  = RadioIf->FrameTime.Subseconds;
+   StatusTlmPayload->TimeFitRatePpb    = RadioIf->RxTime.Stats.RatePpb;
+   StatusTlmPayload->TimeFitResidualNs = RadioIf->RxTime.Stats.ResidualNs;
+
+   StatusTlmPayload->PayloadRelayCnt     = RadioIf->Core.Payload.Stats.FrameCnt[RX_FRAME_TYPE_RELAY];
+   StatusTlmPayload->PayloadTimeCnt      = RadioIf->Core.Payload.Stats.FrameCnt[RX_FRAME_TYPE_TIME];
+   StatusTlmPayload->PayloadCommandCnt   = RadioIf->Core.Payload.Stats.FrameCnt[RX_FRAME_TYPE_COMMAND];
+   StatusTlmPayload->PayloadInvalidCnt   = RadioIf->Core.Payload.Stats.InvalidCnt;
+   StatusTlmPayload->PayloadUnhandledCnt = RadioIf->Core.Payload.Stats.UnhandledCnt;
+   StatusTlmPayload->PayloadSinkErrCnt   = RadioIf->Core.Payload.Stats.SinkErrCnt;
+   StatusTlmPayload->TimeSyncValid       = RadioIf->TimeSyncValid;
+   StatusTlmPayload->TimeSyncNode        = RadioIf->TimeSyncNode;
+   StatusTlmPayload->TimeSyncSpare       = 0;
+   StatusTlmPayload->TimeSyncOffsetUs    = RadioIf->TimeSyncOffsetUs;
+
+   RADIO_IF_UpdateDecodeUtil();
+   StatusTlmPayload->DecodeWorkers     = RadioIf->Core.Pool.WorkerCnt;
+   StatusTlmPayload->DecodeSpare       = 0;
+   StatusTlmPayload->DecodeMaxInFlight = RadioIf->Core.Pool.Stats.MaxInFlight;
+   StatusTlmPayload->DecodeStealCnt    = 0;
+   for (i = 0; i < RX_POOL_MAX_WORKERS; i++)
+   {
+      StatusTlmPayload->DecodeUtil[i]   = RadioIf->Core.Pool.Worker[i].Stats.UtilPct;
+      StatusTlmPayload->DecodeJobCnt[i] = RadioIf->Core.Pool.Worker[i].Stats.JobCnt;
+      StatusTlmPayload->DecodeStealCnt += RadioIf->Core.Pool.Worker[i].Stats.StealCnt;
+   }
+   StatusTlmPayload->DecodeHeldCnt     = RadioIf->Core.Pool.Stats.HeldCnt;
+   StatusTlmPayload->DecodeFullCnt     = RadioIf->Core.Pool.Stats.FullCnt;
+   
+   RADIO_RX_GetWatchdogStatus(&WatchdogStatus);
+   StatusTlmPayload->WatchdogActive        = WatchdogStatus.Active;
+   StatusTlmPayload->WatchdogLastFault     = WatchdogStatus.LastFault;
+   StatusTlmPayload->WatchdogSpare         = 0;
+   StatusTlmPayload->WatchdogResetCnt      = WatchdogStatus.ResetCnt;
+   StatusTlmPayload->WatchdogProbeCnt      = WatchdogStatus.ProbeCnt;
+   StatusTlmPayload->WatchdogRecoveryUs    = WatchdogStatus.LastRecoveryUs;
+   StatusTlmPayload->WatchdogMaxRecoveryUs = WatchdogStatus.MaxRecoveryUs;
+   
+   StatusTlmPayload->SweepActive      = RadioIf->Sweep.Active;
+   StatusTlmPayload->SweepSpare       = 0;
+   StatusTlmPayload->SweepSpare2      = 0;
+   StatusTlmPayload->SweepCnt         = RadioIf->Sweep.Stats.SweepCnt;
+   StatusTlmPayload->SweepStepsPerSec = RadioIf->Sweep.Stats.StepsPerSec;
+   StatusTlmPayload->SweepLastUs      = RadioIf->Sweep.Stats.LastSweepUs;
+   
+   RADIO_IF_UpdateChannel();
+   StatusTlmPayload->VchanActive        = RadioIf->VchanActive;
+   StatusTlmPayload->VchanSpare         = 0;
+   StatusTlmPayload->VchanSpare2        = 0;
+   StatusTlmPayload->VchanTxCnt         = RadioIf->Vchan.TxCnt;
+   StatusTlmPayload->VchanRxCnt         = RadioIf->Vchan.RxCnt;
+   StatusTlmPayload->VchanLostCnt       = RadioIf->Vchan.LostCnt;
+   StatusTlmPayload->VchanCorruptCnt    = RadioIf->Vchan.CorruptCnt;
+   StatusTlmPayload->VchanCollisionCnt  = RadioIf->Vchan.CollisionCnt;
+   StatusTlmPayload->VchanOffChannelCnt = RadioIf->Vchan.OffChannelCnt;
+   StatusTlmPayload->VchanMissCnt       = RadioIf->Vchan.MissCnt;
+   StatusTlmPayload->VchanGoodputBps    = RadioIf->VchanGoodputBps;
+   StatusTlmPayload->VchanLatencyUs     = RadioIf->VchanLatencyUs;
+   StatusTlmPayload->VchanMaxLatencyUs  = RadioIf->Vchan.MaxLatencyUs;
+   
+   RADIO_IF_UpdateSpiCost();
+   SPI_REC_GetStatus(&SpiRecStatus);
+   RADIO_RX_GetReplayStatus(&ReplayStatus);
+   StatusTlmPayload->SpiFrameTransfers = RadioIf->SpiFrameTransfers;
+   StatusTlmPayload->SpiFrameBytes     = RadioIf->SpiFrameBytes;
+   StatusTlmPayload->SpiFrameUs        = RadioIf->SpiFrameUs;
+   StatusTlmPayload->SpiFrameBusyUs    = RadioIf->SpiFrameBusyUs;
+   StatusTlmPayload->SpiLastFrameUs    = RadioIf->SpiLast.LastFrameNs/1000;
+   StatusTlmPayload->SpiTransferCnt    = RadioIf->SpiLast.TransferCnt;
+   StatusTlmPayload->SpiRecEvictCnt    = SpiRecStatus.EvictCnt;
+   StatusTlmPayload->ReplayActive      = ReplayStatus.Active;
+   StatusTlmPayload->SpiSpare          = 0;
+   StatusTlmPayload->ReplayMismatchCnt = (uint16)ReplayStatus.MismatchCnt;
+   
+   StatusTlmPayload->PktCnt           = RadioIf->Core.Deframer.Stats.PktCnt;
+   StatusTlmPayload->IdlePktCnt       = RadioIf->Core.Deframer.Stats.IdlePktCnt;
+   StatusTlmPayload->PktResyncCnt     = RadioIf->Core.Deframer.Stats.ResyncCnt;
+   StatusTlmPayload->PktGapCnt        = RadioIf->Core.Deframer.Stats.GapCnt;
+   StatusTlmPayload->PktDiscardByteCnt = RadioIf->Core.Deframer.Stats.DiscardByteCnt;
+   StatusTlmPayload->PktEmitErrCnt    = RadioIf->Core.Deframer.Stats.EmitErrCnt;
+   StatusTlmPayload->RingHighWater    = RadioIf->Core.Deframer.Stats.RingHighWater;
+   
+   RX_MEM_GetArenaStatus(&ArenaStatus);
+   RADIO_RX_GetSlotStatus(&SlotStatus);
+   StatusTlmPayload->ArenaSize           = ArenaStatus.Size;
+   StatusTlmPayload->ArenaUsed           = ArenaStatus.Used;
+   StatusTlmPayload->ArenaFailCnt        = (uint16)ArenaStatus.FailCnt;
+   StatusTlmPayload->FrameSlots          = (uint8)SlotStatus.SlotCnt;
+   StatusTlmPayload->SlotHighWater       = (uint8)SlotStatus.HighWater;
+   StatusTlmPayload->ChildStackSize      = RX_MEM_StackSize(&RadioIf->ChildStack);
+   StatusTlmPayload->ChildStackHighWater = RX_MEM_StackHighWater(&RadioIf->ChildStack);
+   
+   RX_TAP_GetStatus(&TapStatus);
+   StatusTlmPayload->TapOpen          = TapStatus.Open;
+   StatusTlmPayload->TapClientCnt     = TapStatus.ClientCnt;
+   StatusTlmPayload->TapNotifyDropCnt = (uint16)TapStatus.NotifyDropCnt;
+   StatusTlmPayload->TapFrameCnt      = TapStatus.FrameCnt;
       
    CFE_SB_TimeStampMsg(CFE_MSG_PTR(LoraRx.StatusTlm.TelemetryHeader));
    CFE_SB_TransmitMsg(CFE_MSG_PTR(LoraRx.StatusTlm.TelemetryHeader), true);
@@ -0,0 +1,137 @@
+/*
+**  This program is free software: you can redistribute it and/or modify
+**  it under the terms of the GNU Lesser General Public License as
+**  published by the Free Software Foundation, either version 3 of the
+**  License, or (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Lesser General Public License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public License
+**  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+**
+**  Purpose:
+**    Define the LoRa Receive application
+**
+**  Notes:
+**    1. The app's child task runs the receive pipeline that reassembles
+**       CCSDS space packets from received LoRa frames and publishes them
+**       on the software bus.
+**
+*/
+
+#ifndef _lora_rx_app_
+#define _lora_rx_app_
+
+/*
+** Includes
+*/
+
+#include "app_cfg.h"
+#include "radio_if.h"
+#include "key_tbl.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+/*
+** Events
+*/
+
+#define LORA_RX_INIT_APP_EID     (LORA_RX_BASE_EID + 0)
+#define LORA_RX_NOOP_EID         (LORA_RX_BASE_EID + 1)
+#define LORA_RX_EXIT_EID         (LORA_RX_BASE_EID + 2)
+#define LORA_RX_INVALID_MID_EID  (LORA_RX_BASE_EID + 3)
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+
+/******************************************************************************
+** Command Packets
+** - See EDS command definitions in lora_rx.xml
+*/
+
+
+/******************************************************************************
+** Telmetery Packets
+** - See EDS command definitions in lora_rx.xml
+*/
+
+
+/******************************************************************************
+** LORA_RX_Class
+*/
+typedef struct
+{
+
+   /*
+   ** App Framework
+   */
+
+   INITBL_Class_t    IniTbl;
+   CFE_SB_PipeId_t   CmdPipe;
+   CMDMGR_Class_t    CmdMgr;
+   CHILDMGR_Class_t  ChildMgr;
+   TBLMGR_Class_t    TblMgr;
+
+   /*
+   ** Telemetry Packets
+   */
+
+   LORA_RX_StatusTlm_t  StatusTlm;
+
+   /*
+   ** LORA_RX State & Contained Objects
+   */
+
+   uint32            PerfId;
+   CFE_SB_MsgId_t    CmdMid;
+   CFE_SB_MsgId_t    OneHzMid;
+
+   RADIO_IF_Class_t  RadioIf;
+   KEY_TBL_Class_t   KeyTbl;
+
+} LORA_RX_Class_t;
+
+
+/*******************/
+/** Exported Data **/
+/*******************/
+
+extern LORA_RX_Class_t  LoraRx;
+
+
+/************************/
+/** Exported Functions **/
+/************************/
+
+
+/******************************************************************************
+** Function: LORA_RX_AppMain
+**
+*/
+void LORA_RX_AppMain(void);
+
+
+/******************************************************************************
+** Function: LORA_RX_NoOpCmd
+**
+*/
+bool LORA_RX_NoOpCmd(void* ObjDataPtr, const CFE_MSG_Message_t *MsgPtr);
+
+
+/******************************************************************************
+** Function: LORA_RX_ResetAppCmd
+**
+*/
+bool LORA_RX_ResetAppCmd(void* ObjDataPtr, const CFE_MSG_Message_t *MsgPtr);
+
+
+#endif /* _lora_rx_app_ */
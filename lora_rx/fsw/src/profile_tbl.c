@@ -0,0 +1,381 @@
+/*
+**  This program is free software: you can redistribute it and/or modify
+**  it under the terms of the GNU Lesser General Public License as
+**  published by the Free Software Foundation, either version 3 of the
+**  License, or (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Lesser General Public License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public License
+**  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+**
+**  Purpose:
+**    Implement the radio profile table
+**
+**  Notes:
+**    1. See profile_tbl.h for details.
+**
+*/
+
+/*
+** Include Files:
+*/
+
+#include <stdio.h>
+#include <string.h>
+#include "profile_tbl.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define PROFILE_JSON_FIELDS  11
+#define JSON_OBJ_CNT         (PROFILE_JSON_FIELDS*PROFILE_TBL_MAX_ENTRIES)
+#define QUERY_LEN            32
+
+/*
+** Field indices within an entry's JSON objects. The id, name and mod
+** fields are required.
+*/
+#define FIELD_ID         0
+#define FIELD_NAME       1
+#define FIELD_MOD        2
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+/*
+** JSON working buffer entry. Numbers are loaded into 16-bit fields and
+** range checked before they're copied into a profile definition.
+*/
+typedef struct
+{
+   uint16  Id;
+   char    Name[RADIO_RX_PROFILE_NAME_LEN];
+   uint16  Mod;
+   uint16  Frequency;
+   uint16  SpreadingFactor;
+   uint16  Bandwidth;
+   uint16  CodingRate;
+   uint16  Crc;
+   uint16  Bitrate;
+   uint16  Shaping;
+   uint32  SyncWord;
+
+} TblEntry_t;
+
+
+/**********************/
+/** Global File Data **/
+/**********************/
+
+static PROFILE_TBL_Class_t *ProfileTbl = NULL;
+
+static TblEntry_t TblEntry[PROFILE_TBL_MAX_ENTRIES];                 /* Working buffer for loads */
+static PROFILE_TBL_Profile_t TblProfile[PROFILE_TBL_MAX_PROFILES];   /* Compiled load, installed if all valid */
+
+static CJSON_Obj_t JsonTblObjs[JSON_OBJ_CNT];
+static char        JsonQuery[JSON_OBJ_CNT][QUERY_LEN];
+
+
+/*******************************/
+/** Local Function Prototypes **/
+/*******************************/
+
+static bool LoadJsonData(size_t JsonFileLen);
+static bool LoadEntry(uint16 EntryIdx);
+
+
+/******************************************************************************
+** Function: PROFILE_TBL_Constructor
+**
+*/
+void PROFILE_TBL_Constructor(PROFILE_TBL_Class_t *ProfileTblPtr)
+{
+
+   static const char *FieldName[PROFILE_JSON_FIELDS] =
+   {
+      "id", "name", "mod", "frequency", "sf", "bw", "cr", "crc", "bitrate", "shaping", "sync-word"
+   };
+   uint16 Obj;
+   uint16 i;
+   uint16 f;
+
+   ProfileTbl = ProfileTblPtr;
+
+   memset(ProfileTbl, 0, sizeof(PROFILE_TBL_Class_t));
+
+   for (i = 0; i < RADIO_RX_BUILTIN_PROFILES; i++)
+   {
+      ProfileTbl->Profile[i].Valid = RADIO_RX_GetBuiltinProfile(i, &ProfileTbl->Profile[i].Def,
+                                                                &ProfileTbl->Profile[i].Image);
+      if (ProfileTbl->Profile[i].Valid)
+      {
+         ProfileTbl->ProfileCnt++;
+      }
+   }
+
+   for (i = 0; i < PROFILE_TBL_MAX_ENTRIES; i++)
+   {
+      for (f = 0; f < PROFILE_JSON_FIELDS; f++)
+      {
+         Obj = PROFILE_JSON_FIELDS*i + f;
+         snprintf(JsonQuery[Obj], QUERY_LEN, "profile[%d].%s", i, FieldName[f]);
+      }
+      Obj = PROFILE_JSON_FIELDS*i;
+      CJSON_ObjConstructor(&JsonTblObjs[Obj+0],  JsonQuery[Obj+0],  JSONNumber, &TblEntry[i].Id, 2);
+      CJSON_ObjConstructor(&JsonTblObjs[Obj+1],  JsonQuery[Obj+1],  JSONString, TblEntry[i].Name, RADIO_RX_PROFILE_NAME_LEN);
+      CJSON_ObjConstructor(&JsonTblObjs[Obj+2],  JsonQuery[Obj+2],  JSONNumber, &TblEntry[i].Mod, 2);
+      CJSON_ObjConstructor(&JsonTblObjs[Obj+3],  JsonQuery[Obj+3],  JSONNumber, &TblEntry[i].Frequency, 2);
+      CJSON_ObjConstructor(&JsonTblObjs[Obj+4],  JsonQuery[Obj+4],  JSONNumber, &TblEntry[i].SpreadingFactor, 2);
+      CJSON_ObjConstructor(&JsonTblObjs[Obj+5],  JsonQuery[Obj+5],  JSONNumber, &TblEntry[i].Bandwidth, 2);
+      CJSON_ObjConstructor(&JsonTblObjs[Obj+6],  JsonQuery[Obj+6],  JSONNumber, &TblEntry[i].CodingRate, 2);
+      CJSON_ObjConstructor(&JsonTblObjs[Obj+7],  JsonQuery[Obj+7],  JSONNumber, &TblEntry[i].Crc, 2);
+      CJSON_ObjConstructor(&JsonTblObjs[Obj+8],  JsonQuery[Obj+8],  JSONNumber, &TblEntry[i].Bitrate, 2);
+      CJSON_ObjConstructor(&JsonTblObjs[Obj+9],  JsonQuery[Obj+9],  JSONNumber, &TblEntry[i].Shaping, 2);
+      CJSON_ObjConstructor(&JsonTblObjs[Obj+10], JsonQuery[Obj+10], JSONNumber, &TblEntry[i].SyncWord, 4);
+   }
+   ProfileTbl->JsonObjCnt = JSON_OBJ_CNT;
+
+} /* End PROFILE_TBL_Constructor() */
+
+
+/******************************************************************************
+** Function: PROFILE_TBL_ResetStatus
+**
+*/
+void PROFILE_TBL_ResetStatus(void)
+{
+
+   /* Nothing to do */
+
+} /* End PROFILE_TBL_ResetStatus() */
+
+
+/******************************************************************************
+** Function: PROFILE_TBL_DumpCmd
+**
+** Notes:
+**  1. Function signature must match TBLMGR_DumpTblFuncPtr_t.
+**  2. Can assume valid table filename because this is a callback from
+**     the app framework table manager that has verified the file.
+**  3. DumpType is unused.
+**  4. Built-in profiles are not dumped so a dump file can be reloaded.
+**
+*/
+bool PROFILE_TBL_DumpCmd(TBLMGR_Tbl_t *Tbl, uint8 DumpType, const char *Filename)
+{
+
+   bool       RetStatus = false;
+   bool       First = true;
+   int32      SysStatus;
+   osal_id_t  FileHandle;
+   uint16     i;
+   char       DumpRecord[256];
+   const RADIO_RX_ProfileDef_t *Def;
+
+   SysStatus = OS_OpenCreate(&FileHandle, Filename, OS_FILE_FLAG_CREATE | OS_FILE_FLAG_TRUNCATE, OS_WRITE_ONLY);
+
+   if (SysStatus == OS_SUCCESS)
+   {
+
+      sprintf(DumpRecord,"{\n   \"name\": \"LoRa Receive Profile Table\",\n   \"description\": \"Radio profiles selected by id\",\n   \"profile\": [\n");
+      OS_write(FileHandle, DumpRecord, strlen(DumpRecord));
+
+      for (i = RADIO_RX_BUILTIN_PROFILES; i < PROFILE_TBL_MAX_PROFILES; i++)
+      {
+         if (ProfileTbl->Profile[i].Valid)
+         {
+            Def = &ProfileTbl->Profile[i].Def;
+            sprintf(DumpRecord,"%s      {\"id\": %d, \"name\": \"%s\", \"mod\": %d, \"frequency\": %d, "
+                    "\"sf\": %d, \"bw\": %d, \"cr\": %d, \"crc\": %d, \"bitrate\": %d, \"shaping\": %d, \"sync-word\": %u}",
+                    First ? "" : ",\n", i, Def->Name, Def->Mod, Def->Frequency,
+                    Def->SpreadingFactor, Def->Bandwidth, Def->CodingRate, Def->Crc,
+                    Def->Bitrate, Def->Shaping, (unsigned int)Def->SyncWord);
+            OS_write(FileHandle, DumpRecord, strlen(DumpRecord));
+            First = false;
+         }
+      }
+
+      sprintf(DumpRecord,"\n   ]\n}\n");
+      OS_write(FileHandle, DumpRecord, strlen(DumpRecord));
+
+      OS_close(FileHandle);
+
+      CFE_EVS_SendEvent(PROFILE_TBL_DUMP_EID, CFE_EVS_EventType_DEBUG,
+                        "Successfully dumped profile table to %s", Filename);
+      RetStatus = true;
+
+   } /* End if file create */
+   else
+   {
+
+      CFE_EVS_SendEvent(PROFILE_TBL_DUMP_EID, CFE_EVS_EventType_ERROR,
+                        "Error creating dump file '%s', status=0x%08X",
+                        Filename, SysStatus);
+
+   } /* End if file create error */
+
+   return RetStatus;
+
+} /* End of PROFILE_TBL_DumpCmd() */
+
+
+/******************************************************************************
+** Function: PROFILE_TBL_LoadCmd
+**
+** Notes:
+**  1. Function signature must match TBLMGR_LoadTblFuncPtr_t.
+**
+*/
+bool PROFILE_TBL_LoadCmd(TBLMGR_Tbl_t *Tbl, uint8 LoadType, const char *Filename)
+{
+
+   bool RetStatus = false;
+
+   if (LoadType == TBLMGR_LOAD_TBL_REPLACE)
+   {
+      if (CJSON_ProcessFile(Filename, ProfileTbl->JsonBuf, PROFILE_TBL_JSON_FILE_MAX_CHAR, LoadJsonData))
+      {
+         ProfileTbl->Loaded = true;
+         RetStatus = true;
+      }
+   }
+   else
+   {
+      CFE_EVS_SendEvent(PROFILE_TBL_LOAD_EID, CFE_EVS_EventType_ERROR,
+                        "Profile table load rejected, only replace loads are supported");
+   }
+
+   return RetStatus;
+
+} /* End PROFILE_TBL_LoadCmd() */
+
+
+/******************************************************************************
+** Function: LoadJsonData
+**
+** Notes:
+**  1. Profiles must be contiguous starting at profile[0]. Each profile is
+**     compiled into TblProfile and the table is only replaced if every
+**     profile compiles. The built-in profiles are always kept.
+**
+*/
+static bool LoadJsonData(size_t JsonFileLen)
+{
+
+   bool   RetStatus = true;
+   uint16 EntryCnt;
+   uint16 i;
+
+   ProfileTbl->JsonFileLen = JsonFileLen;
+
+   memset(TblEntry, 0, sizeof(TblEntry));
+   memset(TblProfile, 0, sizeof(TblProfile));
+   for (i = 0; i < JSON_OBJ_CNT; i++)
+   {
+      JsonTblObjs[i].Updated = false;
+   }
+
+   CJSON_LoadObjArray(JsonTblObjs, ProfileTbl->JsonObjCnt, ProfileTbl->JsonBuf, ProfileTbl->JsonFileLen);
+
+   for (EntryCnt = 0; EntryCnt < PROFILE_TBL_MAX_ENTRIES; EntryCnt++)
+   {
+      if (!JsonTblObjs[PROFILE_JSON_FIELDS*EntryCnt + FIELD_ID].Updated)
+      {
+         break;
+      }
+   }
+
+   for (i = 0; i < EntryCnt && RetStatus; i++)
+   {
+      RetStatus = LoadEntry(i);
+   }
+
+   if (RetStatus)
+   {
+      memcpy(&TblProfile[0], &ProfileTbl->Profile[0], RADIO_RX_BUILTIN_PROFILES*sizeof(PROFILE_TBL_Profile_t));
+      memcpy(ProfileTbl->Profile, TblProfile, sizeof(TblProfile));
+      ProfileTbl->ProfileCnt = RADIO_RX_BUILTIN_PROFILES + EntryCnt;
+      CFE_EVS_SendEvent(PROFILE_TBL_LOAD_EID, CFE_EVS_EventType_INFORMATION,
+                        "Loaded %d radio profiles", EntryCnt);
+   }
+
+   return RetStatus;
+
+} /* End LoadJsonData() */
+
+
+/******************************************************************************
+** Function: LoadEntry
+**
+** Validate and compile a working buffer entry into its TblProfile slot.
+**
+*/
+static bool LoadEntry(uint16 EntryIdx)
+{
+
+   bool RetStatus = false;
+   const CJSON_Obj_t *Obj = &JsonTblObjs[PROFILE_JSON_FIELDS*EntryIdx];
+   const TblEntry_t  *Entry = &TblEntry[EntryIdx];
+   PROFILE_TBL_Profile_t *Profile;
+
+   if (!Obj[FIELD_NAME].Updated || !Obj[FIELD_MOD].Updated)
+   {
+      CFE_EVS_SendEvent(PROFILE_TBL_LOAD_EID, CFE_EVS_EventType_ERROR,
+                        "Profile table load rejected, profile[%d] name or mod not defined", EntryIdx);
+   }
+   else if (Entry->Id < RADIO_RX_BUILTIN_PROFILES || Entry->Id >= PROFILE_TBL_MAX_PROFILES)
+   {
+      CFE_EVS_SendEvent(PROFILE_TBL_LOAD_EID, CFE_EVS_EventType_ERROR,
+                        "Profile table load rejected, profile[%d] id %d not in range %d..%d",
+                        EntryIdx, Entry->Id, RADIO_RX_BUILTIN_PROFILES, PROFILE_TBL_MAX_PROFILES-1);
+   }
+   else if (TblProfile[Entry->Id].Valid)
+   {
+      CFE_EVS_SendEvent(PROFILE_TBL_LOAD_EID, CFE_EVS_EventType_ERROR,
+                        "Profile table load rejected, duplicate id %d", Entry->Id);
+   }
+   else if (Entry->SpreadingFactor > 0xFF || Entry->Bandwidth > 0xFF || Entry->CodingRate > 0xFF ||
+            Entry->Crc > 0xFF || Entry->Bitrate > 0xFF || Entry->Shaping > 0xFF || Entry->Mod > 0xFF)
+   {
+      CFE_EVS_SendEvent(PROFILE_TBL_LOAD_EID, CFE_EVS_EventType_ERROR,
+                        "Profile table load rejected, profile %d register value exceeds 8 bits", Entry->Id);
+   }
+   else
+   {
+      Profile = &TblProfile[Entry->Id];
+
+      strncpy(Profile->Def.Name, Entry->Name, RADIO_RX_PROFILE_NAME_LEN-1);
+      Profile->Def.Mod             = (uint8)Entry->Mod;
+      Profile->Def.Frequency       = Entry->Frequency;
+      Profile->Def.SpreadingFactor = (uint8)Entry->SpreadingFactor;
+      Profile->Def.Bandwidth       = (uint8)Entry->Bandwidth;
+      Profile->Def.CodingRate      = (uint8)Entry->CodingRate;
+      Profile->Def.Crc             = (uint8)Entry->Crc;
+      Profile->Def.Bitrate         = (uint8)Entry->Bitrate;
+      Profile->Def.Shaping         = (uint8)Entry->Shaping;
+      Profile->Def.SyncWord        = Entry->SyncWord;
+
+      if (RADIO_RX_CompileProfile(&Profile->Def, &Profile->Image))
+      {
+         Profile->Valid = true;
+         RetStatus = true;
+      }
+      else
+      {
+         CFE_EVS_SendEvent(PROFILE_TBL_LOAD_EID, CFE_EVS_EventType_ERROR,
+                           "Profile table load rejected, profile %d '%s' has invalid radio parameters",
+                           Entry->Id, Profile->Def.Name);
+      }
+   }
+
+   return RetStatus;
+
+} /* End LoadEntry() */
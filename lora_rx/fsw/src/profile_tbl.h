@@ -0,0 +1,144 @@
+/*
+**  This program is free software: you can redistribute it and/or modify
+**  it under the terms of the GNU Lesser General Public License as
+**  published by the Free Software Foundation, either version 3 of the
+**  License, or (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Lesser General Public License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public License
+**  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+**
+**  Purpose:
+**    Define the radio profile table
+**
+**  Notes:
+**    1. Each profile is compiled into an SX128x command image when the table
+**       is loaded so selecting a profile is a single prevalidated burst. See
+**       RADIO_RX_CompileProfile() in radio_rx.h.
+**    2. Ids 0 and 1 are the profiles built into the radio bridge. Table
+**       profiles use ids 2 to PROFILE_TBL_MAX_PROFILES-1.
+**    3. Profile values are SX128x register settings. A frequency of 0
+**       leaves the frequency unchanged when the profile is selected.
+**
+*/
+
+#ifndef _profile_tbl_
+#define _profile_tbl_
+
+/*
+** Includes
+*/
+
+#include "app_cfg.h"
+#include "radio_rx.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+
+/*
+** Event Message IDs
+*/
+
+#define PROFILE_TBL_DUMP_EID  (PROFILE_TBL_BASE_EID + 0)
+#define PROFILE_TBL_LOAD_EID  (PROFILE_TBL_BASE_EID + 1)
+
+#define PROFILE_TBL_NAME  "Profile"
+
+#define PROFILE_TBL_MAX_PROFILES  16
+#define PROFILE_TBL_MAX_ENTRIES   (PROFILE_TBL_MAX_PROFILES - RADIO_RX_BUILTIN_PROFILES)
+
+#define PROFILE_TBL_JSON_FILE_MAX_CHAR  8000
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+
+typedef struct
+{
+   bool  Valid;
+   RADIO_RX_ProfileDef_t   Def;
+   RADIO_RX_ProfileImage_t Image;
+
+} PROFILE_TBL_Profile_t;
+
+
+/******************************************************************************
+** PROFILE_TBL_Class
+*/
+typedef struct
+{
+
+   /*
+   ** Class State Data
+   */
+
+   bool    Loaded;
+   uint16  ProfileCnt;     /* Valid profiles including built-in profiles */
+   PROFILE_TBL_Profile_t Profile[PROFILE_TBL_MAX_PROFILES];
+
+   size_t JsonObjCnt;
+   char   JsonBuf[PROFILE_TBL_JSON_FILE_MAX_CHAR];
+   size_t JsonFileLen;
+
+} PROFILE_TBL_Class_t;
+
+
+/************************/
+/** Exported Functions **/
+/************************/
+
+
+/******************************************************************************
+** Function: PROFILE_TBL_Constructor
+**
+** Initialize the profile table object to a known state
+**
+** Notes:
+**   1. This must be called prior to any other function.
+**   2. Installs the built-in profiles.
+**
+*/
+void PROFILE_TBL_Constructor(PROFILE_TBL_Class_t *ProfileTblPtr);
+
+
+/******************************************************************************
+** Function: PROFILE_TBL_DumpCmd
+**
+** Notes:
+**  1. Function signature must match TBLMGR_DumpTblFuncPtr_t.
+**
+*/
+bool PROFILE_TBL_DumpCmd(TBLMGR_Tbl_t *Tbl, uint8 DumpType, const char *Filename);
+
+
+/******************************************************************************
+** Function: PROFILE_TBL_LoadCmd
+**
+** Notes:
+**  1. Function signature must match TBLMGR_LoadTblFuncPtr_t.
+**  2. Only replace loads are supported. A load replaces every table
+**     profile and is rejected if any profile doesn't compile.
+**
+*/
+bool PROFILE_TBL_LoadCmd(TBLMGR_Tbl_t *Tbl, uint8 LoadType, const char *Filename);
+
+
+/******************************************************************************
+** Function: PROFILE_TBL_ResetStatus
+**
+** Reset counters and status flags to a known reset state.
+**
+*/
+void PROFILE_TBL_ResetStatus(void);
+
+
+#endif /* _profile_tbl_ */
@@ -29,6 +29,7 @@
 ** Include Files:
 */
 
+#include <stdio.h>
 #include <string.h>
 #include "app_cfg.h"
 #include "radio_if.h"
@@ -41,11 +42,52 @@
 
 static RADIO_IF_Class_t *RadioIf = NULL;
 
+static const uint32 SpiCalSpeed[RADIO_IF_SPI_CAL_STEPS] = 
+{
+   1000000, 2000000, 4000000, 6000000, 8000000, 10000000, 12000000, 14000000, 16000000, RADIO_RX_SPI_MAX_SPEED
+};
+
+/* Trace dump working buffers, only used by the main task. TraceEvent holds
+** RX_TRACE_TaskEvents() events per task and is allocated from the arena. */
+static RX_TRACE_Event_t *TraceEvent = NULL;
+static char   TraceFileBuf[4096];
+static uint32 TraceFileLen;
+
+/* SPI recording file image, 8 byte aligned for the replayer */
+static uint64 SpiRecFile[(SPI_REC_FILE_MAX_LEN + 7)/8];
+
 
 /*******************************/
 /** Local Function Prototypes **/
 /*******************************/
 
+static bool EmitPkt(void *EmitCtx, const uint8_t *Seg1, uint16_t Seg1Len,
+                    const uint8_t *Seg2, uint16_t Seg2Len);
+static uint32 BenchCrypto(AES_GCM_Impl_Enum_t Impl);
+static bool InitRadio(bool WarmStart);
+static void RestoreState(void);
+static bool CalibrateSpi(void);
+static void ApplyModulation(void);
+static void ApplyProfile(const RADIO_RX_ProfileDef_t *Def, const RADIO_RX_ProfileImage_t *Image);
+static void ConfigToProfile(RADIO_RX_ProfileDef_t *Def);
+static bool LoadSchedule(RX_SCHED_Plan_t *Plan);
+static uint32 RunSchedule(uint32 WaitMs);
+static void UpdateLinkModel(const RADIO_RX_ProfileDef_t *Def);
+static void StartReceive(void);
+static void CheckScanRelock(void);
+static void RecoverRadio(void);
+static bool SyncSweep(void);
+static void FrameReceived(void *FrameCtx, const RADIO_RX_Frame_t *Frame);
+static RADIO_RX_Frame_t *WaitRadioFrame(void *BackendCtx, uint32_t TimeoutMs);
+static void ReleaseRadioFrame(void *BackendCtx);
+static void AbortRadioWait(void *BackendCtx);
+static bool PublishPayloadPkt(void *SinkCtx, uint8_t Node, const uint8_t *Pkt, uint16_t Len);
+static void TimeSyncReceived(void *SinkCtx, uint8_t Node, uint32_t Seconds, uint32_t Subseconds,
+                             int64_t RxTimeNs);
+static void PerfLog(uint32_t PerfId, bool Exit);
+static void WriteTraceTask(osal_id_t FileHandle, RX_TRACE_Task_Enum_t Task, uint32 EventCnt, int64 BaseNs);
+static void WriteTraceRecord(osal_id_t FileHandle, const char *Record, bool Flush);
+
 
 /******************************************************************************
 ** Function: RADIO_IF_Constructor
@@ -59,11 +101,30 @@ static RADIO_IF_Class_t *RadioIf = NULL;
 void RADIO_IF_Constructor(RADIO_IF_Class_t *RadioIfPtr, INITBL_Class_t *IniTbl)
 {
    
+   RADIO_RX_ProfileDef_t   Def;
+   RADIO_RX_ProfileImage_t Image;
+   RX_MEM_ArenaStatus_t    Arena;
+   RX_PAYLOAD_Sinks_t      PayloadSinks;
+   RX_CORE_Backend_t       Backend;
+   RX_VCHAN_Model_t        VchanModel;
+   RX_TRACE_Event_t *TraceRing;
+   const char *VchanName;
+   bool   FlrcValid;
+   uint32 StagePerfId[RX_TRACE_STAGE_CNT];
+   uint32 TraceEvents;
+   uint32 DeframerRingSize;
+   uint32 DecodeWorkers;
+   uint32 DecodeDepth;
+   
    RadioIf = RadioIfPtr;
    
    memset(RadioIf, 0, sizeof(RADIO_IF_Class_t));
    
    RadioIf->IniTbl = IniTbl;
+
+   /* The radio object and frame slots are allocated first so they don't depend on the trace budget */
+   RX_MEM_ArenaInit(INITBL_GetIntConfig(RadioIf->IniTbl, CFG_ARENA_BYTES));
+   RadioIf->MemReady = RADIO_RX_Setup(INITBL_GetIntConfig(RadioIf->IniTbl, CFG_FRAME_SLOTS));
    RadioIf->Initialized = false;
    RadioIf->SpiSpeed = INITBL_GetIntConfig(RadioIf->IniTbl, CFG_RADIO_SPI_SPEED);
    
@@ -72,19 +133,200 @@ void RADIO_IF_Constructor(RADIO_IF_Class_t *RadioIfPtr, INITBL_Class_t *IniTbl)
    RadioIf->RadioConfig.LoRa.SpreadingFactor = INITBL_GetIntConfig(RadioIf->IniTbl, CFG_RADIO_LORA_SF);
    RadioIf->RadioConfig.LoRa.Bandwidth       = INITBL_GetIntConfig(RadioIf->IniTbl, CFG_RADIO_LORA_BW);
    RadioIf->RadioConfig.LoRa.CodingRate      = INITBL_GetIntConfig(RadioIf->IniTbl, CFG_RADIO_LORA_CR);
-   RadioIF->RadioConfig.Lora.TCXO            = INITBL_GetIntConfig(RadioIf->IniTbl, CFG_RADIO_LORA_TCXO);
-   RadioIF->RadioConfig.Lora.HSM             = INITBL_GetIntConfig(RadioIf->IniTbl, CFG_RADIO_LORA_HSM);
-   RadioIF->RadioConfig.Lora.Power           = INITBL_GetIntConfig(RadioIf->IniTbl, CFG_RADIO_LORA_POWER);
-   RadioIF->RadioConfig.Lora.Mod             = INITBL_GetIntConfig(RadioIf->IniTbl, CFG_RADIO_LORA_MOD);
-   RadioIF->RadioConfig.Lora.CRC             = INITBL_GetIntConfig(RadioIf->IniTbl, CFG_RADIO_LORA_CRC);
-   RadioIF->RadioConfig.Lora.LDRO            = INITBL_GetIntConfig(RadioIf->IniTbl, CFG_RADIO_LORA_LDRO);
-   RadioIF->RadioConfig.Lora.Node            = INITBL_GetIntConfig(RadioIf->IniTbl, CFG_RADIO_LORA_NODE);
-   RadioIF->RadioConfig.Lora.Dest            = INITBL_GetIntConfig(RadioIf->IniTbl, CFG_RADIO_LORA_DEST);
-   RadioIF->RadioConfig.Lora.TXPA            = INITBL_GetIntConfig(RadioIf->IniTbl, CFG_RADIO_LORA_TXPA);
-   RadioIF->RadioConfig.Lora.RXLNA           = INITBL_GetIntConfig(RadioIf->IniTbl, CFG_RADIO_LORA_RXLNA);
+   RadioIf->RadioConfig.LoRa.TCXO            = INITBL_GetIntConfig(RadioIf->IniTbl, CFG_RADIO_LORA_TCXO);
+   RadioIf->RadioConfig.LoRa.HSM             = INITBL_GetIntConfig(RadioIf->IniTbl, CFG_RADIO_LORA_HSM);
+   RadioIf->RadioConfig.LoRa.Power           = INITBL_GetIntConfig(RadioIf->IniTbl, CFG_RADIO_LORA_POWER);
+   RadioIf->RadioConfig.LoRa.Mod             = INITBL_GetIntConfig(RadioIf->IniTbl, CFG_RADIO_LORA_MOD);
+   RadioIf->RadioConfig.LoRa.CRC             = INITBL_GetIntConfig(RadioIf->IniTbl, CFG_RADIO_LORA_CRC);
+   RadioIf->RadioConfig.LoRa.LDRO            = INITBL_GetIntConfig(RadioIf->IniTbl, CFG_RADIO_LORA_LDRO);
+   RadioIf->RadioConfig.LoRa.Node            = INITBL_GetIntConfig(RadioIf->IniTbl, CFG_RADIO_LORA_NODE);
+   RadioIf->RadioConfig.LoRa.Dest            = INITBL_GetIntConfig(RadioIf->IniTbl, CFG_RADIO_LORA_DEST);
+   RadioIf->RadioConfig.LoRa.TXPA            = INITBL_GetIntConfig(RadioIf->IniTbl, CFG_RADIO_LORA_TXPA);
+   RadioIf->RadioConfig.LoRa.RXLNA           = INITBL_GetIntConfig(RadioIf->IniTbl, CFG_RADIO_LORA_RXLNA);
+
+   RadioIf->RadioConfig.Flrc.Bitrate    = INITBL_GetIntConfig(RadioIf->IniTbl, CFG_RADIO_FLRC_BITRATE);
+   RadioIf->RadioConfig.Flrc.CodingRate = INITBL_GetIntConfig(RadioIf->IniTbl, CFG_RADIO_FLRC_CR);
+   RadioIf->RadioConfig.Flrc.Shaping    = INITBL_GetIntConfig(RadioIf->IniTbl, CFG_RADIO_FLRC_SHAPING);
+   RadioIf->RadioConfig.Flrc.CrcLen     = INITBL_GetIntConfig(RadioIf->IniTbl, CFG_RADIO_FLRC_CRC);
+   RadioIf->RadioConfig.Flrc.SyncWord   = INITBL_GetIntConfig(RadioIf->IniTbl, CFG_RADIO_FLRC_SYNC_WORD);
+
+   PROFILE_TBL_Constructor(&RadioIf->ProfileTbl);
+   RadioIf->ActiveProfile = RADIO_IF_NO_PROFILE;
+
+   RadioIf->RadioConfig.Mod = RADIO_RX_MOD_FLRC;
+   ConfigToProfile(&Def);
+   FlrcValid = RADIO_RX_CompileProfile(&Def, &Image);
+   RadioIf->RadioConfig.Mod = RADIO_RX_MOD_LORA;
+   ConfigToProfile(&Def);
+   if (!RADIO_RX_CompileProfile(&Def, &Image))
+   {
+      /* Keep the Node/Dest filter and RF settings, take the modulation from a built-in profile */
+      RADIO_RX_GetBuiltinProfile(0, &Def, &Image);
+      CFE_EVS_SendEvent(RADIO_IF_CONSTRUCTOR_EID, CFE_EVS_EventType_ERROR,
+                        "Invalid LoRa ini parameters SF=%d, BW=%d, CR=%d, using built-in profile %s",
+                        RadioIf->RadioConfig.LoRa.SpreadingFactor, RadioIf->RadioConfig.LoRa.Bandwidth,
+                        RadioIf->RadioConfig.LoRa.CodingRate, Def.Name);
+      RadioIf->RadioConfig.LoRa.SpreadingFactor = Def.SpreadingFactor;
+      RadioIf->RadioConfig.LoRa.Bandwidth       = Def.Bandwidth;
+      RadioIf->RadioConfig.LoRa.CodingRate      = Def.CodingRate;
+      RadioIf->RadioConfig.LoRa.CRC             = Def.Crc;
+   }
+
+   RadioIf->RadioConfig.Mod = RadioIf->RadioConfig.LoRa.Mod;
+   if (RadioIf->RadioConfig.Mod == RADIO_RX_MOD_FLRC && !FlrcValid)
+   {
+      CFE_EVS_SendEvent(RADIO_IF_CONSTRUCTOR_EID, CFE_EVS_EventType_ERROR,
+                        "Invalid FLRC ini parameters, starting in LoRa mode");
+      RadioIf->RadioConfig.Mod = RADIO_RX_MOD_LORA;
+   }
+   else if (RadioIf->RadioConfig.Mod != RADIO_RX_MOD_LORA && RadioIf->RadioConfig.Mod != RADIO_RX_MOD_FLRC)
+   {
+      CFE_EVS_SendEvent(RADIO_IF_CONSTRUCTOR_EID, CFE_EVS_EventType_ERROR,
+                        "Unsupported modulation %d, starting in LoRa mode", RadioIf->RadioConfig.Mod);
+      RadioIf->RadioConfig.Mod = RADIO_RX_MOD_LORA;
+   }
+   RadioIf->RadioConfig.LoRa.Mod = RADIO_RX_MOD_LORA;
+
+   RadioIf->RadioConfig.SniffRxUs    = INITBL_GetIntConfig(RadioIf->IniTbl, CFG_SNIFF_RX_US);
+   RadioIf->RadioConfig.SniffSleepUs = INITBL_GetIntConfig(RadioIf->IniTbl, CFG_SNIFF_SLEEP_US);
+   OS_GetLocalTime(&RadioIf->WakeRateLastTime);
+
+   Backend.WaitFunc    = WaitRadioFrame;
+   Backend.ReleaseFunc = ReleaseRadioFrame;
+   Backend.AbortFunc   = AbortRadioWait;
+   Backend.Ctx         = NULL;
+   RX_CORE_Constructor(&RadioIf->Core, &Backend, FrameReceived, NULL);
+   PayloadSinks.Relay   = PublishPayloadPkt;
+   PayloadSinks.Time    = TimeSyncReceived;
+   PayloadSinks.Command = PublishPayloadPkt;
+   RX_PAYLOAD_Constructor(&RadioIf->Core.Payload, &PayloadSinks, NULL);
+   RadioIf->NackPeriod = INITBL_GetIntConfig(RadioIf->IniTbl, CFG_SEQ_NACK_PERIOD);
+   if (!RX_LINK_Constructor(&RadioIf->Core.Link, INITBL_GetIntConfig(RadioIf->IniTbl, CFG_LINK_EWMA_SHIFT)))
+   {
+      CFE_EVS_SendEvent(RADIO_IF_CONSTRUCTOR_EID, CFE_EVS_EventType_ERROR,
+                        "Invalid link average shift %d, using default %d",
+                        INITBL_GetIntConfig(RadioIf->IniTbl, CFG_LINK_EWMA_SHIFT), RX_LINK_DEF_EWMA_SHIFT);
+   }
+   RadioIf->Core.SecRequired = INITBL_GetIntConfig(RadioIf->IniTbl, CFG_SEC_REQUIRED);
+   RX_SEC_Constructor(&RadioIf->Core.Sec, INITBL_GetIntConfig(RadioIf->IniTbl, CFG_SEC_ACCEL) ?
+                      AES_GCM_AccelImpl() : AES_GCM_IMPL_PORTABLE);
+
+   RadioIf->ScanRelockMs = INITBL_GetIntConfig(RadioIf->IniTbl, CFG_SCAN_RELOCK_MS);
+   SCAN_TBL_Constructor(&RadioIf->ScanTbl);
+
+   RadioIf->SchedLeadUs = INITBL_GetIntConfig(RadioIf->IniTbl, CFG_SCHED_LEAD_US);
+   RX_SCHED_Constructor(&RadioIf->Sched, INITBL_GetIntConfig(RadioIf->IniTbl, CFG_SCHED_LATE_LIMIT_US));
+   SCHED_TBL_Constructor(&RadioIf->SchedTbl, &RadioIf->ProfileTbl, LoadSchedule);
+
+   RX_SWEEP_Constructor(&RadioIf->Sweep);
+
+   if (!RX_DECOMP_Constructor(&RadioIf->Core.Decomp, INITBL_GetIntConfig(RadioIf->IniTbl, CFG_DECOMP_WINDOW_BITS),
+                              INITBL_GetIntConfig(RadioIf->IniTbl, CFG_DECOMP_LOOKAHEAD_BITS),
+                              INITBL_GetIntConfig(RadioIf->IniTbl, CFG_DECOMP_MAX_LEN)))
+   {
+      CFE_EVS_SendEvent(RADIO_IF_CONSTRUCTOR_EID, CFE_EVS_EventType_ERROR,
+                        "Invalid decompression window %d or lookahead %d bits, using defaults %d and %d",
+                        INITBL_GetIntConfig(RadioIf->IniTbl, CFG_DECOMP_WINDOW_BITS),
+                        INITBL_GetIntConfig(RadioIf->IniTbl, CFG_DECOMP_LOOKAHEAD_BITS),
+                        RX_DECOMP_DEF_WINDOW_BITS, RX_DECOMP_DEF_LOOKAHEAD_BITS);
+   }
+
+   RadioIf->RxTimeCalNs = INITBL_GetIntConfig(RadioIf->IniTbl, CFG_RX_TIME_CAL_NS);
+   RX_TIME_Constructor(&RadioIf->RxTime);
+   RX_EVT_Constructor(&RadioIf->RxEvt);
+
+   StagePerfId[RX_TRACE_WAIT]     = INITBL_GetIntConfig(RadioIf->IniTbl, CFG_WAIT_PERF_ID);
+   StagePerfId[RX_TRACE_SPI_READ] = INITBL_GetIntConfig(RadioIf->IniTbl, CFG_SPI_READ_PERF_ID);
+   StagePerfId[RX_TRACE_FILTER]   = INITBL_GetIntConfig(RadioIf->IniTbl, CFG_FILTER_PERF_ID);
+   StagePerfId[RX_TRACE_SEC]      = INITBL_GetIntConfig(RadioIf->IniTbl, CFG_SEC_PERF_ID);
+   StagePerfId[RX_TRACE_DECOMP]   = INITBL_GetIntConfig(RadioIf->IniTbl, CFG_DECOMP_PERF_ID);
+   StagePerfId[RX_TRACE_DEFRAME]  = INITBL_GetIntConfig(RadioIf->IniTbl, CFG_DEFRAMER_PERF_ID);
+   StagePerfId[RX_TRACE_PUBLISH]  = INITBL_GetIntConfig(RadioIf->IniTbl, CFG_PUBLISH_PERF_ID);
+   /* The rings and the dump buffer are one block so a failed allocation doesn't strand arena bytes */
+   TraceEvents = INITBL_GetIntConfig(RadioIf->IniTbl, CFG_TRACE_EVENTS);
+   TraceRing   = RX_MEM_Alloc(2*RX_TRACE_TASK_CNT*TraceEvents*sizeof(RX_TRACE_Event_t));
+   if (TraceRing == NULL)
+   {
+      TraceEvents = 0;
+   }
+   TraceEvent = (TraceRing == NULL) ? NULL : &TraceRing[RX_TRACE_TASK_CNT*TraceEvents];
+   RX_TRACE_Init(StagePerfId, PerfLog, TraceRing, TraceEvents, INITBL_GetIntConfig(RadioIf->IniTbl, CFG_TRACE_ENABLE));
+   SPI_REC_Init(INITBL_GetIntConfig(RadioIf->IniTbl, CFG_SPI_REC_ENABLE));
+
+   DeframerRingSize = INITBL_GetIntConfig(RadioIf->IniTbl, CFG_DEFRAMER_RING_BYTES);
+   RadioIf->MemReady &= CCSDS_DEFRAMER_Constructor(&RadioIf->Core.Deframer, INITBL_GetIntConfig(RadioIf->IniTbl, CFG_DEFRAMER_MAX_PKT_LEN),
+                                                   RX_MEM_Alloc(DeframerRingSize), DeframerRingSize, EmitPkt, NULL);
 
+   DecodeWorkers = INITBL_GetIntConfig(RadioIf->IniTbl, CFG_DECODE_WORKERS);
+   DecodeDepth   = INITBL_GetIntConfig(RadioIf->IniTbl, CFG_DECODE_DEPTH);
+   if (DecodeWorkers > 0)
+   {
+      if (!RX_CORE_StartPool(&RadioIf->Core, DecodeWorkers, RX_MEM_Alloc(DecodeDepth*sizeof(RX_CORE_Job_t)), DecodeDepth))
+      {
+         CFE_EVS_SendEvent(RADIO_IF_CONSTRUCTOR_EID, CFE_EVS_EventType_ERROR,
+                           "Decode workers not started, %d workers with depth %d, frames are decoded by the child task",
+                           (int)DecodeWorkers, (int)DecodeDepth);
+      }
+   }
+
+   if (INITBL_GetIntConfig(RadioIf->IniTbl, CFG_TAP_ENABLE))
+   {
+      if (!RX_TAP_Open(INITBL_GetStrConfig(RadioIf->IniTbl, CFG_TAP_SHM_NAME),
+                       INITBL_GetStrConfig(RadioIf->IniTbl, CFG_TAP_SOCKET_PATH),
+                       INITBL_GetIntConfig(RadioIf->IniTbl, CFG_TAP_SLOTS)))
+      {
+         CFE_EVS_SendEvent(RADIO_IF_CONSTRUCTOR_EID, CFE_EVS_EventType_ERROR,
+                           "Frame tap not opened, shared memory %s with %d slots or socket %s failed",
+                           INITBL_GetStrConfig(RadioIf->IniTbl, CFG_TAP_SHM_NAME),
+                           INITBL_GetIntConfig(RadioIf->IniTbl, CFG_TAP_SLOTS),
+                           INITBL_GetStrConfig(RadioIf->IniTbl, CFG_TAP_SOCKET_PATH));
+      }
+   }
+
+   VchanName = INITBL_GetStrConfig(RadioIf->IniTbl, CFG_VCHAN_SHM_NAME);
+   if (VchanName[0] != '\0')
+   {
+      VchanModel.LossPpm    = INITBL_GetIntConfig(RadioIf->IniTbl, CFG_VCHAN_LOSS_PPM);
+      VchanModel.CorruptPpm = INITBL_GetIntConfig(RadioIf->IniTbl, CFG_VCHAN_CORRUPT_PPM);
+      VchanModel.DelayUs    = INITBL_GetIntConfig(RadioIf->IniTbl, CFG_VCHAN_DELAY_US);
+      VchanModel.DopplerHz  = (int32)INITBL_GetIntConfig(RadioIf->IniTbl, CFG_VCHAN_DOPPLER_HZ);
+      VchanModel.Seed       = INITBL_GetIntConfig(RadioIf->IniTbl, CFG_VCHAN_SEED);
+      RadioIf->VchanActive  = RADIO_RX_SetChannel(VchanName, &VchanModel);
+      if (RadioIf->VchanActive)
+      {
+         CFE_EVS_SendEvent(RADIO_IF_CONSTRUCTOR_EID, CFE_EVS_EventType_INFORMATION,
+                           "Receiving on virtual RF channel %s: loss %u ppm, corruption %u ppm, delay %u us, Doppler %d Hz",
+                           VchanName, (unsigned int)VchanModel.LossPpm, (unsigned int)VchanModel.CorruptPpm,
+                           (unsigned int)VchanModel.DelayUs, (int)VchanModel.DopplerHz);
+      }
+      else
+      {
+         CFE_EVS_SendEvent(RADIO_IF_CONSTRUCTOR_EID, CFE_EVS_EventType_ERROR,
+                           "Virtual RF channel %s not opened, using the SX128x", VchanName);
+      }
+   }
+
+   RX_MEM_GetArenaStatus(&Arena);
+   CFE_EVS_SendEvent(RADIO_IF_CONSTRUCTOR_EID, RadioIf->MemReady && Arena.FailCnt == 0 ?
+                     CFE_EVS_EventType_INFORMATION : CFE_EVS_EventType_ERROR,
+                     "Receive arena %u of %u bytes used, %u allocation failures (last %u bytes), "
+                     "%d frame slots, %u trace events per task%s",
+                     (unsigned int)Arena.Used, (unsigned int)Arena.Size, (unsigned int)Arena.FailCnt,
+                     (unsigned int)Arena.FailLen, INITBL_GetIntConfig(RadioIf->IniTbl, CFG_FRAME_SLOTS),
+                     (unsigned int)RX_TRACE_TaskEvents(), RadioIf->MemReady ? "" : ", receive path disabled");
+   
+   RestoreState();
+   RX_CORE_SetAddress(&RadioIf->Core, (uint8)RadioIf->RadioConfig.LoRa.Dest, (uint8)RadioIf->RadioConfig.LoRa.Node);
+   
+   ConfigToProfile(&Def);
+   UpdateLinkModel(&Def);
+   OS_GetLocalTime(&RadioIf->GoodputLastTime);
       
-   CFE_MSG_Init(CFE_MSG_PTR(RadioIf->RadioTlm.TelemetryHeader), CFE_SB_ValueToMsgId(INITBL_GetIntConfig(RadioIf->IniTbl, CFG_LORA_TX_RADIO_TLM_TOPICID)), sizeof(LORA_TX_RadioTlm_t));
+   CFE_MSG_Init(CFE_MSG_PTR(RadioIf->RadioTlm.TelemetryHeader), CFE_SB_ValueToMsgId(INITBL_GetIntConfig(RadioIf->IniTbl, CFG_LORA_RX_RADIO_TLM_TOPICID)), sizeof(LORA_RX_RadioTlm_t));
+   CFE_MSG_Init(CFE_MSG_PTR(RadioIf->RxEventTlm.TelemetryHeader), CFE_SB_ValueToMsgId(INITBL_GetIntConfig(RadioIf->IniTbl, CFG_LORA_RX_RX_EVENT_TLM_TOPICID)), sizeof(LORA_RX_RxEventTlm_t));
+   CFE_MSG_Init(CFE_MSG_PTR(RadioIf->NackTlm.TelemetryHeader), CFE_SB_ValueToMsgId(INITBL_GetIntConfig(RadioIf->IniTbl, CFG_LORA_RX_NACK_TLM_TOPICID)), sizeof(LORA_RX_NackTlm_t));
+   CFE_MSG_Init(CFE_MSG_PTR(RadioIf->LinkTlm.TelemetryHeader), CFE_SB_ValueToMsgId(INITBL_GetIntConfig(RadioIf->IniTbl, CFG_LORA_RX_LINK_TLM_TOPICID)), sizeof(LORA_RX_LinkTlm_t));
+   CFE_MSG_Init(CFE_MSG_PTR(RadioIf->SweepTlm.TelemetryHeader), CFE_SB_ValueToMsgId(INITBL_GetIntConfig(RadioIf->IniTbl, CFG_LORA_RX_SWEEP_TLM_TOPICID)), sizeof(LORA_RX_SweepTlm_t));
 
 } /* End RADIO_IF_Constructor() */
 
@@ -94,21 +336,91 @@ void RADIO_IF_Constructor(RADIO_IF_Class_t *RadioIfPtr, INITBL_Class_t *IniTbl)
 **
 ** Notes:
 **   1. Returning false causes the child task to terminate.
-**   2. Information events are sent because this is instructional code and the
-**      events provide feedback. The events are filtered so they won't flood
-**      the ground. A reset app command resets the event filter.  
+**   2. The wait for a frame is bounded so the loop notices when the radio
+**      is reinitialized. While sniffing the child sleeps until a frame
+**      arrives or a command changes the receive mode.
+**   3. Pending key loads and time fits are applied after the wait so a
+**      frame that ends a long sleep is processed with the latest ones.
+**   4. Per-frame conditions are only counted, no events are sent from the
+**      receive loop. See RADIO_IF_ReportRxEvents().
+**   5. Schedule entries are applied before the wait, which is shortened
+**      to end SCHED_LEAD_US before the next entry is due. A loaded
+**      schedule waits for the radio to be initialized.
+**   6. With DECODE_WORKERS set a processed frame is queued to the decode
+**      workers and retired by a later wait, see rx_core.h.
+**   7. A radio watchdog reset aborts the wait and the configuration is
+**      restored at the start of the next pass, see RecoverRadio().
+**   8. While a spectrum sweep is active each pass is one sweep instead of
+**      a frame wait, see SyncSweep(). The child delays after each sweep so
+**      back-to-back sweeps don't starve lower priority tasks.
+**   9. The radio section of a pass runs under the radio lock and checks
+**      Initialized again inside it. InitRadio() takes the lock before it
+**      destroys the radio, so the radio can't be rebuilt during a sweep
+**      or a recovery.
 **
 */
 bool RADIO_IF_ChildTask(CHILDMGR_Class_t *ChildMgr)
 {
    
-   bool RetStatus = true;
- 
-   CFE_EVS_SendEvent (RADIO_IF_CHILD_TASK_EID, CFE_EVS_EventType_INFORMATION, 
-                      "RADIO_IF_ChildTask()"); 
-   OS_TaskDelay(2000);
+   RADIO_RX_Frame_t *Frame;
+   bool   Sniffing;
+   uint32 WaitMs;
+   
+   if (!RadioIf->ChildStack.Painted)
+   {
+      RX_MEM_PaintStack(&RadioIf->ChildStack);
+   }
+
+   if (RadioIf->Initialized)
+   {
+      RADIO_RX_Lock();
+      if (!RadioIf->Initialized)
+      {
+         RADIO_RX_Unlock();
+         return true;
+      }
+      if (RADIO_RX_RecoveryPending())
+      {
+         RecoverRadio();
+      }
+      if (SyncSweep())
+      {
+         RX_SWEEP_AddSweep(&RadioIf->Sweep,
+                           RADIO_RX_SweepRssi(RadioIf->Sweep.Plan.StartKHz*1000UL, RadioIf->Sweep.Plan.StepKHz*1000UL,
+                                              RadioIf->Sweep.Plan.StepCnt, RadioIf->Sweep.Plan.SettleUs,
+                                              RadioIf->Sweep.Rssi));
+         RADIO_RX_Unlock();
+         OS_TaskDelay(RADIO_IF_SWEEP_YIELD_MS);
+         return true;
+      }
+      Sniffing = (RadioIf->RadioConfig.SniffSleepUs > 0 && !RadioIf->ScanActive);
+      WaitMs   = Sniffing ? RADIO_RX_WAIT_FOREVER : RadioIf->RxWaitMs;
+      RADIO_RX_Unlock();
+      
+      WaitMs = RunSchedule(WaitMs);
+      Frame = RX_CORE_WaitFrame(&RadioIf->Core, WaitMs);
+      RX_TIME_Sync(&RadioIf->RxTime);
+      if (Frame != NULL)
+      {
+         RX_CORE_ProcessFrame(&RadioIf->Core, Frame);
+         RX_CORE_ReleaseFrame(&RadioIf->Core);
+         RadioIf->ScanIdleMs = 0;
+      }
+      else if (RadioIf->ScanActive)
+      {
+         CheckScanRelock();
+      }
+   }
+   else
+   {
+      RX_SEC_Sync(&RadioIf->Core.Sec);
+      RX_TIME_Sync(&RadioIf->RxTime);
+      RX_SCHED_Sync(&RadioIf->Sched);
+      RX_SWEEP_Sync(&RadioIf->Sweep);
+      OS_TaskDelay(RADIO_IF_IDLE_DELAY_MS);
+   }
        
-   return RetStatus;
+   return true;
 
 } /* End RADIO_IF_ChildTask() */
 
@@ -126,237 +438,2520 @@ bool RADIO_IF_ChildTask(CHILDMGR_Class_t *ChildMgr)
 void RADIO_IF_ResetStatus(void)
 {
 
-   return;
+   RX_CORE_ResetStatus(&RadioIf->Core);
+   RadioIf->ScanRelockCnt = 0;
+   RX_TIME_ResetStatus(&RadioIf->RxTime);
+   RX_EVT_ResetStatus(&RadioIf->RxEvt);
+   RADIO_RX_ResetStatus();
+   RX_SCHED_ResetStatus(&RadioIf->Sched);
+   RadioIf->SchedExecCnt = 0;
+   RadioIf->SchedSkipCnt = 0;
+   RadioIf->SchedLateCnt = 0;
+   RadioIf->WatchdogResetCnt = 0;
+   RX_SWEEP_ResetStatus(&RadioIf->Sweep);
+   memset(&RadioIf->Vchan, 0, sizeof(RX_VCHAN_Stats_t));
+   RadioIf->VchanGoodputBps = 0;
+   RadioIf->VchanLatencyUs  = 0;
 
 } /* End RADIO_IF_ResetStatus() */
 
 
 /******************************************************************************
-** Function: RADIO_IF_InitRadio
+** Function: RADIO_IF_HostWakeRate
 **
 */
-bool RADIO_IF_InitRadioCmd(void *ObjDataPtr, const CFE_MSG_Message_t *MsgPtr)
+uint32 RADIO_IF_HostWakeRate(void)
 {
    
-   bool RetStatus = false;
-   RADIO_RX_Pin_t RadioPin;
-
-   RadioPin.Busy = INITBL_GetIntConfig(RadioIf->IniTbl, CFG_RADIO_PIN_BUSY);
-   RadioPin.Nrst = INITBL_GetIntConfig(RadioIf->IniTbl, CFG_RADIO_PIN_NRST);
-   RadioPin.Nss  = INITBL_GetIntConfig(RadioIf->IniTbl, CFG_RADIO_PIN_NSS);
-   RadioPin.Dio1 = INITBL_GetIntConfig(RadioIf->IniTbl, CFG_RADIO_PIN_DIO1);
-   RadioPin.Dio2 = INITBL_GetIntConfig(RadioIf->IniTbl, CFG_RADIO_PIN_DIO2);
-   RadioPin.Dio3 = INITBL_GetIntConfig(RadioIf->IniTbl, CFG_RADIO_PIN_DIO3);
-   RadioPin.TxEn = INITBL_GetIntConfig(RadioIf->IniTbl, CFG_RADIO_PIN_TX_EN);
-   RadioPin.RxEn = INITBL_GetIntConfig(RadioIf->IniTbl, CFG_RADIO_PIN_RX_EN);
+   RADIO_RX_SniffStatus_t SniffStatus;
+   OS_time_t Now;
+   uint32    WakeCnt;
+   int64     ElapsedNs;
+   uint32    WakeRate = 0;
    
-   RetStatus = RADIO_RX_InitRadio(INITBL_GetStrConfig(RadioIf->IniTbl, CFG_RADIO_SPI_DEV_STR),
-                                  INITBL_GetIntConfig(RadioIf->IniTbl, CFG_RADIO_SPI_DEV_NUM),
-                                  &RadioPin);
+   RADIO_RX_GetSniffStatus(&SniffStatus);
+   OS_GetLocalTime(&Now);
    
-   if (RetStatus)
-   {
-      RadioIf->Initialized = true;
-      CFE_EVS_SendEvent(RADIO_RX_INIT_RADIO_CMD_EID, CFE_EVS_EventType_INFORMATION,
-                        "Sucessfully initialized the RX Radio");
-   }
-   else
+   WakeCnt   = SniffStatus.IrqCnt + SniffStatus.ConsumerWakeCnt;
+   ElapsedNs = OS_TimeGetTotalNanoseconds(OS_TimeSubtract(Now, RadioIf->WakeRateLastTime));
+   
+   if (ElapsedNs > 0 && WakeCnt >= RadioIf->WakeRateLastCnt)
    {
-      RadioIf->Initialized = false;
-      CFE_EVS_SendEvent(RADIO_RX_INIT_RADIO_CMD_EID, CFE_EVS_EventType_ERROR,
-                        "Failed to initialize the RX Radio");
+      WakeRate = (uint32)(((uint64)(WakeCnt - RadioIf->WakeRateLastCnt)*100000000000ULL)/ElapsedNs);
    }
-
-   return RetStatus;
    
-} /* RADIO_IF_InitRadioCmd() */
+   RadioIf->WakeRateLastCnt  = WakeCnt;
+   RadioIf->WakeRateLastTime = Now;
+   
+   return WakeRate;
+   
+} /* End RADIO_IF_HostWakeRate() */
 
 
 /******************************************************************************
-** Function: RADIO_IF_SendRadioTlmCmd
+** Function: RADIO_IF_UpdateGoodput
 **
-** Notes:
-**   1. See radio_if.h file prologue for data source details.
 */
-bool RADIO_IF_SendRadioTlmCmd(void *ObjDataPtr, const CFE_MSG_Message_t *MsgPtr)
+void RADIO_IF_UpdateGoodput(void)
 {
    
-   LORA_RX_RadioTlm_Payload_t *RadioTlmPayload = &RadioIf->RadioTlm.Payload;
+   OS_time_t Now;
+   uint32    ByteCnt   = RadioIf->Core.GoodputByteCnt;
+   uint64    AirtimeUs = RadioIf->RxAirtimeUs;
+   int64     ElapsedNs;
+   uint64    Ratio;
    
-   strncpy(RadioTlmPayload->SpiDevStr, INITBL_GetStrConfig(RadioIf->IniTbl, CFG_RADIO_SPI_DEV_STR), OS_MAX_PATH_LEN - 1);   
-   RadioTlmPayload->SpiDevNum      = INITBL_GetIntConfig(RadioIf->IniTbl, CFG_RADIO_SPI_DEV_NUM);
-   RadioTlmPayload->SpiSpeed       = RadioIf->SpiSpeed;
-   RadioTlmPayload->RadioPinBusy   = INITBL_GetIntConfig(RadioIf->IniTbl, CFG_RADIO_PIN_BUSY);
-   RadioTlmPayload->RadioPinNrst   = INITBL_GetIntConfig(RadioIf->IniTbl, CFG_RADIO_PIN_NRST);
-   RadioTlmPayload->RadioPinNss    = INITBL_GetIntConfig(RadioIf->IniTbl, CFG_RADIO_PIN_NSS);
-   RadioTlmPayload->RadioPinDio1   = INITBL_GetIntConfig(RadioIf->IniTbl, CFG_RADIO_PIN_DIO1);
-   RadioTlmPayload->RadioPinDio2   = INITBL_GetIntConfig(RadioIf->IniTbl, CFG_RADIO_PIN_DIO2);
-   RadioTlmPayload->RadioPinDio3   = INITBL_GetIntConfig(RadioIf->IniTbl, CFG_RADIO_PIN_DIO3);
-   RadioTlmPayload->RadioPinTxEn   = INITBL_GetIntConfig(RadioIf->IniTbl, CFG_RADIO_PIN_TX_EN);
-   RadioTlmPayload->RadioPinRxEn   = INITBL_GetIntConfig(RadioIf->IniTbl, CFG_RADIO_PIN_RX_EN);
-
-   RadioTlmPayload->RadioFrequency      = RadioIf->RadioConfig.Frequency;
-   RadioTlmPayload->LoRaSpreadingFactor = RadioIf->RadioConfig.LoRa.SpreadingFactor;
-   RadioTlmPayload->LoRaBandwidth       = RadioIf->RadioConfig.LoRa.Bandwidth;
-   RadioTlmPayload->LoRaCodingRate      = RadioIf->RadioConfig.LoRa.CodingRate;
-   RadioTlmPayload->LoRaTCXO            = RadioIf->RadioConfig.LoRa.TCXO;
-   RadioTlmPayload->LoRaHSM             = RadioIf->RadioConfig.LoRa.HSM;
-   RadioTlmPayload->LoRaPower           = RadioIf->RadioConfig.LoRa.Power;
-   RadioTlmPayload->LoRaMod             = RadioIf->RadioConfig.LoRa.Mod;
-   RadioTlmPayload->LoRaCRC             = RadioIf->RadioConfig.LoRa.CRC;
-   RadioTlmPayload->LoRaLDRO            = RadioIf->RadioConfig.LoRa.LDRO;
-   RadioTlmPayload->LoRaNode            = RadioIf->RadioConfig.LoRa.Node;
-   RadioTlmPayload->LoRaDest            = RadioIf->RadioConfig.LoRa.Dest;
-   RadioTlmPayload->LoRaTXPA            = RadioIf->RadioConfig.LoRa.TXPA;
-   RadioTlmPayload->LoRaRXLNA           = RadioIf->RadioConfig.LoRa.RXLNA;
+   OS_GetLocalTime(&Now);
+   ElapsedNs = OS_TimeGetTotalNanoseconds(OS_TimeSubtract(Now, RadioIf->GoodputLastTime));
    
-   CFE_SB_TimeStampMsg(CFE_MSG_PTR(RadioIf->RadioTlm.TelemetryHeader));
-   CFE_SB_TransmitMsg(CFE_MSG_PTR(RadioIf->RadioTlm.TelemetryHeader), true);
-
-   CFE_EVS_SendEvent(RADIO_RX_SEND_RADIO_TLM_CMD_EID, CFE_EVS_EventType_INFORMATION,
-                     "Sent Radio configuration telemetry message");
-   return true;
+   RadioIf->RxGoodputBps = 0;
+   RadioIf->AirtimeRatio = 0;
+   if (ElapsedNs > 0)
+   {
+      RadioIf->RxGoodputBps = (uint32)(((uint64)(ByteCnt - RadioIf->GoodputLastByteCnt)*8*1000000000ULL)/ElapsedNs);
+      Ratio = ((AirtimeUs - RadioIf->GoodputLastAirtimeUs)*10000000ULL)/ElapsedNs;
+      RadioIf->AirtimeRatio = (uint16)((Ratio > 10000) ? 10000 : Ratio);
+   }
    
-} /* RADIO_IF_SendRadioTlmCmd() */
+   RadioIf->GoodputLastByteCnt   = ByteCnt;
+   RadioIf->GoodputLastAirtimeUs = AirtimeUs;
+   RadioIf->GoodputLastTime      = Now;
+   
+} /* End RADIO_IF_UpdateGoodput() */
 
 
 /******************************************************************************
-** Function: RADIO_IF_SetLoRaParamsCmd
+** Function: RADIO_IF_UpdateDecodeUtil
 **
-** Notes:
-**   1. TODO: Add parameter validity checks
 */
-bool RADIO_IF_SetLoRaParamsCmd(void *ObjDataPtr, const CFE_MSG_Message_t *MsgPtr)
+void RADIO_IF_UpdateDecodeUtil(void)
 {
-   
-   const LORA_RX_SetLoRaParams_CmdPayload_t *Cmd = CMDMGR_PAYLOAD_PTR(MsgPtr, LORA_RX_SetLoRaParams_t);
-   bool RetStatus = false;
 
-   if (RadioIf->Initialized)
-   {
-      RadioIf->RadioConfig.LoRa.SpreadingFactor = Cmd->SpreadingFactor;
-      RadioIf->RadioConfig.LoRa.Bandwidth       = Cmd->Bandwidth;
-      RadioIf->RadioConfig.LoRa.CodingRate      = Cmd->CodingRate;
-      RadioIf->RadioConfig.LoRa.TCXO            = Cmd->TCXO;
-      RadioIf->RadioConfig.LoRa.HSM             = Cmd->HSM;
-      RadioIf->RadioConfig.LoRa.Power           = Cmd->Power;
-      RadioIf->RadioConfig.LoRa.Mod             = Cmd->Mod;
-      RadioIf->RadioConfig.LoRa.CRC             = Cmd->CRC;
-      RadioIf->RadioConfig.LoRa.LDRO            = Cmd->LDRO;
-      RadioIf->RadioConfig.LoRa.Node            = Cmd->Node;
-      RadioIf->RadioConfig.LoRa.Dest            = Cmd->Dest;
-      RadioIf->RadioConfig.LoRa.TXPA            = Cmd->TXPA;
-      RadioIf->RadioConfig.LoRa.RXLNA           = Cmd->RXLNA;
+   RX_POOL_SampleUtil(&RadioIf->Core.Pool);
 
+} /* End RADIO_IF_UpdateDecodeUtil() */
 
-      RADIO_RX_SetLoraParams(RadioIf->RadioConfig.LoRa.SpreadingFactor,
-                             RadioIf->RadioConfig.LoRa.Bandwidth,
-                             RadioIf->RadioConfig.LoRa.CodingRate,
-                             RadioIf->RadioConfig.LoRa.TCXO;
-                             RadioIf->RadioConfig.LoRa.HSM,
-                             RadioIf->RadioConfig.LoRa.Power,
-                             RadioIf->RadioConfig.LoRa.Mod,
-                             RadioIf->RadioConfig.LoRa.CRC,
-                             RadioIf->RadioConfig.LoRa.LDRO,
-                             RadioIf->RadioConfig.LoRa.Node,
-                             RadioIf->RadioConfig.LoRa.Dest,
-                             RadioIf->RadioConfig.LoRa.TXPA,
-                             RadioIf->RadioConfig.LoRa.RXLNA);
 
-      CFE_EVS_SendEvent(RADIO_RX_SET_LORA_PARAMS_CMD_EID, CFE_EVS_EventType_INFORMATION,
-                        "Set LoRa paramaters: SF=%d, BW=%d, RC=%d", Cmd->SpreadingFactor,
-                        Cmd->Bandwidth, Cmd->CodingRate);
-                        
-      RetStatus = true;
+/******************************************************************************
+** Function: RADIO_IF_UpdateSpiCost
+**
+*/
+void RADIO_IF_UpdateSpiCost(void)
+{
+   
+   RADIO_RX_SpiStatus_t    Spi;
+   RADIO_RX_ReplayStatus_t Replay;
+   uint32 FrameCnt;
+   
+   RADIO_RX_GetSpiStatus(&Spi);
+   
+   FrameCnt = Spi.FrameCnt - RadioIf->SpiLast.FrameCnt;
+   if (FrameCnt > 0)
+   {
+      RadioIf->SpiFrameTransfers = (uint16)((Spi.FrameTransferCnt - RadioIf->SpiLast.FrameTransferCnt)/FrameCnt);
+      RadioIf->SpiFrameBytes     = (uint16)((Spi.FrameByteCnt - RadioIf->SpiLast.FrameByteCnt)/FrameCnt);
+      RadioIf->SpiFrameUs        = (uint32)((Spi.FrameNs - RadioIf->SpiLast.FrameNs)/(FrameCnt*1000ULL));
+      RadioIf->SpiFrameBusyUs    = (uint32)((Spi.FrameBusyNs - RadioIf->SpiLast.FrameBusyNs)/(FrameCnt*1000ULL));
    }
-   else
+   memcpy(&RadioIf->SpiLast, &Spi, sizeof(RADIO_RX_SpiStatus_t));
+   
+   RADIO_RX_GetReplayStatus(&Replay);
+   if (RadioIf->ReplayActive && !Replay.Active)
    {
-      CFE_EVS_SendEvent(RADIO_RX_SET_LORA_PARAMS_CMD_EID, CFE_EVS_EventType_ERROR,
-                        "Set LoRa parameters failed, Radio not initialized");
+      RADIO_RX_Lock();
+      if (RadioIf->Initialized)
+      {
+         RADIO_RX_SetRadioFrequency(RadioIf->RadioConfig.Frequency*1000000UL);
+         ApplyModulation();
+      }
+      RADIO_RX_Unlock();
+      
+      CFE_EVS_SendEvent(RADIO_IF_REPLAY_SPI_REC_CMD_EID, 
+                        (Replay.MismatchCnt == 0) ? CFE_EVS_EventType_INFORMATION : CFE_EVS_EventType_ERROR,
+                        "SPI replay complete, %u of %u records replayed, %u skipped, %u mismatches. Receiving restarted.",
+                        (unsigned int)Replay.ReplayCnt, (unsigned int)Replay.RecordCnt,
+                        (unsigned int)Replay.SkipCnt, (unsigned int)Replay.MismatchCnt);
    }
-
-   return RetStatus;
+   RadioIf->ReplayActive = Replay.Active;
    
-} /* RADIO_IF_SetLoRaParamsCmd() */
+} /* End RADIO_IF_UpdateSpiCost() */
 
 
 /******************************************************************************
-** Function: RADIO_IF_SetRadioFrequencyCmd
+** Function: RADIO_IF_UpdateChannel
 **
-** Notes:
-**   1. TODO: What is a valid frequency range
 */
-bool RADIO_IF_SetRadioFrequencyCmd(void *ObjDataPtr, const CFE_MSG_Message_t *MsgPtr)
+void RADIO_IF_UpdateChannel(void)
 {
    
-   const LORA_RX_SetRadioFrequency_CmdPayload_t *Cmd = CMDMGR_PAYLOAD_PTR(MsgPtr, LORA_RX_SetRadioFrequency_t);
-   bool RetStatus = false;
-
-   if (Cmd->Frequency >= 0 && Cmd->Frequency <= 48000)
+   RX_VCHAN_Stats_t Vchan;
+   int64  NowNs = RADIO_RX_RawTimeNs();
+   uint32 RxCnt;
+   
+   if (RADIO_RX_GetChannelStats(&Vchan))
    {
-      if (RadioIf->Initialized)
+      RxCnt = Vchan.RxCnt - RadioIf->Vchan.RxCnt;
+      if (RadioIf->VchanLastNs != 0 && NowNs > RadioIf->VchanLastNs)
       {
-         RadioIf->RadioConfig.Frequency = Cmd->Frequency;
-         RADIO_RX_SetRadioFrequency(Cmd->Frequency*1000000UL);
-         CFE_EVS_SendEvent(RADIO_RX_SET_RADIO_FREQUENCY_CMD_EID, CFE_EVS_EventType_INFORMATION,
-                           "Set radio frequency to %d Mhz", Cmd->Frequency);
-         RetStatus = true;
-      }
-      else
-      {
-         CFE_EVS_SendEvent(RADIO_RX_SET_RADIO_FREQUENCY_CMD_EID, CFE_EVS_EventType_ERROR,
-                           "Set radio frequency failed, Radio not initialized");
+         RadioIf->VchanGoodputBps = (uint32)(((Vchan.RxByteCnt - RadioIf->Vchan.RxByteCnt)*8ULL*1000000000ULL)/
+                                             (uint64)(NowNs - RadioIf->VchanLastNs));
       }
-
+      RadioIf->VchanLatencyUs = (RxCnt > 0) ? (uint32)((Vchan.LatencyNs - RadioIf->Vchan.LatencyNs)/(RxCnt*1000ULL)) : 0;
+      memcpy(&RadioIf->Vchan, &Vchan, sizeof(RX_VCHAN_Stats_t));
+      RadioIf->VchanLastNs = NowNs;
    }
-   else
+   
+} /* End RADIO_IF_UpdateChannel() */
+
+
+/******************************************************************************
+** Function: RADIO_IF_ServiceTap
+**
+*/
+void RADIO_IF_ServiceTap(void)
+{
+
+   uint16 AcceptCnt = RX_TAP_Service();
+
+   if (AcceptCnt > 0)
    {
-      CFE_EVS_SendEvent(RADIO_RX_SET_RADIO_FREQUENCY_CMD_EID, CFE_EVS_EventType_ERROR,
-                           "Set radio frequency failed, invalid frequency %d.",
-                           Cmd->Frequency);
+      CFE_EVS_SendEvent(RADIO_IF_TAP_CLIENT_EID, CFE_EVS_EventType_INFORMATION,
+                        "Frame tap accepted %d client connection%s", AcceptCnt, (AcceptCnt > 1) ? "s" : "");
    }
 
-   return RetStatus;
+} /* End RADIO_IF_ServiceTap() */
+
+
+/******************************************************************************
+** Function: RADIO_IF_SampleTime
+**
+** Notes:
+**   1. The raw time is the midpoint of reads on either side of the mission
+**      time read to cancel most of the read latency.
+**
+*/
+void RADIO_IF_SampleTime(void)
+{
    
-} /* RADIO_IF_SetRadioFrequencyCmd() */
+   int64 RawBeforeNs;
+   int64 RawAfterNs;
+   CFE_TIME_SysTime_t MissionTime;
+   
+   RawBeforeNs = RADIO_RX_RawTimeNs();
+   MissionTime = CFE_TIME_GetTime();
+   RawAfterNs  = RADIO_RX_RawTimeNs();
+   
+   RX_TIME_AddSample(&RadioIf->RxTime, RawBeforeNs + (RawAfterNs - RawBeforeNs)/2,
+                     MissionTime.Seconds, MissionTime.Subseconds);
+   
+} /* End RADIO_IF_SampleTime() */
 
 
 /******************************************************************************
-** Function: RADIO_IF_SetSpiSpeedCmd
+** Function: RADIO_IF_ReportRxEvents
 **
 ** Notes:
-**   1. TODO: What is a valid speed range
+**   1. The stage statistics are read while the child may be updating them.
+**      Each counter is read once so a total is never torn, the next
+**      interval picks up anything counted after the read.
+**
 */
-bool RADIO_IF_SetSpiSpeedCmd(void *ObjDataPtr, const CFE_MSG_Message_t *MsgPtr)
+void RADIO_IF_ReportRxEvents(void)
 {
    
-   const LORA_RX_SetSpiSpeed_CmdPayload_t *Cmd = CMDMGR_PAYLOAD_PTR(MsgPtr, LORA_RX_SetSpiSpeed_t);
-   bool RetStatus = false;
+   LORA_RX_RxEventTlm_Payload_t *Payload = &RadioIf->RxEventTlm.Payload;
+   RADIO_RX_Status_t RadioStatus;
+   uint32 Total[RX_EVT_ID_CNT];
+   uint32 ActiveMask;
+   char   Summary[CFE_MISSION_EVS_MAX_MESSAGE_LENGTH];
+   
+   RADIO_RX_GetStatus(&RadioStatus);
+   
+   Total[RX_EVT_CRC_ERR]         = RadioStatus.CrcErrCnt;
+   Total[RX_EVT_HDR_ERR]         = RadioStatus.HdrErrCnt;
+   Total[RX_EVT_OVERRUN]         = RadioStatus.OverrunCnt;
+   Total[RX_EVT_SHORT_FRAME]     = RX_EVT_READ(RadioIf->Core.Stats.ShortFrameCnt);
+   Total[RX_EVT_DEST_FILTER]     = RX_EVT_READ(RadioIf->Core.Stats.DestFilterCnt);
+   Total[RX_EVT_NODE_FILTER]     = RX_EVT_READ(RadioIf->Core.Stats.NodeFilterCnt);
+   Total[RX_EVT_INSECURE]        = RX_EVT_READ(RadioIf->Core.Stats.InsecureCnt);
+   Total[RX_EVT_SEQ_GAP]         = RX_EVT_READ(RadioIf->Core.Stats.SeqGapCnt);
+   Total[RX_EVT_SEC_AUTH_FAIL]   = RX_EVT_READ(RadioIf->Core.Sec.Stats.AuthFailCnt);
+   Total[RX_EVT_SEC_REPLAY]      = RX_EVT_READ(RadioIf->Core.Sec.Stats.ReplayCnt);
+   Total[RX_EVT_SEC_NO_KEY]      = RX_EVT_READ(RadioIf->Core.Sec.Stats.NoKeyCnt);
+   Total[RX_EVT_DECOMP_ERR]      = RX_EVT_READ(RadioIf->Core.Decomp.Stats.BadRefCnt) +
+                                   RX_EVT_READ(RadioIf->Core.Decomp.Stats.OverflowCnt);
+   Total[RX_EVT_DEFRAMER_RESYNC] = RX_EVT_READ(RadioIf->Core.Deframer.Stats.ResyncCnt);
+   Total[RX_EVT_EMIT_ERR]        = RX_EVT_READ(RadioIf->Core.Deframer.Stats.EmitErrCnt);
+   
+   ActiveMask = RX_EVT_Update(&RadioIf->RxEvt, Total);
+   
+   Payload->CrcErr         = RadioIf->RxEvt.Delta[RX_EVT_CRC_ERR];
+   Payload->HdrErr         = RadioIf->RxEvt.Delta[RX_EVT_HDR_ERR];
+   Payload->Overrun        = RadioIf->RxEvt.Delta[RX_EVT_OVERRUN];
+   Payload->ShortFrame     = RadioIf->RxEvt.Delta[RX_EVT_SHORT_FRAME];
+   Payload->DestFilter     = RadioIf->RxEvt.Delta[RX_EVT_DEST_FILTER];
+   Payload->NodeFilter     = RadioIf->RxEvt.Delta[RX_EVT_NODE_FILTER];
+   Payload->Insecure       = RadioIf->RxEvt.Delta[RX_EVT_INSECURE];
+   Payload->SeqGap         = RadioIf->RxEvt.Delta[RX_EVT_SEQ_GAP];
+   Payload->SecAuthFail    = RadioIf->RxEvt.Delta[RX_EVT_SEC_AUTH_FAIL];
+   Payload->SecReplay      = RadioIf->RxEvt.Delta[RX_EVT_SEC_REPLAY];
+   Payload->SecNoKey       = RadioIf->RxEvt.Delta[RX_EVT_SEC_NO_KEY];
+   Payload->DecompErr      = RadioIf->RxEvt.Delta[RX_EVT_DECOMP_ERR];
+   Payload->DeframerResync = RadioIf->RxEvt.Delta[RX_EVT_DEFRAMER_RESYNC];
+   Payload->EmitErr        = RadioIf->RxEvt.Delta[RX_EVT_EMIT_ERR];
+   Payload->ActiveMask     = ActiveMask;
+   Payload->IntervalCnt       = RadioIf->RxEvt.IntervalCnt;
+   Payload->ActiveIntervalCnt = RadioIf->RxEvt.ActiveIntervalCnt;
+   
+   CFE_SB_TimeStampMsg(CFE_MSG_PTR(RadioIf->RxEventTlm.TelemetryHeader));
+   CFE_SB_TransmitMsg(CFE_MSG_PTR(RadioIf->RxEventTlm.TelemetryHeader), true);
+   
+   if (ActiveMask)
+   {
+      RX_EVT_Format(&RadioIf->RxEvt, Summary, sizeof(Summary));
+      CFE_EVS_SendEvent(RADIO_IF_RX_EVENT_EID,
+                        (ActiveMask & RX_EVT_ERROR_MASK) ? CFE_EVS_EventType_ERROR : CFE_EVS_EventType_DEBUG,
+                        "Rx: %s", Summary);
+   }
+   
+} /* End RADIO_IF_ReportRxEvents() */
+
+
+/******************************************************************************
+** Function: RADIO_IF_ReportSchedule
+**
+** Notes:
+**   1. The statistics are read while the child may be updating them. The
+**      last action fields may be from a later action than the counters,
+**      the next report catches up.
+**
+*/
+void RADIO_IF_ReportSchedule(void)
+{
 
-   if (Cmd->Speed >= 0 && Cmd->Speed <= 8000000)
+   const RX_SCHED_Stats_t *Stats = &RadioIf->Sched.Stats;
+   uint32 ExecCnt = RX_EVT_READ(Stats->ExecCnt);
+   uint32 SkipCnt = RX_EVT_READ(Stats->SkipCnt);
+   uint32 LateCnt = RX_EVT_READ(Stats->LateCnt);
+   int16  LastEntry = Stats->LastEntry;
+   char   LastName[16];
+
+   if (ExecCnt != RadioIf->SchedExecCnt || SkipCnt != RadioIf->SchedSkipCnt)
    {
-      if (RadioIf->Initialized)
+      if (LastEntry == RX_SCHED_BASE)
       {
-         RadioIf->SpiSpeed = Cmd->Speed;
-         RADIO_RX_SetSpiSpeed(Cmd->Speed);
-         CFE_EVS_SendEvent(RADIO_RX_SET_SPI_SPEED_CMD_EID, CFE_EVS_EventType_INFORMATION,
-                           "Set radio SPI speed to %d", Cmd->Speed);
-         RetStatus = true;
+         strcpy(LastName, "base restore");
       }
       else
       {
-         CFE_EVS_SendEvent(RADIO_RX_SET_SPI_SPEED_CMD_EID, CFE_EVS_EventType_ERROR,
-                           "Set radio SPI speed failed, Radio not initialized");
+         snprintf(LastName, sizeof(LastName), "entry[%d]", LastEntry);
       }
-
-   }
-   else
-   {
-      CFE_EVS_SendEvent(RADIO_RX_SET_SPI_SPEED_CMD_EID, CFE_EVS_EventType_ERROR,
-                           "Set radio SPI speed failed, invalid speed %d.",
-                           Cmd->Speed);
+      CFE_EVS_SendEvent(SCHED_TBL_EXEC_EID,
+                        (SkipCnt != RadioIf->SchedSkipCnt || LateCnt != RadioIf->SchedLateCnt) ?
+                        CFE_EVS_EventType_ERROR : CFE_EVS_EventType_INFORMATION,
+                        "Schedule %s applied %d us from due, receiving after %u us. "
+                        "Applied %u, skipped %u, late %u, max late %u us",
+                        LastName, (int)Stats->LastLateUs, (unsigned int)Stats->LastSwitchUs,
+                        (unsigned int)(ExecCnt - RadioIf->SchedExecCnt),
+                        (unsigned int)(SkipCnt - RadioIf->SchedSkipCnt),
+                        (unsigned int)(LateCnt - RadioIf->SchedLateCnt),
+                        (unsigned int)Stats->MaxLateUs);
+      RadioIf->SchedExecCnt = ExecCnt;
+      RadioIf->SchedSkipCnt = SkipCnt;
+      RadioIf->SchedLateCnt = LateCnt;
    }
 
+} /* End RADIO_IF_ReportSchedule() */
+
+
+/******************************************************************************
+** Function: RADIO_IF_ReportWatchdog
+**
+*/
+void RADIO_IF_ReportWatchdog(void)
+{
+
+   static const char *const FaultStr[RADIO_RX_FAULT_CNT] =
+   {
+      "no fault", "BUSY stuck high", "receive stopped", "packet type readback mismatch"
+   };
+   RADIO_RX_WatchdogStatus_t Status;
+
+   RADIO_RX_GetWatchdogStatus(&Status);
+
+   if (Status.ResetCnt != RadioIf->WatchdogResetCnt && !Status.Recovering)
+   {
+      CFE_EVS_SendEvent(RADIO_IF_WATCHDOG_EID, CFE_EVS_EventType_ERROR,
+                        "Radio watchdog reset the radio after %s, receiving again %u us after detection. "
+                        "Resets %u, max recovery %u us",
+                        FaultStr[Status.LastFault < RADIO_RX_FAULT_CNT ? Status.LastFault : 0],
+                        (unsigned int)Status.LastRecoveryUs,
+                        (unsigned int)(Status.ResetCnt - RadioIf->WatchdogResetCnt),
+                        (unsigned int)Status.MaxRecoveryUs);
+      RadioIf->WatchdogResetCnt = Status.ResetCnt;
+   }
+
+} /* End RADIO_IF_ReportWatchdog() */
+
+
+/******************************************************************************
+** Function: RADIO_IF_SendNackTlm
+**
+** Notes:
+**   1. A node's NACK is built from a consistent copy of its window, see
+**      rx_seq.h. Unused node entries are zero.
+**
+*/
+void RADIO_IF_SendNackTlm(void)
+{
+   
+   LORA_RX_NackTlm_Payload_t *Payload = &RadioIf->NackTlm.Payload;
+   RX_SEQ_Nack_t Nack;
+   uint8 NodeCnt;
+   uint8 i;
+   uint8 r;
+   
+   if (RadioIf->NackPeriod == 0 || ++RadioIf->NackSecs < RadioIf->NackPeriod)
+   {
+      return;
+   }
+   RadioIf->NackSecs = 0;
+   
+   NodeCnt = RX_SEQ_NodeCnt(&RadioIf->Core.SeqTrk);
+   if (NodeCnt == 0)
+   {
+      return;
+   }
+   
+   memset(Payload, 0, sizeof(LORA_RX_NackTlm_Payload_t));
+   Payload->NodeCnt      = NodeCnt;
+   Payload->WindowLen    = RX_SEQ_WINDOW;
+   Payload->UntrackedCnt = RadioIf->Core.SeqTrk.UntrackedCnt;
+   for (i = 0; i < NodeCnt; i++)
+   {
+      RX_SEQ_GetNack(&RadioIf->Core.SeqTrk, i, &Nack);
+      Payload->Node[i].Node      = Nack.Node;
+      Payload->Node[i].HighSeq   = Nack.HighSeq;
+      Payload->Node[i].Span      = Nack.Span;
+      Payload->Node[i].RangeCnt  = Nack.RangeCnt;
+      Payload->Node[i].Truncated = Nack.Truncated;
+      Payload->Node[i].MissCnt   = Nack.MissCnt;
+      Payload->Node[i].RxCnt     = Nack.RxCnt;
+      Payload->Node[i].LateCnt   = Nack.LateCnt;
+      Payload->Node[i].LostCnt   = Nack.LostCnt;
+      for (r = 0; r < Nack.RangeCnt; r++)
+      {
+         Payload->Node[i].Range[r].Start = Nack.Range[r].Start;
+         Payload->Node[i].Range[r].Len   = Nack.Range[r].Len;
+      }
+   }
+   
+   CFE_SB_TimeStampMsg(CFE_MSG_PTR(RadioIf->NackTlm.TelemetryHeader));
+   CFE_SB_TransmitMsg(CFE_MSG_PTR(RadioIf->NackTlm.TelemetryHeader), true);
+   
+} /* End RADIO_IF_SendNackTlm() */
+
+
+/******************************************************************************
+** Function: RADIO_IF_SendLinkTlm
+**
+** Notes:
+**   1. Each entry is a consistent copy, see rx_link.h. Nodes heard while
+**      the pages cycle are picked up when the cycle reaches them.
+**   2. The last frame time is reported as an age because the mission time
+**      conversion belongs to the receive context, see rx_time.h.
+**
+*/
+void RADIO_IF_SendLinkTlm(void)
+{
+   
+   LORA_RX_LinkTlm_Payload_t *Payload = &RadioIf->LinkTlm.Payload;
+   RX_LINK_Entry_t Entry;
+   int64  NowNs;
+   int64  AgeMs;
+   uint16 ActiveCnt;
+   uint16 Index;
+   uint8  i;
+   
+   ActiveCnt = RX_LINK_ActiveCnt(&RadioIf->Core.Link);
+   if (ActiveCnt == 0)
+   {
+      return;
+   }
+   if (RadioIf->LinkPageStart >= ActiveCnt)
+   {
+      RadioIf->LinkPageStart = 0;
+   }
+   
+   memset(Payload, 0, sizeof(LORA_RX_LinkTlm_Payload_t));
+   Payload->ActiveCnt = ActiveCnt;
+   Payload->PageStart = RadioIf->LinkPageStart;
+   Index = RadioIf->LinkPageStart;
+   NowNs = RADIO_RX_RawTimeNs();
+   for (i = 0; i < RADIO_IF_LINK_PAGE_LEN && Index < ActiveCnt; i++, Index++)
+   {
+      RX_LINK_Get(&RadioIf->Core.Link, Index, &Entry);
+      Payload->Node[i].Node      = Entry.Node;
+      Payload->Node[i].Rssi      = Entry.Rssi;
+      Payload->Node[i].Snr       = Entry.Snr;
+      Payload->Node[i].Per       = Entry.Per;
+      Payload->Node[i].FrameCnt  = Entry.FrameCnt;
+      Payload->Node[i].ByteCnt   = Entry.ByteCnt;
+      Payload->Node[i].CrcErrCnt = Entry.CrcErrCnt;
+      Payload->Node[i].MissCnt   = Entry.MissCnt;
+      AgeMs = (NowNs - Entry.LastSeenNs)/1000000;
+      Payload->Node[i].LastSeenAgeMs = (AgeMs < 0) ? 0 : (AgeMs > UINT32_MAX) ? UINT32_MAX : (uint32)AgeMs;
+   }
+   Payload->NodeCnt = i;
+   RadioIf->LinkPageStart = Index;
+   
+   CFE_SB_TimeStampMsg(CFE_MSG_PTR(RadioIf->LinkTlm.TelemetryHeader));
+   CFE_SB_TransmitMsg(CFE_MSG_PTR(RadioIf->LinkTlm.TelemetryHeader), true);
+   
+} /* End RADIO_IF_SendLinkTlm() */
+
+
+/******************************************************************************
+** Function: RADIO_IF_SendSweepTlm
+**
+** Notes:
+**   1. A row taken after a stop is still sent, it holds the sweeps that
+**      completed before the stop.
+**
+*/
+void RADIO_IF_SendSweepTlm(void)
+{
+   
+   LORA_RX_SweepTlm_Payload_t *Payload = &RadioIf->SweepTlm.Payload;
+   RX_SWEEP_Row_t *Row = &RadioIf->SweepRow;
+   
+   if (!RX_SWEEP_TakeRow(&RadioIf->Sweep, Row))
+   {
+      return;
+   }
+   
+   memset(Payload, 0, sizeof(LORA_RX_SweepTlm_Payload_t));
+   Payload->StartKHz    = Row->Plan.StartKHz;
+   Payload->StepKHz     = Row->Plan.StepKHz;
+   Payload->SettleUs    = Row->Plan.SettleUs;
+   Payload->StepCnt     = Row->Plan.StepCnt;
+   Payload->StepsPerBin = Row->Plan.StepsPerBin;
+   Payload->BinCnt      = Row->Plan.BinCnt;
+   Payload->SweepCnt    = Row->SweepCnt;
+   Payload->StepsPerSec = (Row->SweepNs > 0) ? (uint32)(((uint64)Row->StepCnt*1000000000)/Row->SweepNs) : 0;
+   Payload->SweepUs     = (Row->SweepCnt > 0) ? (uint32)(Row->SweepNs/Row->SweepCnt/1000) : 0;
+   memcpy(Payload->Bin, Row->Bin, sizeof(Payload->Bin));
+   
+   CFE_SB_TimeStampMsg(CFE_MSG_PTR(RadioIf->SweepTlm.TelemetryHeader));
+   CFE_SB_TransmitMsg(CFE_MSG_PTR(RadioIf->SweepTlm.TelemetryHeader), true);
+   
+} /* End RADIO_IF_SendSweepTlm() */
+
+
+/******************************************************************************
+** Function: RADIO_IF_CryptoBenchCmd
+**
+** Notes:
+**   1. Runs in the main task so it doesn't delay frame processing.
+**
+*/
+bool RADIO_IF_CryptoBenchCmd(void *ObjDataPtr, const CFE_MSG_Message_t *MsgPtr)
+{
+   
+   AES_GCM_Impl_Enum_t AccelImpl = AES_GCM_AccelImpl();
+
+   RadioIf->CryptoBenchPortableNs = BenchCrypto(AES_GCM_IMPL_PORTABLE);
+   
+   if (AccelImpl != AES_GCM_IMPL_PORTABLE)
+   {
+      RadioIf->CryptoBenchAccelNs = BenchCrypto(AccelImpl);
+   }
+   else
+   {
+      RadioIf->CryptoBenchAccelNs = RadioIf->CryptoBenchPortableNs;
+   }
+   
+   CFE_EVS_SendEvent(RADIO_IF_CRYPTO_BENCH_CMD_EID, CFE_EVS_EventType_INFORMATION,
+                     "AES-GCM %d byte frame decrypt: portable %u ns, accelerated(impl %d) %u ns, active impl %d",
+                     RX_FRAME_MAX_LEN, (unsigned int)RadioIf->CryptoBenchPortableNs, AccelImpl,
+                     (unsigned int)RadioIf->CryptoBenchAccelNs, RadioIf->Core.Sec.Impl);
+
+   return true;
+   
+} /* RADIO_IF_CryptoBenchCmd() */
+
+
+/******************************************************************************
+** Function: RADIO_IF_AutoInit
+**
+*/
+void RADIO_IF_AutoInit(void)
+{
+   
+   if (RadioIf->CdsRestored && RadioIf->CdsData.RadioUp)
+   {
+      InitRadio(true);
+   }
+   else if (INITBL_GetIntConfig(RadioIf->IniTbl, CFG_RADIO_AUTO_INIT))
+   {
+      InitRadio(false);
+   }
+   
+} /* End RADIO_IF_AutoInit() */
+
+
+/******************************************************************************
+** Function: RADIO_IF_SaveState
+**
+** Notes:
+**   1. The counters and sequence state are owned by the child task so the
+**      copy is a snapshot that may be one frame behind.
+**   2. The anti-replay windows are saved so a restart doesn't re-accept
+**      captured secured frames. Frames received after the last save,
+**      at most one second, aren't covered.
+**
+*/
+void RADIO_IF_SaveState(void)
+{
+   
+   RADIO_IF_CdsData_t *CdsData = &RadioIf->CdsData;
+   
+   if (!RadioIf->CdsRegistered)
+   {
+      return;
+   }
+   
+   CdsData->Signature      = RADIO_IF_CDS_SIGNATURE;
+   CdsData->SpiSpeed       = RadioIf->SpiSpeed;
+   CdsData->RadioUp        = RadioIf->Initialized;
+   CdsData->UplinkSeqValid = RadioIf->Core.UplinkSeqValid;
+   CdsData->UplinkSeq      = RadioIf->Core.UplinkSeq;
+   CdsData->ActiveProfile  = RadioIf->ActiveProfile;
+   CdsData->RadioConfig    = RadioIf->RadioConfig;
+   CdsData->RxStats        = RadioIf->Core.Stats;
+   RADIO_RX_GetStatus(&CdsData->RadioStatus);
+   memcpy(CdsData->SecWindow, RadioIf->Core.Sec.Window, sizeof(CdsData->SecWindow));
+   
+   CFE_ES_CopyToCDS(RadioIf->CdsHandle, CdsData);
+   
+} /* End RADIO_IF_SaveState() */
+
+
+/******************************************************************************
+** Function: RADIO_IF_InitRadio
+**
+** Notes:
+**   1. A commanded initialization always resets the chip.
+**
+*/
+bool RADIO_IF_InitRadioCmd(void *ObjDataPtr, const CFE_MSG_Message_t *MsgPtr)
+{
+   
+   return InitRadio(false);
+   
+} /* RADIO_IF_InitRadioCmd() */
+
+
+/******************************************************************************
+** Function: RADIO_IF_SendRadioTlmCmd
+**
+** Notes:
+**   1. See radio_if.h file prologue for data source details.
+*/
+bool RADIO_IF_SendRadioTlmCmd(void *ObjDataPtr, const CFE_MSG_Message_t *MsgPtr)
+{
+   
+   LORA_RX_RadioTlm_Payload_t *RadioTlmPayload = &RadioIf->RadioTlm.Payload;
+   
+   strncpy(RadioTlmPayload->SpiDevStr, INITBL_GetStrConfig(RadioIf->IniTbl, CFG_RADIO_SPI_DEV_STR), OS_MAX_PATH_LEN - 1);   
+   RadioTlmPayload->SpiDevNum      = INITBL_GetIntConfig(RadioIf->IniTbl, CFG_RADIO_SPI_DEV_NUM);
+   RadioTlmPayload->SpiSpeed       = RadioIf->SpiSpeed;
+   RadioTlmPayload->SpiCalStatus   = RadioIf->SpiCal.Status;
+   RadioTlmPayload->SpiCalSteps    = RadioIf->SpiCal.StepCnt;
+   RadioTlmPayload->SpiCalMarginSteps = RadioIf->SpiCal.MarginSteps;
+   RadioTlmPayload->SpiCalSpare    = 0;
+   RadioTlmPayload->SpiCalMaxCleanSpeed  = RadioIf->SpiCal.MaxCleanSpeed;
+   RadioTlmPayload->SpiCalFailSpeed      = RadioIf->SpiCal.FailSpeed;
+   RadioTlmPayload->SpiCalFailErrByteCnt = RadioIf->SpiCal.FailErrByteCnt;
+   RadioTlmPayload->SpiCalReadNs   = RadioIf->SpiCal.ReadNs;
+   RadioTlmPayload->SpiCalWriteNs  = RadioIf->SpiCal.WriteNs;
+   RadioTlmPayload->SpiCalUs       = RadioIf->SpiCal.CalUs;
+   RadioTlmPayload->RadioPinBusy   = INITBL_GetIntConfig(RadioIf->IniTbl, CFG_RADIO_PIN_BUSY);
+   RadioTlmPayload->RadioPinNrst   = INITBL_GetIntConfig(RadioIf->IniTbl, CFG_RADIO_PIN_NRST);
+   RadioTlmPayload->RadioPinNss    = INITBL_GetIntConfig(RadioIf->IniTbl, CFG_RADIO_PIN_NSS);
+   RadioTlmPayload->RadioPinDio1   = INITBL_GetIntConfig(RadioIf->IniTbl, CFG_RADIO_PIN_DIO1);
+   RadioTlmPayload->RadioPinDio2   = INITBL_GetIntConfig(RadioIf->IniTbl, CFG_RADIO_PIN_DIO2);
+   RadioTlmPayload->RadioPinDio3   = INITBL_GetIntConfig(RadioIf->IniTbl, CFG_RADIO_PIN_DIO3);
+   RadioTlmPayload->RadioPinTxEn   = INITBL_GetIntConfig(RadioIf->IniTbl, CFG_RADIO_PIN_TX_EN);
+   RadioTlmPayload->RadioPinRxEn   = INITBL_GetIntConfig(RadioIf->IniTbl, CFG_RADIO_PIN_RX_EN);
+
+   RadioTlmPayload->RadioFrequency      = RadioIf->RadioConfig.Frequency;
+   RadioTlmPayload->LoRaSpreadingFactor = RadioIf->RadioConfig.LoRa.SpreadingFactor;
+   RadioTlmPayload->LoRaBandwidth       = RadioIf->RadioConfig.LoRa.Bandwidth;
+   RadioTlmPayload->LoRaCodingRate      = RadioIf->RadioConfig.LoRa.CodingRate;
+   RadioTlmPayload->TCXO                = RadioIf->RadioConfig.LoRa.TCXO;
+   RadioTlmPayload->HSM                 = RadioIf->RadioConfig.LoRa.HSM;
+   RadioTlmPayload->Power               = RadioIf->RadioConfig.LoRa.Power;
+   RadioTlmPayload->CRC                 = RadioIf->RadioConfig.LoRa.CRC;
+   RadioTlmPayload->LDRO                = RadioIf->RadioConfig.LoRa.LDRO;
+   RadioTlmPayload->Node                = RadioIf->RadioConfig.LoRa.Node;
+   RadioTlmPayload->Dest                = RadioIf->RadioConfig.LoRa.Dest;
+   RadioTlmPayload->TXPA                = RadioIf->RadioConfig.LoRa.TXPA;
+   RadioTlmPayload->RXLNA               = RadioIf->RadioConfig.LoRa.RXLNA;
+   RadioTlmPayload->Mod                 = RadioIf->RadioConfig.Mod;
+   RadioTlmPayload->FlrcBitrate         = RadioIf->RadioConfig.Flrc.Bitrate;
+   RadioTlmPayload->FlrcCodingRate      = RadioIf->RadioConfig.Flrc.CodingRate;
+   RadioTlmPayload->FlrcShaping         = RadioIf->RadioConfig.Flrc.Shaping;
+   RadioTlmPayload->FlrcCrcLen          = RadioIf->RadioConfig.Flrc.CrcLen;
+   RadioTlmPayload->FlrcSyncWord        = RadioIf->RadioConfig.Flrc.SyncWord;
+   RadioTlmPayload->SniffRxUs           = RadioIf->RadioConfig.SniffRxUs;
+   RadioTlmPayload->SniffSleepUs        = RadioIf->RadioConfig.SniffSleepUs;
+   RadioTlmPayload->AirSymbolNs         = RadioIf->Airtime.SymbolNs;
+   RadioTlmPayload->AirPreambleUs       = RadioIf->Airtime.PreambleUs;
+   RadioTlmPayload->AirMaxFrameUs       = RadioIf->Airtime.MaxFrameUs;
+   RadioTlmPayload->AirBitRate          = RadioIf->Airtime.BitRate;
+   RadioTlmPayload->RxWaitMs            = RadioIf->RxWaitMs;
+   
+   CFE_SB_TimeStampMsg(CFE_MSG_PTR(RadioIf->RadioTlm.TelemetryHeader));
+   CFE_SB_TransmitMsg(CFE_MSG_PTR(RadioIf->RadioTlm.TelemetryHeader), true);
+
+   CFE_EVS_SendEvent(RADIO_RX_SEND_RADIO_TLM_CMD_EID, CFE_EVS_EventType_INFORMATION,
+                     "Sent Radio configuration telemetry message");
+   return true;
+   
+} /* RADIO_IF_SendRadioTlmCmd() */
+
+
+/******************************************************************************
+** Function: RADIO_IF_SetLoRaParamsCmd
+**
+** Notes:
+**   1. The parameters are validated by compiling them into a profile.
+*/
+bool RADIO_IF_SetLoRaParamsCmd(void *ObjDataPtr, const CFE_MSG_Message_t *MsgPtr)
+{
+   
+   const LORA_RX_SetLoRaParams_CmdPayload_t *Cmd = CMDMGR_PAYLOAD_PTR(MsgPtr, LORA_RX_SetLoRaParams_t);
+   bool RetStatus = false;
+   RADIO_RX_ProfileDef_t   Def;
+   RADIO_RX_ProfileImage_t Image;
+
+   memset(&Def, 0, sizeof(Def));
+   Def.Mod             = RADIO_RX_MOD_LORA;
+   Def.SpreadingFactor = Cmd->SpreadingFactor;
+   Def.Bandwidth       = Cmd->Bandwidth;
+   Def.CodingRate      = Cmd->CodingRate;
+   Def.Crc             = Cmd->CRC;
+
+   if (Cmd->Mod != RADIO_RX_MOD_LORA)
+   {
+      CFE_EVS_SendEvent(RADIO_RX_SET_LORA_PARAMS_CMD_EID, CFE_EVS_EventType_ERROR,
+                        "Set LoRa parameters failed, Mod %d isn't LoRa. Use the FLRC parameters command for FLRC.",
+                        Cmd->Mod);
+   }
+   else if (!RADIO_RX_CompileProfile(&Def, &Image))
+   {
+      CFE_EVS_SendEvent(RADIO_RX_SET_LORA_PARAMS_CMD_EID, CFE_EVS_EventType_ERROR,
+                        "Set LoRa parameters failed, invalid SF=0x%02X, BW=0x%02X, CR=%d or CRC=%d",
+                        Cmd->SpreadingFactor, Cmd->Bandwidth, Cmd->CodingRate, Cmd->CRC);
+   }
+   else if (RadioIf->ReplayActive || RX_SCHED_Busy(&RadioIf->Sched) || RX_SWEEP_Busy(&RadioIf->Sweep))
+   {
+      CFE_EVS_SendEvent(RADIO_RX_SET_LORA_PARAMS_CMD_EID, CFE_EVS_EventType_ERROR,
+                        "Set LoRa parameters failed, a replay, receive schedule or spectrum sweep is running");
+   }
+   else if (RadioIf->Initialized)
+   {
+      RADIO_RX_Lock();
+      RadioIf->RadioConfig.LoRa.SpreadingFactor = Cmd->SpreadingFactor;
+      RadioIf->RadioConfig.LoRa.Bandwidth       = Cmd->Bandwidth;
+      RadioIf->RadioConfig.LoRa.CodingRate      = Cmd->CodingRate;
+      RadioIf->RadioConfig.LoRa.TCXO            = Cmd->TCXO;
+      RadioIf->RadioConfig.LoRa.HSM             = Cmd->HSM;
+      RadioIf->RadioConfig.LoRa.Power           = Cmd->Power;
+      RadioIf->RadioConfig.LoRa.Mod             = Cmd->Mod;
+      RadioIf->RadioConfig.LoRa.CRC             = Cmd->CRC;
+      RadioIf->RadioConfig.LoRa.LDRO            = Cmd->LDRO;
+      RadioIf->RadioConfig.LoRa.Node            = Cmd->Node;
+      RadioIf->RadioConfig.LoRa.Dest            = Cmd->Dest;
+      RadioIf->RadioConfig.LoRa.TXPA            = Cmd->TXPA;
+      RadioIf->RadioConfig.LoRa.RXLNA           = Cmd->RXLNA;
+
+      RadioIf->RadioConfig.Mod = RADIO_RX_MOD_LORA;
+      RadioIf->ActiveProfile   = RADIO_IF_NO_PROFILE;
+      ApplyProfile(&Def, &Image);
+      RADIO_RX_Unlock();
+
+      CFE_EVS_SendEvent(RADIO_RX_SET_LORA_PARAMS_CMD_EID, CFE_EVS_EventType_INFORMATION,
+                        "Set LoRa paramaters: SF=%d, BW=%d, RC=%d", Cmd->SpreadingFactor,
+                        Cmd->Bandwidth, Cmd->CodingRate);
+                        
+      RetStatus = true;
+   }
+   else
+   {
+      CFE_EVS_SendEvent(RADIO_RX_SET_LORA_PARAMS_CMD_EID, CFE_EVS_EventType_ERROR,
+                        "Set LoRa parameters failed, Radio not initialized");
+   }
+
+   return RetStatus;
+   
+} /* RADIO_IF_SetLoRaParamsCmd() */
+
+
+/******************************************************************************
+** Function: RADIO_IF_StartScanCmd
+**
+*/
+bool RADIO_IF_StartScanCmd(void *ObjDataPtr, const CFE_MSG_Message_t *MsgPtr)
+{
+   
+   const SCAN_TBL_Data_t *ScanData = &RadioIf->ScanTbl.Data;
+   RADIO_RX_ScanChannel_t Channel[RADIO_RX_SCAN_MAX_CHANNELS];
+   bool  RetStatus = false;
+   uint8 i;
+   
+   if (!RadioIf->Initialized || RadioIf->RadioConfig.Mod != RADIO_RX_MOD_LORA)
+   {
+      CFE_EVS_SendEvent(RADIO_IF_START_SCAN_CMD_EID, CFE_EVS_EventType_ERROR,
+                        "Start scan failed, radio must be initialized and in LoRa mode");
+   }
+   else if (!RadioIf->ScanTbl.Loaded)
+   {
+      CFE_EVS_SendEvent(RADIO_IF_START_SCAN_CMD_EID, CFE_EVS_EventType_ERROR,
+                        "Start scan failed, no scan table loaded");
+   }
+   else if (RadioIf->ReplayActive || RX_SCHED_Busy(&RadioIf->Sched) || RX_SWEEP_Busy(&RadioIf->Sweep))
+   {
+      CFE_EVS_SendEvent(RADIO_IF_START_SCAN_CMD_EID, CFE_EVS_EventType_ERROR,
+                        "Start scan failed, a replay, receive schedule or spectrum sweep is running");
+   }
+   else
+   {
+      for (i = 0; i < ScanData->ChannelCnt; i++)
+      {
+         Channel[i].Frequency       = ScanData->Channel[i].Frequency*1000UL;
+         Channel[i].SpreadingFactor = ScanData->Channel[i].SpreadingFactor;
+      }
+      
+      RADIO_RX_Lock();
+      RetStatus = RADIO_RX_StartScan(Channel, ScanData->ChannelCnt, ScanData->CadSymbols);
+      if (RetStatus)
+      {
+         RadioIf->ScanActive = true;
+         RadioIf->ScanIdleMs = 0;
+      }
+      RADIO_RX_Unlock();
+      
+      if (RetStatus)
+      {
+         RX_CORE_ResyncUplink(&RadioIf->Core);
+         RADIO_RX_AbortWait();
+         CFE_EVS_SendEvent(RADIO_IF_START_SCAN_CMD_EID, CFE_EVS_EventType_INFORMATION,
+                           "Started CAD scan of %d channels, %d symbols per CAD",
+                           ScanData->ChannelCnt, ScanData->CadSymbols);
+      }
+      else
+      {
+         CFE_EVS_SendEvent(RADIO_IF_START_SCAN_CMD_EID, CFE_EVS_EventType_ERROR,
+                           "Start scan failed, radio rejected the channel list");
+      }
+   }
+   
+   return RetStatus;
+   
+} /* RADIO_IF_StartScanCmd() */
+
+
+/******************************************************************************
+** Function: RADIO_IF_StopScanCmd
+**
+*/
+bool RADIO_IF_StopScanCmd(void *ObjDataPtr, const CFE_MSG_Message_t *MsgPtr)
+{
+   
+   bool RetStatus = false;
+   
+   if (RadioIf->ScanActive)
+   {
+      RADIO_RX_Lock();
+      ApplyModulation();
+      RADIO_RX_Unlock();
+      CFE_EVS_SendEvent(RADIO_IF_STOP_SCAN_CMD_EID, CFE_EVS_EventType_INFORMATION,
+                        "Stopped CAD scan, receiving on %d MHz", RadioIf->RadioConfig.Frequency);
+      RetStatus = true;
+   }
+   else
+   {
+      CFE_EVS_SendEvent(RADIO_IF_STOP_SCAN_CMD_EID, CFE_EVS_EventType_ERROR,
+                        "Stop scan failed, no scan in progress");
+   }
+   
+   return RetStatus;
+   
+} /* RADIO_IF_StopScanCmd() */
+
+
+/******************************************************************************
+** Function: RADIO_IF_StartSweepCmd
+**
+*/
+bool RADIO_IF_StartSweepCmd(void *ObjDataPtr, const CFE_MSG_Message_t *MsgPtr)
+{
+   
+   const LORA_RX_StartSweep_CmdPayload_t *Cmd = CMDMGR_PAYLOAD_PTR(MsgPtr, LORA_RX_StartSweep_t);
+   RX_SWEEP_Plan_t Plan;
+   bool RetStatus = false;
+   
+   if (!RadioIf->Initialized)
+   {
+      CFE_EVS_SendEvent(RADIO_IF_START_SWEEP_CMD_EID, CFE_EVS_EventType_ERROR,
+                        "Start sweep failed, Radio not initialized");
+   }
+   else if (RadioIf->ReplayActive || RX_SCHED_Busy(&RadioIf->Sched))
+   {
+      CFE_EVS_SendEvent(RADIO_IF_START_SWEEP_CMD_EID, CFE_EVS_EventType_ERROR,
+                        "Start sweep failed, a replay or receive schedule is running");
+   }
+   else if (!RX_SWEEP_MakePlan(Cmd->StartKHz, Cmd->StopKHz, Cmd->StepKHz, Cmd->SettleUs, &Plan))
+   {
+      CFE_EVS_SendEvent(RADIO_IF_START_SWEEP_CMD_EID, CFE_EVS_EventType_ERROR,
+                        "Start sweep failed, invalid band %u to %u kHz, step %u kHz or settle %u us. "
+                        "Band must be within %u to %u kHz with at most %u steps, settle at most %u us",
+                        (unsigned int)Cmd->StartKHz, (unsigned int)Cmd->StopKHz, (unsigned int)Cmd->StepKHz,
+                        (unsigned int)Cmd->SettleUs, RX_SWEEP_MIN_KHZ, RX_SWEEP_MAX_KHZ,
+                        RX_SWEEP_MAX_STEPS, RX_SWEEP_MAX_SETTLE_US);
+   }
+   else if (!RX_SWEEP_Start(&RadioIf->Sweep, &Plan))
+   {
+      CFE_EVS_SendEvent(RADIO_IF_START_SWEEP_CMD_EID, CFE_EVS_EventType_ERROR,
+                        "Start sweep failed, the previous sweep command hasn't been applied by the receive task");
+   }
+   else
+   {
+      RADIO_RX_AbortWait();
+      CFE_EVS_SendEvent(RADIO_IF_START_SWEEP_CMD_EID, CFE_EVS_EventType_INFORMATION,
+                        "Started sweep from %u kHz: %d steps of %u kHz in %d bins, %u us settle",
+                        (unsigned int)Plan.StartKHz, Plan.StepCnt, (unsigned int)Plan.StepKHz,
+                        Plan.BinCnt, (unsigned int)Plan.SettleUs);
+      RetStatus = true;
+   }
+   
+   return RetStatus;
+   
+} /* RADIO_IF_StartSweepCmd() */
+
+
+/******************************************************************************
+** Function: RADIO_IF_StopSweepCmd
+**
+*/
+bool RADIO_IF_StopSweepCmd(void *ObjDataPtr, const CFE_MSG_Message_t *MsgPtr)
+{
+   
+   bool RetStatus = false;
+   
+   if (!RX_SWEEP_Busy(&RadioIf->Sweep))
+   {
+      CFE_EVS_SendEvent(RADIO_IF_STOP_SWEEP_CMD_EID, CFE_EVS_EventType_ERROR,
+                        "Stop sweep failed, no sweep in progress");
+   }
+   else if (!RX_SWEEP_Stop(&RadioIf->Sweep))
+   {
+      CFE_EVS_SendEvent(RADIO_IF_STOP_SWEEP_CMD_EID, CFE_EVS_EventType_ERROR,
+                        "Stop sweep failed, the previous sweep command hasn't been applied by the receive task");
+   }
+   else
+   {
+      RADIO_RX_AbortWait();
+      CFE_EVS_SendEvent(RADIO_IF_STOP_SWEEP_CMD_EID, CFE_EVS_EventType_INFORMATION,
+                        "Stopped sweep, receiving on %d MHz", RadioIf->RadioConfig.Frequency);
+      RetStatus = true;
+   }
+   
+   return RetStatus;
+   
+} /* RADIO_IF_StopSweepCmd() */
+
+
+/******************************************************************************
+** Function: RADIO_IF_SetFlrcParamsCmd
+**
+*/
+bool RADIO_IF_SetFlrcParamsCmd(void *ObjDataPtr, const CFE_MSG_Message_t *MsgPtr)
+{
+   
+   const LORA_RX_SetFlrcParams_CmdPayload_t *Cmd = CMDMGR_PAYLOAD_PTR(MsgPtr, LORA_RX_SetFlrcParams_t);
+   bool RetStatus = false;
+   RADIO_RX_ProfileDef_t   Def;
+   RADIO_RX_ProfileImage_t Image;
+
+   memset(&Def, 0, sizeof(Def));
+   Def.Mod        = RADIO_RX_MOD_FLRC;
+   Def.Bitrate    = Cmd->Bitrate;
+   Def.CodingRate = Cmd->CodingRate;
+   Def.Shaping    = Cmd->Shaping;
+   Def.Crc        = Cmd->CrcLen;
+   Def.SyncWord   = Cmd->SyncWord;
+
+   if (!RADIO_RX_CompileProfile(&Def, &Image))
+   {
+      CFE_EVS_SendEvent(RADIO_RX_SET_FLRC_PARAMS_CMD_EID, CFE_EVS_EventType_ERROR,
+                        "Set FLRC parameters failed, invalid BR=0x%02X, CR=%d, Shaping=0x%02X or CRC=%d",
+                        Cmd->Bitrate, Cmd->CodingRate, Cmd->Shaping, Cmd->CrcLen);
+   }
+   else if (RadioIf->ReplayActive || RX_SCHED_Busy(&RadioIf->Sched) || RX_SWEEP_Busy(&RadioIf->Sweep))
+   {
+      CFE_EVS_SendEvent(RADIO_RX_SET_FLRC_PARAMS_CMD_EID, CFE_EVS_EventType_ERROR,
+                        "Set FLRC parameters failed, a replay, receive schedule or spectrum sweep is running");
+   }
+   else if (RadioIf->Initialized)
+   {
+      RADIO_RX_Lock();
+      memcpy(&RadioIf->RadioConfig.Flrc, Cmd, sizeof(LORA_RX_SetFlrcParams_CmdPayload_t));
+      
+      RadioIf->RadioConfig.Mod = RADIO_RX_MOD_FLRC;
+      RadioIf->ActiveProfile   = RADIO_IF_NO_PROFILE;
+      ApplyProfile(&Def, &Image);
+      RADIO_RX_Unlock();
+
+      CFE_EVS_SendEvent(RADIO_RX_SET_FLRC_PARAMS_CMD_EID, CFE_EVS_EventType_INFORMATION,
+                        "Set FLRC paramaters: BR=0x%02X, CR=%d, Shaping=0x%02X, CRC=%d, SyncWord=0x%08X",
+                        Cmd->Bitrate, Cmd->CodingRate, Cmd->Shaping, Cmd->CrcLen, (unsigned int)Cmd->SyncWord);
+                        
+      RetStatus = true;
+   }
+   else
+   {
+      CFE_EVS_SendEvent(RADIO_RX_SET_FLRC_PARAMS_CMD_EID, CFE_EVS_EventType_ERROR,
+                        "Set FLRC parameters failed, Radio not initialized");
+   }
+
+   return RetStatus;
+   
+} /* RADIO_IF_SetFlrcParamsCmd() */
+
+
+/******************************************************************************
+** Function: RADIO_IF_SetSniffModeCmd
+**
+*/
+bool RADIO_IF_SetSniffModeCmd(void *ObjDataPtr, const CFE_MSG_Message_t *MsgPtr)
+{
+   
+   const LORA_RX_SetSniffMode_CmdPayload_t *Cmd = CMDMGR_PAYLOAD_PTR(MsgPtr, LORA_RX_SetSniffMode_t);
+   bool RetStatus = false;
+
+   if (!RadioIf->Initialized)
+   {
+      CFE_EVS_SendEvent(RADIO_IF_SET_SNIFF_MODE_CMD_EID, CFE_EVS_EventType_ERROR,
+                        "Set sniff mode failed, Radio not initialized");
+   }
+   else if (RadioIf->ReplayActive || RX_SWEEP_Busy(&RadioIf->Sweep))
+   {
+      CFE_EVS_SendEvent(RADIO_IF_SET_SNIFF_MODE_CMD_EID, CFE_EVS_EventType_ERROR,
+                        "Set sniff mode failed, a replay or spectrum sweep is running");
+   }
+   else if (Cmd->SleepPeriodUs > 0 &&
+            (Cmd->RxPeriodUs < 16 || Cmd->RxPeriodUs > RADIO_RX_SNIFF_MAX_PERIOD_US ||
+             Cmd->SleepPeriodUs < 16 || Cmd->SleepPeriodUs > RADIO_RX_SNIFF_MAX_PERIOD_US))
+   {
+      CFE_EVS_SendEvent(RADIO_IF_SET_SNIFF_MODE_CMD_EID, CFE_EVS_EventType_ERROR,
+                        "Set sniff mode failed, RX %u and sleep %u us periods must be between 16 and %u us",
+                        (unsigned int)Cmd->RxPeriodUs, (unsigned int)Cmd->SleepPeriodUs,
+                        RADIO_RX_SNIFF_MAX_PERIOD_US);
+   }
+   else
+   {
+      RADIO_RX_Lock();
+      RadioIf->RadioConfig.SniffRxUs    = Cmd->RxPeriodUs;
+      RadioIf->RadioConfig.SniffSleepUs = Cmd->SleepPeriodUs;
+      if (!RadioIf->ScanActive)
+      {
+         StartReceive();
+      }
+      RADIO_RX_Unlock();
+      
+      if (RadioIf->RadioConfig.SniffSleepUs > 0)
+      {
+         CFE_EVS_SendEvent(RADIO_IF_SET_SNIFF_MODE_CMD_EID, CFE_EVS_EventType_INFORMATION,
+                           "Sniff mode enabled: RX %u us, sleep %u us",
+                           (unsigned int)Cmd->RxPeriodUs, (unsigned int)Cmd->SleepPeriodUs);
+      }
+      else
+      {
+         CFE_EVS_SendEvent(RADIO_IF_SET_SNIFF_MODE_CMD_EID, CFE_EVS_EventType_INFORMATION,
+                           "Sniff mode disabled, continuous receive");
+      }
+      RetStatus = true;
+   }
+
+   return RetStatus;
+   
+} /* RADIO_IF_SetSniffModeCmd() */
+
+
+/******************************************************************************
+** Function: RADIO_IF_SelectProfileCmd
+**
+*/
+bool RADIO_IF_SelectProfileCmd(void *ObjDataPtr, const CFE_MSG_Message_t *MsgPtr)
+{
+   
+   const LORA_RX_SelectProfile_CmdPayload_t *Cmd = CMDMGR_PAYLOAD_PTR(MsgPtr, LORA_RX_SelectProfile_t);
+   bool RetStatus = false;
+   const PROFILE_TBL_Profile_t *Profile;
+
+   if (!RadioIf->Initialized)
+   {
+      CFE_EVS_SendEvent(RADIO_IF_SELECT_PROFILE_CMD_EID, CFE_EVS_EventType_ERROR,
+                        "Select profile failed, Radio not initialized");
+   }
+   else if (Cmd->Id >= PROFILE_TBL_MAX_PROFILES || !RadioIf->ProfileTbl.Profile[Cmd->Id].Valid)
+   {
+      CFE_EVS_SendEvent(RADIO_IF_SELECT_PROFILE_CMD_EID, CFE_EVS_EventType_ERROR,
+                        "Select profile failed, profile %d isn't defined", Cmd->Id);
+   }
+   else if (RadioIf->ReplayActive || RX_SCHED_Busy(&RadioIf->Sched) || RX_SWEEP_Busy(&RadioIf->Sweep))
+   {
+      CFE_EVS_SendEvent(RADIO_IF_SELECT_PROFILE_CMD_EID, CFE_EVS_EventType_ERROR,
+                        "Select profile failed, a replay, receive schedule or spectrum sweep is running");
+   }
+   else
+   {
+      Profile = &RadioIf->ProfileTbl.Profile[Cmd->Id];
+      
+      RADIO_RX_Lock();
+      RadioIf->RadioConfig.Mod = Profile->Def.Mod;
+      if (Profile->Def.Mod == RADIO_RX_MOD_FLRC)
+      {
+         RadioIf->RadioConfig.Flrc.Bitrate    = Profile->Def.Bitrate;
+         RadioIf->RadioConfig.Flrc.CodingRate = Profile->Def.CodingRate;
+         RadioIf->RadioConfig.Flrc.Shaping    = Profile->Def.Shaping;
+         RadioIf->RadioConfig.Flrc.CrcLen     = Profile->Def.Crc;
+         RadioIf->RadioConfig.Flrc.SyncWord   = Profile->Def.SyncWord;
+      }
+      else
+      {
+         RadioIf->RadioConfig.LoRa.SpreadingFactor = Profile->Def.SpreadingFactor;
+         RadioIf->RadioConfig.LoRa.Bandwidth       = Profile->Def.Bandwidth;
+         RadioIf->RadioConfig.LoRa.CodingRate      = Profile->Def.CodingRate;
+         RadioIf->RadioConfig.LoRa.CRC             = Profile->Def.Crc;
+      }
+      if (Profile->Def.Frequency != 0)
+      {
+         RadioIf->RadioConfig.Frequency = Profile->Def.Frequency;
+      }
+      
+      ApplyProfile(&Profile->Def, &Profile->Image);
+      RadioIf->ActiveProfile = Cmd->Id;
+      RADIO_RX_Unlock();
+
+      CFE_EVS_SendEvent(RADIO_IF_SELECT_PROFILE_CMD_EID, CFE_EVS_EventType_INFORMATION,
+                        "Selected profile %d '%s', receiving after %u us",
+                        Cmd->Id, Profile->Def.Name, (unsigned int)RadioIf->ProfileSwitchUs);
+      RetStatus = true;
+   }
+
+   return RetStatus;
+   
+} /* RADIO_IF_SelectProfileCmd() */
+
+
+/******************************************************************************
+** Function: RADIO_IF_DumpTraceCmd
+**
+** Notes:
+**   1. Events are written as duration begin/end pairs with the stage
+**      argument in args. The buffers are rings so the first events of a
+**      task may be ends without a begin, trace viewers ignore them.
+**
+*/
+bool RADIO_IF_DumpTraceCmd(void *ObjDataPtr, const CFE_MSG_Message_t *MsgPtr)
+{
+   
+   const LORA_RX_DumpTrace_CmdPayload_t *Cmd = CMDMGR_PAYLOAD_PTR(MsgPtr, LORA_RX_DumpTrace_t);
+   bool      RetStatus = false;
+   int32     SysStatus;
+   osal_id_t FileHandle;
+   uint32    EventCnt[RX_TRACE_TASK_CNT];
+   uint32    LostCnt[RX_TRACE_TASK_CNT];
+   int64     BaseNs = 0;
+   bool      BaseValid = false;
+   uint16    Task;
+
+   for (Task = 0; Task < RX_TRACE_TASK_CNT; Task++)
+   {
+      EventCnt[Task] = RX_TRACE_Snapshot(Task, &TraceEvent[Task*RX_TRACE_TaskEvents()], &LostCnt[Task]);
+      if (EventCnt[Task] > 0 && (!BaseValid || TraceEvent[Task*RX_TRACE_TaskEvents()].TimeNs < BaseNs))
+      {
+         BaseNs    = TraceEvent[Task*RX_TRACE_TaskEvents()].TimeNs;
+         BaseValid = true;
+      }
+   }
+
+   SysStatus = OS_OpenCreate(&FileHandle, Cmd->Filename, OS_FILE_FLAG_CREATE | OS_FILE_FLAG_TRUNCATE, OS_WRITE_ONLY);
+
+   if (SysStatus == OS_SUCCESS)
+   {
+      
+      TraceFileLen = 0;
+      WriteTraceRecord(FileHandle, "{\"displayTimeUnit\": \"ns\", \"traceEvents\": [\n", false);
+      WriteTraceRecord(FileHandle, "{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": 0, \"args\": {\"name\": \"radio-irq\"}},\n", false);
+      WriteTraceRecord(FileHandle, "{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": 1, \"args\": {\"name\": \"rx-child\"}}", false);
+      
+      for (Task = 0; Task < RX_TRACE_TASK_CNT; Task++)
+      {
+         WriteTraceTask(FileHandle, Task, EventCnt[Task], BaseNs);
+      }
+      
+      WriteTraceRecord(FileHandle, "\n]}\n", true);
+      OS_close(FileHandle);
+
+      CFE_EVS_SendEvent(RADIO_IF_DUMP_TRACE_CMD_EID, CFE_EVS_EventType_INFORMATION,
+                        "Dumped %u radio and %u child trace events to %s, %u and %u lost since the last dump%s",
+                        (unsigned int)EventCnt[RX_TRACE_TASK_RADIO], (unsigned int)EventCnt[RX_TRACE_TASK_CHILD],
+                        Cmd->Filename, (unsigned int)LostCnt[RX_TRACE_TASK_RADIO],
+                        (unsigned int)LostCnt[RX_TRACE_TASK_CHILD], RX_TRACE_Enabled() ? "" : ", tracing is disabled");
+      RetStatus = true;
+
+   } /* End if file create */
+   else
+   {
+
+      CFE_EVS_SendEvent(RADIO_IF_DUMP_TRACE_CMD_EID, CFE_EVS_EventType_ERROR,
+                        "Error creating trace dump file '%s', status=0x%08X",
+                        Cmd->Filename, SysStatus);
+
+   } /* End if file create error */
+
+   return RetStatus;
+
+} /* RADIO_IF_DumpTraceCmd() */
+
+
+/******************************************************************************
+** Function: RADIO_IF_DumpSpiRecCmd
+**
+** Notes:
+**   1. The file buffer holds the recording being replayed during a replay
+**      so dumps are rejected until the replay has ended.
+**
+*/
+bool RADIO_IF_DumpSpiRecCmd(void *ObjDataPtr, const CFE_MSG_Message_t *MsgPtr)
+{
+   
+   const LORA_RX_DumpSpiRec_CmdPayload_t *Cmd = CMDMGR_PAYLOAD_PTR(MsgPtr, LORA_RX_DumpSpiRec_t);
+   bool      RetStatus = false;
+   int32     SysStatus;
+   osal_id_t FileHandle;
+   uint32    FileLen;
+   SPI_REC_Status_t RecStatus;
+   
+   if (RadioIf->ReplayActive)
+   {
+      CFE_EVS_SendEvent(RADIO_IF_DUMP_SPI_REC_CMD_EID, CFE_EVS_EventType_ERROR,
+                        "SPI recording dump rejected, a replay is in progress");
+      return false;
+   }
+   
+   FileLen = SPI_REC_Snapshot((uint8 *)SpiRecFile);
+   SPI_REC_GetStatus(&RecStatus);
+   
+   SysStatus = OS_OpenCreate(&FileHandle, Cmd->Filename, OS_FILE_FLAG_CREATE | OS_FILE_FLAG_TRUNCATE, OS_WRITE_ONLY);
+
+   if (SysStatus == OS_SUCCESS)
+   {
+      
+      SysStatus = OS_write(FileHandle, SpiRecFile, FileLen);
+      OS_close(FileHandle);
+      
+      if (SysStatus == (int32)FileLen)
+      {
+         CFE_EVS_SendEvent(RADIO_IF_DUMP_SPI_REC_CMD_EID, CFE_EVS_EventType_INFORMATION,
+                           "Dumped %u SPI records (%u bytes) to %s, %u evicted%s",
+                           (unsigned int)((SPI_REC_FileHdr_t *)SpiRecFile)->RecordCnt, (unsigned int)FileLen,
+                           Cmd->Filename, (unsigned int)RecStatus.EvictCnt,
+                           RecStatus.Enabled ? "" : ", recording is disabled");
+         RetStatus = true;
+      }
+      else
+      {
+         CFE_EVS_SendEvent(RADIO_IF_DUMP_SPI_REC_CMD_EID, CFE_EVS_EventType_ERROR,
+                           "Error writing SPI recording file '%s', status=0x%08X",
+                           Cmd->Filename, SysStatus);
+      }
+
+   } /* End if file create */
+   else
+   {
+
+      CFE_EVS_SendEvent(RADIO_IF_DUMP_SPI_REC_CMD_EID, CFE_EVS_EventType_ERROR,
+                        "Error creating SPI recording file '%s', status=0x%08X",
+                        Cmd->Filename, SysStatus);
+
+   } /* End if file create error */
+
+   return RetStatus;
+
+} /* RADIO_IF_DumpSpiRecCmd() */
+
+
+/******************************************************************************
+** Function: RADIO_IF_ReplaySpiRecCmd
+**
+*/
+bool RADIO_IF_ReplaySpiRecCmd(void *ObjDataPtr, const CFE_MSG_Message_t *MsgPtr)
+{
+   
+   const LORA_RX_ReplaySpiRec_CmdPayload_t *Cmd = CMDMGR_PAYLOAD_PTR(MsgPtr, LORA_RX_ReplaySpiRec_t);
+   bool      RetStatus = false;
+   bool      ScanStopped;
+   bool      Started;
+   int32     SysStatus;
+   osal_id_t FileHandle;
+   RADIO_RX_ReplayStatus_t Replay;
+   
+   if (!RadioIf->Initialized)
+   {
+      CFE_EVS_SendEvent(RADIO_IF_REPLAY_SPI_REC_CMD_EID, CFE_EVS_EventType_ERROR,
+                        "SPI replay rejected, radio not initialized");
+      return false;
+   }
+   if (RadioIf->ReplayActive)
+   {
+      CFE_EVS_SendEvent(RADIO_IF_REPLAY_SPI_REC_CMD_EID, CFE_EVS_EventType_ERROR,
+                        "SPI replay rejected, a replay is in progress");
+      return false;
+   }
+   if (RX_SCHED_Busy(&RadioIf->Sched) || RX_SWEEP_Busy(&RadioIf->Sweep))
+   {
+      CFE_EVS_SendEvent(RADIO_IF_REPLAY_SPI_REC_CMD_EID, CFE_EVS_EventType_ERROR,
+                        "SPI replay rejected, a receive schedule or spectrum sweep is running");
+      return false;
+   }
+   
+   SysStatus = OS_OpenCreate(&FileHandle, Cmd->Filename, OS_FILE_FLAG_NONE, OS_READ_ONLY);
+
+   if (SysStatus == OS_SUCCESS)
+   {
+      
+      SysStatus = OS_read(FileHandle, SpiRecFile, sizeof(SpiRecFile));
+      OS_close(FileHandle);
+      
+      RADIO_RX_Lock();
+      ScanStopped = RadioIf->ScanActive;
+      if (ScanStopped)
+      {
+         RADIO_RX_StopScan();
+         RADIO_RX_SetRadioFrequency(RadioIf->RadioConfig.Frequency*1000000UL);
+         RadioIf->ScanActive = false;
+      }
+      Started = (SysStatus > 0 && RADIO_RX_StartReplay((const uint8 *)SpiRecFile, (uint32)SysStatus));
+      if (Started)
+      {
+         RadioIf->ReplayActive = true;
+      }
+      else if (ScanStopped)
+      {
+         StartReceive();
+      }
+      RADIO_RX_Unlock();
+      
+      if (Started)
+      {
+         RADIO_RX_GetReplayStatus(&Replay);
+         CFE_EVS_SendEvent(RADIO_IF_REPLAY_SPI_REC_CMD_EID, CFE_EVS_EventType_INFORMATION,
+                           "Replaying %u SPI records from %s%s", (unsigned int)Replay.RecordCnt, Cmd->Filename,
+                           ScanStopped ? ", CAD scan stopped" : "");
+         RetStatus = true;
+      }
+      else
+      {
+         CFE_EVS_SendEvent(RADIO_IF_REPLAY_SPI_REC_CMD_EID, CFE_EVS_EventType_ERROR,
+                           "SPI replay rejected, '%s' isn't a valid SPI recording, status=0x%08X%s",
+                           Cmd->Filename, SysStatus, ScanStopped ? ", CAD scan stopped" : "");
+      }
+
+   } /* End if file open */
+   else
+   {
+
+      CFE_EVS_SendEvent(RADIO_IF_REPLAY_SPI_REC_CMD_EID, CFE_EVS_EventType_ERROR,
+                        "Error opening SPI recording file '%s', status=0x%08X",
+                        Cmd->Filename, SysStatus);
+
+   } /* End if file open error */
+
+   return RetStatus;
+
+} /* RADIO_IF_ReplaySpiRecCmd() */
+
+
+/******************************************************************************
+** Function: RADIO_IF_SetRadioFrequencyCmd
+**
+*/
+bool RADIO_IF_SetRadioFrequencyCmd(void *ObjDataPtr, const CFE_MSG_Message_t *MsgPtr)
+{
+   
+   const LORA_RX_SetRadioFrequency_CmdPayload_t *Cmd = CMDMGR_PAYLOAD_PTR(MsgPtr, LORA_RX_SetRadioFrequency_t);
+   bool RetStatus = false;
+
+   if (Cmd->Frequency >= RADIO_RX_MIN_FREQ_MHZ && Cmd->Frequency <= RADIO_RX_MAX_FREQ_MHZ)
+   {
+      if (RadioIf->ReplayActive || RX_SCHED_Busy(&RadioIf->Sched) || RX_SWEEP_Busy(&RadioIf->Sweep))
+      {
+         CFE_EVS_SendEvent(RADIO_RX_SET_RADIO_FREQUENCY_CMD_EID, CFE_EVS_EventType_ERROR,
+                           "Set radio frequency failed, a replay, receive schedule or spectrum sweep is running");
+      }
+      else if (RadioIf->Initialized)
+      {
+         RADIO_RX_Lock();
+         RadioIf->RadioConfig.Frequency = Cmd->Frequency;
+         if (RadioIf->ScanActive)
+         {
+            ApplyModulation();
+         }
+         else
+         {
+            RADIO_RX_SetRadioFrequency(Cmd->Frequency*1000000UL);
+         }
+         RADIO_RX_Unlock();
+         CFE_EVS_SendEvent(RADIO_RX_SET_RADIO_FREQUENCY_CMD_EID, CFE_EVS_EventType_INFORMATION,
+                           "Set radio frequency to %d Mhz", Cmd->Frequency);
+         RetStatus = true;
+      }
+      else
+      {
+         CFE_EVS_SendEvent(RADIO_RX_SET_RADIO_FREQUENCY_CMD_EID, CFE_EVS_EventType_ERROR,
+                           "Set radio frequency failed, Radio not initialized");
+      }
+
+   }
+   else
+   {
+      CFE_EVS_SendEvent(RADIO_RX_SET_RADIO_FREQUENCY_CMD_EID, CFE_EVS_EventType_ERROR,
+                           "Set radio frequency failed, invalid frequency %d MHz. Must be within %d to %d MHz.",
+                           Cmd->Frequency, RADIO_RX_MIN_FREQ_MHZ, RADIO_RX_MAX_FREQ_MHZ);
+   }
+
+   return RetStatus;
+   
+} /* RADIO_IF_SetRadioFrequencyCmd() */
+
+
+/******************************************************************************
+** Function: RADIO_IF_CalibrateSpiCmd
+**
+*/
+bool RADIO_IF_CalibrateSpiCmd(void *ObjDataPtr, const CFE_MSG_Message_t *MsgPtr)
+{
+   
+   bool RetStatus;
+   
+   if (!RadioIf->Initialized || RadioIf->ReplayActive || RX_SWEEP_Busy(&RadioIf->Sweep) ||
+       RX_SCHED_Busy(&RadioIf->Sched) || RadioIf->ScanActive)
+   {
+      CFE_EVS_SendEvent(RADIO_IF_CALIBRATE_SPI_CMD_EID, CFE_EVS_EventType_ERROR,
+                        "SPI calibration rejected, radio %s", 
+                        !RadioIf->Initialized ? "not initialized" :
+                        RadioIf->ReplayActive ? "replay in progress" :
+                        RX_SWEEP_Busy(&RadioIf->Sweep) ? "spectrum sweep in progress" :
+                        RX_SCHED_Busy(&RadioIf->Sched) ? "receive schedule running" : "CAD scan active");
+      return false;
+   }
+   
+   RADIO_RX_Lock();
+   RetStatus = CalibrateSpi();
+   
+   RADIO_RX_SetSpiSpeed(RadioIf->SpiSpeed);
+   ApplyModulation();
+   RADIO_RX_Unlock();
+   RADIO_IF_SaveState();
+   
+   return RetStatus;
+   
+} /* RADIO_IF_CalibrateSpiCmd() */
+
+
+/******************************************************************************
+** Function: RADIO_IF_SetSpiSpeedCmd
+**
+*/
+bool RADIO_IF_SetSpiSpeedCmd(void *ObjDataPtr, const CFE_MSG_Message_t *MsgPtr)
+{
+   
+   const LORA_RX_SetSpiSpeed_CmdPayload_t *Cmd = CMDMGR_PAYLOAD_PTR(MsgPtr, LORA_RX_SetSpiSpeed_t);
+   bool RetStatus = false;
+
+   if (Cmd->Speed > 0 && Cmd->Speed <= RADIO_RX_SPI_MAX_SPEED)
+   {
+      if (RadioIf->ReplayActive || RX_SCHED_Busy(&RadioIf->Sched) || RX_SWEEP_Busy(&RadioIf->Sweep))
+      {
+         CFE_EVS_SendEvent(RADIO_RX_SET_SPI_SPEED_CMD_EID, CFE_EVS_EventType_ERROR,
+                           "Set radio SPI speed failed, a replay, receive schedule or spectrum sweep is running");
+      }
+      else if (RadioIf->Initialized)
+      {
+         RADIO_RX_Lock();
+         RadioIf->SpiSpeed = Cmd->Speed;
+         RADIO_RX_SetSpiSpeed(Cmd->Speed);
+         if (RadioIf->SpiCal.Status != RADIO_IF_SPI_CAL_NONE)
+         {
+            RadioIf->SpiCal.Status = RADIO_IF_SPI_CAL_OVERRIDDEN;
+            RadioIf->SpiCal.Speed  = Cmd->Speed;
+         }
+         RADIO_RX_Unlock();
+         CFE_EVS_SendEvent(RADIO_RX_SET_SPI_SPEED_CMD_EID, CFE_EVS_EventType_INFORMATION,
+                           "Set radio SPI speed to %d", Cmd->Speed);
+         RetStatus = true;
+      }
+      else
+      {
+         CFE_EVS_SendEvent(RADIO_RX_SET_SPI_SPEED_CMD_EID, CFE_EVS_EventType_ERROR,
+                           "Set radio SPI speed failed, Radio not initialized");
+      }
+
+   }
+   else
+   {
+      CFE_EVS_SendEvent(RADIO_RX_SET_SPI_SPEED_CMD_EID, CFE_EVS_EventType_ERROR,
+                           "Set radio SPI speed failed, invalid speed %d.",
+                           Cmd->Speed);
+   }
+
+   return RetStatus;
+   
+} /* RADIO_IF_SetSpiSpeedCmd() */
+
+
+/******************************************************************************
+** Function: InitRadio
+**
+** Notes:
+**   1. A warm start falls back to a full initialization if the radio
+**      doesn't respond.
+**   2. The initialization time is measured until the radio is receiving.
+**   3. The radio is rebuilt under the radio lock. The child task only
+**      touches the radio under the lock, so once it's taken the child has
+**      left any sweep or recovery and sees Initialized false until the
+**      new radio is configured.
+**
+*/
+static bool InitRadio(bool WarmStart)
+{
+   
+   bool RetStatus = false;
+   RADIO_RX_Pin_t RadioPin;
+   OS_time_t StartTime;
+   OS_time_t EndTime;
+   uint32 WatchdogBusyUs;
+   uint32 WatchdogSilenceMs;
+   const char *SpiDevStr = INITBL_GetStrConfig(RadioIf->IniTbl, CFG_RADIO_SPI_DEV_STR);
+   uint8 SpiDevNum = INITBL_GetIntConfig(RadioIf->IniTbl, CFG_RADIO_SPI_DEV_NUM);
+
+   RADIO_RX_Lock();
+   RadioIf->Initialized = false;
+   if (!RadioIf->MemReady)
+   {
+      RADIO_RX_Unlock();
+      CFE_EVS_SendEvent(RADIO_RX_INIT_RADIO_CMD_EID, CFE_EVS_EventType_ERROR,
+                        "RX Radio not initialized, receive path buffers weren't allocated from the arena");
+      return false;
+   }
+   if (RX_SWEEP_Busy(&RadioIf->Sweep))
+   {
+      /* The child task applies the stop after the radio is initialized */
+      RX_SWEEP_Stop(&RadioIf->Sweep);
+   }
+   RADIO_RX_AbortWait();
+   OS_GetLocalTime(&StartTime);
+
+   RadioPin.Busy = INITBL_GetIntConfig(RadioIf->IniTbl, CFG_RADIO_PIN_BUSY);
+   RadioPin.Nrst = INITBL_GetIntConfig(RadioIf->IniTbl, CFG_RADIO_PIN_NRST);
+   RadioPin.Nss  = INITBL_GetIntConfig(RadioIf->IniTbl, CFG_RADIO_PIN_NSS);
+   RadioPin.Dio1 = INITBL_GetIntConfig(RadioIf->IniTbl, CFG_RADIO_PIN_DIO1);
+   RadioPin.Dio2 = INITBL_GetIntConfig(RadioIf->IniTbl, CFG_RADIO_PIN_DIO2);
+   RadioPin.Dio3 = INITBL_GetIntConfig(RadioIf->IniTbl, CFG_RADIO_PIN_DIO3);
+   RadioPin.TxEn = INITBL_GetIntConfig(RadioIf->IniTbl, CFG_RADIO_PIN_TX_EN);
+   RadioPin.RxEn = INITBL_GetIntConfig(RadioIf->IniTbl, CFG_RADIO_PIN_RX_EN);
+   
+   if (WarmStart)
+   {
+      WarmStart = RADIO_RX_AttachRadio(SpiDevStr, SpiDevNum, &RadioPin);
+      if (!WarmStart)
+      {
+         CFE_EVS_SendEvent(RADIO_RX_INIT_RADIO_CMD_EID, CFE_EVS_EventType_ERROR,
+                           "Radio not responding after restart (%s), performing a full initialization",
+                           RADIO_RX_LastError());
+      }
+   }
+   RetStatus = WarmStart ? true : RADIO_RX_InitRadio(SpiDevStr, SpiDevNum, &RadioPin);
+   
+   if (RetStatus)
+   {
+      if (!WarmStart && INITBL_GetIntConfig(RadioIf->IniTbl, CFG_SPI_CAL_AT_INIT))
+      {
+         CalibrateSpi();
+      }
+      RADIO_RX_SetSpiSpeed(RadioIf->SpiSpeed);
+      RADIO_RX_SetRadioFrequency(RadioIf->RadioConfig.Frequency*1000000UL);
+      ApplyModulation();
+      
+      OS_GetLocalTime(&EndTime);
+      RadioIf->RadioInitUs    = (uint32)(OS_TimeGetTotalNanoseconds(OS_TimeSubtract(EndTime, StartTime))/1000);
+      
+      WatchdogBusyUs    = INITBL_GetIntConfig(RadioIf->IniTbl, CFG_WATCHDOG_BUSY_TIMEOUT_US);
+      WatchdogSilenceMs = INITBL_GetIntConfig(RadioIf->IniTbl, CFG_WATCHDOG_RX_SILENCE_MS);
+      if (WatchdogBusyUs > 0 || WatchdogSilenceMs > 0)
+      {
+         RADIO_RX_StartWatchdog(WatchdogBusyUs, WatchdogSilenceMs);
+      }
+      RadioIf->RadioWarmStart = WarmStart;
+      RadioIf->Initialized    = true;
+   }
+   RADIO_RX_Unlock();
+   
+   if (RetStatus)
+   {
+      RADIO_IF_SaveState();
+      
+      CFE_EVS_SendEvent(RADIO_RX_INIT_RADIO_CMD_EID, CFE_EVS_EventType_INFORMATION,
+                        "Sucessfully %s the RX Radio in %s mode in %u us",
+                        WarmStart ? "reattached" : "initialized",
+                        (RadioIf->RadioConfig.Mod == RADIO_RX_MOD_FLRC) ? "FLRC" : "LoRa",
+                        (unsigned int)RadioIf->RadioInitUs);
+   }
+   else
+   {
+      CFE_EVS_SendEvent(RADIO_RX_INIT_RADIO_CMD_EID, CFE_EVS_EventType_ERROR,
+                        "Failed to initialize the RX Radio: %s", RADIO_RX_LastError());
+   }
+
+   return RetStatus;
+   
+} /* End InitRadio() */
+
+
+/******************************************************************************
+** Function: RestoreState
+**
+** Register the CDS block and restore the state saved before a restart
+**
+** Notes:
+**   1. A new block (power-on reset) or a block with an old layout leaves
+**      the JSON init file configuration in place.
+**
+*/
+static void RestoreState(void)
+{
+   
+   RADIO_IF_CdsData_t *CdsData = &RadioIf->CdsData;
+   int32 Status;
+   
+   Status = CFE_ES_RegisterCDS(&RadioIf->CdsHandle, sizeof(RADIO_IF_CdsData_t), RADIO_IF_CDS_NAME);
+   
+   if (Status == CFE_ES_CDS_ALREADY_EXISTS)
+   {
+      RadioIf->CdsRegistered = true;
+      if (CFE_ES_RestoreFromCDS(CdsData, RadioIf->CdsHandle) == CFE_SUCCESS &&
+          CdsData->Signature == RADIO_IF_CDS_SIGNATURE)
+      {
+         RadioIf->SpiSpeed       = CdsData->SpiSpeed;
+         RadioIf->RadioConfig    = CdsData->RadioConfig;
+         RadioIf->Core.Stats          = CdsData->RxStats;
+         RadioIf->Core.UplinkSeqValid = CdsData->UplinkSeqValid;
+         RadioIf->Core.UplinkSeq      = CdsData->UplinkSeq;
+         RadioIf->ActiveProfile  = CdsData->ActiveProfile;
+         RADIO_RX_RestoreStatus(&CdsData->RadioStatus);
+         memcpy(RadioIf->Core.Sec.Window, CdsData->SecWindow, sizeof(RadioIf->Core.Sec.Window));
+         RadioIf->CdsRestored = true;
+         
+         CFE_EVS_SendEvent(RADIO_IF_CDS_EID, CFE_EVS_EventType_INFORMATION,
+                           "Restored radio configuration and counters from the CDS, radio was %s",
+                           CdsData->RadioUp ? "receiving" : "not initialized");
+      }
+      else
+      {
+         memset(CdsData, 0, sizeof(RADIO_IF_CdsData_t));
+         CFE_EVS_SendEvent(RADIO_IF_CDS_EID, CFE_EVS_EventType_ERROR,
+                           "CDS radio state invalid, using the init file configuration");
+      }
+   }
+   else if (Status == CFE_SUCCESS)
+   {
+      RadioIf->CdsRegistered = true;
+   }
+   else
+   {
+      CFE_EVS_SendEvent(RADIO_IF_CDS_EID, CFE_EVS_EventType_ERROR,
+                        "Failed to register CDS block, status 0x%08X. Radio state won't survive restarts.",
+                        (unsigned int)Status);
+   }
+   
+} /* End RestoreState() */
+
+
+/******************************************************************************
+** Function: CalibrateSpi
+**
+** Test ascending SPI speeds and set SpiSpeed to the fastest reliable one
+**
+** Notes:
+**   1. The radio is left in standby at the last tested speed, the caller
+**      must apply SpiSpeed and restart receiving.
+**   2. SpiSpeed is unchanged if even the slowest speed fails.
+**
+*/
+static bool CalibrateSpi(void)
+{
+   
+   RADIO_IF_SpiCal_t *Cal = &RadioIf->SpiCal;
+   RADIO_RX_SpiTest_t Test[RADIO_IF_SPI_CAL_STEPS];
+   uint32 MaxSpeed = INITBL_GetIntConfig(RadioIf->IniTbl, CFG_SPI_CAL_MAX_SPEED);
+   uint16 Passes   = INITBL_GetIntConfig(RadioIf->IniTbl, CFG_SPI_CAL_PASSES);
+   uint16 CleanCnt = 0;
+   uint16 Select;
+   uint16 Step;
+   OS_time_t StartTime;
+   OS_time_t EndTime;
+   
+   memset(Cal, 0, sizeof(RADIO_IF_SpiCal_t));
+   OS_GetLocalTime(&StartTime);
+   
+   for (Step = 0; Step < RADIO_IF_SPI_CAL_STEPS && SpiCalSpeed[Step] <= MaxSpeed; Step++)
+   {
+      RADIO_RX_TestSpiSpeed(SpiCalSpeed[Step], Passes, &Test[Step]);
+      Cal->StepCnt++;
+      if (Test[Step].FailPassCnt > 0)
+      {
+         Cal->FailSpeed      = SpiCalSpeed[Step];
+         Cal->FailErrByteCnt = Test[Step].ErrByteCnt;
+         break;
+      }
+      CleanCnt++;
+   }
+   
+   OS_GetLocalTime(&EndTime);
+   Cal->CalUs = (uint32)(OS_TimeGetTotalNanoseconds(OS_TimeSubtract(EndTime, StartTime))/1000);
+   
+   if (CleanCnt == 0)
+   {
+      Cal->Status = RADIO_IF_SPI_CAL_FAILED;
+      CFE_EVS_SendEvent(RADIO_IF_CALIBRATE_SPI_CMD_EID, CFE_EVS_EventType_ERROR,
+                        "SPI calibration failed, %u byte errors at %u Hz, keeping %u Hz",
+                        (unsigned int)Cal->FailErrByteCnt, (unsigned int)Cal->FailSpeed,
+                        (unsigned int)RadioIf->SpiSpeed);
+      return false;
+   }
+   
+   Cal->MaxCleanSpeed = SpiCalSpeed[CleanCnt-1];
+   Select = CleanCnt - 1;
+   if (Cal->FailSpeed != 0)
+   {
+      if (CleanCnt > 1)
+      {
+         Select--;
+      }
+      Cal->MarginSteps = CleanCnt - Select;
+   }
+   Cal->Status  = (Cal->FailSpeed != 0 && CleanCnt == 1) ? RADIO_IF_SPI_CAL_NO_MARGIN : RADIO_IF_SPI_CAL_OK;
+   Cal->Speed   = SpiCalSpeed[Select];
+   Cal->ReadNs  = Test[Select].ReadNs;
+   Cal->WriteNs = Test[Select].WriteNs;
+   
+   RadioIf->SpiSpeed = Cal->Speed;
+   
+   CFE_EVS_SendEvent(RADIO_IF_CALIBRATE_SPI_CMD_EID, 
+                     (Cal->Status == RADIO_IF_SPI_CAL_OK) ? CFE_EVS_EventType_INFORMATION : CFE_EVS_EventType_ERROR,
+                     "SPI calibrated to %u Hz in %u us, fastest clean %u Hz, first failure %u Hz, %u byte read %u us",
+                     (unsigned int)Cal->Speed, (unsigned int)Cal->CalUs, (unsigned int)Cal->MaxCleanSpeed,
+                     (unsigned int)Cal->FailSpeed, RADIO_RX_SPI_TEST_LEN, (unsigned int)(Cal->ReadNs/1000));
+   
+   return true;
+   
+} /* End CalibrateSpi() */
+
+
+/******************************************************************************
+** Function: ApplyModulation
+**
+** Configure the radio for the active modulation and restart receiving
+**
+** Notes:
+**   1. The configuration is validated when it's set so the compile can't
+**      fail here.
+**
+*/
+static void ApplyModulation(void)
+{
+
+   RADIO_RX_ProfileDef_t   Def;
+   RADIO_RX_ProfileImage_t Image;
+
+   ConfigToProfile(&Def);
+   RADIO_RX_CompileProfile(&Def, &Image);
+   ApplyProfile(&Def, &Image);
+
+} /* End ApplyModulation() */
+
+
+/******************************************************************************
+** Function: ApplyProfile
+**
+** Send a compiled profile to the radio and restart receiving
+**
+** Notes:
+**   1. Frame sequence tracking restarts because frames may have been
+**      missed while the radio was reconfigured.
+**   2. A CAD scan retunes the radio so stopping one restores the
+**      commanded frequency.
+**   3. The link model follows the profile so receive timeouts match the
+**      new frame times.
+**   4. Called with the radio lock held, see radio_if.h note 5.
+**
+*/
+static void ApplyProfile(const RADIO_RX_ProfileDef_t *Def, const RADIO_RX_ProfileImage_t *Image)
+{
+
+   OS_time_t StartTime;
+   OS_time_t EndTime;
+
+   OS_GetLocalTime(&StartTime);
+
+   if (RadioIf->ScanActive)
+   {
+      RADIO_RX_StopScan();
+      RADIO_RX_SetRadioFrequency(RadioIf->RadioConfig.Frequency*1000000UL);
+      RadioIf->ScanActive = false;
+   }
+
+   RADIO_RX_ApplyProfile(Image);
+   UpdateLinkModel(Def);
+   StartReceive();
+   
+   RX_CORE_SetAddress(&RadioIf->Core, (uint8)RadioIf->RadioConfig.LoRa.Dest, (uint8)RadioIf->RadioConfig.LoRa.Node);
+   RX_CORE_ResyncUplink(&RadioIf->Core);
+
+   OS_GetLocalTime(&EndTime);
+   RadioIf->ProfileSwitchUs = (uint32)(OS_TimeGetTotalNanoseconds(OS_TimeSubtract(EndTime, StartTime))/1000);
+
+} /* End ApplyProfile() */
+
+
+/******************************************************************************
+** Function: ConfigToProfile
+**
+** Build a profile definition from the active radio configuration
+**
+** Notes:
+**   1. The frequency is left unchanged, it's set separately by the
+**      frequency command.
+**
+*/
+static void ConfigToProfile(RADIO_RX_ProfileDef_t *Def)
+{
+
+   memset(Def, 0, sizeof(RADIO_RX_ProfileDef_t));
+
+   Def->Mod = RadioIf->RadioConfig.Mod;
+   if (Def->Mod == RADIO_RX_MOD_FLRC)
+   {
+      Def->Bitrate    = RadioIf->RadioConfig.Flrc.Bitrate;
+      Def->CodingRate = RadioIf->RadioConfig.Flrc.CodingRate;
+      Def->Shaping    = RadioIf->RadioConfig.Flrc.Shaping;
+      Def->Crc        = RadioIf->RadioConfig.Flrc.CrcLen;
+      Def->SyncWord   = RadioIf->RadioConfig.Flrc.SyncWord;
+   }
+   else
+   {
+      Def->SpreadingFactor = RadioIf->RadioConfig.LoRa.SpreadingFactor;
+      Def->Bandwidth       = RadioIf->RadioConfig.LoRa.Bandwidth;
+      Def->CodingRate      = RadioIf->RadioConfig.LoRa.CodingRate;
+      Def->Crc             = RadioIf->RadioConfig.LoRa.CRC;
+   }
+
+} /* End ConfigToProfile() */
+
+
+/******************************************************************************
+** Function: LoadSchedule
+**
+** Complete a schedule table plan and queue it for the child task
+**
+** Notes:
+**   1. Called from the main task by the schedule table load. Commands that
+**      change the radio configuration are rejected while a schedule runs
+**      so the base profile, the commanded configuration, stays current.
+**   2. Entries whose profile doesn't define a frequency use the commanded
+**      frequency so every entry leaves the radio at a known frequency.
+**
+*/
+static bool LoadSchedule(RX_SCHED_Plan_t *Plan)
+{
+
+   bool   RetStatus = false;
+   uint16 i;
+
+   ConfigToProfile(&Plan->BaseDef);
+   strncpy(Plan->BaseDef.Name, "commanded", RADIO_RX_PROFILE_NAME_LEN - 1);
+   Plan->BaseDef.Frequency = RadioIf->RadioConfig.Frequency;
+   RetStatus = RADIO_RX_CompileProfile(&Plan->BaseDef, &Plan->BaseImage);
+
+   if (!RetStatus)
+   {
+      CFE_EVS_SendEvent(SCHED_TBL_LOAD_EID, CFE_EVS_EventType_ERROR,
+                        "Schedule table load rejected, the commanded configuration at %d MHz can't be compiled into a profile",
+                        RadioIf->RadioConfig.Frequency);
+      return false;
+   }
+
+   for (i = 0; i < Plan->EntryCnt && RetStatus; i++)
+   {
+      if (Plan->Entry[i].Def.Frequency == 0)
+      {
+         Plan->Entry[i].Def.Frequency = RadioIf->RadioConfig.Frequency;
+         RetStatus = RADIO_RX_CompileProfile(&Plan->Entry[i].Def, &Plan->Entry[i].Image);
+      }
+   }
+
+   if (!RetStatus)
+   {
+      CFE_EVS_SendEvent(SCHED_TBL_LOAD_EID, CFE_EVS_EventType_ERROR,
+                        "Schedule table load rejected, entry[%d] profile '%s' can't be compiled at the commanded %d MHz frequency",
+                        i - 1, Plan->Entry[i-1].Def.Name, RadioIf->RadioConfig.Frequency);
+   }
+   else if (RadioIf->ReplayActive || RX_SWEEP_Busy(&RadioIf->Sweep))
+   {
+      CFE_EVS_SendEvent(SCHED_TBL_LOAD_EID, CFE_EVS_EventType_ERROR,
+                        "Schedule table load rejected, a replay or spectrum sweep is running");
+      RetStatus = false;
+   }
+   else if (RX_SCHED_Load(&RadioIf->Sched, Plan))
+   {
+      /* Wake the child so a sniffing receive loop picks up the new plan */
+      RADIO_RX_AbortWait();
+   }
+   else
+   {
+      CFE_EVS_SendEvent(SCHED_TBL_LOAD_EID, CFE_EVS_EventType_ERROR,
+                        "Schedule table load rejected, the previous load hasn't been started by the receive task");
+      RetStatus = false;
+   }
+
+   return RetStatus;
+
+} /* End LoadSchedule() */
+
+
+/******************************************************************************
+** Function: RunSchedule
+**
+** Apply the schedule actions that are due and return the receive wait
+** bounded by the next one
+**
+** Notes:
+**   1. Called from the child task. Action times are converted to the raw
+**      clock through the receive time fit on every pass so fit updates
+**      are followed. Until there's a fit the wait is bounded so the
+**      schedule is checked again after the next time sample.
+**   2. The child waits for frames until SCHED_LEAD_US before an action is
+**      due and then spins on the raw clock, the wait timeout only has
+**      millisecond resolution and a wakeup may be late by a scheduler
+**      tick.
+**   3. An action whose window ended while the radio was busy or the time
+**      was unknown is skipped, the schedule continues with the next one.
+**   4. Each action is applied under the radio lock, see radio_if.h note 5.
+**      If InitRadio() took the radio in the meantime the action is left
+**      for the next pass.
+**
+*/
+static uint32 RunSchedule(uint32 WaitMs)
+{
+
+   RX_SCHED_Action_t Action;
+   int64  LeadNs = (int64)RadioIf->SchedLeadUs*1000;
+   int64  NowRaw;
+   int64  DueRaw;
+   int64  EndRaw;
+   int64  LateNs;
+   uint32 DueWaitMs;
+   bool   TimeKnown;
+
+   RX_SCHED_Sync(&RadioIf->Sched);
+
+   while (RX_SCHED_NextAction(&RadioIf->Sched, &Action))
+   {
+      NowRaw = RADIO_RX_RawTimeNs();
+
+      TimeKnown = (Action.DueNs == RX_SCHED_NOW   || RX_TIME_ToRaw(&RadioIf->RxTime, Action.DueNs, &DueRaw)) &&
+                  (Action.EndNs == RX_SCHED_NEVER || RX_TIME_ToRaw(&RadioIf->RxTime, Action.EndNs, &EndRaw));
+      if (!TimeKnown)
+      {
+         if (WaitMs > RADIO_IF_RX_WAIT_MAX_MS)
+         {
+            WaitMs = RADIO_IF_RX_WAIT_MAX_MS;
+         }
+         break;
+      }
+
+      if (Action.EndNs != RX_SCHED_NEVER && EndRaw <= NowRaw)
+      {
+         RX_SCHED_Skip(&RadioIf->Sched);
+         continue;
+      }
+
+      if (Action.DueNs == RX_SCHED_NOW)
+      {
+         LateNs = 0;
+      }
+      else if (DueRaw - NowRaw > LeadNs + 1000000)
+      {
+         DueWaitMs = (uint32)((DueRaw - NowRaw - LeadNs)/1000000);
+         if (DueWaitMs < WaitMs)
+         {
+            WaitMs = DueWaitMs;
+         }
+         break;
+      }
+      else
+      {
+         while ((NowRaw = RADIO_RX_RawTimeNs()) < DueRaw)
+         {
+            /* Spin the lead time */
+         }
+         LateNs = NowRaw - DueRaw;
+      }
+
+      RADIO_RX_Lock();
+      if (!RadioIf->Initialized)
+      {
+         RADIO_RX_Unlock();
+         break;
+      }
+      ApplyProfile(Action.Def, Action.Image);
+      RX_SCHED_Done(&RadioIf->Sched, LateNs, RadioIf->ProfileSwitchUs);
+      RADIO_RX_Unlock();
+
+   } /* End while actions */
+
+   return WaitMs;
+
+} /* End RunSchedule() */
+
+
+/******************************************************************************
+** Function: UpdateLinkModel
+**
+** Derive the receive timeouts, link goodput and frame timestamp
+** correction from a profile definition
+**
+** Notes:
+**   1. The link goodput counts the frame data field of back-to-back
+**      maximum length frames.
+**
+*/
+static void UpdateLinkModel(const RADIO_RX_ProfileDef_t *Def)
+{
+
+   uint32 WaitMs;
+
+   RadioIf->AirtimeDef = *Def;
+   RADIO_RX_GetAirtime(Def, &RadioIf->Airtime);
+   RADIO_RX_SetRxTimeOffset((int32)(RadioIf->Airtime.RxDoneNs + RadioIf->RxTimeCalNs));
+
+   WaitMs = (RADIO_IF_RX_WAIT_FRAMES*RadioIf->Airtime.MaxFrameUs)/1000;
+   if (WaitMs < RADIO_IF_RX_WAIT_MS)
+   {
+      WaitMs = RADIO_IF_RX_WAIT_MS;
+   }
+   else if (WaitMs > RADIO_IF_RX_WAIT_MAX_MS)
+   {
+      WaitMs = RADIO_IF_RX_WAIT_MAX_MS;
+   }
+   RadioIf->RxWaitMs = WaitMs;
+
+   RadioIf->LinkGoodputBps = 0;
+   if (RadioIf->Airtime.MaxFrameUs > 0)
+   {
+      RadioIf->LinkGoodputBps = (uint32)(((uint64)(RadioIf->Airtime.MaxFrameLen - RX_FRAME_HDR_LEN)*8*1000000)/
+                                         RadioIf->Airtime.MaxFrameUs);
+   }
+
+} /* End UpdateLinkModel() */
+
+
+/******************************************************************************
+** Function: StartReceive
+**
+** Start continuous or sniff receive using the current configuration
+**
+** Notes:
+**   1. Invalid sniff periods from the ini file fall back to continuous
+**      receive.
+**   2. The child task is woken so it picks the wait that matches the mode.
+**
+*/
+static void StartReceive(void)
+{
+
+   if (RadioIf->RadioConfig.SniffSleepUs > 0)
+   {
+      if (!RADIO_RX_StartSniff(RadioIf->RadioConfig.SniffRxUs, RadioIf->RadioConfig.SniffSleepUs))
+      {
+         CFE_EVS_SendEvent(RADIO_IF_SET_SNIFF_MODE_CMD_EID, CFE_EVS_EventType_ERROR,
+                           "Invalid sniff periods RX %u us, sleep %u us, using continuous receive",
+                           (unsigned int)RadioIf->RadioConfig.SniffRxUs,
+                           (unsigned int)RadioIf->RadioConfig.SniffSleepUs);
+         RadioIf->RadioConfig.SniffSleepUs = 0;
+         RADIO_RX_StartRx();
+      }
+   }
+   else
+   {
+      RADIO_RX_StartRx();
+   }
+   
+   RADIO_RX_AbortWait();
+
+} /* End StartReceive() */
+
+
+/******************************************************************************
+** Function: CheckScanRelock
+**
+** Restart the scan if the locked channel has gone quiet
+**
+** Notes:
+**   1. Called each time the frame wait times out so the idle time is
+**      measured in receive wait steps.
+**   2. The relock time is at least RADIO_IF_RELOCK_FRAMES maximum length
+**      frames at the locked channel's spreading factor so a slow channel
+**      isn't abandoned in the middle of a frame.
+**   3. The scan is checked again under the radio lock, a command may have
+**      stopped it during the wait.
+**
+*/
+static void CheckScanRelock(void)
+{
+
+   RADIO_RX_ScanStatus_t ScanStatus;
+   RADIO_RX_ProfileDef_t ChannelDef;
+   RADIO_RX_Airtime_t    ChannelAirtime;
+   uint32 RelockMs;
+   
+   if (RadioIf->ScanRelockMs == 0)
+   {
+      return;
+   }
+   
+   RADIO_RX_GetScanStatus(&ScanStatus);
+   
+   if (ScanStatus.State == RADIO_RX_SCAN_LOCKED)
+   {
+      ChannelDef = RadioIf->AirtimeDef;
+      ChannelDef.SpreadingFactor = (uint8)RadioIf->ScanTbl.Data.Channel[ScanStatus.Channel].SpreadingFactor;
+      RADIO_RX_GetAirtime(&ChannelDef, &ChannelAirtime);
+      RelockMs = (RADIO_IF_RELOCK_FRAMES*ChannelAirtime.MaxFrameUs)/1000;
+      if (RelockMs < RadioIf->ScanRelockMs)
+      {
+         RelockMs = RadioIf->ScanRelockMs;
+      }
+      
+      RadioIf->ScanIdleMs += RadioIf->RxWaitMs;
+      if (RadioIf->ScanIdleMs >= RelockMs)
+      {
+         RADIO_RX_Lock();
+         if (RadioIf->ScanActive)
+         {
+            RADIO_RX_RestartScan();
+         }
+         RADIO_RX_Unlock();
+         RadioIf->ScanIdleMs     = 0;
+         RX_CORE_ResyncUplink(&RadioIf->Core);
+         RadioIf->ScanRelockCnt++;
+      }
+   }
+   else
+   {
+      RadioIf->ScanIdleMs = 0;
+   }
+
+} /* End CheckScanRelock() */
+
+
+/******************************************************************************
+** Function: RecoverRadio
+**
+** Restore the radio configuration after a radio watchdog reset
+**
+** Notes:
+**   1. Called from the child task. The reset leaves the radio in standby
+**      with its power-on configuration so everything InitRadio() sets in
+**      the radio is restored, the modulation as one profile burst. The
+**      SPI speed is a host setting that survives the reset.
+**   2. A scan is restarted with its channels. A running schedule resumes
+**      at its next entry, until then the commanded configuration is used.
+**   3. An active sweep continues with its plan, the modulation is restored
+**      for when it's stopped.
+**   4. Runs under the radio lock so a command can't change the
+**      configuration while it's restored.
+**
+*/
+static void RecoverRadio(void)
+{
+
+   bool ScanActive;
+
+   RADIO_RX_Lock();
+   
+   ScanActive = RadioIf->ScanActive;
+   RadioIf->ScanActive = false;
+   RADIO_RX_SetRadioFrequency(RadioIf->RadioConfig.Frequency*1000000UL);
+   ApplyModulation();
+   if (__atomic_load_n(&RadioIf->Sweep.Active, __ATOMIC_ACQUIRE))
+   {
+      RADIO_RX_StartSweep();
+   }
+   else if (ScanActive)
+   {
+      RadioIf->ScanActive = RADIO_RX_RestartScan();
+      RadioIf->ScanIdleMs = 0;
+   }
+
+   RADIO_RX_EndRecovery();
+   
+   RADIO_RX_Unlock();
+
+} /* End RecoverRadio() */
+
+
+/******************************************************************************
+** Function: SyncSweep
+**
+** Apply a queued sweep start or stop and return whether a sweep is active
+**
+** Notes:
+**   1. Called from the child task, the sweep executor. A start takes the
+**      radio out of receive, which stops a CAD scan. A stop returns to
+**      receiving with the commanded configuration.
+**
+*/
+static bool SyncSweep(void)
+{
+
+   switch (RX_SWEEP_Sync(&RadioIf->Sweep))
+   {
+      case RX_SWEEP_STARTED:
+         RadioIf->ScanActive = false;
+         RADIO_RX_StartSweep();
+         RX_CORE_ResyncUplink(&RadioIf->Core);
+         break;
+      case RX_SWEEP_STOPPED:
+         RADIO_RX_SetRadioFrequency(RadioIf->RadioConfig.Frequency*1000000UL);
+         ApplyModulation();
+         RX_CORE_ResyncUplink(&RadioIf->Core);
+         break;
+      default:
+         break;
+   }
+
+   return RadioIf->Sweep.Active;
+
+} /* End SyncSweep() */
+
+
+/******************************************************************************
+** Function: EmitPkt
+**
+** Send a packet extracted by the deframer on the software bus
+**
+** Notes:
+**   1. The packet is copied once from the deframer's ring into a zero copy
+**      SB buffer.
+**   2. Packets keep the sequence count assigned by the sender.
+**
+*/
+static bool EmitPkt(void *EmitCtx, const uint8_t *Seg1, uint16_t Seg1Len,
+                    const uint8_t *Seg2, uint16_t Seg2Len)
+{
+   
+   CFE_SB_Buffer_t *SbBufPtr;
+   bool RetStatus = false;
+   
+   RX_TRACE_Begin(RX_TRACE_TASK_CHILD, RX_TRACE_PUBLISH, Seg1Len + Seg2Len);
+   SbBufPtr = CFE_SB_AllocateMessageBuffer(Seg1Len + Seg2Len);
+   
+   if (SbBufPtr != NULL)
+   {
+      memcpy(SbBufPtr, Seg1, Seg1Len);
+      if (Seg2Len > 0)
+      {
+         memcpy((uint8 *)SbBufPtr + Seg1Len, Seg2, Seg2Len);
+      }
+      if (CFE_SB_TransmitBuffer(SbBufPtr, false) == CFE_SUCCESS)
+      {
+         RetStatus = true;
+      }
+      else
+      {
+         CFE_SB_ReleaseMessageBuffer(SbBufPtr);
+      }
+   }
+   RX_TRACE_End(RX_TRACE_TASK_CHILD, RX_TRACE_PUBLISH, Seg1Len + Seg2Len);
+   
    return RetStatus;
    
-} /* RADIO_IF_SetSpiSpeedCmd() */
+} /* End EmitPkt() */
+
+
+/******************************************************************************
+** Function: FrameReceived
+**
+** Receive core hook for frames addressed to this receiver
+**
+** Notes:
+**   1. Adds the frame's time on air to the goodput airtime and converts its
+**      receive time to mission time. See rx_core.h.
+**
+*/
+static void FrameReceived(void *FrameCtx, const RADIO_RX_Frame_t *Frame)
+{
+   
+   RadioIf->RxAirtimeUs += RADIO_RX_FrameAirtimeUs(&RadioIf->AirtimeDef, Frame->Len);
+   RadioIf->FrameTimeValid = RX_TIME_ToMission(&RadioIf->RxTime, Frame->RxTimeNs, &RadioIf->FrameTime.Seconds,
+                                               &RadioIf->FrameTime.Subseconds);
+   
+} /* End FrameReceived() */
+
+
+/******************************************************************************
+** Function: WaitRadioFrame
+**
+** Receive core frame backend, the radio bridge's frame ring
+**
+** Notes:
+**   1. Function signature must match RX_CORE_WaitFunc_t.
+**
+*/
+static RADIO_RX_Frame_t *WaitRadioFrame(void *BackendCtx, uint32_t TimeoutMs)
+{
+   
+   return RADIO_RX_WaitFrame(TimeoutMs);
+   
+} /* End WaitRadioFrame() */
+
+
+/******************************************************************************
+** Function: ReleaseRadioFrame
+**
+** Notes:
+**   1. Function signature must match RX_CORE_ReleaseFunc_t.
+**
+*/
+static void ReleaseRadioFrame(void *BackendCtx)
+{
+   
+   RADIO_RX_ReleaseFrame();
+   
+} /* End ReleaseRadioFrame() */
+
+
+/******************************************************************************
+** Function: AbortRadioWait
+**
+** Notes:
+**   1. Function signature must match RX_CORE_AbortFunc_t.
+**
+*/
+static void AbortRadioWait(void *BackendCtx)
+{
+   
+   RADIO_RX_AbortWait();
+   
+} /* End AbortRadioWait() */
+
+
+/******************************************************************************
+** Function: PublishPayloadPkt
+**
+** Payload sink for relayed telemetry and command frames
+**
+** Notes:
+**   1. The payload handler has checked that the frame holds exactly one
+**      packet so it's published like a deframed packet.
+**
+*/
+static bool PublishPayloadPkt(void *SinkCtx, uint8_t Node, const uint8_t *Pkt, uint16_t Len)
+{
+
+   return EmitPkt(NULL, Pkt, Len, NULL, 0);
+
+} /* End PublishPayloadPkt() */
+
+
+/******************************************************************************
+** Function: TimeSyncReceived
+**
+** Payload sink for time sync frames
+**
+** Notes:
+**   1. The offset is the sender's mission time minus this receiver's
+**      mission time for the end of the same frame, it includes the
+**      propagation delay. It's only valid when there's a time fit.
+**
+*/
+static void TimeSyncReceived(void *SinkCtx, uint8_t Node, uint32_t Seconds, uint32_t Subseconds,
+                             int64_t RxTimeNs)
+{
+
+   uint32 RxSeconds;
+   uint32 RxSubseconds;
+   int64  OffsetUs;
+
+   RadioIf->TimeSyncNode  = Node;
+   RadioIf->TimeSyncValid = RX_TIME_ToMission(&RadioIf->RxTime, RxTimeNs, &RxSeconds, &RxSubseconds);
+   if (RadioIf->TimeSyncValid)
+   {
+      OffsetUs = (RX_TIME_MissionNs(Seconds, Subseconds) - RX_TIME_MissionNs(RxSeconds, RxSubseconds))/1000;
+      if (OffsetUs > INT32_MAX)
+      {
+         OffsetUs = INT32_MAX;
+      }
+      else if (OffsetUs < INT32_MIN)
+      {
+         OffsetUs = INT32_MIN;
+      }
+      RadioIf->TimeSyncOffsetUs = (int32)OffsetUs;
+   }
+
+} /* End TimeSyncReceived() */
+
+
+/******************************************************************************
+** Function: PerfLog
+**
+** Receive trace performance log hook, see rx_trace.h
+**
+*/
+static void PerfLog(uint32_t PerfId, bool Exit)
+{
+
+   if (Exit)
+   {
+      CFE_ES_PerfLogExit(PerfId);
+   }
+   else
+   {
+      CFE_ES_PerfLogEntry(PerfId);
+   }
+
+} /* End PerfLog() */
+
+
+/******************************************************************************
+** Function: WriteTraceTask
+**
+** Write a task's trace events as Chrome trace event records
+**
+** Notes:
+**   1. Times are microseconds with nanosecond decimals, relative to BaseNs.
+**
+*/
+static void WriteTraceTask(osal_id_t FileHandle, RX_TRACE_Task_Enum_t Task, uint32 EventCnt, int64 BaseNs)
+{
+
+   const RX_TRACE_Event_t *Event;
+   char   Record[160];
+   int64  RelNs;
+   uint32 i;
+
+   for (i = 0; i < EventCnt; i++)
+   {
+      Event = &TraceEvent[Task*RX_TRACE_TaskEvents() + i];
+      RelNs = Event->TimeNs - BaseNs;
+      snprintf(Record, sizeof(Record),
+               ",\n{\"name\": \"%s\", \"cat\": \"rx\", \"ph\": \"%c\", \"ts\": %lld.%03d, \"pid\": 1, \"tid\": %d, \"args\": {\"len\": %u}}",
+               RX_TRACE_StageName(Event->Stage), (Event->Phase == RX_TRACE_PHASE_BEGIN) ? 'B' : 'E',
+               (long long)(RelNs/1000), (int)(RelNs%1000), (int)Task, (unsigned int)Event->Arg);
+      WriteTraceRecord(FileHandle, Record, false);
+   }
+
+} /* End WriteTraceTask() */
+
+
+/******************************************************************************
+** Function: WriteTraceRecord
+**
+** Buffer trace dump output so the file is written in large pieces
+**
+*/
+static void WriteTraceRecord(osal_id_t FileHandle, const char *Record, bool Flush)
+{
+
+   size_t RecordLen = strlen(Record);
+
+   if (TraceFileLen + RecordLen > sizeof(TraceFileBuf))
+   {
+      OS_write(FileHandle, TraceFileBuf, TraceFileLen);
+      TraceFileLen = 0;
+   }
+   memcpy(&TraceFileBuf[TraceFileLen], Record, RecordLen);
+   TraceFileLen += RecordLen;
+
+   if (Flush)
+   {
+      OS_write(FileHandle, TraceFileBuf, TraceFileLen);
+      TraceFileLen = 0;
+   }
+
+} /* End WriteTraceRecord() */
+
+
+/******************************************************************************
+** Function: BenchCrypto
+**
+** Return the average time in nanoseconds to decrypt a maximum length
+** secured frame with Impl
+**
+** Notes:
+**   1. Each iteration encrypts and then decrypts the frame in place so the
+**      tag is always valid. Both operations have the same cost so the time
+**      is halved.
+**
+*/
+static uint32 BenchCrypto(AES_GCM_Impl_Enum_t Impl)
+{
+   
+   static AES_GCM_Ctx_t BenchCtx;
+   static uint8 BenchFrame[RX_FRAME_MAX_LEN];
+   
+   uint8  Key[16];
+   uint8  Iv[AES_GCM_IV_LEN];
+   uint8  Tag[RX_SEC_TAG_LEN];
+   uint16 AadLen  = RX_FRAME_HDR_LEN + RX_SEC_HDR_LEN;
+   uint16 DataLen = RX_FRAME_MAX_LEN - RX_FRAME_HDR_LEN - RX_SEC_OVERHEAD;
+   uint16 i;
+   OS_time_t StartTime;
+   OS_time_t StopTime;
+   
+   memset(Key, 0xA5, sizeof(Key));
+   memset(Iv, 0, sizeof(Iv));
+   memset(BenchFrame, 0x5A, sizeof(BenchFrame));
+   
+   AES_GCM_Init(&BenchCtx, Key, sizeof(Key), Impl);
+   
+   OS_GetLocalTime(&StartTime);
+   for (i = 0; i < RADIO_IF_CRYPTO_BENCH_CNT; i++)
+   {
+      AES_GCM_Encrypt(&BenchCtx, Iv, BenchFrame, AadLen, &BenchFrame[AadLen], DataLen, Tag, sizeof(Tag));
+      AES_GCM_Decrypt(&BenchCtx, Iv, BenchFrame, AadLen, &BenchFrame[AadLen], DataLen, Tag, sizeof(Tag));
+   }
+   OS_GetLocalTime(&StopTime);
+   
+   AES_GCM_Wipe(&BenchCtx);
+   
+   return (uint32)(OS_TimeGetTotalNanoseconds(OS_TimeSubtract(StopTime, StartTime)) / (2*RADIO_IF_CRYPTO_BENCH_CNT));
+   
+} /* End BenchCrypto() */
@@ -27,6 +27,20 @@
 **       settings. Ideally the telemetry message should be populated using the
 **       Radio object's configuration data because it is the 'truth'. However,
 **       this impacts legacy code more than desired for the initial demo.   
+**    3. The frame pipeline is the cFS independent receive core, see
+**       rx_core.h. This object adapts it to the app: configuration from
+**       the JSON init file, packets routed to the software bus and
+**       statistics in telemetry.
+**    4. The commanded configuration, receive counters and uplink sequence
+**       state are kept in the cFE Critical Data Store. After a processor
+**       reset or app restart they replace the JSON init file values and a
+**       radio that was receiving is reattached without a chip reset.
+**    5. The main task's commands and the child task both reconfigure the
+**       radio. Each holds the radio lock, see RADIO_RX_Lock(), while it
+**       changes the radio configuration and the state derived from it, so
+**       commands, schedule entries, sweeps and watchdog recoveries are
+**       applied one at a time. The child doesn't hold it while it waits
+**       for a frame.
 **
 */
 
@@ -38,6 +52,17 @@
 */
 
 #include "app_cfg.h"
+#include "rx_core.h"
+#include "rx_evt.h"
+#include "rx_time.h"
+#include "rx_trace.h"
+#include "rx_mem.h"
+#include "rx_tap.h"
+#include "rx_sweep.h"
+#include "spi_rec.h"
+#include "scan_tbl.h"
+#include "profile_tbl.h"
+#include "sched_tbl.h"
 
 
 /***********************/
@@ -56,21 +81,120 @@
 #define RADIO_RX_SET_SPI_SPEED_CMD_EID       (RADIO_IF_BASE_EID + 4)
 #define RADIO_RX_SET_RADIO_FREQUENCY_CMD_EID (RADIO_IF_BASE_EID + 5)
 #define RADIO_RX_SET_LORA_PARAMS_CMD_EID     (RADIO_IF_BASE_EID + 6)
+#define RADIO_IF_CRYPTO_BENCH_CMD_EID        (RADIO_IF_BASE_EID + 7)
+#define RADIO_RX_SET_FLRC_PARAMS_CMD_EID     (RADIO_IF_BASE_EID + 8)
+#define RADIO_IF_START_SCAN_CMD_EID          (RADIO_IF_BASE_EID + 9)
+#define RADIO_IF_STOP_SCAN_CMD_EID           (RADIO_IF_BASE_EID + 10)
+#define RADIO_IF_SET_SNIFF_MODE_CMD_EID      (RADIO_IF_BASE_EID + 11)
+#define RADIO_IF_CDS_EID                     (RADIO_IF_BASE_EID + 12)
+#define RADIO_IF_SELECT_PROFILE_CMD_EID      (RADIO_IF_BASE_EID + 13)
+#define RADIO_IF_RX_EVENT_EID                (RADIO_IF_BASE_EID + 14)
+#define RADIO_IF_DUMP_TRACE_CMD_EID          (RADIO_IF_BASE_EID + 15)
+#define RADIO_IF_DUMP_SPI_REC_CMD_EID        (RADIO_IF_BASE_EID + 16)
+#define RADIO_IF_REPLAY_SPI_REC_CMD_EID      (RADIO_IF_BASE_EID + 17)
+#define RADIO_IF_CALIBRATE_SPI_CMD_EID       (RADIO_IF_BASE_EID + 18)
+#define RADIO_IF_TAP_CLIENT_EID              (RADIO_IF_BASE_EID + 19)
+#define RADIO_IF_START_SWEEP_CMD_EID         (SWEEP_BASE_EID + 0)
+#define RADIO_IF_STOP_SWEEP_CMD_EID          (SWEEP_BASE_EID + 1)
+#define RADIO_IF_WATCHDOG_EID                (WATCHDOG_BASE_EID + 0)
+
+/*
+** Child task receive loop timing. The wait timeout bounds how long the
+** child takes to notice a radio (re)initialization. It's derived from the
+** time on air of a maximum length frame for the active modulation, a
+** frame can't complete sooner so waking more often is wasted. The child
+** waits without a timeout while sniffing and is woken explicitly when the
+** mode changes. A pending schedule entry shortens the wait so the child
+** wakes SCHED_LEAD_US before the entry is due.
+*/
+
+#define RADIO_IF_RX_WAIT_MS      100   /* Minimum wait */
+#define RADIO_IF_RX_WAIT_MAX_MS  1000
+#define RADIO_IF_RX_WAIT_FRAMES  2     /* Wait in maximum length frame times */
+#define RADIO_IF_RELOCK_FRAMES   4     /* Minimum scan relock idle time in maximum length frame times */
+#define RADIO_IF_IDLE_DELAY_MS 500
+#define RADIO_IF_SWEEP_YIELD_MS  1     /* Delay between sweeps so lower priority tasks run */
+
+#define RADIO_IF_CRYPTO_BENCH_CNT  1000   /* Frames per implementation */
+
+#define RADIO_IF_NO_PROFILE  0xFF   /* Radio parameters were set directly */
+
+#define RADIO_IF_LINK_PAGE_LEN  8   /* Nodes per link telemetry packet, matches the EDS LinkNodeList */
+
+/*
+** SPI clock calibration. Speeds are tested in ascending order until one
+** fails. The selected speed is one step below the fastest clean speed so
+** a marginal clock isn't used.
+*/
+
+#define RADIO_IF_SPI_CAL_STEPS  10
+
+#define RADIO_IF_SPI_CAL_NONE       0   /* Not run since startup */
+#define RADIO_IF_SPI_CAL_OK         1
+#define RADIO_IF_SPI_CAL_NO_MARGIN  2   /* Only the slowest speed was clean */
+#define RADIO_IF_SPI_CAL_FAILED     3   /* No clean speed, SPI speed unchanged */
+#define RADIO_IF_SPI_CAL_OVERRIDDEN 4   /* Speed set by command after the calibration */
+
+#define RADIO_IF_CDS_NAME       "RadioState"
+#define RADIO_IF_CDS_SIGNATURE  0x4C524333    /* Change when RADIO_IF_CdsData_t changes */
 
 /**********************/
 /** Type Definitions **/
 /**********************/
 
-// Command and Telemetry packets are defined in lora_tx.xml
+// Command and Telemetry packets are defined in lora_rx.xml
 
 typedef struct
 {
    uint32  Frequency;
+   uint16  Mod;      /* Active modulation, RADIO_RX_MOD_LORA or RADIO_RX_MOD_FLRC */
    LORA_RX_SetLoRaParams_CmdPayload_t LoRa;
+   LORA_RX_SetFlrcParams_CmdPayload_t Flrc;
+   uint32  SniffRxUs;
+   uint32  SniffSleepUs;   /* 0 selects continuous receive */
    
 } RADIO_IF_Config;
 
 
+/*
+** State preserved across restarts in the Critical Data Store
+*/
+typedef struct
+{
+   uint32  Signature;
+   uint32  SpiSpeed;
+   bool    RadioUp;          /* Radio was initialized and receiving */
+   bool    UplinkSeqValid;
+   uint8   UplinkSeq;
+   uint8   ActiveProfile;
+   
+   RADIO_IF_Config     RadioConfig;
+   RX_CORE_Stats_t     RxStats;
+   RADIO_RX_Status_t   RadioStatus;
+   RX_SEC_Window_t     SecWindow[RX_SEC_NODE_CNT];   /* Anti-replay windows, see rx_sec.h note 3 */
+   
+} RADIO_IF_CdsData_t;
+
+
+/*
+** Last SPI clock calibration
+*/
+typedef struct
+{
+   uint8   Status;           /* RADIO_IF_SPI_CAL_* */
+   uint8   StepCnt;          /* Speeds tested */
+   uint8   MarginSteps;      /* Steps from the selected to the first failing speed, 0 if none failed */
+   uint32  Speed;            /* Selected speed */
+   uint32  MaxCleanSpeed;
+   uint32  FailSpeed;        /* First failing speed, 0 if none failed */
+   uint32  FailErrByteCnt;   /* Readback errors at the failing speed */
+   uint32  ReadNs;           /* Data buffer read time at the selected speed */
+   uint32  WriteNs;
+   uint32  CalUs;            /* Calibration duration */
+   
+} RADIO_IF_SpiCal_t;
+
+
 /******************************************************************************
 ** RX_DEMO_Class
 */
@@ -87,17 +211,143 @@ typedef struct
    ** Telemetry Packets
    */
    
-   LORA_RX_RadioTlm_t  RadioTlm;
+   LORA_RX_RadioTlm_t    RadioTlm;
+   LORA_RX_RxEventTlm_t  RxEventTlm;
+   LORA_RX_NackTlm_t     NackTlm;
+   LORA_RX_LinkTlm_t     LinkTlm;
+   LORA_RX_SweepTlm_t    SweepTlm;
 
    /*
    ** Class State Data
    */
    
    bool   Initialized;
+   bool   MemReady;         /* Receive path buffers allocated from the arena */
    uint32 SpiSpeed;
+   RADIO_IF_SpiCal_t SpiCal;
+   
+   bool   CdsRegistered;
+   bool   CdsRestored;      /* Configuration came from the CDS at startup */
+   bool   RadioWarmStart;   /* Last initialization skipped the chip reset */
+   uint32 RadioInitUs;      /* Last initialization time until receiving */
+   uint32 WatchdogResetCnt; /* Radio watchdog resets at the last report */
+   CFE_ES_CDSHandle_t CdsHandle;
+   RADIO_IF_CdsData_t CdsData;
    
    RADIO_IF_Config RadioConfig;
    
+   /*
+   ** Radio Profiles
+   */
+   
+   uint8  ActiveProfile;     /* Last selected profile id, RADIO_IF_NO_PROFILE if none */
+   uint32 ProfileSwitchUs;   /* Last modulation change time until receiving */
+   
+   PROFILE_TBL_Class_t ProfileTbl;
+   
+   /*
+   ** Receive Schedule, executed by the child task. RadioConfig remains
+   ** the commanded configuration that the schedule returns to.
+   */
+   
+   uint32 SchedLeadUs;
+   uint32 SchedExecCnt;            /* Counts at the last execution report */
+   uint32 SchedSkipCnt;
+   uint32 SchedLateCnt;
+   
+   RX_SCHED_Class_t  Sched;
+   SCHED_TBL_Class_t SchedTbl;
+   
+   /*
+   ** Channel Activity Detection Scan
+   */
+   
+   bool   ScanActive;
+   uint32 ScanRelockMs;      /* Rescan after no frames for this long, 0 disables */
+   uint32 ScanIdleMs;
+   uint32 ScanRelockCnt;
+   
+   SCAN_TBL_Class_t ScanTbl;
+   
+   /*
+   ** RSSI Spectrum Sweep, run by the child task instead of receiving
+   */
+   
+   RX_SWEEP_Class_t Sweep;
+   RX_SWEEP_Row_t   SweepRow;       /* Working buffer for the telemetry row */
+   
+   /*
+   ** Link model, derived from the active modulation
+   */
+   
+   RADIO_RX_ProfileDef_t AirtimeDef;
+   RADIO_RX_Airtime_t    Airtime;
+   uint32 RxWaitMs;
+   uint32 LinkGoodputBps;          /* Back-to-back maximum length frames */
+   
+   uint32    RxGoodputBps;         /* Achieved over the last status period */
+   uint16    AirtimeRatio;         /* Last status period spent receiving frames x10000 */
+   uint64    RxAirtimeUs;          /* Time on air of received frames */
+   uint32    GoodputLastByteCnt;
+   uint64    GoodputLastAirtimeUs;
+   OS_time_t GoodputLastTime;
+   
+   /*
+   ** SPI cost of reading a received frame, averaged over the last status
+   ** period
+   */
+   
+   uint16 SpiFrameTransfers;
+   uint16 SpiFrameBytes;
+   uint32 SpiFrameUs;
+   uint32 SpiFrameBusyUs;
+   RADIO_RX_SpiStatus_t SpiLast;
+   
+   bool   ReplayActive;
+   
+   /*
+   ** Virtual RF channel goodput and mean latency over the last status
+   ** period, see RADIO_IF_UpdateChannel()
+   */
+   
+   bool   VchanActive;
+   uint32 VchanGoodputBps;
+   uint32 VchanLatencyUs;
+   RX_VCHAN_Stats_t Vchan;
+   int64  VchanLastNs;
+   
+   RX_MEM_Stack_t ChildStack;
+   
+   /*
+   ** Host wakeup rate
+   */
+   
+   uint32    WakeRateLastCnt;
+   OS_time_t WakeRateLastTime;
+   
+   /*
+   ** Receive Pipeline
+   */
+   
+   uint32 NackPeriod;              /* Seconds between NACK telemetry packets, 0 disables */
+   uint32 NackSecs;
+   uint16 LinkPageStart;           /* Active node index of the next link telemetry page */
+   
+   uint32 CryptoBenchPortableNs;   /* Per-frame decrypt cost from the last benchmark */
+   uint32 CryptoBenchAccelNs;
+   
+   uint32 RxTimeCalNs;             /* DIO1 edge to IRQ status read, added to the RxDone latency */
+   bool   FrameTimeValid;
+   CFE_TIME_SysTime_t FrameTime;   /* End of the frame being processed in mission time */
+   
+   bool   TimeSyncValid;           /* Last time sync frame, see rx_payload.h */
+   uint8  TimeSyncNode;
+   int32  TimeSyncOffsetUs;
+   
+   RX_CORE_Class_t  Core;
+   RX_TIME_Class_t  RxTime;
+   RX_EVT_Class_t   RxEvt;
+   
 } RADIO_IF_Class_t;
 
 
@@ -119,9 +369,40 @@ typedef struct
 void RADIO_IF_Constructor(RADIO_IF_Class_t *RadioIfPtr, INITBL_Class_t *IniTbl);
 
 
+/******************************************************************************
+** Function: RADIO_IF_AutoInit
+**
+** Bring up the radio at startup
+**
+** Notes:
+**   1. A radio that was receiving before a restart is reattached using the
+**      configuration restored from the CDS. It's fully initialized if it
+**      doesn't respond. Otherwise the radio is initialized if
+**      RADIO_AUTO_INIT is set.
+**   2. Call after the tables are registered so receiving starts with the
+**      keys loaded.
+**
+*/
+void RADIO_IF_AutoInit(void);
+
+
+/******************************************************************************
+** Function: RADIO_IF_SaveState
+**
+** Copy the current configuration, counters and link state to the CDS
+**
+*/
+void RADIO_IF_SaveState(void);
+
+
 /******************************************************************************
 ** Function: RADIO_IF_ChildTask
 **
+** Receive frames from the radio and feed them through the receive pipeline
+**
+** Notes:
+**   1. Returning false causes the child task to terminate.
+**
 */
 bool RADIO_IF_ChildTask(CHILDMGR_Class_t *ChildMgr);
 
@@ -139,6 +420,202 @@ bool RADIO_IF_ChildTask(CHILDMGR_Class_t *ChildMgr);
 void RADIO_IF_ResetStatus(void);
 
 
+/******************************************************************************
+** Function: RADIO_IF_HostWakeRate
+**
+** Return the host wakeups per second (x100) since the previous call
+**
+** Notes:
+**   1. Counts radio IRQ and receive task wakeups. Intended to be called
+**      once per status telemetry message.
+**
+*/
+uint32 RADIO_IF_HostWakeRate(void);
+
+
+/******************************************************************************
+** Function: RADIO_IF_UpdateGoodput
+**
+** Update the achieved goodput and airtime ratio since the previous call
+**
+** Notes:
+**   1. Intended to be called once per status telemetry message.
+**   2. Goodput counts frame data bytes passed to the deframer. Comparing it
+**      with the link goodput shows whether throughput is limited by the
+**      link or by the receive path. The airtime ratio shows how much of
+**      the period the transmitter actually used.
+**
+*/
+void RADIO_IF_UpdateGoodput(void);
+
+
+/******************************************************************************
+** Function: RADIO_IF_UpdateSpiCost
+**
+** Update the per-frame SPI cost since the previous call
+**
+** Notes:
+**   1. Intended to be called once per status telemetry message. Also
+**      reports the end of an SPI recording replay and restarts receiving
+**      with the commanded frequency, modulation and receive mode.
+**
+*/
+void RADIO_IF_UpdateSpiCost(void);
+
+
+/******************************************************************************
+** Function: RADIO_IF_UpdateChannel
+**
+** Update the virtual RF channel counters, goodput and latency since the
+** previous call
+**
+** Notes:
+**   1. Intended to be called once per status telemetry message.
+**   2. Goodput counts the payload bytes of good frames read from the
+**      radio. Latency runs from the start of transmission to the read.
+**
+*/
+void RADIO_IF_UpdateChannel(void);
+
+
+/******************************************************************************
+** Function: RADIO_IF_UpdateDecodeUtil
+**
+** Update each decode worker's utilization since the previous call
+**
+** Notes:
+**   1. Intended to be called once per status telemetry message.
+**
+*/
+void RADIO_IF_UpdateDecodeUtil(void);
+
+
+/******************************************************************************
+** Function: RADIO_IF_SendNackTlm
+**
+** Send the selective NACK telemetry when the NACK period has elapsed
+**
+** Notes:
+**   1. Called at 1 Hz from the main task. Nothing is sent until a frame
+**      has passed the security stage. See rx_seq.h.
+**
+*/
+void RADIO_IF_SendNackTlm(void);
+
+
+/******************************************************************************
+** Function: RADIO_IF_SendLinkTlm
+**
+** Send the next page of the per-node link statistics
+**
+** Notes:
+**   1. Called at 1 Hz from the main task. Each call sends up to
+**      RADIO_IF_LINK_PAGE_LEN nodes and the pages cycle through the
+**      active nodes so the cost per call doesn't grow with the node
+**      count. Nothing is sent until a node has been heard. See rx_link.h.
+**
+*/
+void RADIO_IF_SendLinkTlm(void);
+
+
+/******************************************************************************
+** Function: RADIO_IF_SendSweepTlm
+**
+** Send the latest spectrum sweep waterfall row
+**
+** Notes:
+**   1. Called at 1 Hz from the main task. Nothing is sent unless a sweep
+**      completed since the last row.
+**
+*/
+void RADIO_IF_SendSweepTlm(void);
+
+
+/******************************************************************************
+** Function: RADIO_IF_ServiceTap
+**
+** Accept frame tap clients and release the ones that disconnected
+**
+** Notes:
+**   1. Called at 1 Hz from the main task. Frames are published to the tap
+**      by the child task, see rx_tap.h.
+**
+*/
+void RADIO_IF_ServiceTap(void);
+
+
+/******************************************************************************
+** Function: RADIO_IF_SampleTime
+**
+** Add a raw/mission time pair to the receive time correlation
+**
+** Notes:
+**   1. Called at 1 Hz from the main task. This is the only mission time
+**      read used for frame timestamps.
+**
+*/
+void RADIO_IF_SampleTime(void);
+
+
+/******************************************************************************
+** Function: RADIO_IF_ReportRxEvents
+**
+** Send the receive event summary telemetry and event for the last interval
+**
+** Notes:
+**   1. Called at 1 Hz from the main task. See rx_evt.h.
+**   2. The summary event is only sent when a condition occurred. It's an
+**      error event if any condition lost or rejected uplink data, otherwise
+**      it's a debug event.
+**
+*/
+void RADIO_IF_ReportRxEvents(void);
+
+
+/******************************************************************************
+** Function: RADIO_IF_ReportSchedule
+**
+** Send an event for schedule entries executed or skipped since the last
+** report
+**
+** Notes:
+**   1. Called at 1 Hz from the main task.
+**   2. It's an error event if an entry was applied later than the
+**      SCHED_LATE_LIMIT_US ini limit or skipped, otherwise it's an
+**      informational event.
+**
+*/
+void RADIO_IF_ReportSchedule(void);
+
+
+/******************************************************************************
+** Function: RADIO_IF_ReportWatchdog
+**
+** Send an event for radio watchdog recoveries since the last report
+**
+** Notes:
+**   1. Called at 1 Hz from the main task. A recovery is reported once the
+**      child task has restored the configuration so the event has the
+**      detection to receiving time.
+**
+*/
+void RADIO_IF_ReportWatchdog(void);
+
+
+/******************************************************************************
+** Function: RADIO_IF_CryptoBenchCmd
+**
+** Measure the per-frame cost of the portable and accelerated AES-GCM
+** implementations
+**
+** Notes:
+**   1. Must match CMDMGR_CmdFuncPtr_t function signature
+**   2. Uses a throwaway key and a maximum length secured frame. The
+**      receive pipeline isn't affected.
+*/
+bool RADIO_IF_CryptoBenchCmd(void *ObjDataPtr, const CFE_MSG_Message_t *MsgPtr);
+
+
 /******************************************************************************
 ** Function: RADIO_IF_InitRadio
 **
@@ -163,24 +640,183 @@ bool RADIO_IF_SendRadioTlmCmd(void *ObjDataPtr, const CFE_MSG_Message_t *MsgPtr)
 **
 ** Notes:
 **   1. Must match CMDMGR_CmdFuncPtr_t function signature
+**   2. Switches the radio to LoRa. Mod must be RADIO_RX_MOD_LORA, use
+**      RADIO_IF_SetFlrcParamsCmd() to select FLRC.
 */
 bool RADIO_IF_SetLoRaParamsCmd(void *ObjDataPtr, const CFE_MSG_Message_t *MsgPtr);
 
 
+/******************************************************************************
+** Function: RADIO_IF_StartScanCmd
+**
+** Start a channel activity detection scan using the scan table channels
+**
+** Notes:
+**   1. Must match CMDMGR_CmdFuncPtr_t function signature
+**   2. Requires LoRa mode. The scan locks onto the first channel with
+**      activity and rescans if no frames are received for SCAN_RELOCK_MS.
+*/
+bool RADIO_IF_StartScanCmd(void *ObjDataPtr, const CFE_MSG_Message_t *MsgPtr);
+
+
+/******************************************************************************
+** Function: RADIO_IF_StopScanCmd
+**
+** Notes:
+**   1. Must match CMDMGR_CmdFuncPtr_t function signature
+**   2. Returns to the commanded frequency and LoRa parameters.
+*/
+bool RADIO_IF_StopScanCmd(void *ObjDataPtr, const CFE_MSG_Message_t *MsgPtr);
+
+
+/******************************************************************************
+** Function: RADIO_IF_StartSweepCmd
+**
+** Start an RSSI spectrum sweep, see rx_sweep.h
+**
+** Notes:
+**   1. Must match CMDMGR_CmdFuncPtr_t function signature
+**   2. Frames aren't received while sweeping. A running sweep switches
+**      to the new band.
+*/
+bool RADIO_IF_StartSweepCmd(void *ObjDataPtr, const CFE_MSG_Message_t *MsgPtr);
+
+
+/******************************************************************************
+** Function: RADIO_IF_StopSweepCmd
+**
+** Notes:
+**   1. Must match CMDMGR_CmdFuncPtr_t function signature
+**   2. Returns to receiving with the commanded configuration.
+*/
+bool RADIO_IF_StopSweepCmd(void *ObjDataPtr, const CFE_MSG_Message_t *MsgPtr);
+
+
+/******************************************************************************
+** Function: RADIO_IF_SetFlrcParamsCmd
+**
+** Notes:
+**   1. Must match CMDMGR_CmdFuncPtr_t function signature
+**   2. Switches the radio to FLRC. The Node and Dest frame filters set by
+**      the LoRa parameters command are unchanged.
+*/
+bool RADIO_IF_SetFlrcParamsCmd(void *ObjDataPtr, const CFE_MSG_Message_t *MsgPtr);
+
+
+/******************************************************************************
+** Function: RADIO_IF_SetSniffModeCmd
+**
+** Select duty-cycled sniff receive or continuous receive
+**
+** Notes:
+**   1. Must match CMDMGR_CmdFuncPtr_t function signature
+**   2. A SleepPeriodUs of 0 selects continuous receive. A CAD scan in
+**      progress keeps running and the new mode is used when it's stopped.
+*/
+bool RADIO_IF_SetSniffModeCmd(void *ObjDataPtr, const CFE_MSG_Message_t *MsgPtr);
+
+
+/******************************************************************************
+** Function: RADIO_IF_DumpTraceCmd
+**
+** Write the receive pipeline trace to a file in Chrome trace event JSON
+**
+** Notes:
+**   1. Must match CMDMGR_CmdFuncPtr_t function signature
+**   2. The file can be opened with chrome://tracing or the Perfetto UI.
+**      Each trace task is a thread and times are relative to the oldest
+**      event in the dump.
+**   3. Tracing keeps running during the dump. See rx_trace.h.
+*/
+bool RADIO_IF_DumpTraceCmd(void *ObjDataPtr, const CFE_MSG_Message_t *MsgPtr);
+
+
+/******************************************************************************
+** Function: RADIO_IF_DumpSpiRecCmd
+**
+** Write the SPI transfer recording to a file
+**
+** Notes:
+**   1. Must match CMDMGR_CmdFuncPtr_t function signature
+**   2. The file is an SPI recorder file image, see spi_rec.h. Recording
+**      keeps running during the dump.
+*/
+bool RADIO_IF_DumpSpiRecCmd(void *ObjDataPtr, const CFE_MSG_Message_t *MsgPtr);
+
+
+/******************************************************************************
+** Function: RADIO_IF_ReplaySpiRecCmd
+**
+** Replay an SPI recording file in place of the radio
+**
+** Notes:
+**   1. Must match CMDMGR_CmdFuncPtr_t function signature
+**   2. The recorded frames go through the complete receive pipeline. The
+**      radio is left in standby during the replay. RADIO_IF_UpdateSpiCost()
+**      reports the end of the replay and restarts receiving.
+**   3. Recording continues during a replay so a dump taken afterwards can
+**      be compared with the replayed file.
+**   4. Rejected while a receive schedule or spectrum sweep is running. A
+**      CAD scan is stopped and the commanded frequency restored first.
+**      Commands that send radio commands are rejected during the replay
+**      because their transfers would consume recorded ones.
+*/
+bool RADIO_IF_ReplaySpiRecCmd(void *ObjDataPtr, const CFE_MSG_Message_t *MsgPtr);
+
+
+/******************************************************************************
+** Function: RADIO_IF_SelectProfileCmd
+**
+** Switch the radio to a precompiled profile table profile
+**
+** Notes:
+**   1. Must match CMDMGR_CmdFuncPtr_t function signature
+**   2. The profile's register image is sent without further validation, it
+**      was checked when it was compiled. The radio configuration reported
+**      in telemetry is updated from the profile definition.
+*/
+bool RADIO_IF_SelectProfileCmd(void *ObjDataPtr, const CFE_MSG_Message_t *MsgPtr);
+
+
 /******************************************************************************
 ** Function: RADIO_IF_SetRadioFrequencyCmd
 **
 ** Notes:
 **   1. Must match CMDMGR_CmdFuncPtr_t function signature
+**   2. The frequency must be in the RADIO_RX_MIN_FREQ_MHZ to
+**      RADIO_RX_MAX_FREQ_MHZ band that profiles are compiled for, so the
+**      commanded configuration can always be compiled into a profile.
 */
 bool RADIO_IF_SetRadioFrequencyCmd(void *ObjDataPtr, const CFE_MSG_Message_t *MsgPtr);
 
 
+/******************************************************************************
+** Function: RADIO_IF_CalibrateSpiCmd
+**
+** Select the fastest reliable SPI speed
+**
+** Notes:
+**   1. Must match CMDMGR_CmdFuncPtr_t function signature
+**   2. Test patterns are written to and read back from the radio data
+**      buffer at each RADIO_IF_SPI_CAL_STEPS speed up to SPI_CAL_MAX_SPEED.
+**      Receiving stops during the calibration and is restarted afterwards.
+**   3. The result is reported in the radio telemetry.
+**   4. Rejected while a replay, spectrum sweep, receive schedule or CAD
+**      scan is running. Receiving restarts with the commanded modulation
+**      and frequency, which would silently end a schedule or scan.
+*/
+bool RADIO_IF_CalibrateSpiCmd(void *ObjDataPtr, const CFE_MSG_Message_t *MsgPtr);
+
+
 /******************************************************************************
 ** Function: RADIO_IF_SetSpiSpeedCmd
 **
 ** Notes:
 **   1. Must match CMDMGR_CmdFuncPtr_t function signature
+**   2. Rejected while a replay, receive schedule or spectrum sweep is
+**      running.
+**   3. A commanded speed replaces a calibrated one, the calibration
+**      telemetry reports RADIO_IF_SPI_CAL_OVERRIDDEN with the new speed.
 */
 bool RADIO_IF_SetSpiSpeedCmd(void *ObjDataPtr, const CFE_MSG_Message_t *MsgPtr);
 
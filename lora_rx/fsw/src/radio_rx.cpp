@@ -30,148 +30,2657 @@
 */
 
 #include <string.h>
+#include <time.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <new>
+#include <thread>
 #include "SX128x_Linux.hpp"
 extern "C"
 {
    #include "radio_rx.h"
+   #include "rx_mem.h"
+   #include "rx_trace.h"
+   #include "spi_rec.h"
 }
 
 /**********************/
 /** Global File Data **/
 /**********************/
 
+/*
+** The library doesn't expose the DIO1 edge time so the IRQ status read that
+** starts IRQ processing is timestamped at the SPI layer. Nothing else reads
+** the IRQ status so the last stamp belongs to the IRQ being dispatched.
+*/
+
+static std::atomic<int64_t> IrqTimeNs(0);
+static std::atomic<int32_t> RxTimeOffsetNs(0);
+
+/*
+** SPI accounting. Every transfer is timed and recorded along with the BUSY
+** wait that preceded it. The per-IRQ sums are thread_local because only
+** the radio IRQ context's transfers are attributed to frames, they're
+** reset by the IRQ status read and published when a frame has been read.
+*/
+
+static std::atomic<uint32_t> SpiTransferCnt(0);
+static std::atomic<uint32_t> SpiByteCnt(0);
+static std::atomic<uint64_t> SpiTransferNs(0);
+static std::atomic<uint64_t> SpiBusyNs(0);
+static std::atomic<uint32_t> SpiFrameCnt(0);
+static std::atomic<uint32_t> SpiFrameTransferCnt(0);
+static std::atomic<uint32_t> SpiFrameByteCnt(0);
+static std::atomic<uint64_t> SpiFrameNs(0);
+static std::atomic<uint64_t> SpiFrameBusyNs(0);
+static std::atomic<uint32_t> SpiLastFrameNs(0);
+
+static thread_local uint32_t PendingBusyNs = 0;
+static thread_local uint32_t IrqTransferCnt = 0;
+static thread_local uint32_t IrqByteCnt = 0;
+static thread_local uint64_t IrqNs = 0;
+static thread_local uint64_t IrqBusyNs = 0;
+
+/*
+** Replay. While Replaying is set transfers are answered from the recording
+** by the replay cursor. The mutex serializes the cursor between the replay
+** thread and any other context that makes a transfer.
+*/
+
+static std::atomic<bool> Replaying(false);
+static std::atomic<bool> ReplayStop(false);
+static std::mutex        ReplayMutex;
+static std::thread       ReplayTask;
+static SPI_REC_Replay_t  Replay;
+
+/*
+** Virtual RF channel. When a medium is set the radio object answers its
+** transfers from the virtual SX128x instead of the SPI device and the
+** channel thread raises its IRQs. The mutex serializes the virtual radio
+** between the channel thread and the contexts that command it.
+*/
+
+static RX_VCHAN_Medium_t *VchanMedium = NULL;
+static RX_VCHAN_Model_t   VchanModel;
+static RX_VCHAN_Class_t   Vchan;
+static std::mutex         VchanMutex;
+static std::thread        VchanTask;
+static std::atomic<bool>  VchanStop(false);
+
+/*
+** Radio command serialization. A command sequence runs under the radio
+** mutex, including its BUSY waits, so the IRQ context, the watchdog and the
+** app's tasks can't interleave commands. The radio functions take it and
+** radio_if holds it across a reconfiguration with RADIO_RX_Lock(). It's
+** recursive so locked functions can call each other. It's taken before
+** the replay and virtual channel mutexes. Threads that may be joined by a
+** context holding it lock it with LockRadio() which gives up when the
+** thread's stop flag or RadioClosing is set.
+*/
+
+typedef std::unique_lock<std::recursive_timed_mutex> RadioLock_t;
+
+static std::recursive_timed_mutex RadioMutex;
+static std::atomic<bool> RadioClosing(false);
+static thread_local const std::atomic<bool> *RadioLockStop = NULL;
+
+/*
+** Radio watchdog. The BUSY wait start is claimed by the first of any
+** overlapping waits so it ages from the oldest one. The receive arm
+** sequence changes whenever the receive mode changes so a probe that
+** raced a mode change is discarded.
+*/
+
+static std::atomic<int64_t>  BusyWaitStartNs(0);   /* 0 when no BUSY wait in progress */
+static std::atomic<bool>     RxContinuous(false);
+static std::atomic<int64_t>  RxArmNs(0);
+static std::atomic<uint32_t> RxArmSeq(0);
+
+static std::thread       WatchdogTask;
+static std::atomic<bool> WatchdogStop(false);
+static std::atomic<bool> WatchdogActive(false);
+static std::atomic<bool> RecoveryPending(false);
+static uint32_t WatchdogBusyTimeoutUs = 0;
+static uint32_t WatchdogRxSilenceMs   = 0;
+
+static std::atomic<int64_t>  FaultDetectNs(0);
+static std::atomic<uint8_t>  LastFault(RADIO_RX_FAULT_NONE);
+static std::atomic<uint32_t> WatchdogResetCnt(0);
+static std::atomic<uint32_t> WatchdogFaultCnt[RADIO_RX_FAULT_CNT];
+static std::atomic<uint32_t> WatchdogProbeCnt(0);
+static std::atomic<uint32_t> LastRecoveryUs(0);
+static std::atomic<uint32_t> MaxRecoveryUs(0);
+
+static int64_t RawNs(void);
+static bool LockRadio(RadioLock_t &Lock);
+
+/*
+** Virtual radio hardware layer, see rx_vchan.h. There's no BUSY line, a
+** virtual command completes within its transfer.
+*/
+class VirtualRadio : public SX128x
+{
+public:
+   void HalSpiTransfer(uint8_t *buffer_in, const uint8_t *buffer_out, uint16_t size) override
+   {
+      std::lock_guard<std::mutex> Lock(VchanMutex);
+      RX_VCHAN_Transfer(&Vchan, buffer_out, buffer_in, size);
+   }
+   
+   void WaitOnBusy() override
+   {
+   }
+};
+
+/*
+** The accounting, recording and replay wrap either hardware layer so the
+** virtual radio is measured the same way as the SX128x. Each transfer is
+** made under the radio mutex after BUSY is checked again, the library's
+** IRQ context waits for BUSY before the mutex is free so another context's
+** command may have raised it.
+*/
+template <class Hal>
+class RadioDevice : public Hal
+{
+public:
+   using Hal::Hal;
+   
+   void HalSpiTransfer(uint8_t *buffer_in, const uint8_t *buffer_out, uint16_t size) override
+   {
+      RadioLock_t Lock(RadioMutex, std::defer_lock);
+      int64_t  StartNs;
+      uint32_t DurationNs;
+      
+      if (!LockRadio(Lock))
+      {
+         if (buffer_in != NULL)
+         {
+            memset(buffer_in, 0, size);
+         }
+         return;
+      }
+      WaitOnBusy();
+      StartNs = RawNs();
+      
+      if (size > 0 && buffer_out[0] == SX128x::RADIO_GET_IRQSTATUS)
+      {
+         IrqTimeNs.store(StartNs, std::memory_order_relaxed);
+         IrqTransferCnt = 0;
+         IrqByteCnt = 0;
+         IrqNs      = 0;
+         IrqBusyNs  = PendingBusyNs;
+      }
+      
+      if (Replaying.load(std::memory_order_acquire))
+      {
+         std::lock_guard<std::mutex> Lock(ReplayMutex);
+         SPI_REC_ReplayTransfer(&Replay, buffer_out, buffer_in, size);
+      }
+      else
+      {
+         Hal::HalSpiTransfer(buffer_in, buffer_out, size);
+      }
+      
+      DurationNs = (uint32_t)(RawNs() - StartNs);
+      
+      SpiTransferCnt.fetch_add(1, std::memory_order_relaxed);
+      SpiByteCnt.fetch_add(size, std::memory_order_relaxed);
+      SpiTransferNs.fetch_add(DurationNs, std::memory_order_relaxed);
+      SpiBusyNs.fetch_add(PendingBusyNs, std::memory_order_relaxed);
+      
+      IrqTransferCnt++;
+      IrqByteCnt += size;
+      IrqNs      += DurationNs;
+      
+      SPI_REC_Add(buffer_out, buffer_in, size, StartNs, DurationNs, PendingBusyNs);
+      PendingBusyNs = 0;
+   }
+   
+   void WaitOnBusy() override
+   {
+      int64_t  StartNs;
+      int64_t  NoWait = 0;
+      uint32_t WaitNs;
+      bool     Oldest;
+      
+      if (!Replaying.load(std::memory_order_acquire))
+      {
+         StartNs = RawNs();
+         Oldest  = BusyWaitStartNs.compare_exchange_strong(NoWait, StartNs, std::memory_order_relaxed);
+         Hal::WaitOnBusy();
+         if (Oldest)
+         {
+            BusyWaitStartNs.store(0, std::memory_order_relaxed);
+         }
+         WaitNs = (uint32_t)(RawNs() - StartNs);
+         PendingBusyNs += WaitNs;
+         IrqBusyNs     += WaitNs;
+      }
+   }
+};
+
+typedef RadioDevice<SX128x_Linux> HwRadioDevice;
+typedef RadioDevice<VirtualRadio> VirtualRadioDevice;
+
+/*
+** The radio object is constructed in arena storage so reinitializing the
+** radio reuses the same memory. HwRadio is only set for the SX128x, the
+** virtual radio doesn't have an SPI clock.
+*/
+static void *RadioStorage = NULL;
+static char  LastError[RADIO_RX_ERROR_LEN] = "";
+
 // Pins based on hardware configuration
-SX128x_Linux *Radio = NULL;
+SX128x *Radio = NULL;
+static HwRadioDevice      *HwRadio = NULL;
+static VirtualRadioDevice *VirtualRadioDev = NULL;
+
+/*
+** Receive frame slots. The radio IRQ context is the only producer and the
+** app's child task is the only consumer so the head and tail indices are
+** each written by one context. The mutex is only used to sleep/wake the
+** consumer, it doesn't protect the slots.
+*/
+
+static RADIO_RX_Frame_t *FrameSlot = NULL;
+static uint32_t SlotCnt  = 0;
+static uint32_t SlotMask = 0;
+static std::atomic<uint32_t> SlotHighWater(0);
+
+static std::atomic<uint32_t> SlotHead(0);
+static std::atomic<uint32_t> SlotTail(0);
+
+static std::mutex              SlotMutex;
+static std::condition_variable SlotCond;
+
+static std::atomic<uint8_t>  PacketType(SX128x::PACKET_TYPE_LORA);
+
+/*
+** CAD scan state. The channel list is only written while the scan is idle,
+** after that it's only used by the radio IRQ context.
+*/
+
+static uint8_t LoRaBandwidth  = SX128x::LORA_BW_1600;
+static uint8_t LoRaCodingRate = SX128x::LORA_CR_4_5;
+
+static std::atomic<uint8_t> ScanState(RADIO_RX_SCAN_IDLE);
+static RADIO_RX_ScanChannel_t ScanChannel[RADIO_RX_SCAN_MAX_CHANNELS];
+static uint8_t ScanChannelCnt = 0;
+static uint8_t ScanIndex = 0;
+static SX128x::RadioLoRaCadSymbols_t ScanCadSymbols = SX128x::LORA_CAD_04_SYMBOL;
+static std::chrono::steady_clock::time_point ScanStartTime;
+
+static std::atomic<uint8_t>  ScanLockIndex(0);
+static std::atomic<uint32_t> ScanStepCnt(0);
+static std::atomic<uint32_t> ScanAcquireCnt(0);
+static std::atomic<uint32_t> ScanLastAcquireUs(0);
+static std::atomic<uint32_t> ScanHitCnt[RADIO_RX_SCAN_MAX_CHANNELS];
+
+/*
+** Sniff state. The wake time is written by the radio IRQ context when a
+** reception starts and read by the consumer to measure wake latency.
+*/
+
+static std::atomic<bool>     SniffActive(false);
+static SX128x::RadioTickSizes_t SniffTickSize = SX128x::RADIO_TICK_SIZE_0015_US;
+static uint16_t SniffRxTicks    = 0;
+static uint16_t SniffSleepTicks = 0;
+static std::atomic<uint32_t> SniffRxPeriodUs(0);
+static std::atomic<uint32_t> SniffSleepPeriodUs(0);
+static std::chrono::steady_clock::time_point SniffStartTime;
+
+static std::atomic<int64_t>  SniffWakeTimeNs(0);     /* 0 when no reception in progress */
+static std::atomic<int64_t>  SniffLastWakeTimeNs(0);
+static std::atomic<uint64_t> SniffBusyNs(0);         /* Time spent receiving frames */
+static std::atomic<uint32_t> SniffWakeCnt(0);
+static std::atomic<uint32_t> SniffWakeLatencyUs(0);
+static std::atomic<uint32_t> SniffMaxWakeLatencyUs(0);
+
+static std::atomic<bool>     WaitAbort(false);
+static std::atomic<uint32_t> IrqCnt(0);
+static std::atomic<uint32_t> ConsumerWakeCnt(0);
+
+static std::atomic<uint32_t> RxDoneCnt(0);
+static std::atomic<uint32_t> CrcErrCnt(0);
+static std::atomic<uint32_t> HdrErrCnt(0);
+static std::atomic<uint32_t> OverrunCnt(0);
+
+
+/*
+** Profile compiler. These are constexpr so the built-in profiles are
+** encoded by the compiler and table profiles use the same code at load time.
+*/
+
+constexpr uint32_t SX128X_XTAL_HZ = 52000000;
+
+constexpr uint32_t FrequencySteps(uint32_t FrequencyHz)
+{
+   return (uint32_t)(((uint64_t)FrequencyHz << 18)/SX128X_XTAL_HZ);
+}
+
+/* Datasheet section 14.4.1: register 0x925 must match the spreading factor */
+constexpr uint8_t LoRaSfRegister(uint8_t SpreadingFactor)
+{
+   return (SpreadingFactor <= SX128x::LORA_SF6) ? 0x1E : ((SpreadingFactor <= SX128x::LORA_SF8) ? 0x37 : 0x32);
+}
+
+constexpr void AddCmd(RADIO_RX_ProfileImage_t &Image, uint8_t Opcode, const uint8_t *Param, uint8_t ParamLen)
+{
+   uint8_t i = 0;
+   
+   Image.Cmd[Image.CmdCnt][0] = Opcode;
+   for (i = 0; i < ParamLen; i++)
+   {
+      Image.Cmd[Image.CmdCnt][1+i] = Param[i];
+   }
+   Image.CmdLen[Image.CmdCnt] = ParamLen + 1;
+   Image.CmdCnt++;
+}
+
+constexpr bool ValidProfile(const RADIO_RX_ProfileDef_t &Def)
+{
+   bool Valid = false;
+   
+   if (Def.Frequency != 0 && (Def.Frequency < RADIO_RX_MIN_FREQ_MHZ || Def.Frequency > RADIO_RX_MAX_FREQ_MHZ))
+   {
+      return false;
+   }
+   
+   if (Def.Mod == RADIO_RX_MOD_LORA)
+   {
+      Valid = ((Def.SpreadingFactor & 0x0F) == 0 &&
+               Def.SpreadingFactor >= SX128x::LORA_SF5 && Def.SpreadingFactor <= SX128x::LORA_SF12 &&
+               (Def.Bandwidth == SX128x::LORA_BW_0200 || Def.Bandwidth == SX128x::LORA_BW_0400 ||
+                Def.Bandwidth == SX128x::LORA_BW_0800 || Def.Bandwidth == SX128x::LORA_BW_1600) &&
+               Def.CodingRate >= SX128x::LORA_CR_4_5 && Def.CodingRate <= SX128x::LORA_CR_LI_4_7 &&
+               Def.Crc <= 1);
+   }
+   else if (Def.Mod == RADIO_RX_MOD_FLRC)
+   {
+      Valid = ((Def.Bitrate == SX128x::FLRC_BR_1_300_BW_1_2 || Def.Bitrate == SX128x::FLRC_BR_1_000_BW_1_2 ||
+                Def.Bitrate == SX128x::FLRC_BR_0_650_BW_0_6 || Def.Bitrate == SX128x::FLRC_BR_0_520_BW_0_6 ||
+                Def.Bitrate == SX128x::FLRC_BR_0_325_BW_0_3 || Def.Bitrate == SX128x::FLRC_BR_0_260_BW_0_3) &&
+               (Def.CodingRate == SX128x::FLRC_CR_1_2 || Def.CodingRate == SX128x::FLRC_CR_3_4 ||
+                Def.CodingRate == SX128x::FLRC_CR_1_0) &&
+               (Def.Shaping == SX128x::RADIO_MOD_SHAPING_BT_OFF || Def.Shaping == SX128x::RADIO_MOD_SHAPING_BT_1_0 ||
+                Def.Shaping == SX128x::RADIO_MOD_SHAPING_BT_0_5) &&
+               Def.Crc <= 3);
+   }
+   
+   return Valid;
+}
+
+/*
+** Command order follows the SX128x datasheet: standby, packet type,
+** frequency, modulation and packet parameters. The LoRa packet parameters
+** match the frame format: 12 symbol preamble, explicit header, CRC and
+** normal IQ. FLRC uses a 32 bit preamble, sync word 1 and no whitening.
+*/
+constexpr RADIO_RX_ProfileImage_t BuildProfile(const RADIO_RX_ProfileDef_t &Def)
+{
+   RADIO_RX_ProfileImage_t Image{};
+   uint32_t Steps = FrequencySteps((uint32_t)Def.Frequency*1000000UL);
+   
+   const uint8_t Standby[1]  = { SX128x::STDBY_XOSC };
+   const uint8_t Freq[3]     = { (uint8_t)(Steps >> 16), (uint8_t)(Steps >> 8), (uint8_t)Steps };
+   const uint8_t LoRaType[1] = { SX128x::PACKET_TYPE_LORA };
+   const uint8_t FlrcType[1] = { SX128x::PACKET_TYPE_FLRC };
+   const uint8_t LoRaMod[3]  = { Def.SpreadingFactor, Def.Bandwidth, Def.CodingRate };
+   const uint8_t LoRaSfReg[3] = { 0x09, 0x25, LoRaSfRegister(Def.SpreadingFactor) };
+   const uint8_t LoRaPkt[7]  = { 12, SX128x::LORA_PACKET_VARIABLE_LENGTH, RX_FRAME_MAX_LEN,
+                                 (uint8_t)(Def.Crc ? SX128x::LORA_CRC_ON : SX128x::LORA_CRC_OFF),
+                                 SX128x::LORA_IQ_NORMAL, 0, 0 };
+   const uint8_t FlrcMod[3]  = { Def.Bitrate, Def.CodingRate, Def.Shaping };
+   const uint8_t FlrcPkt[7]  = { SX128x::PREAMBLE_LENGTH_32_BITS, SX128x::FLRC_SYNCWORD_LENGTH_4_BYTE,
+                                 SX128x::RADIO_RX_MATCH_SYNCWORD_1, SX128x::RADIO_PACKET_VARIABLE_LENGTH,
+                                 RADIO_RX_FLRC_MAX_LEN, (uint8_t)((Def.Crc & 0x03) << 4),
+                                 SX128x::RADIO_WHITENING_OFF };
+   /* FLRC sync word 1 starts one byte after the 5 byte sync word 1 base address 0x09CE */
+   const uint8_t FlrcSync[6] = { 0x09, 0xCF, (uint8_t)(Def.SyncWord >> 24), (uint8_t)(Def.SyncWord >> 16),
+                                 (uint8_t)(Def.SyncWord >> 8), (uint8_t)Def.SyncWord };
+   
+   Image.Mod = Def.Mod;
+   
+   AddCmd(Image, SX128x::RADIO_SET_STANDBY, Standby, 1);
+   if (Def.Mod == RADIO_RX_MOD_FLRC)
+   {
+      AddCmd(Image, SX128x::RADIO_SET_PACKETTYPE, FlrcType, 1);
+      if (Def.Frequency != 0)
+      {
+         AddCmd(Image, SX128x::RADIO_SET_RFFREQUENCY, Freq, 3);
+      }
+      AddCmd(Image, SX128x::RADIO_SET_MODULATIONPARAMS, FlrcMod, 3);
+      AddCmd(Image, SX128x::RADIO_SET_PACKETPARAMS, FlrcPkt, 7);
+      AddCmd(Image, SX128x::RADIO_WRITE_REGISTER, FlrcSync, 6);
+      Image.ModParam[0] = FlrcMod[0];
+      Image.ModParam[1] = FlrcMod[1];
+      Image.ModParam[2] = FlrcMod[2];
+   }
+   else
+   {
+      AddCmd(Image, SX128x::RADIO_SET_PACKETTYPE, LoRaType, 1);
+      if (Def.Frequency != 0)
+      {
+         AddCmd(Image, SX128x::RADIO_SET_RFFREQUENCY, Freq, 3);
+      }
+      AddCmd(Image, SX128x::RADIO_SET_MODULATIONPARAMS, LoRaMod, 3);
+      AddCmd(Image, SX128x::RADIO_WRITE_REGISTER, LoRaSfReg, 3);
+      AddCmd(Image, SX128x::RADIO_SET_PACKETPARAMS, LoRaPkt, 7);
+      Image.ModParam[0] = LoRaMod[0];
+      Image.ModParam[1] = LoRaMod[1];
+      Image.ModParam[2] = LoRaMod[2];
+   }
+   
+   return Image;
+}
+
+/*
+** Built-in profiles: a long range acquisition profile and a high rate
+** bulk transfer profile
+*/
+constexpr RADIO_RX_ProfileDef_t BuiltinProfileDef[RADIO_RX_BUILTIN_PROFILES] =
+{
+   { "acq-SF12",      RADIO_RX_MOD_LORA, SX128x::LORA_SF12, SX128x::LORA_BW_0800, SX128x::LORA_CR_LI_4_7, 1, 0, 0, 0, 0, 0, 0 },
+   { "bulk-SF5-1600", RADIO_RX_MOD_LORA, SX128x::LORA_SF5,  SX128x::LORA_BW_1600, SX128x::LORA_CR_4_5,    1, 0, 0, 0, 0, 0, 0 }
+};
+
+static_assert(ValidProfile(BuiltinProfileDef[0]) && ValidProfile(BuiltinProfileDef[1]), "Invalid built-in radio profile");
+
+constexpr RADIO_RX_ProfileImage_t BuiltinProfileImage[RADIO_RX_BUILTIN_PROFILES] =
+{
+   BuildProfile(BuiltinProfileDef[0]),
+   BuildProfile(BuiltinProfileDef[1])
+};
+
+
+/*
+** Time-on-air model. Symbol times and maximum length frame times for every
+** valid LoRa setting are compile time tables indexed by SF (5-12), bandwidth
+** and coding rate, so the run time model is a table lookup. LoRa times are
+** kept in quarter symbols because the preamble overhead is 4.25 or 6.25
+** symbols.
+*/
+
+constexpr uint8_t  LORA_SF_CNT  = 8;
+constexpr uint8_t  LORA_BW_CNT  = 4;
+constexpr uint8_t  LORA_CR_CNT  = 7;
+constexpr uint8_t  LORA_PREAMBLE_SYMBOLS = 12;    /* Set by BuildProfile() */
+constexpr uint8_t  LORA_HEADER_BITS      = 20;    /* Explicit header */
+constexpr uint32_t FLRC_OVERHEAD_BITS    = 32+32; /* Preamble and sync word, uncoded */
+constexpr uint32_t FLRC_HEADER_BITS      = 16;
+constexpr uint32_t FLRC_TAIL_BITS        = 6;     /* Coded packets only */
+
+/*
+** Estimated RxDone IRQ latency after the last symbol. LoRa completes
+** decoding the last interleaver block about one symbol after it's
+** received, FLRC after the last byte clears the deserializer.
+*/
+constexpr uint32_t FLRC_RX_DONE_BITS     = 8;
+
+constexpr uint32_t LoRaBandwidthHz[LORA_BW_CNT] = { 203125, 406250, 812500, 1625000 };
+
+constexpr int8_t LoRaBwIndex(uint8_t Bandwidth)
+{
+   return (Bandwidth == SX128x::LORA_BW_0200) ? 0 : (Bandwidth == SX128x::LORA_BW_0400) ? 1 :
+          (Bandwidth == SX128x::LORA_BW_0800) ? 2 : (Bandwidth == SX128x::LORA_BW_1600) ? 3 : -1;
+}
+
+/* Coded bits per 4 data bits. The long interleaving code 0x07 is 4/8. */
+constexpr uint32_t LoRaCrDenominator(uint8_t CodingRate)
+{
+   return (CodingRate <= SX128x::LORA_CR_4_8) ? (CodingRate + 4) :
+          ((CodingRate == SX128x::LORA_CR_LI_4_7) ? 8 : (CodingRate - SX128x::LORA_CR_LI_4_5 + 5));
+}
+
+constexpr uint32_t LoRaSymbolNs(uint8_t Sf, uint8_t BwIndex)
+{
+   return (uint32_t)(((uint64_t)1000000000 << Sf)/LoRaBandwidthHz[BwIndex]);
+}
+
+constexpr uint32_t LoRaPreambleQuarters(uint8_t Sf)
+{
+   return 4*LORA_PREAMBLE_SYMBOLS + ((Sf <= 6) ? 25 : 17);
+}
+
+/* SX128x datasheet LoRa packet duration, SF11 and SF12 use the reduced rate */
+constexpr uint32_t LoRaFrameNs(uint8_t Sf, uint8_t BwIndex, uint32_t CrDenom, bool Crc, uint16_t FrameLen)
+{
+   int32_t  Bits    = 8*FrameLen + (Crc ? 16 : 0) - 4*Sf + ((Sf >= 7) ? 8 : 0) + LORA_HEADER_BITS;
+   uint32_t BitsPerBlock = 4*((Sf >= 11) ? (Sf - 2) : Sf);
+   uint32_t Blocks  = (Bits > 0) ? (((uint32_t)Bits + BitsPerBlock - 1)/BitsPerBlock) : 0;
+   uint32_t Quarters = LoRaPreambleQuarters(Sf) + 4*(8 + Blocks*CrDenom);
+
+   return (uint32_t)(((uint64_t)Quarters*LoRaSymbolNs(Sf, BwIndex))/4);
+}
+
+struct LoRaAirtimeTable_t
+{
+   uint32_t SymbolNs[LORA_SF_CNT][LORA_BW_CNT];
+   uint32_t MaxFrameUs[LORA_SF_CNT][LORA_BW_CNT][LORA_CR_CNT][2];
+};
+
+constexpr LoRaAirtimeTable_t BuildLoRaAirtimeTable()
+{
+   LoRaAirtimeTable_t Table{};
+   
+   for (uint8_t Sf = 0; Sf < LORA_SF_CNT; Sf++)
+   {
+      for (uint8_t Bw = 0; Bw < LORA_BW_CNT; Bw++)
+      {
+         Table.SymbolNs[Sf][Bw] = LoRaSymbolNs(Sf+5, Bw);
+         for (uint8_t Cr = 0; Cr < LORA_CR_CNT; Cr++)
+         {
+            for (uint8_t Crc = 0; Crc < 2; Crc++)
+            {
+               Table.MaxFrameUs[Sf][Bw][Cr][Crc] =
+                  LoRaFrameNs(Sf+5, Bw, LoRaCrDenominator(Cr+1), Crc, RX_FRAME_MAX_LEN)/1000;
+            }
+         }
+      }
+   }
+   
+   return Table;
+}
+
+constexpr LoRaAirtimeTable_t LoRaAirtime = BuildLoRaAirtimeTable();
+
+/* SF12 at 203 kHz is 4096/203125 s, SF5 at 1625 kHz is 32/1625000 s */
+static_assert(LoRaAirtime.SymbolNs[7][0] == 20164923 && LoRaAirtime.SymbolNs[0][3] == 19692, "LoRa symbol time table");
+
+constexpr uint32_t FlrcBitRate(uint8_t Bitrate)
+{
+   return (Bitrate == SX128x::FLRC_BR_1_300_BW_1_2) ? 1300000 : (Bitrate == SX128x::FLRC_BR_1_000_BW_1_2) ? 1040000 :
+          (Bitrate == SX128x::FLRC_BR_0_650_BW_0_6) ?  650000 : (Bitrate == SX128x::FLRC_BR_0_520_BW_0_6) ?  520000 :
+          (Bitrate == SX128x::FLRC_BR_0_325_BW_0_3) ?  325000 : (Bitrate == SX128x::FLRC_BR_0_260_BW_0_3) ?  260000 : 0;
+}
+
+/* Occupied bandwidth, the bitrate codes name it */
+constexpr uint32_t FlrcBandwidthHz(uint8_t Bitrate)
+{
+   return (Bitrate == SX128x::FLRC_BR_1_300_BW_1_2 || Bitrate == SX128x::FLRC_BR_1_000_BW_1_2) ? 1200000 :
+          (Bitrate == SX128x::FLRC_BR_0_650_BW_0_6 || Bitrate == SX128x::FLRC_BR_0_520_BW_0_6) ?  600000 : 300000;
+}
+
+/* Crc is the CRC length code, 0 is off and 1-3 are 2-4 bytes */
+constexpr uint32_t FlrcFrameNs(uint8_t Bitrate, uint8_t CodingRate, uint8_t Crc, uint16_t FrameLen)
+{
+   uint32_t Bits = FLRC_HEADER_BITS + 8*((uint32_t)FrameLen + ((Crc > 0) ? (Crc + 1) : 0));
+   
+   if (CodingRate == SX128x::FLRC_CR_1_2)
+   {
+      Bits = 2*Bits + FLRC_TAIL_BITS;
+   }
+   else if (CodingRate == SX128x::FLRC_CR_3_4)
+   {
+      Bits = (4*Bits + 2)/3 + FLRC_TAIL_BITS;
+   }
+   
+   return (uint32_t)(((uint64_t)(FLRC_OVERHEAD_BITS + Bits)*1000000000)/FlrcBitRate(Bitrate));
+}
+
+
+/*******************************/
+/** Local Function Prototypes **/
+/*******************************/
+
+static void RxDoneCallback(void);
+static void RxErrorCallback(SX128x::IrqErrorCode_t ErrCode);
+static void ReadFrame(uint8_t Flags);
+static void CadDoneCallback(bool Detected);
+static void StartCad(void);
+static void SniffWakeCallback(void);
+static void SniffEndReception(void);
+static void SniffArm(void);
+static int64_t SteadyNs(void);
+static void PublishFrameSpiCost(void);
+static void ReplayIrqs(void);
+static void VchanIrqs(void);
+static void StopChannel(void);
+static bool ChannelPhy(uint8_t Type, const uint8_t *ModParam, uint8_t Crc, uint8_t Len, RX_VCHAN_Phy_t *Phy);
+static void SetRxArmed(bool Continuous);
+static void WatchdogLoop(void);
+static uint8_t CheckHealth(int64_t *LastProbeNs);
+static void ResetRadio(uint8_t Fault);
+static bool CreateRadio(const char *SpiDevStr, uint8_t SpiDevNum, const RADIO_RX_Pin_t *RadioPin);
+static void SaveError(const char *Error);
+
+
+/******************************************************************************
+** Function: RADIO_RX_Setup
+**
+*/
+bool RADIO_RX_Setup(uint16_t FrameSlots)
+{
+   
+   if (FrameSlots == 0 || FrameSlots > RADIO_RX_MAX_FRAME_SLOTS || (FrameSlots & (FrameSlots - 1)) != 0)
+   {
+      return false;
+   }
+   
+   RadioStorage = RX_MEM_Alloc(std::max(sizeof(HwRadioDevice), sizeof(VirtualRadioDevice)));
+   FrameSlot    = (RADIO_RX_Frame_t *)RX_MEM_Alloc(FrameSlots*sizeof(RADIO_RX_Frame_t));
+   if (RadioStorage == NULL || FrameSlot == NULL)
+   {
+      RadioStorage = NULL;
+      FrameSlot    = NULL;
+      return false;
+   }
+   
+   SlotCnt  = FrameSlots;
+   SlotMask = FrameSlots - 1;
+   
+   return true;
+   
+} /* End RADIO_RX_Setup() */
+
+
+/******************************************************************************
+** Function: RADIO_RX_InitRadio
+**
+*/
+bool RADIO_RX_InitRadio(const char *SpiDevStr, uint8_t SpiDevNum, const RADIO_RX_Pin_t *RadioPin)
+{
+   bool RetStatus = false;
+   
+   std::lock_guard<std::recursive_timed_mutex> Lock(RadioMutex);
+   
+   try
+   {
+      if (CreateRadio(SpiDevStr, SpiDevNum, RadioPin))
+      {
+         Radio->Init();
+         Radio->SetStandby(SX128x::STDBY_XOSC);
+         Radio->SetBufferBaseAddresses(0x00, 0x00);
+      
+         RetStatus = true;
+      }
+   }
+   catch (const std::exception &Error)
+   {
+      SaveError(Error.what());
+      RetStatus = false;
+   }
+   
+   return RetStatus;
+   
+} /* End RADIO_RX_InitRadio() */
+
+
+/******************************************************************************
+** Function: RADIO_RX_AttachRadio
+**
+** Notes:
+**   1. The SX128x status byte reports the circuit mode in bits 7:5. A radio
+**      that lost power or is stuck doesn't report standby, FS or RX.
+**
+*/
+bool RADIO_RX_AttachRadio(const char *SpiDevStr, uint8_t SpiDevNum, const RADIO_RX_Pin_t *RadioPin)
+{
+   bool    RetStatus = false;
+   uint8_t Mode;
+   
+   std::lock_guard<std::recursive_timed_mutex> Lock(RadioMutex);
+   
+   try
+   {
+      if (CreateRadio(SpiDevStr, SpiDevNum, RadioPin))
+      {
+         Mode = (Radio->GetStatus() >> 5) & 0x07;
+         if (Mode >= 2 && Mode <= 5)
+         {
+            Radio->SetStandby(SX128x::STDBY_XOSC);
+            Radio->ClearIrqStatus(SX128x::IRQ_RADIO_ALL);
+            Radio->SetBufferBaseAddresses(0x00, 0x00);
+            RetStatus = true;
+         }
+         else
+         {
+            SaveError("Invalid radio operating mode");
+         }
+      }
+   }
+   catch (const std::exception &Error)
+   {
+      SaveError(Error.what());
+      RetStatus = false;
+   }
+   
+   return RetStatus;
+   
+} /* End RADIO_RX_AttachRadio() */
+
+
+/******************************************************************************
+** Function: RADIO_RX_LastError
+**
+*/
+const char *RADIO_RX_LastError(void)
+{
+   
+   return LastError;
+   
+} /* End RADIO_RX_LastError() */
+
+
+/******************************************************************************
+** Function: RADIO_RX_Lock
+**
+*/
+void RADIO_RX_Lock(void)
+{
+   
+   RadioMutex.lock();
+   
+} /* End RADIO_RX_Lock() */
+
+
+/******************************************************************************
+** Function: RADIO_RX_Unlock
+**
+*/
+void RADIO_RX_Unlock(void)
+{
+   
+   RadioMutex.unlock();
+   
+} /* End RADIO_RX_Unlock() */
+
+
+/******************************************************************************
+** Function: RADIO_RX_GetSlotStatus
+**
+*/
+void RADIO_RX_GetSlotStatus(RADIO_RX_SlotStatus_t *Status)
+{
+   
+   Status->SlotCnt   = (uint16_t)SlotCnt;
+   Status->HighWater = (uint16_t)SlotHighWater.load(std::memory_order_relaxed);
+   
+} /* End RADIO_RX_GetSlotStatus() */
+
+
+/******************************************************************************
+** Function: RADIO_RX_CompileProfile
+**
+*/
+bool RADIO_RX_CompileProfile(const RADIO_RX_ProfileDef_t *Def, RADIO_RX_ProfileImage_t *Image)
+{
+   
+   if (!ValidProfile(*Def))
+   {
+      return false;
+   }
+   
+   *Image = BuildProfile(*Def);
+   
+   return true;
+   
+} /* End RADIO_RX_CompileProfile() */
+
+
+/******************************************************************************
+** Function: RADIO_RX_GetBuiltinProfile
+**
+*/
+bool RADIO_RX_GetBuiltinProfile(uint8_t Index, RADIO_RX_ProfileDef_t *Def, RADIO_RX_ProfileImage_t *Image)
+{
+   
+   if (Index >= RADIO_RX_BUILTIN_PROFILES)
+   {
+      return false;
+   }
+   
+   *Def   = BuiltinProfileDef[Index];
+   *Image = BuiltinProfileImage[Index];
+   
+   return true;
+   
+} /* End RADIO_RX_GetBuiltinProfile() */
+
+
+/******************************************************************************
+** Function: RADIO_RX_ApplyProfile
+**
+** Notes:
+**   1. WriteCommand() waits for BUSY before each command so the burst only
+**      costs the SPI transfers.
+**
+*/
+bool RADIO_RX_ApplyProfile(const RADIO_RX_ProfileImage_t *Image)
+{
+   
+   uint8_t i;
+   
+   std::lock_guard<std::recursive_timed_mutex> Lock(RadioMutex);
+   
+   SetRxArmed(false);
+   for (i = 0; i < Image->CmdCnt; i++)
+   {
+      Radio->WriteCommand((SX128x::RadioCommands_t)Image->Cmd[i][0],
+                          const_cast<uint8_t *>(&Image->Cmd[i][1]), Image->CmdLen[i] - 1);
+   }
+   
+   if (Image->Mod == RADIO_RX_MOD_FLRC)
+   {
+      PacketType = SX128x::PACKET_TYPE_FLRC;
+   }
+   else
+   {
+      LoRaBandwidth  = Image->ModParam[1];
+      LoRaCodingRate = Image->ModParam[2];
+      PacketType = SX128x::PACKET_TYPE_LORA;
+   }
+   
+   return true;
+   
+} /* End RADIO_RX_ApplyProfile() */
+
+
+/******************************************************************************
+** Function: RADIO_RX_GetAirtime
+**
+*/
+bool RADIO_RX_GetAirtime(const RADIO_RX_ProfileDef_t *Def, RADIO_RX_Airtime_t *Airtime)
+{
+   
+   uint8_t Sf;
+   uint8_t Bw;
+   
+   memset(Airtime, 0, sizeof(RADIO_RX_Airtime_t));
+   
+   if (!ValidProfile(*Def))
+   {
+      return false;
+   }
+   
+   if (Def->Mod == RADIO_RX_MOD_FLRC)
+   {
+      Airtime->BitRate    = FlrcBitRate(Def->Bitrate);
+      Airtime->SymbolNs   = 1000000000/Airtime->BitRate;
+      Airtime->PreambleUs = (uint32_t)(((uint64_t)FLRC_OVERHEAD_BITS*1000000)/Airtime->BitRate);
+      Airtime->MaxFrameUs = FlrcFrameNs(Def->Bitrate, Def->CodingRate, Def->Crc, RADIO_RX_FLRC_MAX_LEN)/1000;
+      Airtime->MaxFrameLen = RADIO_RX_FLRC_MAX_LEN;
+      Airtime->RxDoneNs   = FLRC_RX_DONE_BITS*Airtime->SymbolNs;
+   }
+   else
+   {
+      Sf = (Def->SpreadingFactor >> 4) - 5;
+      Bw = (uint8_t)LoRaBwIndex(Def->Bandwidth);
+      Airtime->SymbolNs   = LoRaAirtime.SymbolNs[Sf][Bw];
+      Airtime->PreambleUs = (uint32_t)(((uint64_t)LoRaPreambleQuarters(Sf+5)*Airtime->SymbolNs)/4000);
+      Airtime->MaxFrameUs = LoRaAirtime.MaxFrameUs[Sf][Bw][Def->CodingRate-1][Def->Crc];
+      Airtime->MaxFrameLen = RX_FRAME_MAX_LEN;
+      Airtime->RxDoneNs   = Airtime->SymbolNs;
+      /* SF bits per symbol, 4 of every LoRaCrDenominator() bits carry data */
+      Airtime->BitRate    = (uint32_t)(((uint64_t)(Sf+5)*1000000000*4)/
+                                       ((uint64_t)Airtime->SymbolNs*LoRaCrDenominator(Def->CodingRate)));
+   }
+   
+   return true;
+   
+} /* End RADIO_RX_GetAirtime() */
+
+
+/******************************************************************************
+** Function: RADIO_RX_FrameAirtimeUs
+**
+*/
+uint32_t RADIO_RX_FrameAirtimeUs(const RADIO_RX_ProfileDef_t *Def, uint16_t FrameLen)
+{
+   
+   uint32_t FrameUs = 0;
+   
+   if (ValidProfile(*Def))
+   {
+      if (Def->Mod == RADIO_RX_MOD_FLRC)
+      {
+         FrameUs = FlrcFrameNs(Def->Bitrate, Def->CodingRate, Def->Crc, FrameLen)/1000;
+      }
+      else
+      {
+         FrameUs = LoRaFrameNs(Def->SpreadingFactor >> 4, (uint8_t)LoRaBwIndex(Def->Bandwidth),
+                               LoRaCrDenominator(Def->CodingRate), Def->Crc, FrameLen)/1000;
+      }
+   }
+   
+   return FrameUs;
+   
+} /* End RADIO_RX_FrameAirtimeUs() */
+
+
+/******************************************************************************
+** Function: RADIO_RX_RawTimeNs
+**
+*/
+int64_t RADIO_RX_RawTimeNs(void)
+{
+   
+   return RawNs();
+   
+} /* End RADIO_RX_RawTimeNs() */
+
+
+/******************************************************************************
+** Function: RADIO_RX_SetRxTimeOffset
+**
+*/
+void RADIO_RX_SetRxTimeOffset(int32_t OffsetNs)
+{
+   
+   RxTimeOffsetNs.store(OffsetNs, std::memory_order_relaxed);
+   
+} /* End RADIO_RX_SetRxTimeOffset() */
+
+                            
+/******************************************************************************
+** Function: RADIO_RX_GetSpiStatus
+**
+*/
+void RADIO_RX_GetSpiStatus(RADIO_RX_SpiStatus_t *Status)
+{
+   
+   Status->TransferCnt      = SpiTransferCnt.load(std::memory_order_relaxed);
+   Status->ByteCnt          = SpiByteCnt.load(std::memory_order_relaxed);
+   Status->TransferNs       = SpiTransferNs.load(std::memory_order_relaxed);
+   Status->BusyNs           = SpiBusyNs.load(std::memory_order_relaxed);
+   Status->FrameTransferCnt = SpiFrameTransferCnt.load(std::memory_order_relaxed);
+   Status->FrameByteCnt     = SpiFrameByteCnt.load(std::memory_order_relaxed);
+   Status->FrameNs          = SpiFrameNs.load(std::memory_order_relaxed);
+   Status->FrameBusyNs      = SpiFrameBusyNs.load(std::memory_order_relaxed);
+   Status->LastFrameNs      = SpiLastFrameNs.load(std::memory_order_relaxed);
+   Status->FrameCnt         = SpiFrameCnt.load(std::memory_order_acquire);
+   
+} /* End RADIO_RX_GetSpiStatus() */
+
+
+/******************************************************************************
+** Function: RADIO_RX_StartReplay
+**
+** Notes:
+**   1. The radio's interrupts are disabled first so only the replay thread
+**      runs the IRQ callbacks. Receiving must be restarted after a replay.
+**   2. The radio mutex is taken before the replay mutex, a transfer takes
+**      them in that order.
+**
+*/
+bool RADIO_RX_StartReplay(const uint8_t *Buf, uint32_t Len)
+{
+   
+   bool RetStatus = false;
+   
+   std::lock_guard<std::recursive_timed_mutex> Lock(RadioMutex);
+   
+   if (Radio != NULL && !Replaying.load(std::memory_order_acquire))
+   {
+      if (ReplayTask.joinable())
+      {
+         ReplayTask.join();
+      }
+      
+      std::lock_guard<std::mutex> Lock(ReplayMutex);
+      if (SPI_REC_ReplayOpen(&Replay, Buf, Len))
+      {
+         ScanState   = RADIO_RX_SCAN_IDLE;
+         SniffActive = false;
+         Radio->SetStandby(SX128x::STDBY_XOSC);
+         Radio->SetDioIrqParams(SX128x::IRQ_RADIO_NONE, SX128x::IRQ_RADIO_NONE, 
+                                SX128x::IRQ_RADIO_NONE, SX128x::IRQ_RADIO_NONE);
+         
+         ReplayStop.store(false, std::memory_order_relaxed);
+         Replaying.store(true, std::memory_order_release);
+         ReplayTask = std::thread(ReplayIrqs);
+         RetStatus  = true;
+      }
+   }
+   
+   return RetStatus;
+   
+} /* End RADIO_RX_StartReplay() */
+
+
+/******************************************************************************
+** Function: RADIO_RX_StopReplay
+**
+*/
+void RADIO_RX_StopReplay(void)
+{
+   
+   ReplayStop.store(true, std::memory_order_relaxed);
+   if (ReplayTask.joinable())
+   {
+      ReplayTask.join();
+   }
+   
+} /* End RADIO_RX_StopReplay() */
+
+
+/******************************************************************************
+** Function: RADIO_RX_GetReplayStatus
+**
+*/
+void RADIO_RX_GetReplayStatus(RADIO_RX_ReplayStatus_t *Status)
+{
+   
+   std::lock_guard<std::mutex> Lock(ReplayMutex);
+   
+   memset(Status, 0, sizeof(RADIO_RX_ReplayStatus_t));
+   Status->Active      = Replaying.load(std::memory_order_acquire);
+   Status->RecordCnt   = Replay.RecordCnt;
+   Status->ReplayCnt   = Replay.ReplayCnt;
+   Status->MismatchCnt = Replay.MismatchCnt;
+   Status->SkipCnt     = Replay.SkipCnt;
+   
+} /* End RADIO_RX_GetReplayStatus() */
+
+
+/******************************************************************************
+** Function: RADIO_RX_StartWatchdog
+**
+*/
+bool RADIO_RX_StartWatchdog(uint32_t BusyTimeoutUs, uint32_t RxSilenceMs)
+{
+   
+   std::lock_guard<std::recursive_timed_mutex> Lock(RadioMutex);
+   
+   if (Radio == NULL)
+   {
+      return false;
+   }
+   
+   RADIO_RX_StopWatchdog();
+   
+   WatchdogBusyTimeoutUs = BusyTimeoutUs;
+   WatchdogRxSilenceMs   = RxSilenceMs;
+   RecoveryPending.store(false, std::memory_order_relaxed);
+   
+   WatchdogStop.store(false, std::memory_order_relaxed);
+   WatchdogActive.store(true, std::memory_order_release);
+   WatchdogTask = std::thread(WatchdogLoop);
+   
+   return true;
+   
+} /* End RADIO_RX_StartWatchdog() */
+
+
+/******************************************************************************
+** Function: RADIO_RX_StopWatchdog
+**
+*/
+void RADIO_RX_StopWatchdog(void)
+{
+   
+   WatchdogStop.store(true, std::memory_order_relaxed);
+   if (WatchdogTask.joinable())
+   {
+      WatchdogTask.join();
+   }
+   WatchdogActive.store(false, std::memory_order_release);
+   RecoveryPending.store(false, std::memory_order_release);
+   
+} /* End RADIO_RX_StopWatchdog() */
+
+
+/******************************************************************************
+** Function: RADIO_RX_RecoveryPending
+**
+*/
+bool RADIO_RX_RecoveryPending(void)
+{
+   
+   return RecoveryPending.load(std::memory_order_acquire);
+   
+} /* End RADIO_RX_RecoveryPending() */
+
+
+/******************************************************************************
+** Function: RADIO_RX_EndRecovery
+**
+*/
+void RADIO_RX_EndRecovery(void)
+{
+   
+   uint32_t RecoveryUs;
+   
+   if (RecoveryPending.load(std::memory_order_acquire))
+   {
+      RecoveryUs = (uint32_t)((RawNs() - FaultDetectNs.load(std::memory_order_relaxed))/1000);
+      LastRecoveryUs.store(RecoveryUs, std::memory_order_relaxed);
+      if (RecoveryUs > MaxRecoveryUs.load(std::memory_order_relaxed))
+      {
+         MaxRecoveryUs.store(RecoveryUs, std::memory_order_relaxed);
+      }
+      RecoveryPending.store(false, std::memory_order_release);
+   }
+   
+} /* End RADIO_RX_EndRecovery() */
+
+
+/******************************************************************************
+** Function: RADIO_RX_GetWatchdogStatus
+**
+*/
+void RADIO_RX_GetWatchdogStatus(RADIO_RX_WatchdogStatus_t *Status)
+{
+   
+   uint8_t i;
+   
+   Status->Active         = WatchdogActive.load(std::memory_order_acquire);
+   Status->LastFault      = LastFault.load(std::memory_order_relaxed);
+   Status->Recovering     = RecoveryPending.load(std::memory_order_acquire);
+   Status->Spare          = 0;
+   Status->ResetCnt       = WatchdogResetCnt.load(std::memory_order_relaxed);
+   Status->ProbeCnt       = WatchdogProbeCnt.load(std::memory_order_relaxed);
+   Status->LastRecoveryUs = LastRecoveryUs.load(std::memory_order_relaxed);
+   Status->MaxRecoveryUs  = MaxRecoveryUs.load(std::memory_order_relaxed);
+   for (i = 0; i < RADIO_RX_FAULT_CNT; i++)
+   {
+      Status->FaultCnt[i] = WatchdogFaultCnt[i].load(std::memory_order_relaxed);
+   }
+   
+} /* End RADIO_RX_GetWatchdogStatus() */
+
+
+/******************************************************************************
+** Function: RADIO_RX_SetChannel
+**
+** Notes:
+**   1. The medium stays mapped for the life of the process, only the
+**      first name is opened.
+**
+*/
+bool RADIO_RX_SetChannel(const char *MediumName, const RX_VCHAN_Model_t *Model)
+{
+   
+   if (MediumName == NULL || MediumName[0] == '\0')
+   {
+      VchanMedium = NULL;
+      return true;
+   }
+   
+   VchanModel  = *Model;
+   VchanMedium = RX_VCHAN_OpenMedium(MediumName);
+   if (VchanMedium == NULL)
+   {
+      SaveError("Virtual channel medium can't be opened");
+   }
+   
+   return (VchanMedium != NULL);
+   
+} /* End RADIO_RX_SetChannel() */
+
+
+/******************************************************************************
+** Function: RADIO_RX_GetChannelStats
+**
+*/
+bool RADIO_RX_GetChannelStats(RX_VCHAN_Stats_t *Stats)
+{
+   
+   memset(Stats, 0, sizeof(RX_VCHAN_Stats_t));
+   
+   if (VirtualRadioDev == NULL)
+   {
+      return false;
+   }
+   
+   std::lock_guard<std::mutex> Lock(VchanMutex);
+   *Stats = Vchan.Stats;
+   
+   return true;
+   
+} /* End RADIO_RX_GetChannelStats() */
+
+
+/******************************************************************************
+** Function: RADIO_RX_SetSpiSpeed
+**
+** Set the SPI speed
+**
+** Notes:
+**   1. Assumes Radio has been initialized and speed value has been validated 
+**
+*/
+bool RADIO_RX_SetSpiSpeed(uint32_t SpiSpeed)
+{
+   
+   std::lock_guard<std::recursive_timed_mutex> Lock(RadioMutex);
+   
+   if (HwRadio != NULL)
+   {
+      HwRadio->SetSpiSpeed(SpiSpeed);
+   }
+   
+   return true;
+   
+} /* End RADIO_RX_SetSpiSpeed() */
+
+
+/******************************************************************************
+** Function: RADIO_RX_TestSpiSpeed
+**
+*/
+void RADIO_RX_TestSpiSpeed(uint32_t SpiSpeed, uint16_t Passes, RADIO_RX_SpiTest_t *Test)
+{
+   
+   uint8_t  Pattern[RADIO_RX_SPI_TEST_LEN];
+   uint8_t  Readback[RADIO_RX_SPI_TEST_LEN];
+   uint32_t Prbs;
+   uint32_t Errors;
+   uint64_t WriteNs = 0;
+   uint64_t ReadNs  = 0;
+   int64_t  StartNs;
+   uint16_t Pass;
+   uint16_t i;
+   
+   std::lock_guard<std::recursive_timed_mutex> Lock(RadioMutex);
+   
+   memset(Test, 0, sizeof(RADIO_RX_SpiTest_t));
+   
+   ScanState   = RADIO_RX_SCAN_IDLE;
+   SniffActive = false;
+   if (HwRadio != NULL)
+   {
+      HwRadio->SetSpiSpeed(SpiSpeed);
+   }
+   Radio->SetStandby(SX128x::STDBY_XOSC);
+   
+   for (Pass = 0; Pass < Passes; Pass++)
+   {
+      Prbs = 0x9E3779B9u ^ Pass;
+      for (i = 0; i < RADIO_RX_SPI_TEST_LEN; i++)
+      {
+         switch (Pass & 3)
+         {
+            case 0:  Pattern[i] = (i & 1) ? 0xAA : 0x55; break;
+            case 1:  Pattern[i] = (uint8_t)(1 << (i & 7)); break;
+            case 2:  Pattern[i] = (uint8_t)~(1 << (i & 7)); break;
+            default:
+               Prbs ^= Prbs << 13;
+               Prbs ^= Prbs >> 17;
+               Prbs ^= Prbs << 5;
+               Pattern[i] = (uint8_t)Prbs;
+               break;
+         }
+      }
+      
+      StartNs = RawNs();
+      Radio->WriteBuffer(0x00, Pattern, RADIO_RX_SPI_TEST_LEN);
+      WriteNs += RawNs() - StartNs;
+      
+      memset(Readback, 0, RADIO_RX_SPI_TEST_LEN);
+      StartNs = RawNs();
+      Radio->ReadBuffer(0x00, Readback, RADIO_RX_SPI_TEST_LEN);
+      ReadNs += RawNs() - StartNs;
+      
+      Errors = 0;
+      for (i = 0; i < RADIO_RX_SPI_TEST_LEN; i++)
+      {
+         Errors += (Readback[i] != Pattern[i]);
+      }
+      
+      /* Circuit mode 2 is STDBY_RC, 3 is STDBY_XOSC */
+      if (Errors > 0 || ((Radio->GetStatus() >> 5) & 0x07) != 3)
+      {
+         Test->FailPassCnt++;
+      }
+      Test->ErrByteCnt += Errors;
+      Test->PassCnt++;
+   }
+   
+   if (Passes > 0)
+   {
+      Test->WriteNs = (uint32_t)(WriteNs/Passes);
+      Test->ReadNs  = (uint32_t)(ReadNs/Passes);
+   }
+   
+} /* End RADIO_RX_TestSpiSpeed() */
+
+
+
+/******************************************************************************
+** Function: RADIO_RX_SetRadioFrequency
+**
+** Set the radio frequency
+**
+** Notes:
+**   1. Assumes Radio has been initialized and frequency (Hz) value has been
+**      validated 
+**
+*/
+bool RADIO_RX_SetRadioFrequency(uint32_t Frequency)
+{
+   
+   std::lock_guard<std::recursive_timed_mutex> Lock(RadioMutex);
+   
+   Radio->SetRfFrequency(Frequency);
+   
+   return true;
+   
+} /* End RADIO_RX_SetRadioFrequency() */
+
+
+/******************************************************************************
+** Function: RADIO_RX_StartRx
+**
+** Notes:
+**   1. A timeout count of 0xFFFF selects continuous receive so the radio
+**      stays in RX after each RxDone.
+**
+*/
+bool RADIO_RX_StartRx(void)
+{
+   
+   uint16_t IrqMask = SX128x::IRQ_RX_DONE | SX128x::IRQ_CRC_ERROR | SX128x::IRQ_HEADER_ERROR;
+   
+   std::lock_guard<std::recursive_timed_mutex> Lock(RadioMutex);
+   
+   SniffActive.store(false, std::memory_order_release);
+   
+   Radio->SetDioIrqParams(IrqMask, IrqMask, SX128x::IRQ_RADIO_NONE, SX128x::IRQ_RADIO_NONE);
+   Radio->SetRx({SX128x::RADIO_TICK_SIZE_1000_US, 0xFFFF});
+   SetRxArmed(true);
+   
+   return true;
+   
+} /* End RADIO_RX_StartRx() */
+
+
+/******************************************************************************
+** Function: RADIO_RX_StartSniff
+**
+** Notes:
+**   1. A LoRa header or FLRC sync word interrupt marks the start of a
+**      reception. The preamble detected interrupt isn't used because the
+**      SX128x library doesn't dispatch it.
+**
+*/
+bool RADIO_RX_StartSniff(uint32_t RxPeriodUs, uint32_t SleepPeriodUs)
+{
+   
+   uint32_t MaxPeriodUs = (RxPeriodUs > SleepPeriodUs) ? RxPeriodUs : SleepPeriodUs;
+   uint32_t TickNs;
+   
+   std::lock_guard<std::recursive_timed_mutex> Lock(RadioMutex);
+   
+   if (RxPeriodUs == 0 || SleepPeriodUs == 0 || MaxPeriodUs > RADIO_RX_SNIFF_MAX_PERIOD_US)
+   {
+      return false;
+   }
+   
+   if (MaxPeriodUs <= 1023984)
+   {
+      SniffTickSize = SX128x::RADIO_TICK_SIZE_0015_US;
+      TickNs = 15625;
+   }
+   else if (MaxPeriodUs <= 4095937)
+   {
+      SniffTickSize = SX128x::RADIO_TICK_SIZE_0062_US;
+      TickNs = 62500;
+   }
+   else if (MaxPeriodUs <= 65535000)
+   {
+      SniffTickSize = SX128x::RADIO_TICK_SIZE_1000_US;
+      TickNs = 1000000;
+   }
+   else
+   {
+      SniffTickSize = SX128x::RADIO_TICK_SIZE_4000_US;
+      TickNs = 4000000;
+   }
+   
+   SniffRxTicks    = (uint16_t)(((uint64_t)RxPeriodUs*1000)/TickNs);
+   SniffSleepTicks = (uint16_t)(((uint64_t)SleepPeriodUs*1000)/TickNs);
+   if (SniffRxTicks == 0 || SniffSleepTicks == 0)
+   {
+      return false;
+   }
+   SniffRxPeriodUs    = (uint32_t)(((uint64_t)SniffRxTicks*TickNs)/1000);
+   SniffSleepPeriodUs = (uint32_t)(((uint64_t)SniffSleepTicks*TickNs)/1000);
+   
+   ScanState.store(RADIO_RX_SCAN_IDLE, std::memory_order_release);
+   
+   SniffWakeTimeNs = 0;
+   SniffBusyNs     = 0;
+   SniffStartTime  = std::chrono::steady_clock::now();
+   SniffActive.store(true, std::memory_order_release);
+   SetRxArmed(false);
+   
+   SniffArm();
+   
+   return true;
+   
+} /* End RADIO_RX_StartSniff() */
+
+
+/******************************************************************************
+** Function: RADIO_RX_GetSniffStatus
+**
+*/
+void RADIO_RX_GetSniffStatus(RADIO_RX_SniffStatus_t *Status)
+{
+   
+   uint64_t ElapsedNs;
+   uint64_t BusyNs;
+   uint64_t WindowRatio;
+   
+   Status->Active           = SniffActive.load(std::memory_order_acquire);
+   Status->Spare            = 0;
+   Status->RxPeriodUs       = SniffRxPeriodUs.load(std::memory_order_relaxed);
+   Status->SleepPeriodUs    = SniffSleepPeriodUs.load(std::memory_order_relaxed);
+   Status->WakeCnt          = SniffWakeCnt.load(std::memory_order_relaxed);
+   Status->WakeLatencyUs    = SniffWakeLatencyUs.load(std::memory_order_relaxed);
+   Status->MaxWakeLatencyUs = SniffMaxWakeLatencyUs.load(std::memory_order_relaxed);
+   Status->IrqCnt           = IrqCnt.load(std::memory_order_relaxed);
+   Status->ConsumerWakeCnt  = ConsumerWakeCnt.load(std::memory_order_relaxed);
+   
+   Status->DutyRatio = 10000;
+   if (Status->Active)
+   {
+      ElapsedNs   = (uint64_t)(SteadyNs() - std::chrono::duration_cast<std::chrono::nanoseconds>(SniffStartTime.time_since_epoch()).count());
+      BusyNs      = SniffBusyNs.load(std::memory_order_relaxed);
+      WindowRatio = ((uint64_t)Status->RxPeriodUs*10000)/(Status->RxPeriodUs + Status->SleepPeriodUs);
+      if (ElapsedNs > 0 && BusyNs < ElapsedNs)
+      {
+         Status->DutyRatio = (uint16_t)(WindowRatio + ((10000 - WindowRatio)*BusyNs)/ElapsedNs);
+      }
+   }
+   
+} /* End RADIO_RX_GetSniffStatus() */
+
+
+/******************************************************************************
+** Function: RADIO_RX_StartScan
+**
+*/
+bool RADIO_RX_StartScan(const RADIO_RX_ScanChannel_t *Channel, uint8_t ChannelCnt, uint8_t CadSymbols)
+{
+   
+   uint8_t i;
+   
+   std::lock_guard<std::recursive_timed_mutex> Lock(RadioMutex);
+   
+   if (ChannelCnt == 0 || ChannelCnt > RADIO_RX_SCAN_MAX_CHANNELS ||
+       PacketType.load() != SX128x::PACKET_TYPE_LORA)
+   {
+      return false;
+   }
+   
+   RADIO_RX_StopScan();
+   
+   if (ChannelCnt != ScanChannelCnt || memcmp(Channel, ScanChannel, ChannelCnt*sizeof(RADIO_RX_ScanChannel_t)) != 0)
+   {
+      for (i = 0; i < RADIO_RX_SCAN_MAX_CHANNELS; i++)
+      {
+         ScanHitCnt[i] = 0;
+      }
+   }
+   memcpy(ScanChannel, Channel, ChannelCnt*sizeof(RADIO_RX_ScanChannel_t));
+   ScanChannelCnt = ChannelCnt;
+   
+   switch (CadSymbols)
+   {
+      case 1:  ScanCadSymbols = SX128x::LORA_CAD_01_SYMBOL; break;
+      case 2:  ScanCadSymbols = SX128x::LORA_CAD_02_SYMBOL; break;
+      case 8:  ScanCadSymbols = SX128x::LORA_CAD_08_SYMBOL; break;
+      case 16: ScanCadSymbols = SX128x::LORA_CAD_16_SYMBOL; break;
+      default: ScanCadSymbols = SX128x::LORA_CAD_04_SYMBOL; break;
+   }
+
+   return RADIO_RX_RestartScan();
+   
+} /* End RADIO_RX_StartScan() */
+
+
+/******************************************************************************
+** Function: RADIO_RX_RestartScan
+**
+*/
+bool RADIO_RX_RestartScan(void)
+{
+   
+   uint16_t IrqMask = SX128x::IRQ_CAD_DONE | SX128x::IRQ_CAD_ACTIVITY_DETECTED;
+   
+   std::lock_guard<std::recursive_timed_mutex> Lock(RadioMutex);
+   
+   if (ScanChannelCnt == 0 || PacketType.load() != SX128x::PACKET_TYPE_LORA)
+   {
+      return false;
+   }
+   
+   RADIO_RX_StopScan();
+   
+   Radio->SetCadParams(ScanCadSymbols);
+   Radio->SetDioIrqParams(IrqMask, IrqMask, SX128x::IRQ_RADIO_NONE, SX128x::IRQ_RADIO_NONE);
+   
+   SniffActive.store(false, std::memory_order_release);
+   
+   ScanIndex     = 0;
+   ScanStartTime = std::chrono::steady_clock::now();
+   SetRxArmed(false);
+   ScanState.store(RADIO_RX_SCAN_SCANNING, std::memory_order_release);
+   
+   StartCad();
+   
+   return true;
+   
+} /* End RADIO_RX_RestartScan() */
+
+
+/******************************************************************************
+** Function: RADIO_RX_StopScan
+**
+*/
+void RADIO_RX_StopScan(void)
+{
+   
+   std::lock_guard<std::recursive_timed_mutex> Lock(RadioMutex);
+   
+   ScanState.store(RADIO_RX_SCAN_IDLE, std::memory_order_release);
+   SetRxArmed(false);
+   Radio->SetStandby(SX128x::STDBY_XOSC);
+   
+} /* End RADIO_RX_StopScan() */
+
+
+/******************************************************************************
+** Function: RADIO_RX_GetScanStatus
+**
+*/
+void RADIO_RX_GetScanStatus(RADIO_RX_ScanStatus_t *Status)
+{
+   
+   uint8_t i;
+   
+   Status->State         = ScanState.load(std::memory_order_acquire);
+   Status->Channel       = ScanLockIndex.load(std::memory_order_relaxed);
+   Status->Spare         = 0;
+   Status->StepCnt       = ScanStepCnt.load(std::memory_order_relaxed);
+   Status->AcquireCnt    = ScanAcquireCnt.load(std::memory_order_relaxed);
+   Status->LastAcquireUs = ScanLastAcquireUs.load(std::memory_order_relaxed);
+   for (i = 0; i < RADIO_RX_SCAN_MAX_CHANNELS; i++)
+   {
+      Status->HitCnt[i] = ScanHitCnt[i].load(std::memory_order_relaxed);
+   }
+   
+} /* End RADIO_RX_GetScanStatus() */
+
+
+/******************************************************************************
+** Function: RADIO_RX_StartSweep
+**
+*/
+void RADIO_RX_StartSweep(void)
+{
+   
+   std::lock_guard<std::recursive_timed_mutex> Lock(RadioMutex);
+   
+   ScanState.store(RADIO_RX_SCAN_IDLE, std::memory_order_release);
+   SniffActive.store(false, std::memory_order_release);
+   SetRxArmed(false);
+   
+   Radio->SetStandby(SX128x::STDBY_XOSC);
+   Radio->SetDioIrqParams(SX128x::IRQ_RADIO_NONE, SX128x::IRQ_RADIO_NONE,
+                          SX128x::IRQ_RADIO_NONE, SX128x::IRQ_RADIO_NONE);
+   
+} /* End RADIO_RX_StartSweep() */
+
+
+/******************************************************************************
+** Function: RADIO_RX_SweepRssi
+**
+** Notes:
+**   1. The commands are written as raw opcodes with precomputed parameters
+**      so a step costs three short SPI transfers. Receive is reentered
+**      after each frequency change so the synthesizer relocks on the new
+**      frequency before the settle time starts.
+**
+*/
+uint64_t RADIO_RX_SweepRssi(uint32_t StartHz, uint32_t StepHz, uint16_t StepCnt,
+                            uint32_t SettleUs, uint8_t *Rssi)
+{
+   
+   uint8_t  Freq[3];
+   uint8_t  RxParam[3] = { SX128x::RADIO_TICK_SIZE_1000_US, 0xFF, 0xFF };
+   uint32_t Steps;
+   int64_t  SettleNs = (int64_t)SettleUs*1000;
+   int64_t  StartNs  = RawNs();
+   int64_t  TunedNs;
+   uint16_t i;
+   
+   std::lock_guard<std::recursive_timed_mutex> Lock(RadioMutex);
+   
+   for (i = 0; i < StepCnt; i++)
+   {
+      Steps = FrequencySteps(StartHz + i*StepHz);
+      Freq[0] = (uint8_t)(Steps >> 16);
+      Freq[1] = (uint8_t)(Steps >> 8);
+      Freq[2] = (uint8_t)Steps;
+      
+      Radio->WriteCommand(SX128x::RADIO_SET_RFFREQUENCY, Freq, 3);
+      Radio->WriteCommand(SX128x::RADIO_SET_RX, RxParam, 3);
+      
+      TunedNs = RawNs();
+      while (RawNs() - TunedNs < SettleNs)
+      {
+         /* Spin the settle time */
+      }
+      
+      Radio->ReadCommand(SX128x::RADIO_GET_RSSIINST, &Rssi[i], 1);
+   }
+   
+   return (uint64_t)(RawNs() - StartNs);
+   
+} /* End RADIO_RX_SweepRssi() */
+
+
+/******************************************************************************
+** Function: RADIO_RX_WaitFrame
+**
+*/
+RADIO_RX_Frame_t *RADIO_RX_WaitFrame(uint32_t TimeoutMs)
+{
+   
+   uint32_t Tail = SlotTail.load(std::memory_order_relaxed);
+   int64_t  WakeNs;
+   uint32_t LatencyUs;
+   auto FrameReady = [Tail]{ return SlotHead.load(std::memory_order_acquire) != Tail || WaitAbort.load(); };
+   
+   if (SlotHead.load(std::memory_order_acquire) == Tail)
+   {
+      std::unique_lock<std::mutex> Lock(SlotMutex);
+      if (TimeoutMs == RADIO_RX_WAIT_FOREVER)
+      {
+         SlotCond.wait(Lock, FrameReady);
+      }
+      else
+      {
+         SlotCond.wait_for(Lock, std::chrono::milliseconds(TimeoutMs), FrameReady);
+      }
+      Lock.unlock();
+      
+      ConsumerWakeCnt.fetch_add(1, std::memory_order_relaxed);
+      
+      if (WaitAbort.exchange(false) || SlotHead.load(std::memory_order_acquire) == Tail)
+      {
+         return NULL;
+      }
+      
+      WakeNs = SniffLastWakeTimeNs.load(std::memory_order_acquire);
+      if (SniffActive.load(std::memory_order_relaxed) && WakeNs != 0)
+      {
+         LatencyUs = (uint32_t)((SteadyNs() - WakeNs)/1000);
+         SniffWakeLatencyUs.store(LatencyUs, std::memory_order_relaxed);
+         if (LatencyUs > SniffMaxWakeLatencyUs.load(std::memory_order_relaxed))
+         {
+            SniffMaxWakeLatencyUs.store(LatencyUs, std::memory_order_relaxed);
+         }
+      }
+   }
+   
+   return &FrameSlot[Tail & SlotMask];
+   
+} /* End RADIO_RX_WaitFrame() */
+
+
+/******************************************************************************
+** Function: RADIO_RX_AbortWait
+**
+*/
+void RADIO_RX_AbortWait(void)
+{
+   
+   {
+      std::lock_guard<std::mutex> Lock(SlotMutex);
+      WaitAbort = true;
+   }
+   SlotCond.notify_one();
+   
+} /* End RADIO_RX_AbortWait() */
+
+
+/******************************************************************************
+** Function: RADIO_RX_ReleaseFrame
+**
+*/
+void RADIO_RX_ReleaseFrame(void)
+{
+   
+   SlotTail.fetch_add(1, std::memory_order_release);
+   
+} /* End RADIO_RX_ReleaseFrame() */
+
+
+/******************************************************************************
+** Function: RADIO_RX_GetStatus
+**
+*/
+void RADIO_RX_GetStatus(RADIO_RX_Status_t *Status)
+{
+   
+   Status->RxDoneCnt  = RxDoneCnt.load(std::memory_order_relaxed);
+   Status->CrcErrCnt  = CrcErrCnt.load(std::memory_order_relaxed);
+   Status->HdrErrCnt  = HdrErrCnt.load(std::memory_order_relaxed);
+   Status->OverrunCnt = OverrunCnt.load(std::memory_order_relaxed);
+   
+} /* End RADIO_RX_GetStatus() */
+
+
+/******************************************************************************
+** Function: RADIO_RX_RestoreStatus
+**
+*/
+void RADIO_RX_RestoreStatus(const RADIO_RX_Status_t *Status)
+{
+   
+   RxDoneCnt  = Status->RxDoneCnt;
+   CrcErrCnt  = Status->CrcErrCnt;
+   HdrErrCnt  = Status->HdrErrCnt;
+   OverrunCnt = Status->OverrunCnt;
+   
+} /* End RADIO_RX_RestoreStatus() */
+
+
+/******************************************************************************
+** Function: RADIO_RX_ResetStatus
+**
+*/
+void RADIO_RX_ResetStatus(void)
+{
+   
+   uint8_t i;
+   
+   RxDoneCnt  = 0;
+   CrcErrCnt  = 0;
+   HdrErrCnt  = 0;
+   OverrunCnt = 0;
+   
+   SniffWakeCnt          = 0;
+   SniffWakeLatencyUs    = 0;
+   SniffMaxWakeLatencyUs = 0;
+   IrqCnt          = 0;
+   ConsumerWakeCnt = 0;
+   SlotHighWater   = 0;
+   
+   ScanStepCnt       = 0;
+   ScanAcquireCnt    = 0;
+   ScanLastAcquireUs = 0;
+   for (i = 0; i < RADIO_RX_SCAN_MAX_CHANNELS; i++)
+   {
+      ScanHitCnt[i] = 0;
+   }
+   
+   WatchdogResetCnt = 0;
+   WatchdogProbeCnt = 0;
+   LastRecoveryUs   = 0;
+   MaxRecoveryUs    = 0;
+   for (i = 0; i < RADIO_RX_FAULT_CNT; i++)
+   {
+      WatchdogFaultCnt[i] = 0;
+   }
+   
+   if (VchanMedium != NULL)
+   {
+      std::lock_guard<std::mutex> Lock(VchanMutex);
+      RX_VCHAN_ResetStatus(&Vchan);
+   }
+   
+} /* End RADIO_RX_ResetStatus() */
+
+
+/******************************************************************************
+** Function: RxDoneCallback
+**
+** Notes:
+**   1. Runs in the radio IRQ context. The frame is read under the radio
+**      mutex, the library only locks the IRQ status transfers one by one.
+**
+*/
+static void RxDoneCallback(void)
+{
+   
+   RadioLock_t Lock(RadioMutex, std::defer_lock);
+   
+   IrqCnt.fetch_add(1, std::memory_order_relaxed);
+   RxDoneCnt.fetch_add(1, std::memory_order_relaxed);
+   if (!LockRadio(Lock))
+   {
+      return;
+   }
+   SniffEndReception();
+
+   ReadFrame(0);
+   
+} /* End RxDoneCallback() */
+
+
+/******************************************************************************
+** Function: RxErrorCallback
+**
+** Notes:
+**   1. The radio still buffers the payload of a frame that failed its CRC
+**      so it's passed on flagged, the receive core counts it against the
+**      sender named in its header. A header error leaves no payload.
+**
+*/
+static void RxErrorCallback(SX128x::IrqErrorCode_t ErrCode)
+{
+   
+   RadioLock_t Lock(RadioMutex, std::defer_lock);
+   
+   IrqCnt.fetch_add(1, std::memory_order_relaxed);
+   if (!LockRadio(Lock))
+   {
+      return;
+   }
+   SniffEndReception();
+   
+   if (ErrCode == SX128x::IRQ_CRC_ERROR_CODE)
+   {
+      CrcErrCnt.fetch_add(1, std::memory_order_relaxed);
+      ReadFrame(RADIO_RX_FRAME_CRC_ERR);
+   }
+   else
+   {
+      HdrErrCnt.fetch_add(1, std::memory_order_relaxed);
+   }
+   
+} /* End RxErrorCallback() */
+
+
+/******************************************************************************
+** Function: ReadFrame
+**
+** Notes:
+**   1. Runs in the radio IRQ context. The payload is read straight into the
+**      next free slot. If the consumer has fallen behind and every slot is
+**      in use the frame is left in the radio buffer and counted as an
+**      overrun.
+**   2. A CRC errored frame is only worth a slot when it doesn't take the
+**      last free one from a good frame. It isn't counted as an overrun
+**      when it's dropped.
+**
+*/
+static void ReadFrame(uint8_t Flags)
+{
+   
+   int64_t  RxTimeNs = IrqTimeNs.load(std::memory_order_relaxed) - RxTimeOffsetNs.load(std::memory_order_relaxed);
+   uint32_t Head = SlotHead.load(std::memory_order_relaxed);
+   uint32_t InUse;
+   RADIO_RX_Frame_t *Frame;
+   SX128x::PacketStatus_t PacketStatus;
+   
+   InUse = Head - SlotTail.load(std::memory_order_acquire);
+   if (Flags & RADIO_RX_FRAME_CRC_ERR)
+   {
+      if (InUse + 1 >= SlotCnt)
+      {
+         return;
+      }
+   }
+   else if (InUse >= SlotCnt)
+   {
+      OverrunCnt.fetch_add(1, std::memory_order_relaxed);
+      return;
+   }
+   if (InUse + 1 > SlotHighWater.load(std::memory_order_relaxed))
+   {
+      SlotHighWater.store(InUse + 1, std::memory_order_relaxed);
+   }
+   
+   Frame = &FrameSlot[Head & SlotMask];
+   
+   Frame->RxTimeNs = RxTimeNs;
+   Frame->Flags    = Flags;
+   RX_TRACE_Begin(RX_TRACE_TASK_RADIO, RX_TRACE_SPI_READ, 0);
+   Radio->GetPayload(Frame->Data, &Frame->Len, RX_FRAME_MAX_LEN);
+   Radio->GetPacketStatus(&PacketStatus);
+   RX_TRACE_End(RX_TRACE_TASK_RADIO, RX_TRACE_SPI_READ, Frame->Len);
+   PublishFrameSpiCost();
+   if (PacketType.load(std::memory_order_relaxed) == SX128x::PACKET_TYPE_FLRC)
+   {
+      Frame->Rssi = PacketStatus.Flrc.RssiSync;
+      Frame->Snr  = 0;
+   }
+   else
+   {
+      Frame->Rssi = PacketStatus.LoRa.RssiPkt;
+      Frame->Snr  = PacketStatus.LoRa.SnrPkt;
+   }
+   
+   SlotHead.store(Head + 1, std::memory_order_release);
+   
+   {
+      std::lock_guard<std::mutex> Lock(SlotMutex);
+   }
+   SlotCond.notify_one();
+   
+} /* End ReadFrame() */
+
+
+/******************************************************************************
+** Function: CadDoneCallback
+**
+** Notes:
+**   1. Runs in the radio IRQ context. The radio returns to standby after a
+**      CAD so it can be retuned immediately.
+**
+*/
+static void CadDoneCallback(bool Detected)
+{
+   
+   RadioLock_t Lock(RadioMutex, std::defer_lock);
+   std::chrono::microseconds AcquireTime;
+   
+   IrqCnt.fetch_add(1, std::memory_order_relaxed);
+   
+   if (!LockRadio(Lock) || ScanState.load(std::memory_order_acquire) != RADIO_RX_SCAN_SCANNING)
+   {
+      return;
+   }
+   
+   if (Detected)
+   {
+      AcquireTime = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - ScanStartTime);
+      
+      ScanHitCnt[ScanIndex].fetch_add(1, std::memory_order_relaxed);
+      ScanLockIndex.store(ScanIndex, std::memory_order_relaxed);
+      ScanLastAcquireUs.store((uint32_t)AcquireTime.count(), std::memory_order_relaxed);
+      ScanAcquireCnt.fetch_add(1, std::memory_order_relaxed);
+      ScanState.store(RADIO_RX_SCAN_LOCKED, std::memory_order_release);
+      
+      RADIO_RX_StartRx();
+   }
+   else
+   {
+      ScanIndex = (ScanIndex + 1) % ScanChannelCnt;
+      StartCad();
+   }
+   
+} /* End CadDoneCallback() */
+
+
+/******************************************************************************
+** Function: StartCad
+**
+** Tune to the current scan channel and start a CAD
+**
+*/
+static void StartCad(void)
+{
+   
+   uint8_t ModParam[3];
+   uint8_t SfReg[3];
+   uint8_t Freq[3];
+   
+   ModParam[0] = ScanChannel[ScanIndex].SpreadingFactor;
+   ModParam[1] = LoRaBandwidth;
+   ModParam[2] = LoRaCodingRate;
+   
+   SfReg[0] = 0x09;
+   SfReg[1] = 0x25;
+   SfReg[2] = LoRaSfRegister(ModParam[0]);
+   
+   Freq[0] = (uint8_t)(FrequencySteps(ScanChannel[ScanIndex].Frequency) >> 16);
+   Freq[1] = (uint8_t)(FrequencySteps(ScanChannel[ScanIndex].Frequency) >> 8);
+   Freq[2] = (uint8_t)FrequencySteps(ScanChannel[ScanIndex].Frequency);
+   
+   Radio->WriteCommand(SX128x::RADIO_SET_MODULATIONPARAMS, ModParam, 3);
+   Radio->WriteCommand(SX128x::RADIO_WRITE_REGISTER, SfReg, 3);
+   Radio->WriteCommand(SX128x::RADIO_SET_RFFREQUENCY, Freq, 3);
+   Radio->SetCad();
+   
+   ScanStepCnt.fetch_add(1, std::memory_order_relaxed);
+   
+} /* End StartCad() */
 
 
-/*******************************/
-/** Local Function Prototypes **/
-/*******************************/
+/******************************************************************************
+** Function: SniffWakeCallback
+**
+** Notes:
+**   1. Runs in the radio IRQ context when a LoRa header or FLRC sync word
+**      is detected. Only enabled while sniffing.
+**
+*/
+static void SniffWakeCallback(void)
+{
+   
+   int64_t Now = SteadyNs();
+   
+   IrqCnt.fetch_add(1, std::memory_order_relaxed);
+   
+   if (SniffActive.load(std::memory_order_acquire))
+   {
+      SniffWakeTimeNs.store(Now, std::memory_order_relaxed);
+      SniffLastWakeTimeNs.store(Now, std::memory_order_release);
+      SniffWakeCnt.fetch_add(1, std::memory_order_relaxed);
+   }
+   
+} /* End SniffWakeCallback() */
+
 
 /******************************************************************************
-** Function: RADIO_RX_InitRadio
+** Function: SniffEndReception
+**
+** Notes:
+**   1. Runs in the radio IRQ context after a frame or a receive error. The
+**      radio leaves duty-cycled receive after a reception so it's rearmed.
+**
+*/
+static void SniffEndReception(void)
+{
+   
+   int64_t WakeNs;
+   
+   if (SniffActive.load(std::memory_order_acquire))
+   {
+      WakeNs = SniffWakeTimeNs.exchange(0, std::memory_order_relaxed);
+      if (WakeNs != 0)
+      {
+         SniffBusyNs.fetch_add((uint64_t)(SteadyNs() - WakeNs), std::memory_order_relaxed);
+      }
+      SniffArm();
+   }
+   
+} /* End SniffEndReception() */
+
+
+/******************************************************************************
+** Function: SniffArm
+**
+** Enable the sniff interrupts and start duty-cycled receive
+**
+*/
+static void SniffArm(void)
+{
+   
+   uint16_t IrqMask = SX128x::IRQ_RX_DONE | SX128x::IRQ_CRC_ERROR | SX128x::IRQ_HEADER_ERROR;
+   
+   IrqMask |= (PacketType.load(std::memory_order_relaxed) == SX128x::PACKET_TYPE_FLRC) ?
+              SX128x::IRQ_SYNCWORD_VALID : SX128x::IRQ_HEADER_VALID;
+   
+   Radio->SetDioIrqParams(IrqMask, IrqMask, SX128x::IRQ_RADIO_NONE, SX128x::IRQ_RADIO_NONE);
+   Radio->SetRxDutyCycle(SniffTickSize, SniffRxTicks, SniffSleepTicks);
+   
+} /* End SniffArm() */
+
+
+/******************************************************************************
+** Function: SteadyNs
 **
-** Initialize the Radio object to a known state
+*/
+static int64_t SteadyNs(void)
+{
+   
+   return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+   
+} /* End SteadyNs() */
+
+
+/******************************************************************************
+** Function: RawNs
 **
 ** Notes:
-**   1. This must be called prior to any other function.
+**   1. CLOCK_MONOTONIC_RAW isn't slewed by NTP so it's a stable base for
+**      the mission time fit.
 **
 */
-bool RADIO_RX_InitRadio(const char *SpiDevStr, uint8_t SpiDevNum, const RADIO_RX_Pin_t *RadioPin)
+static int64_t RawNs(void)
 {
-   bool RetStatus = false;
    
-   SX128x_Linux::PinConfig PinConfig;
+   struct timespec Now;
    
-   PinConfig.busy  = RadioPin->Busy;
-   PinConfig.nrst  = RadioPin->Nrst;
-   PinConfig.nss   = RadioPin->Nss;
-   PinConfig.dio1  = RadioPin->Dio1;
-   PinConfig.dio2  = RadioPin->Dio2;
-   PinConfig.dio3  = RadioPin->Dio3;
-   PinConfig.tx_en = RadioPin->TxEn;
-   PinConfig.rx_en = RadioPin->RxEn;
+   clock_gettime(CLOCK_MONOTONIC_RAW, &Now);
    
-   try
+   return (int64_t)Now.tv_sec*1000000000 + Now.tv_nsec;
+   
+} /* End RawNs() */
+
+
+/******************************************************************************
+** Function: PublishFrameSpiCost
+**
+** Add the current IRQ's SPI cost to the frame sums
+**
+** Notes:
+**   1. Runs in the radio IRQ context after the payload has been read. The
+**      frame count is released last so a reader that sees a new count
+**      sees that frame's sums.
+**
+*/
+static void PublishFrameSpiCost(void)
+{
+   
+   SpiFrameTransferCnt.fetch_add(IrqTransferCnt, std::memory_order_relaxed);
+   SpiFrameByteCnt.fetch_add(IrqByteCnt, std::memory_order_relaxed);
+   SpiFrameNs.fetch_add(IrqNs + IrqBusyNs, std::memory_order_relaxed);
+   SpiFrameBusyNs.fetch_add(IrqBusyNs, std::memory_order_relaxed);
+   SpiLastFrameNs.store((uint32_t)(IrqNs + IrqBusyNs), std::memory_order_relaxed);
+   SpiFrameCnt.fetch_add(1, std::memory_order_release);
+   
+} /* End PublishFrameSpiCost() */
+
+
+/******************************************************************************
+** Function: ReplayIrqs
+**
+** Replay thread
+**
+** Notes:
+**   1. Each IRQ status read in the recording marks an IRQ. Records before
+**      it that weren't made by the IRQ context, like the transfers of the
+**      command that started receiving, are skipped.
+**   2. IRQs are spaced by their recorded times. Gaps are limited to 1
+**      second so long idle periods don't stall a replay.
+**
+*/
+static void ReplayIrqs(void)
+{
+   
+   const SPI_REC_Hdr_t *Hdr;
+   int64_t LastIrqNs = 0;
+   int64_t GapNs;
+   
+   RadioLockStop = &ReplayStop;
+   
+   while (!ReplayStop.load(std::memory_order_relaxed))
    {
-      Radio = new SX128x_Linux(SpiDevStr, SpiDevNum, PinConfig);
-      RetStatus = true;
+      {
+         std::lock_guard<std::mutex> Lock(ReplayMutex);
+         
+         while ((Hdr = SPI_REC_ReplayPeek(&Replay)) != NULL && Hdr->Opcode != SX128x::RADIO_GET_IRQSTATUS)
+         {
+            SPI_REC_ReplaySkip(&Replay);
+         }
+         if (Hdr == NULL)
+         {
+            break;
+         }
+         GapNs = (LastIrqNs == 0) ? 0 : Hdr->TimeNs - LastIrqNs;
+         LastIrqNs = Hdr->TimeNs;
+      }
+      
+      if (GapNs > 1000000000)
+      {
+         GapNs = 1000000000;
+      }
+      if (GapNs > 0)
+      {
+         std::this_thread::sleep_for(std::chrono::nanoseconds(GapNs));
+      }
+      
+      RadioLock_t Lock(RadioMutex, std::defer_lock);
+      if (LockRadio(Lock))
+      {
+         Radio->ProcessIrqs();
+      }
    }
-   catch (...)
+   
+   Replaying.store(false, std::memory_order_release);
+   
+} /* End ReplayIrqs() */
+
+
+/******************************************************************************
+** Function: VchanIrqs
+**
+** Virtual channel thread, the virtual radio's IRQ context
+**
+** Notes:
+**   1. The thread sleeps until the next frame ends or receive times out,
+**      at most RADIO_RX_VCHAN_POLL_US so new transmissions are seen
+**      promptly.
+**   2. IRQs aren't dispatched during a replay because the replay answers
+**      the IRQ status reads and clears.
+**
+*/
+static void VchanIrqs(void)
+{
+   
+   int64_t NextNs;
+   int64_t WaitNs;
+   bool    Irq;
+   
+   RadioLockStop = &VchanStop;
+   
+   while (!VchanStop.load(std::memory_order_relaxed))
    {
-      RetStatus = false;
+      {
+         std::lock_guard<std::mutex> Lock(VchanMutex);
+         Irq = RX_VCHAN_Poll(&Vchan, &NextNs);
+      }
+      
+      if (Irq && !Replaying.load(std::memory_order_acquire))
+      {
+         RadioLock_t Lock(RadioMutex, std::defer_lock);
+         if (LockRadio(Lock))
+         {
+            Radio->ProcessIrqs();
+         }
+         continue;
+      }
+      
+      WaitNs = (int64_t)RADIO_RX_VCHAN_POLL_US*1000;
+      if (NextNs != 0 && NextNs - RawNs() < WaitNs)
+      {
+         WaitNs = NextNs - RawNs();
+      }
+      if (WaitNs > 0)
+      {
+         std::this_thread::sleep_for(std::chrono::nanoseconds(WaitNs));
+      }
    }
    
-   return RetStatus;
+} /* End VchanIrqs() */
+
+
+/******************************************************************************
+** Function: StopChannel
+**
+*/
+static void StopChannel(void)
+{
    
-} /* End RADIO_RX_InitRadio() */
+   VchanStop.store(true, std::memory_order_relaxed);
+   if (VchanTask.joinable())
+   {
+      VchanTask.join();
+   }
+   
+} /* End StopChannel() */
+
+
+/******************************************************************************
+** Function: ChannelPhy
+**
+** Virtual channel time-on-air model, see RX_VCHAN_PhyFuncPtr_t
+**
+** Notes:
+**   1. The SX128x modulation parameters are the profile's register
+**      values so the profile airtime model applies directly.
+**
+*/
+static bool ChannelPhy(uint8_t Type, const uint8_t *ModParam, uint8_t Crc, uint8_t Len, RX_VCHAN_Phy_t *Phy)
+{
+   
+   RADIO_RX_ProfileDef_t Def;
+   RADIO_RX_Airtime_t    Airtime;
+   
+   memset(&Def, 0, sizeof(RADIO_RX_ProfileDef_t));
+   memset(Phy, 0, sizeof(RX_VCHAN_Phy_t));
+   
+   if (Type == SX128x::PACKET_TYPE_LORA)
+   {
+      Def.Mod = RADIO_RX_MOD_LORA;
+      Def.SpreadingFactor = ModParam[0];
+      Def.Bandwidth  = ModParam[1];
+      Def.CodingRate = ModParam[2];
+   }
+   else if (Type == SX128x::PACKET_TYPE_FLRC)
+   {
+      Def.Mod = RADIO_RX_MOD_FLRC;
+      Def.Bitrate    = ModParam[0];
+      Def.CodingRate = ModParam[1];
+      Def.Shaping    = ModParam[2];
+   }
+   else
+   {
+      return false;
+   }
+   Def.Crc = Crc;
+   
+   if (!RADIO_RX_GetAirtime(&Def, &Airtime))
+   {
+      return false;
+   }
+   
+   Phy->AirtimeUs  = RADIO_RX_FrameAirtimeUs(&Def, Len);
+   Phy->PreambleUs = Airtime.PreambleUs;
+   Phy->SymbolNs   = Airtime.SymbolNs;
+   Phy->BandwidthHz = (Def.Mod == RADIO_RX_MOD_FLRC) ? FlrcBandwidthHz(Def.Bitrate) :
+                      LoRaBandwidthHz[LoRaBwIndex(Def.Bandwidth)];
+   
+   return true;
+   
+} /* End ChannelPhy() */
 
 
 /******************************************************************************
-** Function: RADIO_RX_SetLoraParams
+** Function: SetRxArmed
 **
-** Set the radio Lora parameters
+** Record a receive mode change for the watchdog
 **
 ** Notes:
-**   None
+**   1. Continuous is true when the radio should stay in RX until it's
+**      commanded out of it, which is what a probe can verify.
 **
 */
-bool RADIO_RX_SetLoraParams(uint8_t SpreadingFactor,
-                            uint8_t Bandwidth,
-                            uint8_t CodingRate,
-                            uint8_t TCXO;
-                            uint8_t HSM,
-                            uint8_t Power,
-                            uint8_t Mod,
-                            uint8_t CRC,
-                            uint8_t LDRO,
-                            uint8_t Node,
-                            uint8_t Dest,
-                            uint8_t TXPA,
-                            uint8_t RXLNA);
+static void SetRxArmed(bool Continuous)
 {
    
-   SX128x::ModulationParams_t ModulationParams;
+   RxContinuous.store(Continuous, std::memory_order_relaxed);
+   RxArmNs.store(RawNs(), std::memory_order_relaxed);
+   RxArmSeq.fetch_add(1, std::memory_order_release);
    
-   ModulationParams.PacketType                  = SX128x::PACKET_TYPE_LORA;
-   ModulationParams.Params.LoRa.CodingRate      = (SX128x::RadioLoRaCodingRates_t)CodingRate;
-   ModulationParams.Params.LoRa.Bandwidth       = (SX128x::RadioLoRaBandwidths_t)Bandwidth;
-   ModulationParams.Params.LoRa.SpreadingFactor = (SX128x::RadioLoRaSpreadingFactors_t)SpreadingFactor;
-   ModulationParams.Params.LoRa.TCXO            = (SX128x::RadioLoRaTCXO_t)TCXO;
-   ModulationParams.Params.LoRa.HSM             = (SX128x::RadioLoRaHSM_t)HSM;
-   ModulationParams.Params.LoRa.Power           = (SX128x::RadioLoRaPower_t)Power;
-   ModulationParams.Params.LoRa.Mod             = (SX128x::RadioLoRaMod_t)Mod;
-   ModulationParams.Params.LoRa.CRC             = (SX128x::RadioLoRaCRC_t)CRC;
-   ModulationParams.Params.LoRa.LDRO            = (SX128x::RadioLoRa_t)LDRO;
-   ModulationParams.Params.LoRa.Node            = (SX128x::RadioLoRa_t)Node;
-   ModulationParams.Params.LoRa.Dest            = (SX128x::RadioLoRa_t)Dest;
-   ModulationParams.Params.LoRa.TXPA            = (SX128x::RadioLoRa_t)TXPA;
-   ModulationParams.Params.LoRa.RXLNA           = (SX128x::RadioLoRa_t)RXLNA;
+} /* End SetRxArmed() */
 
-   Radio->SetModulationParams(ModulationParams);
 
-   return true;
+/******************************************************************************
+** Function: WatchdogLoop
+**
+** Watchdog thread
+**
+** Notes:
+**   1. Checks are suspended while a recovery waits for the caller to
+**      restore the configuration and while a replay answers the
+**      transfers.
+**
+*/
+static void WatchdogLoop(void)
+{
    
-} /* RADIO_RX_SetLoraParams() */
-                            
+   int64_t LastProbeNs = 0;
+   uint8_t Fault;
+   
+   RadioLockStop = &WatchdogStop;
+   
+   while (!WatchdogStop.load(std::memory_order_relaxed))
+   {
+      std::this_thread::sleep_for(std::chrono::milliseconds(RADIO_RX_WATCHDOG_POLL_MS));
+      
+      if (RecoveryPending.load(std::memory_order_acquire) || Replaying.load(std::memory_order_acquire))
+      {
+         continue;
+      }
+      
+      Fault = CheckHealth(&LastProbeNs);
+      if (Fault != RADIO_RX_FAULT_NONE)
+      {
+         ResetRadio(Fault);
+         LastProbeNs = 0;
+      }
+   }
+   
+} /* End WatchdogLoop() */
+
+
 /******************************************************************************
-** Function: RADIO_RX_SetSpiSpeed
+** Function: CheckHealth
 **
-** Set the SPI speed
+** Return the radio fault detected, RADIO_RX_FAULT_NONE if it's healthy
 **
 ** Notes:
-**   1. Assumes Radio has been initialized and speed value has been validated 
+**   1. The radio is only probed when no other context holds the radio
+**      mutex and no BUSY wait is in progress, so a probe never splits a
+**      command sequence and the watchdog never blocks behind the radio
+**      it's checking. A busy radio is probed on a later poll.
+**   2. The SX128x status byte reports the circuit mode in bits 7:5, 5 is
+**      RX. A radio that lost its configuration reports the packet type
+**      it resets to.
+**   3. A healthy probe restarts the silence time so a quiet radio is
+**      probed once every RxSilenceMs.
 **
 */
-bool RADIO_RX_SetSpiSpeed(uint32_t SpiSpeed)
+static uint8_t CheckHealth(int64_t *LastProbeNs)
 {
    
-   Radio->SetSpiSpeed(SpiSpeed);
+   int64_t  Now    = RawNs();
+   int64_t  BusyNs = BusyWaitStartNs.load(std::memory_order_relaxed);
+   int64_t  QuietNs;
+   uint32_t ArmSeq;
+   uint8_t  Mode;
+   uint8_t  Type = 0;
+   uint8_t  Fault = RADIO_RX_FAULT_NONE;
    
-   return true;
+   if (BusyNs != 0)
+   {
+      if (WatchdogBusyTimeoutUs > 0 && Now - BusyNs > (int64_t)WatchdogBusyTimeoutUs*1000)
+      {
+         Fault = RADIO_RX_FAULT_BUSY;
+      }
+      return Fault;
+   }
    
-} /* End RADIO_RX_SetSpiSpeed() */
+   if (WatchdogRxSilenceMs == 0)
+   {
+      return Fault;
+   }
+   
+   QuietNs = Now - std::max(std::max(IrqTimeNs.load(std::memory_order_relaxed),
+                                     RxArmNs.load(std::memory_order_relaxed)), *LastProbeNs);
+   if (QuietNs < (int64_t)WatchdogRxSilenceMs*1000000)
+   {
+      return Fault;
+   }
+   
+   if (ScanState.load(std::memory_order_acquire) == RADIO_RX_SCAN_SCANNING)
+   {
+      Fault = RADIO_RX_FAULT_NOT_RX;
+   }
+   else if (RxContinuous.load(std::memory_order_relaxed))
+   {
+      RadioLock_t Lock(RadioMutex, std::try_to_lock);
+      if (!Lock.owns_lock() || BusyWaitStartNs.load(std::memory_order_relaxed) != 0)
+      {
+         return Fault;
+      }
+      
+      ArmSeq = RxArmSeq.load(std::memory_order_acquire);
+      Mode = (Radio->GetStatus() >> 5) & 0x07;
+      Radio->ReadCommand(SX128x::RADIO_GET_PACKETTYPE, &Type, 1);
+      *LastProbeNs = RawNs();
+      WatchdogProbeCnt.fetch_add(1, std::memory_order_relaxed);
+      
+      if (RxArmSeq.load(std::memory_order_acquire) == ArmSeq)
+      {
+         if (Mode != 5)
+         {
+            Fault = RADIO_RX_FAULT_NOT_RX;
+         }
+         else if (Type != PacketType.load(std::memory_order_relaxed))
+         {
+            Fault = RADIO_RX_FAULT_READBACK;
+         }
+      }
+   }
+   
+   return Fault;
+   
+} /* End CheckHealth() */
+
+
+/******************************************************************************
+** Function: ResetRadio
+**
+** Pulse Nrst and leave the radio in standby for the caller to reconfigure
+**
+** Notes:
+**   1. The library's Reset() pulses Nrst and waits for BUSY to drop. The
+**      reset also releases any context blocked in a BUSY wait.
+**   2. The radio is reset and reconfigured under the radio mutex. A stuck
+**      BUSY is the exception, the mutex holder is blocked in the BUSY wait
+**      so Nrst is pulsed first to release it.
+**   3. The consumer's wait is aborted so it sees the pending recovery
+**      without waiting for its timeout.
+**
+*/
+static void ResetRadio(uint8_t Fault)
+{
+   
+   RadioLock_t Lock(RadioMutex, std::defer_lock);
+   
+   FaultDetectNs.store(RawNs(), std::memory_order_relaxed);
+   LastFault.store(Fault, std::memory_order_relaxed);
+   WatchdogFaultCnt[Fault].fetch_add(1, std::memory_order_relaxed);
+   
+   try
+   {
+      if (Fault == RADIO_RX_FAULT_BUSY)
+      {
+         Radio->Reset();
+      }
+      if (!LockRadio(Lock))
+      {
+         return;
+      }
+      
+      ScanState.store(RADIO_RX_SCAN_IDLE, std::memory_order_release);
+      SniffActive.store(false, std::memory_order_release);
+      SetRxArmed(false);
+      
+      if (Fault != RADIO_RX_FAULT_BUSY)
+      {
+         Radio->Reset();
+      }
+      Radio->SetStandby(SX128x::STDBY_XOSC);
+      Radio->ClearIrqStatus(SX128x::IRQ_RADIO_ALL);
+      Radio->SetBufferBaseAddresses(0x00, 0x00);
+   }
+   catch (const std::exception &Error)
+   {
+      SaveError(Error.what());
+   }
+   
+   WatchdogResetCnt.fetch_add(1, std::memory_order_relaxed);
+   RecoveryPending.store(true, std::memory_order_release);
+   RADIO_RX_AbortWait();
+   
+} /* End ResetRadio() */
+
 
+/******************************************************************************
+** Function: CreateRadio
+**
+** Create the radio object and register the IRQ callbacks
+**
+** Notes:
+**   1. Throws if the SPI device or GPIO pins can't be opened, Radio is
+**      NULL in that case.
+**   2. Returns false if RADIO_RX_Setup() didn't allocate the storage.
+**   3. With a channel medium set the virtual radio is created instead and
+**      the pins aren't used.
+**   4. Called with the radio mutex held. RadioClosing makes the old
+**      radio's IRQ context give up waiting for the mutex so it can be
+**      joined by the destructor.
+**   5. The frame slot indices aren't reset. The child task consumes
+**      frames outside the radio mutex and owns the tail, frames queued by
+**      the old radio are still valid and are consumed normally.
+**
+*/
+static bool CreateRadio(const char *SpiDevStr, uint8_t SpiDevNum, const RADIO_RX_Pin_t *RadioPin)
+{
+   
+   SX128x_Linux::PinConfig PinConfig;
+   
+   LastError[0] = '\0';
+   if (RadioStorage == NULL)
+   {
+      SaveError("Radio storage not allocated");
+      return false;
+   }
+   
+   if (Radio != NULL)
+   {
+      RADIO_RX_StopWatchdog();
+      RADIO_RX_StopReplay();
+      StopChannel();
+      RadioClosing.store(true, std::memory_order_release);
+      if (HwRadio != NULL)
+      {
+         HwRadio->~HwRadioDevice();
+      }
+      else
+      {
+         VirtualRadioDev->~VirtualRadioDevice();
+      }
+      RadioClosing.store(false, std::memory_order_release);
+      Radio   = NULL;
+      HwRadio = NULL;
+      VirtualRadioDev = NULL;
+   }
+   
+   PinConfig.busy  = RadioPin->Busy;
+   PinConfig.nrst  = RadioPin->Nrst;
+   PinConfig.nss   = RadioPin->Nss;
+   PinConfig.dio1  = RadioPin->Dio1;
+   PinConfig.dio2  = RadioPin->Dio2;
+   PinConfig.dio3  = RadioPin->Dio3;
+   PinConfig.tx_en = RadioPin->TxEn;
+   PinConfig.rx_en = RadioPin->RxEn;
+   
+   if (VchanMedium != NULL)
+   {
+      RX_VCHAN_Constructor(&Vchan, VchanMedium, &VchanModel, ChannelPhy);
+      VirtualRadioDev = new (RadioStorage) VirtualRadioDevice();
+      Radio = VirtualRadioDev;
+   }
+   else
+   {
+      HwRadio = new (RadioStorage) HwRadioDevice(SpiDevStr, SpiDevNum, PinConfig);
+      Radio   = HwRadio;
+   }
+   
+   Radio->callbacks.rxDone  = RxDoneCallback;
+   Radio->callbacks.rxError = RxErrorCallback;
+   Radio->callbacks.cadDone = CadDoneCallback;
+   Radio->callbacks.rxHeaderDone   = SniffWakeCallback;
+   Radio->callbacks.rxSyncWordDone = SniffWakeCallback;
+   
+   ScanState   = RADIO_RX_SCAN_IDLE;
+   SniffActive = false;
+   SetRxArmed(false);
+   
+   if (VirtualRadioDev != NULL)
+   {
+      VchanStop.store(false, std::memory_order_relaxed);
+      VchanTask = std::thread(VchanIrqs);
+   }
+   
+   return true;
+   
+} /* End CreateRadio() */
 
 
 /******************************************************************************
-** Function: RADIO_RX_SetRadioFrequency
+** Function: LockRadio
 **
-** Set the radio frequency
+** Lock the radio mutex from a thread that may be joined while it's held
 **
 ** Notes:
-**   1. Assumes Radio has been initialized and frequency (Hz) value has been
-**      validated 
+**   1. Returns false without the lock when the radio is being destroyed or
+**      the calling thread is being stopped, the caller must skip its radio
+**      access.
 **
 */
-bool RADIO_RX_SetRadioFrequency(uint32_t Frequency)
+static bool LockRadio(RadioLock_t &Lock)
 {
    
-   Radio->SetRfFrequency(Frequency);
+   while (!Lock.try_lock_for(std::chrono::milliseconds(1)))
+   {
+      if (RadioClosing.load(std::memory_order_acquire) ||
+          (RadioLockStop != NULL && RadioLockStop->load(std::memory_order_relaxed)))
+      {
+         return false;
+      }
+   }
    
    return true;
    
-} /* End RADIO_RX_SetRadioFrequency() */
+} /* End LockRadio() */
 
-}
-**********/
+
+/******************************************************************************
+** Function: SaveError
+**
+*/
+static void SaveError(const char *Error)
+{
+   
+   strncpy(LastError, Error, RADIO_RX_ERROR_LEN - 1);
+   LastError[RADIO_RX_ERROR_LEN - 1] = '\0';
+   
+} /* End SaveError() */
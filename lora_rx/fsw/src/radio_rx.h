@@ -29,11 +29,67 @@
 ** Includes
 */
 #include <stdint.h>
+#include "rx_frame.h"
+#include "rx_vchan.h"
 
 /***********************/
 /** Macro Definitions **/
 /***********************/
 
+#define RADIO_RX_MAX_FRAME_SLOTS  64   /* Slot counts must be a power of 2 */
+
+#define RADIO_RX_ERROR_LEN  64
+
+#define RADIO_RX_SPI_MAX_SPEED    18000000   /* SX128x datasheet SPI clock limit */
+#define RADIO_RX_SPI_TEST_LEN     255        /* Data buffer bytes per test pass */
+
+#define RADIO_RX_MIN_FREQ_MHZ  2400   /* SX128x 2.4 GHz ISM band */
+#define RADIO_RX_MAX_FREQ_MHZ  2500
+
+/*
+** Modulation values match the Mod field in the lora_rx.xml LoRa parameters
+*/
+
+#define RADIO_RX_MOD_LORA  0
+#define RADIO_RX_MOD_FLRC  1
+#define RADIO_RX_MOD_FSK   2   /* Not supported */
+
+#define RADIO_RX_FLRC_MAX_LEN  127   /* SX128x FLRC payload limit */
+
+#define RADIO_RX_SCAN_MAX_CHANNELS  16
+
+#define RADIO_RX_SCAN_IDLE      0
+#define RADIO_RX_SCAN_SCANNING  1
+#define RADIO_RX_SCAN_LOCKED    2
+
+/*
+** Radio watchdog faults, see RADIO_RX_StartWatchdog()
+*/
+
+#define RADIO_RX_FAULT_NONE      0
+#define RADIO_RX_FAULT_BUSY      1   /* BUSY stuck high */
+#define RADIO_RX_FAULT_NOT_RX    2   /* Radio left receive or stopped raising IRQs */
+#define RADIO_RX_FAULT_READBACK  3   /* Packet type readback doesn't match */
+#define RADIO_RX_FAULT_CNT       4
+
+#define RADIO_RX_WATCHDOG_POLL_MS  10
+
+#define RADIO_RX_VCHAN_POLL_US  1000   /* Virtual channel medium poll limit */
+
+/*
+** Radio profiles. A profile is compiled into the SX128x SPI commands that
+** configure it so switching profiles doesn't compute anything.
+*/
+
+#define RADIO_RX_PROFILE_NAME_LEN      16
+#define RADIO_RX_PROFILE_MAX_CMDS       8
+#define RADIO_RX_PROFILE_MAX_CMD_LEN    8   /* Opcode and parameters */
+#define RADIO_RX_BUILTIN_PROFILES       2
+
+#define RADIO_RX_WAIT_FOREVER  0xFFFFFFFF   /* RADIO_RX_WaitFrame() timeout */
+
+#define RADIO_RX_SNIFF_MAX_PERIOD_US  262140000   /* 0xFFFF 4 ms ticks */
+
 
 /**********************/
 /** Type Definitions **/
@@ -54,45 +110,525 @@ typedef struct
 } RADIO_RX_Pin_t;
 
 
+/*
+** A received frame is read from the radio directly into a slot by the radio
+** IRQ context and handed to the caller without copying. RxTimeNs is the
+** CLOCK_MONOTONIC_RAW time the frame ended, see RADIO_RX_SetRxTimeOffset().
+** A frame that failed its CRC is passed on with RADIO_RX_FRAME_CRC_ERR set
+** so its sender can be counted, its data can't be trusted.
+*/
+
+#define RADIO_RX_FRAME_CRC_ERR  0x01
+
+typedef struct
+{
+   int64_t  RxTimeNs;
+   uint8_t  Len;
+   int8_t   Rssi;    /* dBm, FLRC reports the RSSI at sync word detection */
+   int8_t   Snr;     /* dB, 0 for FLRC */
+   uint8_t  Flags;
+   uint8_t  Data[RX_FRAME_MAX_LEN];
+
+} RADIO_RX_Frame_t;
+
+
+/*
+** LoRa fields are used when Mod is RADIO_RX_MOD_LORA and FLRC fields when
+** it's RADIO_RX_MOD_FLRC. Values are SX128x register settings, see
+** SX128x.hpp.
+*/
+typedef struct
+{
+   char     Name[RADIO_RX_PROFILE_NAME_LEN];
+   uint8_t  Mod;
+   uint8_t  SpreadingFactor;   /* LoRa */
+   uint8_t  Bandwidth;         /* LoRa */
+   uint8_t  CodingRate;        /* LoRa or FLRC */
+   uint8_t  Crc;               /* LoRa 0=Off 1=On, FLRC 0=Off, 1-3=2-4 bytes */
+   uint8_t  Bitrate;           /* FLRC */
+   uint8_t  Shaping;           /* FLRC */
+   uint8_t  Spare;
+   uint16_t Frequency;         /* MHz, 0 leaves the frequency unchanged */
+   uint16_t Spare2;
+   uint32_t SyncWord;          /* FLRC, sent MSB first */
+   
+} RADIO_RX_ProfileDef_t;
+
+
+typedef struct
+{
+   uint8_t  Mod;
+   uint8_t  CmdCnt;
+   uint8_t  ModParam[3];       /* SetModulationParams parameters */
+   uint8_t  CmdLen[RADIO_RX_PROFILE_MAX_CMDS];
+   uint8_t  Cmd[RADIO_RX_PROFILE_MAX_CMDS][RADIO_RX_PROFILE_MAX_CMD_LEN];
+   
+} RADIO_RX_ProfileImage_t;
+
+
+/*
+** Time-on-air model for a profile. LoRa times follow the SX128x datasheet
+** packet duration formula for the frame format set by the profile (12
+** symbol preamble, explicit header). FLRC times count the 32 bit preamble
+** and sync word plus the coded header, payload and CRC.
+*/
+typedef struct
+{
+   uint32_t SymbolNs;     /* LoRa symbol time or FLRC bit time */
+   uint32_t PreambleUs;   /* Preamble and sync, the minimum to detect a frame */
+   uint32_t MaxFrameUs;   /* Time on air of a MaxFrameLen byte frame */
+   uint32_t BitRate;      /* Channel bits per second after coding */
+   uint16_t MaxFrameLen;  /* RX_FRAME_MAX_LEN or RADIO_RX_FLRC_MAX_LEN */
+   uint16_t Spare;
+   uint32_t RxDoneNs;     /* End of packet to RxDone IRQ, estimated */
+
+} RADIO_RX_Airtime_t;
+
+
+/*
+** Channel activity detection scan
+*/
+typedef struct
+{
+   uint32_t Frequency;         /* Hz */
+   uint8_t  SpreadingFactor;   /* SX128x.hpp RadioLoRaSpreadingFactors_t */
+   
+} RADIO_RX_ScanChannel_t;
+
+
+typedef struct
+{
+   uint8_t  State;        /* RADIO_RX_SCAN_* */
+   uint8_t  Channel;      /* Locked channel index, valid when LOCKED */
+   uint16_t Spare;
+   uint32_t StepCnt;      /* CAD operations */
+   uint32_t AcquireCnt;
+   uint32_t LastAcquireUs;   /* Time from scan start to detection */
+   uint32_t HitCnt[RADIO_RX_SCAN_MAX_CHANNELS];
+   
+} RADIO_RX_ScanStatus_t;
+
+
+/*
+** Duty-cycled sniff receive
+*/
+typedef struct
+{
+   uint8_t  Active;
+   uint8_t  Spare;
+   uint16_t DutyRatio;           /* Measured radio receive duty, x10000 */
+   uint32_t RxPeriodUs;          /* Programmed periods after tick rounding */
+   uint32_t SleepPeriodUs;
+   uint32_t WakeCnt;             /* Receptions started in a sniff window */
+   uint32_t WakeLatencyUs;       /* Last first-frame wake latency */
+   uint32_t MaxWakeLatencyUs;
+   uint32_t IrqCnt;              /* Host wakeups by the radio IRQ */
+   uint32_t ConsumerWakeCnt;     /* RADIO_RX_WaitFrame() returns */
+   
+} RADIO_RX_SniffStatus_t;
+
+
+typedef struct
+{
+   uint32_t RxDoneCnt;
+   uint32_t CrcErrCnt;
+   uint32_t HdrErrCnt;
+   uint32_t OverrunCnt;   /* Frames dropped because every slot was in use */
+
+} RADIO_RX_Status_t;
+
+
+typedef struct
+{
+   uint16_t SlotCnt;
+   uint16_t HighWater;    /* Most slots in use when a frame was read */
+
+} RADIO_RX_SlotStatus_t;
+
+
+/*
+** SPI cost. The Frame fields are sums over the transfers made by the
+** RxDone IRQs so the caller can average them over an interval.
+*/
+typedef struct
+{
+   uint32_t TransferCnt;
+   uint32_t ByteCnt;
+   uint64_t TransferNs;
+   uint64_t BusyNs;              /* BUSY waits before transfers */
+   uint32_t FrameCnt;            /* RxDone IRQs */
+   uint32_t FrameTransferCnt;
+   uint32_t FrameByteCnt;
+   uint64_t FrameNs;             /* Transfer and BUSY time */
+   uint64_t FrameBusyNs;
+   uint32_t LastFrameNs;
+
+} RADIO_RX_SpiStatus_t;
+
+
+typedef struct
+{
+   uint8_t  Active;
+   uint8_t  Spare[3];
+   uint32_t RecordCnt;
+   uint32_t ReplayCnt;
+   uint32_t MismatchCnt;
+   uint32_t SkipCnt;
+
+} RADIO_RX_ReplayStatus_t;
+
+
+/*
+** Radio watchdog. The recovery time is measured from the detection until
+** the caller has restored the configuration and restarted receiving.
+*/
+typedef struct
+{
+   uint8_t  Active;
+   uint8_t  LastFault;           /* RADIO_RX_FAULT_* */
+   uint8_t  Recovering;
+   uint8_t  Spare;
+   uint32_t ResetCnt;
+   uint32_t FaultCnt[RADIO_RX_FAULT_CNT];
+   uint32_t ProbeCnt;            /* Mode and readback checks of a quiet radio */
+   uint32_t LastRecoveryUs;
+   uint32_t MaxRecoveryUs;
+
+} RADIO_RX_WatchdogStatus_t;
+
+
+/*
+** SPI data buffer test at one clock speed
+*/
+typedef struct
+{
+   uint16_t PassCnt;
+   uint16_t FailPassCnt;    /* Passes with a readback or status error */
+   uint32_t ErrByteCnt;     /* Readback bytes that differ from the pattern */
+   uint32_t WriteNs;        /* Average buffer write time */
+   uint32_t ReadNs;         /* Average buffer read time */
+
+} RADIO_RX_SpiTest_t;
+
+
 /************************/
 /** Exported Functions **/
 /************************/
 
 
+/******************************************************************************
+** Function: RADIO_RX_Setup
+**
+** Allocate the radio object and frame slots from the receive arena
+**
+** Notes:
+**   1. This must be called once, after the arena is initialized and prior
+**      to any other function. See rx_mem.h.
+**   2. Returns false if SlotCnt isn't a power of 2 up to
+**      RADIO_RX_MAX_FRAME_SLOTS or the arena is exhausted. The radio
+**      can't be initialized until a setup succeeds.
+**
+*/
+bool RADIO_RX_Setup(uint16_t SlotCnt);
+
+
 /******************************************************************************
 ** Function: RADIO_RX_InitRadio
 **
 ** Initialize the Radio object to a known state
 **
 ** Notes:
-**   1. This must be called prior to any other function.
+**   1. The radio object is constructed in the storage allocated by
+**      RADIO_RX_Setup(). A previous radio object is destroyed first so
+**      reinitializing doesn't use more memory.
+**   2. Returns false if the SPI device or GPIO pins can't be opened, the
+**      reason is available from RADIO_RX_LastError().
 **
 */
 bool RADIO_RX_InitRadio(const char *SpiDevStr, uint8_t SpiDevNum, const RADIO_RX_Pin_t *RadioPin);
 
 
 /******************************************************************************
-** Function: RADIO_RX_SetLoraParams
+** Function: RADIO_RX_AttachRadio
 **
-** Set the radio Lora parameters
+** Connect to a radio that's already configured without resetting it
 **
 ** Notes:
-**   None
+**   1. Used for a warm restart. Returns false if the radio doesn't report
+**      a valid operating mode, in which case RADIO_RX_InitRadio() must be
+**      used.
+**   2. Pending interrupts are cleared. The caller must restore the
+**      modulation and frequency and restart receiving because the bridge
+**      state doesn't survive a restart.
+**
+*/
+bool RADIO_RX_AttachRadio(const char *SpiDevStr, uint8_t SpiDevNum, const RADIO_RX_Pin_t *RadioPin);
+
+
+/******************************************************************************
+** Function: RADIO_RX_LastError
+**
+** Return why the last radio initialization or attach failed
+**
+*/
+const char *RADIO_RX_LastError(void);
+
+
+/******************************************************************************
+** Function: RADIO_RX_Lock
+**
+** Lock the radio for a sequence of radio functions
+**
+** Notes:
+**   1. Each radio function locks the radio itself. Holding the lock keeps a
+**      reconfiguration that takes several calls from interleaving with the
+**      IRQ context, the watchdog and the other task. It's recursive and
+**      each call must be matched by RADIO_RX_Unlock().
+**   2. Don't hold it across RADIO_RX_WaitFrame(), frames are read under
+**      the lock.
+**
+*/
+void RADIO_RX_Lock(void);
+
+
+/******************************************************************************
+** Function: RADIO_RX_Unlock
+**
+*/
+void RADIO_RX_Unlock(void);
+
+
+/******************************************************************************
+** Function: RADIO_RX_GetSlotStatus
+**
+*/
+void RADIO_RX_GetSlotStatus(RADIO_RX_SlotStatus_t *Status);
+
+
+/******************************************************************************
+** Function: RADIO_RX_CompileProfile
+**
+** Validate a profile definition and encode it as an SX128x command image
+**
+** Notes:
+**   1. Returns false if a parameter isn't a valid SX128x setting for the
+**      profile's modulation. The image is unchanged.
+**   2. Doesn't access the radio so it can be used before the radio is
+**      initialized.
+**
+*/
+bool RADIO_RX_CompileProfile(const RADIO_RX_ProfileDef_t *Def, RADIO_RX_ProfileImage_t *Image);
+
+
+/******************************************************************************
+** Function: RADIO_RX_GetBuiltinProfile
+**
+** Copy a profile that's compiled into the bridge
+**
+** Notes:
+**   1. Returns false if Index >= RADIO_RX_BUILTIN_PROFILES.
+**
+*/
+bool RADIO_RX_GetBuiltinProfile(uint8_t Index, RADIO_RX_ProfileDef_t *Def, RADIO_RX_ProfileImage_t *Image);
+
+
+/******************************************************************************
+** Function: RADIO_RX_ApplyProfile
+**
+** Send a compiled profile to the radio
+**
+** Notes:
+**   1. The commands are written back to back with no parameter processing.
+**   2. Leaves the radio in standby, RADIO_RX_StartRx() or
+**      RADIO_RX_StartSniff() must be called to resume receiving.
+**
+*/
+bool RADIO_RX_ApplyProfile(const RADIO_RX_ProfileImage_t *Image);
+
+
+/******************************************************************************
+** Function: RADIO_RX_GetAirtime
+**
+** Get the time-on-air model for a profile definition
+**
+** Notes:
+**   1. Returns false if the definition isn't valid. The frequency isn't
+**      used.
+**   2. The symbol times and maximum frame times are compile time tables
+**      so this doesn't do any arithmetic beyond a lookup.
+**
+*/
+bool RADIO_RX_GetAirtime(const RADIO_RX_ProfileDef_t *Def, RADIO_RX_Airtime_t *Airtime);
+
+
+/******************************************************************************
+** Function: RADIO_RX_FrameAirtimeUs
+**
+** Return the time on air of a FrameLen byte frame
+**
+** Notes:
+**   1. Returns 0 if the definition isn't valid.
+**   2. Cheap enough to call for every received frame.
 **
 */
-bool RADIO_RX_SetLoraParams(uint8_t SpreadingFactor,
-                            uint8_t Bandwidth,
-                            uint8_t CodingRate,
-                            uint8_t TCXO;
-                            uint8_t HSM,
-                            uint8_t Power,
-                            uint8_t Mod,
-                            uint8_t CRC,
-                            uint8_t LDRO,
-                            uint8_t Node,
-                            uint8_t Dest,
-                            uint8_t TXPA,
-                            uint8_t RXLNA);
+uint32_t RADIO_RX_FrameAirtimeUs(const RADIO_RX_ProfileDef_t *Def, uint16_t FrameLen);
+
+
+/******************************************************************************
+** Function: RADIO_RX_RawTimeNs
+**
+** Return the CLOCK_MONOTONIC_RAW time used for frame timestamps
+**
+*/
+int64_t RADIO_RX_RawTimeNs(void);
+
+
+/******************************************************************************
+** Function: RADIO_RX_SetRxTimeOffset
+**
+** Set the time subtracted from the RxDone IRQ time to get the end of packet
+**
+** Notes:
+**   1. The IRQ time is captured when the radio IRQ thread reads the IRQ
+**      status after the DIO1 edge, before any other SPI traffic.
+**   2. The offset is the modulation's RxDone latency plus a calibration
+**      for the DIO1 to IRQ thread delay. It's applied in the IRQ context
+**      so each frame's RxTimeNs is already corrected.
+**
+*/
+void RADIO_RX_SetRxTimeOffset(int32_t OffsetNs);
+
+
+/******************************************************************************
+** Function: RADIO_RX_GetSpiStatus
+**
+** Notes:
+**   1. Every transfer is also passed to the SPI recorder, see spi_rec.h.
+**
+*/
+void RADIO_RX_GetSpiStatus(RADIO_RX_SpiStatus_t *Status);
+
+
+/******************************************************************************
+** Function: RADIO_RX_StartReplay
+**
+** Replay a recording in place of the radio
+**
+** Notes:
+**   1. Buf is an SPI recorder file image and must stay valid until the
+**      replay ends. 
+**   2. A replay thread reissues the recorded IRQs with their recorded
+**      spacing. Every transfer is answered from the recording instead of
+**      the radio so the IRQ callbacks see the captured traffic.
+**   3. Radio commands shouldn't be sent during a replay because their
+**      transfers consume recorded transfers.
+**   4. Returns false if the recording is invalid or a replay is running.
+**
+*/
+bool RADIO_RX_StartReplay(const uint8_t *Buf, uint32_t Len);
+
+
+/******************************************************************************
+** Function: RADIO_RX_StopReplay
+**
+*/
+void RADIO_RX_StopReplay(void);
+
+
+/******************************************************************************
+** Function: RADIO_RX_GetReplayStatus
+**
+*/
+void RADIO_RX_GetReplayStatus(RADIO_RX_ReplayStatus_t *Status);
+
+
+/******************************************************************************
+** Function: RADIO_RX_StartWatchdog
+**
+** Start the radio watchdog thread
+**
+** Notes:
+**   1. Every RADIO_RX_WATCHDOG_POLL_MS the thread checks for:
+**      - A BUSY wait that has lasted longer than BusyTimeoutUs.
+**      - No IRQ for RxSilenceMs while receiving continuously or scanning.
+**        A quiet channel is normal in continuous receive so the radio is
+**        probed: its status must report RX and its packet type must
+**        match the applied profile. A scan raises a CAD IRQ every few
+**        symbols so silence alone is a fault.
+**      Sniff mode is only checked for BUSY, a probe would wake the radio
+**      out of its duty cycle.
+**   2. A fault is recovered by pulsing Nrst, putting the radio in standby
+**      and aborting the consumer's wait. The caller must then restore the
+**      configuration, restart receiving and call RADIO_RX_EndRecovery().
+**      No checks are made until it does.
+**   3. A BusyTimeoutUs of 0 disables the BUSY check and an RxSilenceMs of
+**      0 disables the receive checks.
+**   4. The watchdog is stopped when the radio is reinitialized and
+**      doesn't check anything during a replay.
+**
+*/
+bool RADIO_RX_StartWatchdog(uint32_t BusyTimeoutUs, uint32_t RxSilenceMs);
+
+
+/******************************************************************************
+** Function: RADIO_RX_StopWatchdog
+**
+*/
+void RADIO_RX_StopWatchdog(void);
+
+
+/******************************************************************************
+** Function: RADIO_RX_RecoveryPending
+**
+** Return true if the watchdog reset the radio and is waiting for the
+** configuration to be restored
+**
+*/
+bool RADIO_RX_RecoveryPending(void);
+
+
+/******************************************************************************
+** Function: RADIO_RX_EndRecovery
+**
+** Record the recovery time and resume the watchdog checks
+**
+*/
+void RADIO_RX_EndRecovery(void);
+
+
+/******************************************************************************
+** Function: RADIO_RX_GetWatchdogStatus
+**
+*/
+void RADIO_RX_GetWatchdogStatus(RADIO_RX_WatchdogStatus_t *Status);
+
+
+/******************************************************************************
+** Function: RADIO_RX_SetChannel
+**
+** Select the virtual RF channel medium the radio is created on
+**
+** Notes:
+**   1. Must be called before RADIO_RX_InitRadio() or RADIO_RX_AttachRadio()
+**      which then create a virtual SX128x on the shared memory medium
+**      instead of opening the SPI device and pins. See rx_vchan.h.
+**   2. A NULL or empty MediumName selects the SX128x hardware. Returns
+**      false if the medium can't be opened, the hardware is used in that
+**      case.
+**   3. Model sets the channel impairments applied to received frames.
+**
+*/
+bool RADIO_RX_SetChannel(const char *MediumName, const RX_VCHAN_Model_t *Model);
+
+
+/******************************************************************************
+** Function: RADIO_RX_GetChannelStats
+**
+** Copy the virtual channel counters, returns false if the radio isn't
+** virtual
+**
+*/
+bool RADIO_RX_GetChannelStats(RX_VCHAN_Stats_t *Stats);
 
 
 /******************************************************************************
@@ -119,4 +655,215 @@ bool RADIO_RX_SetRadioFrequency(uint32_t Frequency);
 bool RADIO_RX_SetSpiSpeed(uint32_t SpiSpeed);
 
 
+/******************************************************************************
+** Function: RADIO_RX_TestSpiSpeed
+**
+** Write and read back test patterns through the radio data buffer
+**
+** Notes:
+**   1. Assumes Radio has been initialized. The radio is put in standby
+**      first because the patterns overwrite the receive buffer, the
+**      caller must restart receiving.
+**   2. The speed is left at SpiSpeed.
+**   3. Passes cycle through alternating bits, walking ones, walking zeros
+**      and a pseudo-random sequence. Each pass also checks that the
+**      status byte still reports standby.
+**
+*/
+void RADIO_RX_TestSpiSpeed(uint32_t SpiSpeed, uint16_t Passes, RADIO_RX_SpiTest_t *Test);
+
+
+/******************************************************************************
+** Function: RADIO_RX_StartRx
+**
+** Enable the receive interrupts and put the radio in continuous receive mode
+**
+** Notes:
+**   1. Modulation and packet parameters must be set before calling.
+**
+*/
+bool RADIO_RX_StartRx(void);
+
+
+/******************************************************************************
+** Function: RADIO_RX_StartSniff
+**
+** Put the radio in duty-cycled receive using SetRxDutyCycle
+**
+** Notes:
+**   1. The radio alternates between RxPeriodUs of receive and SleepPeriodUs
+**      of sleep on its own. The host isn't interrupted until a LoRa header
+**      or FLRC sync word is detected, so a RADIO_RX_WaitFrame() caller can
+**      block indefinitely while sniffing.
+**   2. The periods are rounded down to the smallest SX128x tick size that
+**      can represent both. Returns false if either period is 0 or greater
+**      than RADIO_RX_SNIFF_MAX_PERIOD_US.
+**   3. RADIO_RX_StartRx() and RADIO_RX_StartScan() end sniffing.
+**   4. Modulation and packet parameters must be set before calling.
+**
+*/
+bool RADIO_RX_StartSniff(uint32_t RxPeriodUs, uint32_t SleepPeriodUs);
+
+
+/******************************************************************************
+** Function: RADIO_RX_GetSniffStatus
+**
+** Notes:
+**   1. The wake latency is measured from the radio interrupt that starts a
+**      reception to the consumer receiving the frame, for frames that
+**      arrive while the consumer is blocked.
+**   2. The duty ratio combines the programmed receive window ratio with
+**      the time spent receiving frames since sniffing started.
+**   3. The IRQ and consumer wake counts are maintained in every receive
+**      mode so sniffing can be compared with continuous receive.
+**
+*/
+void RADIO_RX_GetSniffStatus(RADIO_RX_SniffStatus_t *Status);
+
+
+/******************************************************************************
+** Function: RADIO_RX_StartScan
+**
+** Cycle through a list of frequency/spreading factor pairs using channel
+** activity detection and switch to continuous receive on the first
+** detection
+**
+** Notes:
+**   1. The scan runs in the radio IRQ context. Each CAD done interrupt
+**      either retunes to the next channel and starts another CAD or locks
+**      onto the channel, so no host task is involved in a step.
+**   2. The LoRa bandwidth and coding rate are the ones from the last
+**      applied LoRa profile. Returns false if the radio isn't in
+**      LoRa mode or the channel list is empty or too long.
+**   3. CadSymbols is the number of symbols per CAD (1, 2, 4, 8 or 16).
+**   4. Hit counts are cleared when the channel list changes.
+**
+*/
+bool RADIO_RX_StartScan(const RADIO_RX_ScanChannel_t *Channel, uint8_t ChannelCnt, uint8_t CadSymbols);
+
+
+/******************************************************************************
+** Function: RADIO_RX_RestartScan
+**
+** Restart the scan with the channel list from the last RADIO_RX_StartScan()
+**
+*/
+bool RADIO_RX_RestartScan(void);
+
+
+/******************************************************************************
+** Function: RADIO_RX_StopScan
+**
+** Notes:
+**   1. Leaves the radio in standby. The caller must restore the modulation
+**      and frequency and call RADIO_RX_StartRx().
+**
+*/
+void RADIO_RX_StopScan(void);
+
+
+/******************************************************************************
+** Function: RADIO_RX_GetScanStatus
+**
+*/
+void RADIO_RX_GetScanStatus(RADIO_RX_ScanStatus_t *Status);
+
+
+/******************************************************************************
+** Function: RADIO_RX_StartSweep
+**
+** Prepare the radio for RSSI sweeps
+**
+** Notes:
+**   1. Stops receiving frames: the radio is left in continuous receive
+**      with its interrupts disabled so the RSSI can be read at any
+**      frequency. Receiving must be restarted after the sweeps.
+**
+*/
+void RADIO_RX_StartSweep(void);
+
+
+/******************************************************************************
+** Function: RADIO_RX_SweepRssi
+**
+** Sample the instantaneous RSSI at StepCnt frequencies starting at StartHz
+**
+** Notes:
+**   1. RADIO_RX_StartSweep() must have been called.
+**   2. Rssi[i] is the raw SX128x RSSI at StartHz + i*StepHz, -2 times the
+**      power in dBm.
+**   3. Each step is a frequency command, a receive command, a spin of
+**      SettleUs on the raw clock and an RSSI read. Returns the sweep time
+**      in nanoseconds.
+**
+*/
+uint64_t RADIO_RX_SweepRssi(uint32_t StartHz, uint32_t StepHz, uint16_t StepCnt,
+                            uint32_t SettleUs, uint8_t *Rssi);
+
+
+/******************************************************************************
+** Function: RADIO_RX_WaitFrame
+**
+** Wait up to TimeoutMs for a received frame
+**
+** Notes:
+**   1. Returns a pointer to the oldest filled slot or NULL if the timeout
+**      expired. The slot remains owned by the caller until
+**      RADIO_RX_ReleaseFrame() is called so the caller may process the
+**      frame in place.
+**   2. Only one task may consume frames.
+**   3. A TimeoutMs of RADIO_RX_WAIT_FOREVER blocks until a frame arrives
+**      or RADIO_RX_AbortWait() is called.
+**
+*/
+RADIO_RX_Frame_t *RADIO_RX_WaitFrame(uint32_t TimeoutMs);
+
+
+/******************************************************************************
+** Function: RADIO_RX_AbortWait
+**
+** Make a blocked RADIO_RX_WaitFrame() return NULL
+**
+** Notes:
+**   1. Used when the receive mode changes so the consumer can switch from
+**      an unbounded wait to a timed wait.
+**
+*/
+void RADIO_RX_AbortWait(void);
+
+
+/******************************************************************************
+** Function: RADIO_RX_ReleaseFrame
+**
+** Return the slot obtained from RADIO_RX_WaitFrame() to the radio
+**
+*/
+void RADIO_RX_ReleaseFrame(void);
+
+
+/******************************************************************************
+** Function: RADIO_RX_GetStatus
+**
+** Copy the receive counters maintained by the radio IRQ context
+**
+*/
+void RADIO_RX_GetStatus(RADIO_RX_Status_t *Status);
+
+
+/******************************************************************************
+** Function: RADIO_RX_RestoreStatus
+**
+** Load the receive counters, used to continue counting after a restart
+**
+*/
+void RADIO_RX_RestoreStatus(const RADIO_RX_Status_t *Status);
+
+
+/******************************************************************************
+** Function: RADIO_RX_ResetStatus
+**
+*/
+void RADIO_RX_ResetStatus(void);
+
+
 #endif /* _radio_rx_ */
@@ -0,0 +1,758 @@
+/*
+**  This program is free software: you can redistribute it and/or modify
+**  it under the terms of the GNU Lesser General Public License as
+**  published by the Free Software Foundation, either version 3 of the
+**  License, or (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Lesser General Public License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public License
+**  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+**
+**  Purpose:
+**    Implement the receive core, the cFS independent frame pipeline
+**
+**  Notes:
+**    1. See rx_core.h for details.
+**
+*/
+
+/*
+** Include Files:
+*/
+
+#include <string.h>
+#include <time.h>
+#include "rx_core.h"
+#include "rx_evt.h"
+#include "rx_tap.h"
+#include "rx_trace.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define POOL_WAIT_MS  100   /* Bound on each wait for the oldest decode job */
+
+
+/*******************************/
+/** Local Function Prototypes **/
+/*******************************/
+
+static bool ScreenFrame(RX_CORE_Class_t *Core, const RADIO_RX_Frame_t *Frame);
+static bool AcceptFrame(RX_CORE_Class_t *Core, const RADIO_RX_Frame_t *Frame);
+static void RouteFrame(RX_CORE_Class_t *Core, const RADIO_RX_Frame_t *Frame,
+                       const uint8_t *Data, uint16_t DataLen, const RX_CORE_Job_t *Job);
+static bool Decompress(RX_CORE_Class_t *Core, const uint8_t *Data, uint16_t DataLen,
+                       const RX_CORE_Job_t *Job, const uint8_t **Out, uint16_t *OutLen);
+static void WriteDecompressed(RX_CORE_Class_t *Core, const uint8_t *Data, uint16_t DataLen,
+                              uint8_t Fhp, bool SeqGap, const RX_CORE_Job_t *Job);
+static void DispatchPayload(RX_CORE_Class_t *Core, const RADIO_RX_Frame_t *Frame,
+                            const uint8_t *Data, uint16_t DataLen, const RX_CORE_Job_t *Job);
+static void SubmitJob(RX_CORE_Class_t *Core, const RADIO_RX_Frame_t *Frame);
+static void DecodeJob(void *Ctx, uint32_t Slot);
+static void FinishJob(RX_CORE_Class_t *Core, RX_CORE_Job_t *Job);
+static void RetireJobs(RX_CORE_Class_t *Core);
+static void WakeReceiver(void *Ctx);
+static int64_t SteadyNs(void);
+
+
+/******************************************************************************
+** Function: RX_CORE_Constructor
+**
+*/
+void RX_CORE_Constructor(RX_CORE_Class_t *Core, const RX_CORE_Backend_t *Backend,
+                         RX_CORE_FrameFunc_t FrameFunc, void *FrameCtx)
+{
+
+   memset(Core, 0, sizeof(RX_CORE_Class_t));
+
+   Core->FrameFunc = FrameFunc;
+   Core->FrameCtx  = FrameCtx;
+   if (Backend != NULL)
+   {
+      Core->Backend      = *Backend;
+      Core->BackendValid = true;
+   }
+
+   RX_SEQ_Constructor(&Core->SeqTrk);
+   RX_LINK_Constructor(&Core->Link, RX_LINK_DEF_EWMA_SHIFT);
+   RX_PAYLOAD_Constructor(&Core->Payload, NULL, NULL);
+   RX_POOL_Constructor(&Core->Pool);
+
+} /* End RX_CORE_Constructor() */
+
+
+/******************************************************************************
+** Function: RX_CORE_StartPool
+**
+*/
+bool RX_CORE_StartPool(RX_CORE_Class_t *Core, uint8_t WorkerCnt, RX_CORE_Job_t *Job, uint16_t Depth)
+{
+
+   if (Job == NULL)
+   {
+      return false;
+   }
+
+   Core->Job = Job;
+
+   return RX_POOL_Start(&Core->Pool, WorkerCnt, Depth, DecodeJob, WakeReceiver, Core);
+
+} /* End RX_CORE_StartPool() */
+
+
+/******************************************************************************
+** Function: RX_CORE_SetAddress
+**
+*/
+void RX_CORE_SetAddress(RX_CORE_Class_t *Core, uint8_t Dest, uint8_t Node)
+{
+
+   Core->Dest = Dest;
+   Core->Node = Node;
+
+} /* End RX_CORE_SetAddress() */
+
+
+/******************************************************************************
+** Function: RX_CORE_ResyncUplink
+**
+*/
+void RX_CORE_ResyncUplink(RX_CORE_Class_t *Core)
+{
+
+   Core->UplinkSeqValid = false;
+
+} /* End RX_CORE_ResyncUplink() */
+
+
+/******************************************************************************
+** Function: RX_CORE_WaitFrame
+**
+*/
+RADIO_RX_Frame_t *RX_CORE_WaitFrame(RX_CORE_Class_t *Core, uint32_t TimeoutMs)
+{
+
+   RADIO_RX_Frame_t *Frame;
+   uint32_t Slot;
+
+   if (Core->Pool.Running)
+   {
+      RetireJobs(Core);
+      if (RX_SEC_SyncPending(&Core->Sec) && !RX_POOL_Idle(&Core->Pool))
+      {
+         RX_POOL_WaitReady(&Core->Pool, TimeoutMs, &Slot);
+         RetireJobs(Core);
+         if (RX_POOL_Idle(&Core->Pool))
+         {
+            RX_SEC_Sync(&Core->Sec);
+         }
+         return NULL;
+      }
+   }
+
+   if (!Core->BackendValid)
+   {
+      return NULL;
+   }
+
+   RX_TRACE_Begin(RX_TRACE_TASK_CHILD, RX_TRACE_WAIT, 0);
+   Frame = Core->Backend.WaitFunc(Core->Backend.Ctx, TimeoutMs);
+   RX_TRACE_End(RX_TRACE_TASK_CHILD, RX_TRACE_WAIT, (Frame != NULL) ? Frame->Len : 0);
+
+   if (Core->Pool.Running)
+   {
+      RetireJobs(Core);
+   }
+   if (RX_POOL_Idle(&Core->Pool))
+   {
+      RX_SEC_Sync(&Core->Sec);
+   }
+
+   return Frame;
+
+} /* End RX_CORE_WaitFrame() */
+
+
+/******************************************************************************
+** Function: RX_CORE_ReleaseFrame
+**
+*/
+void RX_CORE_ReleaseFrame(RX_CORE_Class_t *Core)
+{
+
+   if (Core->BackendValid)
+   {
+      Core->Backend.ReleaseFunc(Core->Backend.Ctx);
+   }
+
+} /* End RX_CORE_ReleaseFrame() */
+
+
+/******************************************************************************
+** Function: RX_CORE_ProcessFrame
+**
+** Notes:
+**   1. Frames addressed to this receiver are counted and frames from the
+**      uplink node are passed to the deframer. See rx_frame.h for the
+**      frame format.
+**   2. The transmitter compresses before it encrypts so compressed frames
+**      are decompressed after the security stage.
+**
+*/
+void RX_CORE_ProcessFrame(RX_CORE_Class_t *Core, RADIO_RX_Frame_t *Frame)
+{
+
+   const uint8_t *Data;
+   uint16_t DataLen;
+   RX_SEC_Status_Enum_t SecStatus;
+
+   if (!ScreenFrame(Core, Frame))
+   {
+      return;
+   }
+
+   if (Core->Pool.Running)
+   {
+      SubmitJob(Core, Frame);
+      return;
+   }
+
+   if (Frame->Data[RX_FRAME_FLAGS_OFFSET] & RX_FRAME_FLAG_SECURE)
+   {
+      RX_TRACE_Begin(RX_TRACE_TASK_CHILD, RX_TRACE_SEC, Frame->Len);
+      SecStatus = RX_SEC_Verify(&Core->Sec, Frame->Data, Frame->Len, &DataLen);
+      RX_TRACE_End(RX_TRACE_TASK_CHILD, RX_TRACE_SEC, Frame->Len);
+      if (SecStatus != RX_SEC_OK)
+      {
+         return;
+      }
+      Data = &Frame->Data[RX_FRAME_HDR_LEN + RX_SEC_HDR_LEN];
+   }
+   else if (Core->SecRequired)
+   {
+      RX_EVT_COUNT(Core->Stats.InsecureCnt);
+      return;
+   }
+   else
+   {
+      Data    = &Frame->Data[RX_FRAME_HDR_LEN];
+      DataLen = Frame->Len - RX_FRAME_HDR_LEN;
+   }
+
+   RouteFrame(Core, Frame, Data, DataLen, NULL);
+
+} /* End RX_CORE_ProcessFrame() */
+
+
+/******************************************************************************
+** Function: RX_CORE_Poll
+**
+*/
+bool RX_CORE_Poll(RX_CORE_Class_t *Core, uint32_t TimeoutMs)
+{
+
+   RADIO_RX_Frame_t *Frame = RX_CORE_WaitFrame(Core, TimeoutMs);
+
+   if (Frame == NULL)
+   {
+      return false;
+   }
+
+   RX_CORE_ProcessFrame(Core, Frame);
+   RX_CORE_ReleaseFrame(Core);
+
+   return true;
+
+} /* End RX_CORE_Poll() */
+
+
+/******************************************************************************
+** Function: RX_CORE_Flush
+**
+*/
+void RX_CORE_Flush(RX_CORE_Class_t *Core)
+{
+
+   uint32_t Slot;
+
+   while (!RX_POOL_Idle(&Core->Pool))
+   {
+      RX_POOL_WaitReady(&Core->Pool, POOL_WAIT_MS, &Slot);
+      RetireJobs(Core);
+   }
+
+} /* End RX_CORE_Flush() */
+
+
+/******************************************************************************
+** Function: RX_CORE_ResetStatus
+**
+*/
+void RX_CORE_ResetStatus(RX_CORE_Class_t *Core)
+{
+
+   memset(&Core->Stats, 0, sizeof(RX_CORE_Stats_t));
+   RX_SEC_ResetStatus(&Core->Sec);
+   RX_SEQ_ResetStatus(&Core->SeqTrk);
+   RX_LINK_ResetStatus(&Core->Link);
+   RX_PAYLOAD_ResetStatus(&Core->Payload);
+   RX_POOL_ResetStatus(&Core->Pool);
+   RX_DECOMP_ResetStatus(&Core->Decomp);
+   CCSDS_DEFRAMER_ResetStatus(&Core->Deframer);
+   Core->DecompLastNs = 0;
+   Core->DecompMaxNs  = 0;
+
+} /* End RX_CORE_ResetStatus() */
+
+
+/******************************************************************************
+** Function: ScreenFrame
+**
+** Tap a received frame and return true if it's accepted for processing
+**
+** Notes:
+**   1. A CRC errored frame is only counted against its sender's link
+**      statistics.
+**
+*/
+static bool ScreenFrame(RX_CORE_Class_t *Core, const RADIO_RX_Frame_t *Frame)
+{
+
+   bool Accepted;
+
+   if (Frame->Flags & RADIO_RX_FRAME_CRC_ERR)
+   {
+      RX_TAP_Write(Frame->Data, Frame->Len, Frame->RxTimeNs, Frame->Rssi, Frame->Snr, RX_TAP_FLAG_CRC_ERR);
+      if (Frame->Len > RX_FRAME_NODE_OFFSET)
+      {
+         RX_LINK_CrcError(&Core->Link, Frame->Data[RX_FRAME_NODE_OFFSET]);
+      }
+      return false;
+   }
+
+   RX_TRACE_Begin(RX_TRACE_TASK_CHILD, RX_TRACE_FILTER, Frame->Len);
+   Accepted = AcceptFrame(Core, Frame);
+   RX_TRACE_End(RX_TRACE_TASK_CHILD, RX_TRACE_FILTER, Frame->Len);
+   RX_TAP_Write(Frame->Data, Frame->Len, Frame->RxTimeNs, Frame->Rssi, Frame->Snr,
+                Accepted ? RX_TAP_FLAG_ACCEPTED : 0);
+   if (!Accepted)
+   {
+      return false;
+   }
+
+   Core->Stats.FrameCnt++;
+   if (Core->FrameFunc != NULL)
+   {
+      Core->FrameFunc(Core->FrameCtx, Frame);
+   }
+
+   return true;
+
+} /* End ScreenFrame() */
+
+
+/******************************************************************************
+** Function: AcceptFrame
+**
+** Return true if the frame is long enough and addressed to this receiver
+**
+*/
+static bool AcceptFrame(RX_CORE_Class_t *Core, const RADIO_RX_Frame_t *Frame)
+{
+
+   const uint8_t *Hdr = Frame->Data;
+
+   if (Frame->Len <= RX_FRAME_HDR_LEN)
+   {
+      RX_EVT_COUNT(Core->Stats.ShortFrameCnt);
+      return false;
+   }
+
+   if (Hdr[RX_FRAME_DEST_OFFSET] != Core->Dest &&
+       Hdr[RX_FRAME_DEST_OFFSET] != RX_FRAME_BROADCAST)
+   {
+      RX_EVT_COUNT(Core->Stats.DestFilterCnt);
+      return false;
+   }
+
+   return true;
+
+} /* End AcceptFrame() */
+
+
+/******************************************************************************
+** Function: RouteFrame
+**
+** Track a frame that passed the security stage and route its data field
+**
+** Notes:
+**   1. Job is the decode pool job that holds the frame or NULL.
+**
+*/
+static void RouteFrame(RX_CORE_Class_t *Core, const RADIO_RX_Frame_t *Frame,
+                       const uint8_t *Data, uint16_t DataLen, const RX_CORE_Job_t *Job)
+{
+
+   const uint8_t *Hdr = Frame->Data;
+   bool SeqGap;
+
+   RX_SEQ_Update(&Core->SeqTrk, Hdr[RX_FRAME_NODE_OFFSET], Hdr[RX_FRAME_SEQ_OFFSET]);
+   RX_LINK_Update(&Core->Link, Hdr[RX_FRAME_NODE_OFFSET], Hdr[RX_FRAME_SEQ_OFFSET], Frame->Len,
+                  Frame->Rssi, Frame->Snr, Frame->RxTimeNs);
+
+   if (Hdr[RX_FRAME_NODE_OFFSET] != Core->Node)
+   {
+      if (RX_FRAME_TYPE(Hdr[RX_FRAME_FLAGS_OFFSET]) == RX_FRAME_TYPE_RELAY)
+      {
+         DispatchPayload(Core, Frame, Data, DataLen, Job);
+      }
+      else
+      {
+         RX_EVT_COUNT(Core->Stats.NodeFilterCnt);
+      }
+      return;
+   }
+
+   SeqGap = true;
+   if (Core->UplinkSeqValid)
+   {
+      SeqGap = (Hdr[RX_FRAME_SEQ_OFFSET] != (uint8_t)(Core->UplinkSeq + 1));
+      if (SeqGap)
+      {
+         RX_EVT_COUNT(Core->Stats.SeqGapCnt);
+      }
+   }
+   Core->UplinkSeq      = Hdr[RX_FRAME_SEQ_OFFSET];
+   Core->UplinkSeqValid = true;
+   Core->GoodputByteCnt += DataLen;
+
+   if (RX_FRAME_TYPE(Hdr[RX_FRAME_FLAGS_OFFSET]) != RX_FRAME_TYPE_PACKETS)
+   {
+      DispatchPayload(Core, Frame, Data, DataLen, Job);
+   }
+   else if (Hdr[RX_FRAME_FLAGS_OFFSET] & RX_FRAME_FLAG_COMPRESSED)
+   {
+      WriteDecompressed(Core, Data, DataLen, Hdr[RX_FRAME_FHP_OFFSET], SeqGap, Job);
+   }
+   else
+   {
+      RX_TRACE_Begin(RX_TRACE_TASK_CHILD, RX_TRACE_DEFRAME, DataLen);
+      CCSDS_DEFRAMER_Write(&Core->Deframer, Data, DataLen, Hdr[RX_FRAME_FHP_OFFSET], SeqGap);
+      RX_TRACE_End(RX_TRACE_TASK_CHILD, RX_TRACE_DEFRAME, DataLen);
+   }
+
+} /* End RouteFrame() */
+
+
+/******************************************************************************
+** Function: Decompress
+**
+** Decompress a frame's data field and time it
+**
+** Notes:
+**   1. A job decompressed by a decode worker is only counted. Otherwise
+**      the data is decompressed into the decompression stage's output
+**      buffer.
+**
+*/
+static bool Decompress(RX_CORE_Class_t *Core, const uint8_t *Data, uint16_t DataLen,
+                       const RX_CORE_Job_t *Job, const uint8_t **Out, uint16_t *OutLen)
+{
+
+   RX_DECOMP_Status_Enum_t DecompStatus;
+   int64_t StartNs;
+
+   if (Job != NULL && Job->Decompressed)
+   {
+      DecompStatus = Job->DecompStatus;
+      RX_DECOMP_Account(&Core->Decomp, DecompStatus, DataLen, Job->OutLen);
+      Core->DecompLastNs = Job->DecompNs;
+      *Out    = Job->Out;
+      *OutLen = Job->OutLen;
+   }
+   else
+   {
+      RX_TRACE_Begin(RX_TRACE_TASK_CHILD, RX_TRACE_DECOMP, DataLen);
+      StartNs = SteadyNs();
+      DecompStatus = RX_DECOMP_Frame(&Core->Decomp, Data, DataLen, OutLen);
+      Core->DecompLastNs = (uint32_t)(SteadyNs() - StartNs);
+      RX_TRACE_End(RX_TRACE_TASK_CHILD, RX_TRACE_DECOMP, DataLen);
+      *Out = Core->Decomp.Out;
+   }
+
+   if (Core->DecompLastNs > Core->DecompMaxNs)
+   {
+      Core->DecompMaxNs = Core->DecompLastNs;
+   }
+
+   return (DecompStatus == RX_DECOMP_OK);
+
+} /* End Decompress() */
+
+
+/******************************************************************************
+** Function: WriteDecompressed
+**
+** Decompress a frame's data field and pass it to the deframer
+**
+** Notes:
+**   1. The decompressed data is written in frame data field sized pieces
+**      so the deframer's ring is sized the same as it is for uncompressed
+**      frames. The FHP is relative to the decompressed data and is passed
+**      with the piece that contains it.
+**   2. A frame that fails to decompress is treated as lost so the
+**      deframer drops any partial packet when the next frame arrives.
+**
+*/
+static void WriteDecompressed(RX_CORE_Class_t *Core, const uint8_t *Data, uint16_t DataLen,
+                              uint8_t Fhp, bool SeqGap, const RX_CORE_Job_t *Job)
+{
+
+   const uint8_t *Out;
+   uint16_t OutLen;
+   uint16_t Offset;
+   uint16_t PieceLen;
+   uint8_t  PieceFhp;
+
+   if (!Decompress(Core, Data, DataLen, Job, &Out, &OutLen))
+   {
+      Core->UplinkSeqValid = false;
+      return;
+   }
+
+   RX_TRACE_Begin(RX_TRACE_TASK_CHILD, RX_TRACE_DEFRAME, OutLen);
+   for (Offset = 0; Offset < OutLen; Offset += PieceLen)
+   {
+      PieceLen = OutLen - Offset;
+      if (PieceLen > RX_FRAME_MAX_DATA_LEN)
+      {
+         PieceLen = RX_FRAME_MAX_DATA_LEN;
+      }
+      PieceFhp = RX_FRAME_FHP_NONE;
+      if (Fhp != RX_FRAME_FHP_NONE && Fhp >= Offset && Fhp < Offset + PieceLen)
+      {
+         PieceFhp = Fhp - Offset;
+      }
+      CCSDS_DEFRAMER_Write(&Core->Deframer, &Out[Offset], PieceLen,
+                           PieceFhp, (SeqGap && Offset == 0));
+   }
+   RX_TRACE_End(RX_TRACE_TASK_CHILD, RX_TRACE_DEFRAME, OutLen);
+
+} /* End WriteDecompressed() */
+
+
+/******************************************************************************
+** Function: DispatchPayload
+**
+** Pass a typed frame's data field to the payload dispatcher
+**
+** Notes:
+**   1. A compressed data field is decompressed first, a frame that fails
+**      to decompress is dropped. The frame type's handler is timed as the
+**      publish stage like packets emitted by the deframer.
+**
+*/
+static void DispatchPayload(RX_CORE_Class_t *Core, const RADIO_RX_Frame_t *Frame,
+                            const uint8_t *Data, uint16_t DataLen, const RX_CORE_Job_t *Job)
+{
+
+   RX_PAYLOAD_Frame_t Payload;
+   const uint8_t *Out;
+   uint16_t OutLen;
+
+   if (Frame->Data[RX_FRAME_FLAGS_OFFSET] & RX_FRAME_FLAG_COMPRESSED)
+   {
+      if (!Decompress(Core, Data, DataLen, Job, &Out, &OutLen))
+      {
+         return;
+      }
+      Data    = Out;
+      DataLen = OutLen;
+   }
+
+   Payload.Type     = RX_FRAME_TYPE(Frame->Data[RX_FRAME_FLAGS_OFFSET]);
+   Payload.Node     = Frame->Data[RX_FRAME_NODE_OFFSET];
+   Payload.Len      = DataLen;
+   Payload.Data     = Data;
+   Payload.RxTimeNs = Frame->RxTimeNs;
+
+   RX_TRACE_Begin(RX_TRACE_TASK_CHILD, RX_TRACE_PUBLISH, DataLen);
+   RX_PAYLOAD_Dispatch(&Core->Payload, &Payload);
+   RX_TRACE_End(RX_TRACE_TASK_CHILD, RX_TRACE_PUBLISH, DataLen);
+
+} /* End DispatchPayload() */
+
+
+/******************************************************************************
+** Function: SubmitJob
+**
+** Copy an accepted frame to the next decode pool job and queue it
+**
+*/
+static void SubmitJob(RX_CORE_Class_t *Core, const RADIO_RX_Frame_t *Frame)
+{
+
+   uint32_t Slot;
+
+   while (RX_POOL_Full(&Core->Pool))
+   {
+      RX_POOL_WaitReady(&Core->Pool, POOL_WAIT_MS, &Slot);
+      RetireJobs(Core);
+   }
+
+   Slot = RX_POOL_NextSlot(&Core->Pool);
+   memcpy(&Core->Job[Slot].Frame, Frame, sizeof(RADIO_RX_Frame_t));
+   RX_POOL_Submit(&Core->Pool);
+
+} /* End SubmitJob() */
+
+
+/******************************************************************************
+** Function: DecodeJob
+**
+** Decrypt and decompress a job's frame, runs on a decode worker
+**
+** Notes:
+**   1. Function signature must match RX_POOL_DecodeFunc_t.
+**   2. Only frames that will be routed are decompressed. The node filter
+**      is checked again when the job is retired, a job that wasn't
+**      decompressed here is decompressed by the receive task.
+**
+*/
+static void DecodeJob(void *Ctx, uint32_t Slot)
+{
+
+   RX_CORE_Class_t *Core = (RX_CORE_Class_t *)Ctx;
+   RX_CORE_Job_t   *Job  = &Core->Job[Slot];
+   const uint8_t   *Hdr  = Job->Frame.Data;
+   uint16_t DataOffset = RX_FRAME_HDR_LEN;
+   int64_t  StartNs;
+
+   Job->SecStatus    = RX_SEC_OK;
+   Job->Decompressed = false;
+   Job->DataLen      = Job->Frame.Len - RX_FRAME_HDR_LEN;
+
+   if (Hdr[RX_FRAME_FLAGS_OFFSET] & RX_FRAME_FLAG_SECURE)
+   {
+      Job->SecStatus = RX_SEC_Decrypt(&Core->Sec, Job->Frame.Data, Job->Frame.Len, &Job->DataLen);
+      if (Job->SecStatus != RX_SEC_OK)
+      {
+         return;
+      }
+      DataOffset = RX_FRAME_HDR_LEN + RX_SEC_HDR_LEN;
+   }
+   else if (Core->SecRequired)
+   {
+      return;
+   }
+
+   if ((Hdr[RX_FRAME_FLAGS_OFFSET] & RX_FRAME_FLAG_COMPRESSED) &&
+       (Hdr[RX_FRAME_NODE_OFFSET] == __atomic_load_n(&Core->Node, __ATOMIC_RELAXED) ||
+        RX_FRAME_TYPE(Hdr[RX_FRAME_FLAGS_OFFSET]) == RX_FRAME_TYPE_RELAY))
+   {
+      StartNs = SteadyNs();
+      Job->DecompStatus = RX_DECOMP_Expand(&Core->Decomp, &Job->Frame.Data[DataOffset], Job->DataLen,
+                                           Job->Out, &Job->OutLen);
+      Job->DecompNs     = (uint32_t)(SteadyNs() - StartNs);
+      Job->Decompressed = true;
+   }
+
+} /* End DecodeJob() */
+
+
+/******************************************************************************
+** Function: FinishJob
+**
+** Run a decoded job's serial stages in the receive task
+**
+*/
+static void FinishJob(RX_CORE_Class_t *Core, RX_CORE_Job_t *Job)
+{
+
+   const RADIO_RX_Frame_t *Frame = &Job->Frame;
+   const uint8_t *Data;
+
+   if (Frame->Data[RX_FRAME_FLAGS_OFFSET] & RX_FRAME_FLAG_SECURE)
+   {
+      if (RX_SEC_Commit(&Core->Sec, Job->SecStatus, Frame->Data) != RX_SEC_OK)
+      {
+         return;
+      }
+      Data = &Frame->Data[RX_FRAME_HDR_LEN + RX_SEC_HDR_LEN];
+   }
+   else if (Core->SecRequired)
+   {
+      RX_EVT_COUNT(Core->Stats.InsecureCnt);
+      return;
+   }
+   else
+   {
+      Data = &Frame->Data[RX_FRAME_HDR_LEN];
+   }
+
+   RouteFrame(Core, Frame, Data, Job->DataLen, Job);
+
+} /* End FinishJob() */
+
+
+/******************************************************************************
+** Function: RetireJobs
+**
+** Finish and retire decoded jobs in arrival order
+**
+*/
+static void RetireJobs(RX_CORE_Class_t *Core)
+{
+
+   uint32_t Slot;
+
+   while (RX_POOL_Ready(&Core->Pool, &Slot))
+   {
+      FinishJob(Core, &Core->Job[Slot]);
+      RX_POOL_Retire(&Core->Pool);
+   }
+
+} /* End RetireJobs() */
+
+
+/******************************************************************************
+** Function: WakeReceiver
+**
+** Notes:
+**   1. Function signature must match RX_POOL_WakeFunc_t.
+**   2. Ends a frame wait so the receive task retires the oldest job.
+**
+*/
+static void WakeReceiver(void *Ctx)
+{
+
+   RX_CORE_Class_t *Core = (RX_CORE_Class_t *)Ctx;
+
+   if (Core->BackendValid)
+   {
+      Core->Backend.AbortFunc(Core->Backend.Ctx);
+   }
+
+} /* End WakeReceiver() */
+
+
+/******************************************************************************
+** Function: SteadyNs
+**
+*/
+static int64_t SteadyNs(void)
+{
+
+   struct timespec Now;
+
+   clock_gettime(CLOCK_MONOTONIC, &Now);
+
+   return (int64_t)Now.tv_sec*1000000000 + Now.tv_nsec;
+
+} /* End SteadyNs() */
@@ -0,0 +1,331 @@
+/*
+**  This program is free software: you can redistribute it and/or modify
+**  it under the terms of the GNU Lesser General Public License as
+**  published by the Free Software Foundation, either version 3 of the
+**  License, or (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Lesser General Public License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public License
+**  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+**
+**  Purpose:
+**    Define the receive core, the cFS independent frame pipeline
+**
+**  Notes:
+**    1. The core takes received frames from its frame backend, see
+**       RX_CORE_Backend_t, through the destination filter, security,
+**       uplink sequence check, decompression and deframing stages, and
+**       routes the extracted packets to the deframer's emit function.
+**       Frames of other types skip the deframer and are dispatched to the
+**       payload handler for their type, see rx_payload.h. Statistics are
+**       kept for every stage.
+**    2. It has no cFE or OSAL dependencies. The Lora_Rx app's radio_if
+**       object is a thin adapter that constructs it from the JSON ini
+**       file, routes packets to the software bus and reports the
+**       statistics, selective NACKs and per-node link statistics. It
+**       passes the radio bridge's frame ring (radio_rx.h) to the core as
+**       the frame backend.
+**    3. A ground station or a host benchmark can link the core without
+**       cFS or the radio driver: rx_core, rx_sec, aes_gcm, rx_seq,
+**       rx_link, rx_decomp, rx_payload, rx_pool, ccsds_deframer,
+**       rx_trace, rx_tap and rx_evt. radio_rx.h is only included for the
+**       frame type. See unit-test/rx_core_test.c for a host backend.
+**    4. The core's stages are public members so the owner constructs
+**       them with its own configuration after RX_CORE_Constructor().
+**       The deframer's emit function is the packet router and the
+**       payload sinks service the other frame types.
+**    5. Frames are processed by one task. Configuration setters may be
+**       called from another task, each setting is a single store.
+**    6. RX_CORE_StartPool() moves decryption and decompression to a pool
+**       of decode workers, see rx_pool.h. Frames are screened, tapped and
+**       passed to FrameFunc on arrival and then copied to a job so the
+**       radio's frame slot is released immediately. Decoded jobs are
+**       retired in arrival order by the receive task, which runs the
+**       replay check, sequence and link tracking, filters, deframer and
+**       payload dispatch exactly as it does without the pool. Worker
+**       stages aren't traced, their time is reported as utilization.
+**    7. This header shouldn't include cFS or Lora_Rx app C header files.
+**
+*/
+
+#ifndef _rx_core_
+#define _rx_core_
+
+/*
+** Includes
+*/
+#include <stdbool.h>
+#include <stdint.h>
+#include "radio_rx.h"
+#include "rx_frame.h"
+#include "rx_sec.h"
+#include "rx_seq.h"
+#include "rx_link.h"
+#include "rx_decomp.h"
+#include "rx_payload.h"
+#include "rx_pool.h"
+#include "ccsds_deframer.h"
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+
+/*
+** Frame level statistics. Counters reported by RX_EVT are only written
+** with RX_EVT_COUNT().
+*/
+typedef struct
+{
+   uint32_t FrameCnt;        /* Frames accepted for processing            */
+   uint32_t ShortFrameCnt;   /* Frames too short to contain a header      */
+   uint32_t DestFilterCnt;   /* Frames addressed to another recipient     */
+   uint32_t NodeFilterCnt;   /* Frames from a node other than the uplink  */
+   uint32_t SeqGapCnt;       /* Uplink frame sequence discontinuities     */
+   uint32_t InsecureCnt;     /* Unsecured frames rejected, SecRequired    */
+
+} RX_CORE_Stats_t;
+
+
+/*
+** Called for each frame that passes the destination filter, before the
+** frame is processed. The frame must not be changed.
+*/
+typedef void (*RX_CORE_FrameFunc_t)(void *FrameCtx, const RADIO_RX_Frame_t *Frame);
+
+
+/*
+** Frame backend. Wait returns the next received frame or NULL if none
+** arrives within TimeoutMs. Release returns the frame obtained from the
+** last Wait. Abort makes a blocked Wait return NULL and may be called
+** from any task.
+*/
+typedef RADIO_RX_Frame_t *(*RX_CORE_WaitFunc_t)(void *BackendCtx, uint32_t TimeoutMs);
+typedef void (*RX_CORE_ReleaseFunc_t)(void *BackendCtx);
+typedef void (*RX_CORE_AbortFunc_t)(void *BackendCtx);
+
+typedef struct
+{
+   RX_CORE_WaitFunc_t    WaitFunc;
+   RX_CORE_ReleaseFunc_t ReleaseFunc;
+   RX_CORE_AbortFunc_t   AbortFunc;
+   void *Ctx;
+
+} RX_CORE_Backend_t;
+
+
+/*
+** A frame in the decode pool. The worker fields are written by the
+** worker that decodes the job and read when it's retired.
+*/
+typedef struct
+{
+
+   RADIO_RX_Frame_t Frame;
+
+   RX_SEC_Status_Enum_t    SecStatus;
+   RX_DECOMP_Status_Enum_t DecompStatus;
+   bool     Decompressed;     /* Out holds the decompressed data field */
+   uint16_t DataLen;          /* Plaintext data field length           */
+   uint16_t OutLen;
+   uint32_t DecompNs;
+   uint8_t  Out[RX_DECOMP_MAX_OUT_LEN];
+
+} RX_CORE_Job_t;
+
+
+typedef struct
+{
+
+   /*
+   ** Configuration
+   */
+
+   uint8_t  Dest;
+   uint8_t  Node;
+   bool     SecRequired;
+   RX_CORE_FrameFunc_t FrameFunc;
+   void    *FrameCtx;
+   RX_CORE_Backend_t   Backend;
+   bool     BackendValid;
+
+   /*
+   ** Stages
+   */
+
+   RX_SEC_Class_t         Sec;
+   RX_SEQ_Class_t         SeqTrk;
+   RX_LINK_Class_t        Link;
+   RX_DECOMP_Class_t      Decomp;
+   CCSDS_DEFRAMER_Class_t Deframer;
+   RX_PAYLOAD_Class_t     Payload;
+   RX_POOL_Class_t        Pool;
+   RX_CORE_Job_t         *Job;     /* Reorder buffer, one job per pool slot */
+
+   /*
+   ** State
+   */
+
+   bool     UplinkSeqValid;
+   uint8_t  UplinkSeq;
+   uint32_t GoodputByteCnt;   /* Frame data bytes passed to the deframer */
+   uint32_t DecompLastNs;     /* Decompression time of the last compressed frame */
+   uint32_t DecompMaxNs;
+
+   RX_CORE_Stats_t Stats;
+
+} RX_CORE_Class_t;
+
+
+/************************/
+/** Exported Functions **/
+/************************/
+
+
+/******************************************************************************
+** Function: RX_CORE_Constructor
+**
+** Initialize the core to a known state
+**
+** Notes:
+**   1. The backend is copied. It may be NULL if frames are only passed
+**      to RX_CORE_ProcessFrame(), RX_CORE_WaitFrame() then returns NULL
+**      without waiting.
+**   2. FrameFunc may be NULL. The stages must be constructed afterwards,
+**      see note 4 above. The sequence tracker and link table are
+**      constructed with their defaults and the payload dispatcher
+**      without sinks.
+**
+*/
+void RX_CORE_Constructor(RX_CORE_Class_t *Core, const RX_CORE_Backend_t *Backend,
+                         RX_CORE_FrameFunc_t FrameFunc, void *FrameCtx);
+
+
+/******************************************************************************
+** Function: RX_CORE_StartPool
+**
+** Start decode workers, see note 6 above
+**
+** Notes:
+**   1. Job must hold Depth jobs and stay allocated while the pool runs.
+**   2. Returns false if the pool can't be started, frames are then
+**      decoded by the receive task. See RX_POOL_Start() for the limits.
+**   3. Must be called before the first frame is processed.
+**
+*/
+bool RX_CORE_StartPool(RX_CORE_Class_t *Core, uint8_t WorkerCnt, RX_CORE_Job_t *Job, uint16_t Depth);
+
+
+/******************************************************************************
+** Function: RX_CORE_SetAddress
+**
+** Set the accepted destination and the uplink node
+**
+*/
+void RX_CORE_SetAddress(RX_CORE_Class_t *Core, uint8_t Dest, uint8_t Node);
+
+
+/******************************************************************************
+** Function: RX_CORE_ResyncUplink
+**
+** Forget the uplink sequence so the next frame starts a new sequence
+**
+** Notes:
+**   1. Used when the link changes, the deframer drops any partial packet
+**      when the next frame arrives.
+**
+*/
+void RX_CORE_ResyncUplink(RX_CORE_Class_t *Core);
+
+
+/******************************************************************************
+** Function: RX_CORE_WaitFrame
+**
+** Wait for the next received frame
+**
+** Notes:
+**   1. Returns NULL on a timeout. Pending key loads are applied before
+**      returning so a frame that ends a long wait uses the latest keys.
+**   2. A returned frame must be released with RX_CORE_ReleaseFrame()
+**      after it's processed.
+**   3. With decode workers, decoded jobs are retired before and after the
+**      wait and a worker that decodes the oldest job ends the wait early.
+**      Keys are only switched while no job is in flight so a pending key
+**      load waits for the pool to drain instead of waiting for a frame.
+**
+*/
+RADIO_RX_Frame_t *RX_CORE_WaitFrame(RX_CORE_Class_t *Core, uint32_t TimeoutMs);
+
+
+/******************************************************************************
+** Function: RX_CORE_ReleaseFrame
+**
+** Return the frame obtained from RX_CORE_WaitFrame() to the backend
+**
+*/
+void RX_CORE_ReleaseFrame(RX_CORE_Class_t *Core);
+
+
+/******************************************************************************
+** Function: RX_CORE_ProcessFrame
+**
+** Run a frame through the pipeline
+**
+** Notes:
+**   1. Every frame is published to the frame tap, see rx_tap.h.
+**   2. Secured frames are authenticated and decrypted in place, see
+**      rx_sec.h. The sequence and link statistics of every frame that
+**      passes the security stage are tracked per sender node, see
+**      rx_seq.h and rx_link.h. The frame doesn't have to come from the
+**      radio so host benchmarks can feed frames directly.
+**   3. A CRC errored frame is only counted against its sender's link
+**      statistics.
+**   4. Typed frames are filtered like the packet stream except relayed
+**      telemetry, which is accepted from any node.
+**   5. With decode workers the frame is copied and queued, the caller can
+**      release it on return. A full reorder buffer blocks until the oldest
+**      job is retired.
+**
+*/
+void RX_CORE_ProcessFrame(RX_CORE_Class_t *Core, RADIO_RX_Frame_t *Frame);
+
+
+/******************************************************************************
+** Function: RX_CORE_Poll
+**
+** Wait for, process and release one frame
+**
+** Notes:
+**   1. Returns false if no frame was received within TimeoutMs.
+**
+*/
+bool RX_CORE_Poll(RX_CORE_Class_t *Core, uint32_t TimeoutMs);
+
+
+/******************************************************************************
+** Function: RX_CORE_Flush
+**
+** Wait for every frame in the decode pool to be decoded and retired
+**
+** Notes:
+**   1. Returns immediately without decode workers.
+**
+*/
+void RX_CORE_Flush(RX_CORE_Class_t *Core);
+
+
+/******************************************************************************
+** Function: RX_CORE_ResetStatus
+**
+** Reset the core and stage statistics
+**
+*/
+void RX_CORE_ResetStatus(RX_CORE_Class_t *Core);
+
+
+#endif /* _rx_core_ */
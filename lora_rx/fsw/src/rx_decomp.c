@@ -0,0 +1,249 @@
+/*
+**  This program is free software: you can redistribute it and/or modify
+**  it under the terms of the GNU Lesser General Public License as
+**  published by the Free Software Foundation, either version 3 of the
+**  License, or (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Lesser General Public License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public License
+**  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+**
+**  Purpose:
+**    Implement the receive decompression stage class
+**
+**  Notes:
+**    1. See rx_decomp.h for details.
+**
+*/
+
+/*
+** Include Files:
+*/
+
+#include <string.h>
+#include "rx_decomp.h"
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+typedef struct
+{
+   const uint8_t *Data;
+   uint32_t BitPos;
+   uint32_t BitLen;
+
+} BitReader_t;
+
+
+/*******************************/
+/** Local Function Prototypes **/
+/*******************************/
+
+static bool GetBits(BitReader_t *Reader, uint8_t Count, uint16_t *Value);
+
+
+/******************************************************************************
+** Function: RX_DECOMP_Constructor
+**
+*/
+bool RX_DECOMP_Constructor(RX_DECOMP_Class_t *Decomp, uint8_t WindowBits,
+                           uint8_t LookaheadBits, uint16_t MaxOutLen)
+{
+
+   bool RetStatus = true;
+
+   memset(Decomp, 0, sizeof(RX_DECOMP_Class_t));
+
+   if (WindowBits < RX_DECOMP_MIN_WINDOW_BITS || WindowBits > RX_DECOMP_MAX_WINDOW_BITS ||
+       LookaheadBits < RX_DECOMP_MIN_LOOKAHEAD_BITS || LookaheadBits >= WindowBits)
+   {
+      WindowBits    = RX_DECOMP_DEF_WINDOW_BITS;
+      LookaheadBits = RX_DECOMP_DEF_LOOKAHEAD_BITS;
+      RetStatus     = false;
+   }
+
+   Decomp->WindowBits    = WindowBits;
+   Decomp->LookaheadBits = LookaheadBits;
+   Decomp->MaxOutLen     = (MaxOutLen > 0 && MaxOutLen < RX_DECOMP_MAX_OUT_LEN) ? MaxOutLen : RX_DECOMP_MAX_OUT_LEN;
+
+   return RetStatus;
+
+} /* End RX_DECOMP_Constructor() */
+
+
+/******************************************************************************
+** Function: RX_DECOMP_ResetStatus
+**
+*/
+void RX_DECOMP_ResetStatus(RX_DECOMP_Class_t *Decomp)
+{
+
+   memset(&Decomp->Stats, 0, sizeof(RX_DECOMP_Stats_t));
+
+} /* End RX_DECOMP_ResetStatus() */
+
+
+/******************************************************************************
+** Function: RX_DECOMP_Frame
+**
+*/
+RX_DECOMP_Status_Enum_t RX_DECOMP_Frame(RX_DECOMP_Class_t *Decomp, const uint8_t *Data,
+                                        uint16_t Len, uint16_t *OutLen)
+{
+
+   RX_DECOMP_Status_Enum_t Status;
+   uint16_t Produced = 0;
+
+   Status = RX_DECOMP_Expand(Decomp, Data, Len, Decomp->Out, &Produced);
+   RX_DECOMP_Account(Decomp, Status, Len, Produced);
+   *OutLen = Produced;
+
+   return Status;
+
+} /* End RX_DECOMP_Frame() */
+
+
+/******************************************************************************
+** Function: RX_DECOMP_Expand
+**
+** Notes:
+**   1. Back-references may overlap the bytes they produce (offset < length)
+**      so they're copied a byte at a time.
+**
+*/
+RX_DECOMP_Status_Enum_t RX_DECOMP_Expand(const RX_DECOMP_Class_t *Decomp, const uint8_t *Data,
+                                         uint16_t Len, uint8_t *Out, uint16_t *OutLen)
+{
+
+   BitReader_t Reader;
+   uint16_t Produced = 0;
+   uint16_t Tag;
+   uint16_t Literal;
+   uint16_t Index;
+   uint16_t Count;
+   uint16_t Offset;
+   uint16_t i;
+
+   Reader.Data   = Data;
+   Reader.BitPos = 0;
+   Reader.BitLen = (uint32_t)Len * 8;
+
+   while (GetBits(&Reader, 1, &Tag))
+   {
+      if (Tag)
+      {
+         if (!GetBits(&Reader, 8, &Literal))
+         {
+            break;
+         }
+         if (Produced >= Decomp->MaxOutLen)
+         {
+            return RX_DECOMP_OVERFLOW;
+         }
+         Out[Produced++] = (uint8_t)Literal;
+      }
+      else
+      {
+         if (!GetBits(&Reader, Decomp->WindowBits, &Index) ||
+             !GetBits(&Reader, Decomp->LookaheadBits, &Count))
+         {
+            break;
+         }
+         Offset = Index + 1;
+         Count  = Count + 1;
+         if (Offset > Produced)
+         {
+            return RX_DECOMP_BAD_REF;
+         }
+         if (Count > Decomp->MaxOutLen - Produced)
+         {
+            return RX_DECOMP_OVERFLOW;
+         }
+         for (i = 0; i < Count; i++)
+         {
+            Out[Produced] = Out[Produced - Offset];
+            Produced++;
+         }
+      }
+   } /* End while input */
+
+   *OutLen = Produced;
+
+   return RX_DECOMP_OK;
+
+} /* End RX_DECOMP_Expand() */
+
+
+/******************************************************************************
+** Function: RX_DECOMP_Account
+**
+*/
+void RX_DECOMP_Account(RX_DECOMP_Class_t *Decomp, RX_DECOMP_Status_Enum_t Status,
+                       uint16_t Len, uint16_t OutLen)
+{
+
+   switch (Status)
+   {
+      case RX_DECOMP_OK:
+         Decomp->Stats.FrameCnt++;
+         Decomp->Stats.InByteCnt  += Len;
+         Decomp->Stats.OutByteCnt += OutLen;
+         if (OutLen > Decomp->Stats.MaxOutLen)
+         {
+            Decomp->Stats.MaxOutLen = OutLen;
+         }
+         break;
+      case RX_DECOMP_BAD_REF:
+         Decomp->Stats.BadRefCnt++;
+         break;
+      case RX_DECOMP_OVERFLOW:
+         Decomp->Stats.OverflowCnt++;
+         break;
+   }
+
+} /* End RX_DECOMP_Account() */
+
+
+/******************************************************************************
+** Function: GetBits
+**
+** Read Count (<= 16) bits MSB first. Returns false if the input doesn't
+** hold Count more bits.
+**
+*/
+static bool GetBits(BitReader_t *Reader, uint8_t Count, uint16_t *Value)
+{
+
+   uint32_t Bits = 0;
+   uint32_t Byte;
+   uint8_t  Avail;
+   uint8_t  Take;
+
+   if (Reader->BitPos + Count > Reader->BitLen)
+   {
+      return false;
+   }
+
+   while (Count > 0)
+   {
+      Byte  = Reader->Data[Reader->BitPos >> 3];
+      Avail = 8 - (Reader->BitPos & 7);
+      Take  = (Count < Avail) ? Count : Avail;
+
+      Bits = (Bits << Take) | ((Byte >> (Avail - Take)) & ((1u << Take) - 1));
+
+      Reader->BitPos += Take;
+      Count -= Take;
+   }
+
+   *Value = (uint16_t)Bits;
+
+   return true;
+
+} /* End GetBits() */
@@ -0,0 +1,173 @@
+/*
+**  This program is free software: you can redistribute it and/or modify
+**  it under the terms of the GNU Lesser General Public License as
+**  published by the Free Software Foundation, either version 3 of the
+**  License, or (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Lesser General Public License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public License
+**  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+**
+**  Purpose:
+**    Define the receive decompression stage class
+**
+**  Notes:
+**    1. Frames with RX_FRAME_FLAG_COMPRESSED set carry an LZSS compressed
+**       data field using the heatshrink bitstream format so the transmitter
+**       can use the heatshrink encoder with the same window and lookahead
+**       sizes:
+**         - Bits are read MSB first
+**         - Tag 1: 8-bit literal byte
+**         - Tag 0: back-reference with a WindowBits index (offset - 1)
+**                  followed by a LookaheadBits count (length - 1)
+**       Trailing bits that don't complete a token are padding.
+**    2. Each frame is a self-contained stream so a lost frame never
+**       corrupts the frames that follow it. The FHP in a compressed frame
+**       is an offset into the decompressed data field.
+**    3. Because streams don't span frames the output buffer doubles as the
+**       decoder's window, so the only memory is one preallocated buffer
+**       sized at compile time. A frame that references data before its start
+**       or expands beyond MaxOutLen is rejected.
+**    4. RX_DECOMP_Expand() decodes into a caller's buffer without changing
+**       the stage so decode workers (rx_pool.h) can share one configured
+**       stage. The receive context counts their results with
+**       RX_DECOMP_Account().
+**    5. This header shouldn't include cFS or Lora_Rx app C header files.
+**
+*/
+
+#ifndef _rx_decomp_
+#define _rx_decomp_
+
+/*
+** Includes
+*/
+#include <stdbool.h>
+#include <stdint.h>
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define RX_DECOMP_MIN_WINDOW_BITS   4
+#define RX_DECOMP_MAX_WINDOW_BITS  12
+#define RX_DECOMP_MIN_LOOKAHEAD_BITS  3
+
+#define RX_DECOMP_MAX_OUT_LEN    4096   /* Decompressed bytes per frame */
+
+#define RX_DECOMP_DEF_WINDOW_BITS     8
+#define RX_DECOMP_DEF_LOOKAHEAD_BITS  4
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+typedef enum
+{
+   RX_DECOMP_OK       = 0,
+   RX_DECOMP_BAD_REF  = 1,
+   RX_DECOMP_OVERFLOW = 2
+
+} RX_DECOMP_Status_Enum_t;
+
+
+typedef struct
+{
+   uint32_t FrameCnt;      /* Frames successfully decompressed        */
+   uint32_t InByteCnt;     /* Compressed bytes in successful frames   */
+   uint32_t OutByteCnt;    /* Decompressed bytes in successful frames */
+   uint32_t BadRefCnt;
+   uint32_t OverflowCnt;
+   uint16_t MaxOutLen;     /* Largest decompressed frame              */
+
+} RX_DECOMP_Stats_t;
+
+
+/******************************************************************************
+** RX_DECOMP_Class
+*/
+typedef struct
+{
+
+   uint8_t  WindowBits;
+   uint8_t  LookaheadBits;
+   uint16_t MaxOutLen;
+
+   RX_DECOMP_Stats_t Stats;
+
+   uint8_t  Out[RX_DECOMP_MAX_OUT_LEN];
+
+} RX_DECOMP_Class_t;
+
+
+/************************/
+/** Exported Functions **/
+/************************/
+
+
+/******************************************************************************
+** Function: RX_DECOMP_Constructor
+**
+** Notes:
+**   1. Returns false if the window or lookahead size is outside the
+**      supported range. The defaults are used and MaxOutLen is limited to
+**      RX_DECOMP_MAX_OUT_LEN.
+**
+*/
+bool RX_DECOMP_Constructor(RX_DECOMP_Class_t *Decomp, uint8_t WindowBits,
+                           uint8_t LookaheadBits, uint16_t MaxOutLen);
+
+
+/******************************************************************************
+** Function: RX_DECOMP_ResetStatus
+**
+*/
+void RX_DECOMP_ResetStatus(RX_DECOMP_Class_t *Decomp);
+
+
+/******************************************************************************
+** Function: RX_DECOMP_Frame
+**
+** Decompress a frame's data field into Decomp->Out
+**
+** Notes:
+**   1. On success *OutLen is the number of bytes in Decomp->Out which are
+**      valid until the next call.
+**
+*/
+RX_DECOMP_Status_Enum_t RX_DECOMP_Frame(RX_DECOMP_Class_t *Decomp, const uint8_t *Data,
+                                        uint16_t Len, uint16_t *OutLen);
+
+
+/******************************************************************************
+** Function: RX_DECOMP_Expand
+**
+** Decompress a frame's data field into Out
+**
+** Notes:
+**   1. Out must hold RX_DECOMP_MAX_OUT_LEN bytes. No statistics are
+**      counted, pass the result to RX_DECOMP_Account().
+**   2. May be called from several tasks at once.
+**
+*/
+RX_DECOMP_Status_Enum_t RX_DECOMP_Expand(const RX_DECOMP_Class_t *Decomp, const uint8_t *Data,
+                                         uint16_t Len, uint8_t *Out, uint16_t *OutLen);
+
+
+/******************************************************************************
+** Function: RX_DECOMP_Account
+**
+** Count the result of an RX_DECOMP_Expand() call
+**
+*/
+void RX_DECOMP_Account(RX_DECOMP_Class_t *Decomp, RX_DECOMP_Status_Enum_t Status,
+                       uint16_t Len, uint16_t OutLen);
+
+
+#endif /* _rx_decomp_ */
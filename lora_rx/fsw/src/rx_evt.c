@@ -0,0 +1,151 @@
+/*
+**  This program is free software: you can redistribute it and/or modify
+**  it under the terms of the GNU Lesser General Public License as
+**  published by the Free Software Foundation, either version 3 of the
+**  License, or (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Lesser General Public License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public License
+**  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+**
+**  Purpose:
+**    Implement the receive event aggregation class
+**
+**  Notes:
+**    1. See rx_evt.h for details.
+**
+*/
+
+/*
+** Include Files:
+*/
+
+#include <stdio.h>
+#include <string.h>
+#include "rx_evt.h"
+
+
+/**********************/
+/** Global File Data **/
+/**********************/
+
+static const char *EvtName[RX_EVT_ID_CNT] =
+{
+   "crc",
+   "hdr",
+   "overrun",
+   "short",
+   "dest-filter",
+   "node-filter",
+   "insecure",
+   "seq-gap",
+   "auth-fail",
+   "replay",
+   "no-key",
+   "decomp",
+   "resync",
+   "emit"
+};
+
+
+/******************************************************************************
+** Function: RX_EVT_Constructor
+**
+*/
+void RX_EVT_Constructor(RX_EVT_Class_t *Evt)
+{
+
+   memset(Evt, 0, sizeof(RX_EVT_Class_t));
+
+} /* End RX_EVT_Constructor() */
+
+
+/******************************************************************************
+** Function: RX_EVT_ResetStatus
+**
+*/
+void RX_EVT_ResetStatus(RX_EVT_Class_t *Evt)
+{
+
+   Evt->IntervalCnt       = 0;
+   Evt->ActiveIntervalCnt = 0;
+
+} /* End RX_EVT_ResetStatus() */
+
+
+/******************************************************************************
+** Function: RX_EVT_Update
+**
+*/
+uint32_t RX_EVT_Update(RX_EVT_Class_t *Evt, const uint32_t Total[RX_EVT_ID_CNT])
+{
+
+   uint16_t i;
+
+   Evt->ActiveMask = 0;
+
+   for (i = 0; i < RX_EVT_ID_CNT; i++)
+   {
+      if (!Evt->Primed)
+      {
+         Evt->Delta[i] = 0;
+      }
+      else
+      {
+         Evt->Delta[i] = (Total[i] >= Evt->Last[i]) ? (Total[i] - Evt->Last[i]) : Total[i];
+      }
+      if (Evt->Delta[i] > 0)
+      {
+         Evt->ActiveMask |= RX_EVT_MASK(i);
+      }
+      Evt->Last[i] = Total[i];
+   }
+
+   Evt->Primed = true;
+   Evt->IntervalCnt++;
+   if (Evt->ActiveMask)
+   {
+      Evt->ActiveIntervalCnt++;
+   }
+
+   return Evt->ActiveMask;
+
+} /* End RX_EVT_Update() */
+
+
+/******************************************************************************
+** Function: RX_EVT_Format
+**
+*/
+void RX_EVT_Format(const RX_EVT_Class_t *Evt, char *Buf, size_t BufLen)
+{
+
+   size_t   Len = 0;
+   int      Written;
+   uint16_t i;
+
+   if (BufLen == 0)
+   {
+      return;
+   }
+   Buf[0] = '\0';
+
+   for (i = 0; i < RX_EVT_ID_CNT && Len < BufLen; i++)
+   {
+      if (Evt->Delta[i] > 0)
+      {
+         Written = snprintf(&Buf[Len], BufLen - Len, "%s%s %u", (Len > 0) ? ", " : "",
+                            EvtName[i], (unsigned int)Evt->Delta[i]);
+         if (Written < 0)
+         {
+            break;
+         }
+         Len += (size_t)Written;
+      }
+   }
+
+} /* End RX_EVT_Format() */
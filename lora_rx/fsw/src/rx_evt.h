@@ -0,0 +1,152 @@
+/*
+**  This program is free software: you can redistribute it and/or modify
+**  it under the terms of the GNU Lesser General Public License as
+**  published by the Free Software Foundation, either version 3 of the
+**  License, or (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Lesser General Public License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public License
+**  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+**
+**  Purpose:
+**    Define the receive event aggregation class
+**
+**  Notes:
+**    1. Receive path conditions (CRC errors, overruns, filter rejects, ...)
+**       are never reported with an event when they occur. Their owners
+**       count them with RX_EVT_COUNT() and the app's main task collects
+**       the counter deltas at 1 Hz with RX_EVT_Update(). One summary event
+**       and telemetry packet report each interval's deltas, so formatting
+**       and software bus traffic stay off the per-frame path.
+**    2. Each counter has a single writer. RX_EVT_COUNT() is a relaxed
+**       load and store, not a locked read-modify-write, and readers in
+**       other contexts use RX_EVT_READ().
+**    3. A total that's lower than the previous one means its owner reset
+**       it, so the new total is the interval's delta.
+**    4. This header shouldn't include cFS or Lora_Rx app C header files.
+**
+*/
+
+#ifndef _rx_evt_
+#define _rx_evt_
+
+/*
+** Includes
+*/
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define RX_EVT_COUNT(Cnt)  __atomic_store_n(&(Cnt), __atomic_load_n(&(Cnt), __ATOMIC_RELAXED) + 1, __ATOMIC_RELAXED)
+#define RX_EVT_READ(Cnt)   __atomic_load_n(&(Cnt), __ATOMIC_RELAXED)
+
+#define RX_EVT_MASK(Id)    (1u << (Id))
+
+/* Conditions that indicate lost or rejected uplink data */
+#define RX_EVT_ERROR_MASK  (RX_EVT_MASK(RX_EVT_CRC_ERR)       | RX_EVT_MASK(RX_EVT_HDR_ERR)     | \
+                            RX_EVT_MASK(RX_EVT_OVERRUN)       | RX_EVT_MASK(RX_EVT_SEC_AUTH_FAIL) | \
+                            RX_EVT_MASK(RX_EVT_SEC_REPLAY)    | RX_EVT_MASK(RX_EVT_SEC_NO_KEY)  | \
+                            RX_EVT_MASK(RX_EVT_DECOMP_ERR)    | RX_EVT_MASK(RX_EVT_EMIT_ERR))
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+
+typedef enum
+{
+   RX_EVT_CRC_ERR = 0,
+   RX_EVT_HDR_ERR,
+   RX_EVT_OVERRUN,
+   RX_EVT_SHORT_FRAME,
+   RX_EVT_DEST_FILTER,
+   RX_EVT_NODE_FILTER,
+   RX_EVT_INSECURE,
+   RX_EVT_SEQ_GAP,
+   RX_EVT_SEC_AUTH_FAIL,
+   RX_EVT_SEC_REPLAY,
+   RX_EVT_SEC_NO_KEY,
+   RX_EVT_DECOMP_ERR,
+   RX_EVT_DEFRAMER_RESYNC,
+   RX_EVT_EMIT_ERR,
+   RX_EVT_ID_CNT
+
+} RX_EVT_Id_Enum_t;
+
+
+/******************************************************************************
+** RX_EVT_Class
+*/
+typedef struct
+{
+
+   bool     Primed;                   /* Last holds a previous update's totals */
+   uint32_t ActiveMask;               /* Conditions with a non-zero delta */
+   uint32_t Last[RX_EVT_ID_CNT];
+   uint32_t Delta[RX_EVT_ID_CNT];
+
+   uint32_t IntervalCnt;
+   uint32_t ActiveIntervalCnt;        /* Intervals with at least one condition */
+
+} RX_EVT_Class_t;
+
+
+/************************/
+/** Exported Functions **/
+/************************/
+
+
+/******************************************************************************
+** Function: RX_EVT_Constructor
+**
+*/
+void RX_EVT_Constructor(RX_EVT_Class_t *Evt);
+
+
+/******************************************************************************
+** Function: RX_EVT_ResetStatus
+**
+** Notes:
+**   1. The previous totals are kept so the next interval is still a delta.
+**
+*/
+void RX_EVT_ResetStatus(RX_EVT_Class_t *Evt);
+
+
+/******************************************************************************
+** Function: RX_EVT_Update
+**
+** Compute the deltas since the previous update and return the active mask
+**
+** Notes:
+**   1. Total is indexed by RX_EVT_Id_Enum_t.
+**   2. The first update only records the totals. Counters restored from a
+**      warm restart aren't reported as a burst.
+**
+*/
+uint32_t RX_EVT_Update(RX_EVT_Class_t *Evt, const uint32_t Total[RX_EVT_ID_CNT]);
+
+
+/******************************************************************************
+** Function: RX_EVT_Format
+**
+** Write the interval's non-zero deltas as "name count" pairs
+**
+** Notes:
+**   1. Output is truncated to BufLen, including the terminator.
+**
+*/
+void RX_EVT_Format(const RX_EVT_Class_t *Evt, char *Buf, size_t BufLen);
+
+
+#endif /* _rx_evt_ */
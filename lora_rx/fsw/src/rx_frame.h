@@ -0,0 +1,90 @@
+/*
+**  This program is free software: you can redistribute it and/or modify
+**  it under the terms of the GNU Lesser General Public License as
+**  published by the Free Software Foundation, either version 3 of the
+**  License, or (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Lesser General Public License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public License
+**  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+**
+**  Purpose:
+**    Define the over-the-air LoRa frame format
+**
+**  Notes:
+**    1. Every LoRa frame starts with a fixed header followed by a data
+**       field that carries a byte stream of CCSDS space packets. Packets
+**       are not aligned to frames and can span any number of frames.
+**    2. The header follows the same to/from/id/flags convention used by
+**       the transmit app so the Dest and Node radio settings identify the
+**       recipient and the sender.
+**    3. The first header pointer (FHP) is the offset within the data field
+**       of the first CCSDS primary header that starts in the frame. It
+**       follows the CCSDS M_PDU convention and lets the receiver resync
+**       after a lost or corrupted frame without scanning for a header.
+**    4. The upper nibble of the flags is the frame type. Type 0 frames
+**       carry the packet stream described above. Other types carry one
+**       self-contained payload in the data field and are dispatched to a
+**       payload handler, see rx_payload.h. Their FHP is unused and should
+**       be RX_FRAME_FHP_NONE.
+**    5. This header shouldn't include cFS or Lora_Rx app C header files.
+**
+*/
+
+#ifndef _rx_frame_
+#define _rx_frame_
+
+/*
+** Includes
+*/
+#include <stdint.h>
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define RX_FRAME_MAX_LEN       255   /* SX128x LoRa payload limit */
+#define RX_FRAME_HDR_LEN         5
+#define RX_FRAME_MAX_DATA_LEN  (RX_FRAME_MAX_LEN - RX_FRAME_HDR_LEN)
+
+#define RX_FRAME_FHP_NONE   0xFF  /* No packet header starts in the frame */
+
+/*
+** Header byte offsets
+*/
+
+#define RX_FRAME_DEST_OFFSET   0
+#define RX_FRAME_NODE_OFFSET   1
+#define RX_FRAME_SEQ_OFFSET    2
+#define RX_FRAME_FLAGS_OFFSET  3
+#define RX_FRAME_FHP_OFFSET    4
+
+#define RX_FRAME_BROADCAST  0xFF  /* Dest value accepted by all receivers */
+
+/*
+** Flags
+*/
+
+#define RX_FRAME_FLAG_SECURE      0x01  /* Authenticated and encrypted, see rx_sec.h */
+#define RX_FRAME_FLAG_COMPRESSED  0x02  /* Compressed data field, see rx_decomp.h   */
+
+/*
+** Frame types, see note 4
+*/
+
+#define RX_FRAME_TYPE_SHIFT  4
+#define RX_FRAME_TYPE_CNT    16
+#define RX_FRAME_TYPE(Flags)  ((uint8_t)(Flags) >> RX_FRAME_TYPE_SHIFT)
+
+#define RX_FRAME_TYPE_PACKETS   0   /* CCSDS packet stream                   */
+#define RX_FRAME_TYPE_RELAY     1   /* Telemetry packet relayed from a node  */
+#define RX_FRAME_TYPE_FILE      2   /* File chunk, reserved                  */
+#define RX_FRAME_TYPE_TIME      3   /* Sender's mission time                 */
+#define RX_FRAME_TYPE_COMMAND   4   /* Command packet                        */
+
+
+#endif /* _rx_frame_ */
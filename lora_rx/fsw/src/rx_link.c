@@ -0,0 +1,226 @@
+/*
+**  This program is free software: you can redistribute it and/or modify
+**  it under the terms of the GNU Lesser General Public License as
+**  published by the Free Software Foundation, either version 3 of the
+**  License, or (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Lesser General Public License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public License
+**  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+**
+**  Purpose:
+**    Implement the per-node link statistics table
+**
+**  Notes:
+**    1. See rx_link.h for details.
+**
+*/
+
+/*
+** Include Files:
+*/
+
+#include <string.h>
+#include "rx_link.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define EWMA(Avg, Sample, Shift)  ((Avg) + (((int32_t)(Sample) - (int32_t)(Avg)) >> (Shift)))
+
+
+/*******************************/
+/** Local Function Prototypes **/
+/*******************************/
+
+static void BeginUpdate(RX_LINK_Entry_t *Entry);
+static void EndUpdate(RX_LINK_Entry_t *Entry);
+
+
+/******************************************************************************
+** Function: RX_LINK_Constructor
+**
+*/
+bool RX_LINK_Constructor(RX_LINK_Class_t *Link, uint8_t EwmaShift)
+{
+
+   bool RetStatus = true;
+   uint16_t i;
+
+   memset(Link, 0, sizeof(RX_LINK_Class_t));
+
+   if (EwmaShift > RX_LINK_MAX_EWMA_SHIFT)
+   {
+      EwmaShift = RX_LINK_DEF_EWMA_SHIFT;
+      RetStatus = false;
+   }
+   Link->EwmaShift = EwmaShift;
+
+   Link->Decay[0] = 65536;
+   for (i = 1; i < RX_LINK_MAX_AHEAD; i++)
+   {
+      Link->Decay[i] = Link->Decay[i-1] - (Link->Decay[i-1] >> EwmaShift);
+   }
+
+   return RetStatus;
+
+} /* End RX_LINK_Constructor() */
+
+
+/******************************************************************************
+** Function: RX_LINK_Update
+**
+** Notes:
+**   1. Only a sequence count ahead of the newest one contributes a PER
+**      sample. Duplicates, late frames and jumps of half the sequence
+**      space or more don't say how many frames were lost.
+**
+*/
+void RX_LINK_Update(RX_LINK_Class_t *Link, uint8_t Node, uint8_t Seq, uint8_t Len,
+                    int8_t Rssi, int8_t Snr, int64_t RxTimeNs)
+{
+
+   RX_LINK_Entry_t *Entry = &Link->Entry[Node];
+   uint8_t  Ahead;
+   uint32_t Per;
+
+   if (!Entry->Heard)
+   {
+      memset(Entry, 0, sizeof(RX_LINK_Entry_t));
+      Entry->Node       = Node;
+      Entry->HighSeq    = Seq;
+      Entry->Heard      = true;
+      Entry->Rssi       = (int16_t)(Rssi*16);
+      Entry->Snr        = (int16_t)(Snr*16);
+      Entry->FrameCnt   = 1;
+      Entry->ByteCnt    = Len;
+      Entry->LastSeenNs = RxTimeNs;
+      Link->Active[Link->ActiveCnt] = Node;
+      __atomic_store_n(&Link->ActiveCnt, Link->ActiveCnt + 1, __ATOMIC_RELEASE);
+      return;
+   }
+
+   Ahead = (uint8_t)(Seq - Entry->HighSeq);
+
+   BeginUpdate(Entry);
+
+   Entry->FrameCnt++;
+   Entry->ByteCnt   += Len;
+   Entry->LastSeenNs = RxTimeNs;
+   Entry->Rssi = (int16_t)EWMA(Entry->Rssi, Rssi*16, Link->EwmaShift);
+   Entry->Snr  = (int16_t)EWMA(Entry->Snr, Snr*16, Link->EwmaShift);
+   if (Ahead > 0 && Ahead < RX_LINK_MAX_AHEAD)
+   {
+      Per = RX_LINK_PER_ONE - (uint32_t)(((uint64_t)(RX_LINK_PER_ONE - Entry->Per)*Link->Decay[Ahead - 1]) >> 16);
+      Entry->Per      = (uint16_t)(Per - (Per >> Link->EwmaShift));
+      Entry->MissCnt += Ahead - 1;
+      Entry->HighSeq  = Seq;
+   }
+
+   EndUpdate(Entry);
+
+} /* End RX_LINK_Update() */
+
+
+/******************************************************************************
+** Function: RX_LINK_CrcError
+**
+*/
+void RX_LINK_CrcError(RX_LINK_Class_t *Link, uint8_t Node)
+{
+
+   RX_LINK_Entry_t *Entry = &Link->Entry[Node];
+
+   if (Entry->Heard)
+   {
+      BeginUpdate(Entry);
+      Entry->CrcErrCnt++;
+      EndUpdate(Entry);
+   }
+
+} /* End RX_LINK_CrcError() */
+
+
+/******************************************************************************
+** Function: RX_LINK_ActiveCnt
+**
+*/
+uint16_t RX_LINK_ActiveCnt(const RX_LINK_Class_t *Link)
+{
+
+   return __atomic_load_n(&Link->ActiveCnt, __ATOMIC_ACQUIRE);
+
+} /* End RX_LINK_ActiveCnt() */
+
+
+/******************************************************************************
+** Function: RX_LINK_Get
+**
+*/
+void RX_LINK_Get(RX_LINK_Class_t *Link, uint16_t Index, RX_LINK_Entry_t *Entry)
+{
+
+   const RX_LINK_Entry_t *Src = &Link->Entry[Link->Active[Index]];
+   uint32_t Lock;
+
+   do
+   {
+      Lock = __atomic_load_n(&Src->Lock, __ATOMIC_ACQUIRE);
+      memcpy(Entry, Src, sizeof(RX_LINK_Entry_t));
+      __atomic_thread_fence(__ATOMIC_ACQUIRE);
+   } while ((Lock & 1) || Lock != __atomic_load_n(&Src->Lock, __ATOMIC_RELAXED));
+
+} /* End RX_LINK_Get() */
+
+
+/******************************************************************************
+** Function: RX_LINK_ResetStatus
+**
+*/
+void RX_LINK_ResetStatus(RX_LINK_Class_t *Link)
+{
+
+   RX_LINK_Entry_t *Entry;
+   uint16_t i;
+
+   for (i = 0; i < RX_LINK_ActiveCnt(Link); i++)
+   {
+      Entry = &Link->Entry[Link->Active[i]];
+      Entry->FrameCnt  = 0;
+      Entry->ByteCnt   = 0;
+      Entry->CrcErrCnt = 0;
+      Entry->MissCnt   = 0;
+   }
+
+} /* End RX_LINK_ResetStatus() */
+
+
+/******************************************************************************
+** Function: BeginUpdate
+**
+*/
+static void BeginUpdate(RX_LINK_Entry_t *Entry)
+{
+
+   __atomic_store_n(&Entry->Lock, Entry->Lock + 1, __ATOMIC_RELAXED);
+   __atomic_thread_fence(__ATOMIC_RELEASE);
+
+} /* End BeginUpdate() */
+
+
+/******************************************************************************
+** Function: EndUpdate
+**
+*/
+static void EndUpdate(RX_LINK_Entry_t *Entry)
+{
+
+   __atomic_store_n(&Entry->Lock, Entry->Lock + 1, __ATOMIC_RELEASE);
+
+} /* End EndUpdate() */
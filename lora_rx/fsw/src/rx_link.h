@@ -0,0 +1,167 @@
+/*
+**  This program is free software: you can redistribute it and/or modify
+**  it under the terms of the GNU Lesser General Public License as
+**  published by the Free Software Foundation, either version 3 of the
+**  License, or (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Lesser General Public License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public License
+**  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+**
+**  Purpose:
+**    Define the per-node link statistics table
+**
+**  Notes:
+**    1. The table is indexed directly by the frame header's Node byte so
+**       an update is a single entry access regardless of how many nodes
+**       are heard. Nodes are listed in the order they were first heard so
+**       a reader can page through the active entries without scanning
+**       the table.
+**    2. RSSI and SNR are exponentially weighted moving averages kept in
+**       1/16 dB. The packet error ratio (PER) estimate is the same kind of
+**       average taken over the node's sequence counts, a sample of 1 for
+**       each count skipped and 0 for each frame received. A run of missed
+**       counts is applied in one step from a table of decay factors so
+**       the update cost doesn't depend on the run length. Frames lost to
+**       CRC errors are counted as missing, their sequence counts never
+**       arrive.
+**    3. A CRC errored frame's Node byte may itself be corrupted so CRC
+**       errors are only counted for nodes already in the table.
+**    4. The table is updated by one task and read by another. A node is
+**       published with a release store of ActiveCnt and each update is
+**       bracketed by the entry's sequence lock so a reader never sees a
+**       torn entry. The writer never waits.
+**    5. This header shouldn't include cFS or Lora_Rx app C header files.
+**
+*/
+
+#ifndef _rx_link_
+#define _rx_link_
+
+/*
+** Includes
+*/
+#include <stdbool.h>
+#include <stdint.h>
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define RX_LINK_NODES  256   /* One entry per Node byte value */
+
+#define RX_LINK_MAX_EWMA_SHIFT  8   /* Averages over 2^Shift frames */
+#define RX_LINK_DEF_EWMA_SHIFT  3
+
+#define RX_LINK_PER_ONE  65535   /* Fixed point PER of 1.0 */
+
+#define RX_LINK_MAX_AHEAD  128   /* Half the sequence space, larger jumps aren't losses */
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+
+typedef struct
+{
+   uint32_t Lock;        /* Odd while the writer updates the entry */
+   uint8_t  Node;
+   uint8_t  HighSeq;     /* Newest sequence count received */
+   bool     Heard;       /* Listed in RX_LINK_Class_t Active[] */
+   uint8_t  Spare;
+   int16_t  Rssi;        /* 1/16 dBm */
+   int16_t  Snr;         /* 1/16 dB */
+   uint16_t Per;         /* RX_LINK_PER_ONE is 1.0 */
+   uint32_t FrameCnt;
+   uint32_t ByteCnt;
+   uint32_t CrcErrCnt;
+   uint32_t MissCnt;     /* Sequence counts skipped ahead of in-order frames */
+   int64_t  LastSeenNs;  /* RxTimeNs of the newest frame, see radio_rx.h */
+
+} RX_LINK_Entry_t;
+
+
+typedef struct
+{
+   uint8_t  EwmaShift;
+   uint16_t ActiveCnt;
+   uint32_t Decay[RX_LINK_MAX_AHEAD];   /* (1 - 2^-EwmaShift)^i in 1/65536 */
+   uint8_t  Active[RX_LINK_NODES];   /* Node ids in the order first heard */
+   RX_LINK_Entry_t Entry[RX_LINK_NODES];
+
+} RX_LINK_Class_t;
+
+
+/************************/
+/** Exported Functions **/
+/************************/
+
+
+/******************************************************************************
+** Function: RX_LINK_Constructor
+**
+** Notes:
+**   1. Returns false and uses RX_LINK_DEF_EWMA_SHIFT if EwmaShift is
+**      greater than RX_LINK_MAX_EWMA_SHIFT.
+**
+*/
+bool RX_LINK_Constructor(RX_LINK_Class_t *Link, uint8_t EwmaShift);
+
+
+/******************************************************************************
+** Function: RX_LINK_Update
+**
+** Record a frame of Len bytes from Node
+**
+*/
+void RX_LINK_Update(RX_LINK_Class_t *Link, uint8_t Node, uint8_t Seq, uint8_t Len,
+                    int8_t Rssi, int8_t Snr, int64_t RxTimeNs);
+
+
+/******************************************************************************
+** Function: RX_LINK_CrcError
+**
+** Record a CRC errored frame whose header claims to be from Node
+**
+** Notes:
+**   1. Ignored if Node isn't in the table, see note 3 above.
+**
+*/
+void RX_LINK_CrcError(RX_LINK_Class_t *Link, uint8_t Node);
+
+
+/******************************************************************************
+** Function: RX_LINK_ActiveCnt
+**
+*/
+uint16_t RX_LINK_ActiveCnt(const RX_LINK_Class_t *Link);
+
+
+/******************************************************************************
+** Function: RX_LINK_Get
+**
+** Copy the entry of the Index'th node heard
+**
+** Notes:
+**   1. Index is less than RX_LINK_ActiveCnt(). May be called from any task.
+**
+*/
+void RX_LINK_Get(RX_LINK_Class_t *Link, uint16_t Index, RX_LINK_Entry_t *Entry);
+
+
+/******************************************************************************
+** Function: RX_LINK_ResetStatus
+**
+** Zero the per-node counters, the averages and the node list are kept
+**
+*/
+void RX_LINK_ResetStatus(RX_LINK_Class_t *Link);
+
+
+#endif /* _rx_link_ */
@@ -0,0 +1,180 @@
+/*
+**  This program is free software: you can redistribute it and/or modify
+**  it under the terms of the GNU Lesser General Public License as
+**  published by the Free Software Foundation, either version 3 of the
+**  License, or (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Lesser General Public License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public License
+**  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+**
+**  Purpose:
+**    Implement the receive path memory arena and stack watermark
+**
+**  Notes:
+**    1. See rx_mem.h for details.
+**
+*/
+
+/*
+** Include Files:
+*/
+
+#define _GNU_SOURCE   /* pthread_getattr_np() */
+#include <pthread.h>
+#include <string.h>
+#include "rx_mem.h"
+
+
+/**********************/
+/** Global File Data **/
+/**********************/
+
+static uint8_t Arena[RX_MEM_ARENA_MAX_BYTES] __attribute__((aligned(RX_MEM_ALIGN)));
+
+static RX_MEM_ArenaStatus_t ArenaStatus;
+
+
+/******************************************************************************
+** Function: RX_MEM_ArenaInit
+**
+*/
+bool RX_MEM_ArenaInit(uint32_t Size)
+{
+
+   bool RetStatus = true;
+
+   if (Size > RX_MEM_ARENA_MAX_BYTES)
+   {
+      Size = RX_MEM_ARENA_MAX_BYTES;
+      RetStatus = false;
+   }
+
+   memset(&ArenaStatus, 0, sizeof(RX_MEM_ArenaStatus_t));
+   ArenaStatus.Size = Size;
+
+   return RetStatus;
+
+} /* End RX_MEM_ArenaInit() */
+
+
+/******************************************************************************
+** Function: RX_MEM_Alloc
+**
+*/
+void *RX_MEM_Alloc(uint32_t Len)
+{
+
+   uint32_t AlignedLen = (Len + RX_MEM_ALIGN - 1) & ~(uint32_t)(RX_MEM_ALIGN - 1);
+   void *Block = NULL;
+
+   if (Len > 0 && AlignedLen >= Len && AlignedLen <= ArenaStatus.Size - ArenaStatus.Used)
+   {
+      Block = &Arena[ArenaStatus.Used];
+      memset(Block, 0, AlignedLen);
+      ArenaStatus.Used += AlignedLen;
+      ArenaStatus.AllocCnt++;
+   }
+   else
+   {
+      ArenaStatus.FailCnt++;
+      ArenaStatus.FailLen = Len;
+   }
+
+   return Block;
+
+} /* End RX_MEM_Alloc() */
+
+
+/******************************************************************************
+** Function: RX_MEM_GetArenaStatus
+**
+*/
+void RX_MEM_GetArenaStatus(RX_MEM_ArenaStatus_t *Status)
+{
+
+   memcpy(Status, &ArenaStatus, sizeof(RX_MEM_ArenaStatus_t));
+
+} /* End RX_MEM_GetArenaStatus() */
+
+
+/******************************************************************************
+** Function: RX_MEM_PaintStack
+**
+** Notes:
+**   1. pthread_attr_getstack() reports the usable stack, guard pages are
+**      excluded. The stack grows down so everything from the low address
+**      to just below this function's frame is unused.
+**
+*/
+void RX_MEM_PaintStack(RX_MEM_Stack_t *Stack)
+{
+
+   pthread_attr_t Attr;
+   void    *Addr;
+   size_t   Size;
+   uint8_t *Frame = (uint8_t *)__builtin_frame_address(0);
+
+   if (pthread_getattr_np(pthread_self(), &Attr) != 0)
+   {
+      return;
+   }
+
+   if (pthread_attr_getstack(&Attr, &Addr, &Size) == 0 &&
+       Frame - (uint8_t *)Addr > RX_MEM_STACK_GUARD && Frame < (uint8_t *)Addr + Size)
+   {
+      memset(Addr, RX_MEM_STACK_PATTERN, (size_t)(Frame - (uint8_t *)Addr) - RX_MEM_STACK_GUARD);
+      Stack->Low  = (uint8_t *)Addr;
+      Stack->High = (uint8_t *)Addr + Size;
+      __atomic_store_n(&Stack->Painted, true, __ATOMIC_RELEASE);
+   }
+
+   pthread_attr_destroy(&Attr);
+
+} /* End RX_MEM_PaintStack() */
+
+
+/******************************************************************************
+** Function: RX_MEM_StackSize
+**
+*/
+uint32_t RX_MEM_StackSize(const RX_MEM_Stack_t *Stack)
+{
+
+   if (!__atomic_load_n(&Stack->Painted, __ATOMIC_ACQUIRE))
+   {
+      return 0;
+   }
+
+   return (uint32_t)(Stack->High - Stack->Low);
+
+} /* End RX_MEM_StackSize() */
+
+
+/******************************************************************************
+** Function: RX_MEM_StackHighWater
+**
+** Notes:
+**   1. A used byte that happens to hold the pattern can hide at most the
+**      bytes above it, the scan stops at the first changed byte.
+**
+*/
+uint32_t RX_MEM_StackHighWater(const RX_MEM_Stack_t *Stack)
+{
+
+   const volatile uint8_t *Byte;
+
+   if (!__atomic_load_n(&Stack->Painted, __ATOMIC_ACQUIRE))
+   {
+      return 0;
+   }
+
+   for (Byte = Stack->Low; Byte < Stack->High && *Byte == RX_MEM_STACK_PATTERN; Byte++);
+
+   return (uint32_t)(Stack->High - (const uint8_t *)Byte);
+
+} /* End RX_MEM_StackHighWater() */
@@ -0,0 +1,149 @@
+/*
+**  This program is free software: you can redistribute it and/or modify
+**  it under the terms of the GNU Lesser General Public License as
+**  published by the Free Software Foundation, either version 3 of the
+**  License, or (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Lesser General Public License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public License
+**  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+**
+**  Purpose:
+**    Define the receive path memory arena and stack watermark
+**
+**  Notes:
+**    1. Every buffer the receive path needs is carved from one arena when
+**       the app initializes: the radio object, the frame slots, the
+**       deframer ring and the trace buffers. Sizes come from the JSON ini
+**       file. Nothing is freed and nothing is allocated from the heap
+**       afterwards so memory use is fixed for the life of the app.
+**    2. The arena is a static block of RX_MEM_ARENA_MAX_BYTES. The ini
+**       file's arena size is a budget within it, an allocation that
+**       doesn't fit the budget fails and is counted.
+**    3. Allocations are cache line aligned so buffers written by different
+**       tasks don't share a line.
+**    4. Stack watermarks fill the unused part of a task's stack with a
+**       pattern when the task starts. The deepest byte that no longer
+**       holds the pattern is the task's stack high water mark.
+**    5. Allocation is only done during initialization from one task, the
+**       arena has no lock.
+**    6. This header shouldn't include cFS or Lora_Rx app C header files.
+**
+*/
+
+#ifndef _rx_mem_
+#define _rx_mem_
+
+/*
+** Includes
+*/
+#include <stdbool.h>
+#include <stdint.h>
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define RX_MEM_ARENA_MAX_BYTES  (1024*1024)
+#define RX_MEM_ALIGN            64
+
+#define RX_MEM_STACK_PATTERN    0x5A
+#define RX_MEM_STACK_GUARD      1024   /* Bytes below the caller's frame that aren't painted */
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+
+typedef struct
+{
+   uint32_t Size;       /* Budget from the ini file */
+   uint32_t Used;       /* Never decreases so it's also the high water mark */
+   uint32_t AllocCnt;
+   uint32_t FailCnt;
+   uint32_t FailLen;    /* Size of the last failed allocation */
+
+} RX_MEM_ArenaStatus_t;
+
+
+typedef struct
+{
+   bool     Painted;    /* Set by the task after Low and High */
+   uint8_t *Low;
+   uint8_t *High;
+
+} RX_MEM_Stack_t;
+
+
+/************************/
+/** Exported Functions **/
+/************************/
+
+
+/******************************************************************************
+** Function: RX_MEM_ArenaInit
+**
+** Empty the arena and set its budget
+**
+** Notes:
+**   1. Size is limited to RX_MEM_ARENA_MAX_BYTES, returns false if it was.
+**
+*/
+bool RX_MEM_ArenaInit(uint32_t Size);
+
+
+/******************************************************************************
+** Function: RX_MEM_Alloc
+**
+** Return Len zeroed bytes from the arena or NULL if they don't fit
+**
+*/
+void *RX_MEM_Alloc(uint32_t Len);
+
+
+/******************************************************************************
+** Function: RX_MEM_GetArenaStatus
+**
+*/
+void RX_MEM_GetArenaStatus(RX_MEM_ArenaStatus_t *Status);
+
+
+/******************************************************************************
+** Function: RX_MEM_PaintStack
+**
+** Fill the calling task's unused stack with RX_MEM_STACK_PATTERN
+**
+** Notes:
+**   1. Must be called by the task that owns the stack, as early as
+**      possible. Does nothing if the stack bounds aren't available.
+**
+*/
+void RX_MEM_PaintStack(RX_MEM_Stack_t *Stack);
+
+
+/******************************************************************************
+** Function: RX_MEM_StackSize
+**
+*/
+uint32_t RX_MEM_StackSize(const RX_MEM_Stack_t *Stack);
+
+
+/******************************************************************************
+** Function: RX_MEM_StackHighWater
+**
+** Return the most stack bytes the task has used, 0 if it isn't painted
+**
+** Notes:
+**   1. May be called from any task.
+**
+*/
+uint32_t RX_MEM_StackHighWater(const RX_MEM_Stack_t *Stack);
+
+
+#endif /* _rx_mem_ */
@@ -0,0 +1,225 @@
+/*
+**  This program is free software: you can redistribute it and/or modify
+**  it under the terms of the GNU Lesser General Public License as
+**  published by the Free Software Foundation, either version 3 of the
+**  License, or (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Lesser General Public License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public License
+**  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+**
+**  Purpose:
+**    Implement the typed frame payload dispatcher
+**
+**  Notes:
+**    1. See rx_payload.h for details. A handler for a new frame type is a
+**       PayloadHandler specialization with a static Handle() function,
+**       the dispatch table picks it up when it's compiled.
+**
+*/
+
+/*
+** Include Files:
+*/
+
+#include <string.h>
+#include <array>
+#include <utility>
+extern "C"
+{
+   #include "rx_payload.h"
+   #include "rx_evt.h"
+}
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define CCSDS_PRI_HDR_LEN   6
+#define CCSDS_VERSION_MASK  0xE0
+#define CCSDS_CMD_TYPE      0x10
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+typedef bool (*Handler_t)(RX_PAYLOAD_Class_t *Payload, const RX_PAYLOAD_Frame_t *Frame);
+
+
+/******************************************************************************
+** Payload parsing helpers
+*/
+
+static inline uint32_t GetUint32(const uint8_t *Data)
+{
+   return ((uint32_t)Data[0] << 24) | ((uint32_t)Data[1] << 16) | ((uint32_t)Data[2] << 8) | Data[3];
+}
+
+/* True if the payload is exactly one CCSDS packet of the requested type */
+static inline bool WholePacket(const RX_PAYLOAD_Frame_t *Frame, bool Command)
+{
+   return (Frame->Len >= CCSDS_PRI_HDR_LEN + 1 &&
+           (Frame->Data[0] & CCSDS_VERSION_MASK) == 0 &&
+           ((Frame->Data[0] & CCSDS_CMD_TYPE) != 0) == Command &&
+           (uint32_t)((Frame->Data[4] << 8) | Frame->Data[5]) + CCSDS_PRI_HDR_LEN + 1 == Frame->Len);
+}
+
+static bool DeliverPkt(RX_PAYLOAD_Class_t *Payload, RX_PAYLOAD_PktFunc_t Sink,
+                       const RX_PAYLOAD_Frame_t *Frame, bool Command)
+{
+   if (Sink == NULL)
+   {
+      RX_EVT_COUNT(Payload->Stats.UnhandledCnt);
+      return false;
+   }
+   if (!WholePacket(Frame, Command))
+   {
+      RX_EVT_COUNT(Payload->Stats.InvalidCnt);
+      return false;
+   }
+   if (!Sink(Payload->SinkCtx, Frame->Node, Frame->Data, Frame->Len))
+   {
+      RX_EVT_COUNT(Payload->Stats.SinkErrCnt);
+      return false;
+   }
+   return true;
+}
+
+
+/******************************************************************************
+** Payload handlers
+**
+** The primary template is the handler of every type without a
+** specialization.
+*/
+
+template <uint8_t Type>
+struct PayloadHandler
+{
+   static constexpr bool Defined = false;
+
+   static bool Handle(RX_PAYLOAD_Class_t *Payload, const RX_PAYLOAD_Frame_t *)
+   {
+      RX_EVT_COUNT(Payload->Stats.UnhandledCnt);
+      return false;
+   }
+};
+
+
+template <>
+struct PayloadHandler<RX_FRAME_TYPE_RELAY>
+{
+   static constexpr bool Defined = true;
+
+   static bool Handle(RX_PAYLOAD_Class_t *Payload, const RX_PAYLOAD_Frame_t *Frame)
+   {
+      return DeliverPkt(Payload, Payload->Sinks.Relay, Frame, false);
+   }
+};
+
+
+template <>
+struct PayloadHandler<RX_FRAME_TYPE_TIME>
+{
+   static constexpr bool Defined = true;
+
+   static bool Handle(RX_PAYLOAD_Class_t *Payload, const RX_PAYLOAD_Frame_t *Frame)
+   {
+      if (Payload->Sinks.Time == NULL)
+      {
+         RX_EVT_COUNT(Payload->Stats.UnhandledCnt);
+         return false;
+      }
+      if (Frame->Len != RX_PAYLOAD_TIME_LEN)
+      {
+         RX_EVT_COUNT(Payload->Stats.InvalidCnt);
+         return false;
+      }
+      Payload->Sinks.Time(Payload->SinkCtx, Frame->Node, GetUint32(&Frame->Data[0]),
+                          GetUint32(&Frame->Data[4]), Frame->RxTimeNs);
+      return true;
+   }
+};
+
+
+template <>
+struct PayloadHandler<RX_FRAME_TYPE_COMMAND>
+{
+   static constexpr bool Defined = true;
+
+   static bool Handle(RX_PAYLOAD_Class_t *Payload, const RX_PAYLOAD_Frame_t *Frame)
+   {
+      return DeliverPkt(Payload, Payload->Sinks.Command, Frame, true);
+   }
+};
+
+
+/******************************************************************************
+** Dispatch table, one entry per frame type built from the handlers above
+*/
+
+template <size_t... Type>
+constexpr std::array<Handler_t, sizeof...(Type)> BuildTable(std::index_sequence<Type...>)
+{
+   return {{ &PayloadHandler<(uint8_t)Type>::Handle... }};
+}
+
+static constexpr std::array<Handler_t, RX_FRAME_TYPE_CNT> HandlerTable =
+   BuildTable(std::make_index_sequence<RX_FRAME_TYPE_CNT>());
+
+static_assert(!PayloadHandler<RX_FRAME_TYPE_PACKETS>::Defined, "The packet stream is deframed by the receive core");
+
+
+/******************************************************************************
+** Function: RX_PAYLOAD_Constructor
+**
+*/
+void RX_PAYLOAD_Constructor(RX_PAYLOAD_Class_t *Payload, const RX_PAYLOAD_Sinks_t *Sinks, void *SinkCtx)
+{
+
+   memset(Payload, 0, sizeof(RX_PAYLOAD_Class_t));
+
+   if (Sinks != NULL)
+   {
+      Payload->Sinks = *Sinks;
+   }
+   Payload->SinkCtx = SinkCtx;
+
+} /* End RX_PAYLOAD_Constructor() */
+
+
+/******************************************************************************
+** Function: RX_PAYLOAD_Dispatch
+**
+*/
+bool RX_PAYLOAD_Dispatch(RX_PAYLOAD_Class_t *Payload, const RX_PAYLOAD_Frame_t *Frame)
+{
+
+   bool Delivered = HandlerTable[Frame->Type & (RX_FRAME_TYPE_CNT - 1)](Payload, Frame);
+
+   if (Delivered)
+   {
+      RX_EVT_COUNT(Payload->Stats.FrameCnt[Frame->Type & (RX_FRAME_TYPE_CNT - 1)]);
+   }
+
+   return Delivered;
+
+} /* End RX_PAYLOAD_Dispatch() */
+
+
+/******************************************************************************
+** Function: RX_PAYLOAD_ResetStatus
+**
+*/
+void RX_PAYLOAD_ResetStatus(RX_PAYLOAD_Class_t *Payload)
+{
+
+   memset(&Payload->Stats, 0, sizeof(RX_PAYLOAD_Stats_t));
+
+} /* End RX_PAYLOAD_ResetStatus() */
@@ -0,0 +1,147 @@
+/*
+**  This program is free software: you can redistribute it and/or modify
+**  it under the terms of the GNU Lesser General Public License as
+**  published by the Free Software Foundation, either version 3 of the
+**  License, or (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Lesser General Public License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public License
+**  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+**
+**  Purpose:
+**    Define the typed frame payload dispatcher
+**
+**  Notes:
+**    1. Frames other than the packet stream carry one payload whose layout
+**       is set by the frame type, see rx_frame.h. After the security and
+**       decompression stages the receive core passes them here and the
+**       payload is parsed by the handler compiled in for its type.
+**    2. Handlers are C++ template specializations keyed by frame type in
+**       rx_payload.cpp. The dispatch table is built from them at compile
+**       time so a frame costs one indexed call whatever handlers exist,
+**       and adding a handler doesn't touch the path of other types.
+**       Types without a handler are counted as unhandled.
+**    3. A handler validates its payload and passes the parsed fields to
+**       the owner's sink for the type. A type whose sink is NULL is
+**       counted as unhandled so an owner only supplies what it services.
+**    4. Payload layouts, integers are big endian:
+**         RX_FRAME_TYPE_RELAY    One complete CCSDS telemetry packet
+**         RX_FRAME_TYPE_TIME     Seconds (4), subseconds (4): the sender's
+**                                mission time at the end of the frame
+**         RX_FRAME_TYPE_COMMAND  One complete CCSDS command packet
+**    5. Dispatch runs in the receive task like the rest of the core.
+**    6. This header shouldn't include cFS or Lora_Rx app C header files.
+**
+*/
+
+#ifndef _rx_payload_
+#define _rx_payload_
+
+/*
+** Includes
+*/
+#include <stdbool.h>
+#include <stdint.h>
+#include "rx_frame.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define RX_PAYLOAD_TIME_LEN  8
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+
+typedef struct
+{
+   uint8_t  Type;
+   uint8_t  Node;
+   uint16_t Len;
+   const uint8_t *Data;    /* Data field after security and decompression */
+   int64_t  RxTimeNs;      /* See RADIO_RX_Frame_t */
+
+} RX_PAYLOAD_Frame_t;
+
+
+/*
+** Sinks, called from the receive task. A packet sink returns false if the
+** packet couldn't be delivered.
+*/
+typedef bool (*RX_PAYLOAD_PktFunc_t)(void *SinkCtx, uint8_t Node, const uint8_t *Pkt, uint16_t Len);
+typedef void (*RX_PAYLOAD_TimeFunc_t)(void *SinkCtx, uint8_t Node, uint32_t Seconds, uint32_t Subseconds,
+                                      int64_t RxTimeNs);
+
+typedef struct
+{
+   RX_PAYLOAD_PktFunc_t  Relay;
+   RX_PAYLOAD_TimeFunc_t Time;
+   RX_PAYLOAD_PktFunc_t  Command;
+
+} RX_PAYLOAD_Sinks_t;
+
+
+typedef struct
+{
+   uint32_t FrameCnt[RX_FRAME_TYPE_CNT];   /* Payloads delivered per type */
+   uint32_t InvalidCnt;                    /* Payloads that failed their handler's checks */
+   uint32_t UnhandledCnt;                  /* No handler or sink for the type */
+   uint32_t SinkErrCnt;                    /* Sink couldn't deliver the payload */
+
+} RX_PAYLOAD_Stats_t;
+
+
+typedef struct
+{
+
+   RX_PAYLOAD_Sinks_t Sinks;
+   void *SinkCtx;
+
+   RX_PAYLOAD_Stats_t Stats;
+
+} RX_PAYLOAD_Class_t;
+
+
+/************************/
+/** Exported Functions **/
+/************************/
+
+
+/******************************************************************************
+** Function: RX_PAYLOAD_Constructor
+**
+** Notes:
+**   1. Sinks may be NULL, every payload is then counted as unhandled.
+**
+*/
+void RX_PAYLOAD_Constructor(RX_PAYLOAD_Class_t *Payload, const RX_PAYLOAD_Sinks_t *Sinks, void *SinkCtx);
+
+
+/******************************************************************************
+** Function: RX_PAYLOAD_Dispatch
+**
+** Pass a frame's payload to the handler for its type
+**
+** Notes:
+**   1. Returns true if the payload was delivered to a sink.
+**
+*/
+bool RX_PAYLOAD_Dispatch(RX_PAYLOAD_Class_t *Payload, const RX_PAYLOAD_Frame_t *Frame);
+
+
+/******************************************************************************
+** Function: RX_PAYLOAD_ResetStatus
+**
+*/
+void RX_PAYLOAD_ResetStatus(RX_PAYLOAD_Class_t *Payload);
+
+
+#endif /* _rx_payload_ */
@@ -0,0 +1,481 @@
+/*
+**  This program is free software: you can redistribute it and/or modify
+**  it under the terms of the GNU Lesser General Public License as
+**  published by the Free Software Foundation, either version 3 of the
+**  License, or (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Lesser General Public License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public License
+**  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+**
+**  Purpose:
+**    Implement the parallel decode worker pool
+**
+**  Notes:
+**    1. See rx_pool.h for details.
+**    2. A job's Done flag is stored by its worker before the worker reads
+**       Tail and Tail is stored by the receive task before it reads the
+**       next Done flag. Both are sequentially consistent so either the
+**       receive task sees the job decoded or the worker sees its job is
+**       the oldest and wakes the receive task.
+**
+*/
+
+/*
+** Include Files:
+*/
+
+#include <errno.h>
+#include <string.h>
+#include <time.h>
+#include "rx_pool.h"
+#include "rx_evt.h"
+
+
+/*******************************/
+/** Local Function Prototypes **/
+/*******************************/
+
+static void *WorkerMain(void *Arg);
+static bool TakeJob(RX_POOL_Class_t *Pool, RX_POOL_Worker_t *Worker, uint32_t *Seq);
+static bool QueuePop(RX_POOL_Queue_t *Queue, uint32_t *Seq);
+static int64_t SteadyNs(void);
+
+
+/******************************************************************************
+** Function: RX_POOL_Constructor
+**
+*/
+void RX_POOL_Constructor(RX_POOL_Class_t *Pool)
+{
+
+   memset(Pool, 0, sizeof(RX_POOL_Class_t));
+
+} /* End RX_POOL_Constructor() */
+
+
+/******************************************************************************
+** Function: RX_POOL_Start
+**
+*/
+bool RX_POOL_Start(RX_POOL_Class_t *Pool, uint8_t WorkerCnt, uint16_t Depth,
+                   RX_POOL_DecodeFunc_t DecodeFunc, RX_POOL_WakeFunc_t WakeFunc, void *Ctx)
+{
+
+   pthread_condattr_t CondAttr;
+   uint8_t i;
+
+   if (Pool->Running || WorkerCnt == 0 || WorkerCnt > RX_POOL_MAX_WORKERS ||
+       Depth == 0 || Depth > RX_POOL_MAX_DEPTH || (Depth & (Depth - 1)) != 0 ||
+       DecodeFunc == NULL)
+   {
+      return false;
+   }
+
+   RX_POOL_Constructor(Pool);
+   Pool->Depth      = Depth;
+   Pool->DecodeFunc = DecodeFunc;
+   Pool->WakeFunc   = WakeFunc;
+   Pool->Ctx        = Ctx;
+   Pool->SampleNs   = SteadyNs();
+
+   sem_init(&Pool->Ready, 0, 0);
+   pthread_mutex_init(&Pool->DoneLock, NULL);
+   pthread_condattr_init(&CondAttr);
+   pthread_condattr_setclock(&CondAttr, CLOCK_MONOTONIC);
+   pthread_cond_init(&Pool->DoneCond, &CondAttr);
+   pthread_condattr_destroy(&CondAttr);
+
+   Pool->Running = true;
+   for (i = 0; i < WorkerCnt; i++)
+   {
+      Pool->Worker[i].Pool = Pool;
+      Pool->Worker[i].Id   = i;
+      pthread_mutex_init(&Pool->Worker[i].Queue.Lock, NULL);
+      if (pthread_create(&Pool->Worker[i].Thread, NULL, WorkerMain, &Pool->Worker[i]) != 0)
+      {
+         pthread_mutex_destroy(&Pool->Worker[i].Queue.Lock);
+         RX_POOL_Stop(Pool);
+         return false;
+      }
+      Pool->WorkerCnt++;
+   }
+
+   return true;
+
+} /* End RX_POOL_Start() */
+
+
+/******************************************************************************
+** Function: RX_POOL_Stop
+**
+*/
+void RX_POOL_Stop(RX_POOL_Class_t *Pool)
+{
+
+   uint8_t i;
+
+   if (!Pool->Running)
+   {
+      return;
+   }
+
+   __atomic_store_n(&Pool->Stop, true, __ATOMIC_RELEASE);
+   for (i = 0; i < Pool->WorkerCnt; i++)
+   {
+      sem_post(&Pool->Ready);
+   }
+   for (i = 0; i < Pool->WorkerCnt; i++)
+   {
+      pthread_join(Pool->Worker[i].Thread, NULL);
+      pthread_mutex_destroy(&Pool->Worker[i].Queue.Lock);
+   }
+
+   pthread_cond_destroy(&Pool->DoneCond);
+   pthread_mutex_destroy(&Pool->DoneLock);
+   sem_destroy(&Pool->Ready);
+
+   Pool->Running   = false;
+   Pool->WorkerCnt = 0;
+   Pool->Head      = 0;
+   Pool->Tail      = 0;
+
+} /* End RX_POOL_Stop() */
+
+
+/******************************************************************************
+** Function: RX_POOL_Full
+**
+*/
+bool RX_POOL_Full(const RX_POOL_Class_t *Pool)
+{
+
+   return (Pool->Head - Pool->Tail >= Pool->Depth);
+
+} /* End RX_POOL_Full() */
+
+
+/******************************************************************************
+** Function: RX_POOL_Idle
+**
+*/
+bool RX_POOL_Idle(const RX_POOL_Class_t *Pool)
+{
+
+   return (Pool->Head == Pool->Tail);
+
+} /* End RX_POOL_Idle() */
+
+
+/******************************************************************************
+** Function: RX_POOL_NextSlot
+**
+*/
+uint32_t RX_POOL_NextSlot(const RX_POOL_Class_t *Pool)
+{
+
+   return Pool->Head & (Pool->Depth - 1);
+
+} /* End RX_POOL_NextSlot() */
+
+
+/******************************************************************************
+** Function: RX_POOL_Submit
+**
+*/
+bool RX_POOL_Submit(RX_POOL_Class_t *Pool)
+{
+
+   RX_POOL_Queue_t *Queue;
+   uint32_t Seq = Pool->Head;
+   uint32_t InFlight;
+
+   if (RX_POOL_Full(Pool))
+   {
+      RX_EVT_COUNT(Pool->Stats.FullCnt);
+      return false;
+   }
+
+   __atomic_store_n(&Pool->Done[Seq & (Pool->Depth - 1)], 0, __ATOMIC_RELAXED);
+   Pool->Head = Seq + 1;
+
+   Queue = &Pool->Worker[Pool->NextWorker].Queue;
+   Pool->NextWorker = (Pool->NextWorker + 1) % Pool->WorkerCnt;
+
+   pthread_mutex_lock(&Queue->Lock);
+   Queue->Seq[Queue->Head % RX_POOL_MAX_DEPTH] = Seq;
+   Queue->Head++;
+   pthread_mutex_unlock(&Queue->Lock);
+   sem_post(&Pool->Ready);
+
+   RX_EVT_COUNT(Pool->Stats.SubmitCnt);
+   InFlight = Pool->Head - Pool->Tail;
+   if (InFlight > Pool->Stats.MaxInFlight)
+   {
+      __atomic_store_n(&Pool->Stats.MaxInFlight, (uint16_t)InFlight, __ATOMIC_RELAXED);
+   }
+
+   return true;
+
+} /* End RX_POOL_Submit() */
+
+
+/******************************************************************************
+** Function: RX_POOL_Ready
+**
+*/
+bool RX_POOL_Ready(RX_POOL_Class_t *Pool, uint32_t *Slot)
+{
+
+   uint32_t TailSlot = Pool->Tail & (Pool->Depth - 1);
+
+   if (Pool->Head != Pool->Tail && __atomic_load_n(&Pool->Done[TailSlot], __ATOMIC_SEQ_CST))
+   {
+      *Slot = TailSlot;
+      return true;
+   }
+
+   return false;
+
+} /* End RX_POOL_Ready() */
+
+
+/******************************************************************************
+** Function: RX_POOL_WaitReady
+**
+*/
+bool RX_POOL_WaitReady(RX_POOL_Class_t *Pool, uint32_t TimeoutMs, uint32_t *Slot)
+{
+
+   struct timespec Deadline;
+   bool Ready;
+
+   if (Pool->Head == Pool->Tail)
+   {
+      return false;
+   }
+
+   clock_gettime(CLOCK_MONOTONIC, &Deadline);
+   Deadline.tv_sec  += TimeoutMs / 1000;
+   Deadline.tv_nsec += (long)(TimeoutMs % 1000) * 1000000;
+   if (Deadline.tv_nsec >= 1000000000)
+   {
+      Deadline.tv_sec++;
+      Deadline.tv_nsec -= 1000000000;
+   }
+
+   pthread_mutex_lock(&Pool->DoneLock);
+   while (!(Ready = RX_POOL_Ready(Pool, Slot)))
+   {
+      if (pthread_cond_timedwait(&Pool->DoneCond, &Pool->DoneLock, &Deadline) == ETIMEDOUT)
+      {
+         Ready = RX_POOL_Ready(Pool, Slot);
+         break;
+      }
+   }
+   pthread_mutex_unlock(&Pool->DoneLock);
+
+   return Ready;
+
+} /* End RX_POOL_WaitReady() */
+
+
+/******************************************************************************
+** Function: RX_POOL_Retire
+**
+*/
+void RX_POOL_Retire(RX_POOL_Class_t *Pool)
+{
+
+   if (Pool->Head != Pool->Tail)
+   {
+      __atomic_store_n(&Pool->Tail, Pool->Tail + 1, __ATOMIC_SEQ_CST);
+      RX_EVT_COUNT(Pool->Stats.RetireCnt);
+   }
+
+} /* End RX_POOL_Retire() */
+
+
+/******************************************************************************
+** Function: RX_POOL_SampleUtil
+**
+*/
+void RX_POOL_SampleUtil(RX_POOL_Class_t *Pool)
+{
+
+   RX_POOL_WorkerStats_t *Stats;
+   int64_t  Now = SteadyNs();
+   int64_t  ElapsedNs = Now - Pool->SampleNs;
+   uint64_t BusyNs;
+   uint64_t Pct;
+   uint8_t  i;
+
+   if (ElapsedNs <= 0)
+   {
+      return;
+   }
+
+   for (i = 0; i < Pool->WorkerCnt; i++)
+   {
+      Stats  = &Pool->Worker[i].Stats;
+      BusyNs = __atomic_load_n(&Stats->BusyNs, __ATOMIC_RELAXED);
+      Pct    = (BusyNs - Stats->SampleBusyNs) * 100 / (uint64_t)ElapsedNs;
+      Stats->UtilPct      = (Pct > 100) ? 100 : (uint8_t)Pct;
+      Stats->SampleBusyNs = BusyNs;
+   }
+   Pool->SampleNs = Now;
+
+} /* End RX_POOL_SampleUtil() */
+
+
+/******************************************************************************
+** Function: RX_POOL_ResetStatus
+**
+** Notes:
+**   1. Busy times aren't reset so the next utilization sample stays valid.
+**
+*/
+void RX_POOL_ResetStatus(RX_POOL_Class_t *Pool)
+{
+
+   uint8_t i;
+
+   for (i = 0; i < RX_POOL_MAX_WORKERS; i++)
+   {
+      __atomic_store_n(&Pool->Worker[i].Stats.JobCnt, 0, __ATOMIC_RELAXED);
+      __atomic_store_n(&Pool->Worker[i].Stats.StealCnt, 0, __ATOMIC_RELAXED);
+   }
+   memset(&Pool->Stats, 0, sizeof(RX_POOL_Stats_t));
+
+} /* End RX_POOL_ResetStatus() */
+
+
+/******************************************************************************
+** Function: WorkerMain
+**
+** Notes:
+**   1. Each semaphore count is one queued job so a woken worker always
+**      finds a job unless the pool is stopping.
+**
+*/
+static void *WorkerMain(void *Arg)
+{
+
+   RX_POOL_Worker_t *Worker = (RX_POOL_Worker_t *)Arg;
+   RX_POOL_Class_t  *Pool   = Worker->Pool;
+   uint32_t Seq;
+   int64_t  StartNs;
+
+   while (true)
+   {
+      if (sem_wait(&Pool->Ready) != 0)
+      {
+         continue;   /* EINTR */
+      }
+      if (__atomic_load_n(&Pool->Stop, __ATOMIC_ACQUIRE))
+      {
+         break;
+      }
+      if (!TakeJob(Pool, Worker, &Seq))
+      {
+         continue;
+      }
+
+      StartNs = SteadyNs();
+      Pool->DecodeFunc(Pool->Ctx, Seq & (Pool->Depth - 1));
+      __atomic_fetch_add(&Worker->Stats.BusyNs, (uint64_t)(SteadyNs() - StartNs), __ATOMIC_RELAXED);
+      RX_EVT_COUNT(Worker->Stats.JobCnt);
+
+      __atomic_store_n(&Pool->Done[Seq & (Pool->Depth - 1)], 1, __ATOMIC_SEQ_CST);
+      if (__atomic_load_n(&Pool->Tail, __ATOMIC_SEQ_CST) == Seq)
+      {
+         pthread_mutex_lock(&Pool->DoneLock);
+         pthread_cond_broadcast(&Pool->DoneCond);
+         pthread_mutex_unlock(&Pool->DoneLock);
+         if (Pool->WakeFunc != NULL)
+         {
+            Pool->WakeFunc(Pool->Ctx);
+         }
+      }
+      else
+      {
+         __atomic_fetch_add(&Pool->Stats.HeldCnt, 1, __ATOMIC_RELAXED);
+      }
+   } /* End while */
+
+   return NULL;
+
+} /* End WorkerMain() */
+
+
+/******************************************************************************
+** Function: TakeJob
+**
+** Take the oldest job from the worker's own queue or steal one
+**
+*/
+static bool TakeJob(RX_POOL_Class_t *Pool, RX_POOL_Worker_t *Worker, uint32_t *Seq)
+{
+
+   uint8_t i;
+
+   if (QueuePop(&Worker->Queue, Seq))
+   {
+      return true;
+   }
+
+   for (i = 1; i < Pool->WorkerCnt; i++)
+   {
+      if (QueuePop(&Pool->Worker[(Worker->Id + i) % Pool->WorkerCnt].Queue, Seq))
+      {
+         RX_EVT_COUNT(Worker->Stats.StealCnt);
+         return true;
+      }
+   }
+
+   return false;
+
+} /* End TakeJob() */
+
+
+/******************************************************************************
+** Function: QueuePop
+**
+*/
+static bool QueuePop(RX_POOL_Queue_t *Queue, uint32_t *Seq)
+{
+
+   bool Popped = false;
+
+   pthread_mutex_lock(&Queue->Lock);
+   if (Queue->Tail != Queue->Head)
+   {
+      *Seq = Queue->Seq[Queue->Tail % RX_POOL_MAX_DEPTH];
+      Queue->Tail++;
+      Popped = true;
+   }
+   pthread_mutex_unlock(&Queue->Lock);
+
+   return Popped;
+
+} /* End QueuePop() */
+
+
+/******************************************************************************
+** Function: SteadyNs
+**
+*/
+static int64_t SteadyNs(void)
+{
+
+   struct timespec Now;
+
+   clock_gettime(CLOCK_MONOTONIC, &Now);
+
+   return (int64_t)Now.tv_sec*1000000000 + Now.tv_nsec;
+
+} /* End SteadyNs() */
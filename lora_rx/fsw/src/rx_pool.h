@@ -0,0 +1,294 @@
+/*
+**  This program is free software: you can redistribute it and/or modify
+**  it under the terms of the GNU Lesser General Public License as
+**  published by the Free Software Foundation, either version 3 of the
+**  License, or (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Lesser General Public License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public License
+**  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+**
+**  Purpose:
+**    Define the parallel decode worker pool
+**
+**  Notes:
+**    1. The pool runs a frame's decode stages, decryption and
+**       decompression, on several worker threads while the receive task
+**       keeps the stages that depend on frame order. It doesn't know what
+**       a job is, the owner keeps a job array indexed by the slot numbers
+**       the pool hands out and supplies the decode function.
+**    2. Jobs are numbered in arrival order. The slot array is the reorder
+**       buffer: a job's slot is its sequence number modulo Depth and jobs
+**       are retired from the oldest slot only after it's decoded, so the
+**       output order always matches the arrival order no matter which
+**       worker finishes first. A full buffer stalls the receive task
+**       until the oldest job is decoded.
+**    3. Each worker has its own FIFO queue and jobs are dealt round robin.
+**       A counting semaphore holds one count per queued job. A woken
+**       worker takes the oldest job from its own queue and, if that's
+**       empty, steals the oldest job from the next non-empty queue so a
+**       slow job never leaves the other workers idle.
+**    4. The worker that decodes the oldest job calls the wake function so
+**       a receive task blocked waiting for a frame can retire it.
+**    5. Each worker accumulates the time it spends decoding. The
+**       utilization is the busy time between two RX_POOL_SampleUtil()
+**       calls as a percentage of the elapsed time.
+**    6. Submit, retire and wait functions are only called by the receive
+**       task. Statistics may be read by another task.
+**    7. This header shouldn't include cFS or Lora_Rx app C header files.
+**
+*/
+
+#ifndef _rx_pool_
+#define _rx_pool_
+
+/*
+** Includes
+*/
+#include <stdbool.h>
+#include <stdint.h>
+#include <pthread.h>
+#include <semaphore.h>
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define RX_POOL_MAX_WORKERS  4
+#define RX_POOL_MAX_DEPTH   64   /* Jobs in flight, a power of 2 */
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+
+/*
+** Decode the job in Slot. Called from a worker thread, jobs in different
+** slots are decoded concurrently.
+*/
+typedef void (*RX_POOL_DecodeFunc_t)(void *Ctx, uint32_t Slot);
+
+/*
+** Called from a worker thread when the oldest job is decoded
+*/
+typedef void (*RX_POOL_WakeFunc_t)(void *Ctx);
+
+
+typedef struct
+{
+   uint32_t JobCnt;       /* Jobs decoded                            */
+   uint32_t StealCnt;     /* Jobs taken from another worker's queue  */
+   uint64_t BusyNs;       /* Time spent decoding                     */
+   uint64_t SampleBusyNs; /* BusyNs at the last utilization sample   */
+   uint8_t  UtilPct;      /* Utilization over the last sample period */
+
+} RX_POOL_WorkerStats_t;
+
+
+typedef struct
+{
+   uint32_t SubmitCnt;
+   uint32_t RetireCnt;
+   uint32_t HeldCnt;      /* Jobs decoded while an older job was still in the buffer */
+   uint32_t FullCnt;      /* Submits that found the reorder buffer full            */
+   uint16_t MaxInFlight;
+
+} RX_POOL_Stats_t;
+
+
+typedef struct
+{
+   pthread_mutex_t Lock;
+   uint32_t Head;
+   uint32_t Tail;
+   uint32_t Seq[RX_POOL_MAX_DEPTH];
+
+} RX_POOL_Queue_t;
+
+
+struct RX_POOL_Class;
+
+typedef struct
+{
+   struct RX_POOL_Class *Pool;
+   uint8_t    Id;
+   pthread_t  Thread;
+   RX_POOL_Queue_t       Queue;
+   RX_POOL_WorkerStats_t Stats;
+
+} RX_POOL_Worker_t;
+
+
+/******************************************************************************
+** RX_POOL_Class
+*/
+typedef struct RX_POOL_Class
+{
+
+   bool     Running;
+   bool     Stop;
+   uint8_t  WorkerCnt;
+   uint16_t Depth;
+
+   RX_POOL_DecodeFunc_t DecodeFunc;
+   RX_POOL_WakeFunc_t   WakeFunc;
+   void    *Ctx;
+
+   sem_t    Ready;           /* One count per queued job */
+   pthread_mutex_t DoneLock;
+   pthread_cond_t  DoneCond;
+
+   uint32_t Head;            /* Next job sequence number */
+   uint32_t Tail;            /* Oldest job not retired   */
+   uint8_t  NextWorker;
+   uint8_t  Done[RX_POOL_MAX_DEPTH];
+
+   int64_t  SampleNs;
+
+   RX_POOL_Worker_t Worker[RX_POOL_MAX_WORKERS];
+   RX_POOL_Stats_t  Stats;
+
+} RX_POOL_Class_t;
+
+
+/************************/
+/** Exported Functions **/
+/************************/
+
+
+/******************************************************************************
+** Function: RX_POOL_Constructor
+**
+** Initialize the pool to a known stopped state
+**
+*/
+void RX_POOL_Constructor(RX_POOL_Class_t *Pool);
+
+
+/******************************************************************************
+** Function: RX_POOL_Start
+**
+** Start the worker threads
+**
+** Notes:
+**   1. Returns false if WorkerCnt is 0 or more than RX_POOL_MAX_WORKERS,
+**      Depth isn't a power of 2 up to RX_POOL_MAX_DEPTH or a thread can't
+**      be created. The pool is left stopped.
+**   2. WakeFunc may be NULL.
+**
+*/
+bool RX_POOL_Start(RX_POOL_Class_t *Pool, uint8_t WorkerCnt, uint16_t Depth,
+                   RX_POOL_DecodeFunc_t DecodeFunc, RX_POOL_WakeFunc_t WakeFunc, void *Ctx);
+
+
+/******************************************************************************
+** Function: RX_POOL_Stop
+**
+** Stop and join the worker threads
+**
+** Notes:
+**   1. Jobs that haven't been retired are discarded.
+**
+*/
+void RX_POOL_Stop(RX_POOL_Class_t *Pool);
+
+
+/******************************************************************************
+** Function: RX_POOL_Full
+**
+*/
+bool RX_POOL_Full(const RX_POOL_Class_t *Pool);
+
+
+/******************************************************************************
+** Function: RX_POOL_Idle
+**
+** Return true if no job is in flight
+**
+*/
+bool RX_POOL_Idle(const RX_POOL_Class_t *Pool);
+
+
+/******************************************************************************
+** Function: RX_POOL_NextSlot
+**
+** Return the slot the next submitted job must be written to
+**
+** Notes:
+**   1. Only valid while the pool isn't full.
+**
+*/
+uint32_t RX_POOL_NextSlot(const RX_POOL_Class_t *Pool);
+
+
+/******************************************************************************
+** Function: RX_POOL_Submit
+**
+** Queue the job written to RX_POOL_NextSlot() for decoding
+**
+** Notes:
+**   1. Returns false and counts the attempt if the pool is full.
+**
+*/
+bool RX_POOL_Submit(RX_POOL_Class_t *Pool);
+
+
+/******************************************************************************
+** Function: RX_POOL_Ready
+**
+** Return true and the oldest job's slot if it has been decoded
+**
+** Notes:
+**   1. The job stays in the reorder buffer until RX_POOL_Retire().
+**
+*/
+bool RX_POOL_Ready(RX_POOL_Class_t *Pool, uint32_t *Slot);
+
+
+/******************************************************************************
+** Function: RX_POOL_WaitReady
+**
+** Wait up to TimeoutMs for the oldest job to be decoded
+**
+** Notes:
+**   1. Returns false if no job is in flight or the wait timed out.
+**
+*/
+bool RX_POOL_WaitReady(RX_POOL_Class_t *Pool, uint32_t TimeoutMs, uint32_t *Slot);
+
+
+/******************************************************************************
+** Function: RX_POOL_Retire
+**
+** Release the oldest job's slot after its serial stages are done
+**
+*/
+void RX_POOL_Retire(RX_POOL_Class_t *Pool);
+
+
+/******************************************************************************
+** Function: RX_POOL_SampleUtil
+**
+** Update each worker's utilization, see note 5 above
+**
+** Notes:
+**   1. Must only be called from one task.
+**
+*/
+void RX_POOL_SampleUtil(RX_POOL_Class_t *Pool);
+
+
+/******************************************************************************
+** Function: RX_POOL_ResetStatus
+**
+*/
+void RX_POOL_ResetStatus(RX_POOL_Class_t *Pool);
+
+
+#endif /* _rx_pool_ */
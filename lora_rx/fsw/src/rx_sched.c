@@ -0,0 +1,313 @@
+/*
+**  This program is free software: you can redistribute it and/or modify
+**  it under the terms of the GNU Lesser General Public License as
+**  published by the Free Software Foundation, either version 3 of the
+**  License, or (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Lesser General Public License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public License
+**  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+**
+**  Purpose:
+**    Implement the time-tagged receive schedule
+**
+**  Notes:
+**    1. See rx_sched.h for details.
+**
+*/
+
+/*
+** Include Files:
+*/
+
+#include <string.h>
+#include "rx_sched.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define NS_PER_MS  1000000LL
+
+
+/*******************************/
+/** Local Function Prototypes **/
+/*******************************/
+
+static int64_t EntryEndNs(const RX_SCHED_Plan_t *Plan, uint16_t Index);
+static void Advance(RX_SCHED_Class_t *Sched, bool Applied);
+
+
+/******************************************************************************
+** Function: RX_SCHED_Constructor
+**
+*/
+void RX_SCHED_Constructor(RX_SCHED_Class_t *Sched, uint32_t LateLimitUs)
+{
+
+   memset(Sched, 0, sizeof(RX_SCHED_Class_t));
+
+   Sched->LateLimitUs     = LateLimitUs;
+   Sched->Stats.LastEntry = RX_SCHED_BASE;
+
+} /* End RX_SCHED_Constructor() */
+
+
+/******************************************************************************
+** Function: RX_SCHED_Load
+**
+*/
+bool RX_SCHED_Load(RX_SCHED_Class_t *Sched, const RX_SCHED_Plan_t *Plan)
+{
+
+   uint32_t Active  = __atomic_load_n(&Sched->ActivePlan, __ATOMIC_ACQUIRE);
+   uint32_t Pending = __atomic_load_n(&Sched->PendingPlan, __ATOMIC_ACQUIRE);
+
+   if (Pending != Active)
+   {
+      return false;
+   }
+
+   memcpy(&Sched->Plan[Active ^ 1], Plan, sizeof(RX_SCHED_Plan_t));
+   Sched->Stats.LoadCnt++;
+   __atomic_store_n(&Sched->PendingPlan, Active ^ 1, __ATOMIC_RELEASE);
+
+   return true;
+
+} /* End RX_SCHED_Load() */
+
+
+/******************************************************************************
+** Function: RX_SCHED_Check
+**
+*/
+int16_t RX_SCHED_Check(const RX_SCHED_Plan_t *Plan)
+{
+
+   uint16_t i;
+
+   for (i = 1; i < Plan->EntryCnt; i++)
+   {
+      if (Plan->Entry[i].StartNs <= Plan->Entry[i-1].StartNs)
+      {
+         return (int16_t)i;
+      }
+   }
+
+   return -1;
+
+} /* End RX_SCHED_Check() */
+
+
+/******************************************************************************
+** Function: RX_SCHED_Sync
+**
+** Notes:
+**   1. Busy is published before the plan switch so a task that sees the
+**      switch also sees the new plan's state.
+**
+*/
+void RX_SCHED_Sync(RX_SCHED_Class_t *Sched)
+{
+
+   uint32_t Pending = __atomic_load_n(&Sched->PendingPlan, __ATOMIC_ACQUIRE);
+
+   if (Pending != Sched->ActivePlan)
+   {
+      Sched->NextEntry  = 0;
+      Sched->RestoreDue = Sched->InEntry;
+      Sched->RestoreNs  = RX_SCHED_NOW;
+      __atomic_store_n(&Sched->Busy, Sched->RestoreDue || Sched->Plan[Pending].EntryCnt > 0, __ATOMIC_RELAXED);
+      __atomic_store_n(&Sched->ActivePlan, Pending, __ATOMIC_RELEASE);
+   }
+
+} /* End RX_SCHED_Sync() */
+
+
+/******************************************************************************
+** Function: RX_SCHED_NextAction
+**
+** Notes:
+**   1. A base restore is stale once the next entry has started, the entry
+**      replaces it.
+**
+*/
+bool RX_SCHED_NextAction(const RX_SCHED_Class_t *Sched, RX_SCHED_Action_t *Action)
+{
+
+   const RX_SCHED_Plan_t *Plan = &Sched->Plan[Sched->ActivePlan];
+   bool More = (Sched->NextEntry < Plan->EntryCnt);
+
+   if (Sched->RestoreDue)
+   {
+      Action->Entry = RX_SCHED_BASE;
+      Action->DueNs = Sched->RestoreNs;
+      Action->EndNs = More ? Plan->Entry[Sched->NextEntry].StartNs : RX_SCHED_NEVER;
+      Action->Def   = &Plan->BaseDef;
+      Action->Image = &Plan->BaseImage;
+   }
+   else if (More)
+   {
+      Action->Entry = (int16_t)Sched->NextEntry;
+      Action->DueNs = Plan->Entry[Sched->NextEntry].StartNs;
+      Action->EndNs = EntryEndNs(Plan, Sched->NextEntry);
+      Action->Def   = &Plan->Entry[Sched->NextEntry].Def;
+      Action->Image = &Plan->Entry[Sched->NextEntry].Image;
+   }
+
+   return (Sched->RestoreDue || More);
+
+} /* End RX_SCHED_NextAction() */
+
+
+/******************************************************************************
+** Function: RX_SCHED_Done
+**
+*/
+void RX_SCHED_Done(RX_SCHED_Class_t *Sched, int64_t LateNs, uint32_t SwitchUs)
+{
+
+   int32_t LateUs = (int32_t)(LateNs/1000);
+
+   Sched->Stats.ExecCnt++;
+   Sched->Stats.LastEntry    = Sched->RestoreDue ? RX_SCHED_BASE : (int16_t)Sched->NextEntry;
+   Sched->Stats.LastLateUs   = LateUs;
+   Sched->Stats.LastSwitchUs = SwitchUs;
+   if (LateUs > 0 && (uint32_t)LateUs > Sched->Stats.MaxLateUs)
+   {
+      Sched->Stats.MaxLateUs = (uint32_t)LateUs;
+   }
+   if (LateUs > 0 && (uint32_t)LateUs > Sched->LateLimitUs)
+   {
+      Sched->Stats.LateCnt++;
+   }
+   if (SwitchUs > Sched->Stats.MaxSwitchUs)
+   {
+      Sched->Stats.MaxSwitchUs = SwitchUs;
+   }
+
+   Advance(Sched, true);
+
+} /* End RX_SCHED_Done() */
+
+
+/******************************************************************************
+** Function: RX_SCHED_Skip
+**
+*/
+void RX_SCHED_Skip(RX_SCHED_Class_t *Sched)
+{
+
+   Sched->Stats.SkipCnt++;
+   Advance(Sched, false);
+
+} /* End RX_SCHED_Skip() */
+
+
+/******************************************************************************
+** Function: RX_SCHED_Busy
+**
+*/
+bool RX_SCHED_Busy(const RX_SCHED_Class_t *Sched)
+{
+
+   uint32_t Active  = __atomic_load_n(&Sched->ActivePlan, __ATOMIC_ACQUIRE);
+   uint32_t Pending = __atomic_load_n(&Sched->PendingPlan, __ATOMIC_ACQUIRE);
+
+   return (Pending != Active || __atomic_load_n(&Sched->Busy, __ATOMIC_ACQUIRE));
+
+} /* End RX_SCHED_Busy() */
+
+
+/******************************************************************************
+** Function: RX_SCHED_ResetStatus
+**
+*/
+void RX_SCHED_ResetStatus(RX_SCHED_Class_t *Sched)
+{
+
+   uint32_t LoadCnt = Sched->Stats.LoadCnt;
+
+   memset(&Sched->Stats, 0, sizeof(RX_SCHED_Stats_t));
+   Sched->Stats.LoadCnt   = LoadCnt;
+   Sched->Stats.LastEntry = RX_SCHED_BASE;
+
+} /* End RX_SCHED_ResetStatus() */
+
+
+/******************************************************************************
+** Function: EntryEndNs
+**
+** Return the time an entry stops being active
+**
+*/
+static int64_t EntryEndNs(const RX_SCHED_Plan_t *Plan, uint16_t Index)
+{
+
+   const RX_SCHED_Entry_t *Entry = &Plan->Entry[Index];
+   int64_t EndNs = RX_SCHED_NEVER;
+
+   if (Entry->DurationMs > 0)
+   {
+      EndNs = Entry->StartNs + (int64_t)Entry->DurationMs*NS_PER_MS;
+   }
+   if (Index + 1 < Plan->EntryCnt && Plan->Entry[Index+1].StartNs < EndNs)
+   {
+      EndNs = Plan->Entry[Index+1].StartNs;
+   }
+
+   return EndNs;
+
+} /* End EntryEndNs() */
+
+
+/******************************************************************************
+** Function: Advance
+**
+** Move past the next action
+**
+** Notes:
+**   1. A skipped entry leaves the radio as it was. If that was an earlier
+**      entry the base restore still follows the skipped entry's window.
+**
+*/
+static void Advance(RX_SCHED_Class_t *Sched, bool Applied)
+{
+
+   const RX_SCHED_Plan_t *Plan = &Sched->Plan[Sched->ActivePlan];
+   const RX_SCHED_Entry_t *Entry;
+   int64_t EndNs;
+
+   if (Sched->RestoreDue)
+   {
+      Sched->RestoreDue = false;
+      if (Applied)
+      {
+         Sched->InEntry = false;
+      }
+   }
+   else
+   {
+      Entry = &Plan->Entry[Sched->NextEntry];
+      EndNs = EntryEndNs(Plan, Sched->NextEntry);
+      Sched->NextEntry++;
+      if (Applied)
+      {
+         Sched->InEntry = true;
+      }
+      if (Sched->InEntry && Entry->DurationMs > 0 &&
+          (Sched->NextEntry >= Plan->EntryCnt || Plan->Entry[Sched->NextEntry].StartNs > EndNs))
+      {
+         Sched->RestoreDue = true;
+         Sched->RestoreNs  = EndNs;
+      }
+   }
+
+   __atomic_store_n(&Sched->Busy, Sched->RestoreDue || Sched->NextEntry < Plan->EntryCnt, __ATOMIC_RELEASE);
+
+} /* End Advance() */
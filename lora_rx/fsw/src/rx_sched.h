@@ -0,0 +1,236 @@
+/*
+**  This program is free software: you can redistribute it and/or modify
+**  it under the terms of the GNU Lesser General Public License as
+**  published by the Free Software Foundation, either version 3 of the
+**  License, or (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Lesser General Public License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public License
+**  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+**
+**  Purpose:
+**    Define the time-tagged receive schedule
+**
+**  Notes:
+**    1. A plan is a list of entries in start time order. Each entry holds
+**       a radio profile that was compiled when the plan was loaded, see
+**       RADIO_RX_CompileProfile(), so executing an entry is a single
+**       prevalidated command burst. An entry is active from its start
+**       time for its duration, a duration of 0 holds it until the next
+**       entry starts. The plan's base profile is restored when an entry
+**       ends before the next one starts.
+**    2. Times are mission nanoseconds, see RX_TIME_MissionNs(). The
+**       owner converts an action's time to the raw clock when it waits
+**       for it so corrections to the time fit are followed.
+**    3. The executor (the receive context) asks for the next action,
+**       waits until it's due, applies it and calls RX_SCHED_Done(). An
+**       action whose window has already passed is skipped with
+**       RX_SCHED_Skip() so a late load or a long outage doesn't replay
+**       stale entries.
+**    4. Plans are double buffered. RX_SCHED_Load() fills the inactive
+**       plan from any task and the executor switches plans in
+**       RX_SCHED_Sync(). A plan replacing one that's in the middle of an
+**       entry starts by restoring the base profile right away, a plan
+**       with no entries clears the schedule.
+**    5. This header shouldn't include cFS or Lora_Rx app C header files.
+**
+*/
+
+#ifndef _rx_sched_
+#define _rx_sched_
+
+/*
+** Includes
+*/
+#include <stdbool.h>
+#include <stdint.h>
+#include "radio_rx.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define RX_SCHED_MAX_ENTRIES  32
+
+#define RX_SCHED_NO_PROFILE  0xFF   /* Entry set by radio parameters */
+
+#define RX_SCHED_BASE   (-1)        /* Action entry index of the base profile */
+#define RX_SCHED_NOW    INT64_MIN   /* Action due time of a restore that isn't timed */
+#define RX_SCHED_NEVER  INT64_MAX   /* Action end time that never passes */
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+
+typedef struct
+{
+   int64_t  StartNs;       /* Mission time */
+   uint32_t DurationMs;    /* 0 holds the entry until the next one starts */
+   uint8_t  ProfileId;     /* Source profile table id or RX_SCHED_NO_PROFILE */
+   RADIO_RX_ProfileDef_t   Def;
+   RADIO_RX_ProfileImage_t Image;
+
+} RX_SCHED_Entry_t;
+
+
+typedef struct
+{
+   uint16_t EntryCnt;
+   RADIO_RX_ProfileDef_t   BaseDef;
+   RADIO_RX_ProfileImage_t BaseImage;
+   RX_SCHED_Entry_t Entry[RX_SCHED_MAX_ENTRIES];
+
+} RX_SCHED_Plan_t;
+
+
+typedef struct
+{
+   int16_t  Entry;         /* Entry index or RX_SCHED_BASE */
+   int64_t  DueNs;         /* Mission time the action is due or RX_SCHED_NOW */
+   int64_t  EndNs;         /* Mission time the action is stale, RX_SCHED_NEVER if it never is */
+   const RADIO_RX_ProfileDef_t   *Def;
+   const RADIO_RX_ProfileImage_t *Image;
+
+} RX_SCHED_Action_t;
+
+
+typedef struct
+{
+   uint32_t LoadCnt;
+   uint32_t ExecCnt;       /* Actions applied, entries and base restores */
+   uint32_t SkipCnt;       /* Actions whose window passed before they were due */
+   uint32_t LateCnt;       /* Actions applied later than the late limit */
+   int32_t  LastLateUs;    /* Applied minus due time, negative if early */
+   uint32_t MaxLateUs;
+   uint32_t LastSwitchUs;  /* Apply start until receiving */
+   uint32_t MaxSwitchUs;
+   int16_t  LastEntry;     /* Entry index of the last action, RX_SCHED_BASE for a restore */
+
+} RX_SCHED_Stats_t;
+
+
+typedef struct
+{
+   uint32_t ActivePlan;    /* Only written by the executor */
+   uint32_t PendingPlan;   /* Written by RX_SCHED_Load()   */
+   RX_SCHED_Plan_t Plan[2];
+
+   uint32_t LateLimitUs;
+   uint16_t NextEntry;     /* Next entry to apply */
+   bool     RestoreDue;    /* Base restore is the next action */
+   int64_t  RestoreNs;
+   bool     InEntry;       /* An entry's profile is applied */
+   bool     Busy;          /* Actions remain, published to other tasks */
+
+   RX_SCHED_Stats_t Stats;
+
+} RX_SCHED_Class_t;
+
+
+/************************/
+/** Exported Functions **/
+/************************/
+
+
+/******************************************************************************
+** Function: RX_SCHED_Constructor
+**
+** Notes:
+**   1. Actions applied more than LateLimitUs after they're due are counted
+**      as late.
+**
+*/
+void RX_SCHED_Constructor(RX_SCHED_Class_t *Sched, uint32_t LateLimitUs);
+
+
+/******************************************************************************
+** Function: RX_SCHED_Load
+**
+** Queue a plan for the executor
+**
+** Notes:
+**   1. Returns false if the previous load hasn't been picked up by
+**      RX_SCHED_Sync() yet, the plan isn't copied.
+**   2. Entries must be in start time order, see RX_SCHED_Check().
+**
+*/
+bool RX_SCHED_Load(RX_SCHED_Class_t *Sched, const RX_SCHED_Plan_t *Plan);
+
+
+/******************************************************************************
+** Function: RX_SCHED_Check
+**
+** Return the index of the first entry that doesn't start after the
+** previous one, or -1 if the plan is in order
+**
+*/
+int16_t RX_SCHED_Check(const RX_SCHED_Plan_t *Plan);
+
+
+/******************************************************************************
+** Function: RX_SCHED_Sync
+**
+** Switch to a pending plan. Must be called from the executor.
+**
+*/
+void RX_SCHED_Sync(RX_SCHED_Class_t *Sched);
+
+
+/******************************************************************************
+** Function: RX_SCHED_NextAction
+**
+** Get the next action, returns false if there's none. Must be called from
+** the executor.
+**
+*/
+bool RX_SCHED_NextAction(const RX_SCHED_Class_t *Sched, RX_SCHED_Action_t *Action);
+
+
+/******************************************************************************
+** Function: RX_SCHED_Done
+**
+** Record that the next action was applied LateNs after it was due and
+** took SwitchUs. Must be called from the executor.
+**
+*/
+void RX_SCHED_Done(RX_SCHED_Class_t *Sched, int64_t LateNs, uint32_t SwitchUs);
+
+
+/******************************************************************************
+** Function: RX_SCHED_Skip
+**
+** Drop the next action without applying it. Must be called from the
+** executor.
+**
+*/
+void RX_SCHED_Skip(RX_SCHED_Class_t *Sched);
+
+
+/******************************************************************************
+** Function: RX_SCHED_Busy
+**
+** Return true if a plan is pending or has actions left
+**
+** Notes:
+**   1. May be called from any task. Once it returns false the executor
+**      won't apply anything until the next RX_SCHED_Load().
+**
+*/
+bool RX_SCHED_Busy(const RX_SCHED_Class_t *Sched);
+
+
+/******************************************************************************
+** Function: RX_SCHED_ResetStatus
+**
+*/
+void RX_SCHED_ResetStatus(RX_SCHED_Class_t *Sched);
+
+
+#endif /* _rx_sched_ */
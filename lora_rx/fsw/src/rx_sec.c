@@ -0,0 +1,407 @@
+/*
+**  This program is free software: you can redistribute it and/or modify
+**  it under the terms of the GNU Lesser General Public License as
+**  published by the Free Software Foundation, either version 3 of the
+**  License, or (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Lesser General Public License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public License
+**  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+**
+**  Purpose:
+**    Implement the receive security stage class
+**
+**  Notes:
+**    1. See rx_sec.h for details.
+**
+*/
+
+/*
+** Include Files:
+*/
+
+#include <string.h>
+#include "rx_sec.h"
+
+
+/*******************************/
+/** Local Function Prototypes **/
+/*******************************/
+
+static RX_SEC_Status_Enum_t Decrypt(const RX_SEC_Class_t *Sec, uint8_t *Frame, uint16_t FrameLen,
+                                    bool CheckWindow, uint16_t *DataLen);
+static uint32_t FrameSeq(const uint8_t *Frame);
+static uint64_t KeyCheck(const AES_GCM_Ctx_t *Gcm);
+static bool SameKey(const RX_SEC_Window_t *Window, uint8_t KeyId, const RX_SEC_Key_t *Key);
+static bool WindowCheck(const RX_SEC_Window_t *Window, uint8_t KeyId, const RX_SEC_Key_t *Key, uint32_t Seq);
+static void WindowUpdate(RX_SEC_Window_t *Window, uint8_t KeyId, const RX_SEC_Key_t *Key, uint32_t Seq);
+
+
+/******************************************************************************
+** Function: RX_SEC_Constructor
+**
+*/
+void RX_SEC_Constructor(RX_SEC_Class_t *Sec, AES_GCM_Impl_Enum_t Impl)
+{
+
+   memset(Sec, 0, sizeof(RX_SEC_Class_t));
+
+   Sec->Impl = Impl;
+
+} /* End RX_SEC_Constructor() */
+
+
+/******************************************************************************
+** Function: RX_SEC_LoadKeys
+**
+*/
+bool RX_SEC_LoadKeys(RX_SEC_Class_t *Sec, const RX_SEC_KeyDef_t *KeyDef, uint16_t KeyCnt)
+{
+
+   uint32_t Active = __atomic_load_n(&Sec->ActiveBank, __ATOMIC_ACQUIRE);
+   uint32_t Bank   = Active ^ 1;
+   uint16_t i;
+
+   if (__atomic_load_n(&Sec->PendingBank, __ATOMIC_ACQUIRE) != Active)
+   {
+      return false;
+   }
+
+   for (i = 0; i < KeyCnt; i++)
+   {
+      if (KeyDef[i].Id >= RX_SEC_MAX_KEYS)
+      {
+         return false;
+      }
+   }
+
+   for (i = 0; i < RX_SEC_MAX_KEYS; i++)
+   {
+      AES_GCM_Wipe(&Sec->Key[Bank][i].Gcm);
+      Sec->Key[Bank][i].Loaded = false;
+   }
+
+   for (i = 0; i < KeyCnt; i++)
+   {
+      if (!AES_GCM_Init(&Sec->Key[Bank][KeyDef[i].Id].Gcm, KeyDef[i].Value, KeyDef[i].Len, Sec->Impl))
+      {
+         return false;
+      }
+      Sec->Key[Bank][KeyDef[i].Id].Check  = KeyCheck(&Sec->Key[Bank][KeyDef[i].Id].Gcm);
+      Sec->Key[Bank][KeyDef[i].Id].Loaded = true;
+   }
+
+   __atomic_store_n(&Sec->PendingBank, Bank, __ATOMIC_RELEASE);
+
+   return true;
+
+} /* End RX_SEC_LoadKeys() */
+
+
+/******************************************************************************
+** Function: RX_SEC_ResetStatus
+**
+*/
+void RX_SEC_ResetStatus(RX_SEC_Class_t *Sec)
+{
+
+   memset(&Sec->Stats, 0, sizeof(RX_SEC_Stats_t));
+
+} /* End RX_SEC_ResetStatus() */
+
+
+/******************************************************************************
+** Function: RX_SEC_Sync
+**
+** Notes:
+**   1. The previously active bank is wiped before the switch is published
+**      so RX_SEC_LoadKeys() can't start filling it while it's being wiped.
+**   2. The replay windows aren't cleared, a window restarts when its node
+**      changes keys, see rx_sec.h note 3.
+**
+*/
+void RX_SEC_Sync(RX_SEC_Class_t *Sec)
+{
+
+   uint32_t Pending = __atomic_load_n(&Sec->PendingBank, __ATOMIC_ACQUIRE);
+   uint32_t Old     = Sec->ActiveBank;
+   uint16_t i;
+
+   if (Pending != Old)
+   {
+      for (i = 0; i < RX_SEC_MAX_KEYS; i++)
+      {
+         AES_GCM_Wipe(&Sec->Key[Old][i].Gcm);
+         Sec->Key[Old][i].Loaded = false;
+      }
+      
+      __atomic_store_n(&Sec->ActiveBank, Pending, __ATOMIC_RELEASE);
+   }
+
+} /* End RX_SEC_Sync() */
+
+
+/******************************************************************************
+** Function: RX_SEC_SyncPending
+**
+*/
+bool RX_SEC_SyncPending(const RX_SEC_Class_t *Sec)
+{
+
+   return (__atomic_load_n(&Sec->PendingBank, __ATOMIC_ACQUIRE) != Sec->ActiveBank);
+
+} /* End RX_SEC_SyncPending() */
+
+
+/******************************************************************************
+** Function: RX_SEC_Verify
+**
+** Notes:
+**   1. The replay window is checked before the more expensive tag
+**      verification and only updated after it passes.
+**
+*/
+RX_SEC_Status_Enum_t RX_SEC_Verify(RX_SEC_Class_t *Sec, uint8_t *Frame, uint16_t FrameLen,
+                                   uint16_t *DataLen)
+{
+
+   return RX_SEC_Commit(Sec, Decrypt(Sec, Frame, FrameLen, true, DataLen), Frame);
+
+} /* End RX_SEC_Verify() */
+
+
+/******************************************************************************
+** Function: RX_SEC_Decrypt
+**
+*/
+RX_SEC_Status_Enum_t RX_SEC_Decrypt(const RX_SEC_Class_t *Sec, uint8_t *Frame, uint16_t FrameLen,
+                                    uint16_t *DataLen)
+{
+
+   return Decrypt(Sec, Frame, FrameLen, false, DataLen);
+
+} /* End RX_SEC_Decrypt() */
+
+
+/******************************************************************************
+** Function: RX_SEC_Commit
+**
+*/
+RX_SEC_Status_Enum_t RX_SEC_Commit(RX_SEC_Class_t *Sec, RX_SEC_Status_Enum_t Status,
+                                   const uint8_t *Frame)
+{
+
+   RX_SEC_Window_t *Window;
+   const RX_SEC_Key_t *Key;
+   uint8_t  KeyId;
+   uint32_t Seq;
+
+   if (Status == RX_SEC_OK)
+   {
+      Window = &Sec->Window[Frame[RX_FRAME_NODE_OFFSET]];
+      KeyId  = Frame[RX_FRAME_HDR_LEN];
+      Key    = &Sec->Key[Sec->ActiveBank][KeyId];
+      Seq    = FrameSeq(Frame);
+      if (WindowCheck(Window, KeyId, Key, Seq))
+      {
+         WindowUpdate(Window, KeyId, Key, Seq);
+      }
+      else
+      {
+         Status = RX_SEC_REPLAY;
+      }
+   }
+
+   switch (Status)
+   {
+      case RX_SEC_OK:        Sec->Stats.FrameCnt++;    break;
+      case RX_SEC_TOO_SHORT: Sec->Stats.ShortCnt++;    break;
+      case RX_SEC_NO_KEY:    Sec->Stats.NoKeyCnt++;    break;
+      case RX_SEC_REPLAY:    Sec->Stats.ReplayCnt++;   break;
+      case RX_SEC_AUTH_FAIL: Sec->Stats.AuthFailCnt++; break;
+   }
+
+   return Status;
+
+} /* End RX_SEC_Commit() */
+
+
+/******************************************************************************
+** Function: Decrypt
+**
+** Authenticate and decrypt a secured frame in place without changing the
+** stage's state
+**
+** Notes:
+**   1. CheckWindow rejects replayed frames before the tag is verified. It
+**      reads the replay windows so it's only used in the receive context.
+**
+*/
+static RX_SEC_Status_Enum_t Decrypt(const RX_SEC_Class_t *Sec, uint8_t *Frame, uint16_t FrameLen,
+                                    bool CheckWindow, uint16_t *DataLen)
+{
+
+   const uint8_t *SecHdr = &Frame[RX_FRAME_HDR_LEN];
+   const RX_SEC_Key_t *Key;
+   uint8_t  Iv[AES_GCM_IV_LEN];
+   uint8_t  KeyId;
+   uint8_t  Node;
+   uint16_t CipherLen;
+
+   if (FrameLen <= RX_FRAME_HDR_LEN + RX_SEC_OVERHEAD)
+   {
+      return RX_SEC_TOO_SHORT;
+   }
+
+   KeyId = SecHdr[0];
+   if (KeyId >= RX_SEC_MAX_KEYS || !Sec->Key[Sec->ActiveBank][KeyId].Loaded)
+   {
+      return RX_SEC_NO_KEY;
+   }
+   Key = &Sec->Key[Sec->ActiveBank][KeyId];
+
+   Node = Frame[RX_FRAME_NODE_OFFSET];
+   if (CheckWindow && !WindowCheck(&Sec->Window[Node], KeyId, Key, FrameSeq(Frame)))
+   {
+      return RX_SEC_REPLAY;
+   }
+
+   memset(Iv, 0, sizeof(Iv));
+   Iv[0] = Node;
+   Iv[1] = KeyId;
+   memcpy(&Iv[8], &SecHdr[1], 4);
+
+   CipherLen = FrameLen - RX_FRAME_HDR_LEN - RX_SEC_OVERHEAD;
+
+   if (!AES_GCM_Decrypt(&Key->Gcm, Iv, Frame, RX_FRAME_HDR_LEN + RX_SEC_HDR_LEN,
+                        &Frame[RX_FRAME_HDR_LEN + RX_SEC_HDR_LEN], CipherLen,
+                        &Frame[FrameLen - RX_SEC_TAG_LEN], RX_SEC_TAG_LEN))
+   {
+      return RX_SEC_AUTH_FAIL;
+   }
+
+   *DataLen = CipherLen;
+
+   return RX_SEC_OK;
+
+} /* End Decrypt() */
+
+
+/******************************************************************************
+** Function: FrameSeq
+**
+*/
+static uint32_t FrameSeq(const uint8_t *Frame)
+{
+
+   const uint8_t *SecHdr = &Frame[RX_FRAME_HDR_LEN];
+
+   return ((uint32_t)SecHdr[1] << 24) | ((uint32_t)SecHdr[2] << 16) |
+          ((uint32_t)SecHdr[3] << 8)  | SecHdr[4];
+
+} /* End FrameSeq() */
+
+
+/******************************************************************************
+** Function: KeyCheck
+**
+** Notes:
+**   1. Frame IVs have zeros in bytes 2-7 so the all ones IV is never used
+**      to encrypt a frame.
+**
+*/
+static uint64_t KeyCheck(const AES_GCM_Ctx_t *Gcm)
+{
+
+   uint8_t  Iv[AES_GCM_IV_LEN];
+   uint8_t  Tag[sizeof(uint64_t)];
+   uint64_t Check = 0;
+   uint16_t i;
+
+   memset(Iv, 0xFF, sizeof(Iv));
+   AES_GCM_Encrypt(Gcm, Iv, Iv, 0, Tag, 0, Tag, sizeof(Tag));
+
+   for (i = 0; i < sizeof(Tag); i++)
+   {
+      Check = (Check << 8) | Tag[i];
+   }
+
+   return Check;
+
+} /* End KeyCheck() */
+
+
+/******************************************************************************
+** Function: SameKey
+**
+** Return true if the window's frames were authenticated with this key
+**
+*/
+static bool SameKey(const RX_SEC_Window_t *Window, uint8_t KeyId, const RX_SEC_Key_t *Key)
+{
+
+   return (Window->Valid && Window->KeyId == KeyId && Window->KeyCheck == Key->Check);
+
+} /* End SameKey() */
+
+
+/******************************************************************************
+** Function: WindowCheck
+**
+** Return true if Seq is newer than the window or inside it and not yet seen
+**
+*/
+static bool WindowCheck(const RX_SEC_Window_t *Window, uint8_t KeyId, const RX_SEC_Key_t *Key, uint32_t Seq)
+{
+
+   uint32_t Age;
+
+   if (!SameKey(Window, KeyId, Key) || Seq > Window->Highest)
+   {
+      return true;
+   }
+
+   Age = Window->Highest - Seq;
+   if (Age >= RX_SEC_WINDOW_LEN)
+   {
+      return false;
+   }
+
+   return ((Window->Bitmap >> Age) & 1) == 0;
+
+} /* End WindowCheck() */
+
+
+/******************************************************************************
+** Function: WindowUpdate
+**
+*/
+static void WindowUpdate(RX_SEC_Window_t *Window, uint8_t KeyId, const RX_SEC_Key_t *Key, uint32_t Seq)
+{
+
+   uint32_t Shift;
+
+   if (!SameKey(Window, KeyId, Key))
+   {
+      Window->Valid    = true;
+      Window->KeyId    = KeyId;
+      Window->KeyCheck = Key->Check;
+      Window->Highest  = Seq;
+      Window->Bitmap   = 1;
+   }
+   else if (Seq > Window->Highest)
+   {
+      Shift = Seq - Window->Highest;
+      Window->Bitmap  = (Shift >= RX_SEC_WINDOW_LEN) ? 1 : ((Window->Bitmap << Shift) | 1);
+      Window->Highest = Seq;
+   }
+   else
+   {
+      Window->Bitmap |= (uint64_t)1 << (Window->Highest - Seq);
+   }
+
+} /* End WindowUpdate() */
@@ -0,0 +1,251 @@
+/*
+**  This program is free software: you can redistribute it and/or modify
+**  it under the terms of the GNU Lesser General Public License as
+**  published by the Free Software Foundation, either version 3 of the
+**  License, or (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Lesser General Public License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public License
+**  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+**
+**  Purpose:
+**    Define the receive security stage class
+**
+**  Notes:
+**    1. Frames with RX_FRAME_FLAG_SECURE set carry a security header after
+**       the frame header and an AES-GCM tag at the end of the frame:
+**
+**         | Frame Hdr | KeyId | SecSeq (32-bit BE) | Ciphertext | Tag |
+**
+**       The frame and security headers are authenticated as AAD. The
+**       ciphertext is the frame data field described in rx_frame.h.
+**    2. The 96-bit IV is Node | KeyId | 0 (6 bytes) | SecSeq so each
+**       transmitting node must never reuse a SecSeq with a key.
+**    3. Each node has a sliding bitmap anti-replay window. The window is
+**       only advanced by frames that pass authentication. It records the
+**       KeyId and key check value of the key that authenticated them and
+**       restarts when a frame from the node is authenticated by another
+**       KeyId or new key material, which starts a new sequence number
+**       space. Old keys should be removed from the key table once the
+**       nodes have switched, a frame replayed under a key that is still
+**       loaded restarts the window.
+**    4. Keys are double buffered. RX_SEC_LoadKeys() runs in the app's main
+**       task and fills the inactive bank. The receive context switches
+**       banks in RX_SEC_Sync(). The replay windows are kept so reloading
+**       the same keys doesn't re-accept old frames, and the owner may save
+**       and restore Window[] across restarts.
+**    5. The decode worker pool (rx_pool.h) splits verification in two.
+**       RX_SEC_Decrypt() authenticates and decrypts without changing the
+**       stage so it can run on several workers. RX_SEC_Commit() runs in
+**       the receive context in arrival order, checks and advances the
+**       replay window and counts the result. Keys may only be switched by
+**       RX_SEC_Sync() while no frame is being decrypted.
+**    6. This header shouldn't include cFS or Lora_Rx app C header files.
+**
+*/
+
+#ifndef _rx_sec_
+#define _rx_sec_
+
+/*
+** Includes
+*/
+#include "aes_gcm.h"
+#include "rx_frame.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define RX_SEC_HDR_LEN       5   /* KeyId + SecSeq */
+#define RX_SEC_TAG_LEN      16
+#define RX_SEC_OVERHEAD     (RX_SEC_HDR_LEN + RX_SEC_TAG_LEN)
+
+#define RX_SEC_MAX_KEYS      8   /* KeyId is an index into the key bank */
+#define RX_SEC_MAX_KEY_LEN  32
+#define RX_SEC_NODE_CNT    256
+#define RX_SEC_WINDOW_LEN   64   /* Anti-replay window width in frames */
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+typedef enum
+{
+   RX_SEC_OK        = 0,
+   RX_SEC_TOO_SHORT = 1,
+   RX_SEC_NO_KEY    = 2,
+   RX_SEC_REPLAY    = 3,
+   RX_SEC_AUTH_FAIL = 4
+
+} RX_SEC_Status_Enum_t;
+
+
+typedef struct
+{
+   uint8_t  Id;
+   uint8_t  Len;
+   uint8_t  Value[RX_SEC_MAX_KEY_LEN];
+
+} RX_SEC_KeyDef_t;
+
+
+typedef struct
+{
+   bool     Loaded;
+   uint64_t Check;    /* Identifies the key material, see RX_SEC_LoadKeys() */
+   AES_GCM_Ctx_t Gcm;
+
+} RX_SEC_Key_t;
+
+
+typedef struct
+{
+   bool     Valid;
+   uint8_t  KeyId;    /* Key the window's frames were authenticated with */
+   uint32_t Highest;
+   uint64_t Bitmap;   /* Bit n set: Highest-n was received */
+   uint64_t KeyCheck;
+
+} RX_SEC_Window_t;
+
+
+typedef struct
+{
+   uint32_t FrameCnt;     /* Frames authenticated and decrypted */
+   uint32_t ShortCnt;
+   uint32_t NoKeyCnt;
+   uint32_t ReplayCnt;
+   uint32_t AuthFailCnt;
+
+} RX_SEC_Stats_t;
+
+
+/******************************************************************************
+** RX_SEC_Class
+*/
+typedef struct
+{
+
+   AES_GCM_Impl_Enum_t Impl;
+
+   uint32_t ActiveBank;    /* Only written by the receive context */
+   uint32_t PendingBank;   /* Written by RX_SEC_LoadKeys()        */
+   RX_SEC_Key_t Key[2][RX_SEC_MAX_KEYS];
+
+   RX_SEC_Window_t Window[RX_SEC_NODE_CNT];
+
+   RX_SEC_Stats_t  Stats;
+
+} RX_SEC_Class_t;
+
+
+/************************/
+/** Exported Functions **/
+/************************/
+
+
+/******************************************************************************
+** Function: RX_SEC_Constructor
+**
+** Notes:
+**   1. No keys are loaded so every secured frame is rejected until
+**      RX_SEC_LoadKeys() is called.
+**
+*/
+void RX_SEC_Constructor(RX_SEC_Class_t *Sec, AES_GCM_Impl_Enum_t Impl);
+
+
+/******************************************************************************
+** Function: RX_SEC_LoadKeys
+**
+** Load a complete key set into the inactive bank
+**
+** Notes:
+**   1. Returns false if a previous load hasn't been applied by RX_SEC_Sync()
+**      or a key definition is invalid. The active keys are unchanged.
+**   2. Each key's check value is the first 8 bytes of the GMAC of an empty
+**      message with an IV no frame uses, so it identifies the key without
+**      exposing it or the GHASH subkey.
+**
+*/
+bool RX_SEC_LoadKeys(RX_SEC_Class_t *Sec, const RX_SEC_KeyDef_t *KeyDef, uint16_t KeyCnt);
+
+
+/******************************************************************************
+** Function: RX_SEC_ResetStatus
+**
+*/
+void RX_SEC_ResetStatus(RX_SEC_Class_t *Sec);
+
+
+/******************************************************************************
+** Function: RX_SEC_Sync
+**
+** Apply a pending key load. Must be called from the receive context.
+**
+*/
+void RX_SEC_Sync(RX_SEC_Class_t *Sec);
+
+
+/******************************************************************************
+** Function: RX_SEC_SyncPending
+**
+** Return true if a key load is waiting for RX_SEC_Sync()
+**
+*/
+bool RX_SEC_SyncPending(const RX_SEC_Class_t *Sec);
+
+
+/******************************************************************************
+** Function: RX_SEC_Verify
+**
+** Authenticate, replay check and decrypt a secured frame in place
+**
+** Notes:
+**   1. On success the plaintext data field starts at
+**      Frame[RX_FRAME_HDR_LEN + RX_SEC_HDR_LEN] and *DataLen is its length.
+**   2. Must be called from the receive context.
+**
+*/
+RX_SEC_Status_Enum_t RX_SEC_Verify(RX_SEC_Class_t *Sec, uint8_t *Frame, uint16_t FrameLen,
+                                   uint16_t *DataLen);
+
+
+/******************************************************************************
+** Function: RX_SEC_Decrypt
+**
+** Authenticate and decrypt a secured frame in place, see note 5 above
+**
+** Notes:
+**   1. The replay window isn't checked and no statistics are counted. The
+**      result must be passed to RX_SEC_Commit().
+**   2. May be called from several tasks at once.
+**
+*/
+RX_SEC_Status_Enum_t RX_SEC_Decrypt(const RX_SEC_Class_t *Sec, uint8_t *Frame, uint16_t FrameLen,
+                                    uint16_t *DataLen);
+
+
+/******************************************************************************
+** Function: RX_SEC_Commit
+**
+** Replay check and count a frame decrypted by RX_SEC_Decrypt()
+**
+** Notes:
+**   1. Returns RX_SEC_REPLAY if a decrypted frame was already received,
+**      otherwise Status.
+**   2. Must be called from the receive context in frame arrival order.
+**
+*/
+RX_SEC_Status_Enum_t RX_SEC_Commit(RX_SEC_Class_t *Sec, RX_SEC_Status_Enum_t Status,
+                                   const uint8_t *Frame);
+
+
+#endif /* _rx_sec_ */
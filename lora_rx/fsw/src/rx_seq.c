@@ -0,0 +1,256 @@
+/*
+**  This program is free software: you can redistribute it and/or modify
+**  it under the terms of the GNU Lesser General Public License as
+**  published by the Free Software Foundation, either version 3 of the
+**  License, or (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Lesser General Public License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public License
+**  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+**
+**  Purpose:
+**    Implement the per-node uplink sequence tracker
+**
+**  Notes:
+**    1. See rx_seq.h for details.
+**
+*/
+
+/*
+** Include Files:
+*/
+
+#include <string.h>
+#include "rx_seq.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define WINDOW_BIT(Window, i)  (((Window)[(i) >> 6] >> ((i) & 63)) & 1)
+
+
+/*******************************/
+/** Local Function Prototypes **/
+/*******************************/
+
+static void Advance(RX_SEQ_Node_t *Node, uint8_t Ahead);
+
+
+/******************************************************************************
+** Function: RX_SEQ_Constructor
+**
+*/
+void RX_SEQ_Constructor(RX_SEQ_Class_t *SeqTrk)
+{
+
+   memset(SeqTrk, 0, sizeof(RX_SEQ_Class_t));
+
+} /* End RX_SEQ_Constructor() */
+
+
+/******************************************************************************
+** Function: RX_SEQ_Update
+**
+*/
+void RX_SEQ_Update(RX_SEQ_Class_t *SeqTrk, uint8_t NodeId, uint8_t Seq)
+{
+
+   RX_SEQ_Node_t *Node;
+   uint8_t Index = SeqTrk->NodeIndex[NodeId];
+   uint8_t Ahead;
+   uint8_t Behind;
+
+   if (Index == 0)
+   {
+      if (SeqTrk->NodeCnt >= RX_SEQ_MAX_NODES)
+      {
+         SeqTrk->UntrackedCnt++;
+         return;
+      }
+      Node = &SeqTrk->Node[SeqTrk->NodeCnt];
+      memset(Node, 0, sizeof(RX_SEQ_Node_t));
+      Node->Node      = NodeId;
+      Node->HighSeq   = Seq;
+      Node->Span      = 1;
+      Node->Window[0] = 1;
+      Node->RxCnt     = 1;
+      SeqTrk->NodeIndex[NodeId] = SeqTrk->NodeCnt + 1;
+      __atomic_store_n(&SeqTrk->NodeCnt, SeqTrk->NodeCnt + 1, __ATOMIC_RELEASE);
+      return;
+   }
+
+   Node  = &SeqTrk->Node[Index - 1];
+   Ahead = (uint8_t)(Seq - Node->HighSeq);
+
+   __atomic_store_n(&SeqTrk->Lock, SeqTrk->Lock + 1, __ATOMIC_RELAXED);
+   __atomic_thread_fence(__ATOMIC_RELEASE);
+
+   Node->RxCnt++;
+   if (Ahead == 0)
+   {
+      Node->DupCnt++;
+   }
+   else if (Ahead < RX_SEQ_WINDOW)
+   {
+      Advance(Node, Ahead);
+      Node->HighSeq = Seq;
+   }
+   else
+   {
+      Behind = (uint8_t)(Node->HighSeq - Seq);
+      if (Behind < Node->Span)
+      {
+         if (WINDOW_BIT(Node->Window, Behind))
+         {
+            Node->DupCnt++;
+         }
+         else
+         {
+            Node->Window[Behind >> 6] |= (uint64_t)1 << (Behind & 63);
+            Node->LateCnt++;
+         }
+      }
+   }
+
+   __atomic_store_n(&SeqTrk->Lock, SeqTrk->Lock + 1, __ATOMIC_RELEASE);
+
+} /* End RX_SEQ_Update() */
+
+
+/******************************************************************************
+** Function: RX_SEQ_NodeCnt
+**
+*/
+uint8_t RX_SEQ_NodeCnt(const RX_SEQ_Class_t *SeqTrk)
+{
+
+   return __atomic_load_n(&SeqTrk->NodeCnt, __ATOMIC_ACQUIRE);
+
+} /* End RX_SEQ_NodeCnt() */
+
+
+/******************************************************************************
+** Function: RX_SEQ_GetNack
+**
+*/
+void RX_SEQ_GetNack(RX_SEQ_Class_t *SeqTrk, uint8_t Index, RX_SEQ_Nack_t *Nack)
+{
+
+   RX_SEQ_Node_t Node;
+   uint32_t Lock;
+   bool     Missing;
+   uint8_t  RunStart = 0;
+   uint8_t  RunLen = 0;
+   uint8_t  i;
+
+   do
+   {
+      Lock = __atomic_load_n(&SeqTrk->Lock, __ATOMIC_ACQUIRE);
+      memcpy(&Node, &SeqTrk->Node[Index], sizeof(RX_SEQ_Node_t));
+      __atomic_thread_fence(__ATOMIC_ACQUIRE);
+   } while ((Lock & 1) || Lock != __atomic_load_n(&SeqTrk->Lock, __ATOMIC_RELAXED));
+
+   memset(Nack, 0, sizeof(RX_SEQ_Nack_t));
+   Nack->Node    = Node.Node;
+   Nack->HighSeq = Node.HighSeq;
+   Nack->Span    = Node.Span;
+   Nack->RxCnt   = Node.RxCnt;
+   Nack->LateCnt = Node.LateCnt;
+   Nack->DupCnt  = Node.DupCnt;
+   Nack->LostCnt = Node.LostCnt;
+
+   /* Oldest to newest, HighSeq itself is always present */
+   for (i = Node.Span - 1; i > 0; i--)
+   {
+      Missing = !WINDOW_BIT(Node.Window, i);
+      if (Missing)
+      {
+         Nack->MissCnt++;
+         if (RunLen++ == 0)
+         {
+            RunStart = (uint8_t)(Node.HighSeq - i);
+         }
+      }
+      if (RunLen > 0 && (!Missing || i == 1))
+      {
+         if (Nack->RangeCnt < RX_SEQ_MAX_RANGES)
+         {
+            Nack->Range[Nack->RangeCnt].Start = RunStart;
+            Nack->Range[Nack->RangeCnt].Len   = RunLen;
+            Nack->RangeCnt++;
+         }
+         else
+         {
+            Nack->Truncated = true;
+         }
+         RunLen = 0;
+      }
+   }
+
+} /* End RX_SEQ_GetNack() */
+
+
+/******************************************************************************
+** Function: RX_SEQ_ResetStatus
+**
+*/
+void RX_SEQ_ResetStatus(RX_SEQ_Class_t *SeqTrk)
+{
+
+   uint8_t i;
+
+   SeqTrk->UntrackedCnt = 0;
+   for (i = 0; i < RX_SEQ_NodeCnt(SeqTrk); i++)
+   {
+      SeqTrk->Node[i].RxCnt   = 0;
+      SeqTrk->Node[i].LateCnt = 0;
+      SeqTrk->Node[i].DupCnt  = 0;
+      SeqTrk->Node[i].LostCnt = 0;
+   }
+
+} /* End RX_SEQ_ResetStatus() */
+
+
+/******************************************************************************
+** Function: Advance
+**
+** Move a node's window Ahead (1..127) sequences and mark the new HighSeq
+**
+** Notes:
+**   1. Missing positions pushed off the window are lost for good.
+**
+*/
+static void Advance(RX_SEQ_Node_t *Node, uint8_t Ahead)
+{
+
+   uint16_t i;
+
+   for (i = RX_SEQ_WINDOW - Ahead; i < Node->Span; i++)
+   {
+      if (!WINDOW_BIT(Node->Window, i))
+      {
+         Node->LostCnt++;
+      }
+   }
+
+   if (Ahead >= 64)
+   {
+      Node->Window[1] = Node->Window[0] << (Ahead - 64);
+      Node->Window[0] = 0;
+   }
+   else
+   {
+      Node->Window[1] = (Node->Window[1] << Ahead) | (Node->Window[0] >> (64 - Ahead));
+      Node->Window[0] = Node->Window[0] << Ahead;
+   }
+   Node->Window[0] |= 1;
+
+   Node->Span = (Node->Span + Ahead > RX_SEQ_WINDOW) ? RX_SEQ_WINDOW : Node->Span + Ahead;
+
+} /* End Advance() */
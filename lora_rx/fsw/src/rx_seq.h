@@ -0,0 +1,166 @@
+/*
+**  This program is free software: you can redistribute it and/or modify
+**  it under the terms of the GNU Lesser General Public License as
+**  published by the Free Software Foundation, either version 3 of the
+**  License, or (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Lesser General Public License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public License
+**  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+**
+**  Purpose:
+**    Define the per-node uplink sequence tracker
+**
+**  Notes:
+**    1. Every authenticated frame's sender Node and 8-bit sequence count
+**       update a 128 frame bitmap window for that node. Bit i of a window
+**       is set when sequence HighSeq - i was received, HighSeq being the
+**       newest sequence seen. Span counts the window positions at or
+**       after the node's first frame, older positions aren't missing.
+**    2. A sequence up to 127 ahead of HighSeq advances the window. Missing
+**       frames that fall off the end of the window are counted as lost.
+**       A sequence up to 127 behind fills its bit, it's a late frame or a
+**       retransmission.
+**    3. RX_SEQ_GetNack() compresses a node's window into ranges of
+**       consecutive missing sequences, oldest first because they're the
+**       first to fall off the window. A transmitter retransmits the
+**       ranges to fill the gaps.
+**    4. The tracker is updated by one task and read by another. Nodes are
+**       published with a release store of NodeCnt and each update is
+**       bracketed by a sequence lock so a reader never sees a torn window.
+**    5. This header shouldn't include cFS or Lora_Rx app C header files.
+**
+*/
+
+#ifndef _rx_seq_
+#define _rx_seq_
+
+/*
+** Includes
+*/
+#include <stdbool.h>
+#include <stdint.h>
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define RX_SEQ_MAX_NODES   8
+#define RX_SEQ_WINDOW      128   /* Frames tracked per node, half the sequence space */
+#define RX_SEQ_MAX_RANGES  8     /* Missing ranges reported per node */
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+
+typedef struct
+{
+   uint8_t  Start;     /* First missing sequence */
+   uint8_t  Len;       /* Consecutive missing sequences */
+
+} RX_SEQ_Range_t;
+
+
+typedef struct
+{
+   uint8_t  Node;
+   uint8_t  HighSeq;
+   uint8_t  Span;
+   uint8_t  RangeCnt;
+   bool     Truncated;  /* More ranges than RX_SEQ_MAX_RANGES, the newest weren't reported */
+   uint16_t MissCnt;    /* Missing sequences in the window */
+   uint32_t RxCnt;
+   uint32_t LateCnt;    /* Frames that filled a gap */
+   uint32_t DupCnt;
+   uint32_t LostCnt;    /* Missing frames that fell off the window */
+   RX_SEQ_Range_t Range[RX_SEQ_MAX_RANGES];
+
+} RX_SEQ_Nack_t;
+
+
+typedef struct
+{
+   uint8_t  Node;
+   uint8_t  HighSeq;
+   uint8_t  Span;
+   uint64_t Window[RX_SEQ_WINDOW/64];   /* Window[0] bit 0 is HighSeq */
+   uint32_t RxCnt;
+   uint32_t LateCnt;
+   uint32_t DupCnt;
+   uint32_t LostCnt;
+
+} RX_SEQ_Node_t;
+
+
+typedef struct
+{
+   uint32_t Lock;                /* Odd while the writer updates a node */
+   uint8_t  NodeCnt;
+   uint32_t UntrackedCnt;        /* Frames from nodes after the table filled */
+   uint8_t  NodeIndex[256];      /* Node id to Node[] index + 1, 0 if not tracked */
+   RX_SEQ_Node_t Node[RX_SEQ_MAX_NODES];
+
+} RX_SEQ_Class_t;
+
+
+/************************/
+/** Exported Functions **/
+/************************/
+
+
+/******************************************************************************
+** Function: RX_SEQ_Constructor
+**
+*/
+void RX_SEQ_Constructor(RX_SEQ_Class_t *SeqTrk);
+
+
+/******************************************************************************
+** Function: RX_SEQ_Update
+**
+** Record a frame from Node with sequence Seq
+**
+** Notes:
+**   1. Finding the node is a table lookup and the window update is a
+**      shift of two words, the cost doesn't depend on the node count.
+**
+*/
+void RX_SEQ_Update(RX_SEQ_Class_t *SeqTrk, uint8_t Node, uint8_t Seq);
+
+
+/******************************************************************************
+** Function: RX_SEQ_NodeCnt
+**
+*/
+uint8_t RX_SEQ_NodeCnt(const RX_SEQ_Class_t *SeqTrk);
+
+
+/******************************************************************************
+** Function: RX_SEQ_GetNack
+**
+** Build the selective NACK for the tracked node at Index
+**
+** Notes:
+**   1. Index is less than RX_SEQ_NodeCnt(). May be called from any task.
+**
+*/
+void RX_SEQ_GetNack(RX_SEQ_Class_t *SeqTrk, uint8_t Index, RX_SEQ_Nack_t *Nack);
+
+
+/******************************************************************************
+** Function: RX_SEQ_ResetStatus
+**
+** Zero the per-node counters, the windows are kept
+**
+*/
+void RX_SEQ_ResetStatus(RX_SEQ_Class_t *SeqTrk);
+
+
+#endif /* _rx_seq_ */
@@ -0,0 +1,271 @@
+/*
+**  This program is free software: you can redistribute it and/or modify
+**  it under the terms of the GNU Lesser General Public License as
+**  published by the Free Software Foundation, either version 3 of the
+**  License, or (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Lesser General Public License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public License
+**  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+**
+**  Purpose:
+**    Implement the RSSI spectrum sweep
+**
+**  Notes:
+**    1. See rx_sweep.h for details.
+**
+*/
+
+/*
+** Include Files:
+*/
+
+#include <string.h>
+#include "rx_sweep.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define REQ_NONE   0
+#define REQ_START  1
+#define REQ_STOP   2
+
+
+/******************************************************************************
+** Function: RX_SWEEP_Constructor
+**
+*/
+void RX_SWEEP_Constructor(RX_SWEEP_Class_t *Sweep)
+{
+
+   memset(Sweep, 0, sizeof(RX_SWEEP_Class_t));
+
+} /* End RX_SWEEP_Constructor() */
+
+
+/******************************************************************************
+** Function: RX_SWEEP_MakePlan
+**
+*/
+bool RX_SWEEP_MakePlan(uint32_t StartKHz, uint32_t StopKHz, uint32_t StepKHz,
+                       uint32_t SettleUs, RX_SWEEP_Plan_t *Plan)
+{
+
+   uint32_t StepCnt;
+
+   if (StartKHz < RX_SWEEP_MIN_KHZ || StopKHz > RX_SWEEP_MAX_KHZ || StopKHz < StartKHz ||
+       StepKHz == 0 || SettleUs > RX_SWEEP_MAX_SETTLE_US)
+   {
+      return false;
+   }
+
+   StepCnt = (StopKHz - StartKHz)/StepKHz + 1;
+   if (StepCnt > RX_SWEEP_MAX_STEPS)
+   {
+      return false;
+   }
+
+   Plan->StartKHz    = StartKHz;
+   Plan->StepKHz     = StepKHz;
+   Plan->SettleUs    = SettleUs;
+   Plan->StepCnt     = (uint16_t)StepCnt;
+   Plan->StepsPerBin = (uint16_t)((StepCnt + RX_SWEEP_MAX_BINS - 1)/RX_SWEEP_MAX_BINS);
+   Plan->BinCnt      = (uint16_t)((StepCnt + Plan->StepsPerBin - 1)/Plan->StepsPerBin);
+
+   return true;
+
+} /* End RX_SWEEP_MakePlan() */
+
+
+/******************************************************************************
+** Function: RX_SWEEP_Start
+**
+*/
+bool RX_SWEEP_Start(RX_SWEEP_Class_t *Sweep, const RX_SWEEP_Plan_t *Plan)
+{
+
+   if (__atomic_load_n(&Sweep->Request, __ATOMIC_ACQUIRE) != REQ_NONE)
+   {
+      return false;
+   }
+
+   Sweep->PendingPlan = *Plan;
+   __atomic_store_n(&Sweep->Request, REQ_START, __ATOMIC_RELEASE);
+
+   return true;
+
+} /* End RX_SWEEP_Start() */
+
+
+/******************************************************************************
+** Function: RX_SWEEP_Stop
+**
+*/
+bool RX_SWEEP_Stop(RX_SWEEP_Class_t *Sweep)
+{
+
+   if (__atomic_load_n(&Sweep->Request, __ATOMIC_ACQUIRE) != REQ_NONE)
+   {
+      return false;
+   }
+
+   __atomic_store_n(&Sweep->Request, REQ_STOP, __ATOMIC_RELEASE);
+
+   return true;
+
+} /* End RX_SWEEP_Stop() */
+
+
+/******************************************************************************
+** Function: RX_SWEEP_Sync
+**
+** Notes:
+**   1. A new plan starts a new row, bins from different plans aren't
+**      combined.
+**
+*/
+RX_SWEEP_Change_Enum_t RX_SWEEP_Sync(RX_SWEEP_Class_t *Sweep)
+{
+
+   RX_SWEEP_Change_Enum_t Change = RX_SWEEP_NO_CHANGE;
+   uint32_t Request = __atomic_load_n(&Sweep->Request, __ATOMIC_ACQUIRE);
+
+   if (Request == REQ_START)
+   {
+      Sweep->Plan = Sweep->PendingPlan;
+      memset(&Sweep->Accum, 0, sizeof(RX_SWEEP_Row_t));
+      Sweep->Accum.Plan = Sweep->Plan;
+      Sweep->Stats.StartCnt++;
+      __atomic_store_n(&Sweep->Active, true, __ATOMIC_RELEASE);
+      Change = RX_SWEEP_STARTED;
+   }
+   else if (Request == REQ_STOP && Sweep->Active)
+   {
+      __atomic_store_n(&Sweep->Active, false, __ATOMIC_RELEASE);
+      Change = RX_SWEEP_STOPPED;
+   }
+
+   if (Request != REQ_NONE)
+   {
+      __atomic_store_n(&Sweep->Request, REQ_NONE, __ATOMIC_RELEASE);
+   }
+
+   return Change;
+
+} /* End RX_SWEEP_Sync() */
+
+
+/******************************************************************************
+** Function: RX_SWEEP_AddSweep
+**
+** Notes:
+**   1. The raw RSSI is -2*dBm so the strongest step has the smallest
+**      value and a bin is 255 minus it.
+**
+*/
+void RX_SWEEP_AddSweep(RX_SWEEP_Class_t *Sweep, uint64_t SweepNs)
+{
+
+   const RX_SWEEP_Plan_t *Plan = &Sweep->Plan;
+   RX_SWEEP_Row_t *Accum = &Sweep->Accum;
+   uint16_t Step = 0;
+   uint16_t BinEnd;
+   uint16_t b;
+   uint8_t  Peak;
+   uint8_t  Level;
+
+   for (b = 0; b < Plan->BinCnt; b++)
+   {
+      BinEnd = Step + Plan->StepsPerBin;
+      if (BinEnd > Plan->StepCnt)
+      {
+         BinEnd = Plan->StepCnt;
+      }
+      Peak = 0xFF;
+      for (; Step < BinEnd; Step++)
+      {
+         if (Sweep->Rssi[Step] < Peak)
+         {
+            Peak = Sweep->Rssi[Step];
+         }
+      }
+      Level = (uint8_t)(0xFF - Peak);
+      if (Level > Accum->Bin[b])
+      {
+         Accum->Bin[b] = Level;
+      }
+   }
+
+   Accum->SweepCnt++;
+   Accum->StepCnt += Plan->StepCnt;
+   Accum->SweepNs += SweepNs;
+
+   Sweep->Stats.SweepCnt++;
+   Sweep->Stats.LastSweepUs = (uint32_t)(SweepNs/1000);
+
+   if (!__atomic_load_n(&Sweep->RowReady, __ATOMIC_ACQUIRE))
+   {
+      if (Accum->SweepNs > 0)
+      {
+         Sweep->Stats.StepsPerSec = (uint32_t)(((uint64_t)Accum->StepCnt*1000000000)/Accum->SweepNs);
+      }
+      memcpy(&Sweep->Row, Accum, sizeof(RX_SWEEP_Row_t));
+      __atomic_store_n(&Sweep->RowReady, 1, __ATOMIC_RELEASE);
+
+      memset(Accum, 0, sizeof(RX_SWEEP_Row_t));
+      Accum->Plan = Sweep->Plan;
+   }
+
+} /* End RX_SWEEP_AddSweep() */
+
+
+/******************************************************************************
+** Function: RX_SWEEP_TakeRow
+**
+*/
+bool RX_SWEEP_TakeRow(RX_SWEEP_Class_t *Sweep, RX_SWEEP_Row_t *Row)
+{
+
+   if (!__atomic_load_n(&Sweep->RowReady, __ATOMIC_ACQUIRE))
+   {
+      return false;
+   }
+
+   memcpy(Row, &Sweep->Row, sizeof(RX_SWEEP_Row_t));
+   Sweep->Stats.RowCnt++;
+   __atomic_store_n(&Sweep->RowReady, 0, __ATOMIC_RELEASE);
+
+   return true;
+
+} /* End RX_SWEEP_TakeRow() */
+
+
+/******************************************************************************
+** Function: RX_SWEEP_Busy
+**
+*/
+bool RX_SWEEP_Busy(const RX_SWEEP_Class_t *Sweep)
+{
+
+   return (__atomic_load_n(&Sweep->Request, __ATOMIC_ACQUIRE) != REQ_NONE ||
+           __atomic_load_n(&Sweep->Active, __ATOMIC_ACQUIRE));
+
+} /* End RX_SWEEP_Busy() */
+
+
+/******************************************************************************
+** Function: RX_SWEEP_ResetStatus
+**
+*/
+void RX_SWEEP_ResetStatus(RX_SWEEP_Class_t *Sweep)
+{
+
+   memset(&Sweep->Stats, 0, sizeof(RX_SWEEP_Stats_t));
+
+} /* End RX_SWEEP_ResetStatus() */
@@ -0,0 +1,236 @@
+/*
+**  This program is free software: you can redistribute it and/or modify
+**  it under the terms of the GNU Lesser General Public License as
+**  published by the Free Software Foundation, either version 3 of the
+**  License, or (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Lesser General Public License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public License
+**  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+**
+**  Purpose:
+**    Define the RSSI spectrum sweep
+**
+**  Notes:
+**    1. A sweep steps the radio across a band and samples the
+**       instantaneous RSSI at each step, see RADIO_RX_SweepRssi(). The
+**       steps are reduced to at most RX_SWEEP_MAX_BINS bins so a sweep is
+**       one compact waterfall row.
+**    2. Bins are 8-bit: dBm = Bin/2 - 127.5, the SX128x's 0.5 dB RSSI
+**       resolution. A bin holds the strongest step in it and a row holds
+**       the strongest of every sweep since the last row was taken, so a
+**       short burst isn't lost between telemetry rows.
+**    3. The executor (the receive context) runs the sweeps. Start and
+**       stop requests are queued from any task and picked up by
+**       RX_SWEEP_Sync(). Completed rows are passed back through a one row
+**       mailbox, the executor keeps accumulating until the consumer has
+**       taken the previous row.
+**    4. The sweep rate in steps per second is measured over the sweeps in
+**       each row and includes the SPI transfers, BUSY waits and settle
+**       time of every step.
+**    5. This header shouldn't include cFS or Lora_Rx app C header files.
+**
+*/
+
+#ifndef _rx_sweep_
+#define _rx_sweep_
+
+/*
+** Includes
+*/
+#include <stdbool.h>
+#include <stdint.h>
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define RX_SWEEP_MAX_STEPS  1024
+#define RX_SWEEP_MAX_BINS    128
+
+#define RX_SWEEP_MIN_KHZ       2400000
+#define RX_SWEEP_MAX_KHZ       2500000
+#define RX_SWEEP_MAX_SETTLE_US   10000
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+
+typedef enum
+{
+   RX_SWEEP_NO_CHANGE = 0,
+   RX_SWEEP_STARTED   = 1,
+   RX_SWEEP_STOPPED   = 2
+
+} RX_SWEEP_Change_Enum_t;
+
+
+typedef struct
+{
+   uint32_t StartKHz;
+   uint32_t StepKHz;
+   uint32_t SettleUs;      /* After tuning, before the RSSI is read */
+   uint16_t StepCnt;
+   uint16_t StepsPerBin;
+   uint16_t BinCnt;
+
+} RX_SWEEP_Plan_t;
+
+
+typedef struct
+{
+   RX_SWEEP_Plan_t Plan;
+   uint32_t SweepCnt;      /* Sweeps held in the bins */
+   uint32_t StepCnt;
+   uint64_t SweepNs;
+   uint8_t  Bin[RX_SWEEP_MAX_BINS];
+
+} RX_SWEEP_Row_t;
+
+
+typedef struct
+{
+   uint32_t StartCnt;
+   uint32_t SweepCnt;
+   uint32_t RowCnt;        /* Rows taken by the consumer */
+   uint32_t StepsPerSec;   /* Rate over the last row's sweeps */
+   uint32_t LastSweepUs;
+
+} RX_SWEEP_Stats_t;
+
+
+typedef struct
+{
+   uint32_t Request;       /* Written by RX_SWEEP_Start/Stop(), cleared by RX_SWEEP_Sync() */
+   RX_SWEEP_Plan_t PendingPlan;
+   bool     Active;        /* Only written by the executor, published to other tasks */
+
+   RX_SWEEP_Plan_t Plan;
+   uint8_t  Rssi[RX_SWEEP_MAX_STEPS];   /* Raw RSSI of the current sweep */
+   RX_SWEEP_Row_t Accum;
+
+   uint32_t RowReady;      /* Mailbox row is full */
+   RX_SWEEP_Row_t Row;
+
+   RX_SWEEP_Stats_t Stats;
+
+} RX_SWEEP_Class_t;
+
+
+/************************/
+/** Exported Functions **/
+/************************/
+
+
+/******************************************************************************
+** Function: RX_SWEEP_Constructor
+**
+*/
+void RX_SWEEP_Constructor(RX_SWEEP_Class_t *Sweep);
+
+
+/******************************************************************************
+** Function: RX_SWEEP_MakePlan
+**
+** Derive a sweep plan from a band in kHz
+**
+** Notes:
+**   1. Returns false if the band isn't within RX_SWEEP_MIN_KHZ to
+**      RX_SWEEP_MAX_KHZ, the step is 0, the band has more than
+**      RX_SWEEP_MAX_STEPS steps or SettleUs exceeds
+**      RX_SWEEP_MAX_SETTLE_US.
+**   2. The last step is at or below StopKHz.
+**
+*/
+bool RX_SWEEP_MakePlan(uint32_t StartKHz, uint32_t StopKHz, uint32_t StepKHz,
+                       uint32_t SettleUs, RX_SWEEP_Plan_t *Plan);
+
+
+/******************************************************************************
+** Function: RX_SWEEP_Start
+**
+** Queue a start request, a running sweep switches to the new plan
+**
+** Notes:
+**   1. Returns false if the previous request hasn't been picked up by
+**      RX_SWEEP_Sync() yet.
+**
+*/
+bool RX_SWEEP_Start(RX_SWEEP_Class_t *Sweep, const RX_SWEEP_Plan_t *Plan);
+
+
+/******************************************************************************
+** Function: RX_SWEEP_Stop
+**
+** Queue a stop request
+**
+** Notes:
+**   1. Returns false if the previous request hasn't been picked up by
+**      RX_SWEEP_Sync() yet.
+**
+*/
+bool RX_SWEEP_Stop(RX_SWEEP_Class_t *Sweep);
+
+
+/******************************************************************************
+** Function: RX_SWEEP_Sync
+**
+** Apply a queued request. Must be called from the executor.
+**
+** Notes:
+**   1. Returns the change the executor must make to the radio. A stop
+**      when no sweep is running isn't a change.
+**
+*/
+RX_SWEEP_Change_Enum_t RX_SWEEP_Sync(RX_SWEEP_Class_t *Sweep);
+
+
+/******************************************************************************
+** Function: RX_SWEEP_AddSweep
+**
+** Reduce the sweep in Rssi to bins and add it to the row. Must be called
+** from the executor.
+**
+*/
+void RX_SWEEP_AddSweep(RX_SWEEP_Class_t *Sweep, uint64_t SweepNs);
+
+
+/******************************************************************************
+** Function: RX_SWEEP_TakeRow
+**
+** Copy the completed row, returns false if there isn't one
+**
+** Notes:
+**   1. Must only be called by one consumer task.
+**
+*/
+bool RX_SWEEP_TakeRow(RX_SWEEP_Class_t *Sweep, RX_SWEEP_Row_t *Row);
+
+
+/******************************************************************************
+** Function: RX_SWEEP_Busy
+**
+** Return true if a sweep is running or a request is queued
+**
+** Notes:
+**   1. May be called from any task.
+**
+*/
+bool RX_SWEEP_Busy(const RX_SWEEP_Class_t *Sweep);
+
+
+/******************************************************************************
+** Function: RX_SWEEP_ResetStatus
+**
+*/
+void RX_SWEEP_ResetStatus(RX_SWEEP_Class_t *Sweep);
+
+
+#endif /* _rx_sweep_ */
@@ -0,0 +1,275 @@
+/*
+**  This program is free software: you can redistribute it and/or modify
+**  it under the terms of the GNU Lesser General Public License as
+**  published by the Free Software Foundation, either version 3 of the
+**  License, or (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Lesser General Public License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public License
+**  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+**
+**  Purpose:
+**    Implement the receive frame tap for local ground tools
+**
+**  Notes:
+**    1. See rx_tap.h for details.
+**
+*/
+
+/*
+** Include Files:
+*/
+
+#define _GNU_SOURCE   /* accept4() */
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include "rx_tap.h"
+
+
+/**********************/
+/** Global File Data **/
+/**********************/
+
+static RX_TAP_Ctrl_t *Ctrl = NULL;
+static RX_TAP_Slot_t *Slot = NULL;
+static uint32_t SlotMask;
+static uint64_t WriteSeq;
+
+static int ListenFd = -1;
+
+/*
+** A client slot is owned by RX_TAP_Service() while ClientFd is -1 or
+** ClientDead is set, otherwise by RX_TAP_Write(). The writer sets
+** ClientDead when a send fails and never touches the fd again, the
+** service task closes it, frees the slot and then clears ClientDead.
+*/
+static int  ClientFd[RX_TAP_MAX_CLIENTS];
+static bool ClientDead[RX_TAP_MAX_CLIENTS];
+
+static uint32_t FrameCnt;
+static uint32_t NotifyCnt;
+static uint32_t NotifyDropCnt;
+
+
+/******************************************************************************
+** Function: RX_TAP_Open
+**
+*/
+bool RX_TAP_Open(const char *ShmName, const char *SockPath, uint32_t SlotCnt)
+{
+
+   struct sockaddr_un Addr;
+   size_t MapLen = sizeof(RX_TAP_Ctrl_t) + (size_t)SlotCnt*sizeof(RX_TAP_Slot_t);
+   void  *Map;
+   int    ShmFd;
+   uint16_t i;
+
+   for (i = 0; i < RX_TAP_MAX_CLIENTS; i++)
+   {
+      ClientFd[i]   = -1;
+      ClientDead[i] = false;
+   }
+
+   if (SlotCnt == 0 || SlotCnt > RX_TAP_MAX_SLOTS || (SlotCnt & (SlotCnt - 1)) != 0 ||
+       strlen(SockPath) >= sizeof(Addr.sun_path))
+   {
+      return false;
+   }
+
+   shm_unlink(ShmName);
+   ShmFd = shm_open(ShmName, O_CREAT | O_EXCL | O_RDWR, 0644);
+   if (ShmFd < 0)
+   {
+      return false;
+   }
+   if (ftruncate(ShmFd, MapLen) != 0)
+   {
+      close(ShmFd);
+      shm_unlink(ShmName);
+      return false;
+   }
+   Map = mmap(NULL, MapLen, PROT_READ | PROT_WRITE, MAP_SHARED, ShmFd, 0);
+   close(ShmFd);
+   if (Map == MAP_FAILED)
+   {
+      shm_unlink(ShmName);
+      return false;
+   }
+
+   memset(&Addr, 0, sizeof(Addr));
+   Addr.sun_family = AF_UNIX;
+   strncpy(Addr.sun_path, SockPath, sizeof(Addr.sun_path) - 1);
+   unlink(SockPath);
+   ListenFd = socket(AF_UNIX, SOCK_SEQPACKET | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+   if (ListenFd < 0 || bind(ListenFd, (struct sockaddr *)&Addr, sizeof(Addr)) != 0 ||
+       listen(ListenFd, RX_TAP_MAX_CLIENTS) != 0)
+   {
+      if (ListenFd >= 0)
+      {
+         close(ListenFd);
+         ListenFd = -1;
+      }
+      munmap(Map, MapLen);
+      shm_unlink(ShmName);
+      return false;
+   }
+
+   /* Pages are already zero, readers check Magic last */
+   Ctrl = (RX_TAP_Ctrl_t *)Map;
+   Slot = (RX_TAP_Slot_t *)((uint8_t *)Map + sizeof(RX_TAP_Ctrl_t));
+   SlotMask = SlotCnt - 1;
+   WriteSeq = 0;
+   Ctrl->Version = RX_TAP_VERSION;
+   Ctrl->CtrlLen = sizeof(RX_TAP_Ctrl_t);
+   Ctrl->SlotLen = sizeof(RX_TAP_Slot_t);
+   Ctrl->SlotCnt = SlotCnt;
+   __atomic_store_n(&Ctrl->Magic, RX_TAP_MAGIC, __ATOMIC_RELEASE);
+
+   return true;
+
+} /* End RX_TAP_Open() */
+
+
+/******************************************************************************
+** Function: RX_TAP_Write
+**
+** Notes:
+**   1. The fence after marking the slot busy keeps the frame stores from
+**      becoming visible before the busy Seq, as in a sequence lock.
+**
+*/
+void RX_TAP_Write(const uint8_t *Data, uint8_t Len, int64_t RxTimeNs,
+                  int8_t Rssi, int8_t Snr, uint8_t Flags)
+{
+
+   RX_TAP_Slot_t *Next;
+   uint16_t i;
+   int      Fd;
+
+   if (Ctrl == NULL)
+   {
+      return;
+   }
+
+   Next = &Slot[WriteSeq & SlotMask];
+   __atomic_store_n(&Next->Seq, 2*WriteSeq + 1, __ATOMIC_RELAXED);
+   __atomic_thread_fence(__ATOMIC_RELEASE);
+
+   Next->RxTimeNs = RxTimeNs;
+   Next->Len      = Len;
+   Next->Rssi     = Rssi;
+   Next->Snr      = Snr;
+   Next->Flags    = Flags;
+   memcpy(Next->Data, Data, Len);
+
+   __atomic_store_n(&Next->Seq, 2*WriteSeq + 2, __ATOMIC_RELEASE);
+   WriteSeq++;
+   __atomic_store_n(&Ctrl->WriteSeq, WriteSeq, __ATOMIC_RELEASE);
+   __atomic_store_n(&FrameCnt, FrameCnt + 1, __ATOMIC_RELAXED);
+
+   for (i = 0; i < RX_TAP_MAX_CLIENTS; i++)
+   {
+      if (__atomic_load_n(&ClientDead[i], __ATOMIC_ACQUIRE))
+      {
+         continue;
+      }
+      Fd = __atomic_load_n(&ClientFd[i], __ATOMIC_ACQUIRE);
+      if (Fd < 0)
+      {
+         continue;
+      }
+      if (send(Fd, &WriteSeq, sizeof(WriteSeq), MSG_DONTWAIT | MSG_NOSIGNAL) == sizeof(WriteSeq))
+      {
+         __atomic_store_n(&NotifyCnt, NotifyCnt + 1, __ATOMIC_RELAXED);
+      }
+      else if (errno == EAGAIN || errno == EWOULDBLOCK)
+      {
+         __atomic_store_n(&NotifyDropCnt, NotifyDropCnt + 1, __ATOMIC_RELAXED);
+      }
+      else
+      {
+         __atomic_store_n(&ClientDead[i], true, __ATOMIC_RELEASE);
+      }
+   }
+
+} /* End RX_TAP_Write() */
+
+
+/******************************************************************************
+** Function: RX_TAP_Service
+**
+*/
+uint16_t RX_TAP_Service(void)
+{
+
+   uint16_t AcceptCnt = 0;
+   uint16_t i;
+   int      Fd;
+
+   if (ListenFd < 0)
+   {
+      return 0;
+   }
+
+   for (i = 0; i < RX_TAP_MAX_CLIENTS; i++)
+   {
+      if (__atomic_load_n(&ClientDead[i], __ATOMIC_ACQUIRE))
+      {
+         close(ClientFd[i]);
+         __atomic_store_n(&ClientFd[i], -1, __ATOMIC_RELAXED);
+         __atomic_store_n(&ClientDead[i], false, __ATOMIC_RELEASE);
+      }
+   }
+
+   for (i = 0; i < RX_TAP_MAX_CLIENTS; i++)
+   {
+      if (ClientFd[i] >= 0)
+      {
+         continue;
+      }
+      Fd = accept4(ListenFd, NULL, NULL, SOCK_NONBLOCK | SOCK_CLOEXEC);
+      if (Fd < 0)
+      {
+         break;
+      }
+      __atomic_store_n(&ClientFd[i], Fd, __ATOMIC_RELEASE);
+      AcceptCnt++;
+   }
+
+   return AcceptCnt;
+
+} /* End RX_TAP_Service() */
+
+
+/******************************************************************************
+** Function: RX_TAP_GetStatus
+**
+*/
+void RX_TAP_GetStatus(RX_TAP_Status_t *Status)
+{
+
+   uint16_t i;
+
+   Status->Open      = (Ctrl != NULL);
+   Status->ClientCnt = 0;
+   for (i = 0; i < RX_TAP_MAX_CLIENTS; i++)
+   {
+      if (ClientFd[i] >= 0 && !__atomic_load_n(&ClientDead[i], __ATOMIC_ACQUIRE))
+      {
+         Status->ClientCnt++;
+      }
+   }
+   Status->FrameCnt      = __atomic_load_n(&FrameCnt, __ATOMIC_RELAXED);
+   Status->NotifyCnt     = __atomic_load_n(&NotifyCnt, __ATOMIC_RELAXED);
+   Status->NotifyDropCnt = __atomic_load_n(&NotifyDropCnt, __ATOMIC_RELAXED);
+
+} /* End RX_TAP_GetStatus() */
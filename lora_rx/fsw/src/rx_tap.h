@@ -0,0 +1,169 @@
+/*
+**  This program is free software: you can redistribute it and/or modify
+**  it under the terms of the GNU Lesser General Public License as
+**  published by the Free Software Foundation, either version 3 of the
+**  License, or (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Lesser General Public License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public License
+**  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+**
+**  Purpose:
+**    Define the receive frame tap for local ground tools
+**
+**  Notes:
+**    1. The tap publishes every received frame and its metadata into a
+**       POSIX shared memory ring so processes on the same host (Python or
+**       GNU Radio tooling) can consume frames without the software bus.
+**       Readers map the ring read-only and read frames in place.
+**    2. The ring is an RX_TAP_Ctrl_t followed by SlotCnt RX_TAP_Slot_t.
+**       Frame n is written to slot n % SlotCnt. A slot's Seq is 2n+1
+**       while frame n is being written and 2n+2 when it's complete, and
+**       Ctrl.WriteSeq is the number of frames published. A reader that
+**       wants frame n checks Seq == 2n+2, reads the slot, then checks Seq
+**       again. A different Seq means the writer lapped the reader and the
+**       frame is lost to that reader.
+**    3. Readers connect to a SOCK_SEQPACKET Unix socket to be notified.
+**       Each notification is the uint64_t WriteSeq after a frame is
+**       published. Notifications are sent without blocking, a reader that
+**       doesn't drain its socket loses notifications, not frames, and
+**       should catch up from Ctrl.WriteSeq.
+**    4. The writer never waits on a reader: there are no locks and no
+**       reader state in the ring. A slow reader can't stall the radio.
+**    5. New clients are accepted and closed clients are released by
+**       RX_TAP_Service() from a different task than RX_TAP_Write(), so
+**       connections take effect within a service period.
+**    6. Multi-byte fields are in host byte order.
+**    7. This header shouldn't include cFS or Lora_Rx app C header files.
+**
+*/
+
+#ifndef _rx_tap_
+#define _rx_tap_
+
+/*
+** Includes
+*/
+#include <stdbool.h>
+#include <stdint.h>
+#include "rx_frame.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define RX_TAP_MAGIC        0x52585450   /* "RXTP" */
+#define RX_TAP_VERSION      1
+
+#define RX_TAP_MAX_SLOTS    4096         /* Slot count must be a power of 2 */
+#define RX_TAP_MAX_CLIENTS  4
+
+#define RX_TAP_FLAG_ACCEPTED  0x01       /* Frame passed the destination filter */
+#define RX_TAP_FLAG_CRC_ERR   0x02       /* Frame failed its CRC, see radio_rx.h */
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+
+/*
+** Ring control block at the start of the shared memory
+*/
+typedef struct
+{
+   uint32_t Magic;
+   uint16_t Version;
+   uint16_t CtrlLen;      /* sizeof(RX_TAP_Ctrl_t), slot 0 follows */
+   uint32_t SlotLen;      /* sizeof(RX_TAP_Slot_t) */
+   uint32_t SlotCnt;
+   uint64_t WriteSeq;     /* Frames published, updated after the slot */
+   uint8_t  Spare[40];    /* Keep WriteSeq's cache line to itself */
+
+} RX_TAP_Ctrl_t;
+
+
+typedef struct
+{
+   uint64_t Seq;          /* See note 2 */
+   int64_t  RxTimeNs;     /* CLOCK_MONOTONIC_RAW at RxDone */
+   uint8_t  Len;
+   int8_t   Rssi;         /* dBm */
+   int8_t   Snr;          /* dB */
+   uint8_t  Flags;
+   uint32_t Spare;
+   uint8_t  Data[RX_FRAME_MAX_LEN + 1];
+
+} RX_TAP_Slot_t;
+
+
+typedef struct
+{
+   bool     Open;
+   uint8_t  ClientCnt;
+   uint32_t FrameCnt;
+   uint32_t NotifyCnt;
+   uint32_t NotifyDropCnt;  /* Notifications a full client socket couldn't take */
+
+} RX_TAP_Status_t;
+
+
+/************************/
+/** Exported Functions **/
+/************************/
+
+
+/******************************************************************************
+** Function: RX_TAP_Open
+**
+** Create the shared memory ring and the notification socket
+**
+** Notes:
+**   1. ShmName is a shm_open() name ("/name"). Stale shared memory and
+**      socket files from a previous run are removed first.
+**   2. Returns false if SlotCnt isn't a power of 2 up to RX_TAP_MAX_SLOTS
+**      or either object can't be created, the tap stays closed.
+**
+*/
+bool RX_TAP_Open(const char *ShmName, const char *SockPath, uint32_t SlotCnt);
+
+
+/******************************************************************************
+** Function: RX_TAP_Write
+**
+** Publish a frame and notify the connected clients
+**
+** Notes:
+**   1. Called from a single task. Does nothing if the tap isn't open.
+**
+*/
+void RX_TAP_Write(const uint8_t *Data, uint8_t Len, int64_t RxTimeNs,
+                  int8_t Rssi, int8_t Snr, uint8_t Flags);
+
+
+/******************************************************************************
+** Function: RX_TAP_Service
+**
+** Accept new clients and release closed ones
+**
+** Notes:
+**   1. Must not be called from the RX_TAP_Write() task. Returns the
+**      number of clients accepted.
+**
+*/
+uint16_t RX_TAP_Service(void);
+
+
+/******************************************************************************
+** Function: RX_TAP_GetStatus
+**
+*/
+void RX_TAP_GetStatus(RX_TAP_Status_t *Status);
+
+
+#endif /* _rx_tap_ */
@@ -0,0 +1,275 @@
+/*
+**  This program is free software: you can redistribute it and/or modify
+**  it under the terms of the GNU Lesser General Public License as
+**  published by the Free Software Foundation, either version 3 of the
+**  License, or (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Lesser General Public License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public License
+**  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+**
+**  Purpose:
+**    Implement the receive time correlation class
+**
+**  Notes:
+**    1. See rx_time.h for details.
+**
+*/
+
+/*
+** Include Files:
+*/
+
+#include <string.h>
+#include "rx_time.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define NS_PER_SEC  1000000000LL
+
+
+/*******************************/
+/** Local Function Prototypes **/
+/*******************************/
+
+static void ComputeFit(RX_TIME_Class_t *Time, uint16_t SampleCnt, RX_TIME_Fit_t *Fit);
+static int64_t FitMissionNs(const RX_TIME_Fit_t *Fit, int64_t RawNs);
+
+
+/******************************************************************************
+** Function: RX_TIME_Constructor
+**
+*/
+void RX_TIME_Constructor(RX_TIME_Class_t *Time)
+{
+
+   memset(Time, 0, sizeof(RX_TIME_Class_t));
+
+} /* End RX_TIME_Constructor() */
+
+
+/******************************************************************************
+** Function: RX_TIME_AddSample
+**
+** Notes:
+**   1. The jump check uses the newest fit, which may not have been applied
+**      by the receive context yet.
+**
+*/
+void RX_TIME_AddSample(RX_TIME_Class_t *Time, int64_t RawNs, uint32_t Seconds, uint32_t Subseconds)
+{
+
+   uint32_t Active = __atomic_load_n(&Time->ActiveFit, __ATOMIC_ACQUIRE);
+   uint32_t Pending = __atomic_load_n(&Time->PendingFit, __ATOMIC_ACQUIRE);
+   const RX_TIME_Fit_t *LastFit = &Time->Fit[Pending];
+   int64_t  MissionNs = RX_TIME_MissionNs(Seconds, Subseconds);
+   int64_t  ErrorNs;
+   RX_TIME_Sample_t *Sample;
+
+   if (LastFit->Valid)
+   {
+      ErrorNs = MissionNs - FitMissionNs(LastFit, RawNs);
+      if (ErrorNs > RX_TIME_JUMP_NS || ErrorNs < -RX_TIME_JUMP_NS)
+      {
+         Time->Stats.SampleCnt = 0;
+         Time->Stats.JumpCnt++;
+      }
+   }
+
+   Sample = &Time->Sample[Time->NextSample];
+   Sample->RawNs     = RawNs;
+   Sample->MissionNs = MissionNs;
+   Time->NextSample  = (Time->NextSample + 1) % RX_TIME_FIT_SAMPLES;
+   if (Time->Stats.SampleCnt < RX_TIME_FIT_SAMPLES)
+   {
+      Time->Stats.SampleCnt++;
+   }
+
+   if (Pending != Active)
+   {
+      Time->Stats.SkipCnt++;
+      return;
+   }
+
+   ComputeFit(Time, Time->Stats.SampleCnt, &Time->Fit[Active ^ 1]);
+   Time->Stats.FitCnt++;
+
+   __atomic_store_n(&Time->PendingFit, Active ^ 1, __ATOMIC_RELEASE);
+
+} /* End RX_TIME_AddSample() */
+
+
+/******************************************************************************
+** Function: RX_TIME_ResetStatus
+**
+*/
+void RX_TIME_ResetStatus(RX_TIME_Class_t *Time)
+{
+
+   Time->Stats.FitCnt  = 0;
+   Time->Stats.SkipCnt = 0;
+   Time->Stats.JumpCnt = 0;
+
+} /* End RX_TIME_ResetStatus() */
+
+
+/******************************************************************************
+** Function: RX_TIME_Sync
+**
+*/
+void RX_TIME_Sync(RX_TIME_Class_t *Time)
+{
+
+   uint32_t Pending = __atomic_load_n(&Time->PendingFit, __ATOMIC_ACQUIRE);
+
+   if (Pending != Time->ActiveFit)
+   {
+      __atomic_store_n(&Time->ActiveFit, Pending, __ATOMIC_RELEASE);
+   }
+
+} /* End RX_TIME_Sync() */
+
+
+/******************************************************************************
+** Function: RX_TIME_ToMission
+**
+*/
+bool RX_TIME_ToMission(const RX_TIME_Class_t *Time, int64_t RawNs, uint32_t *Seconds, uint32_t *Subseconds)
+{
+
+   const RX_TIME_Fit_t *Fit = &Time->Fit[Time->ActiveFit];
+   int64_t MissionNs;
+
+   if (!Fit->Valid)
+   {
+      return false;
+   }
+
+   MissionNs   = FitMissionNs(Fit, RawNs);
+   *Seconds    = (uint32_t)(MissionNs / NS_PER_SEC);
+   *Subseconds = (uint32_t)(((uint64_t)(MissionNs % NS_PER_SEC) << 32) / NS_PER_SEC);
+
+   return true;
+
+} /* End RX_TIME_ToMission() */
+
+
+/******************************************************************************
+** Function: RX_TIME_ToRaw
+**
+*/
+bool RX_TIME_ToRaw(const RX_TIME_Class_t *Time, int64_t MissionNs, int64_t *RawNs)
+{
+
+   const RX_TIME_Fit_t *Fit = &Time->Fit[Time->ActiveFit];
+
+   if (!Fit->Valid)
+   {
+      return false;
+   }
+
+   *RawNs = Fit->RefRawNs + (int64_t)((double)(MissionNs - Fit->RefMissionNs)/Fit->Rate);
+
+   return true;
+
+} /* End RX_TIME_ToRaw() */
+
+
+/******************************************************************************
+** Function: RX_TIME_MissionNs
+**
+*/
+int64_t RX_TIME_MissionNs(uint32_t Seconds, uint32_t Subseconds)
+{
+
+   return (int64_t)Seconds*NS_PER_SEC + (int64_t)(((uint64_t)Subseconds*NS_PER_SEC) >> 32);
+
+} /* End RX_TIME_MissionNs() */
+
+
+/******************************************************************************
+** Function: ComputeFit
+**
+** Least squares line through the newest SampleCnt samples
+**
+** Notes:
+**   1. Times are taken relative to the newest sample so the doubles only
+**      hold the sample span, not absolute times.
+**   2. A single sample gives a rate of 1.
+**
+*/
+static void ComputeFit(RX_TIME_Class_t *Time, uint16_t SampleCnt, RX_TIME_Fit_t *Fit)
+{
+
+   const RX_TIME_Sample_t *Ref = &Time->Sample[(Time->NextSample + RX_TIME_FIT_SAMPLES - 1) % RX_TIME_FIT_SAMPLES];
+   const RX_TIME_Sample_t *Sample;
+   double   MeanX = 0.0;
+   double   MeanY = 0.0;
+   double   Sxx = 0.0;
+   double   Sxy = 0.0;
+   double   X;
+   double   Y;
+   double   Residual;
+   double   MaxResidual = 0.0;
+   uint16_t i;
+
+   for (i = 0; i < SampleCnt; i++)
+   {
+      Sample = &Time->Sample[(Time->NextSample + RX_TIME_FIT_SAMPLES - 1 - i) % RX_TIME_FIT_SAMPLES];
+      MeanX += (double)(Sample->RawNs - Ref->RawNs);
+      MeanY += (double)(Sample->MissionNs - Ref->MissionNs);
+   }
+   MeanX /= SampleCnt;
+   MeanY /= SampleCnt;
+
+   for (i = 0; i < SampleCnt; i++)
+   {
+      Sample = &Time->Sample[(Time->NextSample + RX_TIME_FIT_SAMPLES - 1 - i) % RX_TIME_FIT_SAMPLES];
+      X = (double)(Sample->RawNs - Ref->RawNs) - MeanX;
+      Y = (double)(Sample->MissionNs - Ref->MissionNs) - MeanY;
+      Sxx += X*X;
+      Sxy += X*Y;
+   }
+
+   Fit->Rate         = (Sxx > 0.0) ? (Sxy/Sxx) : 1.0;
+   Fit->RefRawNs     = Ref->RawNs;
+   Fit->RefMissionNs = Ref->MissionNs + (int64_t)(MeanY - Fit->Rate*MeanX);
+   Fit->Valid        = true;
+
+   for (i = 0; i < SampleCnt; i++)
+   {
+      Sample = &Time->Sample[(Time->NextSample + RX_TIME_FIT_SAMPLES - 1 - i) % RX_TIME_FIT_SAMPLES];
+      Residual = (double)(Sample->MissionNs - FitMissionNs(Fit, Sample->RawNs));
+      if (Residual < 0.0)
+      {
+         Residual = -Residual;
+      }
+      if (Residual > MaxResidual)
+      {
+         MaxResidual = Residual;
+      }
+   }
+
+   Time->Stats.RatePpb    = (int32_t)((Fit->Rate - 1.0)*1.0e9);
+   Time->Stats.ResidualNs = (MaxResidual > 4.0e9) ? 0xFFFFFFFF : (uint32_t)MaxResidual;
+
+} /* End ComputeFit() */
+
+
+/******************************************************************************
+** Function: FitMissionNs
+**
+*/
+static int64_t FitMissionNs(const RX_TIME_Fit_t *Fit, int64_t RawNs)
+{
+
+   return Fit->RefMissionNs + (int64_t)((double)(RawNs - Fit->RefRawNs)*Fit->Rate);
+
+} /* End FitMissionNs() */
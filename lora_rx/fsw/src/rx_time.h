@@ -0,0 +1,188 @@
+/*
+**  This program is free software: you can redistribute it and/or modify
+**  it under the terms of the GNU Lesser General Public License as
+**  published by the Free Software Foundation, either version 3 of the
+**  License, or (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Lesser General Public License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public License
+**  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+**
+**  Purpose:
+**    Define the receive time correlation class
+**
+**  Notes:
+**    1. Frames are timestamped with the CLOCK_MONOTONIC_RAW time (raw
+**       time) by the radio bridge. This class converts raw times to mission
+**       time with a least squares line through the most recent raw/mission
+**       time pairs so no mission time call is made per frame.
+**    2. Mission times are seconds and 2^-32 subseconds, the same as
+**       CFE_TIME_SysTime_t.
+**    3. Fits are double buffered. RX_TIME_AddSample() runs in the app's
+**       main task and fills the inactive fit. The receive context switches
+**       fits in RX_TIME_Sync().
+**    4. A sample that's more than RX_TIME_JUMP_NS from the current fit
+**       means mission time was set, the old samples are discarded.
+**    5. This header shouldn't include cFS or Lora_Rx app C header files.
+**
+*/
+
+#ifndef _rx_time_
+#define _rx_time_
+
+/*
+** Includes
+*/
+#include <stdbool.h>
+#include <stdint.h>
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define RX_TIME_FIT_SAMPLES  16
+#define RX_TIME_JUMP_NS      1000000
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+
+typedef struct
+{
+   int64_t  RawNs;
+   int64_t  MissionNs;
+
+} RX_TIME_Sample_t;
+
+
+typedef struct
+{
+   bool     Valid;
+   int64_t  RefRawNs;       /* Raw time of the newest sample */
+   int64_t  RefMissionNs;   /* Fitted mission time at RefRawNs */
+   double   Rate;           /* Mission ns per raw ns */
+
+} RX_TIME_Fit_t;
+
+
+typedef struct
+{
+   uint32_t FitCnt;
+   uint32_t SkipCnt;       /* Fits dropped because the previous one wasn't applied */
+   uint32_t JumpCnt;       /* Mission time discontinuities */
+   int32_t  RatePpb;       /* Raw clock rate relative to mission time, parts per billion */
+   uint32_t ResidualNs;    /* Largest residual of the last fit */
+   uint16_t SampleCnt;
+
+} RX_TIME_Stats_t;
+
+
+/******************************************************************************
+** RX_TIME_Class
+*/
+typedef struct
+{
+
+   uint32_t ActiveFit;     /* Only written by the receive context */
+   uint32_t PendingFit;    /* Written by RX_TIME_AddSample()      */
+   RX_TIME_Fit_t Fit[2];
+
+   uint16_t NextSample;
+   RX_TIME_Sample_t Sample[RX_TIME_FIT_SAMPLES];
+
+   RX_TIME_Stats_t Stats;
+
+} RX_TIME_Class_t;
+
+
+/************************/
+/** Exported Functions **/
+/************************/
+
+
+/******************************************************************************
+** Function: RX_TIME_Constructor
+**
+** Notes:
+**   1. Conversions fail until the first sample has been applied.
+**
+*/
+void RX_TIME_Constructor(RX_TIME_Class_t *Time);
+
+
+/******************************************************************************
+** Function: RX_TIME_AddSample
+**
+** Add a raw/mission time pair and refit
+**
+** Notes:
+**   1. Must be called from one context, the app's main task.
+**   2. The raw time should be taken as close as possible to the mission
+**      time, e.g. the midpoint of raw times read before and after it.
+**
+*/
+void RX_TIME_AddSample(RX_TIME_Class_t *Time, int64_t RawNs, uint32_t Seconds, uint32_t Subseconds);
+
+
+/******************************************************************************
+** Function: RX_TIME_ResetStatus
+**
+** Notes:
+**   1. The fit and its samples are kept.
+**
+*/
+void RX_TIME_ResetStatus(RX_TIME_Class_t *Time);
+
+
+/******************************************************************************
+** Function: RX_TIME_Sync
+**
+** Apply a pending fit. Must be called from the receive context.
+**
+*/
+void RX_TIME_Sync(RX_TIME_Class_t *Time);
+
+
+/******************************************************************************
+** Function: RX_TIME_ToMission
+**
+** Convert a raw time to mission time using the active fit
+**
+** Notes:
+**   1. Returns false if there's no fit yet.
+**   2. Must be called from the receive context.
+**
+*/
+bool RX_TIME_ToMission(const RX_TIME_Class_t *Time, int64_t RawNs, uint32_t *Seconds, uint32_t *Subseconds);
+
+
+/******************************************************************************
+** Function: RX_TIME_ToRaw
+**
+** Convert a mission time in nanoseconds to raw time using the active fit
+**
+** Notes:
+**   1. Returns false if there's no fit yet.
+**   2. Must be called from the receive context.
+**
+*/
+bool RX_TIME_ToRaw(const RX_TIME_Class_t *Time, int64_t MissionNs, int64_t *RawNs);
+
+
+/******************************************************************************
+** Function: RX_TIME_MissionNs
+**
+** Return a seconds and 2^-32 subseconds mission time in nanoseconds
+**
+*/
+int64_t RX_TIME_MissionNs(uint32_t Seconds, uint32_t Subseconds);
+
+
+#endif /* _rx_time_ */
@@ -0,0 +1,285 @@
+/*
+**  This program is free software: you can redistribute it and/or modify
+**  it under the terms of the GNU Lesser General Public License as
+**  published by the Free Software Foundation, either version 3 of the
+**  License, or (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Lesser General Public License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public License
+**  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+**
+**  Purpose:
+**    Implement the receive pipeline trace
+**
+**  Notes:
+**    1. See rx_trace.h for details.
+**
+*/
+
+/*
+** Include Files:
+*/
+
+#include <string.h>
+#include <time.h>
+#include "rx_trace.h"
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+typedef struct
+{
+   uint32_t Head;            /* Events recorded, only written by the task */
+   bool     Filled;          /* Every slot has been written, set after the head */
+   uint32_t SnapshotHead;    /* Head at the start of the last snapshot */
+   RX_TRACE_Event_t *Event;
+
+} TaskBuf_t;
+
+
+/**********************/
+/** Global File Data **/
+/**********************/
+
+static bool     TraceEnabled = false;
+static uint32_t TaskEvents = 0;
+static uint32_t StagePerfId[RX_TRACE_STAGE_CNT];
+static RX_TRACE_PerfFunc_t PerfFunc = NULL;
+
+static TaskBuf_t TaskBuf[RX_TRACE_TASK_CNT];
+
+static const char *StageName[RX_TRACE_STAGE_CNT] =
+{
+   "wait",
+   "spi-read",
+   "filter",
+   "sec",
+   "decomp",
+   "deframe",
+   "publish"
+};
+
+
+/*******************************/
+/** Local Function Prototypes **/
+/*******************************/
+
+static void Record(RX_TRACE_Task_Enum_t Task, RX_TRACE_Stage_Enum_t Stage, uint8_t Phase, uint16_t Arg);
+
+
+/******************************************************************************
+** Function: RX_TRACE_Init
+**
+*/
+void RX_TRACE_Init(const uint32_t PerfId[RX_TRACE_STAGE_CNT], RX_TRACE_PerfFunc_t PerfFuncPtr,
+                   RX_TRACE_Event_t *EventBuf, uint32_t EventCnt, bool Enabled)
+{
+
+   uint16_t Task;
+
+   memcpy(StagePerfId, PerfId, sizeof(StagePerfId));
+   memset(TaskBuf, 0, sizeof(TaskBuf));
+   PerfFunc = PerfFuncPtr;
+
+   TaskEvents = 0;
+   if (EventBuf != NULL && EventCnt > 0 && (EventCnt & (EventCnt - 1)) == 0)
+   {
+      TaskEvents = EventCnt;
+      for (Task = 0; Task < RX_TRACE_TASK_CNT; Task++)
+      {
+         TaskBuf[Task].Event = &EventBuf[Task*EventCnt];
+      }
+   }
+
+   RX_TRACE_Enable(Enabled);
+
+} /* End RX_TRACE_Init() */
+
+
+/******************************************************************************
+** Function: RX_TRACE_Enable
+**
+*/
+void RX_TRACE_Enable(bool Enabled)
+{
+
+   __atomic_store_n(&TraceEnabled, Enabled && TaskEvents > 0, __ATOMIC_RELAXED);
+
+} /* End RX_TRACE_Enable() */
+
+
+/******************************************************************************
+** Function: RX_TRACE_Enabled
+**
+*/
+bool RX_TRACE_Enabled(void)
+{
+
+   return __atomic_load_n(&TraceEnabled, __ATOMIC_RELAXED);
+
+} /* End RX_TRACE_Enabled() */
+
+
+/******************************************************************************
+** Function: RX_TRACE_TaskEvents
+**
+*/
+uint32_t RX_TRACE_TaskEvents(void)
+{
+
+   return TaskEvents;
+
+} /* End RX_TRACE_TaskEvents() */
+
+
+/******************************************************************************
+** Function: RX_TRACE_Begin
+**
+*/
+void RX_TRACE_Begin(RX_TRACE_Task_Enum_t Task, RX_TRACE_Stage_Enum_t Stage, uint16_t Arg)
+{
+
+   if (PerfFunc != NULL)
+   {
+      PerfFunc(StagePerfId[Stage], false);
+   }
+   Record(Task, Stage, RX_TRACE_PHASE_BEGIN, Arg);
+
+} /* End RX_TRACE_Begin() */
+
+
+/******************************************************************************
+** Function: RX_TRACE_End
+**
+*/
+void RX_TRACE_End(RX_TRACE_Task_Enum_t Task, RX_TRACE_Stage_Enum_t Stage, uint16_t Arg)
+{
+
+   Record(Task, Stage, RX_TRACE_PHASE_END, Arg);
+   if (PerfFunc != NULL)
+   {
+      PerfFunc(StagePerfId[Stage], true);
+   }
+
+} /* End RX_TRACE_End() */
+
+
+/******************************************************************************
+** Function: RX_TRACE_Snapshot
+**
+** Notes:
+**   1. Head is free running so all index arithmetic is modulo 2^32, which
+**      is a multiple of the buffer size. Filled tells a full buffer from
+**      one that hasn't wrapped once the head itself has wrapped.
+**   2. Events recorded during the copy, plus the one that may be in
+**      progress, overwrite the oldest copied events so that many are
+**      discarded from the front of the snapshot.
+**
+*/
+uint32_t RX_TRACE_Snapshot(RX_TRACE_Task_Enum_t Task, RX_TRACE_Event_t *Event, uint32_t *LostCnt)
+{
+
+   TaskBuf_t *Buf = &TaskBuf[Task];
+   uint32_t Mask = TaskEvents - 1;
+   bool     Filled;
+   uint32_t StartHead;
+   uint32_t EndHead;
+   uint32_t First;
+   uint32_t Cnt;
+   uint32_t Drop;
+   uint32_t Recorded;
+   uint32_t i;
+
+   *LostCnt = 0;
+   if (TaskEvents == 0)
+   {
+      return 0;
+   }
+
+   Filled    = __atomic_load_n(&Buf->Filled, __ATOMIC_ACQUIRE);
+   StartHead = __atomic_load_n(&Buf->Head, __ATOMIC_ACQUIRE);
+   Cnt   = (Filled || StartHead >= TaskEvents) ? TaskEvents : StartHead;
+   First = StartHead - Cnt;
+
+   for (i = 0; i < Cnt; i++)
+   {
+      Event[i] = Buf->Event[(First + i) & Mask];
+   }
+
+   __atomic_thread_fence(__ATOMIC_ACQUIRE);
+   EndHead = __atomic_load_n(&Buf->Head, __ATOMIC_RELAXED);
+
+   Drop = 0;
+   if (Cnt + (EndHead - StartHead) + 1 > TaskEvents)
+   {
+      Drop = Cnt + (EndHead - StartHead) + 1 - TaskEvents;
+      if (Drop > Cnt)
+      {
+         Drop = Cnt;
+      }
+      Cnt -= Drop;
+      memmove(Event, &Event[Drop], Cnt*sizeof(RX_TRACE_Event_t));
+   }
+
+   Recorded = StartHead - Buf->SnapshotHead;
+   *LostCnt = (Recorded > Cnt) ? (Recorded - Cnt) : 0;
+   Buf->SnapshotHead = StartHead;
+
+   return Cnt;
+
+} /* End RX_TRACE_Snapshot() */
+
+
+/******************************************************************************
+** Function: RX_TRACE_StageName
+**
+*/
+const char *RX_TRACE_StageName(uint8_t Stage)
+{
+
+   return (Stage < RX_TRACE_STAGE_CNT) ? StageName[Stage] : "unknown";
+
+} /* End RX_TRACE_StageName() */
+
+
+/******************************************************************************
+** Function: Record
+**
+*/
+static void Record(RX_TRACE_Task_Enum_t Task, RX_TRACE_Stage_Enum_t Stage, uint8_t Phase, uint16_t Arg)
+{
+
+   TaskBuf_t *Buf = &TaskBuf[Task];
+   RX_TRACE_Event_t *Event;
+   struct timespec Now;
+   uint32_t Head;
+
+   if (!__atomic_load_n(&TraceEnabled, __ATOMIC_RELAXED))
+   {
+      return;
+   }
+
+   clock_gettime(CLOCK_MONOTONIC_RAW, &Now);
+
+   Head  = __atomic_load_n(&Buf->Head, __ATOMIC_RELAXED);
+   Event = &Buf->Event[Head & (TaskEvents-1)];
+
+   Event->TimeNs = (int64_t)Now.tv_sec*1000000000LL + Now.tv_nsec;
+   Event->Stage  = (uint8_t)Stage;
+   Event->Phase  = Phase;
+   Event->Arg    = Arg;
+   Event->Spare  = 0;
+
+   if (Head == TaskEvents-1)
+   {
+      __atomic_store_n(&Buf->Filled, true, __ATOMIC_RELAXED);
+   }
+   __atomic_store_n(&Buf->Head, Head + 1, __ATOMIC_RELEASE);
+
+} /* End Record() */
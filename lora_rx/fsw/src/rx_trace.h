@@ -0,0 +1,182 @@
+/*
+**  This program is free software: you can redistribute it and/or modify
+**  it under the terms of the GNU Lesser General Public License as
+**  published by the Free Software Foundation, either version 3 of the
+**  License, or (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Lesser General Public License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public License
+**  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+**
+**  Purpose:
+**    Define the receive pipeline trace
+**
+**  Notes:
+**    1. Each receive pipeline stage is bracketed by RX_TRACE_Begin() and
+**       RX_TRACE_End(). Each call logs the stage's performance id through
+**       the hook installed by RX_TRACE_Init(). When tracing is enabled the
+**       call also records a time tagged event in the calling task's trace
+**       buffer.
+**    2. Every task has its own buffer with a single writer so recording
+**       is a slot write and a release store of the head, no locks. The
+**       buffers are rings supplied to RX_TRACE_Init() and keep the most
+**       recent TaskEvents events.
+**    3. RX_TRACE_Snapshot() may run while the writer is recording. Events
+**       that could have been overwritten during the copy are dropped from
+**       the snapshot rather than returned torn.
+**    4. Times are CLOCK_MONOTONIC_RAW nanoseconds, the same time base as
+**       RADIO_RX_Frame_t.RxTimeNs.
+**    5. The trace is process wide because the radio bridge records into it
+**       from its IRQ context.
+**    6. This header shouldn't include cFS or Lora_Rx app C header files.
+**
+*/
+
+#ifndef _rx_trace_
+#define _rx_trace_
+
+/*
+** Includes
+*/
+#include <stdbool.h>
+#include <stdint.h>
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define RX_TRACE_PHASE_BEGIN  0
+#define RX_TRACE_PHASE_END    1
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+
+typedef enum
+{
+   RX_TRACE_TASK_RADIO = 0,   /* Radio bridge IRQ context */
+   RX_TRACE_TASK_CHILD,       /* App child task, frame processing */
+   RX_TRACE_TASK_CNT
+
+} RX_TRACE_Task_Enum_t;
+
+
+typedef enum
+{
+   RX_TRACE_WAIT = 0,    /* Child waiting for a frame */
+   RX_TRACE_SPI_READ,    /* Frame payload and status read */
+   RX_TRACE_FILTER,      /* Frame header checks */
+   RX_TRACE_SEC,         /* Authenticate and decrypt */
+   RX_TRACE_DECOMP,
+   RX_TRACE_DEFRAME,
+   RX_TRACE_PUBLISH,     /* Software bus send of an extracted packet */
+   RX_TRACE_STAGE_CNT
+
+} RX_TRACE_Stage_Enum_t;
+
+
+typedef struct
+{
+   int64_t   TimeNs;
+   uint8_t   Stage;
+   uint8_t   Phase;
+   uint16_t  Arg;       /* Stage specific, byte count for data stages */
+   uint32_t  Spare;
+
+} RX_TRACE_Event_t;
+
+
+/*
+** Called with Exit false at the start of a stage and true at its end
+*/
+typedef void (*RX_TRACE_PerfFunc_t)(uint32_t PerfId, bool Exit);
+
+
+/************************/
+/** Exported Functions **/
+/************************/
+
+
+/******************************************************************************
+** Function: RX_TRACE_Init
+**
+** Install the performance log hook, stage ids and event buffers
+**
+** Notes:
+**   1. PerfId is indexed by RX_TRACE_Stage_Enum_t. PerfFunc may be NULL.
+**   2. EventBuf holds RX_TRACE_TASK_CNT*TaskEvents events and must stay
+**      valid. TaskEvents must be a power of 2. Without a valid buffer the
+**      performance hook is still called but events can't be recorded.
+**   3. Must be called before the receive contexts are started.
+**
+*/
+void RX_TRACE_Init(const uint32_t PerfId[RX_TRACE_STAGE_CNT], RX_TRACE_PerfFunc_t PerfFunc,
+                   RX_TRACE_Event_t *EventBuf, uint32_t TaskEvents, bool Enabled);
+
+
+/******************************************************************************
+** Function: RX_TRACE_Enable
+**
+*/
+void RX_TRACE_Enable(bool Enabled);
+
+
+/******************************************************************************
+** Function: RX_TRACE_Enabled
+**
+*/
+bool RX_TRACE_Enabled(void);
+
+
+/******************************************************************************
+** Function: RX_TRACE_TaskEvents
+**
+** Return the events kept per task, 0 if there are no event buffers
+**
+*/
+uint32_t RX_TRACE_TaskEvents(void);
+
+
+/******************************************************************************
+** Function: RX_TRACE_Begin
+**
+*/
+void RX_TRACE_Begin(RX_TRACE_Task_Enum_t Task, RX_TRACE_Stage_Enum_t Stage, uint16_t Arg);
+
+
+/******************************************************************************
+** Function: RX_TRACE_End
+**
+*/
+void RX_TRACE_End(RX_TRACE_Task_Enum_t Task, RX_TRACE_Stage_Enum_t Stage, uint16_t Arg);
+
+
+/******************************************************************************
+** Function: RX_TRACE_Snapshot
+**
+** Copy a task's events, oldest first, and return the number copied
+**
+** Notes:
+**   1. Event must hold RX_TRACE_TaskEvents() events.
+**   2. LostCnt is the number of events recorded since the last snapshot
+**      that were overwritten before they could be copied.
+**
+*/
+uint32_t RX_TRACE_Snapshot(RX_TRACE_Task_Enum_t Task, RX_TRACE_Event_t *Event, uint32_t *LostCnt);
+
+
+/******************************************************************************
+** Function: RX_TRACE_StageName
+**
+*/
+const char *RX_TRACE_StageName(uint8_t Stage);
+
+
+#endif /* _rx_trace_ */
@@ -0,0 +1,961 @@
+/*
+**  This program is free software: you can redistribute it and/or modify
+**  it under the terms of the GNU Lesser General Public License as
+**  published by the Free Software Foundation, either version 3 of the
+**  License, or (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Lesser General Public License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public License
+**  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+**
+**  Purpose:
+**    Implement the virtual RF channel
+**
+**  Notes:
+**    1. See rx_vchan.h for details.
+**    2. Opcodes, IRQ bits and parameter encodings are the SX128x
+**       datasheet's. They're repeated here because SX128x.hpp is C++.
+**
+*/
+
+/*
+** Include Files:
+*/
+
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "rx_vchan.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define OP_GET_PACKETTYPE      0x03
+#define OP_GET_IRQSTATUS       0x15
+#define OP_GET_RXBUFFERSTATUS  0x17
+#define OP_WRITE_REGISTER      0x18
+#define OP_READ_REGISTER       0x19
+#define OP_WRITE_BUFFER        0x1A
+#define OP_READ_BUFFER         0x1B
+#define OP_GET_PACKETSTATUS    0x1D
+#define OP_GET_RSSIINST        0x1F
+#define OP_SET_STANDBY         0x80
+#define OP_SET_RX              0x82
+#define OP_SET_SLEEP           0x84
+#define OP_SET_RFFREQUENCY     0x86
+#define OP_SET_CADPARAMS       0x88
+#define OP_SET_PACKETTYPE      0x8A
+#define OP_SET_MODPARAMS       0x8B
+#define OP_SET_PKTPARAMS       0x8C
+#define OP_SET_DIOIRQPARAMS    0x8D
+#define OP_SET_BUFFERBASE      0x8F
+#define OP_SET_RXDUTYCYCLE     0x94
+#define OP_CLR_IRQSTATUS       0x97
+#define OP_SET_FS              0xC1
+#define OP_SET_CAD             0xC5
+
+#define IRQ_RX_DONE            0x0002
+#define IRQ_SYNCWORD_VALID     0x0004
+#define IRQ_HEADER_VALID       0x0010
+#define IRQ_CRC_ERROR          0x0040
+#define IRQ_CAD_DONE           0x1000
+#define IRQ_CAD_DETECTED       0x2000
+#define IRQ_RX_TX_TIMEOUT      0x4000
+
+#define PACKET_TYPE_LORA       0x01
+#define PACKET_TYPE_FLRC       0x03
+#define LORA_CRC_ON            0x20
+
+#define CMD_STATUS_OK          0x01     /* Status byte bits 4:2 */
+
+#define SX128X_XTAL_HZ         52000000
+
+/*
+** Receive kinds. CAD and single receives end in STDBY_RC, a duty cycled
+** receive ends when a frame is received.
+*/
+#define RX_KIND_NONE    0
+#define RX_KIND_CONT    1
+#define RX_KIND_SINGLE  2
+#define RX_KIND_DUTY    3
+#define RX_KIND_CAD     4
+
+#define SLOT_MASK  (RX_VCHAN_MEDIUM_SLOTS - 1)
+
+
+/*******************************/
+/** Local Function Prototypes **/
+/*******************************/
+
+static void TakeTransmissions(RX_VCHAN_Class_t *Vchan);
+static void AddPending(RX_VCHAN_Class_t *Vchan, const RX_VCHAN_Slot_t *Tx);
+static void CompleteFrame(RX_VCHAN_Class_t *Vchan, const RX_VCHAN_Pending_t *Frame);
+static void DeliverFrame(RX_VCHAN_Class_t *Vchan, const RX_VCHAN_Pending_t *Frame);
+static void CompleteCad(RX_VCHAN_Class_t *Vchan, int64_t NowNs);
+static bool Heard(const RX_VCHAN_Class_t *Vchan, const RX_VCHAN_Pending_t *Frame);
+static bool SameModulation(const RX_VCHAN_Class_t *Vchan, const RX_VCHAN_Slot_t *Tx);
+static bool OnChannel(const RX_VCHAN_Class_t *Vchan, const RX_VCHAN_Pending_t *Frame);
+static void StartRx(RX_VCHAN_Class_t *Vchan, uint8_t RxKind);
+static void EndRx(RX_VCHAN_Class_t *Vchan);
+static int8_t ChannelRssi(const RX_VCHAN_Class_t *Vchan);
+static void AccountRead(RX_VCHAN_Class_t *Vchan);
+static bool Chance(RX_VCHAN_Class_t *Vchan, uint32_t Ppm);
+static uint32_t Random(RX_VCHAN_Class_t *Vchan);
+static uint32_t TickNs(uint8_t TickSize);
+
+
+/******************************************************************************
+** Function: RX_VCHAN_OpenMedium
+**
+** Notes:
+**   1. Every opener writes the same layout fields before claiming Magic so
+**      concurrent first opens are harmless.
+**
+*/
+RX_VCHAN_Medium_t *RX_VCHAN_OpenMedium(const char *ShmName)
+{
+
+   RX_VCHAN_Medium_t *Medium;
+   RX_VCHAN_Ctrl_t   *Ctrl;
+   struct stat ShmStat;
+   uint32_t Expected = 0;
+   void *Map;
+   int   ShmFd;
+
+   ShmFd = shm_open(ShmName, O_CREAT | O_RDWR, 0666);
+   if (ShmFd < 0)
+   {
+      return NULL;
+   }
+   if (fstat(ShmFd, &ShmStat) != 0 ||
+       (ShmStat.st_size == 0 && ftruncate(ShmFd, sizeof(RX_VCHAN_Medium_t)) != 0) ||
+       (ShmStat.st_size != 0 && ShmStat.st_size != sizeof(RX_VCHAN_Medium_t)))
+   {
+      close(ShmFd);
+      return NULL;
+   }
+   Map = mmap(NULL, sizeof(RX_VCHAN_Medium_t), PROT_READ | PROT_WRITE, MAP_SHARED, ShmFd, 0);
+   close(ShmFd);
+   if (Map == MAP_FAILED)
+   {
+      return NULL;
+   }
+
+   Medium = (RX_VCHAN_Medium_t *)Map;
+   Ctrl   = &Medium->Ctrl;
+   if (__atomic_load_n(&Ctrl->Magic, __ATOMIC_ACQUIRE) == 0)
+   {
+      Ctrl->Version = RX_VCHAN_VERSION;
+      Ctrl->CtrlLen = sizeof(RX_VCHAN_Ctrl_t);
+      Ctrl->SlotLen = sizeof(RX_VCHAN_Slot_t);
+      Ctrl->SlotCnt = RX_VCHAN_MEDIUM_SLOTS;
+      __atomic_compare_exchange_n(&Ctrl->Magic, &Expected, RX_VCHAN_MAGIC, false,
+                                  __ATOMIC_RELEASE, __ATOMIC_ACQUIRE);
+   }
+
+   if (__atomic_load_n(&Ctrl->Magic, __ATOMIC_ACQUIRE) != RX_VCHAN_MAGIC ||
+       Ctrl->Version != RX_VCHAN_VERSION || Ctrl->CtrlLen != sizeof(RX_VCHAN_Ctrl_t) ||
+       Ctrl->SlotLen != sizeof(RX_VCHAN_Slot_t) || Ctrl->SlotCnt != RX_VCHAN_MEDIUM_SLOTS)
+   {
+      munmap(Map, sizeof(RX_VCHAN_Medium_t));
+      return NULL;
+   }
+
+   return Medium;
+
+} /* End RX_VCHAN_OpenMedium() */
+
+
+/******************************************************************************
+** Function: RX_VCHAN_Transmit
+**
+*/
+void RX_VCHAN_Transmit(RX_VCHAN_Medium_t *Medium, uint32_t FrequencyHz, uint8_t PacketType,
+                       const uint8_t *ModParam, uint8_t Crc, const uint8_t *Data, uint8_t Len)
+{
+
+   uint64_t TxSeq = __atomic_fetch_add(&Medium->Ctrl.TxSeq, 1, __ATOMIC_ACQ_REL);
+   RX_VCHAN_Slot_t *Slot = &Medium->Slot[TxSeq & SLOT_MASK];
+
+   __atomic_store_n(&Slot->Seq, 2*TxSeq + 1, __ATOMIC_RELAXED);
+   __atomic_thread_fence(__ATOMIC_RELEASE);
+
+   Slot->StartNs     = RX_VCHAN_TimeNs();
+   Slot->FrequencyHz = FrequencyHz;
+   Slot->PacketType  = PacketType;
+   memcpy(Slot->ModParam, ModParam, sizeof(Slot->ModParam));
+   Slot->Crc = Crc;
+   Slot->Len = Len;
+   memcpy(Slot->Data, Data, Len);
+
+   __atomic_store_n(&Slot->Seq, 2*TxSeq + 2, __ATOMIC_RELEASE);
+
+} /* End RX_VCHAN_Transmit() */
+
+
+/******************************************************************************
+** Function: RX_VCHAN_Constructor
+**
+*/
+void RX_VCHAN_Constructor(RX_VCHAN_Class_t *Vchan, RX_VCHAN_Medium_t *Medium,
+                          const RX_VCHAN_Model_t *Model, RX_VCHAN_PhyFuncPtr_t PhyFunc)
+{
+
+   memset(Vchan, 0, sizeof(RX_VCHAN_Class_t));
+
+   Vchan->Medium  = Medium;
+   Vchan->PhyFunc = PhyFunc;
+   Vchan->Model   = *Model;
+   Vchan->RxSeq   = __atomic_load_n(&Medium->Ctrl.TxSeq, __ATOMIC_ACQUIRE);
+   Vchan->Random  = (Model->Seed != 0) ? Model->Seed : ((uint32_t)RX_VCHAN_TimeNs() | 1);
+
+   Vchan->Mode       = RX_VCHAN_MODE_STDBY_RC;
+   Vchan->PacketType = PACKET_TYPE_LORA;
+   Vchan->CadSymbols = 1;
+
+} /* End RX_VCHAN_Constructor() */
+
+
+/******************************************************************************
+** Function: RX_VCHAN_Transfer
+**
+** Notes:
+**   1. Read commands return their data after the opcode and a status
+**      byte, register reads after the opcode, two address bytes and a
+**      status byte, buffer reads after the opcode, offset and status.
+**
+*/
+void RX_VCHAN_Transfer(RX_VCHAN_Class_t *Vchan, const uint8_t *Mosi, uint8_t *Miso, uint16_t Len)
+{
+
+   const uint8_t *Param = &Mosi[1];
+   uint16_t ParamLen = (Len > 0) ? Len - 1 : 0;
+   uint16_t Addr;
+   uint16_t Count;
+   uint16_t i;
+
+   memset(Miso, (Vchan->Mode << 5) | (CMD_STATUS_OK << 2), Len);
+   if (Len == 0)
+   {
+      return;
+   }
+
+   switch (Mosi[0])
+   {
+      case OP_SET_STANDBY:
+         EndRx(Vchan);
+         Vchan->Mode = (ParamLen > 0 && Param[0] != 0) ? RX_VCHAN_MODE_STDBY_XOSC : RX_VCHAN_MODE_STDBY_RC;
+         break;
+      case OP_SET_SLEEP:
+         EndRx(Vchan);
+         break;
+      case OP_SET_FS:
+         EndRx(Vchan);
+         Vchan->Mode = RX_VCHAN_MODE_FS;
+         break;
+      case OP_SET_RX:
+         if (ParamLen >= 3)
+         {
+            Count = (uint16_t)((Param[1] << 8) | Param[2]);
+            StartRx(Vchan, (Count == 0xFFFF) ? RX_KIND_CONT : RX_KIND_SINGLE);
+            if (Count != 0 && Count != 0xFFFF)
+            {
+               Vchan->RxDeadlineNs = Vchan->RxArmNs + (int64_t)Count*TickNs(Param[0]);
+            }
+         }
+         break;
+      case OP_SET_RXDUTYCYCLE:
+         if (ParamLen >= 5)
+         {
+            Vchan->DutyRxNs    = ((Param[1] << 8) | Param[2])*TickNs(Param[0]);
+            Vchan->DutySleepNs = ((Param[3] << 8) | Param[4])*TickNs(Param[0]);
+            StartRx(Vchan, RX_KIND_DUTY);
+         }
+         break;
+      case OP_SET_CAD:
+         StartRx(Vchan, RX_KIND_CAD);
+         {
+            RX_VCHAN_Phy_t Phy;
+            if (Vchan->PhyFunc(Vchan->PacketType, Vchan->ModParam, 0, 0, &Phy))
+            {
+               Vchan->RxDeadlineNs = Vchan->RxArmNs + (int64_t)Vchan->CadSymbols*Phy.SymbolNs;
+            }
+            else
+            {
+               Vchan->RxDeadlineNs = Vchan->RxArmNs;
+            }
+         }
+         break;
+      case OP_SET_PACKETTYPE:
+         if (ParamLen >= 1)
+         {
+            Vchan->PacketType = Param[0];
+         }
+         break;
+      case OP_GET_PACKETTYPE:
+         if (Len > 2)
+         {
+            Miso[2] = Vchan->PacketType;
+         }
+         break;
+      case OP_SET_RFFREQUENCY:
+         if (ParamLen >= 3)
+         {
+            Vchan->FrequencyHz = (uint32_t)((((uint64_t)Param[0] << 16 | Param[1] << 8 | Param[2])*SX128X_XTAL_HZ) >> 18);
+         }
+         break;
+      case OP_SET_CADPARAMS:
+         if (ParamLen >= 1)
+         {
+            Vchan->CadSymbols = (uint8_t)(1 << ((Param[0] >> 5) & 0x07));
+         }
+         break;
+      case OP_SET_MODPARAMS:
+         memcpy(Vchan->ModParam, Param, (ParamLen < 3) ? ParamLen : 3);
+         break;
+      case OP_SET_PKTPARAMS:
+         memcpy(Vchan->PktParam, Param, (ParamLen < 7) ? ParamLen : 7);
+         break;
+      case OP_SET_BUFFERBASE:
+         if (ParamLen >= 2)
+         {
+            Vchan->RxBase = Param[1];
+         }
+         break;
+      case OP_SET_DIOIRQPARAMS:
+         if (ParamLen >= 4)
+         {
+            Vchan->IrqMask  = (uint16_t)((Param[0] << 8) | Param[1]);
+            Vchan->Dio1Mask = (uint16_t)((Param[2] << 8) | Param[3]);
+         }
+         break;
+      case OP_GET_IRQSTATUS:
+         if (Len > 3)
+         {
+            Miso[2] = (uint8_t)(Vchan->IrqStatus >> 8);
+            Miso[3] = (uint8_t)Vchan->IrqStatus;
+         }
+         break;
+      case OP_CLR_IRQSTATUS:
+         if (ParamLen >= 2)
+         {
+            Vchan->IrqStatus &= (uint16_t)~((Param[0] << 8) | Param[1]);
+         }
+         break;
+      case OP_GET_RXBUFFERSTATUS:
+         if (Len > 3)
+         {
+            Miso[2] = Vchan->RxLen;
+            Miso[3] = Vchan->RxBase;
+         }
+         break;
+      case OP_GET_PACKETSTATUS:
+         for (i = 2; i < Len && i < 7; i++)
+         {
+            Miso[i] = 0;
+         }
+         if (Len > 3)
+         {
+            if (Vchan->PacketType == PACKET_TYPE_FLRC)
+            {
+               Miso[3] = (uint8_t)(-2*Vchan->RxRssi);
+            }
+            else
+            {
+               Miso[2] = (uint8_t)(-2*Vchan->RxRssi);
+               Miso[3] = (uint8_t)(4*Vchan->RxSnr);
+            }
+         }
+         break;
+      case OP_GET_RSSIINST:
+         if (Len > 2)
+         {
+            Miso[2] = (uint8_t)(-2*ChannelRssi(Vchan));
+         }
+         break;
+      case OP_WRITE_REGISTER:
+         if (ParamLen >= 2)
+         {
+            Addr = (uint16_t)((Param[0] << 8) | Param[1]);
+            for (i = 2; i < ParamLen; i++)
+            {
+               Vchan->Reg[(Addr + i - 2) % RX_VCHAN_REG_LEN] = Param[i];
+            }
+         }
+         break;
+      case OP_READ_REGISTER:
+         if (ParamLen >= 2)
+         {
+            Addr = (uint16_t)((Param[0] << 8) | Param[1]);
+            for (i = 4; i < Len; i++)
+            {
+               Miso[i] = Vchan->Reg[(Addr + i - 4) % RX_VCHAN_REG_LEN];
+            }
+         }
+         break;
+      case OP_WRITE_BUFFER:
+         for (i = 1; i < ParamLen; i++)
+         {
+            Vchan->Buf[(uint8_t)(Param[0] + i - 1)] = Param[i];
+         }
+         break;
+      case OP_READ_BUFFER:
+         if (ParamLen >= 1)
+         {
+            for (i = 3; i < Len; i++)
+            {
+               Miso[i] = Vchan->Buf[(uint8_t)(Param[0] + i - 3)];
+            }
+            if (Vchan->BufTxStartNs != 0 && Param[0] == Vchan->RxBase && Len >= 3 + Vchan->RxLen)
+            {
+               AccountRead(Vchan);
+            }
+         }
+         break;
+      default:
+         break;
+   }
+
+} /* End RX_VCHAN_Transfer() */
+
+
+/******************************************************************************
+** Function: RX_VCHAN_Poll
+**
+** Notes:
+**   1. A CAD or receive timeout is completed before frames so a CAD sees
+**      frames that ended during it.
+**
+*/
+bool RX_VCHAN_Poll(RX_VCHAN_Class_t *Vchan, int64_t *NextNs)
+{
+
+   int64_t NowNs;
+   int64_t Next;
+   uint8_t First;
+   uint8_t i;
+
+   TakeTransmissions(Vchan);
+   NowNs = RX_VCHAN_TimeNs();
+
+   if (Vchan->RxDeadlineNs != 0 && NowNs >= Vchan->RxDeadlineNs)
+   {
+      if (Vchan->RxKind == RX_KIND_CAD)
+      {
+         CompleteCad(Vchan, NowNs);
+      }
+      else
+      {
+         Vchan->IrqStatus |= IRQ_RX_TX_TIMEOUT & Vchan->IrqMask;
+      }
+      EndRx(Vchan);
+   }
+
+   /* Complete ended frames in the order they ended */
+   while (Vchan->PendingCnt > 0)
+   {
+      First = 0;
+      for (i = 1; i < Vchan->PendingCnt; i++)
+      {
+         if (Vchan->Pending[i].EndNs < Vchan->Pending[First].EndNs)
+         {
+            First = i;
+         }
+      }
+      if (Vchan->Pending[First].EndNs > NowNs)
+      {
+         break;
+      }
+      CompleteFrame(Vchan, &Vchan->Pending[First]);
+      Vchan->PendingCnt--;
+      Vchan->Pending[First] = Vchan->Pending[Vchan->PendingCnt];
+   }
+
+   Next = Vchan->RxDeadlineNs;
+   for (i = 0; i < Vchan->PendingCnt; i++)
+   {
+      if (Next == 0 || Vchan->Pending[i].EndNs < Next)
+      {
+         Next = Vchan->Pending[i].EndNs;
+      }
+   }
+   *NextNs = Next;
+
+   return ((Vchan->IrqStatus & Vchan->Dio1Mask) != 0);
+
+} /* End RX_VCHAN_Poll() */
+
+
+/******************************************************************************
+** Function: RX_VCHAN_TimeNs
+**
+*/
+int64_t RX_VCHAN_TimeNs(void)
+{
+
+   struct timespec Now;
+
+   clock_gettime(CLOCK_MONOTONIC_RAW, &Now);
+
+   return (int64_t)Now.tv_sec*1000000000 + Now.tv_nsec;
+
+} /* End RX_VCHAN_TimeNs() */
+
+
+/******************************************************************************
+** Function: RX_VCHAN_ResetStatus
+**
+*/
+void RX_VCHAN_ResetStatus(RX_VCHAN_Class_t *Vchan)
+{
+
+   memset(&Vchan->Stats, 0, sizeof(RX_VCHAN_Stats_t));
+
+} /* End RX_VCHAN_ResetStatus() */
+
+
+/******************************************************************************
+** Function: TakeTransmissions
+**
+** Copy completed medium slots into the pending frames
+**
+** Notes:
+**   1. A slot that's still being written stops the scan until the next
+**      poll. Slots a reader fell more than a medium behind on are lost.
+**
+*/
+static void TakeTransmissions(RX_VCHAN_Class_t *Vchan)
+{
+
+   RX_VCHAN_Medium_t *Medium = Vchan->Medium;
+   const RX_VCHAN_Slot_t *Slot;
+   RX_VCHAN_Slot_t Tx;
+   uint64_t TxSeq = __atomic_load_n(&Medium->Ctrl.TxSeq, __ATOMIC_ACQUIRE);
+   uint64_t Seq;
+
+   if (TxSeq - Vchan->RxSeq > RX_VCHAN_MEDIUM_SLOTS)
+   {
+      Vchan->Stats.OverrunCnt += (uint32_t)(TxSeq - Vchan->RxSeq - RX_VCHAN_MEDIUM_SLOTS);
+      Vchan->RxSeq = TxSeq - RX_VCHAN_MEDIUM_SLOTS;
+   }
+
+   while (Vchan->RxSeq < TxSeq)
+   {
+      Slot = &Medium->Slot[Vchan->RxSeq & SLOT_MASK];
+      Seq  = __atomic_load_n(&Slot->Seq, __ATOMIC_ACQUIRE);
+      if (Seq < 2*Vchan->RxSeq + 2)
+      {
+         break;
+      }
+
+      memcpy(&Tx, Slot, sizeof(RX_VCHAN_Slot_t));
+      __atomic_thread_fence(__ATOMIC_ACQUIRE);
+      if (Seq == 2*Vchan->RxSeq + 2 && __atomic_load_n(&Slot->Seq, __ATOMIC_RELAXED) == Seq)
+      {
+         AddPending(Vchan, &Tx);
+      }
+      else
+      {
+         Vchan->Stats.OverrunCnt++;
+      }
+      Vchan->RxSeq++;
+   }
+
+} /* End TakeTransmissions() */
+
+
+/******************************************************************************
+** Function: AddPending
+**
+** Notes:
+**   1. Collisions are marked when a frame is added because every frame
+**      that overlaps it is either pending or starts later. Frames on
+**      different channels don't collide.
+**
+*/
+static void AddPending(RX_VCHAN_Class_t *Vchan, const RX_VCHAN_Slot_t *Tx)
+{
+
+   RX_VCHAN_Pending_t *Frame;
+   RX_VCHAN_Pending_t *Other;
+   RX_VCHAN_Phy_t Phy;
+   uint32_t Separation;
+   uint8_t i;
+
+   Vchan->Stats.TxCnt++;
+   Vchan->Stats.TxByteCnt += Tx->Len;
+
+   if (!Vchan->PhyFunc(Tx->PacketType, Tx->ModParam, Tx->Crc, Tx->Len, &Phy))
+   {
+      Vchan->Stats.MismatchCnt++;
+      return;
+   }
+   if (Vchan->PendingCnt >= RX_VCHAN_MAX_PENDING)
+   {
+      Vchan->Stats.OverrunCnt++;
+      return;
+   }
+
+   Frame = &Vchan->Pending[Vchan->PendingCnt];
+   Frame->Tx          = *Tx;
+   Frame->ArriveNs    = Tx->StartNs + (int64_t)Vchan->Model.DelayUs*1000;
+   Frame->EndNs       = Frame->ArriveNs + (int64_t)Phy.AirtimeUs*1000;
+   Frame->FrequencyHz = (uint32_t)((int64_t)Tx->FrequencyHz + Vchan->Model.DopplerHz);
+   Frame->BandwidthHz = Phy.BandwidthHz;
+   Frame->PreambleUs  = Phy.PreambleUs;
+   Frame->Collided    = false;
+
+   for (i = 0; i < Vchan->PendingCnt; i++)
+   {
+      Other = &Vchan->Pending[i];
+      Separation = (uint32_t)labs((long)Other->FrequencyHz - (long)Frame->FrequencyHz);
+      if (Other->ArriveNs < Frame->EndNs && Frame->ArriveNs < Other->EndNs &&
+          Separation < (Other->BandwidthHz + Frame->BandwidthHz)/2)
+      {
+         Other->Collided = true;
+         Frame->Collided = true;
+      }
+   }
+   Vchan->PendingCnt++;
+
+} /* End AddPending() */
+
+
+/******************************************************************************
+** Function: CompleteFrame
+**
+** Apply the channel model to a frame that ended, see rx_vchan.h note 4
+**
+*/
+static void CompleteFrame(RX_VCHAN_Class_t *Vchan, const RX_VCHAN_Pending_t *Frame)
+{
+
+   if (Vchan->Mode != RX_VCHAN_MODE_RX || Vchan->RxKind == RX_KIND_CAD || !Heard(Vchan, Frame))
+   {
+      Vchan->Stats.MissCnt++;
+   }
+   else if (!SameModulation(Vchan, &Frame->Tx))
+   {
+      Vchan->Stats.MismatchCnt++;
+   }
+   else if (!OnChannel(Vchan, Frame))
+   {
+      Vchan->Stats.OffChannelCnt++;
+   }
+   else if (Frame->Collided)
+   {
+      Vchan->Stats.CollisionCnt++;
+   }
+   else if (Chance(Vchan, Vchan->Model.LossPpm))
+   {
+      Vchan->Stats.LostCnt++;
+   }
+   else
+   {
+      DeliverFrame(Vchan, Frame);
+   }
+
+} /* End CompleteFrame() */
+
+
+/******************************************************************************
+** Function: DeliverFrame
+**
+** Notes:
+**   1. The frame replaces any unread frame in the buffer, as it does in
+**      the SX128x.
+**
+*/
+static void DeliverFrame(RX_VCHAN_Class_t *Vchan, const RX_VCHAN_Pending_t *Frame)
+{
+
+   const RX_VCHAN_Slot_t *Tx = &Frame->Tx;
+   uint16_t Irq;
+   uint16_t Bit;
+   uint16_t i;
+   bool     CrcOn;
+
+   for (i = 0; i < Tx->Len; i++)
+   {
+      Vchan->Buf[(uint8_t)(Vchan->RxBase + i)] = Tx->Data[i];
+   }
+   Vchan->RxLen  = Tx->Len;
+   Vchan->RxRssi = RX_VCHAN_RSSI_DBM;
+   Vchan->RxSnr  = RX_VCHAN_SNR_DB;
+
+   if (Vchan->PacketType == PACKET_TYPE_FLRC)
+   {
+      Irq   = IRQ_SYNCWORD_VALID | IRQ_RX_DONE;
+      CrcOn = ((Vchan->PktParam[5] & 0x30) != 0);
+   }
+   else
+   {
+      Irq   = IRQ_HEADER_VALID | IRQ_RX_DONE;
+      CrcOn = (Vchan->PktParam[3] == LORA_CRC_ON);
+   }
+
+   if (Tx->Len > 0 && Chance(Vchan, Vchan->Model.CorruptPpm))
+   {
+      Bit = (uint16_t)(Random(Vchan) % (8*Tx->Len));
+      Vchan->Buf[(uint8_t)(Vchan->RxBase + Bit/8)] ^= (uint8_t)(1 << (Bit % 8));
+      Vchan->Stats.CorruptCnt++;
+      if (CrcOn)
+      {
+         Irq |= IRQ_CRC_ERROR;
+      }
+   }
+
+   Vchan->BufTxStartNs = (Irq & IRQ_CRC_ERROR) ? 0 : Tx->StartNs;
+   Vchan->IrqStatus |= Irq & Vchan->IrqMask;
+   Vchan->Stats.DeliverCnt++;
+
+   if (Vchan->RxKind != RX_KIND_CONT)
+   {
+      EndRx(Vchan);
+   }
+
+} /* End DeliverFrame() */
+
+
+/******************************************************************************
+** Function: CompleteCad
+**
+** Notes:
+**   1. Activity is a LoRa frame with the CAD's spreading factor on the
+**      channel at any time during the CAD.
+**
+*/
+static void CompleteCad(RX_VCHAN_Class_t *Vchan, int64_t NowNs)
+{
+
+   const RX_VCHAN_Pending_t *Frame;
+   uint16_t Irq = IRQ_CAD_DONE;
+   uint8_t  i;
+
+   for (i = 0; i < Vchan->PendingCnt; i++)
+   {
+      Frame = &Vchan->Pending[i];
+      if (Frame->ArriveNs < NowNs && Frame->EndNs > Vchan->RxArmNs &&
+          Frame->Tx.PacketType == PACKET_TYPE_LORA && Vchan->PacketType == PACKET_TYPE_LORA &&
+          Frame->Tx.ModParam[0] == Vchan->ModParam[0] && OnChannel(Vchan, Frame))
+      {
+         Irq |= IRQ_CAD_DETECTED;
+         break;
+      }
+   }
+
+   Vchan->IrqStatus |= Irq & Vchan->IrqMask;
+
+} /* End CompleteCad() */
+
+
+/******************************************************************************
+** Function: Heard
+**
+** Return whether the radio was listening in time to detect the frame
+**
+** Notes:
+**   1. The receiver has to start listening within the first half of the
+**      preamble. A duty cycled receiver must have a receive window open
+**      at some point in that time.
+**
+*/
+static bool Heard(const RX_VCHAN_Class_t *Vchan, const RX_VCHAN_Pending_t *Frame)
+{
+
+   int64_t  LockNs = Frame->ArriveNs + (int64_t)Frame->PreambleUs*500;
+   uint64_t PeriodNs;
+   uint64_t PhaseNs;
+   bool     RetStatus = (Vchan->RxArmNs <= LockNs);
+
+   if (RetStatus && Vchan->RxKind == RX_KIND_DUTY && Frame->ArriveNs > Vchan->RxArmNs)
+   {
+      PeriodNs = (uint64_t)Vchan->DutyRxNs + Vchan->DutySleepNs;
+      PhaseNs  = (PeriodNs > 0) ? (uint64_t)(Frame->ArriveNs - Vchan->RxArmNs) % PeriodNs : 0;
+      RetStatus = (PhaseNs < Vchan->DutyRxNs || Frame->ArriveNs + (int64_t)(PeriodNs - PhaseNs) <= LockNs);
+   }
+
+   return RetStatus;
+
+} /* End Heard() */
+
+
+/******************************************************************************
+** Function: SameModulation
+**
+** Notes:
+**   1. The LoRa coding rate is in the explicit header so it doesn't have
+**      to match.
+**
+*/
+static bool SameModulation(const RX_VCHAN_Class_t *Vchan, const RX_VCHAN_Slot_t *Tx)
+{
+
+   return (Tx->PacketType == Vchan->PacketType &&
+           Tx->ModParam[0] == Vchan->ModParam[0] && Tx->ModParam[1] == Vchan->ModParam[1]);
+
+} /* End SameModulation() */
+
+
+/******************************************************************************
+** Function: OnChannel
+**
+*/
+static bool OnChannel(const RX_VCHAN_Class_t *Vchan, const RX_VCHAN_Pending_t *Frame)
+{
+
+   return ((uint32_t)labs((long)Frame->FrequencyHz - (long)Vchan->FrequencyHz) <= Frame->BandwidthHz/4);
+
+} /* End OnChannel() */
+
+
+/******************************************************************************
+** Function: StartRx
+**
+*/
+static void StartRx(RX_VCHAN_Class_t *Vchan, uint8_t RxKind)
+{
+
+   Vchan->Mode         = RX_VCHAN_MODE_RX;
+   Vchan->RxKind       = RxKind;
+   Vchan->RxArmNs      = RX_VCHAN_TimeNs();
+   Vchan->RxDeadlineNs = 0;
+
+} /* End StartRx() */
+
+
+/******************************************************************************
+** Function: EndRx
+**
+*/
+static void EndRx(RX_VCHAN_Class_t *Vchan)
+{
+
+   Vchan->Mode         = RX_VCHAN_MODE_STDBY_RC;
+   Vchan->RxKind       = RX_KIND_NONE;
+   Vchan->RxDeadlineNs = 0;
+
+} /* End EndRx() */
+
+
+/******************************************************************************
+** Function: ChannelRssi
+**
+** Return the instantaneous RSSI at the tuned frequency
+**
+*/
+static int8_t ChannelRssi(const RX_VCHAN_Class_t *Vchan)
+{
+
+   const RX_VCHAN_Pending_t *Frame;
+   int64_t NowNs = RX_VCHAN_TimeNs();
+   uint8_t i;
+
+   for (i = 0; i < Vchan->PendingCnt; i++)
+   {
+      Frame = &Vchan->Pending[i];
+      if (Frame->ArriveNs <= NowNs && NowNs < Frame->EndNs &&
+          (uint32_t)labs((long)Frame->FrequencyHz - (long)Vchan->FrequencyHz) <= Frame->BandwidthHz/2)
+      {
+         return RX_VCHAN_RSSI_DBM;
+      }
+   }
+
+   return RX_VCHAN_NOISE_DBM;
+
+} /* End ChannelRssi() */
+
+
+/******************************************************************************
+** Function: AccountRead
+**
+** Count a good frame read out of the buffer and its latency
+**
+*/
+static void AccountRead(RX_VCHAN_Class_t *Vchan)
+{
+
+   RX_VCHAN_Stats_t *Stats = &Vchan->Stats;
+   int64_t  LatencyNs = RX_VCHAN_TimeNs() - Vchan->BufTxStartNs;
+   uint32_t LatencyUs;
+
+   if (LatencyNs < 0)
+   {
+      LatencyNs = 0;
+   }
+   LatencyUs = (uint32_t)(LatencyNs/1000);
+
+   Stats->RxCnt++;
+   Stats->RxByteCnt += Vchan->RxLen;
+   Stats->LatencyNs += (uint64_t)LatencyNs;
+   Stats->LastLatencyUs = LatencyUs;
+   if (LatencyUs > Stats->MaxLatencyUs)
+   {
+      Stats->MaxLatencyUs = LatencyUs;
+   }
+
+   Vchan->BufTxStartNs = 0;
+
+} /* End AccountRead() */
+
+
+/******************************************************************************
+** Function: Chance
+**
+** Return true with probability Ppm parts per million
+**
+*/
+static bool Chance(RX_VCHAN_Class_t *Vchan, uint32_t Ppm)
+{
+
+   return (Ppm > 0 && (Random(Vchan) % 1000000) < Ppm);
+
+} /* End Chance() */
+
+
+/******************************************************************************
+** Function: Random
+**
+** Xorshift32, a fixed seed repeats the channel's loss and corruption
+** pattern for the same traffic
+**
+*/
+static uint32_t Random(RX_VCHAN_Class_t *Vchan)
+{
+
+   uint32_t x = Vchan->Random;
+
+   x ^= x << 13;
+   x ^= x >> 17;
+   x ^= x << 5;
+   Vchan->Random = x;
+
+   return x;
+
+} /* End Random() */
+
+
+/******************************************************************************
+** Function: TickNs
+**
+** Return the duration of an SX128x RadioTickSizes_t period base
+**
+*/
+static uint32_t TickNs(uint8_t TickSize)
+{
+
+   static const uint32_t Tick[4] = { 15625, 62500, 1000000, 4000000 };
+
+   return Tick[TickSize & 0x03];
+
+} /* End TickNs() */
@@ -0,0 +1,341 @@
+/*
+**  This program is free software: you can redistribute it and/or modify
+**  it under the terms of the GNU Lesser General Public License as
+**  published by the Free Software Foundation, either version 3 of the
+**  License, or (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Lesser General Public License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public License
+**  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+**
+**  Purpose:
+**    Define the virtual RF channel
+**
+**  Notes:
+**    1. The virtual channel replaces the SX128x with a model so the
+**       receive path can be run end to end without radio hardware.
+**       Transmitters publish frames into a POSIX shared memory medium and
+**       the channel delivers them to a virtual SX128x that answers the
+**       radio bridge's SPI transfers, see RX_VCHAN_Transfer(). Everything
+**       above the SPI transfers, IRQ dispatch included, is the code that
+**       runs against the real radio.
+**    2. The medium is an RX_VCHAN_Ctrl_t followed by RX_VCHAN_MEDIUM_SLOTS
+**       RX_VCHAN_Slot_t. It's created by whichever side opens it first
+**       and isn't removed so either side can restart. Transmission n is
+**       claimed by incrementing Ctrl.TxSeq and written to slot
+**       n % RX_VCHAN_MEDIUM_SLOTS with the RX_TAP seqlock protocol: Seq
+**       is 2n+1 while it's written and 2n+2 when it's complete, see
+**       rx_tap.h. RX_VCHAN_Transmit() is the transmitter side.
+**    3. Times are CLOCK_MONOTONIC_RAW so every process on the host shares
+**       them. A slot's StartNs is the start of the transmission, a frame
+**       arrives DelayUs later and ends its time on air after that. The
+**       time on air is computed from the transmitter's modulation by the
+**       same model the receive path uses, see RX_VCHAN_PhyFuncPtr_t.
+**    4. A frame that ends is received if the virtual radio was listening
+**       in time to detect its preamble, has the transmitter's packet type,
+**       spreading factor and bandwidth (LoRa) or bitrate and coding rate
+**       (FLRC), and is tuned within a quarter of its bandwidth of the
+**       frame's frequency plus the Doppler offset. Frames that overlap on
+**       the receive channel destroy each other, there's no capture
+**       effect. Survivors are dropped with probability LossPpm and have a
+**       bit flipped with probability CorruptPpm. A corrupted frame fails
+**       its CRC if CRC is enabled.
+**    5. RX_VCHAN_Poll() advances the model and is called by the bridge's
+**       medium thread, which acts as the radio IRQ context. The virtual
+**       radio isn't thread safe, the bridge serializes calls.
+**    6. Goodput and latency are measured when a good frame is read out of
+**       the virtual radio's buffer, so frames the bridge drops aren't
+**       counted. Latency is from the start of transmission.
+**    7. Multi-byte fields are in host byte order.
+**    8. This header shouldn't include cFS or Lora_Rx app C header files.
+**
+*/
+
+#ifndef _rx_vchan_
+#define _rx_vchan_
+
+/*
+** Includes
+*/
+#include <stdbool.h>
+#include <stdint.h>
+#include "rx_frame.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define RX_VCHAN_MAGIC          0x5643484E   /* "VCHN" */
+#define RX_VCHAN_VERSION        1
+
+#define RX_VCHAN_MEDIUM_SLOTS   64           /* Power of 2 */
+#define RX_VCHAN_MAX_PENDING    16           /* Frames in flight at the receiver */
+#define RX_VCHAN_REG_LEN        0x1000
+
+#define RX_VCHAN_RSSI_DBM       (-60)        /* Received frames */
+#define RX_VCHAN_SNR_DB         10
+#define RX_VCHAN_NOISE_DBM      (-105)       /* Instantaneous RSSI of a quiet channel */
+
+/*
+** SX128x circuit modes, reported in status byte bits 7:5
+*/
+#define RX_VCHAN_MODE_STDBY_RC    2
+#define RX_VCHAN_MODE_STDBY_XOSC  3
+#define RX_VCHAN_MODE_FS          4
+#define RX_VCHAN_MODE_RX          5
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+
+/*
+** Medium control block at the start of the shared memory
+*/
+typedef struct
+{
+   uint32_t Magic;
+   uint16_t Version;
+   uint16_t CtrlLen;      /* sizeof(RX_VCHAN_Ctrl_t), slot 0 follows */
+   uint32_t SlotLen;      /* sizeof(RX_VCHAN_Slot_t) */
+   uint32_t SlotCnt;
+   uint64_t TxSeq;        /* Transmissions claimed */
+   uint8_t  Spare[40];    /* Keep TxSeq's cache line to itself */
+
+} RX_VCHAN_Ctrl_t;
+
+
+typedef struct
+{
+   uint64_t Seq;          /* See note 2 */
+   int64_t  StartNs;      /* CLOCK_MONOTONIC_RAW start of transmission */
+   uint32_t FrequencyHz;
+   uint8_t  PacketType;   /* SX128x.hpp RadioPacketTypes_t */
+   uint8_t  ModParam[3];  /* SX128x modulation parameter bytes */
+   uint8_t  Crc;          /* LoRa 0=Off 1=On, FLRC 0=Off, 1-3=2-4 bytes */
+   uint8_t  Len;
+   uint16_t Spare;
+   uint8_t  Data[RX_FRAME_MAX_LEN + 1];
+
+} RX_VCHAN_Slot_t;
+
+
+typedef struct
+{
+   RX_VCHAN_Ctrl_t Ctrl;
+   RX_VCHAN_Slot_t Slot[RX_VCHAN_MEDIUM_SLOTS];
+
+} RX_VCHAN_Medium_t;
+
+
+/*
+** Channel model, see note 4
+*/
+typedef struct
+{
+   uint32_t LossPpm;
+   uint32_t CorruptPpm;
+   uint32_t DelayUs;
+   int32_t  DopplerHz;    /* Added to every transmission's frequency */
+   uint32_t Seed;         /* 0 seeds from the clock */
+
+} RX_VCHAN_Model_t;
+
+
+/*
+** Physical layer timing of a modulation, supplied by the receive path's
+** time-on-air model
+*/
+typedef struct
+{
+   uint32_t AirtimeUs;    /* Of the frame length asked for */
+   uint32_t PreambleUs;
+   uint32_t SymbolNs;     /* LoRa symbol time or FLRC bit time */
+   uint32_t BandwidthHz;
+
+} RX_VCHAN_Phy_t;
+
+typedef bool (*RX_VCHAN_PhyFuncPtr_t)(uint8_t PacketType, const uint8_t *ModParam, uint8_t Crc,
+                                      uint8_t Len, RX_VCHAN_Phy_t *Phy);
+
+
+typedef struct
+{
+   uint32_t TxCnt;            /* Transmissions taken from the medium */
+   uint32_t TxByteCnt;
+   uint32_t DeliverCnt;       /* Frames put in the radio buffer */
+   uint32_t RxCnt;            /* Good frames read by the receiver */
+   uint32_t RxByteCnt;
+   uint32_t LostCnt;          /* Loss model */
+   uint32_t CorruptCnt;       /* Corruption model */
+   uint32_t CollisionCnt;
+   uint32_t OffChannelCnt;    /* Outside the frequency tolerance */
+   uint32_t MismatchCnt;      /* Different modulation */
+   uint32_t MissCnt;          /* Radio wasn't listening */
+   uint32_t OverrunCnt;       /* Lapped in the medium or too many in flight */
+   uint64_t LatencyNs;        /* Sum over RxCnt */
+   uint32_t LastLatencyUs;
+   uint32_t MaxLatencyUs;
+
+} RX_VCHAN_Stats_t;
+
+
+typedef struct
+{
+   RX_VCHAN_Slot_t Tx;
+   int64_t  ArriveNs;
+   int64_t  EndNs;
+   uint32_t FrequencyHz;      /* Including the Doppler offset */
+   uint32_t BandwidthHz;
+   uint32_t PreambleUs;
+   bool     Collided;
+
+} RX_VCHAN_Pending_t;
+
+
+/******************************************************************************
+** RX_VCHAN_Class
+*/
+typedef struct
+{
+
+   /*
+   ** Channel
+   */
+
+   RX_VCHAN_Medium_t    *Medium;
+   RX_VCHAN_PhyFuncPtr_t PhyFunc;
+   RX_VCHAN_Model_t      Model;
+   uint64_t RxSeq;            /* Next transmission to take from the medium */
+   uint32_t Random;
+
+   RX_VCHAN_Pending_t Pending[RX_VCHAN_MAX_PENDING];
+   uint8_t  PendingCnt;
+
+   /*
+   ** Virtual SX128x
+   */
+
+   uint8_t  Mode;
+   uint8_t  RxKind;           /* See rx_vchan.c */
+   uint8_t  PacketType;
+   uint8_t  ModParam[3];
+   uint8_t  PktParam[7];
+   uint8_t  CadSymbols;
+   uint8_t  RxBase;
+   uint8_t  RxLen;
+   int8_t   RxRssi;
+   int8_t   RxSnr;
+   uint16_t IrqMask;
+   uint16_t Dio1Mask;
+   uint16_t IrqStatus;
+   uint32_t FrequencyHz;
+   int64_t  RxArmNs;          /* Start of receive or duty cycle */
+   int64_t  RxDeadlineNs;     /* Receive timeout or end of CAD, 0 if none */
+   uint32_t DutyRxNs;
+   uint32_t DutySleepNs;
+   int64_t  BufTxStartNs;     /* Start of transmission of the unread buffered frame, 0 if none */
+   uint8_t  Buf[256];
+   uint8_t  Reg[RX_VCHAN_REG_LEN];
+
+   RX_VCHAN_Stats_t Stats;
+
+} RX_VCHAN_Class_t;
+
+
+/************************/
+/** Exported Functions **/
+/************************/
+
+
+/******************************************************************************
+** Function: RX_VCHAN_OpenMedium
+**
+** Create or map the shared memory medium
+**
+** Notes:
+**   1. ShmName is a shm_open() name ("/name"). Returns NULL if the medium
+**      can't be mapped or an existing medium has a different layout.
+**   2. Used by both the receiver and transmitters.
+**
+*/
+RX_VCHAN_Medium_t *RX_VCHAN_OpenMedium(const char *ShmName);
+
+
+/******************************************************************************
+** Function: RX_VCHAN_Transmit
+**
+** Publish a transmission starting now
+**
+** Notes:
+**   1. Any number of transmitters may share a medium. A transmitter should
+**      wait for the frame's time on air before its next transmission, the
+**      medium doesn't enforce it.
+**
+*/
+void RX_VCHAN_Transmit(RX_VCHAN_Medium_t *Medium, uint32_t FrequencyHz, uint8_t PacketType,
+                       const uint8_t *ModParam, uint8_t Crc, const uint8_t *Data, uint8_t Len);
+
+
+/******************************************************************************
+** Function: RX_VCHAN_Constructor
+**
+** Notes:
+**   1. The virtual radio starts in STDBY_RC with power-on settings. Only
+**      transmissions published after construction are received.
+**
+*/
+void RX_VCHAN_Constructor(RX_VCHAN_Class_t *Vchan, RX_VCHAN_Medium_t *Medium,
+                          const RX_VCHAN_Model_t *Model, RX_VCHAN_PhyFuncPtr_t PhyFunc);
+
+
+/******************************************************************************
+** Function: RX_VCHAN_Transfer
+**
+** Answer an SPI transfer as the SX128x would
+**
+** Notes:
+**   1. Follows the datasheet's SPI framing: every MISO byte that isn't
+**      read data is the status byte. Commands the receive path doesn't
+**      use are accepted and ignored.
+**
+*/
+void RX_VCHAN_Transfer(RX_VCHAN_Class_t *Vchan, const uint8_t *Mosi, uint8_t *Miso, uint16_t Len);
+
+
+/******************************************************************************
+** Function: RX_VCHAN_Poll
+**
+** Take new transmissions from the medium and complete the ones that ended
+**
+** Notes:
+**   1. Returns true while a DIO1 mapped IRQ is pending. NextNs is set to
+**      the time of the next event or 0 if none is scheduled.
+**
+*/
+bool RX_VCHAN_Poll(RX_VCHAN_Class_t *Vchan, int64_t *NextNs);
+
+
+/******************************************************************************
+** Function: RX_VCHAN_TimeNs
+**
+** Return the medium time, see note 3
+**
+*/
+int64_t RX_VCHAN_TimeNs(void);
+
+
+/******************************************************************************
+** Function: RX_VCHAN_ResetStatus
+**
+*/
+void RX_VCHAN_ResetStatus(RX_VCHAN_Class_t *Vchan);
+
+
+#endif /* _rx_vchan_ */
@@ -0,0 +1,246 @@
+/*
+**  This program is free software: you can redistribute it and/or modify
+**  it under the terms of the GNU Lesser General Public License as
+**  published by the Free Software Foundation, either version 3 of the
+**  License, or (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Lesser General Public License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public License
+**  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+**
+**  Purpose:
+**    Implement the channel scan table
+**
+**  Notes:
+**    1. See scan_tbl.h for details.
+**
+*/
+
+/*
+** Include Files:
+*/
+
+#include <stdio.h>
+#include <string.h>
+#include "scan_tbl.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define JSON_OBJ_CNT  (1 + 2*RADIO_RX_SCAN_MAX_CHANNELS)
+#define QUERY_LEN     32
+
+
+/**********************/
+/** Global File Data **/
+/**********************/
+
+static SCAN_TBL_Class_t *ScanTbl = NULL;
+
+static SCAN_TBL_Data_t TblData;  /* Working buffer for loads */
+
+static CJSON_Obj_t JsonTblObjs[JSON_OBJ_CNT];
+static char        JsonQuery[JSON_OBJ_CNT][QUERY_LEN];
+
+
+/*******************************/
+/** Local Function Prototypes **/
+/*******************************/
+
+static bool LoadJsonData(size_t JsonFileLen);
+
+
+/******************************************************************************
+** Function: SCAN_TBL_Constructor
+**
+*/
+void SCAN_TBL_Constructor(SCAN_TBL_Class_t *ScanTblPtr)
+{
+
+   uint16 i;
+
+   ScanTbl = ScanTblPtr;
+
+   memset(ScanTbl, 0, sizeof(SCAN_TBL_Class_t));
+
+   CJSON_ObjConstructor(&JsonTblObjs[0], "cad-symbols", JSONNumber, &TblData.CadSymbols, 2);
+
+   for (i = 0; i < RADIO_RX_SCAN_MAX_CHANNELS; i++)
+   {
+      snprintf(JsonQuery[1+2*i], QUERY_LEN, "channel[%d].frequency", i);
+      snprintf(JsonQuery[2+2*i], QUERY_LEN, "channel[%d].sf", i);
+      CJSON_ObjConstructor(&JsonTblObjs[1+2*i], JsonQuery[1+2*i], JSONNumber, &TblData.Channel[i].Frequency, 4);
+      CJSON_ObjConstructor(&JsonTblObjs[2+2*i], JsonQuery[2+2*i], JSONNumber, &TblData.Channel[i].SpreadingFactor, 2);
+   }
+   ScanTbl->JsonObjCnt = JSON_OBJ_CNT;
+
+} /* End SCAN_TBL_Constructor() */
+
+
+/******************************************************************************
+** Function: SCAN_TBL_ResetStatus
+**
+*/
+void SCAN_TBL_ResetStatus(void)
+{
+
+   /* Nothing to do */
+
+} /* End SCAN_TBL_ResetStatus() */
+
+
+/******************************************************************************
+** Function: SCAN_TBL_DumpCmd
+**
+** Notes:
+**  1. Function signature must match TBLMGR_DumpTblFuncPtr_t.
+**  2. Can assume valid table filename because this is a callback from
+**     the app framework table manager that has verified the file.
+**  3. DumpType is unused.
+**
+*/
+bool SCAN_TBL_DumpCmd(TBLMGR_Tbl_t *Tbl, uint8 DumpType, const char *Filename)
+{
+
+   bool       RetStatus = false;
+   int32      SysStatus;
+   osal_id_t  FileHandle;
+   uint16     i;
+   char       DumpRecord[256];
+
+   SysStatus = OS_OpenCreate(&FileHandle, Filename, OS_FILE_FLAG_CREATE | OS_FILE_FLAG_TRUNCATE, OS_WRITE_ONLY);
+
+   if (SysStatus == OS_SUCCESS)
+   {
+
+      sprintf(DumpRecord,"{\n   \"name\": \"LoRa Receive Scan Table\",\n   \"description\": \"CAD scan channels\",\n");
+      OS_write(FileHandle, DumpRecord, strlen(DumpRecord));
+
+      sprintf(DumpRecord,"   \"cad-symbols\": %d,\n   \"channel\": [\n", ScanTbl->Data.CadSymbols);
+      OS_write(FileHandle, DumpRecord, strlen(DumpRecord));
+
+      for (i = 0; i < ScanTbl->Data.ChannelCnt; i++)
+      {
+         sprintf(DumpRecord,"      {\"frequency\": %u, \"sf\": %d}%s\n",
+                 (unsigned int)ScanTbl->Data.Channel[i].Frequency, ScanTbl->Data.Channel[i].SpreadingFactor,
+                 (i < ScanTbl->Data.ChannelCnt-1) ? "," : "");
+         OS_write(FileHandle, DumpRecord, strlen(DumpRecord));
+      }
+
+      sprintf(DumpRecord,"   ]\n}\n");
+      OS_write(FileHandle, DumpRecord, strlen(DumpRecord));
+
+      OS_close(FileHandle);
+
+      CFE_EVS_SendEvent(SCAN_TBL_DUMP_EID, CFE_EVS_EventType_DEBUG,
+                        "Successfully dumped scan table to %s", Filename);
+      RetStatus = true;
+
+   } /* End if file create */
+   else
+   {
+
+      CFE_EVS_SendEvent(SCAN_TBL_DUMP_EID, CFE_EVS_EventType_ERROR,
+                        "Error creating dump file '%s', status=0x%08X",
+                        Filename, SysStatus);
+
+   } /* End if file create error */
+
+   return RetStatus;
+
+} /* End of SCAN_TBL_DumpCmd() */
+
+
+/******************************************************************************
+** Function: SCAN_TBL_LoadCmd
+**
+** Notes:
+**  1. Function signature must match TBLMGR_LoadTblFuncPtr_t.
+**
+*/
+bool SCAN_TBL_LoadCmd(TBLMGR_Tbl_t *Tbl, uint8 LoadType, const char *Filename)
+{
+
+   bool RetStatus = false;
+
+   if (LoadType == TBLMGR_LOAD_TBL_REPLACE)
+   {
+      if (CJSON_ProcessFile(Filename, ScanTbl->JsonBuf, SCAN_TBL_JSON_FILE_MAX_CHAR, LoadJsonData))
+      {
+         ScanTbl->Loaded = true;
+         RetStatus = true;
+      }
+   }
+   else
+   {
+      CFE_EVS_SendEvent(SCAN_TBL_LOAD_EID, CFE_EVS_EventType_ERROR,
+                        "Scan table load rejected, only replace loads are supported");
+   }
+
+   return RetStatus;
+
+} /* End SCAN_TBL_LoadCmd() */
+
+
+/******************************************************************************
+** Function: LoadJsonData
+**
+** Notes:
+**  1. Channels must be contiguous starting at channel[0]. A channel must
+**     have both a frequency and a spreading factor.
+**
+*/
+static bool LoadJsonData(size_t JsonFileLen)
+{
+
+   bool   RetStatus = false;
+   uint16 ChannelCnt;
+   uint16 i;
+
+   ScanTbl->JsonFileLen = JsonFileLen;
+
+   memset(&TblData, 0, sizeof(TblData));
+   for (i = 0; i < JSON_OBJ_CNT; i++)
+   {
+      JsonTblObjs[i].Updated = false;
+   }
+
+   CJSON_LoadObjArray(JsonTblObjs, ScanTbl->JsonObjCnt, ScanTbl->JsonBuf, ScanTbl->JsonFileLen);
+
+   for (ChannelCnt = 0; ChannelCnt < RADIO_RX_SCAN_MAX_CHANNELS; ChannelCnt++)
+   {
+      if (!JsonTblObjs[1+2*ChannelCnt].Updated || !JsonTblObjs[2+2*ChannelCnt].Updated)
+      {
+         break;
+      }
+   }
+
+   if (!JsonTblObjs[0].Updated || ChannelCnt == 0)
+   {
+      CFE_EVS_SendEvent(SCAN_TBL_LOAD_EID, CFE_EVS_EventType_ERROR,
+                        "Scan table load rejected, cad-symbols or channels not defined");
+   }
+   else if (TblData.CadSymbols != 1 && TblData.CadSymbols != 2 && TblData.CadSymbols != 4 &&
+            TblData.CadSymbols != 8 && TblData.CadSymbols != 16)
+   {
+      CFE_EVS_SendEvent(SCAN_TBL_LOAD_EID, CFE_EVS_EventType_ERROR,
+                        "Scan table load rejected, invalid cad-symbols %d", TblData.CadSymbols);
+   }
+   else
+   {
+      TblData.ChannelCnt = ChannelCnt;
+      memcpy(&ScanTbl->Data, &TblData, sizeof(SCAN_TBL_Data_t));
+      CFE_EVS_SendEvent(SCAN_TBL_LOAD_EID, CFE_EVS_EventType_INFORMATION,
+                        "Loaded %d scan channels", ChannelCnt);
+      RetStatus = true;
+   }
+
+   return RetStatus;
+
+} /* End LoadJsonData() */
@@ -0,0 +1,146 @@
+/*
+**  This program is free software: you can redistribute it and/or modify
+**  it under the terms of the GNU Lesser General Public License as
+**  published by the Free Software Foundation, either version 3 of the
+**  License, or (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Lesser General Public License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public License
+**  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+**
+**  Purpose:
+**    Define the channel scan table
+**
+**  Notes:
+**    1. The table defines the frequency/spreading factor pairs that are
+**       cycled by the channel activity detection scan. See radio_rx.h.
+**    2. Frequencies are in kHz so a channel list can follow Doppler offsets
+**       that are smaller than the 1 MHz radio frequency command step.
+**    3. A load doesn't affect a scan in progress, the new channels are used
+**       when the next scan is started.
+**
+*/
+
+#ifndef _scan_tbl_
+#define _scan_tbl_
+
+/*
+** Includes
+*/
+
+#include "app_cfg.h"
+#include "radio_rx.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+
+/*
+** Event Message IDs
+*/
+
+#define SCAN_TBL_DUMP_EID  (SCAN_TBL_BASE_EID + 0)
+#define SCAN_TBL_LOAD_EID  (SCAN_TBL_BASE_EID + 1)
+
+#define SCAN_TBL_NAME  "Scan"
+
+#define SCAN_TBL_JSON_FILE_MAX_CHAR  4000
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+
+typedef struct
+{
+   uint32  Frequency;        /* kHz */
+   uint16  SpreadingFactor;  /* SX128x.hpp RadioLoRaSpreadingFactors_t */
+
+} SCAN_TBL_Channel_t;
+
+
+typedef struct
+{
+   uint16  CadSymbols;       /* 1, 2, 4, 8 or 16 */
+   uint16  ChannelCnt;
+   SCAN_TBL_Channel_t Channel[RADIO_RX_SCAN_MAX_CHANNELS];
+
+} SCAN_TBL_Data_t;
+
+
+/******************************************************************************
+** SCAN_TBL_Class
+*/
+typedef struct
+{
+
+   /*
+   ** Class State Data
+   */
+
+   bool            Loaded;
+   SCAN_TBL_Data_t Data;
+
+   size_t JsonObjCnt;
+   char   JsonBuf[SCAN_TBL_JSON_FILE_MAX_CHAR];
+   size_t JsonFileLen;
+
+} SCAN_TBL_Class_t;
+
+
+/************************/
+/** Exported Functions **/
+/************************/
+
+
+/******************************************************************************
+** Function: SCAN_TBL_Constructor
+**
+** Initialize the scan table object to a known state
+**
+** Notes:
+**   1. This must be called prior to any other function.
+**
+*/
+void SCAN_TBL_Constructor(SCAN_TBL_Class_t *ScanTblPtr);
+
+
+/******************************************************************************
+** Function: SCAN_TBL_DumpCmd
+**
+** Notes:
+**  1. Function signature must match TBLMGR_DumpTblFuncPtr_t.
+**
+*/
+bool SCAN_TBL_DumpCmd(TBLMGR_Tbl_t *Tbl, uint8 DumpType, const char *Filename);
+
+
+/******************************************************************************
+** Function: SCAN_TBL_LoadCmd
+**
+** Notes:
+**  1. Function signature must match TBLMGR_LoadTblFuncPtr_t.
+**  2. Only replace loads are supported because the channel list is
+**     always loaded as a unit.
+**
+*/
+bool SCAN_TBL_LoadCmd(TBLMGR_Tbl_t *Tbl, uint8 LoadType, const char *Filename);
+
+
+/******************************************************************************
+** Function: SCAN_TBL_ResetStatus
+**
+** Reset counters and status flags to a known reset state.
+**
+*/
+void SCAN_TBL_ResetStatus(void);
+
+
+#endif /* _scan_tbl_ */
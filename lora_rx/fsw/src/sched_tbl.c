@@ -0,0 +1,402 @@
+/*
+**  This program is free software: you can redistribute it and/or modify
+**  it under the terms of the GNU Lesser General Public License as
+**  published by the Free Software Foundation, either version 3 of the
+**  License, or (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Lesser General Public License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public License
+**  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+**
+**  Purpose:
+**    Implement the receive schedule table
+**
+**  Notes:
+**    1. See sched_tbl.h for details.
+**
+*/
+
+/*
+** Include Files:
+*/
+
+#include <stdio.h>
+#include <string.h>
+#include "sched_tbl.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define SCHED_JSON_FIELDS  9
+#define JSON_OBJ_CNT       (SCHED_JSON_FIELDS*RX_SCHED_MAX_ENTRIES)
+#define QUERY_LEN          32
+
+/*
+** Field indices within an entry's JSON objects. The start field is
+** required and either the profile field or every parameter field.
+*/
+#define FIELD_START      0
+#define FIELD_PROFILE    3
+#define FIELD_FREQUENCY  4
+#define FIELD_CRC        8
+
+
+/**********************/
+/** Global File Data **/
+/**********************/
+
+static SCHED_TBL_Class_t *SchedTbl = NULL;
+
+static SCHED_TBL_Entry_t TblEntry[RX_SCHED_MAX_ENTRIES];   /* Working buffer for loads */
+static RX_SCHED_Plan_t   TblPlan;                          /* Compiled load */
+
+static CJSON_Obj_t JsonTblObjs[JSON_OBJ_CNT];
+static char        JsonQuery[JSON_OBJ_CNT][QUERY_LEN];
+
+
+/*******************************/
+/** Local Function Prototypes **/
+/*******************************/
+
+static bool LoadJsonData(size_t JsonFileLen);
+static bool LoadEntry(uint16 EntryIdx);
+
+
+/******************************************************************************
+** Function: SCHED_TBL_Constructor
+**
+*/
+void SCHED_TBL_Constructor(SCHED_TBL_Class_t *SchedTblPtr, const PROFILE_TBL_Class_t *ProfileTbl,
+                           SCHED_TBL_LoadFunc_t LoadFunc)
+{
+
+   static const char *FieldName[SCHED_JSON_FIELDS] =
+   {
+      "start", "start-us", "duration-ms", "profile", "frequency", "sf", "bw", "cr", "crc"
+   };
+   uint16 Obj;
+   uint16 i;
+   uint16 f;
+
+   SchedTbl = SchedTblPtr;
+
+   memset(SchedTbl, 0, sizeof(SCHED_TBL_Class_t));
+   SchedTbl->ProfileTbl = ProfileTbl;
+   SchedTbl->LoadFunc   = LoadFunc;
+
+   for (i = 0; i < RX_SCHED_MAX_ENTRIES; i++)
+   {
+      for (f = 0; f < SCHED_JSON_FIELDS; f++)
+      {
+         Obj = SCHED_JSON_FIELDS*i + f;
+         snprintf(JsonQuery[Obj], QUERY_LEN, "entry[%d].%s", i, FieldName[f]);
+      }
+      Obj = SCHED_JSON_FIELDS*i;
+      CJSON_ObjConstructor(&JsonTblObjs[Obj+0], JsonQuery[Obj+0], JSONNumber, &TblEntry[i].Start, 4);
+      CJSON_ObjConstructor(&JsonTblObjs[Obj+1], JsonQuery[Obj+1], JSONNumber, &TblEntry[i].StartUs, 4);
+      CJSON_ObjConstructor(&JsonTblObjs[Obj+2], JsonQuery[Obj+2], JSONNumber, &TblEntry[i].DurationMs, 4);
+      CJSON_ObjConstructor(&JsonTblObjs[Obj+3], JsonQuery[Obj+3], JSONNumber, &TblEntry[i].Profile, 2);
+      CJSON_ObjConstructor(&JsonTblObjs[Obj+4], JsonQuery[Obj+4], JSONNumber, &TblEntry[i].Frequency, 2);
+      CJSON_ObjConstructor(&JsonTblObjs[Obj+5], JsonQuery[Obj+5], JSONNumber, &TblEntry[i].SpreadingFactor, 2);
+      CJSON_ObjConstructor(&JsonTblObjs[Obj+6], JsonQuery[Obj+6], JSONNumber, &TblEntry[i].Bandwidth, 2);
+      CJSON_ObjConstructor(&JsonTblObjs[Obj+7], JsonQuery[Obj+7], JSONNumber, &TblEntry[i].CodingRate, 2);
+      CJSON_ObjConstructor(&JsonTblObjs[Obj+8], JsonQuery[Obj+8], JSONNumber, &TblEntry[i].Crc, 2);
+   }
+   SchedTbl->JsonObjCnt = JSON_OBJ_CNT;
+
+} /* End SCHED_TBL_Constructor() */
+
+
+/******************************************************************************
+** Function: SCHED_TBL_ResetStatus
+**
+*/
+void SCHED_TBL_ResetStatus(void)
+{
+
+   /* Nothing to do */
+
+} /* End SCHED_TBL_ResetStatus() */
+
+
+/******************************************************************************
+** Function: SCHED_TBL_DumpCmd
+**
+** Notes:
+**  1. Function signature must match TBLMGR_DumpTblFuncPtr_t.
+**  2. Can assume valid table filename because this is a callback from
+**     the app framework table manager that has verified the file.
+**  3. DumpType is unused.
+**
+*/
+bool SCHED_TBL_DumpCmd(TBLMGR_Tbl_t *Tbl, uint8 DumpType, const char *Filename)
+{
+
+   bool       RetStatus = false;
+   int32      SysStatus;
+   osal_id_t  FileHandle;
+   uint16     i;
+   char       DumpRecord[256];
+   const SCHED_TBL_Entry_t *Entry;
+
+   SysStatus = OS_OpenCreate(&FileHandle, Filename, OS_FILE_FLAG_CREATE | OS_FILE_FLAG_TRUNCATE, OS_WRITE_ONLY);
+
+   if (SysStatus == OS_SUCCESS)
+   {
+
+      sprintf(DumpRecord,"{\n   \"name\": \"LoRa Receive Schedule Table\",\n   \"description\": \"Time-tagged receive configurations\",\n   \"entry\": [\n");
+      OS_write(FileHandle, DumpRecord, strlen(DumpRecord));
+
+      for (i = 0; i < SchedTbl->EntryCnt; i++)
+      {
+         Entry = &SchedTbl->Entry[i];
+         if (Entry->Profile != RX_SCHED_NO_PROFILE)
+         {
+            sprintf(DumpRecord,"      {\"start\": %u, \"start-us\": %u, \"duration-ms\": %u, \"profile\": %d}%s\n",
+                    (unsigned int)Entry->Start, (unsigned int)Entry->StartUs, (unsigned int)Entry->DurationMs,
+                    Entry->Profile, (i < SchedTbl->EntryCnt-1) ? "," : "");
+         }
+         else
+         {
+            sprintf(DumpRecord,"      {\"start\": %u, \"start-us\": %u, \"duration-ms\": %u, \"frequency\": %d, "
+                    "\"sf\": %d, \"bw\": %d, \"cr\": %d, \"crc\": %d}%s\n",
+                    (unsigned int)Entry->Start, (unsigned int)Entry->StartUs, (unsigned int)Entry->DurationMs,
+                    Entry->Frequency, Entry->SpreadingFactor, Entry->Bandwidth, Entry->CodingRate, Entry->Crc,
+                    (i < SchedTbl->EntryCnt-1) ? "," : "");
+         }
+         OS_write(FileHandle, DumpRecord, strlen(DumpRecord));
+      }
+
+      sprintf(DumpRecord,"   ]\n}\n");
+      OS_write(FileHandle, DumpRecord, strlen(DumpRecord));
+
+      OS_close(FileHandle);
+
+      CFE_EVS_SendEvent(SCHED_TBL_DUMP_EID, CFE_EVS_EventType_DEBUG,
+                        "Successfully dumped schedule table to %s", Filename);
+      RetStatus = true;
+
+   } /* End if file create */
+   else
+   {
+
+      CFE_EVS_SendEvent(SCHED_TBL_DUMP_EID, CFE_EVS_EventType_ERROR,
+                        "Error creating dump file '%s', status=0x%08X",
+                        Filename, SysStatus);
+
+   } /* End if file create error */
+
+   return RetStatus;
+
+} /* End of SCHED_TBL_DumpCmd() */
+
+
+/******************************************************************************
+** Function: SCHED_TBL_LoadCmd
+**
+** Notes:
+**  1. Function signature must match TBLMGR_LoadTblFuncPtr_t.
+**
+*/
+bool SCHED_TBL_LoadCmd(TBLMGR_Tbl_t *Tbl, uint8 LoadType, const char *Filename)
+{
+
+   bool RetStatus = false;
+
+   if (LoadType == TBLMGR_LOAD_TBL_REPLACE)
+   {
+      if (CJSON_ProcessFile(Filename, SchedTbl->JsonBuf, SCHED_TBL_JSON_FILE_MAX_CHAR, LoadJsonData))
+      {
+         SchedTbl->Loaded = true;
+         RetStatus = true;
+      }
+   }
+   else
+   {
+      CFE_EVS_SendEvent(SCHED_TBL_LOAD_EID, CFE_EVS_EventType_ERROR,
+                        "Schedule table load rejected, only replace loads are supported");
+   }
+
+   return RetStatus;
+
+} /* End SCHED_TBL_LoadCmd() */
+
+
+/******************************************************************************
+** Function: LoadJsonData
+**
+** Notes:
+**  1. Entries must be contiguous starting at entry[0]. Each entry is
+**     compiled into TblPlan and the plan is only passed on if every entry
+**     compiles.
+**
+*/
+static bool LoadJsonData(size_t JsonFileLen)
+{
+
+   bool    RetStatus = true;
+   uint16  EntryCnt;
+   int16   OutOfOrder;
+   uint16  i;
+
+   SchedTbl->JsonFileLen = JsonFileLen;
+
+   memset(TblEntry, 0, sizeof(TblEntry));
+   memset(&TblPlan, 0, sizeof(TblPlan));
+   for (i = 0; i < JSON_OBJ_CNT; i++)
+   {
+      JsonTblObjs[i].Updated = false;
+   }
+
+   CJSON_LoadObjArray(JsonTblObjs, SchedTbl->JsonObjCnt, SchedTbl->JsonBuf, SchedTbl->JsonFileLen);
+
+   for (EntryCnt = 0; EntryCnt < RX_SCHED_MAX_ENTRIES; EntryCnt++)
+   {
+      if (!JsonTblObjs[SCHED_JSON_FIELDS*EntryCnt + FIELD_START].Updated)
+      {
+         break;
+      }
+   }
+
+   for (i = 0; i < EntryCnt && RetStatus; i++)
+   {
+      RetStatus = LoadEntry(i);
+   }
+   TblPlan.EntryCnt = EntryCnt;
+
+   if (RetStatus)
+   {
+      OutOfOrder = RX_SCHED_Check(&TblPlan);
+      if (OutOfOrder >= 0)
+      {
+         CFE_EVS_SendEvent(SCHED_TBL_LOAD_EID, CFE_EVS_EventType_ERROR,
+                           "Schedule table load rejected, entry[%d] doesn't start after entry[%d]",
+                           OutOfOrder, OutOfOrder-1);
+         RetStatus = false;
+      }
+      else if (EntryCnt > 0 && TblEntry[EntryCnt-1].DurationMs == 0)
+      {
+         CFE_EVS_SendEvent(SCHED_TBL_LOAD_EID, CFE_EVS_EventType_ERROR,
+                           "Schedule table load rejected, the last entry needs a duration");
+         RetStatus = false;
+      }
+      else if (!SchedTbl->LoadFunc(&TblPlan))
+      {
+         RetStatus = false;
+      }
+   }
+
+   if (RetStatus)
+   {
+      memcpy(SchedTbl->Entry, TblEntry, sizeof(TblEntry));
+      SchedTbl->EntryCnt = EntryCnt;
+      if (EntryCnt > 0)
+      {
+         CFE_EVS_SendEvent(SCHED_TBL_LOAD_EID, CFE_EVS_EventType_INFORMATION,
+                           "Loaded %d schedule entries, first at %u.%06u",
+                           EntryCnt, (unsigned int)TblEntry[0].Start, (unsigned int)TblEntry[0].StartUs);
+      }
+      else
+      {
+         CFE_EVS_SendEvent(SCHED_TBL_LOAD_EID, CFE_EVS_EventType_INFORMATION,
+                           "Loaded an empty schedule, the schedule is cleared");
+      }
+   }
+
+   return RetStatus;
+
+} /* End LoadJsonData() */
+
+
+/******************************************************************************
+** Function: LoadEntry
+**
+** Validate and compile a working buffer entry into its TblPlan slot.
+**
+*/
+static bool LoadEntry(uint16 EntryIdx)
+{
+
+   bool RetStatus = false;
+   const CJSON_Obj_t *Obj = &JsonTblObjs[SCHED_JSON_FIELDS*EntryIdx];
+   SCHED_TBL_Entry_t *Entry = &TblEntry[EntryIdx];
+   RX_SCHED_Entry_t  *PlanEntry = &TblPlan.Entry[EntryIdx];
+   uint16 f;
+   bool   ParamsDefined = true;
+
+   for (f = FIELD_FREQUENCY; f <= FIELD_CRC; f++)
+   {
+      ParamsDefined &= Obj[f].Updated;
+   }
+   if (!Obj[FIELD_PROFILE].Updated)
+   {
+      Entry->Profile = RX_SCHED_NO_PROFILE;
+   }
+
+   if (Entry->StartUs >= 1000000)
+   {
+      CFE_EVS_SendEvent(SCHED_TBL_LOAD_EID, CFE_EVS_EventType_ERROR,
+                        "Schedule table load rejected, entry[%d] start-us %u isn't less than 1000000",
+                        EntryIdx, (unsigned int)Entry->StartUs);
+   }
+   else if (Obj[FIELD_PROFILE].Updated == ParamsDefined)
+   {
+      CFE_EVS_SendEvent(SCHED_TBL_LOAD_EID, CFE_EVS_EventType_ERROR,
+                        "Schedule table load rejected, entry[%d] needs either a profile or frequency, sf, bw, cr and crc",
+                        EntryIdx);
+   }
+   else if (Obj[FIELD_PROFILE].Updated &&
+            (Entry->Profile >= PROFILE_TBL_MAX_PROFILES || !SchedTbl->ProfileTbl->Profile[Entry->Profile].Valid))
+   {
+      CFE_EVS_SendEvent(SCHED_TBL_LOAD_EID, CFE_EVS_EventType_ERROR,
+                        "Schedule table load rejected, entry[%d] profile %d isn't defined",
+                        EntryIdx, Entry->Profile);
+   }
+   else if (ParamsDefined && (Entry->Frequency == 0 || Entry->SpreadingFactor > 0xFF ||
+            Entry->Bandwidth > 0xFF || Entry->CodingRate > 0xFF || Entry->Crc > 0xFF))
+   {
+      CFE_EVS_SendEvent(SCHED_TBL_LOAD_EID, CFE_EVS_EventType_ERROR,
+                        "Schedule table load rejected, entry[%d] has no frequency or a register value exceeds 8 bits",
+                        EntryIdx);
+   }
+   else
+   {
+      PlanEntry->StartNs    = (int64)Entry->Start*1000000000 + (int64)Entry->StartUs*1000;
+      PlanEntry->DurationMs = Entry->DurationMs;
+      PlanEntry->ProfileId  = (uint8)Entry->Profile;
+
+      if (ParamsDefined)
+      {
+         snprintf(PlanEntry->Def.Name, RADIO_RX_PROFILE_NAME_LEN, "sched-%d", EntryIdx);
+         PlanEntry->Def.Mod             = RADIO_RX_MOD_LORA;
+         PlanEntry->Def.Frequency       = Entry->Frequency;
+         PlanEntry->Def.SpreadingFactor = (uint8)Entry->SpreadingFactor;
+         PlanEntry->Def.Bandwidth       = (uint8)Entry->Bandwidth;
+         PlanEntry->Def.CodingRate      = (uint8)Entry->CodingRate;
+         PlanEntry->Def.Crc             = (uint8)Entry->Crc;
+      }
+      else
+      {
+         PlanEntry->Def = SchedTbl->ProfileTbl->Profile[Entry->Profile].Def;
+      }
+
+      if (RADIO_RX_CompileProfile(&PlanEntry->Def, &PlanEntry->Image))
+      {
+         RetStatus = true;
+      }
+      else
+      {
+         CFE_EVS_SendEvent(SCHED_TBL_LOAD_EID, CFE_EVS_EventType_ERROR,
+                           "Schedule table load rejected, entry[%d] has invalid radio parameters", EntryIdx);
+      }
+   }
+
+   return RetStatus;
+
+} /* End LoadEntry() */
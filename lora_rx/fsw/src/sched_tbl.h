@@ -0,0 +1,164 @@
+/*
+**  This program is free software: you can redistribute it and/or modify
+**  it under the terms of the GNU Lesser General Public License as
+**  published by the Free Software Foundation, either version 3 of the
+**  License, or (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Lesser General Public License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public License
+**  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+**
+**  Purpose:
+**    Define the receive schedule table
+**
+**  Notes:
+**    1. Each entry retunes the receiver at a mission time, either to a
+**       profile table profile or to a frequency and LoRa parameters, for
+**       a duration. See rx_sched.h for how entries are executed.
+**    2. Profiles are copied and compiled when the schedule is loaded so
+**       later profile table loads don't change a loaded schedule.
+**    3. A load replaces the schedule while it's running. A table with no
+**       entries clears the schedule.
+**    4. Profile entries without a frequency receive on the commanded
+**       frequency at the time of the load.
+**
+*/
+
+#ifndef _sched_tbl_
+#define _sched_tbl_
+
+/*
+** Includes
+*/
+
+#include "app_cfg.h"
+#include "rx_sched.h"
+#include "profile_tbl.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+
+/*
+** Event Message IDs
+*/
+
+#define SCHED_TBL_DUMP_EID  (SCHED_TBL_BASE_EID + 0)
+#define SCHED_TBL_LOAD_EID  (SCHED_TBL_BASE_EID + 1)
+#define SCHED_TBL_EXEC_EID  (SCHED_TBL_BASE_EID + 2)   /* Execution reports, sent by radio_if */
+
+#define SCHED_TBL_NAME  "Schedule"
+
+#define SCHED_TBL_JSON_FILE_MAX_CHAR  8000
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+
+/*
+** Called with a compiled plan, returns false if the plan wasn't accepted.
+** The owner sets the plan's base profile.
+*/
+typedef bool (*SCHED_TBL_LoadFunc_t)(RX_SCHED_Plan_t *Plan);
+
+
+typedef struct
+{
+   uint32  Start;           /* Mission seconds */
+   uint32  StartUs;
+   uint32  DurationMs;      /* 0 holds the entry until the next one starts */
+   uint16  Profile;         /* Profile table id, RX_SCHED_NO_PROFILE if parameters are used */
+   uint16  Frequency;       /* MHz, parameter entries only */
+   uint16  SpreadingFactor;
+   uint16  Bandwidth;
+   uint16  CodingRate;
+   uint16  Crc;
+
+} SCHED_TBL_Entry_t;
+
+
+/******************************************************************************
+** SCHED_TBL_Class
+*/
+typedef struct
+{
+
+   /*
+   ** Class State Data
+   */
+
+   bool    Loaded;
+   uint16  EntryCnt;
+   SCHED_TBL_Entry_t Entry[RX_SCHED_MAX_ENTRIES];
+
+   const PROFILE_TBL_Class_t *ProfileTbl;
+   SCHED_TBL_LoadFunc_t LoadFunc;
+
+   size_t JsonObjCnt;
+   char   JsonBuf[SCHED_TBL_JSON_FILE_MAX_CHAR];
+   size_t JsonFileLen;
+
+} SCHED_TBL_Class_t;
+
+
+/************************/
+/** Exported Functions **/
+/************************/
+
+
+/******************************************************************************
+** Function: SCHED_TBL_Constructor
+**
+** Initialize the schedule table object to a known state
+**
+** Notes:
+**   1. This must be called prior to any other function.
+**   2. Profile entries are resolved from ProfileTbl. A loaded table is
+**      passed to LoadFunc.
+**
+*/
+void SCHED_TBL_Constructor(SCHED_TBL_Class_t *SchedTblPtr, const PROFILE_TBL_Class_t *ProfileTbl,
+                           SCHED_TBL_LoadFunc_t LoadFunc);
+
+
+/******************************************************************************
+** Function: SCHED_TBL_DumpCmd
+**
+** Notes:
+**  1. Function signature must match TBLMGR_DumpTblFuncPtr_t.
+**
+*/
+bool SCHED_TBL_DumpCmd(TBLMGR_Tbl_t *Tbl, uint8 DumpType, const char *Filename);
+
+
+/******************************************************************************
+** Function: SCHED_TBL_LoadCmd
+**
+** Notes:
+**  1. Function signature must match TBLMGR_LoadTblFuncPtr_t.
+**  2. Only replace loads are supported. A load is rejected if any entry
+**     is invalid, the entries aren't in start time order or the last
+**     entry has no duration.
+**
+*/
+bool SCHED_TBL_LoadCmd(TBLMGR_Tbl_t *Tbl, uint8 LoadType, const char *Filename);
+
+
+/******************************************************************************
+** Function: SCHED_TBL_ResetStatus
+**
+** Reset counters and status flags to a known reset state.
+**
+*/
+void SCHED_TBL_ResetStatus(void);
+
+
+#endif /* _sched_tbl_ */
@@ -0,0 +1,374 @@
+/*
+**  This program is free software: you can redistribute it and/or modify
+**  it under the terms of the GNU Lesser General Public License as
+**  published by the Free Software Foundation, either version 3 of the
+**  License, or (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Lesser General Public License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public License
+**  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+**
+**  Purpose:
+**    Implement the radio SPI transaction recorder and replayer
+**
+**  Notes:
+**    1. See spi_rec.h for details.
+**
+*/
+
+/*
+** Include Files:
+*/
+
+#include <string.h>
+#include "spi_rec.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define REC_LEN(DataLen)  ((uint16_t)((sizeof(SPI_REC_Hdr_t) + 2*(DataLen) + 7) & ~7u))
+
+
+/**********************/
+/** Global File Data **/
+/**********************/
+
+/*
+** Records are contiguous. A record that doesn't fit before the end of the
+** ring is preceded by a pad record that fills the rest of the ring. Used
+** counts the bytes from Tail to Head, including pads.
+*/
+static uint64_t RingWords[SPI_REC_RING_BYTES/8];
+static uint8_t  *const Ring = (uint8_t *)RingWords;
+
+static bool     Lock = false;
+static bool     Enabled = false;
+static uint32_t Head;
+static uint32_t Tail;
+static uint32_t Used;
+static uint32_t RecordCnt;
+static uint32_t AddCnt;
+static uint32_t EvictCnt;
+
+
+/*******************************/
+/** Local Function Prototypes **/
+/*******************************/
+
+static void MakeRoom(uint32_t Len);
+
+
+/******************************************************************************
+** Function: SPI_REC_Init
+**
+*/
+void SPI_REC_Init(bool EnableRec)
+{
+
+   while (__atomic_test_and_set(&Lock, __ATOMIC_ACQUIRE));
+
+   Head      = 0;
+   Tail      = 0;
+   Used      = 0;
+   RecordCnt = 0;
+   AddCnt    = 0;
+   EvictCnt  = 0;
+   __atomic_store_n(&Enabled, EnableRec, __ATOMIC_RELAXED);
+
+   __atomic_clear(&Lock, __ATOMIC_RELEASE);
+
+} /* End SPI_REC_Init() */
+
+
+/******************************************************************************
+** Function: SPI_REC_Enabled
+**
+*/
+bool SPI_REC_Enabled(void)
+{
+
+   return __atomic_load_n(&Enabled, __ATOMIC_RELAXED);
+
+} /* End SPI_REC_Enabled() */
+
+
+/******************************************************************************
+** Function: SPI_REC_Add
+**
+*/
+void SPI_REC_Add(const uint8_t *Mosi, const uint8_t *Miso, uint16_t Len,
+                 int64_t TimeNs, uint32_t DurationNs, uint32_t BusyNs)
+{
+
+   SPI_REC_Hdr_t *Hdr;
+   uint16_t DataLen = (Len > SPI_REC_MAX_DATA) ? SPI_REC_MAX_DATA : Len;
+   uint16_t RecLen  = REC_LEN(DataLen);
+   uint32_t PadLen;
+
+   if (!__atomic_load_n(&Enabled, __ATOMIC_RELAXED) || Len == 0)
+   {
+      return;
+   }
+
+   while (__atomic_test_and_set(&Lock, __ATOMIC_ACQUIRE));
+
+   if (Head + RecLen > SPI_REC_RING_BYTES)
+   {
+      PadLen = SPI_REC_RING_BYTES - Head;
+      MakeRoom(PadLen);
+      Hdr = (SPI_REC_Hdr_t *)&Ring[Head];
+      Hdr->RecLen = (uint16_t)PadLen;
+      Hdr->Flags  = SPI_REC_FLAG_PAD;
+      Used += PadLen;
+      Head  = 0;
+   }
+
+   MakeRoom(RecLen);
+
+   Hdr = (SPI_REC_Hdr_t *)&Ring[Head];
+   Hdr->RecLen     = RecLen;
+   Hdr->Opcode     = Mosi[0];
+   Hdr->Flags      = (DataLen < Len) ? SPI_REC_FLAG_TRUNCATED : 0;
+   Hdr->Len        = Len;
+   Hdr->DataLen    = DataLen;
+   Hdr->TimeNs     = TimeNs;
+   Hdr->DurationNs = DurationNs;
+   Hdr->BusyNs     = BusyNs;
+   memcpy(&Ring[Head + sizeof(SPI_REC_Hdr_t)], Mosi, DataLen);
+   memcpy(&Ring[Head + sizeof(SPI_REC_Hdr_t) + DataLen], Miso, DataLen);
+
+   Head  = (Head + RecLen) % SPI_REC_RING_BYTES;
+   Used += RecLen;
+   RecordCnt++;
+   AddCnt++;
+
+   __atomic_clear(&Lock, __ATOMIC_RELEASE);
+
+} /* End SPI_REC_Add() */
+
+
+/******************************************************************************
+** Function: SPI_REC_Snapshot
+**
+*/
+uint32_t SPI_REC_Snapshot(uint8_t *Buf)
+{
+
+   SPI_REC_FileHdr_t FileHdr;
+   const SPI_REC_Hdr_t *Hdr;
+   uint32_t Offset;
+   uint32_t Remaining;
+   uint32_t Len = sizeof(SPI_REC_FileHdr_t);
+
+   while (__atomic_test_and_set(&Lock, __ATOMIC_ACQUIRE));
+
+   FileHdr.Magic     = SPI_REC_FILE_MAGIC;
+   FileHdr.Version   = SPI_REC_FILE_VERSION;
+   FileHdr.HdrLen    = sizeof(SPI_REC_Hdr_t);
+   FileHdr.RecordCnt = RecordCnt;
+
+   for (Offset = Tail, Remaining = Used; Remaining > 0; Remaining -= Hdr->RecLen)
+   {
+      Hdr = (const SPI_REC_Hdr_t *)&Ring[Offset];
+      if (!(Hdr->Flags & SPI_REC_FLAG_PAD))
+      {
+         memcpy(&Buf[Len], Hdr, Hdr->RecLen);
+         Len += Hdr->RecLen;
+      }
+      Offset = (Offset + Hdr->RecLen) % SPI_REC_RING_BYTES;
+   }
+
+   __atomic_clear(&Lock, __ATOMIC_RELEASE);
+
+   FileHdr.RecordLen = Len - sizeof(SPI_REC_FileHdr_t);
+   memcpy(Buf, &FileHdr, sizeof(SPI_REC_FileHdr_t));
+
+   return Len;
+
+} /* End SPI_REC_Snapshot() */
+
+
+/******************************************************************************
+** Function: SPI_REC_GetStatus
+**
+*/
+void SPI_REC_GetStatus(SPI_REC_Status_t *Status)
+{
+
+   while (__atomic_test_and_set(&Lock, __ATOMIC_ACQUIRE));
+
+   Status->Enabled   = Enabled;
+   Status->RecordCnt = RecordCnt;
+   Status->AddCnt    = AddCnt;
+   Status->EvictCnt  = EvictCnt;
+
+   __atomic_clear(&Lock, __ATOMIC_RELEASE);
+
+} /* End SPI_REC_GetStatus() */
+
+
+/******************************************************************************
+** Function: SPI_REC_ReplayOpen
+**
+*/
+bool SPI_REC_ReplayOpen(SPI_REC_Replay_t *Replay, const uint8_t *Buf, uint32_t Len)
+{
+
+   SPI_REC_FileHdr_t FileHdr;
+   const SPI_REC_Hdr_t *Hdr;
+   uint32_t Offset;
+   uint32_t End;
+   uint32_t Cnt = 0;
+
+   memset(Replay, 0, sizeof(SPI_REC_Replay_t));
+
+   if (Len < sizeof(SPI_REC_FileHdr_t))
+   {
+      return false;
+   }
+
+   memcpy(&FileHdr, Buf, sizeof(SPI_REC_FileHdr_t));
+   if (FileHdr.Magic != SPI_REC_FILE_MAGIC || FileHdr.Version != SPI_REC_FILE_VERSION ||
+       FileHdr.HdrLen != sizeof(SPI_REC_Hdr_t) || FileHdr.RecordLen > Len - sizeof(SPI_REC_FileHdr_t))
+   {
+      return false;
+   }
+
+   End = sizeof(SPI_REC_FileHdr_t) + FileHdr.RecordLen;
+   for (Offset = sizeof(SPI_REC_FileHdr_t); Offset < End; Offset += Hdr->RecLen)
+   {
+      if (End - Offset < sizeof(SPI_REC_Hdr_t))
+      {
+         return false;
+      }
+      Hdr = (const SPI_REC_Hdr_t *)&Buf[Offset];
+      if (Hdr->RecLen != REC_LEN(Hdr->DataLen) || Hdr->RecLen > End - Offset ||
+          Hdr->DataLen > Hdr->Len || (Hdr->Flags & SPI_REC_FLAG_PAD))
+      {
+         return false;
+      }
+      Cnt++;
+   }
+
+   if (Cnt != FileHdr.RecordCnt)
+   {
+      return false;
+   }
+
+   Replay->Buf       = Buf;
+   Replay->Len       = End;
+   Replay->Offset    = sizeof(SPI_REC_FileHdr_t);
+   Replay->RecordCnt = Cnt;
+
+   return true;
+
+} /* End SPI_REC_ReplayOpen() */
+
+
+/******************************************************************************
+** Function: SPI_REC_ReplayPeek
+**
+*/
+const SPI_REC_Hdr_t *SPI_REC_ReplayPeek(const SPI_REC_Replay_t *Replay)
+{
+
+   if (Replay->Buf == NULL || Replay->Offset >= Replay->Len)
+   {
+      return NULL;
+   }
+
+   return (const SPI_REC_Hdr_t *)&Replay->Buf[Replay->Offset];
+
+} /* End SPI_REC_ReplayPeek() */
+
+
+/******************************************************************************
+** Function: SPI_REC_ReplaySkip
+**
+*/
+void SPI_REC_ReplaySkip(SPI_REC_Replay_t *Replay)
+{
+
+   const SPI_REC_Hdr_t *Hdr = SPI_REC_ReplayPeek(Replay);
+
+   if (Hdr != NULL)
+   {
+      Replay->Offset += Hdr->RecLen;
+      Replay->ReplayCnt++;
+      Replay->SkipCnt++;
+   }
+
+} /* End SPI_REC_ReplaySkip() */
+
+
+/******************************************************************************
+** Function: SPI_REC_ReplayTransfer
+**
+*/
+bool SPI_REC_ReplayTransfer(SPI_REC_Replay_t *Replay, const uint8_t *Mosi, uint8_t *Miso, uint16_t Len)
+{
+
+   const SPI_REC_Hdr_t *Hdr = SPI_REC_ReplayPeek(Replay);
+   const uint8_t *RecMosi;
+   uint16_t CopyLen;
+   bool Match;
+
+   memset(Miso, 0, Len);
+
+   if (Hdr == NULL)
+   {
+      Replay->MismatchCnt++;
+      return false;
+   }
+
+   RecMosi = (const uint8_t *)Hdr + sizeof(SPI_REC_Hdr_t);
+   CopyLen = (Len < Hdr->DataLen) ? Len : Hdr->DataLen;
+
+   Match = (Hdr->Len == Len && memcmp(RecMosi, Mosi, CopyLen) == 0);
+   memcpy(Miso, RecMosi + Hdr->DataLen, CopyLen);
+
+   Replay->Offset += Hdr->RecLen;
+   Replay->ReplayCnt++;
+   if (!Match)
+   {
+      Replay->MismatchCnt++;
+   }
+
+   return Match;
+
+} /* End SPI_REC_ReplayTransfer() */
+
+
+/******************************************************************************
+** Function: MakeRoom
+**
+** Evict the oldest records until Len bytes are free after Head
+**
+** Notes:
+**   1. Called with the lock held. The free space always starts at Head.
+**
+*/
+static void MakeRoom(uint32_t Len)
+{
+
+   const SPI_REC_Hdr_t *Hdr;
+
+   while (SPI_REC_RING_BYTES - Used < Len)
+   {
+      Hdr  = (const SPI_REC_Hdr_t *)&Ring[Tail];
+      Tail = (Tail + Hdr->RecLen) % SPI_REC_RING_BYTES;
+      Used -= Hdr->RecLen;
+      if (!(Hdr->Flags & SPI_REC_FLAG_PAD))
+      {
+         RecordCnt--;
+         EvictCnt++;
+      }
+   }
+
+} /* End MakeRoom() */
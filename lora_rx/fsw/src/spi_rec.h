@@ -0,0 +1,221 @@
+/*
+**  This program is free software: you can redistribute it and/or modify
+**  it under the terms of the GNU Lesser General Public License as
+**  published by the Free Software Foundation, either version 3 of the
+**  License, or (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Lesser General Public License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public License
+**  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+**
+**  Purpose:
+**    Define the radio SPI transaction recorder and replayer
+**
+**  Notes:
+**    1. The radio bridge reports every SPI transfer to SPI_REC_Add() with
+**       its start time, duration and the BUSY wait that preceded it. Each
+**       transfer is stored as a variable length record in a byte ring.
+**       When the ring is full the oldest records are evicted.
+**    2. Transfers come from the radio IRQ context and from commands in the
+**       app's main task, so the ring has a spin lock. It's only held to
+**       copy a record in and, for SPI_REC_Snapshot(), to copy the ring out.
+**    3. A snapshot is a recording file image: an SPI_REC_FileHdr_t
+**       followed by the records, oldest first. The replayer walks a
+**       recording and answers transfers with the recorded MISO bytes, so
+**       a capture acts as a simulated radio for the bridge.
+**    4. Multi-byte fields are in host byte order.
+**    5. This header shouldn't include cFS or Lora_Rx app C header files.
+**
+*/
+
+#ifndef _spi_rec_
+#define _spi_rec_
+
+/*
+** Includes
+*/
+#include <stdbool.h>
+#include <stdint.h>
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define SPI_REC_RING_BYTES    65536
+#define SPI_REC_MAX_DATA      264          /* Bytes kept per direction, covers a 255 byte buffer read */
+
+#define SPI_REC_FILE_MAGIC    0x53504952   /* "SPIR" */
+#define SPI_REC_FILE_VERSION  1
+#define SPI_REC_FILE_MAX_LEN  (sizeof(SPI_REC_FileHdr_t) + SPI_REC_RING_BYTES)
+
+#define SPI_REC_FLAG_PAD        0x01       /* Ring filler, never in a recording file */
+#define SPI_REC_FLAG_TRUNCATED  0x02       /* Transfer longer than SPI_REC_MAX_DATA */
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+
+/*
+** Record header, followed by DataLen MOSI bytes and DataLen MISO bytes.
+** RecLen is padded to a multiple of 8.
+*/
+typedef struct
+{
+   uint16_t RecLen;
+   uint8_t  Opcode;       /* First MOSI byte */
+   uint8_t  Flags;
+   uint16_t Len;          /* Transfer length */
+   uint16_t DataLen;
+   int64_t  TimeNs;       /* CLOCK_MONOTONIC_RAW at the start of the transfer */
+   uint32_t DurationNs;
+   uint32_t BusyNs;       /* BUSY wait before the transfer */
+
+} SPI_REC_Hdr_t;
+
+
+typedef struct
+{
+   uint32_t Magic;
+   uint16_t Version;
+   uint16_t HdrLen;       /* sizeof(SPI_REC_Hdr_t) */
+   uint32_t RecordCnt;
+   uint32_t RecordLen;    /* Bytes of records following the file header */
+
+} SPI_REC_FileHdr_t;
+
+
+typedef struct
+{
+   bool     Enabled;
+   uint32_t RecordCnt;    /* Records in the ring */
+   uint32_t AddCnt;
+   uint32_t EvictCnt;
+
+} SPI_REC_Status_t;
+
+
+/*
+** Replay cursor. The recording must stay valid while it's replayed.
+*/
+typedef struct
+{
+   const uint8_t *Buf;
+   uint32_t Len;
+   uint32_t Offset;
+   uint32_t RecordCnt;
+   uint32_t ReplayCnt;    /* Records replayed or skipped */
+   uint32_t MismatchCnt;  /* Transfers whose MOSI bytes differ from the recording */
+   uint32_t SkipCnt;
+
+} SPI_REC_Replay_t;
+
+
+/************************/
+/** Exported Functions **/
+/************************/
+
+
+/******************************************************************************
+** Function: SPI_REC_Init
+**
+** Empty the ring and set the recording state
+**
+*/
+void SPI_REC_Init(bool Enabled);
+
+
+/******************************************************************************
+** Function: SPI_REC_Enabled
+**
+*/
+bool SPI_REC_Enabled(void);
+
+
+/******************************************************************************
+** Function: SPI_REC_Add
+**
+** Record a transfer
+**
+** Notes:
+**   1. Mosi and Miso hold Len bytes. Only SPI_REC_MAX_DATA of each are
+**      kept.
+**   2. Does nothing if recording is disabled.
+**
+*/
+void SPI_REC_Add(const uint8_t *Mosi, const uint8_t *Miso, uint16_t Len,
+                 int64_t TimeNs, uint32_t DurationNs, uint32_t BusyNs);
+
+
+/******************************************************************************
+** Function: SPI_REC_Snapshot
+**
+** Write a recording file image of the ring and return its length
+**
+** Notes:
+**   1. Buf must hold SPI_REC_FILE_MAX_LEN bytes.
+**
+*/
+uint32_t SPI_REC_Snapshot(uint8_t *Buf);
+
+
+/******************************************************************************
+** Function: SPI_REC_GetStatus
+**
+*/
+void SPI_REC_GetStatus(SPI_REC_Status_t *Status);
+
+
+/******************************************************************************
+** Function: SPI_REC_ReplayOpen
+**
+** Validate a recording file image and position the cursor at its start
+**
+** Notes:
+**   1. Buf must be 8 byte aligned.
+**
+*/
+bool SPI_REC_ReplayOpen(SPI_REC_Replay_t *Replay, const uint8_t *Buf, uint32_t Len);
+
+
+/******************************************************************************
+** Function: SPI_REC_ReplayPeek
+**
+** Return the next record or NULL at the end of the recording
+**
+*/
+const SPI_REC_Hdr_t *SPI_REC_ReplayPeek(const SPI_REC_Replay_t *Replay);
+
+
+/******************************************************************************
+** Function: SPI_REC_ReplaySkip
+**
+** Step over the next record without replaying it
+**
+*/
+void SPI_REC_ReplaySkip(SPI_REC_Replay_t *Replay);
+
+
+/******************************************************************************
+** Function: SPI_REC_ReplayTransfer
+**
+** Answer a transfer from the next record
+**
+** Notes:
+**   1. Miso gets the recorded MISO bytes, zero filled past the recorded
+**      data or when the recording has ended.
+**   2. Returns false and counts a mismatch if the opcode, length or
+**      recorded MOSI bytes differ. The record is consumed either way so
+**      the replay stays in step.
+**
+*/
+bool SPI_REC_ReplayTransfer(SPI_REC_Replay_t *Replay, const uint8_t *Mosi, uint8_t *Miso, uint16_t Len);
+
+
+#endif /* _spi_rec_ */
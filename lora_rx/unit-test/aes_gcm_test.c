@@ -0,0 +1,222 @@
+/*
+**  This program is free software: you can redistribute it and/or modify
+**  it under the terms of the GNU Lesser General Public License as
+**  published by the Free Software Foundation, either version 3 of the
+**  License, or (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Lesser General Public License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public License
+**  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+**
+**  Purpose:
+**    Host known answer test for the AES-GCM implementations
+**
+**  Notes:
+**    1. Uses test cases 4, 10 and 16 of the GCM specification submitted to
+**       NIST (McGrew and Viega), one for each AES key length. They share
+**       the plaintext, AAD and IV.
+**    2. Each implementation that AES_GCM_Init() selects on this CPU is
+**       tested, the others are reported as skipped.
+**
+*/
+
+/*
+** Include Files:
+*/
+
+#include <stdio.h>
+#include <string.h>
+#include "aes_gcm.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define KAT_MAX_LEN  64
+
+#define CHECK(Cond) Check((Cond), #Cond, __LINE__)
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+typedef struct
+{
+
+   const char *Name;
+   const char *Key;
+   const char *Cipher;
+   const char *Tag;
+
+} Kat_t;
+
+
+/**********************/
+/** Global File Data **/
+/**********************/
+
+static const char *KatPlain =
+   "d9313225f88406e5a55909c5aff5269a86a7a9531534f7da2e4c303d8a318a72"
+   "1c3c0c95956809532fcf0e2449a6b525b16aedf5aa0de657ba637b39";
+static const char *KatAad = "feedfacedeadbeeffeedfacedeadbeefabaddad2";
+static const char *KatIv  = "cafebabefacedbaddecaf888";
+
+static const Kat_t Kat[] =
+{
+   {
+      "Test Case 4 (AES-128)",
+      "feffe9928665731c6d6a8f9467308308",
+      "42831ec2217774244b7221b784d0d49ce3aa212f2c02a4e035c17e2329aca12e"
+      "21d514b25466931c7d8f6a5aac84aa051ba30b396a0aac973d58e091",
+      "5bc94fbc3221a5db94fae95ae7121a47"
+   },
+   {
+      "Test Case 10 (AES-192)",
+      "feffe9928665731c6d6a8f9467308308feffe9928665731c",
+      "3980ca0b3c00e841eb06fac4872a2757859e1ceaa6efd984628593b40ca1e19c"
+      "7d773d00c144c525ac619d18c84a3f4718e2448b2fe324d9ccda2710",
+      "2519498e80f1478f37ba55bd6d27618c"
+   },
+   {
+      "Test Case 16 (AES-256)",
+      "feffe9928665731c6d6a8f9467308308feffe9928665731c6d6a8f9467308308",
+      "522dc1f099567d07f47f37a32a84427d643a8cdcbfe5c0c97598a2bd2555d1aa"
+      "8cb08e48590dbb3da7b08b1056828838c5f61e6393ba7a0abcc9f662",
+      "76fc6ece0f4e1768cddf8853bb2d551b"
+   }
+};
+
+static const char *ImplName[] = { "portable", "AES-NI", "ARMv8 CE" };
+
+static int FailCnt;
+
+
+/******************************************************************************
+** Function: Check
+**
+*/
+static void Check(bool Passed, const char *Cond, int Line)
+{
+
+   if (!Passed)
+   {
+      printf("aes_gcm_test.c:%d: check failed: %s\n", Line, Cond);
+      FailCnt++;
+   }
+
+} /* End Check() */
+
+
+/******************************************************************************
+** Function: HexToBytes
+**
+** Return the number of bytes written to Bytes
+**
+*/
+static size_t HexToBytes(const char *Hex, uint8_t *Bytes)
+{
+
+   size_t Len = strlen(Hex)/2;
+   size_t i;
+   unsigned int Byte;
+
+   for (i = 0; i < Len; i++)
+   {
+      sscanf(&Hex[2*i], "%2x", &Byte);
+      Bytes[i] = (uint8_t)Byte;
+   }
+
+   return Len;
+
+} /* End HexToBytes() */
+
+
+/******************************************************************************
+** Function: TestKat
+**
+** Encrypt and decrypt one known answer test case with Impl
+**
+** Notes:
+**   1. A tampered tag must be rejected with the data left unchanged.
+**
+*/
+static void TestKat(const Kat_t *Test, AES_GCM_Impl_Enum_t Impl)
+{
+
+   AES_GCM_Ctx_t Ctx;
+   uint8_t Key[32];
+   uint8_t Iv[AES_GCM_IV_LEN];
+   uint8_t Aad[KAT_MAX_LEN];
+   uint8_t Plain[KAT_MAX_LEN];
+   uint8_t Cipher[KAT_MAX_LEN];
+   uint8_t Tag[AES_GCM_MAX_TAG_LEN];
+   uint8_t Data[KAT_MAX_LEN];
+   uint8_t OutTag[AES_GCM_MAX_TAG_LEN];
+   size_t  KeyLen   = HexToBytes(Test->Key, Key);
+   size_t  AadLen   = HexToBytes(KatAad, Aad);
+   size_t  PlainLen = HexToBytes(KatPlain, Plain);
+
+   HexToBytes(KatIv, Iv);
+   HexToBytes(Test->Cipher, Cipher);
+   HexToBytes(Test->Tag, Tag);
+
+   CHECK(AES_GCM_Init(&Ctx, Key, KeyLen, Impl));
+
+   memcpy(Data, Plain, PlainLen);
+   AES_GCM_Encrypt(&Ctx, Iv, Aad, AadLen, Data, PlainLen, OutTag, sizeof(OutTag));
+   CHECK(memcmp(Data, Cipher, PlainLen) == 0);
+   CHECK(memcmp(OutTag, Tag, sizeof(Tag)) == 0);
+
+   CHECK(AES_GCM_Decrypt(&Ctx, Iv, Aad, AadLen, Data, PlainLen, Tag, sizeof(Tag)));
+   CHECK(memcmp(Data, Plain, PlainLen) == 0);
+
+   memcpy(Data, Cipher, PlainLen);
+   Tag[0] ^= 1;
+   CHECK(!AES_GCM_Decrypt(&Ctx, Iv, Aad, AadLen, Data, PlainLen, Tag, sizeof(Tag)));
+   CHECK(memcmp(Data, Cipher, PlainLen) == 0);
+
+   AES_GCM_Wipe(&Ctx);
+
+} /* End TestKat() */
+
+
+/******************************************************************************
+** Function: main
+**
+*/
+int main(void)
+{
+
+   AES_GCM_Ctx_t Ctx;
+   uint8_t Key[16];
+   int Impl;
+   size_t i;
+
+   memset(Key, 0, sizeof(Key));
+
+   for (Impl = AES_GCM_IMPL_PORTABLE; Impl <= AES_GCM_IMPL_ARMV8_CE; Impl++)
+   {
+      AES_GCM_Init(&Ctx, Key, sizeof(Key), (AES_GCM_Impl_Enum_t)Impl);
+      if (Ctx.Impl != (AES_GCM_Impl_Enum_t)Impl)
+      {
+         printf("aes_gcm_test: %s implementation not available, skipped\n", ImplName[Impl]);
+         continue;
+      }
+      for (i = 0; i < sizeof(Kat)/sizeof(Kat[0]); i++)
+      {
+         TestKat(&Kat[i], (AES_GCM_Impl_Enum_t)Impl);
+      }
+      printf("aes_gcm_test: %s implementation tested\n", ImplName[Impl]);
+   }
+
+   printf("aes_gcm_test: %s\n", (FailCnt == 0) ? "passed" : "FAILED");
+
+   return (FailCnt == 0) ? 0 : 1;
+
+} /* End main() */
@@ -0,0 +1,861 @@
+/*
+**  This program is free software: you can redistribute it and/or modify
+**  it under the terms of the GNU Lesser General Public License as
+**  published by the Free Software Foundation, either version 3 of the
+**  License, or (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Lesser General Public License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public License
+**  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+**
+**  Purpose:
+**    Host unit test for the receive core
+**
+**  Notes:
+**    1. Frames come from a queue backend so the test links without cFS
+**       and the radio driver, see note 3 in rx_core.h.
+**
+*/
+
+/*
+** Include Files:
+*/
+
+#include <stdio.h>
+#include <string.h>
+#include "rx_core.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define QUEUE_LEN      8
+#define POOL_DEPTH     4
+#define RING_SIZE      1024
+#define TEST_DEST      0x10
+#define TEST_NODE      0x20
+#define TEST_APID      0x123
+#define TEST_KEY_ID    1
+
+#define CHECK(Cond) Check((Cond), #Cond, __LINE__)
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+typedef struct
+{
+
+   RADIO_RX_Frame_t Frame[QUEUE_LEN];
+   uint16_t Head;
+   uint16_t Tail;
+   uint16_t ReleaseCnt;
+   uint16_t AbortCnt;
+
+} Queue_t;
+
+
+/**********************/
+/** Global File Data **/
+/**********************/
+
+static RX_CORE_Class_t Core;
+static Queue_t Queue;
+static uint8_t Ring[RING_SIZE];
+static RX_CORE_Job_t Job[POOL_DEPTH];
+
+static uint16_t PktCnt;
+static uint16_t PktLen;
+static uint16_t WrapCnt;
+static uint8_t  Pkt[RING_SIZE];
+
+static uint16_t TimeCnt;
+static uint32_t TimeSeconds;
+static uint32_t TimeSubseconds;
+static uint16_t RelayCnt;
+static uint16_t RelayLen;
+static uint8_t  RelayNode;
+
+static const RX_SEC_KeyDef_t TestKey[] =
+{
+   { TEST_KEY_ID, 16, { 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+                        0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F } },
+   { TEST_KEY_ID, 16, { 0xF0, 0xE1, 0xD2, 0xC3, 0xB4, 0xA5, 0x96, 0x87,
+                        0x78, 0x69, 0x5A, 0x4B, 0x3C, 0x2D, 0x1E, 0x0F } }
+};
+
+static int FailCnt;
+
+
+/*******************************/
+/** Local Function Prototypes **/
+/*******************************/
+
+static RADIO_RX_Frame_t *QueueWait(void *BackendCtx, uint32_t TimeoutMs);
+static void QueueRelease(void *BackendCtx);
+static void QueueAbort(void *BackendCtx);
+static bool EmitPkt(void *EmitCtx, const uint8_t *Seg1, uint16_t Seg1Len,
+                    const uint8_t *Seg2, uint16_t Seg2Len);
+static bool RelaySink(void *SinkCtx, uint8_t Node, const uint8_t *Data, uint16_t Len);
+static void TimeSink(void *SinkCtx, uint8_t Node, uint32_t Seconds, uint32_t Subseconds,
+                     int64_t RxTimeNs);
+
+
+/******************************************************************************
+** Function: Check
+**
+*/
+static void Check(bool Passed, const char *Cond, int Line)
+{
+
+   if (!Passed)
+   {
+      printf("rx_core_test.c:%d: check failed: %s\n", Line, Cond);
+      FailCnt++;
+   }
+
+} /* End Check() */
+
+
+/******************************************************************************
+** Function: QueueWait
+**
+** Notes:
+**   1. Function signature must match RX_CORE_WaitFunc_t.
+**
+*/
+static RADIO_RX_Frame_t *QueueWait(void *BackendCtx, uint32_t TimeoutMs)
+{
+
+   Queue_t *Q = (Queue_t *)BackendCtx;
+
+   (void)TimeoutMs;
+
+   return (Q->Head == Q->Tail) ? NULL : &Q->Frame[Q->Tail % QUEUE_LEN];
+
+} /* End QueueWait() */
+
+
+/******************************************************************************
+** Function: QueueRelease
+**
+** Notes:
+**   1. Function signature must match RX_CORE_ReleaseFunc_t.
+**
+*/
+static void QueueRelease(void *BackendCtx)
+{
+
+   Queue_t *Q = (Queue_t *)BackendCtx;
+
+   Q->Tail++;
+   Q->ReleaseCnt++;
+
+} /* End QueueRelease() */
+
+
+/******************************************************************************
+** Function: QueueAbort
+**
+** Notes:
+**   1. Function signature must match RX_CORE_AbortFunc_t.
+**
+*/
+static void QueueAbort(void *BackendCtx)
+{
+
+   ((Queue_t *)BackendCtx)->AbortCnt++;
+
+} /* End QueueAbort() */
+
+
+/******************************************************************************
+** Function: EmitPkt
+**
+** Notes:
+**   1. Function signature must match CCSDS_DEFRAMER_EmitFunc_t.
+**
+*/
+static bool EmitPkt(void *EmitCtx, const uint8_t *Seg1, uint16_t Seg1Len,
+                    const uint8_t *Seg2, uint16_t Seg2Len)
+{
+
+   (void)EmitCtx;
+
+   memcpy(Pkt, Seg1, Seg1Len);
+   if (Seg2Len > 0)
+   {
+      memcpy(&Pkt[Seg1Len], Seg2, Seg2Len);
+      WrapCnt++;
+   }
+   PktLen = Seg1Len + Seg2Len;
+   PktCnt++;
+
+   return true;
+
+} /* End EmitPkt() */
+
+
+/******************************************************************************
+** Function: RelaySink
+**
+** Notes:
+**   1. Function signature must match RX_PAYLOAD_PktFunc_t.
+**
+*/
+static bool RelaySink(void *SinkCtx, uint8_t Node, const uint8_t *Data, uint16_t Len)
+{
+
+   (void)SinkCtx;
+   (void)Data;
+
+   RelayNode = Node;
+   RelayLen  = Len;
+   RelayCnt++;
+
+   return true;
+
+} /* End RelaySink() */
+
+
+/******************************************************************************
+** Function: TimeSink
+**
+** Notes:
+**   1. Function signature must match RX_PAYLOAD_TimeFunc_t.
+**
+*/
+static void TimeSink(void *SinkCtx, uint8_t Node, uint32_t Seconds, uint32_t Subseconds,
+                     int64_t RxTimeNs)
+{
+
+   (void)SinkCtx;
+   (void)Node;
+   (void)RxTimeNs;
+
+   TimeSeconds    = Seconds;
+   TimeSubseconds = Subseconds;
+   TimeCnt++;
+
+} /* End TimeSink() */
+
+
+/******************************************************************************
+** Function: BuildPkt
+**
+** Build a telemetry packet with DataLen data bytes and return its length
+**
+*/
+static uint16_t BuildPkt(uint8_t *Ccsds, uint8_t Seq, uint8_t DataLen)
+{
+
+   uint8_t i;
+
+   Ccsds[0] = (uint8_t)(TEST_APID >> 8);
+   Ccsds[1] = (uint8_t)TEST_APID;
+   Ccsds[2] = 0xC0;
+   Ccsds[3] = Seq;
+   Ccsds[4] = 0;
+   Ccsds[5] = DataLen - 1;
+   for (i = 0; i < DataLen; i++)
+   {
+      Ccsds[6+i] = Seq + i;
+   }
+
+   return 6 + DataLen;
+
+} /* End BuildPkt() */
+
+
+/******************************************************************************
+** Function: PushData
+**
+** Queue a frame with a Len byte data field and return it
+**
+*/
+static RADIO_RX_Frame_t *PushData(uint8_t Dest, uint8_t Node, uint8_t Seq, uint8_t Flags,
+                                  uint8_t Fhp, const uint8_t *Data, uint16_t Len)
+{
+
+   RADIO_RX_Frame_t *Frame = &Queue.Frame[Queue.Head % QUEUE_LEN];
+   uint8_t *Hdr = Frame->Data;
+
+   memset(Frame, 0, sizeof(RADIO_RX_Frame_t));
+
+   Hdr[RX_FRAME_DEST_OFFSET]  = Dest;
+   Hdr[RX_FRAME_NODE_OFFSET]  = Node;
+   Hdr[RX_FRAME_SEQ_OFFSET]   = Seq;
+   Hdr[RX_FRAME_FLAGS_OFFSET] = Flags;
+   Hdr[RX_FRAME_FHP_OFFSET]   = Fhp;
+   memcpy(&Frame->Data[RX_FRAME_HDR_LEN], Data, Len);
+
+   Frame->Len  = RX_FRAME_HDR_LEN + Len;
+   Frame->Rssi = -60;
+   Frame->Snr  = 8;
+
+   Queue.Head++;
+
+   return Frame;
+
+} /* End PushData() */
+
+
+/******************************************************************************
+** Function: PushFrame
+**
+** Queue a packet stream frame holding one telemetry packet with DataLen
+** data bytes
+**
+*/
+static void PushFrame(uint8_t Dest, uint8_t Node, uint8_t Seq, uint8_t DataLen, bool CrcErr)
+{
+
+   RADIO_RX_Frame_t *Frame;
+   uint8_t Ccsds[RX_FRAME_MAX_DATA_LEN];
+   uint16_t Len = BuildPkt(Ccsds, Seq, DataLen);
+
+   Frame = PushData(Dest, Node, Seq, RX_FRAME_TYPE_PACKETS << RX_FRAME_TYPE_SHIFT, 0, Ccsds, Len);
+   Frame->Flags = CrcErr ? RADIO_RX_FRAME_CRC_ERR : 0;
+
+} /* End PushFrame() */
+
+
+/******************************************************************************
+** Function: PushSecure
+**
+** Queue a secured packet stream frame holding one telemetry packet with
+** DataLen data bytes, encrypted with Key
+**
+** Notes:
+**   1. Builds the frame the way the transmitter does, see rx_sec.h.
+**
+*/
+static RADIO_RX_Frame_t *PushSecure(uint8_t Seq, uint32_t SecSeq, const RX_SEC_KeyDef_t *Key,
+                                    uint8_t DataLen)
+{
+
+   RADIO_RX_Frame_t *Frame;
+   AES_GCM_Ctx_t Gcm;
+   uint8_t  Body[RX_FRAME_MAX_DATA_LEN];
+   uint8_t  Iv[AES_GCM_IV_LEN];
+   uint16_t PktLen;
+
+   Body[0] = Key->Id;
+   Body[1] = (uint8_t)(SecSeq >> 24);
+   Body[2] = (uint8_t)(SecSeq >> 16);
+   Body[3] = (uint8_t)(SecSeq >> 8);
+   Body[4] = (uint8_t)SecSeq;
+   PktLen  = BuildPkt(&Body[RX_SEC_HDR_LEN], Seq, DataLen);
+
+   Frame = PushData(TEST_DEST, TEST_NODE, Seq,
+                    (RX_FRAME_TYPE_PACKETS << RX_FRAME_TYPE_SHIFT) | RX_FRAME_FLAG_SECURE, 0,
+                    Body, RX_SEC_HDR_LEN + PktLen + RX_SEC_TAG_LEN);
+
+   memset(Iv, 0, sizeof(Iv));
+   Iv[0] = TEST_NODE;
+   Iv[1] = Key->Id;
+   memcpy(&Iv[8], &Body[1], 4);
+
+   AES_GCM_Init(&Gcm, Key->Value, Key->Len, AES_GCM_IMPL_PORTABLE);
+   AES_GCM_Encrypt(&Gcm, Iv, Frame->Data, RX_FRAME_HDR_LEN + RX_SEC_HDR_LEN,
+                   &Frame->Data[RX_FRAME_HDR_LEN + RX_SEC_HDR_LEN], PktLen,
+                   &Frame->Data[RX_FRAME_HDR_LEN + RX_SEC_HDR_LEN + PktLen], RX_SEC_TAG_LEN);
+   AES_GCM_Wipe(&Gcm);
+
+   return Frame;
+
+} /* End PushSecure() */
+
+
+/******************************************************************************
+** Function: PutBits
+**
+** Append the Bits least significant bits of Value to a compressed stream,
+** most significant bit first
+**
+*/
+static void PutBits(uint8_t *Stream, uint16_t *BitPos, uint16_t Value, uint8_t Bits)
+{
+
+   while (Bits-- > 0)
+   {
+      if ((Value >> Bits) & 1)
+      {
+         Stream[*BitPos / 8] |= (uint8_t)(0x80 >> (*BitPos % 8));
+      }
+      (*BitPos)++;
+   }
+
+} /* End PutBits() */
+
+
+/******************************************************************************
+** Function: Setup
+**
+*/
+static void Setup(const RX_CORE_Backend_t *Backend)
+{
+
+   memset(&Queue, 0, sizeof(Queue_t));
+   PktCnt   = 0;
+   PktLen   = 0;
+   WrapCnt  = 0;
+   TimeCnt  = 0;
+   RelayCnt = 0;
+
+   RX_CORE_Constructor(&Core, Backend, NULL, NULL);
+   RX_SEC_Constructor(&Core.Sec, AES_GCM_IMPL_PORTABLE);
+   RX_DECOMP_Constructor(&Core.Decomp, RX_DECOMP_DEF_WINDOW_BITS, RX_DECOMP_DEF_LOOKAHEAD_BITS,
+                         RX_DECOMP_MAX_OUT_LEN);
+   CCSDS_DEFRAMER_Constructor(&Core.Deframer, CCSDS_DEFRAMER_MAX_PKT_LEN(RING_SIZE),
+                              Ring, RING_SIZE, EmitPkt, NULL);
+   RX_CORE_SetAddress(&Core, TEST_DEST, TEST_NODE);
+
+} /* End Setup() */
+
+
+/******************************************************************************
+** Function: TestDeframe
+**
+** A packet stream frame from the uplink node is deframed
+**
+*/
+static void TestDeframe(const RX_CORE_Backend_t *Backend)
+{
+
+   Setup(Backend);
+   PushFrame(TEST_DEST, TEST_NODE, 1, 20, false);
+
+   CHECK(RX_CORE_Poll(&Core, 0));
+   CHECK(Queue.ReleaseCnt == 1);
+   CHECK(Core.Stats.FrameCnt == 1);
+   CHECK(PktCnt == 1);
+   CHECK(PktLen == 26);
+   CHECK(Pkt[1] == (TEST_APID & 0xFF) && Pkt[6] == 1 && Pkt[25] == 20);
+   CHECK(!RX_CORE_Poll(&Core, 0));
+   CHECK(Queue.ReleaseCnt == 1);
+
+} /* End TestDeframe() */
+
+
+/******************************************************************************
+** Function: TestFilter
+**
+** Frames to another receiver, from another node or with a CRC error
+** aren't deframed but are still released
+**
+*/
+static void TestFilter(const RX_CORE_Backend_t *Backend)
+{
+
+   Setup(Backend);
+   PushFrame(TEST_DEST + 1, TEST_NODE, 1, 20, false);
+   PushFrame(TEST_DEST, TEST_NODE + 1, 2, 20, false);
+   PushFrame(TEST_DEST, TEST_NODE, 3, 20, true);
+   PushFrame(RX_FRAME_BROADCAST, TEST_NODE, 4, 20, false);
+
+   while (RX_CORE_Poll(&Core, 0));
+
+   CHECK(Queue.ReleaseCnt == 4);
+   CHECK(Core.Stats.DestFilterCnt == 1);
+   CHECK(Core.Stats.NodeFilterCnt == 1);
+   CHECK(Core.Stats.FrameCnt == 2);
+   CHECK(PktCnt == 1);
+
+} /* End TestFilter() */
+
+
+/******************************************************************************
+** Function: TestSeqGap
+**
+*/
+static void TestSeqGap(const RX_CORE_Backend_t *Backend)
+{
+
+   Setup(Backend);
+   PushFrame(TEST_DEST, TEST_NODE, 1, 20, false);
+   PushFrame(TEST_DEST, TEST_NODE, 2, 20, false);
+   PushFrame(TEST_DEST, TEST_NODE, 4, 20, false);
+
+   while (RX_CORE_Poll(&Core, 0));
+
+   CHECK(Core.Stats.SeqGapCnt == 1);
+   CHECK(PktCnt == 3);
+
+} /* End TestSeqGap() */
+
+
+/******************************************************************************
+** Function: TestNoBackend
+**
+** Frames passed directly are processed without a backend
+**
+*/
+static void TestNoBackend(void)
+{
+
+   Setup(NULL);
+   PushFrame(TEST_DEST, TEST_NODE, 1, 20, false);
+
+   CHECK(RX_CORE_WaitFrame(&Core, 0) == NULL);
+   CHECK(!RX_CORE_Poll(&Core, 0));
+   RX_CORE_ProcessFrame(&Core, &Queue.Frame[0]);
+   RX_CORE_ReleaseFrame(&Core);
+
+   CHECK(PktCnt == 1);
+   CHECK(Queue.ReleaseCnt == 0);
+
+} /* End TestNoBackend() */
+
+
+/******************************************************************************
+** Function: TestSplit
+**
+** A packet split across two frames is emitted when its last byte arrives
+**
+*/
+static void TestSplit(const RX_CORE_Backend_t *Backend)
+{
+
+   uint8_t  Ccsds[RX_FRAME_MAX_DATA_LEN];
+   uint16_t Len;
+
+   Setup(Backend);
+   Len = BuildPkt(Ccsds, 1, 100);
+   PushData(TEST_DEST, TEST_NODE, 1, RX_FRAME_TYPE_PACKETS << RX_FRAME_TYPE_SHIFT, 0, Ccsds, 60);
+   PushData(TEST_DEST, TEST_NODE, 2, RX_FRAME_TYPE_PACKETS << RX_FRAME_TYPE_SHIFT,
+            RX_FRAME_FHP_NONE, &Ccsds[60], Len - 60);
+
+   CHECK(RX_CORE_Poll(&Core, 0));
+   CHECK(PktCnt == 0);
+   CHECK(RX_CORE_Poll(&Core, 0));
+   CHECK(PktCnt == 1);
+   CHECK(PktLen == Len && memcmp(Pkt, Ccsds, Len) == 0);
+   CHECK(Core.Deframer.Stats.ResyncCnt == 0);
+
+} /* End TestSplit() */
+
+
+/******************************************************************************
+** Function: TestMidFhp
+**
+** A frame that starts with the end of a packet and has its first header
+** pointer in mid-frame completes that packet before the next one
+**
+*/
+static void TestMidFhp(const RX_CORE_Backend_t *Backend)
+{
+
+   uint8_t  Data[RX_FRAME_MAX_DATA_LEN];
+   uint8_t  Ccsds[RX_FRAME_MAX_DATA_LEN];
+   uint16_t Len;
+   uint16_t Tail;
+
+   Setup(Backend);
+
+   Len = BuildPkt(Data, 1, 20);
+   Tail = BuildPkt(Ccsds, 2, 40) - 20;
+   memcpy(&Data[Len], Ccsds, 20);
+   PushData(TEST_DEST, TEST_NODE, 1, RX_FRAME_TYPE_PACKETS << RX_FRAME_TYPE_SHIFT, 0, Data, Len + 20);
+
+   memcpy(Data, &Ccsds[20], Tail);
+   Len = BuildPkt(&Data[Tail], 3, 20);
+   PushData(TEST_DEST, TEST_NODE, 2, RX_FRAME_TYPE_PACKETS << RX_FRAME_TYPE_SHIFT, (uint8_t)Tail,
+            Data, Tail + Len);
+
+   CHECK(RX_CORE_Poll(&Core, 0));
+   CHECK(PktCnt == 1);
+   CHECK(RX_CORE_Poll(&Core, 0));
+   CHECK(PktCnt == 3);
+   CHECK(PktLen == 26 && Pkt[3] == 3);
+   CHECK(Core.Deframer.Stats.ResyncCnt == 0);
+   CHECK(Core.Deframer.Stats.DiscardByteCnt == 0);
+
+} /* End TestMidFhp() */
+
+
+/******************************************************************************
+** Function: TestResync
+**
+** A lost frame drops the partial packet and the deframer resynchronizes
+** at the next frame's first header pointer
+**
+*/
+static void TestResync(const RX_CORE_Backend_t *Backend)
+{
+
+   uint8_t  Data[RX_FRAME_MAX_DATA_LEN];
+   uint16_t Len;
+
+   Setup(Backend);
+
+   BuildPkt(Data, 1, 100);
+   PushData(TEST_DEST, TEST_NODE, 1, RX_FRAME_TYPE_PACKETS << RX_FRAME_TYPE_SHIFT, 0, Data, 40);
+
+   memset(Data, 0xA5, 30);
+   Len = BuildPkt(&Data[30], 3, 20);
+   PushData(TEST_DEST, TEST_NODE, 3, RX_FRAME_TYPE_PACKETS << RX_FRAME_TYPE_SHIFT, 30, Data, 30 + Len);
+
+   while (RX_CORE_Poll(&Core, 0));
+
+   CHECK(Core.Stats.SeqGapCnt == 1);
+   CHECK(Core.Deframer.Stats.GapCnt == 1);
+   CHECK(Core.Deframer.Stats.DiscardByteCnt == 70);
+   CHECK(Core.Deframer.Stats.ResyncCnt == 0);
+   CHECK(PktCnt == 1);
+   CHECK(PktLen == Len && Pkt[3] == 3);
+
+} /* End TestResync() */
+
+
+/******************************************************************************
+** Function: TestRingWrap
+**
+** A packet that wraps the end of the deframer's ring is emitted in two
+** segments
+**
+*/
+static void TestRingWrap(const RX_CORE_Backend_t *Backend)
+{
+
+   uint8_t Seq;
+
+   Setup(Backend);
+
+   for (Seq = 1; Seq <= RING_SIZE/200 + 1; Seq++)
+   {
+      PushFrame(TEST_DEST, TEST_NODE, Seq, 194, false);
+      CHECK(RX_CORE_Poll(&Core, 0));
+   }
+
+   CHECK(PktCnt == RING_SIZE/200 + 1);
+   CHECK(WrapCnt == 1);
+   CHECK(PktLen == 200 && Pkt[3] == RING_SIZE/200 + 1);
+   CHECK(Pkt[6] == RING_SIZE/200 + 1 && Pkt[199] == (uint8_t)(RING_SIZE/200 + 1 + 193));
+   CHECK(Core.Deframer.Stats.ResyncCnt == 0);
+
+} /* End TestRingWrap() */
+
+
+/******************************************************************************
+** Function: TestSecure
+**
+** Secured frames are authenticated, decrypted and checked for replay
+**
+** Notes:
+**   1. Reloading the same key keeps the node's replay window, loading a
+**      new key under the same KeyId restarts it.
+**
+*/
+static void TestSecure(const RX_CORE_Backend_t *Backend)
+{
+
+   RADIO_RX_Frame_t *Frame;
+
+   Setup(Backend);
+   CHECK(RX_SEC_LoadKeys(&Core.Sec, &TestKey[0], 1));
+
+   PushSecure(1, 1, &TestKey[0], 20);
+   PushSecure(1, 1, &TestKey[0], 20);
+   while (RX_CORE_Poll(&Core, 0));
+
+   CHECK(Core.Sec.Stats.FrameCnt == 1);
+   CHECK(Core.Sec.Stats.ReplayCnt == 1);
+   CHECK(PktCnt == 1);
+   CHECK(PktLen == 26 && Pkt[6] == 1 && Pkt[25] == 20);
+
+   CHECK(RX_SEC_LoadKeys(&Core.Sec, &TestKey[0], 1));
+   PushSecure(2, 1, &TestKey[0], 20);
+   PushSecure(2, 2, &TestKey[0], 20);
+   Frame = PushSecure(3, 3, &TestKey[0], 20);
+   Frame->Data[Frame->Len - 1] ^= 1;
+   while (RX_CORE_Poll(&Core, 0));
+
+   CHECK(Core.Sec.Stats.FrameCnt == 2);
+   CHECK(Core.Sec.Stats.ReplayCnt == 2);
+   CHECK(Core.Sec.Stats.AuthFailCnt == 1);
+   CHECK(PktCnt == 2 && Pkt[3] == 2);
+
+   CHECK(RX_SEC_LoadKeys(&Core.Sec, &TestKey[1], 1));
+   PushSecure(3, 1, &TestKey[1], 20);
+   while (RX_CORE_Poll(&Core, 0));
+
+   CHECK(Core.Sec.Stats.FrameCnt == 3);
+   CHECK(PktCnt == 3 && Pkt[3] == 3);
+
+   Core.SecRequired = true;
+   PushFrame(TEST_DEST, TEST_NODE, 4, 20, false);
+   while (RX_CORE_Poll(&Core, 0));
+
+   CHECK(Core.Stats.InsecureCnt == 1);
+   CHECK(PktCnt == 3);
+
+} /* End TestSecure() */
+
+
+/******************************************************************************
+** Function: TestCompressed
+**
+** A compressed frame is decompressed and passed to the deframer in frame
+** data field sized pieces
+**
+** Notes:
+**   1. The stream holds one packet as literals followed by back-references
+**      that repeat it, so it expands to more than a frame data field.
+**
+*/
+static void TestCompressed(const RX_CORE_Backend_t *Backend)
+{
+
+   uint8_t  Stream[RX_FRAME_MAX_DATA_LEN];
+   uint8_t  Ccsds[RX_FRAME_MAX_DATA_LEN];
+   uint16_t BitPos = 0;
+   uint16_t Len;
+   uint16_t Copy;
+   uint16_t i;
+
+   Setup(Backend);
+   memset(Stream, 0, sizeof(Stream));
+
+   Len = BuildPkt(Ccsds, 1, 20);
+   for (i = 0; i < Len; i++)
+   {
+      PutBits(Stream, &BitPos, 1, 1);
+      PutBits(Stream, &BitPos, Ccsds[i], 8);
+   }
+   for (Copy = 0; Copy < 9; Copy++)
+   {
+      for (i = 0; i < Len; i += 16)
+      {
+         PutBits(Stream, &BitPos, 0, 1);
+         PutBits(Stream, &BitPos, Len - 1, RX_DECOMP_DEF_WINDOW_BITS);
+         PutBits(Stream, &BitPos, ((Len - i > 16) ? 16 : Len - i) - 1, RX_DECOMP_DEF_LOOKAHEAD_BITS);
+      }
+   }
+   PushData(TEST_DEST, TEST_NODE, 1,
+            (RX_FRAME_TYPE_PACKETS << RX_FRAME_TYPE_SHIFT) | RX_FRAME_FLAG_COMPRESSED, 0,
+            Stream, (BitPos + 7)/8);
+
+   CHECK(RX_CORE_Poll(&Core, 0));
+
+   CHECK(Core.Decomp.Stats.FrameCnt == 1);
+   CHECK(Core.Decomp.Stats.OutByteCnt == 10*Len);
+   CHECK(10*Len > RX_FRAME_MAX_DATA_LEN);
+   CHECK(PktCnt == 10);
+   CHECK(PktLen == Len && memcmp(Pkt, Ccsds, Len) == 0);
+   CHECK(Core.Deframer.Stats.ResyncCnt == 0);
+
+} /* End TestCompressed() */
+
+
+/******************************************************************************
+** Function: TestTyped
+**
+** Frames other than the packet stream go to the payload sinks, relayed
+** frames from any node
+**
+*/
+static void TestTyped(const RX_CORE_Backend_t *Backend)
+{
+
+   static const uint8_t Time[RX_PAYLOAD_TIME_LEN] = { 0, 0, 1, 0, 0, 0, 0x80, 0 };
+   RX_PAYLOAD_Sinks_t Sinks;
+   uint8_t  Ccsds[RX_FRAME_MAX_DATA_LEN];
+   uint16_t Len;
+
+   Setup(Backend);
+   memset(&Sinks, 0, sizeof(Sinks));
+   Sinks.Relay = RelaySink;
+   Sinks.Time  = TimeSink;
+   RX_PAYLOAD_Constructor(&Core.Payload, &Sinks, NULL);
+
+   Len = BuildPkt(Ccsds, 1, 20);
+   PushData(TEST_DEST, TEST_NODE, 1, RX_FRAME_TYPE_TIME << RX_FRAME_TYPE_SHIFT,
+            RX_FRAME_FHP_NONE, Time, sizeof(Time));
+   PushData(TEST_DEST, TEST_NODE + 1, 7, RX_FRAME_TYPE_RELAY << RX_FRAME_TYPE_SHIFT,
+            RX_FRAME_FHP_NONE, Ccsds, Len);
+   PushData(TEST_DEST, TEST_NODE, 2, RX_FRAME_TYPE_TIME << RX_FRAME_TYPE_SHIFT,
+            RX_FRAME_FHP_NONE, Time, sizeof(Time) - 1);
+   PushData(TEST_DEST, TEST_NODE, 3, RX_FRAME_TYPE_COMMAND << RX_FRAME_TYPE_SHIFT,
+            RX_FRAME_FHP_NONE, Ccsds, Len);
+
+   while (RX_CORE_Poll(&Core, 0));
+
+   CHECK(Queue.ReleaseCnt == 4);
+   CHECK(TimeCnt == 1 && TimeSeconds == 256 && TimeSubseconds == 0x8000);
+   CHECK(RelayCnt == 1 && RelayNode == TEST_NODE + 1 && RelayLen == Len);
+   CHECK(Core.Payload.Stats.InvalidCnt == 1);
+   CHECK(Core.Payload.Stats.UnhandledCnt == 1);
+   CHECK(Core.Stats.NodeFilterCnt == 0);
+   CHECK(PktCnt == 0);
+
+} /* End TestTyped() */
+
+
+/******************************************************************************
+** Function: TestPool
+**
+** Decoded jobs are deframed in frame order
+**
+*/
+static void TestPool(const RX_CORE_Backend_t *Backend)
+{
+
+   Setup(Backend);
+   CHECK(RX_CORE_StartPool(&Core, 2, Job, POOL_DEPTH));
+   PushFrame(TEST_DEST, TEST_NODE, 1, 20, false);
+   PushFrame(TEST_DEST, TEST_NODE, 2, 30, false);
+   PushFrame(TEST_DEST, TEST_NODE, 3, 40, false);
+
+   while (RX_CORE_Poll(&Core, 0));
+   RX_CORE_Flush(&Core);
+
+   CHECK(Queue.ReleaseCnt == 3);
+   CHECK(Core.Stats.SeqGapCnt == 0);
+   CHECK(PktCnt == 3);
+   CHECK(PktLen == 46 && Pkt[6] == 3);
+
+   RX_POOL_Stop(&Core.Pool);
+   CHECK(!Core.Pool.Running);
+
+} /* End TestPool() */
+
+
+/******************************************************************************
+** Function: main
+**
+*/
+int main(void)
+{
+
+   RX_CORE_Backend_t Backend;
+
+   Backend.WaitFunc    = QueueWait;
+   Backend.ReleaseFunc = QueueRelease;
+   Backend.AbortFunc   = QueueAbort;
+   Backend.Ctx         = &Queue;
+
+   TestDeframe(&Backend);
+   TestFilter(&Backend);
+   TestSeqGap(&Backend);
+   TestNoBackend();
+   TestSplit(&Backend);
+   TestMidFhp(&Backend);
+   TestResync(&Backend);
+   TestRingWrap(&Backend);
+   TestSecure(&Backend);
+   TestCompressed(&Backend);
+   TestTyped(&Backend);
+   TestPool(&Backend);
+
+   printf("rx_core_test: %s\n", (FailCnt == 0) ? "passed" : "FAILED");
+
+   return (FailCnt == 0) ? 0 : 1;
+
+} /* End main() */